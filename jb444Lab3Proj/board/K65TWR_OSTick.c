@@ -0,0 +1,151 @@
+/*******************************************************************************
+* K65TWR_OSTick.c - Dynamic (tickless) uC/OS-III tick on the K65 PIT.
+*
+* With OS_CFG_DYN_TICK_EN the kernel asks for an interrupt only when the next
+* delay or timeout is due, instead of every 1 ms. PIT channel 1 free-runs as
+* the time base and channel 2 is a one-shot programmed for that expiry. The
+* idle task sleeps in WFI in between (see OSIdleTaskHook() in os_cpu_c.c).
+*
+* Ticks are counted from the time base, not from interrupts. A wakeup for any
+* other reason, such as the generator's DMA half and full block interrupts,
+* sees the right tick count from BSP_OS_TickGet() and the kernel
+* compensates delays made between ticks.
+*
+* The PIT stops in the STOP modes, and so would the DMA stream that PIT
+* channel 0 paces, so only WAIT (plain WFI) is used. The LPTMR keeps running
+* in STOP, but its compare can not be moved while it counts.
+******************************************************************************/
+#include "MCUType.h"
+#include "app_cfg.h"
+#include "os.h"
+#include "K65TWR_OSTick.h"
+
+#define OSTICK_TMR_CH       1u          /* Free-running time base              */
+#define OSTICK_MATCH_CH     2u          /* One-shot for the next tick          */
+#define OSTICK_MIN_CNTS     64u         /* Shortest one-shot, for late matches */
+#define OSTICK_SPAN_MAX     0x7FFFFFFFu /* Longest step, half the count range  */
+
+static INT32U bspOSTickCnts;            /* PIT counts per tick, 0 until started */
+static INT32U bspOSTickBase;            /* Count at the last announced tick     */
+static INT32U bspOSTickMatch;           /* Count at which the next tick is due  */
+static OS_TICK bspOSTickMax;            /* Longest step in ticks                */
+
+static INT32U bspOSTickCntGet(void);
+static void bspOSTickMatchSet(INT32U match);
+void PIT2_IRQHandler(void);
+
+/*******************************************************************************
+* BSP_OS_TickInitFreq - Starts the time base and programs the first expiry.
+*                       Delays made before this call are picked up from
+*                       OSTickCtrStep.
+******************************************************************************/
+void BSP_OS_TickInitFreq(INT32U bus_freq){
+	CPU_SR_ALLOC();
+
+	SIM->SCGC6 |= SIM_SCGC6_PIT(1);
+	PIT->MCR &= ~PIT_MCR_MDIS_MASK;
+
+	PIT->CHANNEL[OSTICK_MATCH_CH].TCTRL = 0;
+	PIT->CHANNEL[OSTICK_TMR_CH].TCTRL = 0;
+	PIT->CHANNEL[OSTICK_TMR_CH].LDVAL = 0xFFFFFFFFu;
+	PIT->CHANNEL[OSTICK_TMR_CH].TCTRL = PIT_TCTRL_TEN_MASK;
+
+	CPU_CRITICAL_ENTER();
+	bspOSTickCnts = bus_freq / (INT32U)OSCfg_TickRate_Hz;
+	bspOSTickMax = (OS_TICK)(OSTICK_SPAN_MAX / bspOSTickCnts);
+	bspOSTickBase = bspOSTickCntGet();
+	(void)BSP_OS_TickNextSet(OSTickCtrStep);
+	CPU_CRITICAL_EXIT();
+
+	NVIC_EnableIRQ(PIT2_IRQn);
+}
+
+/*******************************************************************************
+* BSP_OS_TickGet - Current tick count. Ticks announced to the tick task and
+*                  whole ticks elapsed since then are both included.
+******************************************************************************/
+OS_TICK BSP_OS_TickGet(void){
+	OS_TICK ticks;
+	CPU_SR_ALLOC();
+
+	CPU_CRITICAL_ENTER();
+	ticks = OSTickCtr + OSTickCtrPend;
+	if (bspOSTickCnts != 0){
+		ticks += (OS_TICK)((bspOSTickCntGet() - bspOSTickBase) / bspOSTickCnts);
+	}else{}
+	CPU_CRITICAL_EXIT();
+	return ticks;
+}
+
+/*******************************************************************************
+* BSP_OS_TickNextSet - Programs an interrupt 'ticks' after OSTickCtr, or as
+*                      late as the time base allows if nothing is waiting
+*                      ((OS_TICK)-1). Returns the step programmed from the
+*                      last announced tick. Called with interrupts disabled.
+******************************************************************************/
+OS_TICK BSP_OS_TickNextSet(OS_TICK ticks){
+	OS_TICK step;
+
+	if (bspOSTickCnts == 0){	//not started, BSP_OS_TickInitFreq() catches up
+		return ticks;
+	}else{}
+	if (ticks > OSTickCtrPend){
+		step = ticks - OSTickCtrPend;
+	}else{
+		step = 1u;				//already due, the tick task has been signalled
+	}
+	if (step > bspOSTickMax){
+		step = bspOSTickMax;
+	}else{}
+	bspOSTickMatch = bspOSTickBase + (INT32U)step * bspOSTickCnts;
+	bspOSTickMatchSet(bspOSTickMatch);
+	return step;
+}
+
+/*******************************************************************************
+* PIT2_IRQHandler - Announces every whole tick elapsed since the last one.
+*                   An interrupt a few counts early waits for the rest.
+******************************************************************************/
+void PIT2_IRQHandler(void){
+	OS_TICK ticks;
+	CPU_SR_ALLOC();
+
+	CPU_CRITICAL_ENTER();
+	OSIntEnter();
+	PIT->CHANNEL[OSTICK_MATCH_CH].TCTRL = 0;
+	PIT->CHANNEL[OSTICK_MATCH_CH].TFLG = PIT_TFLG_TIF_MASK;
+	ticks = (OS_TICK)((bspOSTickCntGet() - bspOSTickBase) / bspOSTickCnts);
+	if (ticks != 0){
+		bspOSTickBase += (INT32U)ticks * bspOSTickCnts;
+		OSTimeDynTick(ticks);	//with the base, so BSP_OS_TickGet() never sees half
+	}else{
+		bspOSTickMatchSet(bspOSTickMatch);
+	}
+	CPU_CRITICAL_EXIT();
+	OSIntExit();
+}
+
+/*******************************************************************************
+* bspOSTickCntGet - The PIT counts down, so the inverse is a count up.
+******************************************************************************/
+static INT32U bspOSTickCntGet(void){
+	return ~PIT->CHANNEL[OSTICK_TMR_CH].CVAL;
+}
+
+/*******************************************************************************
+* bspOSTickMatchSet - Restarts the one-shot to expire at count 'match', or
+*                     after OSTICK_MIN_CNTS if that has already passed.
+******************************************************************************/
+static void bspOSTickMatchSet(INT32U match){
+	INT32U cnts;
+
+	cnts = match - bspOSTickCntGet();
+	if ((INT32S)cnts < (INT32S)OSTICK_MIN_CNTS){
+		cnts = OSTICK_MIN_CNTS;
+	}else{}
+	PIT->CHANNEL[OSTICK_MATCH_CH].TCTRL = 0;
+	PIT->CHANNEL[OSTICK_MATCH_CH].TFLG = PIT_TFLG_TIF_MASK;
+	NVIC_ClearPendingIRQ(PIT2_IRQn);
+	PIT->CHANNEL[OSTICK_MATCH_CH].LDVAL = cnts - 1u;
+	PIT->CHANNEL[OSTICK_MATCH_CH].TCTRL = PIT_TCTRL_TIE_MASK | PIT_TCTRL_TEN_MASK;
+}
@@ -0,0 +1,26 @@
+/*******************************************************************************
+* K65TWR_OSTick.h - Dynamic (tickless) uC/OS-III tick for the K65TWR board.
+*
+* Used when OS_CFG_DYN_TICK_EN is enabled in os_cfg.h. It takes the place of
+* OS_CPU_SysTickInitFreq(). The kernel calls BSP_OS_TickGet() and
+* BSP_OS_TickNextSet() itself (see os.h), so the application only has to call
+* BSP_OS_TickInitFreq() from the start task.
+*
+* PIT channel 0 paces the generator DMA (OutputModule.c). This module uses
+*   PIT channel 1   Free-running count, the time base
+*   PIT channel 2   One-shot, interrupts when the next tick is due
+******************************************************************************/
+#ifndef K65TWR_OSTICK_H_
+#define K65TWR_OSTICK_H_
+
+/* The PIT runs from the bus clock. K65TWR_BootClock() sets OUTDIV2 = 1 */
+#define BSP_OS_TICK_BUS_FREQ    (SYSTEM_CLOCK / 2u)
+
+/*******************************************************************************
+* BSP_OS_TickInitFreq - Starts the dynamic tick. bus_freq is the PIT clock in
+*                       Hz. Must be called after OSStart(), like
+*                       OS_CPU_SysTickInitFreq().
+******************************************************************************/
+void BSP_OS_TickInitFreq(INT32U bus_freq);
+
+#endif /* K65TWR_OSTICK_H_ */
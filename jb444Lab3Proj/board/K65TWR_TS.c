@@ -0,0 +1,36 @@
+/*******************************************************************************
+* K65TWR_TS.c - uC/CPU timestamp timer on the Cortex-M4 DWT cycle counter.
+*
+* CPU_Init() calls CPU_TS_TmrInit(), and OS_TS_GET() reads CPU_TS_TmrRd(), so
+* with OS_CFG_TS_EN every kernel timestamp, task cycle count and profiler
+* figure (os_prof.c) is in core clock cycles, 1/SYSTEM_CLOCK s each.
+*
+* CYCCNT only counts while the core is clocked. The idle task sleeps in WFI,
+* so its cycles, and the time between timestamps taken either side of a
+* sleep, come out short. Latencies are measured from a post made after the
+* wakeup and are not affected.
+******************************************************************************/
+#include "MCUType.h"
+#include "K65TWR_ClkCfg.h"
+#include "os.h"
+
+#if (CPU_CFG_TS_TMR_EN == DEF_ENABLED)
+/*******************************************************************************
+* CPU_TS_TmrInit - Enables the trace block and starts CYCCNT from zero.
+******************************************************************************/
+void CPU_TS_TmrInit(void){
+
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CYCCNT = 0u;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+	CPU_TS_TmrFreqSet((CPU_TS_TMR_FREQ)SYSTEM_CLOCK);
+}
+
+/*******************************************************************************
+* CPU_TS_TmrRd - Current cycle count. It counts up and wraps at 32 bits, as
+*                uC/CPU expects.
+******************************************************************************/
+CPU_TS_TMR CPU_TS_TmrRd(void){
+	return (CPU_TS_TMR)DWT->CYCCNT;
+}
+#endif
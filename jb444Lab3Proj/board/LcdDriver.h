@@ -0,0 +1,63 @@
+/****************************************************************************************
+* LcdDriver.h - Character display back-end interface for LcdLayered
+*
+*                LcdLayered owns the layers and the compositor. A back-end
+*                owns the bus and only has to place characters at a cell
+*                and position the cursor. Row and column indices passed to
+*                a back-end are zero based.
+*
+*                The display geometry is set at compile time. Override in
+*                app_cfg.h if needed:
+*                   APP_CFG_LCD_NUM_ROWS    (default 2)
+*                   APP_CFG_LCD_NUM_COLS    (default 16)
+*                   APP_CFG_LCD_DRIVER      (default LcdHD44780Driver)
+*
+*                LCD_NUM_COLS must be a multiple of 4 and no more than 32.
+****************************************************************************************/
+#ifndef LCD_DRIVER_DEF
+#define LCD_DRIVER_DEF
+
+/*************************************************************************
+* Display geometry
+*************************************************************************/
+#ifdef APP_CFG_LCD_NUM_ROWS
+#define LCD_NUM_ROWS    APP_CFG_LCD_NUM_ROWS
+#else
+#define LCD_NUM_ROWS    2
+#endif
+
+#ifdef APP_CFG_LCD_NUM_COLS
+#define LCD_NUM_COLS    APP_CFG_LCD_NUM_COLS
+#else
+#define LCD_NUM_COLS    16
+#endif
+
+#ifdef APP_CFG_LCD_DRIVER
+#define LCD_DRIVER_DEFAULT  APP_CFG_LCD_DRIVER
+#else
+#define LCD_DRIVER_DEFAULT  LcdHD44780Driver
+#endif
+
+/*************************************************************************
+* Back-end operations
+*   init    - Brings up the bus and clears the display. Called once from
+*             LcdInit() before the first write.
+*   moveTo  - Sets the position of the next putChar().
+*   putChar - Writes a character at the current position, then advances
+*             one column.
+*   cursor  - Places the visible cursor and sets its on/blink state.
+*************************************************************************/
+typedef struct {
+    void (*init)(void);
+    void (*moveTo)(INT8U row_index, INT8U col_index);
+    void (*putChar)(INT8C c);
+    void (*cursor)(INT8U row_index, INT8U col_index, INT8U on, INT8U blink);
+} LCD_DRIVER;
+
+/*************************************************************************
+* Available back-ends
+*************************************************************************/
+extern const LCD_DRIVER LcdHD44780Driver;    /* LcdHD44780.c */
+extern const LCD_DRIVER LcdTextBufDriver;    /* LcdTextBuf.c */
+
+#endif
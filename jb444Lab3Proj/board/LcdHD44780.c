@@ -0,0 +1,248 @@
+/****************************************************************************************
+* LcdHD44780.c - LcdLayered back-end for a Hitachi HD44780 type character LCD
+*
+*                Drives the display in 4-bit mode on PORTD of the K65TWR.
+*                Supports 1, 2 and 4 line modules. Four line modules map
+*                rows 3 and 4 onto the tail of the 0x00 and 0x40 DDRAM lines.
+*
+*                The bus code was split out of LcdLayered.c so the layer
+*                compositor can run on other displays.
+*****************************************************************************************
+* Header Files - Dependencies
+*****************************************************************************************/
+#include "MCUType.h"
+#include "app_cfg.h"
+#include "LcdDriver.h"
+
+/*****************************************************************************************
+* LCD Port Defines
+*****************************************************************************************/
+#define LCD_RS_BIT     0x2
+#define LCD_E_BIT      0x4
+#define LCD_DB_MASK    0x78
+#define LCD_PORT       GPIOD->PDOR
+#define LCD_PORT_DIR   GPIOD->PDDR
+#define INIT_BIT_DIR() (LCD_PORT_DIR |= (LCD_RS_BIT|LCD_E_BIT|LCD_DB_MASK))
+#define LCD_SET_RS()   GPIOD->PSOR = LCD_RS_BIT
+#define LCD_CLR_RS()   GPIOD->PCOR = LCD_RS_BIT
+#define LCD_SET_E()    GPIOD->PSOR = LCD_E_BIT
+#define LCD_CLR_E()    GPIOD->PCOR = LCD_E_BIT
+#define LCD_WR_DB(nib) (GPIOD->PDOR = (GPIOD->PDOR & ~LCD_DB_MASK)|((nib)<<3))
+
+/*****************************************************************************************
+* DDRAM addressing
+*   Rows 1 and 2 start at 0x00 and 0x40. On four line modules rows 3 and 4
+*   continue those lines, LCD_NUM_COLS characters further on.
+*****************************************************************************************/
+#if (LCD_NUM_ROWS != 1) && (LCD_NUM_ROWS != 2) && (LCD_NUM_ROWS != 4)
+#error "HD44780 back-end supports 1, 2 or 4 rows"
+#endif
+#define LCD_ROW_ADDR(row_index) ((((row_index) & 1u) ? 0x40u : 0x00u) \
+                                 + (((row_index) >> 1) * LCD_NUM_COLS))
+
+/*************************************************************************
+  Private Local Functions
+*************************************************************************/
+static void lcdInit(void);
+static void lcdMoveTo(INT8U row_index, INT8U col_index);
+static void lcdPutChar(INT8C c);
+static void lcdCursor(INT8U row_index, INT8U col_index, INT8U on, INT8U blink);
+static void lcdDlyus(INT16U us);
+static void lcdDly500ns(void);
+static void lcdWrite(INT16U data);
+
+/*************************************************************************
+  Driver Instance
+*************************************************************************/
+const LCD_DRIVER LcdHD44780Driver = {
+    lcdInit,
+    lcdMoveTo,
+    lcdPutChar,
+    lcdCursor
+};
+
+/*************************************************************************
+  LCD Command Macros
+*************************************************************************/
+/*                                                    R R D D D D D D D D
+                                                      / S B B B B B B B B
+                                                      W   7 6 5 4 3 2 1 0
+*/
+// Clear Display                                      0 0 0 0 0 0 0 0 0 1
+#define LCD_CLR_DISP()         (0x0001)
+// Return Home                                        0 0 0 0 0 0 0 0 1 *
+#define LCD_CUR_HOME()         (0x0002)
+// Entry Mode Set                                     0 0 0 0 0 0 0 1 ids
+#define LCD_ENTRY_MODE(id, s)  (0x0004                       \
+                                | ((INT16U)id ? 0x0002 : 0)  \
+                                | ((INT16U)s  ? 0x0001 : 0))
+// Display ON/OFF Control                             0 0 0 0 0 0 1 d c b
+#define LCD_ON_OFF(d, c, b)    (0x0008                       \
+                                | ((INT16U)d  ? 0x0004 : 0)  \
+                                | ((INT16U)c  ? 0x0002 : 0)  \
+                                | ((INT16U)b  ? 0x0001 : 0))
+// Cursor or Display Shift                            0 0 0 0 0 1 scrl* *
+#define LCD_SHIFT(sc, rl)      (0x0010                       \
+                                | ((INT16U)sc ? 0x0008 : 0)  \
+                                | ((INT16U)rl ? 0x0004 : 0))
+// Function Set                                       0 0 0 0 1 dln f * *
+#define LCD_FUNCTION(dl, n, f) (0x0020                       \
+                                | ((INT16U)dl ? 0x0010 : 0)  \
+                                | ((INT16U)n  ? 0x0008 : 0)  \
+                                | ((INT16U)f  ? 0x0004 : 0))
+// Set CG RAM Address                                 0 0 0 1 ----acg-----
+#define LCD_CG_RAM(acg)        (0x0040                       \
+                                | ((INT16U)agc  & 0x003F))
+// Set DD RAM Address                                 0 0 1 -----add------
+#define LCD_DD_RAM(add)        (0x0080                       \
+                                | (((INT16U)add)  & 0x007F))
+// Write Data to CG or DD RAM                         0 1 ------data------
+#define LCD_WRITE(data)        (0x0100                       \
+                                | ((INT16U)data & 0x00FF))
+
+/******************************************************************************
+  lcdInit() - Initializes the LCD hardware                       (Private)
+
+        Runs the 4-bit reset sequence, then leaves the display on with the
+        cursor off and DDRAM address 0 selected.
+******************************************************************************/
+static void lcdInit(void) {
+
+    SIM->SCGC5 |= SIM_SCGC5_PORTD_MASK;              /* Enable clock gate for PORTD */
+    PORTD->PCR[1]=(0|PORT_PCR_MUX(1));
+    PORTD->PCR[2]=(0|PORT_PCR_MUX(1));
+    PORTD->PCR[3]=(0|PORT_PCR_MUX(1));
+    PORTD->PCR[4]=(0|PORT_PCR_MUX(1));
+    PORTD->PCR[5]=(0|PORT_PCR_MUX(1));
+    PORTD->PCR[6]=(0|PORT_PCR_MUX(1));
+    INIT_BIT_DIR();
+    LCD_CLR_E();
+    LCD_SET_RS();           /*Data select unless in LcdWrCmd()  */
+    lcdDlyus(15000);           /* LCD requires 15ms delay at powerup */
+
+    LCD_CLR_RS();           /*Send first command for RESET sequence*/
+    LCD_WR_DB(0x3);
+    LCD_SET_E();
+    lcdDly500ns();
+    LCD_CLR_E();
+    lcdDlyus(4200);            /*Wait >4.1ms */
+
+    LCD_WR_DB(0x3);         /*Repeat */
+    LCD_SET_E();
+    lcdDly500ns();
+    LCD_CLR_E();
+    lcdDlyus(101);            /*Wait >100us */
+
+    LCD_WR_DB(0x3);         /* Repeat */
+    LCD_SET_E();
+    lcdDly500ns();
+    LCD_CLR_E();
+    lcdDlyus(41);           /*Wait >40us*/
+
+    LCD_WR_DB(0x2);         /*Send last command for RESET sequence*/
+    LCD_SET_E();
+    lcdDly500ns();
+    LCD_CLR_E();
+    lcdDlyus(41);
+
+    lcdWrite(LCD_FUNCTION(0, (LCD_NUM_ROWS > 1), 0)); /*Send command for 4-bit mode */
+    lcdWrite(LCD_ENTRY_MODE(1, 0)); // Increment, no shift
+    lcdWrite(LCD_ON_OFF(1, 0, 0));  // LCD on, cursor off, blink off
+    lcdWrite(LCD_CLR_DISP());       // Clear display
+    lcdDlyus(1650);
+    lcdWrite(LCD_DD_RAM(0x0000));   // Reset cursor
+}
+
+/*************************************************************************
+  lcdMoveTo() - Sets the DDRAM address of the next character     (Private)
+*************************************************************************/
+static void lcdMoveTo(INT8U row_index, INT8U col_index) {
+    if((row_index < LCD_NUM_ROWS) && (col_index < LCD_NUM_COLS)){
+        lcdWrite(LCD_DD_RAM(LCD_ROW_ADDR(row_index) + col_index));
+    }else{ //outside display
+    }
+}
+
+/*************************************************************************
+  lcdPutChar() - Writes a character at the current DDRAM address (Private)
+*************************************************************************/
+static void lcdPutChar(INT8C c) {
+    lcdWrite(LCD_WRITE(c));
+}
+
+/********************************************************************
+** lcdCursor()                                              (Private)
+*
+*  PARAMETERS: row_index - Destination row, zero based.
+*              col_index - Destination column, zero based.
+*              on - (Binary)Turn cursor on if TRUE, off if FALSE.
+*              blink - (Binary)Cursor blinks if TRUE.
+*
+*  DESCRIPTION: Moves the cursor to [row_index,col_index] and
+*               changes the LCD cursor state.
+*
+*  RETURNS: None
+********************************************************************/
+static void lcdCursor(INT8U row_index, INT8U col_index, INT8U on, INT8U blink) {
+    lcdMoveTo(row_index, col_index);
+    lcdWrite(LCD_ON_OFF(1, on, blink));
+}
+
+/******************************************************************************
+  lcdWrite() - Writes a command (both data and control busses)   (Private)
+               to the LCD.
+               data is a 16-bit value bits 9-15 are not used, bit 8 is the
+               register select, bits 0-7 is the character or command.
+
+******************************************************************************/
+static void lcdWrite(INT16U data) {
+    INT8U c;
+    // Set/Reset RS
+    if((data & 0x0100) == 0x0100){
+        LCD_SET_RS(); //data write
+    }else{
+        LCD_CLR_RS(); //command write
+    }
+
+    c = (INT8U)data;
+    // Write character/command to LCD
+    LCD_WR_DB((c>>4));
+    LCD_SET_E();
+    lcdDly500ns();
+    LCD_CLR_E();
+    lcdDly500ns();
+    lcdDly500ns();
+    LCD_WR_DB((c&0x0f));
+    LCD_SET_E();
+    lcdDly500ns();
+    LCD_CLR_E();
+    lcdDlyus(41);
+}
+
+/*************************************************************************
+  lcdDlyus() - Blocks for the passed number of microseconds      (Private)
+*************************************************************************/
+static void lcdDlyus(INT16U us) {
+    INT16U cnt;
+
+    for(cnt = 0; cnt <= us; cnt++) {
+        lcdDly500ns();
+        lcdDly500ns();
+    }
+
+}
+
+
+/********************************************************************
+** lcdDly500ns(void)
+*   Delays, at least, 500ns
+*   Designed for 120MHz or 150MHz clock.
+ *  Tdly >= (66.5ns)i (at 150MHz)
+ * Currently set to ~532ns with i=8.
+ * TDM 01/20/2013
+********************************************************************/
+static void lcdDly500ns(void){
+    INT32U i;
+    for(i=0;i<8;i++){
+    }
+}
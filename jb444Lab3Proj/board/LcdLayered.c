@@ -13,6 +13,9 @@
 *                It is derived from the work of Matthew Cohn, 2/26/2008
 *                
 *                Cursor code is derived from Keegan Morrow, 02/22/2013  
+*
+*                The display itself is driven through an LCD_DRIVER back-end
+*                (see LcdDriver.h), selected with APP_CFG_LCD_DRIVER.
 *                                                                        
 * Todd Morton, 02/26/2013, First Revised Release
 * 01/22/2015, Added to git repo, general clean up. TDM
@@ -30,35 +33,66 @@
 #include "app_cfg.h"
 #include "os.h"
 #include "LcdLayered.h"
+#include "LcdDriver.h"
 #include "K65TWR_GPIO.h"
-#include "math.h"
-
-/*****************************************************************************************
-* LCD Port Defines 
-*****************************************************************************************/
-#define LCD_RS_BIT     0x2
-#define LCD_E_BIT      0x4
-#define LCD_DB_MASK    0x78
-#define LCD_PORT       GPIOD->PDOR
-#define LCD_PORT_DIR   GPIOD->PDDR
-#define INIT_BIT_DIR() (LCD_PORT_DIR |= (LCD_RS_BIT|LCD_E_BIT|LCD_DB_MASK))
-#define LCD_SET_RS()   GPIOD->PSOR = LCD_RS_BIT
-#define LCD_CLR_RS()   GPIOD->PCOR = LCD_RS_BIT
-#define LCD_SET_E()    GPIOD->PSOR = LCD_E_BIT
-#define LCD_CLR_E()    GPIOD->PCOR = LCD_E_BIT
-#define LCD_WR_DB(nib) (GPIOD->PDOR = (GPIOD->PDOR & ~LCD_DB_MASK)|((nib)<<3))
-
 
 /*****************************************************************************************
 * LCD Defines                                                                            *
 *****************************************************************************************/
 // LCD Configuration
-#define LCD_NUM_ROWS   2
-#define LCD_NUM_COLS   16
-
-#define LCD_ENABLE     0x04
+// LCD_NUM_ROWS and LCD_NUM_COLS come from LcdDriver.h
 #define LCD_CLEAR_BYTE 0x20    //SPACE is set as the transparent character
 
+// Layers are composited a 32-bit word (four cells) at a time using a
+// per-row opacity mask, one bit per column.
+#define LCD_CELLS_PER_WORD  4
+#define LCD_WORDS_PER_ROW   (LCD_NUM_COLS/LCD_CELLS_PER_WORD)
+#if (LCD_NUM_COLS > 32) || ((LCD_NUM_COLS % LCD_CELLS_PER_WORD) != 0)
+#error "LCD_NUM_COLS must be a multiple of 4 and no more than 32"
+#endif
+
+#define LCD_DEC_FIELD_MAX   10      // Digits in the largest INT32U
+
+// Command queue for the non-blocking API. Must be a power of two.
+#ifdef APP_CFG_LCD_CMD_Q_SIZE
+#define LCD_CMD_Q_SIZE      APP_CFG_LCD_CMD_Q_SIZE
+#else
+#define LCD_CMD_Q_SIZE      16u
+#endif
+#define LCD_CMD_Q_MASK      (LCD_CMD_Q_SIZE - 1u)
+#if (LCD_CMD_Q_SIZE & LCD_CMD_Q_MASK) != 0
+#error "LCD_CMD_Q_SIZE must be a power of two"
+#endif
+
+#if LCD_NUM_COLS > LCD_DEC_FIELD_MAX
+#define LCD_CMD_TEXT_LEN    LCD_NUM_COLS
+#else
+#define LCD_CMD_TEXT_LEN    LCD_DEC_FIELD_MAX
+#endif
+
+// Queued command operations
+typedef enum {
+    LCD_CMD_TEXT,           // Write len characters starting at row/col
+    LCD_CMD_CLR_LAYER,      // Clear the whole layer
+    LCD_CMD_CLR_LINE        // Clear row of the layer
+} LCD_CMD_OP;
+
+// Queued command, row and col are zero based
+typedef struct {
+    INT8U op;
+    INT8U layer;
+    INT8U row;
+    INT8U col;
+    INT8U len;
+    INT8C text[LCD_CMD_TEXT_LEN];
+} LCD_CMD;
+
+// Queue slot. seq tells producers and the consumer who owns the slot.
+typedef struct {
+    volatile CPU_DATA seq;
+    LCD_CMD cmd;
+} LCD_CMD_SLOT;
+
 // LCD Cursor typedef
 typedef struct {
     INT8U col;
@@ -68,8 +102,15 @@ typedef struct {
 }LCD_CURSOR;
 
 // LCD layer and buffer typdedef
+//   opaque - bit n of opaque[row] is set when column n is not LCD_CLEAR_BYTE
+//   gen    - incremented every time the layer is modified
 typedef struct {
-    INT8C lcd_char[LCD_NUM_ROWS][LCD_NUM_COLS];
+    union {
+        INT8C lcd_char[LCD_NUM_ROWS][LCD_NUM_COLS];
+        INT32U lcd_word[LCD_NUM_ROWS][LCD_WORDS_PER_ROW];
+    };
+    INT32U opaque[LCD_NUM_ROWS];
+    INT32U gen;
     INT8U hidden;
     LCD_CURSOR cursor;
 } LCD_BUFFER;
@@ -77,16 +118,25 @@ typedef struct {
 /*************************************************************************
   Private Local Functions
 *************************************************************************/
-static void lcdDlyus(INT16U us);
-static void lcdDly500ns(void);
-static void lcdWrite(INT16U data);
 static void lcdClear(LCD_BUFFER *buffer);
+static void lcdPutChar(LCD_BUFFER *buffer, INT8U row_index, INT8U col_index,
+                       INT8C c);
 
-static void lcdFlattenLayers(LCD_BUFFER *dest_buffer,
-                             LCD_BUFFER *src_layers);
+static INT8U lcdFlattenLayers(LCD_BUFFER *dest_buffer,
+                              LCD_BUFFER *src_layers);
 static void lcdWriteBuffer(LCD_BUFFER *buffer);
-static void lcdMoveCursor(INT8U row, INT8U col);
-static void lcdCursorDispMode(INT8U on, INT8U blink);
+static void lcdSetHidden(INT8U layer, INT8U hidden);
+static INT8U lcdFmtDecWord(INT8C *dest, INT32U binword, INT8U field, LCD_MODE mode);
+
+static void lcdCmdQInit(void);
+static INT8U lcdCmdPost(const LCD_CMD *cmd);
+static INT8U lcdCmdReplace(const LCD_CMD *cmd);
+static INT8U lcdCmdDropOldest(const LCD_CMD *cmd);
+static INT8U lcdCmdCells(const LCD_CMD *cmd, INT8U *row_first, INT8U *row_last,
+                         INT8U *col_first, INT8U *col_last);
+static INT8U lcdCmdGet(LCD_CMD *cmd);
+static void lcdCmdApply(const LCD_CMD *cmd);
+static void lcdCmdDrain(void);
 
 /*************************************************************************
   MicroC/OS Resources
@@ -100,52 +150,29 @@ static CPU_STK  lcdLayeredTaskStk[APP_CFG_LCD_TASK_STK_SIZE];
   Global Variables
 *************************************************************************/
 // Stored Constants
-static const INT8U lcdRowAddress[LCD_NUM_ROWS] = {0x00, 0x40};
+static const LCD_DRIVER *const lcdDriver = &LCD_DRIVER_DEFAULT;
+
+// Expands a 4-bit slice of an opacity mask to a byte-select word.
+// Cortex-M4 is little endian so the cell in the lowest column is the LSB.
+static const INT32U lcdByteSelect[16] = {
+    0x00000000, 0x000000FF, 0x0000FF00, 0x0000FFFF,
+    0x00FF0000, 0x00FF00FF, 0x00FFFF00, 0x00FFFFFF,
+    0xFF000000, 0xFF0000FF, 0xFF00FF00, 0xFF00FFFF,
+    0xFFFF0000, 0xFFFF00FF, 0xFFFFFF00, 0xFFFFFFFF
+};
 
 // Static Globals
 static LCD_BUFFER lcdBuffer;
 static LCD_BUFFER lcdPreviousBuffer;
 static LCD_BUFFER lcdLayers[LCD_NUM_LAYERS];
+static INT32U lcdFlatGen[LCD_NUM_LAYERS];   // Layer generations in lcdBuffer
+
+// Command queue. Multiple producers, lcdLayeredTask is the only consumer.
+static LCD_CMD_SLOT lcdCmdQ[LCD_CMD_Q_SIZE];
+static volatile CPU_DATA lcdCmdQIn;
+static volatile CPU_DATA lcdCmdQOut;
+static volatile CPU_DATA lcdCmdDropCnt;
 
-/*************************************************************************
-  LCD Command Macros
-*************************************************************************/
-/*                                                    R R D D D D D D D D
-                                                      / S B B B B B B B B
-                                                      W   7 6 5 4 3 2 1 0
-*/
-// Clear Display                                      0 0 0 0 0 0 0 0 0 1
-#define LCD_CLR_DISP()         (0x0001)      
-// Return Home                                        0 0 0 0 0 0 0 0 1 *
-#define LCD_CUR_HOME()         (0x0002)      
-// Entry Mode Set                                     0 0 0 0 0 0 0 1 ids
-#define LCD_ENTRY_MODE(id, s)  (0x0004                       \
-                                | ((INT16U)id ? 0x0002 : 0)  \
-                                | ((INT16U)s  ? 0x0001 : 0))
-// Display ON/OFF Control                             0 0 0 0 0 0 1 d c b
-#define LCD_ON_OFF(d, c, b)    (0x0008                       \
-                                | ((INT16U)d  ? 0x0004 : 0)  \
-                                | ((INT16U)c  ? 0x0002 : 0)  \
-                                | ((INT16U)b  ? 0x0001 : 0))
-// Cursor or Display Shift                            0 0 0 0 0 1 scrl* *
-#define LCD_SHIFT(sc, rl)      (0x0010                       \
-                                | ((INT16U)sc ? 0x0008 : 0)  \
-                                | ((INT16U)rl ? 0x0004 : 0))
-// Function Set                                       0 0 0 0 1 dln f * *
-#define LCD_FUNCTION(dl, n, f) (0x0020                       \
-                                | ((INT16U)dl ? 0x0010 : 0)  \
-                                | ((INT16U)n  ? 0x0008 : 0)  \
-                                | ((INT16U)f  ? 0x0004 : 0))
-// Set CG RAM Address                                 0 0 0 1 ----acg-----
-#define LCD_CG_RAM(acg)        (0x0040                       \
-                                | ((INT16U)agc  & 0x003F))
-// Set DD RAM Address                                 0 0 1 -----add------
-#define LCD_DD_RAM(add)        (0x0080                       \
-                                | (((INT16U)add)  & 0x007F))
-// Write Data to CG or DD RAM                         0 1 ------data------
-#define LCD_WRITE(data)        (0x0100                       \
-                                | ((INT16U)data & 0x00FF))
-                                                                       
 /******************************************************************************
   lcdLayeredTask() - Handles writing to the LCD module      (Private Task)
   
@@ -169,9 +196,15 @@ static void lcdLayeredTask(void *p_arg) {
     	DB3_TURN_OFF();
         OSTaskSemPend(0,OS_OPT_PEND_BLOCKING,(CPU_TS *)0, &os_err);
     	DB3_TURN_ON();
+
+        // Apply everything queued by the non-blocking API as one batch
+        lcdCmdDrain();
         
-        lcdFlattenLayers(&lcdBuffer, (LCD_BUFFER *)&lcdLayers);
-        lcdWriteBuffer(&lcdBuffer);
+        // Only rewrite the display if a layer changed since the last pass
+        if(lcdFlattenLayers(&lcdBuffer, (LCD_BUFFER *)&lcdLayers) == TRUE){
+            lcdWriteBuffer(&lcdBuffer);
+        }else{
+        }
     }
 }
 
@@ -202,6 +235,7 @@ INT8U LcdCursor(INT8U row, INT8U col, INT8U layer, INT8U on, INT8U blink){
         }else{
             lcdLayers[layer].cursor.on = FALSE;
         }
+        lcdLayers[layer].gen++;
     }else{
         noerr = FALSE;
     }
@@ -228,6 +262,7 @@ void LcdDispClear(INT8U layer) {
     }
 
     lcdClear(llayer);
+    llayer->gen++;
 
     (void)OSMutexPost(&lcdLayersKey, OS_OPT_POST_NONE, &os_err);
     while(os_err != OS_ERR_NONE){           /* Error Trap                        */
@@ -260,6 +295,8 @@ void LcdDispClrLine(INT8U row, INT8U layer) {
         // Clear the character at that position
         llayer->lcd_char[row-1][col] = LCD_CLEAR_BYTE;
     }
+    llayer->opaque[row-1] = 0;
+    llayer->gen++;
     
     (void)OSMutexPost(&lcdLayersKey, OS_OPT_POST_NONE, &os_err);
     while(os_err != OS_ERR_NONE){           /* Error Trap                        */
@@ -299,10 +336,11 @@ void LcdDispString(INT8U row,
     
         if((col_index+cnt) < LCD_NUM_COLS){ // not at end of row
             // Copy from the passed paramater to the layer
-            llayer->lcd_char[row_index][col_index+cnt] = string[cnt];
+            lcdPutChar(llayer, row_index, col_index+cnt, string[cnt]);
         }else{ //outside buffer
         }
     }
+    llayer->gen++;
     
     (void)OSMutexPost(&lcdLayersKey, OS_OPT_POST_NONE, &os_err);
     while(os_err != OS_ERR_NONE){           /* Error Trap                        */
@@ -338,7 +376,8 @@ void LcdDispChar(INT8U row,
         }
     
         // Copy from the passed paramater to the layer
-        llayer->lcd_char[row_index][col_index] = character;
+        lcdPutChar(llayer, row_index, col_index, character);
+        llayer->gen++;
     
         (void)OSMutexPost(&lcdLayersKey, OS_OPT_POST_NONE, &os_err);
         while(os_err != OS_ERR_NONE){           /* Error Trap                        */
@@ -363,6 +402,8 @@ void LcdDispByte(INT8U row, INT8U col, INT8U layer, INT8U byte) {
     OS_ERR os_err;
     INT8U row_index;
     INT8U col_index;
+    INT8C msb;
+    INT8C lsb;
     LCD_BUFFER *llayer = &lcdLayers[layer];
     
     // Convert row / col index 1 to index 0
@@ -370,20 +411,20 @@ void LcdDispByte(INT8U row, INT8U col, INT8U layer, INT8U byte) {
     col_index = col - 1;
     
     if(col < LCD_NUM_COLS){
+        msb = (INT8C)(byte >> 4);
+        lsb = (INT8C)(byte & 0x0F);
+
+        // Convert MSB and LSB to ASCII characters
+        msb += (msb <= 9 ? '0' : 'A' - 10);
+        lsb += (lsb <= 9 ? '0' : 'A' - 10);
+
         OSMutexPend(&lcdLayersKey, 0, OS_OPT_PEND_BLOCKING, (CPU_TS *)0, &os_err);
         while(os_err != OS_ERR_NONE){           /* Error Trap                        */
         }
 
-        llayer->lcd_char[row_index][col_index+0] = (byte >> 4);   // MSB
-        llayer->lcd_char[row_index][col_index+1] = (byte & 0x0F); // LSB
-    
-        // Convert MSB to ASCII character
-        llayer->lcd_char[row_index][col_index+0] +=
-            (llayer->lcd_char[row_index][col_index+0] <= 9 ? '0' : 'A' - 10);
-
-        // Convert LSB to ASCII character
-        llayer->lcd_char[row_index][col_index+1] +=
-            (llayer->lcd_char[row_index][col_index+1] <= 9 ? '0' : 'A' - 10);
+        lcdPutChar(llayer, row_index, col_index+0, msb);
+        lcdPutChar(llayer, row_index, col_index+1, lsb);
+        llayer->gen++;
 
 
         (void)OSMutexPost(&lcdLayersKey, OS_OPT_POST_NONE, &os_err);
@@ -422,15 +463,9 @@ void LcdDispDecWord(INT8U row,
                     INT8U field,
                     LCD_MODE mode){
     OS_ERR os_err;
-    INT8C digits[10];
-    INT32U lbinword = binword;
-    INT8U num_zeros = field;
-    INT32U max_field_num;
-    INT8U dig_num;
-    INT8U zero_flag = 0;
-    INT8U align_left_offset;
-    INT8U align_left_flag = 0;
-
+    INT8C digits[LCD_DEC_FIELD_MAX];
+    INT8U len;
+    INT8U i;
     INT8U row_index;
     INT8U col_index;
     LCD_BUFFER *llayer = &lcdLayers[layer];
@@ -440,79 +475,85 @@ void LcdDispDecWord(INT8U row,
         row_index = row - 1;
         col_index = col - 1;
 
-        //Clamp leading zeros to acceptable values
-        if(num_zeros > 10){
-            num_zeros = 10;
-        }else if(num_zeros < 1){
-            num_zeros = 1;
-        }else{
-        }
-    }else{
-    }
+        len = lcdFmtDecWord(digits, binword, field, mode);
 
-    //Calculates maximum bin parameter
-    max_field_num = pow(10,field) - 1;
-    if(lbinword > max_field_num){  //Writes '-' to all field slots if bin length exceeded
-        while(num_zeros != 0){
-            llayer->lcd_char[row_index][col_index+field-num_zeros] = '-';
-            num_zeros--;
+        OSMutexPend(&lcdLayersKey, 0, OS_OPT_PEND_BLOCKING, (CPU_TS *)0, &os_err);
+        while(os_err != OS_ERR_NONE){           /* Error Trap                        */
         }
-        num_zeros = field;
-    }else{
 
-        //Clears field before writing to avoid leftover characters
-        for(INT8U i = 0; i < field; i++){
-            llayer->lcd_char[row_index][col_index+i] = ' ';
-        }
-
-        //Convert to ASCII, find offset if in left align mode
-        dig_num = 0;
-        while(dig_num < 10){
-            digits[dig_num] = (INT8C)((lbinword % 10) +'0');
-            lbinword = lbinword/10;
-            dig_num++;
-            if(lbinword == 0 && mode == LCD_DEC_MODE_AL && align_left_flag != 1){ //Calculates offset for left align
-                align_left_offset = field - dig_num + 1;
-                align_left_flag = 1;
-            }else{
-            }
+        for(i = 0; i < len; i++){
+            lcdPutChar(llayer, row_index, col_index+i, digits[i]);
         }
+        llayer->gen++;
 
-        OSMutexPend(&lcdLayersKey, 0, OS_OPT_PEND_BLOCKING, (CPU_TS *)0, &os_err);
+        (void)OSMutexPost(&lcdLayersKey, OS_OPT_POST_NONE, &os_err);
         while(os_err != OS_ERR_NONE){           /* Error Trap                        */
         }
 
-        //Display ascii digits
-        dig_num = 9;
-        while(dig_num > 0){
-            if(((digits[dig_num] != '0') || (dig_num < num_zeros)) && mode == LCD_DEC_MODE_LZ){
-                llayer->lcd_char[row_index][col_index+field-1-dig_num] = digits[dig_num];
-            }else if(((digits[dig_num] != '0') || (zero_flag == 1)) && mode == LCD_DEC_MODE_AR){
-                zero_flag = 1;
-                llayer->lcd_char[row_index][col_index+field-1-dig_num] = digits[dig_num];
-            }else if(((digits[dig_num] != '0') || (zero_flag == 1)) && mode == LCD_DEC_MODE_AL){
-                zero_flag = 1;
-                llayer->lcd_char[row_index][col_index+field-dig_num-align_left_offset] = digits[dig_num];
-            }else{
-            }
-            dig_num--;
+        //We have modified a layer
+        (void)OSTaskSemPost(&lcdLayeredTaskTCB,OS_OPT_POST_NONE,&os_err);
+        while(os_err != OS_ERR_NONE){           /* Error Trap                        */
         }
+    }else{ //outside layer
+    }
+}
 
-        if(mode == LCD_DEC_MODE_LZ || mode == LCD_DEC_MODE_AR){
-            llayer->lcd_char[row_index][col_index+field-1-dig_num] = digits[0];
-        }else if(mode == LCD_DEC_MODE_AL){
-            llayer->lcd_char[row_index][col_index+field-dig_num-align_left_offset] = digits[0];
-        }else{
-        }(void)OSMutexPost(&lcdLayersKey, OS_OPT_POST_NONE, &os_err);
-         while(os_err != OS_ERR_NONE){           /* Error Trap                        */
-         }
+/*********************************************************************************************
+* lcdFmtDecWord() - Formats binword into a decimal field for LcdDispDecWord()      (Private)
+*    Writes exactly field characters (field is clamped to 1-10) to dest and returns
+*    the count. Unused digit positions are spaces, an oversized binword gives all '-'.
+*    See LcdDispDecWord() for the modes.
+*********************************************************************************************/
+static INT8U lcdFmtDecWord(INT8C *dest, INT32U binword, INT8U field, LCD_MODE mode){
+    static const INT32U pow10[LCD_DEC_FIELD_MAX] = {
+        1u, 10u, 100u, 1000u, 10000u, 100000u,
+        1000000u, 10000000u, 100000000u, 1000000000u
+    };
+    INT8U ndigits;
+    INT8U i;
+
+    //Clamp field to acceptable values
+    if(field > LCD_DEC_FIELD_MAX){
+        field = LCD_DEC_FIELD_MAX;
+    }else if(field < 1){
+        field = 1;
+    }else{
     }
 
-    //We have modified a layer
-    (void)OSTaskSemPost(&lcdLayeredTaskTCB,OS_OPT_POST_NONE,&os_err);
-    while(os_err != OS_ERR_NONE){           /* Error Trap                        */
+    //Count significant digits, zero still shows one digit
+    ndigits = 1;
+    while((ndigits < LCD_DEC_FIELD_MAX) && (binword >= pow10[ndigits])){
+        ndigits++;
     }
 
+    if(ndigits > field){  //Writes '-' to all field slots if bin length exceeded
+        for(i = 0; i < field; i++){
+            dest[i] = '-';
+        }
+    }else{
+        //Clears field before writing to avoid leftover characters
+        for(i = 0; i < field; i++){
+            dest[i] = ' ';
+        }
+        if(mode == LCD_DEC_MODE_LZ){
+            ndigits = field;
+        }else{
+        }
+
+        //Digits fill from the right end of the field, or the left for MODE_AL
+        if(mode == LCD_DEC_MODE_AL){
+            i = ndigits;
+        }else{
+            i = field;
+        }
+        while(ndigits != 0){
+            i--;
+            dest[i] = (INT8C)((binword % 10) + '0');
+            binword = binword/10;
+            ndigits--;
+        }
+    }
+    return(field);
 }
 
 /*************************************************************************
@@ -543,18 +584,19 @@ void LcdDispTime(INT8U row,
         }
     
 
-        llayer->lcd_char[row_index][col_index+0] = hrs / 10 + '0';
-        llayer->lcd_char[row_index][col_index+1] = hrs % 10 + '0';
+        lcdPutChar(llayer, row_index, col_index+0, hrs / 10 + '0');
+        lcdPutChar(llayer, row_index, col_index+1, hrs % 10 + '0');
 
-        llayer->lcd_char[row_index][col_index+2] = ':';
+        lcdPutChar(llayer, row_index, col_index+2, ':');
 
-        llayer->lcd_char[row_index][col_index+3] = mins / 10 + '0';
-        llayer->lcd_char[row_index][col_index+4] = mins % 10 + '0';
+        lcdPutChar(llayer, row_index, col_index+3, mins / 10 + '0');
+        lcdPutChar(llayer, row_index, col_index+4, mins % 10 + '0');
 
-        llayer->lcd_char[row_index][col_index+5] = ':';
+        lcdPutChar(llayer, row_index, col_index+5, ':');
 
-        llayer->lcd_char[row_index][col_index+6] = secs / 10 + '0';
-        llayer->lcd_char[row_index][col_index+7] = secs % 10 + '0';
+        lcdPutChar(llayer, row_index, col_index+6, secs / 10 + '0');
+        lcdPutChar(llayer, row_index, col_index+7, secs % 10 + '0');
+        llayer->gen++;
     
            
         (void)OSMutexPost(&lcdLayersKey, OS_OPT_POST_NONE, &os_err);
@@ -568,6 +610,455 @@ void LcdDispTime(INT8U row,
 }
 
 
+/*************************************************************************
+  LcdDispCharAsync() - Queues a character for a layer             (Public)
+
+                       Never blocks. Posts the lcdModifiedFlag semaphore
+
+                       RETURNS: TRUE if queued, FALSE if dropped
+*************************************************************************/
+INT8U LcdDispCharAsync(INT8U row, INT8U col, INT8U layer, INT8C c) {
+    LCD_CMD cmd;
+    INT8U queued = FALSE;
+
+    if((layer < LCD_NUM_LAYERS) && (row >= 1) && (row <= LCD_NUM_ROWS)
+        && (col >= 1) && (col <= LCD_NUM_COLS)){
+        cmd.op = LCD_CMD_TEXT;
+        cmd.layer = layer;
+        cmd.row = row - 1;
+        cmd.col = col - 1;
+        cmd.len = 1;
+        cmd.text[0] = c;
+        queued = lcdCmdPost(&cmd);
+    }else{ //outside layer
+    }
+    return(queued);
+}
+
+/*************************************************************************
+  LcdDispStringAsync() - Queues a null terminated string          (Public)
+
+                         Characters past the end of the row are dropped.
+                         Never blocks. Posts the lcdModifiedFlag semaphore
+
+                         RETURNS: TRUE if queued, FALSE if dropped
+*************************************************************************/
+INT8U LcdDispStringAsync(INT8U row, INT8U col, INT8U layer,
+                         const INT8C *string) {
+    LCD_CMD cmd;
+    INT8U cnt;
+    INT8U queued = FALSE;
+
+    if((layer < LCD_NUM_LAYERS) && (row >= 1) && (row <= LCD_NUM_ROWS)
+        && (col >= 1) && (col <= LCD_NUM_COLS)){
+        cmd.op = LCD_CMD_TEXT;
+        cmd.layer = layer;
+        cmd.row = row - 1;
+        cmd.col = col - 1;
+        for(cnt = 0; (string[cnt] != 0x00) && ((cmd.col+cnt) < LCD_NUM_COLS); cnt++){
+            cmd.text[cnt] = string[cnt];
+        }
+        cmd.len = cnt;
+        queued = lcdCmdPost(&cmd);
+    }else{ //outside layer
+    }
+    return(queued);
+}
+
+/*************************************************************************
+  LcdDispDecWordAsync() - Queues a decimal field, see             (Public)
+                          LcdDispDecWord() for field and mode.
+
+                          Never blocks. Posts the lcdModifiedFlag semaphore
+
+                          RETURNS: TRUE if queued, FALSE if dropped
+*************************************************************************/
+INT8U LcdDispDecWordAsync(INT8U row, INT8U col, INT8U layer, INT32U binword,
+                          INT8U field, LCD_MODE mode) {
+    LCD_CMD cmd;
+    INT8U len;
+    INT8U queued = FALSE;
+
+    if((layer < LCD_NUM_LAYERS) && (row >= 1) && (row <= LCD_NUM_ROWS)
+        && (col >= 1) && (col <= LCD_NUM_COLS)){
+        cmd.op = LCD_CMD_TEXT;
+        cmd.layer = layer;
+        cmd.row = row - 1;
+        cmd.col = col - 1;
+        len = lcdFmtDecWord(cmd.text, binword, field, mode);
+        if((cmd.col + len) > LCD_NUM_COLS){
+            len = LCD_NUM_COLS - cmd.col;
+        }else{
+        }
+        cmd.len = len;
+        queued = lcdCmdPost(&cmd);
+    }else{ //outside layer
+    }
+    return(queued);
+}
+
+/*************************************************************************
+  LcdDispClearAsync() - Queues a clear of a layer                 (Public)
+
+                        Never blocks. Posts the lcdModifiedFlag semaphore
+
+                        RETURNS: TRUE if queued, FALSE if dropped
+*************************************************************************/
+INT8U LcdDispClearAsync(INT8U layer) {
+    LCD_CMD cmd;
+    INT8U queued = FALSE;
+
+    if(layer < LCD_NUM_LAYERS){
+        cmd.op = LCD_CMD_CLR_LAYER;
+        cmd.layer = layer;
+        cmd.row = 0;
+        cmd.col = 0;
+        cmd.len = 0;
+        queued = lcdCmdPost(&cmd);
+    }else{ //outside layer
+    }
+    return(queued);
+}
+
+/*************************************************************************
+  LcdDispClrLineAsync() - Queues a clear of one line of a layer   (Public)
+
+                          Never blocks. Posts the lcdModifiedFlag semaphore
+
+                          RETURNS: TRUE if queued, FALSE if dropped
+*************************************************************************/
+INT8U LcdDispClrLineAsync(INT8U row, INT8U layer) {
+    LCD_CMD cmd;
+    INT8U queued = FALSE;
+
+    if((layer < LCD_NUM_LAYERS) && (row >= 1) && (row <= LCD_NUM_ROWS)){
+        cmd.op = LCD_CMD_CLR_LINE;
+        cmd.layer = layer;
+        cmd.row = row - 1;
+        cmd.col = 0;
+        cmd.len = 0;
+        queued = lcdCmdPost(&cmd);
+    }else{ //outside layer
+    }
+    return(queued);
+}
+
+/*************************************************************************
+  LcdDispDropCntGet() - Returns the number of commands dropped    (Public)
+                        because the queue was full, oldest or new.
+*************************************************************************/
+INT32U LcdDispDropCntGet(void) {
+    return(lcdCmdDropCnt);
+}
+
+/*************************************************************************
+  lcdCmdQInit() - Empties the command queue                      (Private)
+
+        Bounded multi-producer queue after D. Vyukov. Each slot carries a
+        sequence number: seq == pos means free for the producer claiming
+        pos, seq == pos+1 means filled and ready for the consumer.
+*************************************************************************/
+static void lcdCmdQInit(void) {
+    CPU_DATA i;
+
+    for(i = 0; i < LCD_CMD_Q_SIZE; i++){
+        lcdCmdQ[i].seq = i;
+    }
+    lcdCmdQIn = 0;
+    lcdCmdQOut = 0;
+    lcdCmdDropCnt = 0;
+}
+
+/*************************************************************************
+  lcdCmdPost() - Adds a command to the queue and wakes the task  (Private)
+
+        Lock-free while there is room. When the queue is full the
+        command takes the place of a queued one that it overwrites
+        completely, see lcdCmdReplace(), which loses nothing. Otherwise
+        the oldest command is dropped to make room for it, see
+        lcdCmdDropOldest(). Either drop is counted. A caller never
+        waits on the LCD task or on another producer.
+
+        RETURNS: TRUE if queued, FALSE if dropped
+*************************************************************************/
+static INT8U lcdCmdPost(const LCD_CMD *cmd) {
+    OS_ERR os_err;
+    LCD_CMD_SLOT *slot;
+    CPU_DATA pos;
+    CPU_DATA drops;
+    INT32S dif;
+    INT8U posted = FALSE;
+    INT8U lost = FALSE;
+    INT8U done = FALSE;
+
+    pos = lcdCmdQIn;
+    while(done == FALSE){
+        slot = &lcdCmdQ[pos & LCD_CMD_Q_MASK];
+        dif = (INT32S)(slot->seq - pos);
+        if(dif == 0){                       // Free, try to claim it
+            if(CPU_AtomicCmpSwap((CPU_DATA *)&lcdCmdQIn, pos, pos + 1u) == DEF_OK){
+                slot->cmd = *cmd;
+                __DMB();
+                slot->seq = pos + 1u;       // Publish to the consumer
+                posted = TRUE;
+                done = TRUE;
+            }else{
+                pos = lcdCmdQIn;
+            }
+        }else if(dif < 0){                  // Full
+            posted = lcdCmdReplace(cmd);
+            if(posted == FALSE){
+                posted = lcdCmdDropOldest(cmd);
+                lost = TRUE;                // The oldest, or this one
+            }else{
+            }
+            done = TRUE;
+        }else{                              // Another producer got it
+            pos = lcdCmdQIn;
+        }
+    }
+
+    if(posted == TRUE){
+        // We have modified a layer
+        (void)OSTaskSemPost(&lcdLayeredTaskTCB, OS_OPT_POST_NONE, &os_err);
+    }else{
+    }
+    if(lost == TRUE){
+        do{
+            drops = lcdCmdDropCnt;
+        }while(CPU_AtomicCmpSwap((CPU_DATA *)&lcdCmdDropCnt, drops, drops + 1u) == DEF_FAIL);
+    }
+    return(posted);
+}
+
+/*************************************************************************
+  lcdCmdReplace() - Puts a command in place of a queued one that (Private)
+                    it covers, on a full queue.
+
+        The queued commands are searched newest first for the first one
+        on the same layer whose cells overlap the new command's. If the
+        new command covers all of its cells it takes its place.
+        Dropping the old command loses nothing, and no later queued
+        command touches those cells, so the layer ends up as if both
+        had been applied in order. Any other overlap, or none, fails.
+
+        Runs with interrupts disabled, so neither the consumer nor
+        another producer can change a slot meanwhile. lcdCmdGet() moves
+        lcdCmdQOut on before it copies a slot, so the slot it is copying
+        is never searched. Slots claimed but not yet published belong to
+        a post that is still under way and are skipped.
+
+        RETURNS: TRUE if the command took a queued command's place
+*************************************************************************/
+static INT8U lcdCmdReplace(const LCD_CMD *cmd) {
+    LCD_CMD_SLOT *slot;
+    CPU_DATA pos;
+    INT8U row_first, row_last, col_first, col_last;
+    INT8U q_row_first, q_row_last, q_col_first, q_col_last;
+    INT8U replaced = FALSE;
+    INT8U done = FALSE;
+    CPU_SR_ALLOC();
+
+    if(lcdCmdCells(cmd, &row_first, &row_last, &col_first, &col_last) == TRUE){
+        CPU_CRITICAL_ENTER();
+        pos = lcdCmdQIn;
+        while((done == FALSE) && (pos != lcdCmdQOut)){
+            pos--;
+            slot = &lcdCmdQ[pos & LCD_CMD_Q_MASK];
+            if((slot->seq == (pos + 1u)) && (slot->cmd.layer == cmd->layer)
+                && (lcdCmdCells(&slot->cmd, &q_row_first, &q_row_last,
+                                &q_col_first, &q_col_last) == TRUE)
+                && (q_row_first <= row_last) && (row_first <= q_row_last)
+                && (q_col_first <= col_last) && (col_first <= q_col_last)){
+                if((row_first <= q_row_first) && (q_row_last <= row_last)
+                    && (col_first <= q_col_first) && (q_col_last <= col_last)){
+                    slot->cmd = *cmd;       // Covered, take its place
+                    replaced = TRUE;
+                }else{                      // Partly overlapped, keep order
+                }
+                done = TRUE;
+            }else{ //Unpublished, other layer or disjoint
+            }
+        }
+        CPU_CRITICAL_EXIT();
+    }else{ //Writes no cells, nothing to gain
+    }
+    return(replaced);
+}
+
+/*************************************************************************
+  lcdCmdDropOldest() - Puts a command in place of the oldest     (Private)
+                       one, on a full queue.
+
+        The oldest command is dropped and the new one is queued behind
+        the others, in the slot the oldest had, so the queue moves on
+        by one at both ends. The layers then end up as the latest posts
+        left them, less the oldest write, which later writes are the
+        likeliest to have overwritten.
+
+        Runs with interrupts disabled, like lcdCmdReplace(). The oldest
+        slot must be published and not yet claimed by lcdCmdGet(),
+        which claims it by moving lcdCmdQOut on with a compare and swap,
+        so it cannot copy out the new command in the old one's place.
+        While the LCD task is copying the oldest out the new command is
+        dropped instead.
+
+        RETURNS: TRUE if the command took the oldest command's place
+*************************************************************************/
+static INT8U lcdCmdDropOldest(const LCD_CMD *cmd) {
+    LCD_CMD_SLOT *slot;
+    CPU_DATA in;
+    CPU_DATA out;
+    INT8U queued = FALSE;
+    CPU_SR_ALLOC();
+
+    CPU_CRITICAL_ENTER();
+    in = lcdCmdQIn;
+    out = lcdCmdQOut;
+    slot = &lcdCmdQ[out & LCD_CMD_Q_MASK];
+    if(((in - out) == LCD_CMD_Q_SIZE) && (slot->seq == (out + 1u))){
+        slot->cmd = *cmd;
+        lcdCmdQOut = out + 1u;
+        lcdCmdQIn = in + 1u;
+        slot->seq = in + 1u;                // Published at the new end
+        queued = TRUE;
+    }else{ //LCD task is taking the oldest out
+    }
+    CPU_CRITICAL_EXIT();
+    return(queued);
+}
+
+/*************************************************************************
+  lcdCmdCells() - Gets the cells a command writes, zero based    (Private)
+
+        RETURNS: TRUE if the command writes at least one cell
+*************************************************************************/
+static INT8U lcdCmdCells(const LCD_CMD *cmd, INT8U *row_first, INT8U *row_last,
+                         INT8U *col_first, INT8U *col_last) {
+    INT8U cells = TRUE;
+
+    switch(cmd->op){
+    case LCD_CMD_TEXT:
+        *row_first = cmd->row;
+        *row_last = cmd->row;
+        *col_first = cmd->col;
+        *col_last = cmd->col + cmd->len - 1;
+        cells = (cmd->len != 0) ? TRUE : FALSE;
+        break;
+    case LCD_CMD_CLR_LAYER:
+        *row_first = 0;
+        *row_last = LCD_NUM_ROWS - 1;
+        *col_first = 0;
+        *col_last = LCD_NUM_COLS - 1;
+        break;
+    case LCD_CMD_CLR_LINE:
+        *row_first = cmd->row;
+        *row_last = cmd->row;
+        *col_first = 0;
+        *col_last = LCD_NUM_COLS - 1;
+        break;
+    default:
+        cells = FALSE;
+        break;
+    }
+    return(cells);
+}
+
+/*************************************************************************
+  lcdCmdGet() - Removes the oldest command from the queue        (Private)
+
+        Only lcdLayeredTask calls it. lcdCmdQOut is moved on before the
+        slot is copied, see lcdCmdReplace(), and with a compare and swap,
+        as lcdCmdDropOldest() may move it on first.
+
+        RETURNS: TRUE if *cmd was filled, FALSE if nothing is ready
+*************************************************************************/
+static INT8U lcdCmdGet(LCD_CMD *cmd) {
+    LCD_CMD_SLOT *slot;
+    CPU_DATA pos;
+    INT8U got = FALSE;
+    INT8U done = FALSE;
+
+    pos = lcdCmdQOut;
+    while(done == FALSE){
+        slot = &lcdCmdQ[pos & LCD_CMD_Q_MASK];
+        if(slot->seq == (pos + 1u)){        // Published, try to claim it
+            if(CPU_AtomicCmpSwap((CPU_DATA *)&lcdCmdQOut, pos, pos + 1u) == DEF_OK){
+                __DMB();
+                *cmd = slot->cmd;
+                __DMB();
+                slot->seq = pos + LCD_CMD_Q_SIZE;   // Free for the next lap
+                got = TRUE;
+                done = TRUE;
+            }else{                          // Dropped by a producer
+                pos = lcdCmdQOut;
+            }
+        }else{ //Empty or not yet published
+            done = TRUE;
+        }
+    }
+    return(got);
+}
+
+/*************************************************************************
+  lcdCmdDrain() - Applies all queued commands to the layers      (Private)
+
+        Commands are applied in order under one hold of lcdLayersKey.
+        The layers are then flattened and written to the display once
+        for the whole batch, not once per command.
+
+                       Pends on the lcdLayersKey mutex
+*************************************************************************/
+static void lcdCmdDrain(void) {
+    OS_ERR os_err;
+    LCD_CMD cmd;
+
+    if(lcdCmdQOut != lcdCmdQIn){
+        OSMutexPend(&lcdLayersKey, 0, OS_OPT_PEND_BLOCKING, (CPU_TS *)0, &os_err);
+        while(os_err != OS_ERR_NONE){           /* Error Trap                        */
+        }
+
+        while(lcdCmdGet(&cmd) == TRUE){
+            lcdCmdApply(&cmd);
+        }
+
+        (void)OSMutexPost(&lcdLayersKey, OS_OPT_POST_NONE, &os_err);
+        while(os_err != OS_ERR_NONE){           /* Error Trap                        */
+        }
+    }else{ //Nothing queued
+    }
+}
+
+/*************************************************************************
+  lcdCmdApply() - Applies one command to its layer               (Private)
+
+                  The caller must hold lcdLayersKey.
+*************************************************************************/
+static void lcdCmdApply(const LCD_CMD *cmd) {
+    LCD_BUFFER *llayer = &lcdLayers[cmd->layer];
+    INT8U col;
+
+    switch(cmd->op){
+    case LCD_CMD_TEXT:
+        for(col = 0; col < cmd->len; col++){
+            lcdPutChar(llayer, cmd->row, cmd->col + col, cmd->text[col]);
+        }
+        break;
+    case LCD_CMD_CLR_LAYER:
+        lcdClear(llayer);
+        break;
+    case LCD_CMD_CLR_LINE:
+        for(col = 0; col < LCD_NUM_COLS; col++){
+            llayer->lcd_char[cmd->row][col] = LCD_CLEAR_BYTE;
+        }
+        llayer->opaque[cmd->row] = 0;
+        break;
+    default:
+        break;
+    }
+    llayer->gen++;
+}
+
 /******************************************************************************
   LcdInit() - Initializes the LCD                                 (Public)
 
@@ -579,6 +1070,8 @@ void LcdInit(void) {
     INT8U layer_cnt;
     OS_ERR os_err;
     
+    lcdCmdQInit();
+
     // Create mutex key, semaphore, and task
     OSMutexCreate(&lcdLayersKey,"LCD Layers Key", &os_err);
     while(os_err != OS_ERR_NONE){           /* Error Trap                        */
@@ -601,50 +1094,7 @@ void LcdInit(void) {
     }
 
     // Perform LCD hardware initialisation
-    SIM->SCGC5 |= SIM_SCGC5_PORTD_MASK;              /* Enable clock gate for PORTD */
-    PORTD->PCR[1]=(0|PORT_PCR_MUX(1));
-    PORTD->PCR[2]=(0|PORT_PCR_MUX(1));
-    PORTD->PCR[3]=(0|PORT_PCR_MUX(1));
-    PORTD->PCR[4]=(0|PORT_PCR_MUX(1));
-    PORTD->PCR[5]=(0|PORT_PCR_MUX(1));
-    PORTD->PCR[6]=(0|PORT_PCR_MUX(1));
-    INIT_BIT_DIR();
-    LCD_CLR_E(); 
-    LCD_SET_RS();           /*Data select unless in LcdWrCmd()  */
-    lcdDlyus(15000);           /* LCD requires 15ms delay at powerup */
-   
-    LCD_CLR_RS();           /*Send first command for RESET sequence*/
-    LCD_WR_DB(0x3);
-    LCD_SET_E();
-    lcdDly500ns();
-    LCD_CLR_E();
-    lcdDlyus(4200);            /*Wait >4.1ms */
-  
-    LCD_WR_DB(0x3);         /*Repeat */
-    LCD_SET_E();
-    lcdDly500ns();
-    LCD_CLR_E();
-    lcdDlyus(101);            /*Wait >100us */
-  
-    LCD_WR_DB(0x3);         /* Repeat */
-    LCD_SET_E();
-    lcdDly500ns();
-    LCD_CLR_E();
-    lcdDlyus(41);           /*Wait >40us*/
-  
-    LCD_WR_DB(0x2);         /*Send last command for RESET sequence*/
-    LCD_SET_E();
-    lcdDly500ns();
-    LCD_CLR_E();
-    lcdDlyus(41);
-  
-    lcdWrite(LCD_FUNCTION(0, 1, 0));     /*Send command for 4-bit mode */
-    lcdWrite(LCD_ENTRY_MODE(1, 0)); // Increment, no shift
-    lcdWrite(LCD_ON_OFF(1, 0, 0));  // LCD on, cursor off, blink off
-    lcdWrite(LCD_CLR_DISP());       // Clear display
-    lcdDlyus(1650);
-    lcdWrite(LCD_DD_RAM(0x0000));   // Reset cursor
-    
+    lcdDriver->init();
     
     // Clear all of our layers
     for(layer_cnt = 0; layer_cnt < LCD_NUM_LAYERS; layer_cnt++) {
@@ -665,78 +1115,98 @@ void LcdInit(void) {
         src_layer with the highest index will be on the top.  Treats the
         character defined as LCD_CLEAR_BYTE as a transparent byte.
 
+        Each row is merged a word at a time, selecting the opaque cells of
+        a layer with its opacity mask. The flattened buffer is cached and
+        is only rebuilt when a layer generation differs from the one the
+        buffer was built from.
+
+        RETURNS: TRUE if *dest_buffer was rebuilt, FALSE otherwise
+
                        Pends on the lcdLayersKey mutex
 *************************************************************************/
-static void lcdFlattenLayers(LCD_BUFFER *dest_buffer,
-                             LCD_BUFFER *src_layers) {
+static INT8U lcdFlattenLayers(LCD_BUFFER *dest_buffer,
+                              LCD_BUFFER *src_layers) {
     
     INT8U layer;
     INT8U row;
-    INT8U col;
-    INT8U current_char;
+    INT8U word;
+    INT8U changed = FALSE;
+    INT32U opaque;
+    INT32U select;
+    LCD_BUFFER *src;
     OS_ERR os_err;
-    // Clear the destination buffer
-    lcdClear(dest_buffer);
 
 //    DBUG_PORT &= ~DBUG_LCDTASK;
     OSMutexPend(&lcdLayersKey, 0, OS_OPT_PEND_BLOCKING, (CPU_TS *)0, &os_err);
     while(os_err != OS_ERR_NONE){           /* Error Trap                        */
     }
 //    DBUG_PORT |= DBUG_LCDTASK;
-    // Set the destination buffer cursor to false initially
-    dest_buffer->cursor.on = FALSE;
-    dest_buffer->cursor.blink = FALSE;
 
-    // For each layer...
+    // Has any layer changed since the last flatten?
     for(layer = 0; layer < LCD_NUM_LAYERS; layer++) {
+        if((src_layers+layer)->gen != lcdFlatGen[layer]) {
+            lcdFlatGen[layer] = (src_layers+layer)->gen;
+            changed = TRUE;
+        }else{
+        }
+    }
 
-        // If that layer is not hidden...
-        if((src_layers+layer)->hidden == 0) {
-            // For each row...
-            for(row = 0; row < LCD_NUM_ROWS; row++) {
-                // For each column...
-                for(col = 0; col < LCD_NUM_COLS; col++) {
-                    current_char = (src_layers+layer)->lcd_char[row][col];
-                
-                    // If the source layer is not null
-                    if(current_char != LCD_CLEAR_BYTE) {
-                        // Copy from the source layer to the buffer
-                        dest_buffer->lcd_char[row][col] = current_char;
-                    }else{ //Do nothing - transparent
-                    }
-                    
-                } // column
-            } // row
-
-            //Handle the cursor status
-//            if ( (src_layers+layer)->cursor.on != FALSE){
-                dest_buffer->cursor.col = (src_layers+layer)->cursor.col;
-                dest_buffer->cursor.row = (src_layers+layer)->cursor.row;
-                dest_buffer->cursor.on = (src_layers+layer)->cursor.on;
-                dest_buffer->cursor.blink = (src_layers+layer)->cursor.blink;
-//            }else{
-                // This layer doesn't move the cursor, do nothing
-//            }
-        }else{ //Do nothing - layer is hidden
-        }
-    } // layer
+    if(changed == TRUE) {
+        // Clear the destination buffer
+        lcdClear(dest_buffer);
+
+        // Set the destination buffer cursor to false initially
+        dest_buffer->cursor.on = FALSE;
+        dest_buffer->cursor.blink = FALSE;
+
+        // For each layer...
+        for(layer = 0; layer < LCD_NUM_LAYERS; layer++) {
+            src = src_layers+layer;
+
+            // If that layer is not hidden...
+            if(src->hidden == 0) {
+                // For each row...
+                for(row = 0; row < LCD_NUM_ROWS; row++) {
+                    opaque = src->opaque[row];
+
+                    // For each word with an opaque cell...
+                    for(word = 0; (opaque != 0) && (word < LCD_WORDS_PER_ROW); word++) {
+                        select = lcdByteSelect[opaque & 0x0F];
+                        dest_buffer->lcd_word[row][word] =
+                            (dest_buffer->lcd_word[row][word] & ~select)
+                            | (src->lcd_word[row][word] & select);
+                        opaque >>= LCD_CELLS_PER_WORD;
+                    } // word
+                } // row
+
+                //Handle the cursor status
+                dest_buffer->cursor.col = src->cursor.col;
+                dest_buffer->cursor.row = src->cursor.row;
+                dest_buffer->cursor.on = src->cursor.on;
+                dest_buffer->cursor.blink = src->cursor.blink;
+            }else{ //Do nothing - layer is hidden
+            }
+        } // layer
+    }else{ //Do nothing - cached buffer is current
+    }
     
     (void)OSMutexPost(&lcdLayersKey, OS_OPT_POST_NONE, &os_err);
     while(os_err != OS_ERR_NONE){           /* Error Trap                        */
     }
 
+    return(changed);
 }
 
 
 /*************************************************************************
-  lcdWriteBuffer() - Sends an LCD_BUFFER buffer to lcdWrite()    (Private)
+  lcdWriteBuffer() - Sends an LCD_BUFFER buffer to the back-end  (Private)
   
         The previous buffer lcdPreviousBuffer is a global variable
         containing a copy of the actual contents of the LCD module.  By 
         using the lcdPreviousBuffer and repos_flag, we are able to only
         write bytes that have changed.
                                                            
-                     Blocks for as long as lcdWrite() blocks
+                     Blocks for as long as the back-end blocks
 *************************************************************************/
 static void lcdWriteBuffer(LCD_BUFFER *buffer) {
     INT8U row;
@@ -747,7 +1217,7 @@ static void lcdWriteBuffer(LCD_BUFFER *buffer) {
     for(row = 0; row < LCD_NUM_ROWS; row++) {
     
         // Set our cursor to the beginning of the row
-        lcdWrite(LCD_DD_RAM(lcdRowAddress[row]));
+        lcdDriver->moveTo(row, 0);
         repos_flag = 0;
         
         // For each column...
@@ -759,12 +1229,12 @@ static void lcdWriteBuffer(LCD_BUFFER *buffer) {
                 
                 // If we need to reposition, do that now
                 if(repos_flag == 1) {
-                    lcdWrite(LCD_DD_RAM((lcdRowAddress[row] + col)));
+                    lcdDriver->moveTo(row, col);
                     repos_flag = 0;
                 }
             
                 // Write the character to the LCD
-                lcdWrite(LCD_WRITE(buffer->lcd_char[row][col]));
+                lcdDriver->putChar(buffer->lcd_char[row][col]);
              
                 // And update the previous buffer
                 lcdPreviousBuffer.lcd_char[row][col] =
@@ -779,44 +1249,12 @@ static void lcdWriteBuffer(LCD_BUFFER *buffer) {
         
         }
     }
-    // At the end setup the cursor
-    lcdMoveCursor(buffer->cursor.row,buffer->cursor.col);
-    lcdCursorDispMode(buffer->cursor.on, buffer->cursor.blink);
+    // At the end setup the cursor (layers use one based positions)
+    lcdDriver->cursor(buffer->cursor.row - 1, buffer->cursor.col - 1,
+                      buffer->cursor.on, buffer->cursor.blink);
 
 }
 
-/******************************************************************************
-  lcdWrite() - Writes a command (both data and control busses)   (Private)
-               to the LCD.
-               data is a 16-bit value bits 9-15 are not used, bit 8 is the 
-               register select, bits 0-7 is the character or command.
-               
-******************************************************************************/
-static void lcdWrite(INT16U data) {
-    INT8U c;
-    // Set/Reset RS
-    if((data & 0x0100) == 0x0100){
-        LCD_SET_RS(); //data write
-    }else{
-        LCD_CLR_RS(); //command write
-    }
-    
-    c = (INT8U)data;
-    // Write character/command to LCD
-    LCD_WR_DB((c>>4));
-    LCD_SET_E();
-    lcdDly500ns();
-    LCD_CLR_E();
-    lcdDly500ns();
-    lcdDly500ns();
-    LCD_WR_DB((c&0x0f));
-    LCD_SET_E();
-    lcdDly500ns();
-    LCD_CLR_E();
-    lcdDlyus(41);
-}
-
-
 /*************************************************************************
   lcdClear() - Clears a buffer or layer                          (Private)
 *************************************************************************/
@@ -833,40 +1271,25 @@ static void lcdClear(LCD_BUFFER *buffer) {
             buffer->lcd_char[row][col] = LCD_CLEAR_BYTE;
 
         }
+        buffer->opaque[row] = 0;
     }
     
 }
 
-/********************************************************************
-** lcdMoveCursor(INT8U row, INT8U col)
-*
-*  FILENAME: LCD.c
-*
-*  PARAMETERS: row - Destination row (1 or 2).
-*              col - Destination column (1 - 16).
-*
-*  DESCRIPTION: Moves the cursor to [row,col].
-*
-*  RETURNS: None
-********************************************************************/
-static void lcdMoveCursor(INT8U row, INT8U col) {
-   lcdWrite(LCD_DD_RAM((lcdRowAddress[(row-1)]) + (col-1)));
-}
+/*************************************************************************
+  lcdPutChar() - Writes a character to a buffer or layer and      (Private)
+                 keeps its opacity mask in step.
 
-/********************************************************************
-** lcdCursorDispMode(INT8U on, INT8U blink)                 (Private)
-*
-*  FILENAME: LCD.c
-*
-*  PARAMETERS: on - (Binary)Turn cursor on if TRUE, off if FALSE.
-*              blink - (Binary)Cursor blinks if TRUE.
-*
-*  DESCRIPTION: Changes LCD cursor state.
-*
-*  RETURNS: None
-********************************************************************/
-static void lcdCursorDispMode(INT8U on, INT8U blink) {
-    lcdWrite(LCD_ON_OFF(1, on, blink));
+                 The caller must hold lcdLayersKey for a layer.
+*************************************************************************/
+static void lcdPutChar(LCD_BUFFER *buffer, INT8U row_index, INT8U col_index,
+                       INT8C c) {
+    buffer->lcd_char[row_index][col_index] = c;
+    if(c != LCD_CLEAR_BYTE){
+        buffer->opaque[row_index] |= ((INT32U)1 << col_index);
+    }else{
+        buffer->opaque[row_index] &= ~((INT32U)1 << col_index);
+    }
 }
 
 /********************************************************************
@@ -881,7 +1304,7 @@ static void lcdCursorDispMode(INT8U on, INT8U blink) {
 *  RETURNS: None
 ********************************************************************/
 void LcdHideLayer(INT8U layer){
-    lcdLayers[layer].hidden = 1;
+    lcdSetHidden(layer, 1);
 }
 
 
@@ -897,7 +1320,7 @@ void LcdHideLayer(INT8U layer){
 *  RETURNS: None
 ********************************************************************/
 void LcdShowLayer(INT8U layer){
-    lcdLayers[layer].hidden = 0;
+    lcdSetHidden(layer, 0);
 }
 
 /********************************************************************
@@ -913,36 +1336,32 @@ void LcdShowLayer(INT8U layer){
 ********************************************************************/
 void LcdToggleLayer(INT8U layer){
     if(lcdLayers[layer].hidden){
-        lcdLayers[layer].hidden = 0;
+        lcdSetHidden(layer, 0);
     }else{
-        lcdLayers[layer].hidden = 1;
+        lcdSetHidden(layer, 1);
     }
 }
 
 /*************************************************************************
-  lcdDlyus() - Blocks for the passed number of microseconds      (Private)
+  lcdSetHidden() - Sets the hidden state of a layer               (Private)
+
+                   Pends on the lcdLayersKey mutex
+                   Posts the lcdModifiedFlag semaphore
 *************************************************************************/
-static void lcdDlyus(INT16U us) {
-    INT16U cnt;
-    
-    for(cnt = 0; cnt <= us; cnt++) {
-        lcdDly500ns();
-        lcdDly500ns();
-    }
+static void lcdSetHidden(INT8U layer, INT8U hidden){
+    OS_ERR os_err;
 
-}
+    OSMutexPend(&lcdLayersKey, 0, OS_OPT_PEND_BLOCKING, (CPU_TS *)0, &os_err);
+    while(os_err != OS_ERR_NONE){           /* Error Trap                        */
+    }
 
+    lcdLayers[layer].hidden = hidden;
+    lcdLayers[layer].gen++;
 
-/********************************************************************
-** lcdDly500ns(void)
-*   Delays, at least, 500ns
-*   Designed for 120MHz or 150MHz clock.
- *  Tdly >= (66.5ns)i (at 150MHz)
- * Currently set to ~532ns with i=8.
- * TDM 01/20/2013
-********************************************************************/
-static void lcdDly500ns(void){
-    INT32U i;
-    for(i=0;i<8;i++){
+    (void)OSMutexPost(&lcdLayersKey, OS_OPT_POST_NONE, &os_err);
+    while(os_err != OS_ERR_NONE){           /* Error Trap                        */
     }
+
+    // We have modified a layer
+    (void)OSTaskSemPost(&lcdLayeredTaskTCB,OS_OPT_POST_NONE,&os_err);
 }
@@ -45,6 +45,8 @@
 // LCD ROWS
 #define LCD_ROW_1 1
 #define LCD_ROW_2 2
+#define LCD_ROW_3 3     // Four line displays only
+#define LCD_ROW_4 4
 
 // LCD COLUMNS
 #define LCD_COL_1 1
@@ -63,6 +65,10 @@
 #define LCD_COL_14 14
 #define LCD_COL_15 15
 #define LCD_COL_16 16
+#define LCD_COL_17 17   // 20 column displays only
+#define LCD_COL_18 18
+#define LCD_COL_19 19
+#define LCD_COL_20 20
 
 /*************************************************************************
 * Enumerated type for mode parameter in LcdDispDecWord()
@@ -99,5 +105,25 @@ INT8U LcdCursor(INT8U row, INT8U col, INT8U layer, INT8U on, INT8U blink);
 void LcdHideLayer(INT8U layer);
 void LcdShowLayer(INT8U layer);
 void LcdToggleLayer(INT8U layer);
+
+/*************************************************************************
+  Non-blocking Public Functions
+
+  These queue a drawing command for lcdLayeredTask instead of taking the
+  layer mutex, so the caller never waits on a flatten pass. Commands are
+  applied in order. When the queue is full a command takes the place of
+  a queued one on the same layer whose cells it all overwrites, or else
+  the oldest queued command is dropped to make room, so the display ends
+  up showing the latest posts. FALSE is returned only in the short time
+  the LCD task is taking the oldest command out. Use the blocking call if
+  no update may be lost. Queue depth is APP_CFG_LCD_CMD_Q_SIZE (power of
+  two, default 16).
+*************************************************************************/
+INT8U LcdDispCharAsync(INT8U row, INT8U col, INT8U layer, INT8C c);
+INT8U LcdDispStringAsync(INT8U row, INT8U col, INT8U layer, const INT8C *string);
+INT8U LcdDispDecWordAsync(INT8U row, INT8U col, INT8U layer, INT32U binword, INT8U field, LCD_MODE mode);
+INT8U LcdDispClearAsync(INT8U layer);
+INT8U LcdDispClrLineAsync(INT8U row, INT8U layer);
+INT32U LcdDispDropCntGet(void);
 #endif
 
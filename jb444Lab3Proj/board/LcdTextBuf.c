@@ -0,0 +1,129 @@
+/****************************************************************************************
+* LcdTextBuf.c - Headless LcdLayered back-end that renders into a text buffer
+*
+*                Behaves like a character module with auto-increment: a
+*                write lands at the current position and moves one column
+*                right. Writes past the end of a row are dropped.
+*****************************************************************************************
+* Header Files - Dependencies
+*****************************************************************************************/
+#include "MCUType.h"
+#include "app_cfg.h"
+#include "LcdDriver.h"
+#include "LcdTextBuf.h"
+
+#define LCD_TEXT_BLANK 0x20
+
+/*************************************************************************
+  Private Local Functions
+*************************************************************************/
+static void lcdTextInit(void);
+static void lcdTextMoveTo(INT8U row_index, INT8U col_index);
+static void lcdTextPutChar(INT8C c);
+static void lcdTextCursor(INT8U row_index, INT8U col_index, INT8U on, INT8U blink);
+
+/*************************************************************************
+  Driver Instance
+*************************************************************************/
+const LCD_DRIVER LcdTextBufDriver = {
+    lcdTextInit,
+    lcdTextMoveTo,
+    lcdTextPutChar,
+    lcdTextCursor
+};
+
+/*************************************************************************
+  Static Globals
+*************************************************************************/
+static INT8C lcdTextFrame[LCD_NUM_ROWS][LCD_NUM_COLS + 1];
+static INT8U lcdTextRow;
+static INT8U lcdTextCol;
+static INT32U lcdTextCharCnt;
+static INT8U lcdTextCurRow;
+static INT8U lcdTextCurCol;
+static INT8U lcdTextCurOn;
+static INT8U lcdTextCurBlink;
+
+/*************************************************************************
+  lcdTextInit() - Blanks the frame and homes the write position  (Private)
+*************************************************************************/
+static void lcdTextInit(void) {
+    INT8U row;
+    INT8U col;
+
+    for(row = 0; row < LCD_NUM_ROWS; row++) {
+        for(col = 0; col < LCD_NUM_COLS; col++) {
+            lcdTextFrame[row][col] = LCD_TEXT_BLANK;
+        }
+        lcdTextFrame[row][LCD_NUM_COLS] = 0x00;
+    }
+    lcdTextRow = 0;
+    lcdTextCol = 0;
+    lcdTextCharCnt = 0;
+    lcdTextCurRow = 0;
+    lcdTextCurCol = 0;
+    lcdTextCurOn = FALSE;
+    lcdTextCurBlink = FALSE;
+}
+
+/*************************************************************************
+  lcdTextMoveTo() - Sets the position of the next character      (Private)
+*************************************************************************/
+static void lcdTextMoveTo(INT8U row_index, INT8U col_index) {
+    lcdTextRow = row_index;
+    lcdTextCol = col_index;
+}
+
+/*************************************************************************
+  lcdTextPutChar() - Writes a character and advances one column  (Private)
+*************************************************************************/
+static void lcdTextPutChar(INT8C c) {
+    if((lcdTextRow < LCD_NUM_ROWS) && (lcdTextCol < LCD_NUM_COLS)){
+        lcdTextFrame[lcdTextRow][lcdTextCol] = c;
+        lcdTextCol++;
+    }else{ //outside display
+    }
+    lcdTextCharCnt++;
+}
+
+/*************************************************************************
+  lcdTextCursor() - Records the cursor position and mode         (Private)
+*************************************************************************/
+static void lcdTextCursor(INT8U row_index, INT8U col_index, INT8U on, INT8U blink) {
+    lcdTextCurRow = row_index;
+    lcdTextCurCol = col_index;
+    lcdTextCurOn = on;
+    lcdTextCurBlink = blink;
+}
+
+/*************************************************************************
+  LcdTextBufRow() - Returns a row of the rendered frame            (Public)
+*************************************************************************/
+const INT8C *LcdTextBufRow(INT8U row_index) {
+    const INT8C *row;
+
+    if(row_index < LCD_NUM_ROWS){
+        row = &lcdTextFrame[row_index][0];
+    }else{
+        row = (const INT8C *)0;
+    }
+    return(row);
+}
+
+/*************************************************************************
+  LcdTextBufCharCnt() - Returns the number of characters written   (Public)
+*************************************************************************/
+INT32U LcdTextBufCharCnt(void) {
+    return(lcdTextCharCnt);
+}
+
+/*************************************************************************
+  LcdTextBufCursorGet() - Returns the last cursor settings         (Public)
+*************************************************************************/
+void LcdTextBufCursorGet(INT8U *row_index, INT8U *col_index,
+                         INT8U *on, INT8U *blink) {
+    *row_index = lcdTextCurRow;
+    *col_index = lcdTextCurCol;
+    *on = lcdTextCurOn;
+    *blink = lcdTextCurBlink;
+}
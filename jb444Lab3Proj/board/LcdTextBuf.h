@@ -0,0 +1,26 @@
+/****************************************************************************************
+* LcdTextBuf.h - Headless LcdLayered back-end that renders into a text buffer
+*
+*                Select it with APP_CFG_LCD_DRIVER set to LcdTextBufDriver.
+*                Each row is kept as a NUL terminated string so the frame
+*                can be printed or compared directly.
+****************************************************************************************/
+#ifndef LCD_TEXT_BUF_DEF
+#define LCD_TEXT_BUF_DEF
+
+/*************************************************************************
+  Public Functions
+*************************************************************************/
+
+/* Returns row row_index (zero based) of the rendered frame */
+const INT8C *LcdTextBufRow(INT8U row_index);
+
+/* Returns the number of characters written since init. Used to check
+   that only changed cells are sent to the display. */
+INT32U LcdTextBufCharCnt(void);
+
+/* Returns the cursor as last set by LcdLayered, zero based */
+void LcdTextBufCursorGet(INT8U *row_index, INT8U *col_index,
+                         INT8U *on, INT8U *blink);
+
+#endif
@@ -0,0 +1,6 @@
+/**********************************************************************************
+* MCUType.c - Storage for the host stand-ins declared in host/MCUType.h.
+**********************************************************************************/
+#include "MCUType.h"
+
+GPIO_Type MCUHostGpio[5];
@@ -0,0 +1,68 @@
+/**********************************************************************************
+* MCUType.h - Host stand-in for source/MCUType.h, used by the POSIX uC/OS-III port.
+*             Provides the same WWU types and constants, but sized for a 64-bit
+*             host so INT32U stays 32 bits wide. Force-include it with
+*             -include MCUType.h so source/MCUType.h is never expanded (see
+*             host/os_cpu_c.c).
+*
+*             In place of MK65F18.h it supplies the few CMSIS intrinsics used by
+*             board/ and source/, and plain memory for the GPIO ports so the
+*             debug bit macros in K65TWR_GPIO.h compile and do nothing.
+**********************************************************************************
+* Make sure it is included only one time
+**********************************************************************************/
+#ifndef  MCU_TYPE_PRESENT
+#define  MCU_TYPE_PRESENT
+
+#include <stdint.h>
+#include "cpu.h"
+
+/**********************************************************************************
+* Standard WWU type definitions
+**********************************************************************************/
+typedef char                INT8C;
+typedef unsigned char       INT8U;
+typedef signed char         INT8S;
+typedef unsigned short      INT16U;
+typedef signed short        INT16S;
+typedef unsigned int        INT32U;
+typedef signed int          INT32S;
+typedef unsigned long long  INT64U;
+typedef signed long long    INT64S;
+typedef float               FP32;
+typedef double              FP64;
+
+/**********************************************************************************
+* General Defined Constants
+**********************************************************************************/
+#define FALSE    0
+#define TRUE     1
+
+/**********************************************************************************
+* Simulated GPIO ports. Writes land in MCUHostGpio[] and have no effect.
+**********************************************************************************/
+typedef struct {
+    volatile uint32_t PDOR;
+    volatile uint32_t PSOR;
+    volatile uint32_t PCOR;
+    volatile uint32_t PTOR;
+    volatile uint32_t PDIR;
+    volatile uint32_t PDDR;
+} GPIO_Type;
+
+extern GPIO_Type MCUHostGpio[5];    /* MCUType.c */
+
+#define GPIOA    (&MCUHostGpio[0])
+#define GPIOB    (&MCUHostGpio[1])
+#define GPIOC    (&MCUHostGpio[2])
+#define GPIOD    (&MCUHostGpio[3])
+#define GPIOE    (&MCUHostGpio[4])
+
+/**********************************************************************************
+* CMSIS intrinsics
+**********************************************************************************/
+#define __DMB()     __sync_synchronize()
+#define __DSB()     __sync_synchronize()
+#define __ISB()     __sync_synchronize()
+
+#endif
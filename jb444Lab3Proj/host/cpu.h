@@ -0,0 +1,205 @@
+/*
+*********************************************************************************************************
+*                                                uC/CPU
+*                                    CPU CONFIGURATION & PORT LAYER
+*
+*                                            POSIX Host Port
+*                                            GNU C Compiler
+*
+* Filename      : cpu.h
+*
+* Note(s)       : (1) Host replacement for uC-CPU/cpu.h. It keeps the same module guard, so it is
+*                     force-included ahead of the Cortex-M file (see host/os_cpu_c.c for the build
+*                     line). Any later #include "cpu.h" that resolves to uC-CPU/cpu.h is then empty.
+*
+*                 (2) Data words stay 32 bits wide so the kernel behaves as it does on the K65.
+*                     Addresses are pointer sized for 64-bit hosts.
+*
+*                 (3) There are no interrupts on the host. 'Interrupts disabled' is a flag that the
+*                     simulated tick honours. See host/cpu_c.c.
+*********************************************************************************************************
+*/
+
+#ifndef  CPU_MODULE_PRESENT
+#define  CPU_MODULE_PRESENT
+
+
+/*
+*********************************************************************************************************
+*                                          CPU INCLUDE FILES
+*********************************************************************************************************
+*/
+
+#include  "cpu_cfg.h"
+#include  "cpu_def.h"
+
+#ifdef __cplusplus
+extern  "C" {
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                    CPU STANDARD DATA TYPES
+*********************************************************************************************************
+*/
+
+typedef            void        CPU_VOID;
+typedef            char        CPU_CHAR;                        /*  8-bit character                                     */
+typedef  unsigned  char        CPU_BOOLEAN;                     /*  8-bit boolean or logical                            */
+typedef  unsigned  char        CPU_INT08U;                      /*  8-bit unsigned integer                              */
+typedef    signed  char        CPU_INT08S;                      /*  8-bit   signed integer                              */
+typedef  unsigned  short       CPU_INT16U;                      /* 16-bit unsigned integer                              */
+typedef    signed  short       CPU_INT16S;                      /* 16-bit   signed integer                              */
+typedef  unsigned  int         CPU_INT32U;                      /* 32-bit unsigned integer                              */
+typedef    signed  int         CPU_INT32S;                      /* 32-bit   signed integer                              */
+typedef  unsigned  long  long  CPU_INT64U;                      /* 64-bit unsigned integer                              */
+typedef    signed  long  long  CPU_INT64S;                      /* 64-bit   signed integer                              */
+
+typedef            float       CPU_FP32;                        /* 32-bit floating point                                */
+typedef            double      CPU_FP64;                        /* 64-bit floating point                                */
+
+typedef  volatile  CPU_INT08U  CPU_REG08;                       /*  8-bit register                                      */
+typedef  volatile  CPU_INT16U  CPU_REG16;                       /* 16-bit register                                      */
+typedef  volatile  CPU_INT32U  CPU_REG32;                       /* 32-bit register                                      */
+typedef  volatile  CPU_INT64U  CPU_REG64;                       /* 64-bit register                                      */
+
+typedef            void      (*CPU_FNCT_VOID)(void);
+typedef            void      (*CPU_FNCT_PTR )(void *p_obj);
+
+
+/*
+*********************************************************************************************************
+*                                       CPU WORD CONFIGURATION
+*
+* Note(s) : (1) Address size follows the host pointer size (see Note #2 above).
+*********************************************************************************************************
+*/
+
+#if (__SIZEOF_POINTER__ == 8)
+#define  CPU_CFG_ADDR_SIZE              CPU_WORD_SIZE_64        /* Defines CPU address word size  (in octets).          */
+#else
+#define  CPU_CFG_ADDR_SIZE              CPU_WORD_SIZE_32
+#endif
+#define  CPU_CFG_DATA_SIZE              CPU_WORD_SIZE_32        /* Defines CPU data    word size  (in octets).          */
+#define  CPU_CFG_DATA_SIZE_MAX          CPU_WORD_SIZE_64        /* Defines CPU maximum word size  (in octets).          */
+
+#define  CPU_CFG_ENDIAN_TYPE            CPU_ENDIAN_TYPE_LITTLE  /* Defines CPU data    word-memory order.               */
+
+
+/*
+*********************************************************************************************************
+*                                 CONFIGURE STANDARD DATA TYPES
+*********************************************************************************************************
+*/
+
+#if     (CPU_CFG_ADDR_SIZE == CPU_WORD_SIZE_64)
+typedef  CPU_INT64U  CPU_ADDR;
+#else
+typedef  CPU_INT32U  CPU_ADDR;
+#endif
+
+typedef  CPU_INT32U  CPU_DATA;
+
+typedef  CPU_DATA    CPU_ALIGN;                                 /* Defines CPU data-word-alignment size.                */
+typedef  CPU_ADDR    CPU_SIZE_T;                                /* Defines CPU standard 'size_t'   size.                */
+
+
+/*
+*********************************************************************************************************
+*                                       CPU STACK CONFIGURATION
+*
+* Note(s) : (1) Task stacks declared by the application are kept for stack checking, but each task
+*               actually runs on a host stack allocated by OSTaskStkInit() (see host/os_cpu_c.c).
+*********************************************************************************************************
+*/
+
+#define  CPU_CFG_STK_GROWTH       CPU_STK_GROWTH_HI_TO_LO       /* Defines CPU stack growth order.                      */
+#define  CPU_CFG_STK_ALIGN_BYTES  (8u)                          /* Defines CPU stack alignment in bytes.                */
+
+typedef  CPU_INT32U               CPU_STK;                      /* Defines CPU stack data type.                         */
+typedef  CPU_ADDR                 CPU_STK_SIZE;                 /* Defines CPU stack size data type.                    */
+
+
+/*
+*********************************************************************************************************
+*                                   CRITICAL SECTION CONFIGURATION
+*********************************************************************************************************
+*/
+
+#define  CPU_CFG_CRITICAL_METHOD    CPU_CRITICAL_METHOD_STATUS_LOCAL
+
+typedef  CPU_INT32U                 CPU_SR;                     /* Saved 'interrupts disabled' flag.                    */
+
+#define  CPU_SR_ALLOC()             CPU_SR  cpu_sr = (CPU_SR)0
+
+#define  CPU_INT_DIS()         do { cpu_sr = CPU_SR_Save(); } while (0)
+#define  CPU_INT_EN()          do { CPU_SR_Restore(cpu_sr); } while (0)
+
+#ifdef   CPU_CFG_INT_DIS_MEAS_EN
+#define  CPU_CRITICAL_ENTER()  do { CPU_INT_DIS();         \
+                                    CPU_IntDisMeasStart(); }  while (0)
+#define  CPU_CRITICAL_EXIT()   do { CPU_IntDisMeasStop();  \
+                                    CPU_INT_EN();          }  while (0)
+#else
+#define  CPU_CRITICAL_ENTER()  do { CPU_INT_DIS(); } while (0)
+#define  CPU_CRITICAL_EXIT()   do { CPU_INT_EN();  } while (0)
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                    MEMORY BARRIERS CONFIGURATION
+*********************************************************************************************************
+*/
+
+#define  CPU_MB()       __sync_synchronize()
+#define  CPU_RMB()      __sync_synchronize()
+#define  CPU_WMB()      __sync_synchronize()
+
+
+/*
+*********************************************************************************************************
+*                                         FUNCTION PROTOTYPES
+*
+* Note(s) : (1) CPU_CntLeadZeros() and CPU_CntTrailZeros() come from the C versions in cpu_core.c.
+*               The NVIC and bit-band functions of the Cortex-M port have no host equivalent.
+*
+*           (2) With CPU_CFG_INT_DIS_MEAS_EN defined (e.g. -DCPU_CFG_INT_DIS_MEAS_EN on the build line),
+*               host/cpu_c.c supplies the timestamp timer and CPU_IntDisMeasMaxGet() reports nanoseconds.
+*********************************************************************************************************
+*/
+
+void        CPU_IntDis       (void);
+void        CPU_IntEn        (void);
+
+CPU_SR      CPU_SR_Save      (void);
+void        CPU_SR_Restore   (CPU_SR      cpu_sr);
+CPU_BOOLEAN CPU_HostIntIsDis (void);
+
+void        CPU_WaitForInt   (void);
+void        CPU_WaitForExcept(void);
+
+CPU_BOOLEAN CPU_AtomicCmpSwap(CPU_DATA   *p_data,
+                              CPU_DATA    cmp,
+                              CPU_DATA    val);
+
+
+/*
+*********************************************************************************************************
+*                                   EXTERNAL C LANGUAGE LINKAGE END
+*********************************************************************************************************
+*/
+
+#ifdef __cplusplus
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                             MODULE END
+*********************************************************************************************************
+*/
+
+#endif                                                          /* End of CPU module include.                           */
@@ -0,0 +1,185 @@
+/*
+*********************************************************************************************************
+*                                                uC/CPU
+*                                    CPU CONFIGURATION & PORT LAYER
+*
+*                                            POSIX Host Port
+*                                            GNU C Compiler
+*
+* Filename      : cpu_c.c
+*
+* Note(s)       : (1) The host has no interrupt mask that the kernel can use. Instead a flag stands in
+*                     for PRIMASK. The simulated tick (see host/os_cpu_c.c) is held pending while the
+*                     flag is set and runs when the flag is cleared. This is the same as an NVIC
+*                     pending bit on the board.
+*
+*                 (2) The tick arrives as a signal on the same thread. A compiler barrier is therefore
+*                     enough to keep the flag ordered against the code it protects.
+*********************************************************************************************************
+*/
+
+#include  <sched.h>
+#include  <signal.h>
+#include  <time.h>
+#include  <unistd.h>
+#include  "os.h"
+
+
+/*
+*********************************************************************************************************
+*                                           LOCAL VARIABLES
+*********************************************************************************************************
+*/
+
+static  volatile  sig_atomic_t  CPU_HostIntDisFlag = 1;         /* Interrupts start disabled, as out of reset.          */
+
+#define  CPU_HOST_BARRIER()     __atomic_signal_fence(__ATOMIC_SEQ_CST)
+
+
+/*
+*********************************************************************************************************
+*                                    DISABLE/ENABLE INTERRUPTS
+*********************************************************************************************************
+*/
+
+void  CPU_IntDis (void)
+{
+    CPU_HostIntDisFlag = 1;
+    CPU_HOST_BARRIER();
+}
+
+
+void  CPU_IntEn (void)
+{
+    CPU_HOST_BARRIER();
+    CPU_HostIntDisFlag = 0;
+    OS_CPU_HostTickService();                                   /* Take a tick that arrived while disabled.             */
+}
+
+
+/*
+*********************************************************************************************************
+*                                      SAVE/RESTORE CPU STATUS
+*
+* Description : CPU_SR_Save() returns the current 'interrupts disabled' flag and then sets it.
+*               CPU_SR_Restore() puts the saved flag back. If that enables interrupts, a pending tick
+*               runs straight away.
+*********************************************************************************************************
+*/
+
+CPU_SR  CPU_SR_Save (void)
+{
+    CPU_SR  cpu_sr;
+
+
+    cpu_sr             = (CPU_SR)CPU_HostIntDisFlag;
+    CPU_HostIntDisFlag = 1;
+    CPU_HOST_BARRIER();
+    return (cpu_sr);
+}
+
+
+void  CPU_SR_Restore (CPU_SR  cpu_sr)
+{
+    CPU_HOST_BARRIER();
+    CPU_HostIntDisFlag = (sig_atomic_t)cpu_sr;
+    if (cpu_sr == 0u) {
+        OS_CPU_HostTickService();
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                     CPU_HostIntIsDis()
+*
+* Description : Returns DEF_YES if the kernel currently has interrupts disabled. Used by the tick signal
+*               handler to decide whether to run the tick now or leave it pending.
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN  CPU_HostIntIsDis (void)
+{
+    return ((CPU_HostIntDisFlag != 0) ? DEF_YES : DEF_NO);
+}
+
+
+/*
+*********************************************************************************************************
+*                                    WAIT FOR INTERRUPT/EXCEPTION
+*
+* Note(s) : (1) Sleeps until the next signal. With the virtual tick there are no signals, so the idle
+*               hook never calls these.
+*********************************************************************************************************
+*/
+
+void  CPU_WaitForInt (void)
+{
+    (void)pause();
+}
+
+
+void  CPU_WaitForExcept (void)
+{
+    (void)pause();
+}
+
+
+/*
+*********************************************************************************************************
+*                                        ATOMIC COMPARE AND SWAP
+*
+* Description : Stores 'val' at 'p_data' if it still holds 'cmp'. Returns DEF_OK if stored, DEF_FAIL if
+*               not. Same contract as the LDREX/STREX version in uC-CPU/cpu_a.asm.
+*
+* Note(s)     : (1) Built with CPU_CFG_HOST_CAS_YIELD_EN defined, one swap in 16 first yields 32 times, as
+*                   a thread preempted between reading the word and swapping it. Other threads can then
+*                   change the word and change it back, which is what a stress test of a lock-free list
+*                   wants (see test/mem_lock_free.c).
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN  CPU_AtomicCmpSwap (CPU_DATA  *p_data,
+                                CPU_DATA   cmp,
+                                CPU_DATA   val)
+{
+#ifdef  CPU_CFG_HOST_CAS_YIELD_EN
+    static  __thread  CPU_INT32U  seed = 1u;
+    CPU_INT32U                    n;
+
+
+    seed = seed * 1103515245u + 12345u;
+    for (n = (((seed >> 16) % 16u) == 0u) ? 32u : 0u; n > 0u; n--) {
+        (void)sched_yield();
+    }
+#endif
+    return (__atomic_compare_exchange_n(p_data, &cmp, val, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST) ? DEF_OK : DEF_FAIL);
+}
+
+
+/*
+*********************************************************************************************************
+*                                        TIMESTAMP TIMER
+*
+* Note(s) : (1) Only built when uC/CPU needs a timestamp timer, which is when CPU_CFG_INT_DIS_MEAS_EN is
+*               defined or CPU timestamps are enabled. CLOCK_MONOTONIC in nanoseconds stands in for the
+*               cycle counter, truncated to the CPU_TS_TMR width.
+*********************************************************************************************************
+*/
+
+#if (CPU_CFG_TS_TMR_EN == DEF_ENABLED)
+void  CPU_TS_TmrInit (void)
+{
+    CPU_TS_TmrFreqSet((CPU_TS_TMR_FREQ)1000000000u);
+}
+
+
+CPU_TS_TMR  CPU_TS_TmrRd (void)
+{
+    struct timespec  ts;
+
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((CPU_TS_TMR)((CPU_INT64U)ts.tv_sec * 1000000000u + (CPU_INT64U)ts.tv_nsec));
+}
+#endif
@@ -0,0 +1,136 @@
+/*
+*********************************************************************************************************
+*                                                uC/OS-III
+*                                          The Real-Time Kernel
+*
+*                                            POSIX Host Port
+*
+* File      : OS_CPU.H
+* For       : Linux / POSIX hosts
+* Toolchain : GNU C Compiler
+*
+* Note(s)   : (1) Host replacement for uC-CPU/os_cpu.h. Put host/ ahead of uCOS/uC-CPU on the include
+*                 path so this file is found first.
+*
+*             (2) The tick can be driven two ways:
+*
+*                 (a) Real time  : a SIGALRM timer at OSCfg_TickRate_Hz, like the SysTick on the board.
+*                 (b) Virtual    : OS_CPU_CFG_HOST_TICK_VIRTUAL = 1. The idle task delivers the next tick
+*                                  as soon as every task is blocked. Time then advances only when the
+*                                  system is idle, so runs are repeatable and do not wait on the wall
+*                                  clock. A task that never blocks stops time.
+*********************************************************************************************************
+*/
+
+#ifndef  OS_CPU_H
+#define  OS_CPU_H
+
+#ifdef   OS_CPU_GLOBALS
+#define  OS_CPU_EXT
+#else
+#define  OS_CPU_EXT  extern
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                    EXTERNAL C LANGUAGE LINKAGE
+*********************************************************************************************************
+*/
+
+#ifdef __cplusplus
+extern  "C" {
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                       CONFIGURATION DEFAULTS
+*********************************************************************************************************
+*/
+
+#ifndef  OS_CPU_CFG_HOST_TICK_VIRTUAL
+#define  OS_CPU_CFG_HOST_TICK_VIRTUAL      0u               /* 1 = idle-driven virtual tick (see Note #2b).           */
+#endif
+
+#ifndef  OS_CPU_CFG_HOST_STK_SIZE
+#define  OS_CPU_CFG_HOST_STK_SIZE      65536u               /* Host stack per task, in bytes.                         */
+#endif
+
+#define  OS_CPU_ARM_FP_EN                  0u
+
+
+/*
+*********************************************************************************************************
+*                                               MACROS
+*********************************************************************************************************
+*/
+
+#define  OS_TASK_SW()               OSCtxSw()
+#define  OS_TASK_SW_SYNC()          __sync_synchronize()
+
+
+/*
+*********************************************************************************************************
+*                                       TIMESTAMP CONFIGURATION
+*********************************************************************************************************
+*/
+
+#if      OS_CFG_TS_EN == 1u
+#define  OS_TS_GET()               (CPU_TS)CPU_TS_TmrRd()
+#else
+#define  OS_TS_GET()               (CPU_TS)0u
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                          GLOBAL VARIABLES
+*********************************************************************************************************
+*/
+
+OS_CPU_EXT  CPU_STK  *OS_CPU_ExceptStkBase;
+OS_CPU_EXT  CPU_TS    OS_CPU_CtxSwCycles;                   /* Time of the swapcontext() that switched the task in.   */
+
+
+/*
+*********************************************************************************************************
+*                                         FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+void  OSCtxSw               (void);
+void  OSIntCtxSw            (void);
+void  OSStartHighRdy        (void);
+
+void  OS_CPU_SysTickInit    (CPU_INT32U  cnts);
+void  OS_CPU_SysTickInitFreq(CPU_INT32U  cpu_freq);
+
+void  OS_CPU_SysTickHandler (void);
+
+void  OS_CPU_HostTickService(void);                         /* Runs a pending tick once interrupts are enabled.       */
+
+#if (defined(OS_CFG_STK_GUARD_EN) && (OS_CFG_STK_GUARD_EN == DEF_ENABLED))
+void  OS_CPU_StkGuardInit   (CPU_STK    *p_isr_guard);
+void  OS_CPU_StkGuardSet    (CPU_STK    *p_guard);
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                   EXTERNAL C LANGUAGE LINKAGE END
+*********************************************************************************************************
+*/
+
+#ifdef __cplusplus
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                             MODULE END
+*********************************************************************************************************
+*/
+
+#endif
@@ -0,0 +1,925 @@
+/*
+*********************************************************************************************************
+*                                                uC/OS-III
+*                                          The Real-Time Kernel
+*
+*                                            POSIX Host Port
+*
+* File      : OS_CPU_C.C
+* For       : Linux / POSIX hosts
+* Toolchain : GNU C Compiler
+*
+* Note(s)   : (1) Runs the unmodified kernel as one host process. Each task is a ucontext with its own
+*                 host stack, and a context switch is a swapcontext(). No assembly is needed.
+*
+*             (2) The tick is either a SIGALRM interval timer or a virtual tick. See os_cpu.h Note #2.
+*                 With OS_CFG_DYN_TICK_EN the tick is dynamic, as on the board (board/K65TWR_OSTick.c).
+*                 A microsecond count stands in for the PIT time base and a one-shot for the PIT match.
+*
+*             (3) This directory is not a source entry of the MCUXpresso project, so it is never part
+*                 of the firmware. To build the kernel for the host, from the project directory:
+*
+*                   cc -std=gnu99 -O2 -Ihost -include MCUType.h                                   \
+*                      -IuCOS/uC-CFG -IuCOS/uCOS-III -IuCOS/uC-CPU -IuCOS/uC-LIB -Isource -Iboard \
+*                      [-DOS_CPU_CFG_HOST_TICK_VIRTUAL=1]                                         \
+*                      host/os_cpu_c.c host/cpu_c.c host/MCUType.c uCOS/uCOS-III/os_*.c           \
+*                      uCOS/uC-CPU/os_core.c uCOS/uC-CPU/cpu_core.c uCOS/uC-CFG/os_app_hooks.c    \
+*                      <application files with main()>
+*
+*                 host/MCUType.h is force-included. It pulls in host/cpu.h ahead of the Cortex-M cpu.h
+*                 and supplies the WWU types and the few CMSIS intrinsics used by board/ and source/.
+*                 Modules that only use the kernel (MemTest, LcdLayered with LcdTextBufDriver) build
+*                 unchanged. Modules that touch K65 peripherals do not.
+*
+*                 host/Makefile builds the tests and benchmarks in host/test/ this way. 'make test'
+*                 runs the tests.
+*
+*             (4) With OS_CFG_STK_GUARD_EN each host stack has a PROT_NONE page below it. A task that runs
+*                 off its stack faults there, and the SIGSEGV handler reports it through
+*                 OSStkGuardHitHook(), as the DWT watchpoint does on the board. The guard sits below the
+*                 host stack, not in the task's declared stack, and all guards are always armed.
+*********************************************************************************************************
+*/
+
+#define   OS_CPU_GLOBALS
+
+#include  <errno.h>
+#include  <signal.h>
+#include  <stdlib.h>
+#include  <string.h>
+#include  <sys/mman.h>
+#include  <sys/time.h>
+#include  <time.h>
+#include  <ucontext.h>
+#include  <unistd.h>
+#include  "os.h"
+
+#ifdef __cplusplus
+extern  "C" {
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                          LOCAL DATA TYPES
+*
+* Note(s) : (1) A pointer to the task's host context is kept at the top of the task's own stack, and
+*               OSTCBxxPtr->StkPtr points at it. Nothing else on that stack is used.
+*********************************************************************************************************
+*/
+
+typedef  struct  os_cpu_host_ctx {
+    ucontext_t    Ctx;                                          /* Saved host register state.                           */
+    OS_TASK_PTR   TaskPtr;                                      /* Task entry and argument, used on first switch-in.    */
+    void         *ArgPtr;
+    void         *StkPtr;                                       /* Host stack the task actually runs on.                */
+} OS_CPU_HOST_CTX;
+
+#define  OS_CPU_HOST_CTX_WORDS   ((sizeof(OS_CPU_HOST_CTX *) + sizeof(CPU_STK) - 1u) / sizeof(CPU_STK))
+
+#if (OS_CFG_DYN_TICK_EN == DEF_ENABLED)
+#define  OS_CPU_HOST_DT_FREQ        1000000u                    /* Dynamic tick time base, 1 count per microsecond.     */
+#define  OS_CPU_HOST_DT_MIN_CNTS          1u                    /* Shortest one-shot, for late matches.                 */
+#define  OS_CPU_HOST_DT_SPAN_MAX  0x7FFFFFFFu                   /* Longest step, half the count range.                  */
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                           LOCAL VARIABLES
+*********************************************************************************************************
+*/
+
+static  OS_CPU_HOST_CTX        *OS_CPU_HostCtxCur;              /* Context of the running task.                         */
+static  OS_CPU_HOST_CTX        *OS_CPU_HostCtxZombie;           /* Task that deleted itself, freed by the next one.     */
+static  ucontext_t              OS_CPU_HostCtxMain;             /* Context that called OSStart().                       */
+static  volatile  sig_atomic_t  OS_CPU_HostTickPend;            /* Tick raised but not yet serviced.                    */
+static  CPU_BOOLEAN             OS_CPU_HostTickEn;
+static  CPU_TS                  OS_CPU_HostSwTS;                /* OS_TS_GET() when the last switch began.              */
+
+#if (OS_CFG_STK_GUARD_EN == DEF_ENABLED)
+static  CPU_SIZE_T              OS_CPU_HostPageSize;            /* Size of the guard page below each host stack.        */
+static  CPU_INT08U              OS_CPU_HostSigStk[65536];       /* The SIGSEGV handler runs here, not on the task.      */
+#endif
+
+#if (OS_CFG_DYN_TICK_EN == DEF_ENABLED)
+static  CPU_INT32U              OS_CPU_HostDtCnts;              /* Counts per tick, 0 until started.                    */
+static  CPU_INT32U              OS_CPU_HostDtBase;              /* Count at the last announced tick.                    */
+static  CPU_INT32U              OS_CPU_HostDtMatch;             /* Count at which the next tick is due.                 */
+static  OS_TICK                 OS_CPU_HostDtMax;               /* Longest step in ticks.                               */
+#if (OS_CPU_CFG_HOST_TICK_VIRTUAL > 0u)
+static  CPU_INT32U              OS_CPU_HostDtNow;               /* Simulated time base. Moves only when idle.           */
+static  CPU_INT32U              OS_CPU_HostDtExpiry;            /* Count at which the one-shot fires.                   */
+static  CPU_BOOLEAN             OS_CPU_HostDtArmed;
+#endif
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                       LOCAL FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+static  OS_CPU_HOST_CTX  *OS_CPU_HostCtxGet   (CPU_STK  *p_stk);
+static  void              OS_CPU_HostCtxReap  (void);
+static  void             *OS_CPU_HostStkAlloc (void);
+static  void              OS_CPU_HostStkFree  (void        *p_stk);
+#if (OS_CFG_STK_GUARD_EN == DEF_ENABLED)
+static  void              OS_CPU_HostStkGuardSignal(int         sig,
+                                                    siginfo_t  *p_info,
+                                                    void       *p_uctx);
+#endif
+static  void              OS_CPU_HostSw       (void);
+static  void              OS_CPU_HostTaskEntry(void);
+#if (OS_CPU_CFG_HOST_TICK_VIRTUAL == 0u)
+static  void              OS_CPU_HostTickSignal(int  sig);
+#endif
+#if (OS_CFG_DYN_TICK_EN == DEF_ENABLED)
+static  CPU_INT32U        OS_CPU_HostDtCntGet  (void);
+static  void              OS_CPU_HostDtMatchSet(CPU_INT32U  match);
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                             IDLE TASK HOOK
+*
+* Note(s) : 1) With the virtual tick, an idle CPU means every task is blocked, so the next tick is due
+*              now. Otherwise the host sleeps until the timer signal instead of spinning.
+*
+*           2) With the dynamic tick as well, simulated time jumps straight to the one-shot expiry. A
+*              delay of N ticks then costs one pass through here instead of N.
+*********************************************************************************************************
+*/
+
+void  OSIdleTaskHook (void)
+{
+#if OS_CFG_APP_HOOKS_EN > 0u
+    if (OS_AppIdleTaskHookPtr != (OS_APP_HOOK_VOID)0) {
+        (*OS_AppIdleTaskHookPtr)();
+    }
+#endif
+
+    if (OS_CPU_HostTickEn == DEF_TRUE) {
+#if (OS_CPU_CFG_HOST_TICK_VIRTUAL > 0u)
+#if (OS_CFG_DYN_TICK_EN == DEF_ENABLED)
+        if (OS_CPU_HostDtArmed == DEF_FALSE) {
+            return;
+        }
+        OS_CPU_HostDtNow    = OS_CPU_HostDtExpiry;              /* See Note #2.                                         */
+        OS_CPU_HostDtArmed  = DEF_FALSE;
+#endif
+        OS_CPU_HostTickPend = 1;
+        OS_CPU_HostTickService();
+#else
+        CPU_WaitForInt();
+#endif
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                         OS INITIALIZATION HOOK
+*********************************************************************************************************
+*/
+
+void  OSInitHook (void)
+{
+    OS_CPU_ExceptStkBase = (CPU_STK *)(OSCfg_ISRStkBasePtr + OSCfg_ISRStkSize);
+    OS_CPU_ExceptStkBase = (CPU_STK *)((CPU_ADDR)(OS_CPU_ExceptStkBase) & ~(CPU_ADDR)7u);
+}
+
+
+/*
+*********************************************************************************************************
+*                                           REDZONE HIT HOOK
+*********************************************************************************************************
+*/
+
+#if (OS_CFG_TASK_STK_REDZONE_EN == DEF_ENABLED)
+void  OSRedzoneHitHook (OS_TCB  *p_tcb)
+{
+#if OS_CFG_APP_HOOKS_EN > 0u
+    if (OS_AppRedzoneHitHookPtr != (OS_APP_HOOK_TCB)0) {
+        (*OS_AppRedzoneHitHookPtr)(p_tcb);
+    } else {
+        abort();
+    }
+#else
+    (void)p_tcb;
+    abort();
+#endif
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                         STACK GUARD HIT HOOK
+*
+* Note(s) : 1) Called from the SIGSEGV handler. The faulting store is retried if this returns, so the
+*              default action of SIGSEGV ends the process then.
+*********************************************************************************************************
+*/
+
+#if (OS_CFG_STK_GUARD_EN == DEF_ENABLED)
+void  OSStkGuardHitHook (OS_TCB  *p_tcb)
+{
+#if OS_CFG_APP_HOOKS_EN > 0u
+    if (OS_AppStkGuardHitHookPtr != (OS_APP_HOOK_TCB)0) {
+        (*OS_AppStkGuardHitHookPtr)(p_tcb);
+    } else {
+        abort();
+    }
+#else
+    (void)p_tcb;
+    abort();
+#endif
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                       STATISTIC TASK HOOK
+*********************************************************************************************************
+*/
+
+void  OSStatTaskHook (void)
+{
+#if OS_CFG_APP_HOOKS_EN > 0u
+    if (OS_AppStatTaskHookPtr != (OS_APP_HOOK_VOID)0) {
+        (*OS_AppStatTaskHookPtr)();
+    }
+#endif
+}
+
+
+/*
+*********************************************************************************************************
+*                                        TASK CREATION HOOK
+*********************************************************************************************************
+*/
+
+void  OSTaskCreateHook (OS_TCB  *p_tcb)
+{
+#if OS_CFG_APP_HOOKS_EN > 0u
+    if (OS_AppTaskCreateHookPtr != (OS_APP_HOOK_TCB)0) {
+        (*OS_AppTaskCreateHookPtr)(p_tcb);
+    }
+#else
+    (void)p_tcb;
+#endif
+}
+
+
+/*
+*********************************************************************************************************
+*                                         TASK DELETION HOOK
+*
+* Note(s) : 1) A task that is deleting itself is still running on its host stack, so freeing that stack
+*              is left to whichever task runs next.
+*********************************************************************************************************
+*/
+
+void  OSTaskDelHook (OS_TCB  *p_tcb)
+{
+    OS_CPU_HOST_CTX  *p_ctx;
+
+
+#if OS_CFG_APP_HOOKS_EN > 0u
+    if (OS_AppTaskDelHookPtr != (OS_APP_HOOK_TCB)0) {
+        (*OS_AppTaskDelHookPtr)(p_tcb);
+    }
+#endif
+
+    p_ctx = OS_CPU_HostCtxGet(p_tcb->StkPtr);
+    if (p_ctx == OS_CPU_HostCtxCur) {
+        OS_CPU_HostCtxZombie = p_ctx;                           /* See Note #1.                                         */
+    } else {
+        OS_CPU_HostStkFree(p_ctx->StkPtr);
+        free(p_ctx);
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                          TASK RETURN HOOK
+*********************************************************************************************************
+*/
+
+void  OSTaskReturnHook (OS_TCB  *p_tcb)
+{
+#if OS_CFG_APP_HOOKS_EN > 0u
+    if (OS_AppTaskReturnHookPtr != (OS_APP_HOOK_TCB)0) {
+        (*OS_AppTaskReturnHookPtr)(p_tcb);
+    }
+#else
+    (void)p_tcb;
+#endif
+}
+
+
+/*
+*********************************************************************************************************
+*                                       INITIALIZE A TASK'S STACK
+*
+* Description: Allocates the host stack and context for a task. The task starts in
+*              OS_CPU_HostTaskEntry(), which calls p_task(p_arg) and then OS_TaskReturn().
+*
+* Returns    : Pointer to the context slot at the top of the task's declared stack.
+*
+* Note(s)    : 1) Running out of host memory is fatal, as there is no way to report it to OSTaskCreate().
+*********************************************************************************************************
+*/
+
+CPU_STK  *OSTaskStkInit (OS_TASK_PTR    p_task,
+                         void          *p_arg,
+                         CPU_STK       *p_stk_base,
+                         CPU_STK       *p_stk_limit,
+                         CPU_STK_SIZE   stk_size,
+                         OS_OPT         opt)
+{
+    CPU_STK          *p_stk;
+    OS_CPU_HOST_CTX  *p_ctx;
+
+
+    (void)p_stk_limit;
+    (void)opt;
+
+    p_ctx = (OS_CPU_HOST_CTX *)calloc(1u, sizeof(OS_CPU_HOST_CTX));
+    if (p_ctx == (OS_CPU_HOST_CTX *)0) {
+        abort();                                                /* See Note #1.                                         */
+    }
+    p_ctx->StkPtr  = OS_CPU_HostStkAlloc();
+    if (p_ctx->StkPtr == (void *)0) {
+        abort();
+    }
+    p_ctx->TaskPtr = p_task;
+    p_ctx->ArgPtr  = p_arg;
+
+    (void)getcontext(&p_ctx->Ctx);
+    p_ctx->Ctx.uc_stack.ss_sp   = p_ctx->StkPtr;
+    p_ctx->Ctx.uc_stack.ss_size = OS_CPU_CFG_HOST_STK_SIZE;
+    p_ctx->Ctx.uc_link          = (ucontext_t *)0;
+    (void)sigemptyset(&p_ctx->Ctx.uc_sigmask);                  /* Tasks start with the tick signal unblocked.          */
+    makecontext(&p_ctx->Ctx, OS_CPU_HostTaskEntry, 0);
+
+    p_stk = &p_stk_base[stk_size - OS_CPU_HOST_CTX_WORDS];
+    (void)memcpy(p_stk, &p_ctx, sizeof(p_ctx));                 /* Declared stacks are only 4-byte aligned.             */
+
+    return (p_stk);
+}
+
+
+/*
+*********************************************************************************************************
+*                                           TASK SWITCH HOOK
+*
+* Note(s)    : 1) Interrupts are disabled during this call.
+*              2) OSTCBHighRdyPtr is the task being switched in and OSTCBCurPtr the task being switched out.
+*              3) There is no FP context to save apart from what swapcontext() always saves, so the task
+*                 switched out is charged OS_CPU_CtxSwCycles without its FP registers. A host program can
+*                 call OS_ProfCtxSw() itself to exercise the FP counts.
+*********************************************************************************************************
+*/
+
+void  OSTaskSwHook (void)
+{
+#if OS_CFG_TASK_PROFILE_EN > 0u
+    CPU_TS  ts;
+#endif
+#ifdef  CPU_CFG_INT_DIS_MEAS_EN
+    CPU_TS  int_dis_time;
+#endif
+#if (OS_CFG_TASK_STK_REDZONE_EN == DEF_ENABLED)
+    CPU_BOOLEAN  stk_status;
+#endif
+
+#if OS_CFG_APP_HOOKS_EN > 0u
+    if (OS_AppTaskSwHookPtr != (OS_APP_HOOK_VOID)0) {
+        (*OS_AppTaskSwHookPtr)();
+    }
+#endif
+
+    OS_TRACE_TASK_SWITCHED_IN(OSTCBHighRdyPtr);
+
+#if OS_CFG_TASK_PROFILE_EN > 0u
+    ts = OS_TS_GET();
+    if (OSTCBCurPtr != OSTCBHighRdyPtr) {
+#if (OS_CFG_PROF_EN == DEF_ENABLED)
+        OS_ProfTaskSw(ts);                                      /* Takes ISR time out of the task's cycles              */
+                                                                /* Charge the task its context switch, see Note #3.     */
+        OS_ProfCtxSw(OSTCBCurPtr, DEF_FALSE, OS_CPU_CtxSwCycles);
+#endif
+        OSTCBCurPtr->CyclesDelta  = ts - OSTCBCurPtr->CyclesStart;
+        OSTCBCurPtr->CyclesTotal += (OS_CYCLES)OSTCBCurPtr->CyclesDelta;
+    }
+
+    OSTCBHighRdyPtr->CyclesStart = ts;
+#endif
+
+#ifdef  CPU_CFG_INT_DIS_MEAS_EN
+    int_dis_time = CPU_IntDisMeasMaxCurReset();
+    if (OSTCBCurPtr->IntDisTimeMax < int_dis_time) {
+        OSTCBCurPtr->IntDisTimeMax = int_dis_time;
+    }
+#endif
+
+#if OS_CFG_SCHED_LOCK_TIME_MEAS_EN > 0u
+    if (OSTCBCurPtr->SchedLockTimeMax < OSSchedLockTimeMaxCur) {
+        OSTCBCurPtr->SchedLockTimeMax = OSSchedLockTimeMaxCur;
+    }
+    OSSchedLockTimeMaxCur = (CPU_TS)0;
+#endif
+
+#if (OS_CFG_TASK_STK_REDZONE_EN == DEF_ENABLED)
+    stk_status = OSTaskStkRedzoneChk(DEF_NULL);
+    if (stk_status != DEF_OK) {
+        OSRedzoneHitHook(OSTCBCurPtr);
+    }
+#endif
+
+#if (OS_CFG_STK_GUARD_EN == DEF_ENABLED)
+    OS_StkGuardTaskSw();
+#endif
+
+#if (OS_CFG_TASK_BUDGET_EN == DEF_ENABLED)
+    OS_BudgetTaskSw();
+#endif
+
+#if (OS_CFG_SCHED_ROUND_ROBIN_EN == DEF_ENABLED) && (OS_CFG_DYN_TICK_EN == DEF_ENABLED)
+    OS_SchedRoundRobinArm(OSTCBHighRdyPtr);
+#endif
+}
+
+
+/*
+*********************************************************************************************************
+*                                              TICK HOOK
+*********************************************************************************************************
+*/
+
+void  OSTimeTickHook (void)
+{
+#if OS_CFG_APP_HOOKS_EN > 0u
+    if (OS_AppTimeTickHookPtr != (OS_APP_HOOK_VOID)0) {
+        (*OS_AppTimeTickHookPtr)();
+    }
+#endif
+}
+
+
+/*
+*********************************************************************************************************
+*                                         CONTEXT SWITCHING
+*
+* Description: OSStartHighRdy() runs the first task. OSCtxSw() and OSIntCtxSw() switch from the current
+*              task to OSTCBHighRdyPtr. On the board OSIntCtxSw() only pends PendSV. Here the tick
+*              handler switches directly, which is safe because the kernel calls it last in OSIntExit().
+*
+* Note(s)    : 1) All three are called with interrupts disabled. The task switched in restores its own
+*                 interrupt state when it leaves the critical section it was switched out in.
+*********************************************************************************************************
+*/
+
+void  OSStartHighRdy (void)
+{
+    OSTaskSwHook();
+    OSPrioCur          = OSPrioHighRdy;
+    OSTCBCurPtr        = OSTCBHighRdyPtr;
+    OS_CPU_HostCtxCur  = OS_CPU_HostCtxGet(OSTCBCurPtr->StkPtr);
+    OS_CPU_HostSwTS    = OS_TS_GET();
+    (void)swapcontext(&OS_CPU_HostCtxMain, &OS_CPU_HostCtxCur->Ctx);
+}
+
+
+void  OSCtxSw (void)
+{
+    OS_CPU_HostSw();
+}
+
+
+void  OSIntCtxSw (void)
+{
+    OS_CPU_HostSw();
+}
+
+
+static  void  OS_CPU_HostSw (void)
+{
+    OS_CPU_HOST_CTX  *p_from;
+
+
+    OSTaskSwHook();
+    OSPrioCur          = OSPrioHighRdy;
+    OSTCBCurPtr        = OSTCBHighRdyPtr;
+    p_from             = OS_CPU_HostCtxCur;
+    OS_CPU_HostCtxCur  = OS_CPU_HostCtxGet(OSTCBCurPtr->StkPtr);
+    OS_CPU_HostSwTS    = OS_TS_GET();
+    (void)swapcontext(&p_from->Ctx, &OS_CPU_HostCtxCur->Ctx);
+
+    OS_CPU_CtxSwCycles = OS_TS_GET() - OS_CPU_HostSwTS;         /* Switched back in.                                    */
+    OS_CPU_HostCtxReap();
+}
+
+
+/*
+*********************************************************************************************************
+*                                      HOST TASK ENTRY AND CONTEXT
+*********************************************************************************************************
+*/
+
+static  void  OS_CPU_HostTaskEntry (void)
+{
+    OS_CPU_CtxSwCycles = OS_TS_GET() - OS_CPU_HostSwTS;
+    OS_CPU_HostCtxReap();
+    CPU_IntEn();                                                /* Tasks start with interrupts enabled.                 */
+    OS_CPU_HostCtxCur->TaskPtr(OS_CPU_HostCtxCur->ArgPtr);
+    OS_TaskReturn();
+}
+
+
+static  OS_CPU_HOST_CTX  *OS_CPU_HostCtxGet (CPU_STK  *p_stk)
+{
+    OS_CPU_HOST_CTX  *p_ctx;
+
+
+    (void)memcpy(&p_ctx, p_stk, sizeof(p_ctx));
+    return (p_ctx);
+}
+
+
+static  void  OS_CPU_HostCtxReap (void)
+{
+    if ((OS_CPU_HostCtxZombie != (OS_CPU_HOST_CTX *)0) &&
+        (OS_CPU_HostCtxZombie != OS_CPU_HostCtxCur)) {
+        OS_CPU_HostStkFree(OS_CPU_HostCtxZombie->StkPtr);
+        free(OS_CPU_HostCtxZombie);
+        OS_CPU_HostCtxZombie = (OS_CPU_HOST_CTX *)0;
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                             HOST STACKS
+*
+* Description: OS_CPU_HostStkAlloc() returns OS_CPU_CFG_HOST_STK_SIZE bytes of host stack, NULL if out
+*              of memory. OS_CPU_HostStkFree() gives them back.
+*
+* Note(s)    : 1) With OS_CFG_STK_GUARD_EN the stack is mapped with one more page below it, which is made
+*                 inaccessible. See Note #4 at the top of the file.
+*********************************************************************************************************
+*/
+
+static  void  *OS_CPU_HostStkAlloc (void)
+{
+#if (OS_CFG_STK_GUARD_EN == DEF_ENABLED)
+    CPU_INT08U  *p_map;
+
+
+    p_map = (CPU_INT08U *)mmap((void *)0, OS_CPU_HostPageSize + OS_CPU_CFG_HOST_STK_SIZE,
+                               PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (p_map == (CPU_INT08U *)MAP_FAILED) {
+        return ((void *)0);
+    }
+    (void)mprotect(p_map, OS_CPU_HostPageSize, PROT_NONE);      /* See Note #1.                                         */
+    return ((void *)(p_map + OS_CPU_HostPageSize));
+#else
+    return (malloc(OS_CPU_CFG_HOST_STK_SIZE));
+#endif
+}
+
+
+static  void  OS_CPU_HostStkFree (void  *p_stk)
+{
+#if (OS_CFG_STK_GUARD_EN == DEF_ENABLED)
+    (void)munmap((CPU_INT08U *)p_stk - OS_CPU_HostPageSize, OS_CPU_HostPageSize + OS_CPU_CFG_HOST_STK_SIZE);
+#else
+    free(p_stk);
+#endif
+}
+
+
+#if (OS_CFG_STK_GUARD_EN == DEF_ENABLED)
+/*
+*********************************************************************************************************
+*                                             STACK GUARD
+*
+* Description: OS_CPU_StkGuardInit() installs the SIGSEGV handler. OS_CPU_StkGuardSet() has nothing to
+*              do, as every guard page stays inaccessible. OS_CPU_HostStkGuardSignal() reports a fault in
+*              the guard page of the running task and leaves any other fault to the default action.
+*
+* Note(s)    : 1) Handlers run on the interrupted task's host stack, so there is no ISR stack to guard.
+*
+*              2) A task that overflowed has no stack left to run the handler on, hence sigaltstack().
+*********************************************************************************************************
+*/
+
+void  OS_CPU_StkGuardInit (CPU_STK  *p_isr_guard)
+{
+    stack_t           stk;
+    struct sigaction  act;
+
+
+    (void)p_isr_guard;                                          /* See Note #1.                                         */
+
+    OS_CPU_HostPageSize = (CPU_SIZE_T)sysconf(_SC_PAGESIZE);
+
+    stk.ss_sp    = &OS_CPU_HostSigStk[0];                       /* See Note #2.                                         */
+    stk.ss_size  = sizeof(OS_CPU_HostSigStk);
+    stk.ss_flags = 0;
+    (void)sigaltstack(&stk, (stack_t *)0);
+
+    (void)memset(&act, 0, sizeof(act));
+    act.sa_sigaction = OS_CPU_HostStkGuardSignal;
+    act.sa_flags     = SA_SIGINFO | SA_ONSTACK | SA_RESETHAND;
+    (void)sigemptyset(&act.sa_mask);
+    (void)sigaction(SIGSEGV, &act, (struct sigaction *)0);
+}
+
+
+void  OS_CPU_StkGuardSet (CPU_STK  *p_guard)
+{
+    (void)p_guard;
+}
+
+
+static  void  OS_CPU_HostStkGuardSignal (int         sig,
+                                         siginfo_t  *p_info,
+                                         void       *p_uctx)
+{
+    CPU_INT08U  *p_addr;
+    CPU_INT08U  *p_guard;
+
+
+    (void)sig;
+    (void)p_uctx;
+
+    if (OS_CPU_HostCtxCur == (OS_CPU_HOST_CTX *)0) {
+        return;
+    }
+    p_addr  = (CPU_INT08U *)p_info->si_addr;
+    p_guard = (CPU_INT08U *)OS_CPU_HostCtxCur->StkPtr - OS_CPU_HostPageSize;
+    if ((p_addr >= p_guard) &&
+        (p_addr <  p_guard + OS_CPU_HostPageSize)) {
+        OSStkGuardHitHook(OSTCBCurPtr);
+    }
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                          SYS TICK HANDLER
+*
+* Description: The tick 'interrupt'. Called by OS_CPU_HostTickService() with interrupts enabled.
+*
+* Note(s)    : 1) With the dynamic tick this is the one-shot match. It announces every whole tick elapsed
+*                 since the last one, as PIT2_IRQHandler() does on the board.
+*********************************************************************************************************
+*/
+
+void  OS_CPU_SysTickHandler  (void)
+{
+#if (OS_CFG_DYN_TICK_EN == DEF_ENABLED)
+    OS_TICK  ticks;
+#endif
+    CPU_SR_ALLOC();
+
+
+    CPU_CRITICAL_ENTER();
+    OSIntEnter();                                               /* Tell uC/OS-III that we are starting an ISR           */
+#if (OS_CFG_DYN_TICK_EN == DEF_ENABLED)
+    ticks = (OS_TICK)((OS_CPU_HostDtCntGet() - OS_CPU_HostDtBase) / OS_CPU_HostDtCnts);
+    if (ticks != 0u) {
+        OS_CPU_HostDtBase += (CPU_INT32U)ticks * OS_CPU_HostDtCnts;
+        OSTimeDynTick(ticks);                                   /* With the base, so BSP_OS_TickGet() never sees half   */
+    } else {
+        OS_CPU_HostDtMatchSet(OS_CPU_HostDtMatch);              /* Early, wait for the rest                             */
+    }
+    CPU_CRITICAL_EXIT();
+#else
+    CPU_CRITICAL_EXIT();
+
+    OSTimeTick();                                               /* Call uC/OS-III's OSTimeTick()                        */
+#endif
+
+    OSIntExit();                                                /* Tell uC/OS-III that we are leaving the ISR           */
+}
+
+
+/*
+*********************************************************************************************************
+*                                       SERVICE A PENDING TICK
+*
+* Description: Runs the tick handler if a tick is pending. Called when interrupts are enabled and from
+*              the tick signal. Ticks that arrive while one is pending are merged, as with SysTick.
+*********************************************************************************************************
+*/
+
+void  OS_CPU_HostTickService (void)
+{
+    if (__atomic_exchange_n(&OS_CPU_HostTickPend, 0, __ATOMIC_SEQ_CST) != 0) {
+        OS_CPU_SysTickHandler();
+    }
+}
+
+
+#if (OS_CPU_CFG_HOST_TICK_VIRTUAL == 0u)
+static  void  OS_CPU_HostTickSignal (int  sig)
+{
+    int  err_saved;
+
+
+    (void)sig;
+    err_saved           = errno;
+    OS_CPU_HostTickPend = 1;
+    if (CPU_HostIntIsDis() == DEF_NO) {                         /* Otherwise the next CPU_SR_Restore() runs it.         */
+        OS_CPU_HostTickService();
+    }
+    errno               = err_saved;
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                         INITIALIZE SYS TICK
+*
+* Note(s)    : 1) The host tick rate is OSCfg_TickRate_Hz regardless of cpu_freq or cnts.
+*
+*              2) With the dynamic tick this starts the time base and programs the first expiry, as
+*                 BSP_OS_TickInitFreq() does on the board. Delays made before are picked up from
+*                 OSTickCtrStep.
+*********************************************************************************************************
+*/
+
+void  OS_CPU_SysTickInitFreq (CPU_INT32U  cpu_freq)
+{
+    (void)cpu_freq;
+    OS_CPU_SysTickInit(0u);
+}
+
+
+void  OS_CPU_SysTickInit (CPU_INT32U  cnts)
+{
+#if (OS_CPU_CFG_HOST_TICK_VIRTUAL == 0u)
+    struct  sigaction  act;
+#if (OS_CFG_DYN_TICK_EN != DEF_ENABLED)
+    struct  itimerval  tmr;
+#endif
+#endif
+#if (OS_CFG_DYN_TICK_EN == DEF_ENABLED)
+    CPU_SR_ALLOC();
+#endif
+
+
+    (void)cnts;
+#if (OS_CPU_CFG_HOST_TICK_VIRTUAL == 0u)
+    (void)memset(&act, 0, sizeof(act));
+    act.sa_handler = OS_CPU_HostTickSignal;
+    act.sa_flags   = SA_RESTART;
+    (void)sigemptyset(&act.sa_mask);
+    (void)sigaction(SIGALRM, &act, (struct sigaction *)0);
+
+#if (OS_CFG_DYN_TICK_EN != DEF_ENABLED)
+    tmr.it_interval.tv_sec  = 0;
+    tmr.it_interval.tv_usec = (suseconds_t)(1000000u / OSCfg_TickRate_Hz);
+    tmr.it_value            = tmr.it_interval;
+    (void)setitimer(ITIMER_REAL, &tmr, (struct itimerval *)0);
+#endif
+#endif
+#if (OS_CFG_DYN_TICK_EN == DEF_ENABLED)
+    CPU_CRITICAL_ENTER();                                       /* See Note #2.                                         */
+    OS_CPU_HostDtCnts = OS_CPU_HOST_DT_FREQ / (CPU_INT32U)OSCfg_TickRate_Hz;
+    OS_CPU_HostDtMax  = (OS_TICK)(OS_CPU_HOST_DT_SPAN_MAX / OS_CPU_HostDtCnts);
+    OS_CPU_HostDtBase = OS_CPU_HostDtCntGet();
+    (void)BSP_OS_TickNextSet(OSTickCtrStep);
+    OS_CPU_HostTickEn = DEF_TRUE;
+    CPU_CRITICAL_EXIT();
+#else
+    OS_CPU_HostTickEn = DEF_TRUE;
+#endif
+}
+
+
+#if (OS_CFG_DYN_TICK_EN == DEF_ENABLED)
+/*
+*********************************************************************************************************
+*                                          GET THE TICK COUNT
+*
+* Description: Current tick count. Ticks announced to the tick task and whole ticks elapsed since then
+*              are both included.
+*********************************************************************************************************
+*/
+
+OS_TICK  BSP_OS_TickGet (void)
+{
+    OS_TICK  ticks;
+    CPU_SR_ALLOC();
+
+
+    CPU_CRITICAL_ENTER();
+    ticks = OSTickCtr + OSTickCtrPend;
+    if (OS_CPU_HostDtCnts != 0u) {
+        ticks += (OS_TICK)((OS_CPU_HostDtCntGet() - OS_CPU_HostDtBase) / OS_CPU_HostDtCnts);
+    }
+    CPU_CRITICAL_EXIT();
+    return (ticks);
+}
+
+
+/*
+*********************************************************************************************************
+*                                        SET THE NEXT TICK
+*
+* Description: Programs the one-shot 'ticks' after OSTickCtr, or as late as the time base allows if
+*              nothing is waiting ((OS_TICK)-1).
+*
+* Returns    : The step programmed from the last announced tick.
+*
+* Note(s)    : 1) Called by the kernel with interrupts disabled.
+*********************************************************************************************************
+*/
+
+OS_TICK  BSP_OS_TickNextSet (OS_TICK  ticks)
+{
+    OS_TICK  step;
+
+
+    if (OS_CPU_HostDtCnts == 0u) {                              /* Not started, OS_CPU_SysTickInit() catches up         */
+        return (ticks);
+    }
+    if (ticks > OSTickCtrPend) {
+        step = ticks - OSTickCtrPend;
+    } else {
+        step = 1u;                                              /* Already due, the tick task has been signalled        */
+    }
+    if (step > OS_CPU_HostDtMax) {
+        step = OS_CPU_HostDtMax;
+    }
+    OS_CPU_HostDtMatch = OS_CPU_HostDtBase + (CPU_INT32U)step * OS_CPU_HostDtCnts;
+    OS_CPU_HostDtMatchSet(OS_CPU_HostDtMatch);
+    return (step);
+}
+
+
+/*
+*********************************************************************************************************
+*                                       DYNAMIC TICK TIME BASE
+*
+* Description: OS_CPU_HostDtCntGet() reads the time base. OS_CPU_HostDtMatchSet() restarts the one-shot
+*              to expire at count 'match', or after OS_CPU_HOST_DT_MIN_CNTS if that has already passed.
+*
+* Note(s)    : 1) The virtual time base only moves when the idle task jumps it to the expiry. The real
+*                 one is the monotonic clock and the one-shot is ITIMER_REAL.
+*********************************************************************************************************
+*/
+
+static  CPU_INT32U  OS_CPU_HostDtCntGet (void)
+{
+#if (OS_CPU_CFG_HOST_TICK_VIRTUAL > 0u)
+    return (OS_CPU_HostDtNow);
+#else
+    struct  timespec  ts;
+
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((CPU_INT32U)((CPU_INT64U)ts.tv_sec * 1000000u + (CPU_INT64U)ts.tv_nsec / 1000u));
+#endif
+}
+
+
+static  void  OS_CPU_HostDtMatchSet (CPU_INT32U  match)
+{
+    CPU_INT32U         cnts;
+#if (OS_CPU_CFG_HOST_TICK_VIRTUAL == 0u)
+    struct  itimerval  tmr;
+#endif
+
+
+    cnts = match - OS_CPU_HostDtCntGet();
+    if ((CPU_INT32S)cnts < (CPU_INT32S)OS_CPU_HOST_DT_MIN_CNTS) {
+        cnts = OS_CPU_HOST_DT_MIN_CNTS;
+    }
+#if (OS_CPU_CFG_HOST_TICK_VIRTUAL > 0u)
+    OS_CPU_HostDtExpiry = OS_CPU_HostDtNow + cnts;
+    OS_CPU_HostDtArmed  = DEF_TRUE;
+#else
+    tmr.it_interval.tv_sec  = 0;
+    tmr.it_interval.tv_usec = 0;
+    tmr.it_value.tv_sec     = (time_t)(cnts / 1000000u);
+    tmr.it_value.tv_usec    = (suseconds_t)(cnts % 1000000u);
+    (void)setitimer(ITIMER_REAL, &tmr, (struct itimerval *)0);
+#endif
+}
+#endif
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,29 @@
+/*
+*********************************************************************************************************
+*                                 APPLICATION CONFIGURATION FOR HOST TESTS
+*
+* Filename : app_cfg.h
+*
+* Note(s)  : (1) uC-CFG/app_cfg.h is local to each checkout and not under version control. The host
+*                tests use this one instead. It is ahead of uC-CFG on the include path.
+*
+*            (2) Only the board/ and source/ modules linked into a test read these settings.
+*********************************************************************************************************
+*/
+
+#ifndef  APP_CFG_MODULE_PRESENT
+#define  APP_CFG_MODULE_PRESENT
+
+#define  APP_CFG_LCD_TASK_PRIO          14u
+#define  APP_CFG_LCD_TASK_STK_SIZE     256u
+
+#define  APP_CFG_MEMTEST_TASK_PRIO      28u
+#define  APP_CFG_MEMTEST_TASK_STK_SIZE 256u
+
+#define  APP_CFG_UIF_TASK_PRIO          16u
+#define  APP_CFG_UIV_TASK_PRIO          18u
+#define  APP_CFG_UID_TASK_PRIO          20u
+#define  APP_CFG_UIS_TASK_PRIO          22u
+#define  APP_CFG_SIN_GEN_TASK_PRIO      24u
+
+#endif
@@ -0,0 +1,183 @@
+/*
+*********************************************************************************************************
+*                                 HOST TEST: CPU BUDGETS AND ROUND-ROBIN
+*
+* Filename : budget.c
+*
+* Note(s)  : (1) OSTaskBudgetSet() must reject a budget longer than its period, a 'prio_low' that is not
+*                below the task, and a second budget that takes the two tasks over the rate-monotonic
+*                bound for n = 2 (82.84%).
+*
+*            (2) A busy task at priority 10 gets each budget of TestBudget[] and a 'prio_low' of 20. A
+*                busy task at 15 takes whatever it leaves. Over TEST_TICKS ticks the budgeted task's
+*                share of the two tasks' .CyclesTotal must be within TEST_TOL of budget / period, and
+*                its budget must have run out in at least 9 periods out of 10: a late SIGALRM merges
+*                two ticks, and with a 3-tick period that can cost a period now and then.
+*
+*            (3) Two busy tasks share priority 12 with time quanta of TEST_QUANTA_A and TEST_QUANTA_B.
+*                The first must get its share of the CPU within TEST_TOL. With the dynamic tick a tick
+*                interrupt is only needed at the end of each slice, so there must be fewer than half as
+*                many tick interrupts as ticks; with the periodic tick (budget_periodic) there is one
+*                per tick.
+*
+*            (4) Runs on the SIGALRM tick (budget_VIRTUAL = 0): the virtual tick only advances when the
+*                CPU is idle, and the busy tasks never let it be.
+*********************************************************************************************************
+*/
+
+#include  "host_test.h"
+
+
+#define  TEST_TICKS              1000u
+#define  TEST_TOL                   3u                          /* Percent                              */
+#define  TEST_PRIO                 10u
+#define  TEST_PRIO_BUSY            15u
+#define  TEST_PRIO_LOW             20u
+#define  TEST_PRIO_RR              12u
+#define  TEST_QUANTA_A              6u
+#define  TEST_QUANTA_B              2u
+
+
+static  const  OS_TICK  TestBudget[][2] = {                     /* Budget, period                       */
+    { 2u, 10u },
+    { 5u, 50u },
+    { 1u,  3u }
+};
+
+static  volatile  CPU_INT32U  TestIrqCtr;
+static  OS_TCB      TestTCB;
+static  CPU_STK     TestStk[512];
+static  OS_TCB      TestBusyTCB[2];
+static  CPU_STK     TestBusyStk[2][256];
+
+
+static  void  TestBusy (void  *p_arg)
+{
+    (void)p_arg;
+    while (DEF_ON) {
+        ;
+    }
+}
+
+
+static  void  TestTickHook (void)
+{
+    TestIrqCtr++;
+}
+
+
+static  CPU_INT32U  TestShare (OS_TICK      ticks,               /* Share of busy task 0, in percent     */
+                               CPU_INT32U  *p_irqs)
+{
+    OS_ERR      err;
+    OS_CYCLES   cycles[2];
+    CPU_INT32U  irqs;
+    CPU_INT32U  i;
+
+
+    for (i = 0u; i < 2u; i++) {
+        cycles[i] = TestBusyTCB[i].CyclesTotal;
+    }
+    irqs = TestIrqCtr;
+    OSTimeDly(ticks, OS_OPT_TIME_DLY, &err);
+    HOST_TEST_CHK(err == OS_ERR_NONE);
+   *p_irqs = TestIrqCtr - irqs;
+    for (i = 0u; i < 2u; i++) {
+        cycles[i] = TestBusyTCB[i].CyclesTotal - cycles[i];
+    }
+    return ((CPU_INT32U)((CPU_INT64U)cycles[0] * 100u / (cycles[0] + cycles[1])));
+}
+
+
+static  void  TestAdmit (void)
+{
+    OS_ERR  err;
+
+
+    OSTaskBudgetSet(&TestBusyTCB[0], 11u, 10u, TEST_PRIO_LOW, &err);
+    HOST_TEST_CHK(err == OS_ERR_BUDGET_INVALID);
+    OSTaskBudgetSet(&TestBusyTCB[0],  2u, 10u, TEST_PRIO, &err);
+    HOST_TEST_CHK(err == OS_ERR_PRIO_INVALID);
+    OSTaskBudgetSet(&TestBusyTCB[0],  2u, 10u, TEST_PRIO_LOW, &err);
+    HOST_TEST_CHK(err == OS_ERR_NONE);
+    OSTaskBudgetSet(&TestBusyTCB[1],  7u, 10u, TEST_PRIO_LOW, &err);
+    HOST_TEST_CHK(err == OS_ERR_BUDGET_ADMIT);                  /* 90% > 82.84%                         */
+    OSTaskBudgetSet(&TestBusyTCB[1],  6u, 10u, TEST_PRIO_LOW, &err);
+    HOST_TEST_CHK(err == OS_ERR_NONE);                          /* 80%                                  */
+    HOST_TEST_CHK(OSBudgetQty == 2u);
+    OSTaskBudgetSet(&TestBusyTCB[1],  0u,  0u, 0u, &err);
+    HOST_TEST_CHK(err == OS_ERR_NONE);
+    HOST_TEST_CHK(OSBudgetQty == 1u);
+    HOST_TEST_CHK(TestBusyTCB[1].Prio == TEST_PRIO_BUSY);
+}
+
+
+static  void  TestTask (void  *p_arg)
+{
+    OS_ERR      err;
+    OS_TICK     budget;
+    OS_TICK     period;
+    OS_CTR      overruns;
+    CPU_INT32U  share;
+    CPU_INT32U  exp;
+    CPU_INT32U  irqs;
+    CPU_INT32U  i;
+
+
+    (void)p_arg;
+    OS_CPU_SysTickInitFreq(0u);
+    OS_AppTimeTickHookPtr = TestTickHook;
+    HostTestTaskCreate(&TestBusyTCB[0], "Budgeted", TestBusy, (void *)0, TEST_PRIO,      &TestBusyStk[0][0], 256u);
+    HostTestTaskCreate(&TestBusyTCB[1], "Busy",     TestBusy, (void *)0, TEST_PRIO_BUSY, &TestBusyStk[1][0], 256u);
+    TestAdmit();
+
+    for (i = 0u; i < sizeof(TestBudget) / sizeof(TestBudget[0]); i++) {
+        budget = TestBudget[i][0];
+        period = TestBudget[i][1];
+        OSTaskBudgetSet(&TestBusyTCB[0], budget, period, TEST_PRIO_LOW, &err);
+        HOST_TEST_CHK(err == OS_ERR_NONE);
+        OSTimeDly(period, OS_OPT_TIME_DLY, &err);               /* Past the first, full budget          */
+        overruns = TestBusyTCB[0].BudgetOverrunCtr;
+        share    = TestShare(TEST_TICKS, &irqs);
+        overruns = TestBusyTCB[0].BudgetOverrunCtr - overruns;
+        exp      = budget * 100u / period;
+        printf("budget %u/%-2u ticks: share=%u%% (expected %u%%), overruns=%u in %u ticks, tick irqs=%u\n",
+               (unsigned)budget, (unsigned)period, (unsigned)share, (unsigned)exp,
+               (unsigned)overruns, (unsigned)TEST_TICKS, (unsigned)irqs);
+        HOST_TEST_CHK((share + TEST_TOL >= exp) && (share <= exp + TEST_TOL));
+        HOST_TEST_CHK(overruns * 10u >= TEST_TICKS / period * 9u);
+    }
+    OSTaskBudgetSet(&TestBusyTCB[0], 0u, 0u, 0u, &err);
+    HOST_TEST_CHK((err == OS_ERR_NONE) && (OSBudgetQty == 0u));
+
+    OSTaskChangePrio(&TestBusyTCB[0], TEST_PRIO_RR, &err);      /* See Note #3                          */
+    HOST_TEST_CHK(err == OS_ERR_NONE);
+    OSTaskChangePrio(&TestBusyTCB[1], TEST_PRIO_RR, &err);
+    HOST_TEST_CHK(err == OS_ERR_NONE);
+    OSTaskTimeQuantaSet(&TestBusyTCB[0], TEST_QUANTA_A, &err);
+    OSTaskTimeQuantaSet(&TestBusyTCB[1], TEST_QUANTA_B, &err);
+    OSSchedRoundRobinCfg(DEF_TRUE, 1u, &err);
+    HOST_TEST_CHK(err == OS_ERR_NONE);
+    OSTimeDly(TEST_QUANTA_A + TEST_QUANTA_B, OS_OPT_TIME_DLY, &err);
+    share = TestShare(TEST_TICKS, &irqs);
+    exp   = TEST_QUANTA_A * 100u / (TEST_QUANTA_A + TEST_QUANTA_B);
+    printf("round-robin %u:%u ticks: share=%u%% (expected %u%%), tick irqs=%u in %u ticks\n",
+           (unsigned)TEST_QUANTA_A, (unsigned)TEST_QUANTA_B, (unsigned)share, (unsigned)exp,
+           (unsigned)irqs, (unsigned)TEST_TICKS);
+    HOST_TEST_CHK((share + TEST_TOL >= exp) && (share <= exp + TEST_TOL));
+#if (OS_CFG_DYN_TICK_EN == DEF_ENABLED)
+    HOST_TEST_CHK(irqs < TEST_TICKS / 2u);
+#else
+    HOST_TEST_CHK(irqs + TEST_TICKS / 10u >= TEST_TICKS);
+#endif
+    HostTestPass("budget");
+}
+
+
+int  main (void)
+{
+    HostTestInit();
+    HostTestTaskCreate(&TestTCB, "Test Task", TestTask, (void *)0, 4u, &TestStk[0], 512u);
+    HostTestStart();
+    return (1);
+}
@@ -0,0 +1,14 @@
+/*
+*********************************************************************************************************
+*                                HOST TEST CONFIGURATION: PERIODIC TICK
+*
+* Filename : os_cfg.h
+*
+* Note(s)  : (1) The project configuration with a tick interrupt on every tick.
+*********************************************************************************************************
+*/
+
+#include  "../../../../uCOS/uC-CFG/os_cfg.h"
+
+#undef   OS_CFG_DYN_TICK_EN
+#define  OS_CFG_DYN_TICK_EN              DEF_DISABLED
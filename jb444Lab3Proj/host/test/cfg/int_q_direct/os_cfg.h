@@ -0,0 +1,14 @@
+/*
+*********************************************************************************************************
+*                            HOST TEST CONFIGURATION: ISR POSTS, NOT DEFERRED
+*
+* Filename : os_cfg.h
+*
+* Note(s)  : (1) The project configuration with posts from ISRs performed in the ISR, for comparison.
+*********************************************************************************************************
+*/
+
+#include  "../../../../uCOS/uC-CFG/os_cfg.h"
+
+#undef   OS_CFG_ISR_POST_DEFERRED_EN
+#define  OS_CFG_ISR_POST_DEFERRED_EN     DEF_DISABLED
@@ -0,0 +1,18 @@
+/*
+*********************************************************************************************************
+*                                HOST TEST CONFIGURATION: LOCK-FREE PARTITIONS
+*
+* Filename : os_cfg.h
+*
+* Note(s)  : (1) The project configuration with OSMemGet() and OSMemPut() on CPU_AtomicCmpSwap(), and
+*                argument checking so that OSMemPut() also checks the block is of the partition.
+*********************************************************************************************************
+*/
+
+#include  "../../../../uCOS/uC-CFG/os_cfg.h"
+
+#undef   OS_CFG_MEM_LOCK_FREE_EN
+#define  OS_CFG_MEM_LOCK_FREE_EN         DEF_ENABLED
+
+#undef   OS_CFG_ARG_CHK_EN
+#define  OS_CFG_ARG_CHK_EN               DEF_ENABLED
@@ -0,0 +1,14 @@
+/*
+*********************************************************************************************************
+*                             HOST TEST CONFIGURATION: REFERENCE-COUNTED BLOCKS
+*
+* Filename : os_cfg.h
+*
+* Note(s)  : (1) The project configuration with OSMemRefGet() and OSQPostRef() included.
+*********************************************************************************************************
+*/
+
+#include  "../../../../uCOS/uC-CFG/os_cfg.h"
+
+#undef   OS_CFG_MEM_REF_EN
+#define  OS_CFG_MEM_REF_EN               DEF_ENABLED
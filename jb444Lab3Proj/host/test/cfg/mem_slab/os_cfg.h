@@ -0,0 +1,14 @@
+/*
+*********************************************************************************************************
+*                                  HOST TEST CONFIGURATION: SLAB ALLOCATOR
+*
+* Filename : os_cfg.h
+*
+* Note(s)  : (1) The project configuration with OSMemSlabCreate(), OSMemSlabAlloc() and OSMemSlabFree().
+*********************************************************************************************************
+*/
+
+#include  "../../../../uCOS/uC-CFG/os_cfg.h"
+
+#undef   OS_CFG_MEM_SLAB_EN
+#define  OS_CFG_MEM_SLAB_EN              DEF_ENABLED
@@ -0,0 +1,14 @@
+/*
+*********************************************************************************************************
+*                                HOST TEST CONFIGURATION: PER-QUEUE MESSAGE POOLS
+*
+* Filename : os_cfg.h
+*
+* Note(s)  : (1) The project configuration with OSMsgPoolCreate() and OSQPoolSet() included.
+*********************************************************************************************************
+*/
+
+#include  "../../../../uCOS/uC-CFG/os_cfg.h"
+
+#undef   OS_CFG_MSG_POOL_LOCAL_EN
+#define  OS_CFG_MSG_POOL_LOCAL_EN        DEF_ENABLED
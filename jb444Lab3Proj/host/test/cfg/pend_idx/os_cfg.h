@@ -0,0 +1,18 @@
+/*
+*********************************************************************************************************
+*                                HOST TEST CONFIGURATION: PEND LIST INDEX
+*
+* Filename : os_cfg.h
+*
+* Note(s)  : (1) The project configuration with 256 priorities, of which the pend list index covers
+*                the first 64, so that both indexed and walked insertions are exercised.
+*********************************************************************************************************
+*/
+
+#include  "../../../../uCOS/uC-CFG/os_cfg.h"
+
+#undef   OS_CFG_PRIO_MAX
+#define  OS_CFG_PRIO_MAX                256u
+
+#undef   OS_CFG_PEND_IDX_PRIO_MAX
+#define  OS_CFG_PEND_IDX_PRIO_MAX        64u
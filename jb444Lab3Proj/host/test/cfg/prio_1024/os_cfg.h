@@ -0,0 +1,15 @@
+/*
+*********************************************************************************************************
+*                                HOST TEST CONFIGURATION: 1024 PRIORITIES
+*
+* Filename : os_cfg.h
+*
+* Note(s)  : (1) The project configuration with 1024 task priorities, so that the ready bitmap
+*                has 32 table entries and a group word.
+*********************************************************************************************************
+*/
+
+#include  "../../../../uCOS/uC-CFG/os_cfg.h"
+
+#undef   OS_CFG_PRIO_MAX
+#define  OS_CFG_PRIO_MAX               1024u
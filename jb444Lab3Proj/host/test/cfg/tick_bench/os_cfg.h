@@ -0,0 +1,20 @@
+/*
+*********************************************************************************************************
+*                                 HOST TEST CONFIGURATION: TICK BENCHMARK
+*
+* Filename : os_cfg.h
+*
+* Note(s)  : (1) The project configuration without the statistic and timer tasks. Their 10 Hz delays
+*                would cap every dynamic tick step at 100 ticks, and the benchmark is about long steps.
+*
+*            (2) The tick lists are kept in the timing wheel, see tick_bench_list for the delta lists.
+*********************************************************************************************************
+*/
+
+#include  "../tick_wheel/os_cfg.h"
+
+#undef   OS_CFG_STAT_TASK_EN
+#define  OS_CFG_STAT_TASK_EN             DEF_DISABLED
+
+#undef   OS_CFG_TMR_EN
+#define  OS_CFG_TMR_EN                   DEF_DISABLED
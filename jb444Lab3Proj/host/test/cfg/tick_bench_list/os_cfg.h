@@ -0,0 +1,15 @@
+/*
+*********************************************************************************************************
+*                            HOST TEST CONFIGURATION: TICK BENCHMARK, DELTA LISTS
+*
+* Filename : os_cfg.h
+*
+* Note(s)  : (1) The tick benchmark configuration with the tick lists kept as delta lists, for
+*                comparison.
+*********************************************************************************************************
+*/
+
+#include  "../tick_bench/os_cfg.h"
+
+#undef   OS_CFG_TICK_WHEEL_EN
+#define  OS_CFG_TICK_WHEEL_EN            DEF_DISABLED
@@ -0,0 +1,15 @@
+/*
+*********************************************************************************************************
+*                                   HOST TEST CONFIGURATION: TICK WHEEL
+*
+* Filename : os_cfg.h
+*
+* Note(s)  : (1) The project configuration with the tick lists kept in the timing wheel, which the
+*                project leaves disabled.
+*********************************************************************************************************
+*/
+
+#include  "../../../../uCOS/uC-CFG/os_cfg.h"
+
+#undef   OS_CFG_TICK_WHEEL_EN
+#define  OS_CFG_TICK_WHEEL_EN            DEF_ENABLED
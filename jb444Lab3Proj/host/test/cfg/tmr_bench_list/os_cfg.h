@@ -0,0 +1,15 @@
+/*
+*********************************************************************************************************
+*                              HOST TEST CONFIGURATION: TIMER LIST BENCHMARK
+*
+* Filename : os_cfg.h
+*
+* Note(s)  : (1) The project configuration with the timers kept in the plain timer list, which the
+*                timer task walks on every timer tick.
+*********************************************************************************************************
+*/
+
+#include  "../../../../uCOS/uC-CFG/os_cfg.h"
+
+#undef   OS_CFG_TMR_WHEEL_EN
+#define  OS_CFG_TMR_WHEEL_EN             DEF_DISABLED
@@ -0,0 +1,14 @@
+/*
+*********************************************************************************************************
+*                                   HOST TEST CONFIGURATION: NO TRACE
+*
+* Filename : os_cfg.h
+*
+* Note(s)  : (1) The project configuration with the OS_TRACE_xxx() hooks compiled out.
+*********************************************************************************************************
+*/
+
+#include  "../../../../uCOS/uC-CFG/os_cfg.h"
+
+#undef   OS_CFG_TRACE_EN
+#define  OS_CFG_TRACE_EN                 DEF_DISABLED
@@ -0,0 +1,68 @@
+/*
+*********************************************************************************************************
+*                                      HOST TEST: BOOT CHECKSUM
+*
+* Filename : chksum.c
+*
+* Note(s)  : (1) CalcChkSum() must return the same 16-bit sum as the original byte loop, end address
+*                included, for 20000 random ranges of random bytes. Ranges start and end at every
+*                alignment and are 1 byte to 64 KB long. Ranges of 0xFF bytes check that the lanes
+*                are folded before they can overflow.
+*
+*            (2) The host has no USADA8, so this checks the portable word sum, not the DSP one.
+*********************************************************************************************************
+*/
+
+#include  "host_test.h"
+#include  "MemTest.h"
+
+
+#define  TEST_RANGES            20000u
+#define  TEST_BUF_BYTES         65536u
+
+
+static  INT8U  TestBuf[TEST_BUF_BYTES + 8u];
+
+
+static  INT16U  TestSumBytes (const INT8U  *startaddr,
+                              const INT8U  *endaddr)
+{
+    INT32U  sum;
+
+
+    sum = 0u;
+    while (startaddr <= endaddr) {
+        sum += *startaddr;
+        startaddr++;
+    }
+    return ((INT16U)sum);
+}
+
+
+int  main (void)
+{
+    CPU_INT32U  seed;
+    CPU_INT32U  i;
+    CPU_INT32U  j;
+    CPU_INT32U  r;
+    CPU_INT32U  off;
+    CPU_INT32U  len;
+    INT8U       fill;
+
+
+    seed = 12345u;
+    for (i = 0u; i < TEST_RANGES; i++) {
+        r    = HostTestRand(&seed);
+        off  = r & 7u;
+        len  = 1u + (((r >> 3) & 1u) ? HostTestRand(&seed) % 64u : HostTestRand(&seed) % TEST_BUF_BYTES);
+        fill = (((r >> 4) & 15u) == 0u) ? 0xFFu : 0u;
+        for (j = 0u; j < off + len; j++) {
+            TestBuf[j] = (fill != 0u) ? fill : (INT8U)HostTestRand(&seed);
+        }
+        HOST_TEST_CHK(CalcChkSum(&TestBuf[off], &TestBuf[off + len - 1u]) ==
+                      TestSumBytes(&TestBuf[off], &TestBuf[off + len - 1u]));
+    }
+    printf("chksum ranges=%u\n", (unsigned)TEST_RANGES);
+    HostTestPass("chksum");
+    return (0);
+}
@@ -0,0 +1,82 @@
+/*
+*********************************************************************************************************
+*                                     HOST BENCHMARK: BOOT CHECKSUM
+*
+* Filename : chksum_bench.c
+*
+* Note(s)  : (1) Usage: chksum_bench <bytes>. Times CalcChkSum() and the original byte loop over the
+*                same random buffer and prints the best of 20 runs of each.
+*
+*            (2) The host runs the portable word sum. On the board USADA8 does a word in one
+*                instruction, so the speedup there is not the one printed here.
+*********************************************************************************************************
+*/
+
+#include  "host_test.h"
+#include  "MemTest.h"
+
+
+#define  TEST_BYTES_MAX      (2u * 1024u * 1024u)               /* K65 flash                            */
+#define  TEST_RUNS              20u
+
+
+static  INT8U  TestBuf[TEST_BYTES_MAX];
+
+
+static  INT16U  TestSumBytes (volatile const INT8U  *startaddr,
+                              volatile const INT8U  *endaddr)
+{
+    INT32U  sum;
+
+
+    sum = 0u;                                                   /* volatile: not vectorised by the host */
+    while (startaddr <= endaddr) {
+        sum += *startaddr;
+        startaddr++;
+    }
+    return ((INT16U)sum);
+}
+
+
+int  main (int    argc,
+           char  *argv[])
+{
+    CPU_INT32U  bytes;
+    CPU_INT32U  seed;
+    CPU_INT32U  i;
+    CPU_INT64U  ns;
+    CPU_INT64U  best_word;
+    CPU_INT64U  best_byte;
+    INT16U      sum_word;
+    INT16U      sum_byte;
+
+
+    bytes = (argc > 1) ? (CPU_INT32U)atoi(argv[1]) : 65536u;
+    HOST_TEST_CHK((bytes > 0u) && (bytes <= TEST_BYTES_MAX));
+    seed  = 12345u;
+    for (i = 0u; i < bytes; i++) {
+        TestBuf[i] = (INT8U)HostTestRand(&seed);
+    }
+    best_word = (CPU_INT64U)-1;
+    best_byte = (CPU_INT64U)-1;
+    for (i = 0u; i < TEST_RUNS; i++) {
+        ns       = HostTestNs();
+        sum_word = CalcChkSum(&TestBuf[0], &TestBuf[bytes - 1u]);
+        ns       = HostTestNs() - ns;
+        if (best_word > ns) {
+            best_word = ns;
+        }
+        ns       = HostTestNs();
+        sum_byte = TestSumBytes(&TestBuf[0], &TestBuf[bytes - 1u]);
+        ns       = HostTestNs() - ns;
+        if (best_byte > ns) {
+            best_byte = ns;
+        }
+        HOST_TEST_CHK(sum_word == sum_byte);
+    }
+    printf("chksum bytes=%-8u word=%9u ns  byte=%9u ns  speedup=%5.1fx\n",
+           (unsigned)bytes, (unsigned)best_word, (unsigned)best_byte,
+           (double)best_byte / (double)best_word);
+    HostTestPass("chksum_bench");
+    return (0);
+}
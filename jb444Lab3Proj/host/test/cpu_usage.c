@@ -0,0 +1,110 @@
+/*
+*********************************************************************************************************
+*                                         HOST TEST: CPU USAGE
+*
+* Filename : cpu_usage.c
+*
+* Note(s)  : (1) The idle task sleeps until the next interrupt, as with WFI on the board, so the
+*                idle counter stays near zero and would report the CPU as fully busy. The statistic
+*                task must take CPU usage from the task and ISR cycles instead (see os.h, CPU USAGE).
+*
+*            (2) A load task spins for TEST_BUSY_PCT of each period of TEST_PERIOD ticks and delays
+*                for the rest. Averaged over TEST_SAMPLES statistic periods, the overall usage and the
+*                load task's .CPUUsage must be within TEST_TOL of TEST_BUSY_PCT, and the usage must
+*                fall below TEST_TOL once the load task stops.
+*
+*            (3) Runs on the SIGALRM tick (cpu_usage_VIRTUAL = 0): the virtual tick skips the time the
+*                CPU would sleep, so there would be no idle time to measure.
+*********************************************************************************************************
+*/
+
+#include  "host_test.h"
+
+
+#define  TEST_PERIOD               10u                          /* Ticks                                */
+#define  TEST_BUSY_PCT             30u
+#define  TEST_TOL                   8u                          /* Percent                              */
+#define  TEST_SAMPLES              20u
+#define  TEST_STAT_TICKS          (OS_CFG_TICK_RATE_HZ / OS_CFG_STAT_TASK_RATE_HZ)
+
+
+static  volatile  CPU_BOOLEAN  TestLoadRun = DEF_TRUE;
+static  OS_TCB      TestTCB;
+static  CPU_STK     TestStk[512];
+static  OS_TCB      TestLoadTCB;
+static  CPU_STK     TestLoadStk[512];
+
+
+static  void  TestLoad (void  *p_arg)
+{
+    OS_ERR      err;
+    CPU_INT64U  busy_ns;
+    CPU_INT64U  ns;
+
+
+    (void)p_arg;
+    busy_ns = 1000000000ull / OS_CFG_TICK_RATE_HZ * TEST_PERIOD * TEST_BUSY_PCT / 100u;
+    while (TestLoadRun == DEF_TRUE) {
+        ns = HostTestNs();
+        while (HostTestNs() - ns < busy_ns) {
+            ;
+        }
+        OSTimeDly(TEST_PERIOD - TEST_PERIOD * TEST_BUSY_PCT / 100u, OS_OPT_TIME_DLY, &err);
+    }
+    OSTaskDel((OS_TCB *)0, &err);
+}
+
+
+static  CPU_INT32U  TestUsage (OS_TCB  *p_tcb)
+{
+    OS_ERR      err;
+    CPU_INT32U  i;
+    CPU_INT32U  sum;
+
+
+    sum = 0u;
+    for (i = 0u; i < TEST_SAMPLES; i++) {
+        OSTimeDly(TEST_STAT_TICKS, OS_OPT_TIME_DLY, &err);
+        HOST_TEST_CHK(err == OS_ERR_NONE);
+        sum += (p_tcb != (OS_TCB *)0) ? p_tcb->CPUUsage : OSStatTaskCPUUsage;
+    }
+    return (sum / TEST_SAMPLES / 100u);                         /* In percent                           */
+}
+
+
+static  void  TestTask (void  *p_arg)
+{
+    OS_ERR      err;
+    CPU_INT32U  total;
+    CPU_INT32U  load;
+    CPU_INT32U  idle;
+
+
+    (void)p_arg;
+    OS_CPU_SysTickInitFreq(0u);
+    OSStatTaskCPUUsageInit(&err);
+    HOST_TEST_CHK(err == OS_ERR_NONE);
+    HostTestTaskCreate(&TestLoadTCB, "Load Task", TestLoad, (void *)0, 5u, &TestLoadStk[0], 512u);
+    OSTimeDly(3u * TEST_STAT_TICKS, OS_OPT_TIME_DLY, &err);     /* Let the statistics settle            */
+
+    total = TestUsage((OS_TCB *)0);
+    load  = TestUsage(&TestLoadTCB);
+    TestLoadRun = DEF_FALSE;
+    OSTimeDly(3u * TEST_STAT_TICKS, OS_OPT_TIME_DLY, &err);
+    idle  = TestUsage((OS_TCB *)0);
+    printf("cpu usage loaded=%u%% load task=%u%% idle=%u%% (expected %u%%)\n",
+           (unsigned)total, (unsigned)load, (unsigned)idle, (unsigned)TEST_BUSY_PCT);
+    HOST_TEST_CHK((total + TEST_TOL >= TEST_BUSY_PCT) && (total <= TEST_BUSY_PCT + TEST_TOL));
+    HOST_TEST_CHK((load  + TEST_TOL >= TEST_BUSY_PCT) && (load  <= TEST_BUSY_PCT + TEST_TOL));
+    HOST_TEST_CHK(idle < TEST_TOL);
+    HostTestPass("cpu_usage");
+}
+
+
+int  main (void)
+{
+    HostTestInit();
+    HostTestTaskCreate(&TestTCB, "Test Task", TestTask, (void *)0, 4u, &TestStk[0], 512u);
+    HostTestStart();
+    return (1);
+}
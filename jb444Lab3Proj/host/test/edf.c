@@ -0,0 +1,213 @@
+/*
+*********************************************************************************************************
+*                                      HOST TEST: EDF JOB RELEASES
+*
+* Filename : edf.c
+*
+* Note(s)  : (1) A task with a deadline (the job task, above the test task) is woken in each way the
+*                kernel has. A post to its task semaphore or to its flag group, the end of its delay
+*                and the timeout of its pend release a new job: .EdfJobCtr goes up and .EdfDeadlineAbs
+*                is 'deadline' ticks after the new .EdfRelease. OSTaskSemPendAbort(), OSFlagPendAbort(),
+*                OSTimeDlyResume() and OSTaskResume() of a task that suspended itself make it ready
+*                without one: both stay as they were. See os_edf.c Note #2.
+*
+*            (2) A post to a task suspended while it pended releases its job when it is resumed, not
+*                before.
+*
+*            (3) The test task lets a tick pass before each wake-up, so a new release would differ from
+*                the one before.
+*********************************************************************************************************
+*/
+
+#include  "host_test.h"
+
+
+#define  TEST_DEADLINE              5u
+#define  TEST_DLY_SHORT             3u
+#define  TEST_DLY_LONG            100u
+#define  TEST_FLAG           (OS_FLAGS)1u
+
+#define  TEST_MODE_SEM              0u                          /* What the job task waits on next      */
+#define  TEST_MODE_SEM_TOUT         1u
+#define  TEST_MODE_FLAG             2u
+#define  TEST_MODE_DLY              3u
+#define  TEST_MODE_SUSPEND          4u
+
+
+static  OS_FLAG_GRP          TestGrp;
+static  volatile CPU_INT32U  TestMode;
+static  volatile OS_TICK     TestDly;
+static  volatile CPU_INT32U  TestRuns;
+static  OS_TCB               TestTCB;
+static  CPU_STK              TestStk[512];
+static  OS_TCB               TestJobTCB;
+static  CPU_STK              TestJobStk[256];
+
+static  OS_CTR               TestJobs;                          /* As marked by TestMark()              */
+static  OS_TICK              TestReleaseLast;
+static  OS_TICK              TestDeadlineLast;
+static  CPU_INT32U           TestRunsLast;
+
+
+static  void  TestJob (void  *p_arg)
+{
+    OS_ERR  err;
+
+
+    (void)p_arg;
+    while (DEF_ON) {
+        switch (TestMode) {
+            case TEST_MODE_SEM:
+                 (void)OSTaskSemPend(0u, OS_OPT_PEND_BLOCKING, (CPU_TS *)0, &err);
+                 break;
+
+            case TEST_MODE_SEM_TOUT:
+                 (void)OSTaskSemPend(TestDly, OS_OPT_PEND_BLOCKING, (CPU_TS *)0, &err);
+                 break;
+
+            case TEST_MODE_FLAG:
+                 (void)OSFlagPend(&TestGrp, TEST_FLAG, 0u,
+                                  OS_OPT_PEND_FLAG_SET_ANY | OS_OPT_PEND_FLAG_CONSUME | OS_OPT_PEND_BLOCKING,
+                                  (CPU_TS *)0, &err);
+                 break;
+
+            case TEST_MODE_DLY:
+                 OSTimeDly(TestDly, OS_OPT_TIME_DLY, &err);
+                 break;
+
+            default:
+                 OSTaskSuspend((OS_TCB *)0, &err);
+                 break;
+        }
+        TestRuns++;
+    }
+}
+
+
+static  void  TestMark (CPU_INT32U  mode,                       /* Before a wake-up, see Note #3        */
+                        OS_TICK     dly)
+{
+    OS_ERR  err;
+
+
+    OSTimeDly(1u, OS_OPT_TIME_DLY, &err);
+    HOST_TEST_CHK(err == OS_ERR_NONE);
+    TestMode         = mode;                                    /* What to wait on after this wake-up   */
+    TestDly          = dly;
+    TestJobs         = TestJobTCB.EdfJobCtr;
+    TestReleaseLast  = TestJobTCB.EdfRelease;
+    TestDeadlineLast = TestJobTCB.EdfDeadlineAbs;
+    TestRunsLast     = TestRuns;
+}
+
+
+static  void  TestChk (CPU_BOOLEAN  job,
+                       CPU_INT32U   runs)
+{
+    HOST_TEST_CHK(TestRuns == TestRunsLast + runs);
+    if (job == DEF_YES) {
+        HOST_TEST_CHK(TestJobTCB.EdfJobCtr      == TestJobs + 1u);
+        HOST_TEST_CHK(TestJobTCB.EdfRelease     != TestReleaseLast);
+        HOST_TEST_CHK(TestJobTCB.EdfDeadlineAbs == TestJobTCB.EdfRelease + TEST_DEADLINE);
+    } else {
+        HOST_TEST_CHK(TestJobTCB.EdfJobCtr      == TestJobs);
+        HOST_TEST_CHK(TestJobTCB.EdfRelease     == TestReleaseLast);
+        HOST_TEST_CHK(TestJobTCB.EdfDeadlineAbs == TestDeadlineLast);
+    }
+}
+
+
+static  void  TestTask (void  *p_arg)
+{
+    OS_ERR  err;
+
+
+    (void)p_arg;
+    OS_CPU_SysTickInitFreq(0u);
+    OSTaskEdfSet(&TestJobTCB, 0u, TEST_DEADLINE, &err);         /* Job task pends on its semaphore      */
+    HOST_TEST_CHK(err == OS_ERR_NONE);
+    HOST_TEST_CHK(TestJobTCB.EdfJobCtr == 0u);
+                                                                /* ----------- RELEASES (Note #1) ----- */
+    TestMark(TEST_MODE_SEM, 0u);
+    (void)OSTaskSemPost(&TestJobTCB, OS_OPT_POST_NONE, &err);
+    TestChk(DEF_YES, 1u);
+
+    TestMark(TEST_MODE_FLAG, 0u);
+    (void)OSTaskSemPost(&TestJobTCB, OS_OPT_POST_NONE, &err);
+    TestChk(DEF_YES, 1u);
+    TestMark(TEST_MODE_SEM, 0u);
+    (void)OSFlagPost(&TestGrp, TEST_FLAG, OS_OPT_POST_FLAG_SET, &err);
+    TestChk(DEF_YES, 1u);
+
+    TestMark(TEST_MODE_DLY, TEST_DLY_SHORT);
+    (void)OSTaskSemPost(&TestJobTCB, OS_OPT_POST_NONE, &err);
+    TestChk(DEF_YES, 1u);
+    TestMark(TEST_MODE_SEM, 0u);
+    OSTimeDly(TEST_DLY_SHORT, OS_OPT_TIME_DLY, &err);           /* Job task's delay ends                */
+    TestChk(DEF_YES, 1u);
+
+    TestMark(TEST_MODE_SEM_TOUT, TEST_DLY_SHORT);
+    (void)OSTaskSemPost(&TestJobTCB, OS_OPT_POST_NONE, &err);
+    TestChk(DEF_YES, 1u);
+    TestMark(TEST_MODE_SEM, 0u);
+    OSTimeDly(TEST_DLY_SHORT, OS_OPT_TIME_DLY, &err);           /* Job task's pend times out            */
+    TestChk(DEF_YES, 1u);
+                                                                /* ----------- NO RELEASE (Note #1) --- */
+    TestMark(TEST_MODE_SEM, 0u);
+    (void)OSTaskSemPendAbort(&TestJobTCB, OS_OPT_POST_NONE, &err);
+    HOST_TEST_CHK(err == OS_ERR_NONE);
+    TestChk(DEF_NO, 1u);
+
+    TestMark(TEST_MODE_FLAG, 0u);
+    (void)OSTaskSemPost(&TestJobTCB, OS_OPT_POST_NONE, &err);
+    TestMark(TEST_MODE_SEM, 0u);
+    (void)OSFlagPendAbort(&TestGrp, OS_OPT_PEND_ABORT_1, &err);
+    HOST_TEST_CHK(err == OS_ERR_NONE);
+    TestChk(DEF_NO, 1u);
+
+    TestMark(TEST_MODE_DLY, TEST_DLY_LONG);
+    (void)OSTaskSemPost(&TestJobTCB, OS_OPT_POST_NONE, &err);
+    TestMark(TEST_MODE_SEM, 0u);
+    OSTimeDlyResume(&TestJobTCB, &err);
+    HOST_TEST_CHK(err == OS_ERR_NONE);
+    TestChk(DEF_NO, 1u);
+
+    TestMark(TEST_MODE_SUSPEND, 0u);
+    (void)OSTaskSemPost(&TestJobTCB, OS_OPT_POST_NONE, &err);
+    HOST_TEST_CHK(TestJobTCB.TaskState == OS_TASK_STATE_SUSPENDED);
+    TestMark(TEST_MODE_SEM, 0u);
+    OSTaskResume(&TestJobTCB, &err);
+    HOST_TEST_CHK(err == OS_ERR_NONE);
+    TestChk(DEF_NO, 1u);
+                                                                /* ----------- SUSPENDED (Note #2) ---- */
+    TestMark(TEST_MODE_SEM, 0u);
+    OSTaskSuspend(&TestJobTCB, &err);
+    HOST_TEST_CHK(err == OS_ERR_NONE);
+    (void)OSTaskSemPost(&TestJobTCB, OS_OPT_POST_NONE, &err);
+    TestChk(DEF_NO, 0u);
+    OSTimeDly(1u, OS_OPT_TIME_DLY, &err);
+    OSTaskResume(&TestJobTCB, &err);
+    HOST_TEST_CHK(err == OS_ERR_NONE);
+    TestChk(DEF_YES, 1u);
+    HOST_TEST_CHK(TestJobTCB.EdfRelease == OSTimeGet(&err));
+
+    printf("edf: %u jobs released, %u missed\n",
+           (unsigned)TestJobTCB.EdfJobCtr, (unsigned)TestJobTCB.EdfMissCtr);
+    HOST_TEST_CHK(TestJobTCB.EdfMissCtr == 0u);
+    HostTestPass("edf");
+}
+
+
+int  main (void)
+{
+    OS_ERR  err;
+
+
+    HostTestInit();
+    OSFlagCreate(&TestGrp, "EDF Flags", 0u, &err);
+    HOST_TEST_CHK(err == OS_ERR_NONE);
+    HostTestTaskCreate(&TestTCB,    "Test Task", TestTask, (void *)0, 10u, &TestStk[0],    512u);
+    HostTestTaskCreate(&TestJobTCB, "Job",       TestJob,  (void *)0,  8u, &TestJobStk[0], 256u);
+    HostTestStart();
+    return (1);
+}
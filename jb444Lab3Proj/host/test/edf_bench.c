@@ -0,0 +1,255 @@
+/*
+*********************************************************************************************************
+*                                   HOST BENCHMARK: EDF BAND MISS RATES
+*
+* Filename : edf_bench.c
+*
+* Note(s)  : (1) Usage: edf_bench <busy>. A sine job of TEST_SINE_WORK ticks is released every
+*                APP_CFG_SIN_GEN_PERIOD ticks and is due by the next release, as OutputModule.c sets
+*                it. Like the shipped sine task it has no CPU budget. UI load comes in bursts: on a
+*                random tick each of the four UI tasks gets a job of TEST_UI_WORK_MIN to
+*                TEST_UI_WORK_MAX ticks, due APP_CFG_UI_DEADLINE ticks later. The bursts are as
+*                frequent as makes the offered load <busy> percent of the CPU; skipped releases
+*                (Note #2) make the load that runs lower, and it is printed too.
+*
+*            (2) A driver task at TEST_PRIO_DRV releases the jobs each tick with OSTaskSemPost(). A
+*                job spins until its task has used the given CPU time, read from its .CyclesTotal. A
+*                job is late if it ends after its deadline. A release that finds the task's last job not
+*                ended is skipped. For the sine task that is a lost DMA block, so both count as missed;
+*                a UI task would handle the event in the job under way, so only late UI jobs count.
+*
+*            (3) Each load is run TEST_TICKS ticks twice: at the application's fixed priorities (UI
+*                tasks APP_CFG_UIx_TASK_PRIO, sine below them) and with all five in the EDF band at
+*                APP_CFG_EDF_BAND_PRIO (see UserInt.c). The kernel's .EdfMissCtr of the sine task is
+*                printed beside the driver's count for the EDF run.
+*
+*            (4) Runs on the SIGALRM tick (edf_bench_VIRTUAL = 0), so the result depends on the host:
+*                a job preempted by another process takes longer in wall time than its CPU time.
+*********************************************************************************************************
+*/
+
+#include  "host_test.h"
+#include  "app_cfg.h"
+#include  "OutputModule.h"
+#include  "UserInt.h"
+
+
+#define  TEST_TICKS              4200u
+#define  TEST_SINE_WORK             6u
+#define  TEST_UI_WORK_MIN           2u
+#define  TEST_UI_WORK_MAX           8u
+#define  TEST_PRIO_DRV              8u
+#define  TEST_SINE                  4u                          /* TestJob[] index of the sine task     */
+#define  TEST_TASKS                 5u
+
+
+typedef  struct  test_job {
+    OS_TICK      Release;
+    OS_TICK      Deadline;
+    OS_TICK      Work;
+    CPU_BOOLEAN  Busy;
+    CPU_INT32U   Jobs;
+    CPU_INT32U   Late;
+    CPU_INT32U   Skips;
+    CPU_INT32U   CpuNs;
+} TEST_JOB;
+
+
+static  const  OS_PRIO  TestPrioFixed[TEST_TASKS] = {
+    APP_CFG_UIF_TASK_PRIO,
+    APP_CFG_UIV_TASK_PRIO,
+    APP_CFG_UID_TASK_PRIO,
+    APP_CFG_UIS_TASK_PRIO,
+    APP_CFG_SIN_GEN_TASK_PRIO
+};
+
+static  volatile  TEST_JOB  TestJob[TEST_TASKS];
+static  CPU_INT32U  TestBusyPct;
+static  CPU_INT32U  TestBurstPpm;                               /* Bursts per million ticks             */
+static  OS_TCB      TestTCB;
+static  CPU_STK     TestStk[512];
+static  OS_TCB      TestJobTCB[TEST_TASKS];
+static  CPU_STK     TestJobStk[TEST_TASKS][256];
+
+
+static  CPU_INT32U  TestCpuNs (void)                            /* CPU time of the running task         */
+{
+    CPU_INT32U  ns;
+    CPU_SR_ALLOC();
+
+
+    CPU_CRITICAL_ENTER();
+    ns = (CPU_INT32U)OSTCBCurPtr->CyclesTotal + (CPU_INT32U)(OS_TS_GET() - OSTCBCurPtr->CyclesStart);
+    CPU_CRITICAL_EXIT();
+    return (ns);
+}
+
+
+static  void  TestJobTask (void  *p_arg)
+{
+    OS_ERR             err;
+    volatile TEST_JOB *p_job;
+    CPU_INT32U         work_ns;
+    CPU_INT32U         ns;
+
+
+    p_job = &TestJob[(CPU_ADDR)p_arg];
+    while (DEF_ON) {
+        (void)OSTaskSemPend(0u, OS_OPT_PEND_BLOCKING, (CPU_TS *)0, &err);
+        HOST_TEST_CHK(err == OS_ERR_NONE);
+        work_ns = p_job->Work * (1000000000u / OSCfg_TickRate_Hz);
+        ns      = TestCpuNs();
+        while (TestCpuNs() - ns < work_ns) {                    /* See Note #2                          */
+            ;
+        }
+        if ((OSTimeGet(&err) - p_job->Release) > p_job->Deadline) {
+            p_job->Late++;
+        }
+        p_job->CpuNs += work_ns;
+        p_job->Busy   = DEF_FALSE;
+    }
+}
+
+
+static  void  TestRelease (CPU_INT32U  i,
+                           OS_TICK     now,
+                           OS_TICK     work)
+{
+    OS_ERR  err;
+
+
+    TestJob[i].Jobs++;
+    if (TestJob[i].Busy == DEF_TRUE) {                          /* Previous job not done, skip this one */
+        TestJob[i].Skips++;
+        return;
+    }
+    TestJob[i].Release = now;
+    TestJob[i].Work    = work;
+    TestJob[i].Busy    = DEF_TRUE;
+    (void)OSTaskSemPost(&TestJobTCB[i], OS_OPT_POST_NONE, &err);
+}
+
+
+static  void  TestRun (CPU_BOOLEAN  edf,
+                       CPU_INT32U  *p_seed)
+{
+    OS_ERR      err;
+    OS_TICK     start;
+    OS_TICK     now;
+    CPU_INT32U  i;
+    CPU_INT32U  busy;
+    CPU_INT32U  ui_jobs;
+    CPU_INT32U  ui_late;
+    CPU_INT32U  ui_skips;
+    OS_CTR      edf_misses;
+    CPU_INT64U  ns;
+
+
+    for (i = 0u; i < TEST_TASKS; i++) {                         /* See Note #3                          */
+        OSTaskEdfSet(&TestJobTCB[i], 0u, 0u, &err);
+        HOST_TEST_CHK(err == OS_ERR_NONE);
+        OSTaskChangePrio(&TestJobTCB[i], (edf == DEF_YES) ? APP_CFG_EDF_BAND_PRIO : TestPrioFixed[i], &err);
+        HOST_TEST_CHK(err == OS_ERR_NONE);
+        if (edf == DEF_YES) {
+            OSTaskEdfSet(&TestJobTCB[i],
+                         (i == TEST_SINE) ? APP_CFG_SIN_GEN_PERIOD : 0u,
+                         TestJob[i].Deadline, &err);
+            HOST_TEST_CHK(err == OS_ERR_NONE);
+        }
+        TestJob[i].Jobs   = 0u;
+        TestJob[i].Late   = 0u;
+        TestJob[i].Skips  = 0u;
+        TestJob[i].CpuNs  = 0u;
+    }
+    edf_misses = TestJobTCB[TEST_SINE].EdfMissCtr;
+
+    ns    = HostTestNs();
+    start = OSTimeGet(&err);
+    now   = start;
+    while (now - start < TEST_TICKS) {
+        if (((now - start) % APP_CFG_SIN_GEN_PERIOD) == 0u) {
+            TestRelease(TEST_SINE, now, TEST_SINE_WORK);
+        }
+        if ((HostTestRand(p_seed) % 1000000u) < TestBurstPpm) {
+            for (i = 0u; i < TEST_SINE; i++) {
+                TestRelease(i, now, TEST_UI_WORK_MIN + HostTestRand(p_seed) % (TEST_UI_WORK_MAX - TEST_UI_WORK_MIN + 1u));
+            }
+        }
+        OSTimeDly(1u, OS_OPT_TIME_PERIODIC, &err);
+        now = OSTimeGet(&err);
+    }
+    ns = HostTestNs() - ns;
+    for (i = 0u; i < TEST_TASKS; i++) {                         /* Let the last jobs end                */
+        while (TestJob[i].Busy == DEF_TRUE) {
+            OSTimeDly(1u, OS_OPT_TIME_DLY, &err);
+        }
+    }
+
+    busy      = 0u;
+    ui_jobs   = 0u;
+    ui_late   = 0u;
+    ui_skips  = 0u;
+    for (i = 0u; i < TEST_TASKS; i++) {
+        busy += TestJob[i].CpuNs / 1000u;
+        if (i != TEST_SINE) {
+            ui_jobs   += TestJob[i].Jobs;
+            ui_late   += TestJob[i].Late;
+            ui_skips  += TestJob[i].Skips;
+        }
+    }
+    HOST_TEST_CHK((TestJob[TEST_SINE].Jobs > 0u) && (ui_jobs > 0u));
+    printf("edf load=%2u%% (ran %2u%%) %-5s sine missed %3u/%-3u (%4.1f%%)  ui late %3u/%-3u (%4.1f%%, %u skipped)",
+           (unsigned)TestBusyPct,
+           (unsigned)((CPU_INT64U)busy * 100000u / ns),
+           (edf == DEF_YES) ? "band" : "fixed",
+           (unsigned)(TestJob[TEST_SINE].Late + TestJob[TEST_SINE].Skips),
+           (unsigned)TestJob[TEST_SINE].Jobs,
+           100.0 * (TestJob[TEST_SINE].Late + TestJob[TEST_SINE].Skips) / TestJob[TEST_SINE].Jobs,
+           (unsigned)ui_late,
+           (unsigned)(ui_jobs - ui_skips),
+           100.0 * ui_late / (ui_jobs - ui_skips),
+           (unsigned)ui_skips);
+    if (edf == DEF_YES) {
+        printf("  kernel sine misses %u", (unsigned)(TestJobTCB[TEST_SINE].EdfMissCtr - edf_misses));
+    }
+    printf("\n");
+}
+
+
+static  void  TestTask (void  *p_arg)
+{
+    CPU_INT32U  seed;
+    CPU_INT32U  i;
+
+
+    (void)p_arg;
+    OS_CPU_SysTickInitFreq(0u);
+    for (i = 0u; i < TEST_TASKS; i++) {
+        TestJob[i].Deadline = (i == TEST_SINE) ? APP_CFG_SIN_GEN_DEADLINE : APP_CFG_UI_DEADLINE;
+        HostTestTaskCreate(&TestJobTCB[i], "Job", TestJobTask, (void *)(CPU_ADDR)i,
+                           TestPrioFixed[i], &TestJobStk[i][0], 256u);
+    }
+    seed = 12345u;                                              /* Same releases in both runs           */
+    TestRun(DEF_NO,  &seed);
+    seed = 12345u;
+    TestRun(DEF_YES, &seed);
+    exit(0);
+}
+
+
+int  main (int    argc,
+           char  *argv[])
+{
+    CPU_INT32U  sine_ppm;
+
+
+    TestBusyPct = (argc > 1) ? (CPU_INT32U)atoi(argv[1]) : 71u;
+    sine_ppm    = TEST_SINE_WORK * 1000000u / APP_CFG_SIN_GEN_PERIOD;
+    HOST_TEST_CHK((TestBusyPct * 10000u > sine_ppm) && (TestBusyPct < 100u));
+    TestBurstPpm = (TestBusyPct * 10000u - sine_ppm)            /* Load of one burst: 4 mean UI jobs    */
+                 / (TEST_SINE * (TEST_UI_WORK_MIN + TEST_UI_WORK_MAX) / 2u);
+    HostTestInit();
+    HostTestTaskCreate(&TestTCB, "Driver", TestTask, (void *)0, TEST_PRIO_DRV, &TestStk[0], 512u);
+    HostTestStart();
+    return (1);
+}
@@ -0,0 +1,194 @@
+/*
+*********************************************************************************************************
+*                                   HOST TEST: OUTPUT EVENT FLAG WAKEUPS
+*
+* Filename : flag_wake.c
+*
+* Note(s)  : (1) Usage: flag_wake [<rounds>]. Two waiters pend on one flag group as the output tasks
+*                do, with OS_OPT_PEND_FLAG_SET_ANY | OS_OPT_PEND_FLAG_CONSUME: the sine waiter on
+*                OUT_EV_SINE_MODE | OUT_EV_DMA_BLOCK, the square waiter on OUT_EV_SQUARE_MODE |
+*                OUT_EV_SQUARE_PARAM. Each round the test task makes one to three random posts, from
+*                task context or from a faked ISR (OSIntEnter() ... OSIntExit()) as the DMA handler,
+*                then lets the waiters run. No bit may be left in the group afterwards.
+*
+*            (2) The waiters are below the test task, so all posts of a round are made before either
+*                runs. The first post of one of a waiter's bits readies it with exactly that post's
+*                bits. Flags are not counted: later posts of those bits are consumed with them, and
+*                later posts of its other bits collect in the group and are all returned by the
+*                waiter's next pend, without blocking. So a waiter wakes at most twice per round, and
+*                the expected masks are built by TestPost() as the posts are made.
+*
+*            (3) flag_wake runs with the project's OS_CFG_ISR_POST_DEFERRED_EN, flag_wake_direct with
+*                deferred posts disabled (test/cfg/int_q_direct).
+*********************************************************************************************************
+*/
+
+#include  "host_test.h"
+#include  "OutputModule.h"
+
+
+#define  TEST_POSTS_MAX             3u
+#define  TEST_WAKES_MAX             2u
+#define  TEST_SINE                  0u
+#define  TEST_SQUARE                1u
+#define  TEST_WAITERS               2u
+
+
+static  OS_FLAG_GRP  TestGrp;
+static  CPU_INT32U   TestRounds;
+static  OS_FLAGS     TestGot[TEST_WAITERS][TEST_WAKES_MAX]; /* Masks returned this round          */
+static  CPU_INT32U   TestGotCnt[TEST_WAITERS];
+static  OS_FLAGS     TestExp[TEST_WAITERS][TEST_WAKES_MAX]; /* Masks expected this round          */
+static  CPU_INT32U   TestExpCnt[TEST_WAITERS];
+static  CPU_INT32U   TestWakes[TEST_WAITERS];
+static  CPU_INT32U   TestIsrPosts;
+static  OS_TCB       TestTCB;
+static  CPU_STK      TestStk[512];
+static  OS_TCB       TestWaitTCB[TEST_WAITERS];
+static  CPU_STK      TestWaitStk[TEST_WAITERS][256];
+
+
+static  const  OS_FLAGS  TestPend[TEST_WAITERS] = {
+    OUT_EV_SINE_MODE   | OUT_EV_DMA_BLOCK,
+    OUT_EV_SQUARE_MODE | OUT_EV_SQUARE_PARAM
+};
+
+
+static  void  TestWait (void  *p_arg)
+{
+    OS_ERR      err;
+    OS_FLAGS    flags;
+    CPU_INT32U  w;
+
+
+    w = (CPU_INT32U)(CPU_ADDR)p_arg;
+    while (DEF_ON) {
+        flags = OSFlagPend(&TestGrp, TestPend[w], 0u,           /* As OutputEventPend()                 */
+                           (OS_OPT_PEND_FLAG_SET_ANY | OS_OPT_PEND_FLAG_CONSUME | OS_OPT_PEND_BLOCKING),
+                           (CPU_TS *)0, &err);
+        HOST_TEST_CHK(err == OS_ERR_NONE);
+        HOST_TEST_CHK(TestGotCnt[w] < TEST_WAKES_MAX);
+        TestGot[w][TestGotCnt[w]] = flags;
+        TestGotCnt[w]++;
+        TestWakes[w]++;
+    }
+}
+
+
+static  void  TestPost (OS_FLAGS     flags,
+                        CPU_BOOLEAN  isr)
+{
+    OS_ERR      err;
+    OS_FLAGS    flags_w;
+    CPU_INT32U  w;
+    CPU_SR_ALLOC();
+
+
+    if (isr == DEF_YES) {
+        CPU_CRITICAL_ENTER();                                   /* As DMA0_DMA16_IRQHandler()           */
+        OSIntEnter();
+        CPU_CRITICAL_EXIT();
+        (void)OSFlagPost(&TestGrp, flags, OS_OPT_POST_FLAG_SET, &err);
+        HOST_TEST_CHK(err == OS_ERR_NONE);
+        OSIntExit();
+        TestIsrPosts++;
+    } else {
+        (void)OSFlagPost(&TestGrp, flags, OS_OPT_POST_FLAG_SET, &err);
+        HOST_TEST_CHK(err == OS_ERR_NONE);
+    }
+    for (w = 0u; w < TEST_WAITERS; w++) {                      /* See Note #2                          */
+        flags_w = flags & TestPend[w];
+        if (TestExpCnt[w] == 0u) {
+            if (flags_w != 0u) {
+                TestExp[w][0] = flags_w;
+                TestExpCnt[w] = 1u;
+            }
+        } else {
+            flags_w &= ~TestExp[w][0];
+            if (flags_w != 0u) {
+                TestExp[w][1] |= flags_w;
+                TestExpCnt[w]  = 2u;
+            }
+        }
+    }
+}
+
+
+static  void  TestTask (void  *p_arg)
+{
+    static  const  OS_FLAGS  posts[] = {                        /* What UserInt.c and the ISR post      */
+        OUT_EV_MODE,
+        OUT_EV_SQUARE_PARAM,
+        OUT_EV_DMA_BLOCK,
+        OUT_EV_SINE_MODE | OUT_EV_DMA_BLOCK
+    };
+    OS_ERR      err;
+    CPU_INT32U  seed;
+    CPU_INT32U  round;
+    CPU_INT32U  n;
+    CPU_INT32U  i;
+    CPU_INT32U  w;
+    CPU_INT32U  r;
+    CPU_INT32U  posted;
+
+
+    (void)p_arg;
+    OS_CPU_SysTickInitFreq(0u);
+    OSTimeDly(1u, OS_OPT_TIME_DLY, &err);                       /* Both waiters pend                    */
+    posted = 0u;
+    seed   = 12345u;
+    for (round = 0u; round < TestRounds; round++) {
+        HOST_TEST_CHK(TestGrp.PendList.NbrEntries == TEST_WAITERS);
+        for (w = 0u; w < TEST_WAITERS; w++) {
+            TestGotCnt[w] = 0u;
+            TestExpCnt[w] = 0u;
+            TestExp[w][1] = 0u;
+        }
+        n = 1u + HostTestRand(&seed) % TEST_POSTS_MAX;
+        for (i = 0u; i < n; i++) {
+            r = HostTestRand(&seed);
+            TestPost(posts[r % (sizeof(posts) / sizeof(posts[0]))], ((r >> 8) & 1u) != 0u);
+            posted++;
+        }
+
+        OSTimeDly(1u, OS_OPT_TIME_DLY, &err);                   /* Let the waiters run                  */
+        HOST_TEST_CHK(TestGrp.Flags == 0u);                     /* Every bit consumed                   */
+        for (w = 0u; w < TEST_WAITERS; w++) {
+            HOST_TEST_CHK(TestGotCnt[w] == TestExpCnt[w]);
+            for (i = 0u; i < TestExpCnt[w]; i++) {
+                HOST_TEST_CHK(TestGot[w][i] == TestExp[w][i]);
+            }
+        }
+    }
+
+    printf("%-8s flag wakeups rounds=%u posts=%u (isr=%u): sine woke %u, square woke %u\n",
+           (OS_CFG_ISR_POST_DEFERRED_EN == DEF_ENABLED) ? "deferred" : "direct",
+           (unsigned)TestRounds,
+           (unsigned)posted,
+           (unsigned)TestIsrPosts,
+           (unsigned)TestWakes[TEST_SINE],
+           (unsigned)TestWakes[TEST_SQUARE]);
+    HostTestPass("flag_wake");
+}
+
+
+int  main (int    argc,
+           char  *argv[])
+{
+    OS_ERR      err;
+    CPU_INT32U  w;
+
+
+    TestRounds = (argc > 1) ? (CPU_INT32U)atoi(argv[1]) : 10000u;
+    HOST_TEST_CHK(TestRounds > 0u);
+    HostTestInit();
+    OSFlagCreate(&TestGrp, "Output Events", 0u, &err);
+    HOST_TEST_CHK(err == OS_ERR_NONE);
+    HostTestTaskCreate(&TestTCB, "Test Task", TestTask, (void *)0, 4u, &TestStk[0], 512u);
+    for (w = 0u; w < TEST_WAITERS; w++) {
+        HostTestTaskCreate(&TestWaitTCB[w], (w == TEST_SINE) ? "Sine" : "Square", TestWait,
+                           (void *)(CPU_ADDR)w, (OS_PRIO)(6u + w), &TestWaitStk[w][0], 256u);
+    }
+    HostTestStart();
+    return (1);
+}
@@ -0,0 +1,237 @@
+/*
+*********************************************************************************************************
+*                                           HOST TEST SUPPORT
+*
+* Filename : host_test.c
+*********************************************************************************************************
+*/
+
+#include  <string.h>
+#include  <sys/wait.h>
+#include  <time.h>
+#include  "host_test.h"
+
+
+/*
+*********************************************************************************************************
+*                                          REPORT A FAILED CHECK
+*********************************************************************************************************
+*/
+
+void  HostTestFail (const char  *p_file,
+                    int          line,
+                    const char  *p_expr)
+{
+    printf("FAIL %s:%d: %s (tick %u)\n", p_file, line, p_expr, (unsigned)OSTickCtr);
+    fflush(stdout);
+    exit(1);
+}
+
+
+/*
+*********************************************************************************************************
+*                                      END THE TEST, ALL CHECKS PASSED
+*********************************************************************************************************
+*/
+
+void  HostTestPass (const char  *p_name)
+{
+    printf("PASS %s\n", p_name);
+    fflush(stdout);
+    exit(0);
+}
+
+
+/*
+*********************************************************************************************************
+*                                        MONOTONIC TIME IN NS
+*********************************************************************************************************
+*/
+
+CPU_INT64U  HostTestNs (void)
+{
+    struct timespec  ts;
+
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((CPU_INT64U)ts.tv_sec * 1000000000u + (CPU_INT64U)ts.tv_nsec);
+}
+
+
+/*
+*********************************************************************************************************
+*                                     REPEATABLE PSEUDO-RANDOM NUMBER
+*
+* Note(s) : (1) A 32-bit xorshift. The seed must not be 0.
+*********************************************************************************************************
+*/
+
+CPU_INT32U  HostTestRand (CPU_INT32U  *p_seed)
+{
+    CPU_INT32U  x;
+
+
+    x        = *p_seed;
+    x       ^= x << 13;
+    x       ^= x >> 17;
+    x       ^= x <<  5;
+   *p_seed   = x;
+    return (x);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         INITIALIZE THE KERNEL
+*
+* Note(s) : (1) Interrupts stay disabled until the first task runs, as after reset on the board.
+*
+*           (2) CPU_Init() sets the timestamp frequency, as main() does on the board.
+*********************************************************************************************************
+*/
+
+void  HostTestInit (void)
+{
+    OS_ERR  err;
+
+
+    CPU_Init();                                                 /* See Note #2.                         */
+    CPU_IntDis();
+    OSInit(&err);
+    HOST_TEST_CHK(err == OS_ERR_NONE);
+}
+
+
+/*
+*********************************************************************************************************
+*                                   CREATE A TASK, FAIL THE TEST ON ERROR
+*********************************************************************************************************
+*/
+
+void  HostTestTaskCreate (OS_TCB        *p_tcb,
+                          CPU_CHAR      *p_name,
+                          OS_TASK_PTR    p_task,
+                          void          *p_arg,
+                          OS_PRIO        prio,
+                          CPU_STK       *p_stk,
+                          CPU_STK_SIZE   stk_size)
+{
+    OS_ERR  err;
+
+
+    OSTaskCreate(p_tcb,
+                 p_name,
+                 p_task,
+                 p_arg,
+                 prio,
+                 p_stk,
+                 stk_size / 10u,
+                 stk_size,
+                 0u,
+                 0u,
+                 (void *)0,
+                 (OS_OPT_TASK_STK_CHK | OS_OPT_TASK_STK_CLR),
+                &err);
+    HOST_TEST_CHK(err == OS_ERR_NONE);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          START MULTITASKING
+*
+* Note(s) : (1) The tick is started by the first task to run, with OS_CPU_SysTickInitFreq(), as on the
+*               board. OSStart() only returns on error.
+*********************************************************************************************************
+*/
+
+void  HostTestStart (void)
+{
+    OS_ERR  err;
+
+
+    OSStart(&err);
+    HOST_TEST_CHK(err == OS_ERR_NONE);
+    HostTestFail(__FILE__, __LINE__, "OSStart() returned");
+}
+
+
+/*
+*********************************************************************************************************
+*                                   WRITE A FILE, FAIL THE TEST ON ERROR
+*********************************************************************************************************
+*/
+
+void  HostTestFileWrite (const char  *p_path,
+                         const void  *p_buf,
+                         CPU_SIZE_T   size)
+{
+    FILE  *p_file;
+
+
+    p_file = fopen(p_path, "wb");
+    HOST_TEST_CHK(p_file != (FILE *)0);
+    HOST_TEST_CHK(fwrite(p_buf, 1u, size, p_file) == size);
+    HOST_TEST_CHK(fclose(p_file) == 0);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         RUN A SCRIPT FROM tools/
+*
+* Note(s) : (1) 'p_args' is the script's file name in HOST_TEST_TOOLS and its arguments. Its standard
+*               output is returned in 'p_out', zero terminated. The test fails if it does not fit.
+*
+*           (2) Returns the script's exit status, or -1 if it did not exit normally.
+*********************************************************************************************************
+*/
+
+int  HostTestTool (const char  *p_args,
+                   char        *p_out,
+                   CPU_SIZE_T   out_size)
+{
+    char        cmd[512];
+    FILE       *p_pipe;
+    CPU_SIZE_T  len;
+    CPU_SIZE_T  n;
+    int         status;
+
+
+    HOST_TEST_CHK((CPU_SIZE_T)snprintf(cmd, sizeof(cmd), "python3 %s%s", HOST_TEST_TOOLS, p_args) < sizeof(cmd));
+    fflush(stdout);
+    p_pipe = popen(cmd, "r");
+    HOST_TEST_CHK(p_pipe != (FILE *)0);
+    len = 0u;
+    do {
+        n    = fread(&p_out[len], 1u, out_size - len, p_pipe);
+        len += n;
+    } while ((n > 0u) && (len < out_size));
+    HOST_TEST_CHK(len < out_size);                              /* See Note #1                          */
+    p_out[len] = '\0';
+    status = pclose(p_pipe);
+    if (!WIFEXITED(status)) {
+        return (-1);
+    }
+    return (WEXITSTATUS(status));
+}
+
+
+/*
+*********************************************************************************************************
+*                                    LOOK FOR A LINE IN A SCRIPT'S OUTPUT
+*
+* Note(s) : (1) Prints what was looked for and the whole output when it is not there, and returns
+*               DEF_NO, for HOST_TEST_CHK() to report.
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN  HostTestFind (const char  *p_out,
+                           const char  *p_text)
+{
+    if (strstr(p_out, p_text) != (char *)0) {
+        return (DEF_YES);
+    }
+    printf("missing: \"%s\"\nin:\n%s", p_text, p_out);
+    return (DEF_NO);
+}
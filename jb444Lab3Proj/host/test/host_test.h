@@ -0,0 +1,71 @@
+/*
+*********************************************************************************************************
+*                                           HOST TEST SUPPORT
+*
+* Filename : host_test.h
+*
+* Note(s)  : (1) Each test is its own program. It prints what it measured, then exits with 0 when every
+*                check passed. HOST_TEST_CHK() ends the program with 1 on the first failed check.
+*
+*            (2) Tests run on the virtual tick (OS_CPU_CFG_HOST_TICK_VIRTUAL), so they are repeatable
+*                and do not wait on the wall clock. Benchmarks time with HostTestNs().
+*
+*            (3) A test of a script in tools/ writes what the script reads on the board (a record, a
+*                memory dump) under HOST_TEST_OUT and runs the script with HostTestTool(), which
+*                starts it with python3 from HOST_TEST_TOOLS. Paths are relative to host/, where make
+*                test runs the tests.
+*********************************************************************************************************
+*/
+
+#ifndef  HOST_TEST_H
+#define  HOST_TEST_H
+
+#include  <stdio.h>
+#include  <stdlib.h>
+#include  "os.h"
+
+
+#define  HOST_TEST_OUT              "build/"                    /* See Note #3                          */
+#define  HOST_TEST_TOOLS            "../tools/"
+
+#define  HOST_TEST_CHK(expr)        do {                                                \
+                                        if (!(expr)) {                                  \
+                                            HostTestFail(__FILE__, __LINE__, #expr);    \
+                                        }                                               \
+                                    } while (0)
+
+
+void         HostTestFail      (const char   *p_file,
+                                int           line,
+                                const char   *p_expr);
+
+void         HostTestPass      (const char   *p_name);
+
+CPU_INT64U   HostTestNs        (void);
+
+CPU_INT32U   HostTestRand      (CPU_INT32U   *p_seed);
+
+void         HostTestInit      (void);
+
+void         HostTestTaskCreate(OS_TCB       *p_tcb,
+                                CPU_CHAR     *p_name,
+                                OS_TASK_PTR   p_task,
+                                void         *p_arg,
+                                OS_PRIO       prio,
+                                CPU_STK      *p_stk,
+                                CPU_STK_SIZE  stk_size);
+
+void         HostTestStart     (void);
+
+void         HostTestFileWrite (const char   *p_path,
+                                const void   *p_buf,
+                                CPU_SIZE_T    size);
+
+int          HostTestTool      (const char   *p_args,
+                                char         *p_out,
+                                CPU_SIZE_T    out_size);
+
+CPU_BOOLEAN  HostTestFind      (const char   *p_out,
+                                const char   *p_text);
+
+#endif
@@ -0,0 +1,191 @@
+/*
+*********************************************************************************************************
+*                                   HOST TEST: DEFERRED ISR POSTS
+*
+* Filename : int_q.c
+*
+* Note(s)  : (1) Usage: int_q [<rounds>]. TEST_WAITERS tasks pend on one semaphore. In each round the
+*                test task enters ISR context (OSIntEnter()), posts the semaphore to all of them and a
+*                message to a queue, and leaves it (OSIntExit()). Every waiter must wake once per
+*                round, in priority order, and the queue's reader must get the message.
+*
+*            (2) Built with -DCPU_CFG_INT_DIS_MEAS_EN. CPU_IntDisMeasMaxCurReset() on ISR entry and
+*                CPU_IntDisMeasMaxCurGet() before OSIntExit() give the longest critical section of the
+*                ISR, in ns. The median and worst round are printed with CPU_IntDisMeasMaxGet(),
+*                the longest critical section of the whole run, task level included.
+*
+*            (3) int_q runs with the project's OS_CFG_ISR_POST_DEFERRED_EN. It must then also report
+*                OS_ERR_INT_Q_FULL for the post that does not fit the ISR queue and count it in
+*                OSIntQOvfCtr, and OS_IntQTask() must perform the posts that did. int_q_direct is
+*                built with deferred posts disabled (test/cfg/int_q_direct) for comparison.
+*********************************************************************************************************
+*/
+
+#include  <string.h>
+#include  "host_test.h"
+
+
+#define  TEST_WAITERS              20u
+#define  TEST_ROUNDS_MAX        10000u
+#define  TEST_PRIO_FIRST            6u
+
+
+static  OS_SEM      TestSem;
+static  OS_SEM      TestSemFull;
+static  OS_Q        TestQ;
+static  CPU_INT32U  TestRounds;
+static  CPU_INT32U  TestWakes;
+static  OS_PRIO     TestWakePrio;
+static  CPU_INT32U  TestMsgs;
+static  CPU_TS_TMR  TestIsrNs[TEST_ROUNDS_MAX];
+static  OS_TCB      TestTCB;
+static  CPU_STK     TestStk[512];
+static  OS_TCB      TestRdTCB;
+static  CPU_STK     TestRdStk[256];
+static  OS_TCB      TestWaitTCB[TEST_WAITERS];
+static  CPU_STK     TestWaitStk[TEST_WAITERS][256];
+
+
+static  void  TestWait (void  *p_arg)
+{
+    OS_ERR  err;
+
+
+    (void)p_arg;
+    while (DEF_ON) {
+        (void)OSSemPend(&TestSem, 0u, OS_OPT_PEND_BLOCKING, (CPU_TS *)0, &err);
+        HOST_TEST_CHK(err == OS_ERR_NONE);
+        HOST_TEST_CHK(OSTCBCurPtr->Prio > TestWakePrio);        /* Highest priority first               */
+        TestWakePrio = OSTCBCurPtr->Prio;
+        TestWakes++;
+    }
+}
+
+
+static  void  TestRd (void  *p_arg)
+{
+    OS_ERR       err;
+    OS_MSG_SIZE  size;
+    void        *p_msg;
+
+
+    (void)p_arg;
+    while (DEF_ON) {
+        p_msg = OSQPend(&TestQ, 0u, OS_OPT_PEND_BLOCKING, &size, (CPU_TS *)0, &err);
+        HOST_TEST_CHK(err == OS_ERR_NONE);
+        HOST_TEST_CHK(p_msg == (void *)&TestMsgs);
+        TestMsgs++;
+    }
+}
+
+
+static  int  TestTsCmp (const void  *p_a,
+                        const void  *p_b)
+{
+    CPU_TS_TMR  a;
+    CPU_TS_TMR  b;
+
+
+    a = *(const CPU_TS_TMR *)p_a;
+    b = *(const CPU_TS_TMR *)p_b;
+    return ((a > b) - (a < b));
+}
+
+
+static  void  TestIsrEnter (void)
+{
+    CPU_SR_ALLOC();
+
+
+    CPU_CRITICAL_ENTER();                                       /* As the board's ISR prologue          */
+    OSIntEnter();
+    CPU_CRITICAL_EXIT();
+    (void)CPU_IntDisMeasMaxCurReset();
+}
+
+
+#if (OS_CFG_ISR_POST_DEFERRED_EN == DEF_ENABLED)
+static  void  TestFull (void)
+{
+    OS_ERR      err;
+    CPU_INT32U  i;
+
+
+    TestIsrEnter();
+    for (i = 0u; i < OS_CFG_INT_Q_SIZE; i++) {
+        (void)OSSemPost(&TestSemFull, OS_OPT_POST_1, &err);
+        HOST_TEST_CHK(err == OS_ERR_NONE);
+    }
+    (void)OSSemPost(&TestSemFull, OS_OPT_POST_1, &err);
+    HOST_TEST_CHK(err == OS_ERR_INT_Q_FULL);
+    HOST_TEST_CHK(OSIntQOvfCtr == 1u);
+    OSIntExit();
+    HOST_TEST_CHK(TestSemFull.Ctr == OS_CFG_INT_Q_SIZE);        /* OS_IntQTask() ran on OSIntExit()     */
+}
+#endif
+
+
+static  void  TestTask (void  *p_arg)
+{
+    OS_ERR      err;
+    CPU_INT32U  round;
+
+
+    (void)p_arg;
+    OS_CPU_SysTickInitFreq(0u);
+    for (round = 0u; round < TestRounds; round++) {
+        OSTimeDly(1u, OS_OPT_TIME_DLY, &err);                   /* Every waiter pends again             */
+        HOST_TEST_CHK(TestSem.PendList.NbrEntries == TEST_WAITERS);
+
+        TestIsrEnter();
+        (void)OSSemPost(&TestSem, OS_OPT_POST_ALL, &err);
+        HOST_TEST_CHK(err == OS_ERR_NONE);
+        OSQPost(&TestQ, (void *)&TestMsgs, 0u, OS_OPT_POST_FIFO, &err);
+        HOST_TEST_CHK(err == OS_ERR_NONE);
+        TestIsrNs[round] = CPU_IntDisMeasMaxCurGet();
+        OSIntExit();
+
+        TestWakePrio = 0u;
+        OSTimeDly(1u, OS_OPT_TIME_DLY, &err);                   /* Let the waiters run                  */
+        HOST_TEST_CHK(TestWakes == (round + 1u) * TEST_WAITERS);
+        HOST_TEST_CHK(TestMsgs  ==  round + 1u);
+    }
+#if (OS_CFG_ISR_POST_DEFERRED_EN == DEF_ENABLED)
+    TestFull();
+#endif
+
+    qsort(&TestIsrNs[0], TestRounds, sizeof(TestIsrNs[0]), TestTsCmp);
+    printf("%-8s ISR posts to %u waiters, rounds=%u: ISR int dis median=%u ns max=%u ns, run max=%u ns\n",
+           (OS_CFG_ISR_POST_DEFERRED_EN == DEF_ENABLED) ? "deferred" : "direct",
+           (unsigned)TEST_WAITERS,
+           (unsigned)TestRounds,
+           (unsigned)TestIsrNs[TestRounds / 2u],
+           (unsigned)TestIsrNs[TestRounds - 1u],
+           (unsigned)CPU_IntDisMeasMaxGet());
+    HostTestPass("int_q");
+}
+
+
+int  main (int    argc,
+           char  *argv[])
+{
+    OS_ERR      err;
+    CPU_INT32U  i;
+
+
+    TestRounds = (argc > 1) ? (CPU_INT32U)atoi(argv[1]) : 1000u;
+    HOST_TEST_CHK((TestRounds > 0u) && (TestRounds <= TEST_ROUNDS_MAX));
+    HostTestInit();
+    OSSemCreate(&TestSem,     "Waiters", 0u, &err);
+    OSSemCreate(&TestSemFull, "Full",    0u, &err);
+    OSQCreate(&TestQ, "Queue", 4u, &err);
+    HostTestTaskCreate(&TestTCB, "Test Task", TestTask, (void *)0, 4u, &TestStk[0], 512u);
+    HostTestTaskCreate(&TestRdTCB, "Reader", TestRd, (void *)0, 26u, &TestRdStk[0], 256u);
+    for (i = 0u; i < TEST_WAITERS; i++) {                       /* Created out of priority order        */
+        HostTestTaskCreate(&TestWaitTCB[i], "Waiter", TestWait, (void *)0,
+                           (OS_PRIO)(TEST_PRIO_FIRST + (i * 7u) % TEST_WAITERS),
+                           &TestWaitStk[i][0], 256u);
+    }
+    HostTestStart();
+    return (1);
+}
@@ -0,0 +1,227 @@
+/*
+*********************************************************************************************************
+*                                     HOST TEST: LCD COMMAND QUEUE
+*
+* Filename : lcd_cmd_q.c
+*
+* Note(s)  : (1) The test task runs above the LCD task, so a burst of non-blocking writes fills the
+*                command queue before any of it is drained. Each of 2000 bursts posts 1 to 48 random
+*                text, clear line and clear layer commands to random layers, then a text of opaque
+*                characters on the top layer, then delays so the LCD task drains the queue and redraws.
+*
+*            (2) A model applies every command in the order it was posted and composites the layers.
+*                After a burst that dropped nothing the rendered frame must match the model. A command
+*                that took the place of a queued one on a full queue must leave the same frame as if
+*                both had been applied.
+*
+*            (3) The LCD task is not draining during a burst, so on a full queue the oldest command
+*                is dropped and every post must be accepted. After a burst that dropped commands the
+*                frame must show the last post. The layers are then cleared to bring the model back.
+*
+*            (4) Posts past the queue size either replace a queued command or drop the oldest. The
+*                run must see both, and LcdDispDropCntGet() must count the drops.
+*********************************************************************************************************
+*/
+
+#include  <string.h>
+#include  "host_test.h"
+#include  "LcdLayered.h"
+#include  "LcdDriver.h"
+#include  "LcdTextBuf.h"
+
+
+#define  TEST_BURSTS             2000u
+#define  TEST_BURST_CMDS_MAX       48u
+#define  TEST_TOP_LAYER           (LCD_NUM_LAYERS - 1u)
+#define  TEST_Q_SIZE               16u                          /* LcdLayered.c default LCD_CMD_Q_SIZE  */
+#define  TEST_CLEAR_BYTE         0x20
+
+
+static  INT8C       TestLayer[LCD_NUM_LAYERS][LCD_NUM_ROWS][LCD_NUM_COLS];
+static  CPU_INT32U  TestSeed = 12345u;
+static  OS_TCB      TestTCB;
+static  CPU_STK     TestStk[512];
+
+
+static  CPU_BOOLEAN  TestPost (void)
+{
+    CPU_INT32U  r;
+    INT8U       layer;
+    INT8U       row;
+    INT8U       col;
+    INT8U       len;
+    INT8U       i;
+    INT8C       text[LCD_NUM_COLS + 1];
+    INT8U       queued;
+
+
+    r     = HostTestRand(&TestSeed);
+    layer = (INT8U)(r % LCD_NUM_LAYERS);
+    row   = (INT8U)((r >> 4) % LCD_NUM_ROWS);
+    col   = (INT8U)(((r >> 8) & 3u) * 4u);                      /* Few positions, so writes often cover */
+    switch ((r >> 12) & 7u) {
+        case 0u:
+             queued = LcdDispClearAsync(layer);
+             if (queued == TRUE) {
+                 memset(&TestLayer[layer][0][0], TEST_CLEAR_BYTE, sizeof(TestLayer[layer]));
+             }
+             break;
+
+        case 1u:
+        case 2u:
+             queued = LcdDispClrLineAsync(row + 1u, layer);
+             if (queued == TRUE) {
+                 memset(&TestLayer[layer][row][0], TEST_CLEAR_BYTE, LCD_NUM_COLS);
+             }
+             break;
+
+        default:
+             len = (INT8U)(1u + ((r >> 16) % 8u));
+             for (i = 0u; i < len; i++) {                       /* Spaces are transparent               */
+                 text[i] = (INT8C)((((r >> 20) + i) % 3u == 0u) ? TEST_CLEAR_BYTE : 'a' + (r >> 24) % 26u);
+             }
+             text[len] = 0;
+             queued    = LcdDispStringAsync(row + 1u, col + 1u, layer, text);
+             if (queued == TRUE) {
+                 for (i = 0u; (i < len) && (col + i < LCD_NUM_COLS); i++) {
+                     TestLayer[layer][row][col + i] = text[i];
+                 }
+             }
+             break;
+    }
+    return ((queued == TRUE) ? DEF_YES : DEF_NO);
+}
+
+
+static  void  TestFrameChk (void)
+{
+    INT8U  layer;
+    INT8U  row;
+    INT8U  col;
+    INT8C  c;
+
+
+    for (row = 0u; row < LCD_NUM_ROWS; row++) {
+        for (col = 0u; col < LCD_NUM_COLS; col++) {
+            c = TEST_CLEAR_BYTE;
+            for (layer = 0u; layer < LCD_NUM_LAYERS; layer++) { /* Highest opaque layer is on top       */
+                if (TestLayer[layer][row][col] != TEST_CLEAR_BYTE) {
+                    c = TestLayer[layer][row][col];
+                }
+            }
+            HOST_TEST_CHK(LcdTextBufRow(row)[col] == c);
+        }
+    }
+}
+
+
+static  CPU_BOOLEAN  TestPostLast (INT8U  *p_row,
+                                   INT8U  *p_col,
+                                   INT8C  *p_text)
+{
+    CPU_INT32U  r;
+    INT8U       len;
+    INT8U       i;
+    INT8U       queued;
+
+
+    r      = HostTestRand(&TestSeed);
+    *p_row = (INT8U)(r % LCD_NUM_ROWS);
+    *p_col = (INT8U)((r >> 4) % LCD_NUM_COLS);
+    len    = (INT8U)(1u + ((r >> 8) % 8u));
+    for (i = 0u; i < len; i++) {                                /* No spaces, all of it shows on top    */
+        p_text[i] = (INT8C)('A' + ((r >> 16) + i) % 26u);
+    }
+    p_text[len] = 0;
+    queued      = LcdDispStringAsync(*p_row + 1u, *p_col + 1u, TEST_TOP_LAYER, p_text);
+    if (queued == TRUE) {
+        for (i = 0u; (i < len) && (*p_col + i < LCD_NUM_COLS); i++) {
+            TestLayer[TEST_TOP_LAYER][*p_row][*p_col + i] = p_text[i];
+        }
+    }
+    return ((queued == TRUE) ? DEF_YES : DEF_NO);
+}
+
+
+static  void  TestLastChk (INT8U   row,
+                           INT8U   col,
+                           INT8C  *p_text)
+{
+    INT8U  i;
+
+
+    for (i = 0u; (p_text[i] != 0) && (col + i < LCD_NUM_COLS); i++) {
+        HOST_TEST_CHK(LcdTextBufRow(row)[col + i] == p_text[i]);
+    }
+}
+
+
+static  void  TestTask (void  *p_arg)
+{
+    OS_ERR      err;
+    CPU_INT32U  burst;
+    CPU_INT32U  cmds;
+    CPU_INT32U  i;
+    CPU_INT32U  drops;
+    CPU_INT32U  replaced;
+    CPU_INT32U  dropped;
+    CPU_INT32U  posted;
+    INT8U       layer;
+    INT8U       row;
+    INT8U       col;
+    INT8C       text[LCD_NUM_COLS + 1];
+
+
+    (void)p_arg;
+    OS_CPU_SysTickInitFreq(0u);
+    replaced = 0u;
+    dropped  = 0u;
+    posted   = 0u;
+    for (burst = 0u; burst < TEST_BURSTS; burst++) {
+        cmds = 1u + HostTestRand(&TestSeed) % TEST_BURST_CMDS_MAX;
+        for (i = 0u; i < cmds; i++) {
+            HOST_TEST_CHK(TestPost() == DEF_YES);               /* See Note #3                          */
+        }
+        HOST_TEST_CHK(TestPostLast(&row, &col, &text[0]) == DEF_YES);
+        posted += cmds + 1u;
+        drops   = LcdDispDropCntGet() - dropped;
+        if (cmds + 1u > TEST_Q_SIZE) {                          /* Queue was empty at the start         */
+            HOST_TEST_CHK(drops <= cmds + 1u - TEST_Q_SIZE);
+            replaced += cmds + 1u - TEST_Q_SIZE - drops;
+        } else {
+            HOST_TEST_CHK(drops == 0u);
+        }
+        dropped += drops;
+        OSTimeDly(2u, OS_OPT_TIME_DLY, &err);                   /* Let the LCD task drain and redraw    */
+        HOST_TEST_CHK(err == OS_ERR_NONE);
+        TestLastChk(row, col, &text[0]);
+        if (drops == 0u) {
+            TestFrameChk();
+        } else {                                                /* Model lost track, start again        */
+            for (layer = 0u; layer < LCD_NUM_LAYERS; layer++) {
+                HOST_TEST_CHK(LcdDispClearAsync(layer) == TRUE);
+            }
+            memset(&TestLayer[0][0][0], TEST_CLEAR_BYTE, sizeof(TestLayer));
+            OSTimeDly(2u, OS_OPT_TIME_DLY, &err);
+            HOST_TEST_CHK(err == OS_ERR_NONE);
+            TestFrameChk();
+        }
+    }
+    HOST_TEST_CHK(replaced > 0u);
+    HOST_TEST_CHK(dropped  > 0u);
+    printf("lcd bursts=%u cmds=%u replaced=%u dropped=%u\n",
+           (unsigned)TEST_BURSTS, (unsigned)posted,
+           (unsigned)replaced, (unsigned)dropped);
+    HostTestPass("lcd_cmd_q");
+}
+
+
+int  main (void)
+{
+    HostTestInit();
+    LcdInit();
+    memset(&TestLayer[0][0][0], TEST_CLEAR_BYTE, sizeof(TestLayer));
+    HostTestTaskCreate(&TestTCB, "Test Task", TestTask, (void *)0, 4u, &TestStk[0], 512u);
+    HostTestStart();
+    return (1);
+}
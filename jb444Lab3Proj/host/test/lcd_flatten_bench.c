@@ -0,0 +1,156 @@
+/*
+*********************************************************************************************************
+*                                  HOST BENCHMARK: LCD LAYER COMPOSITING
+*
+* Filename : lcd_flatten_bench.c
+*
+* Note(s)  : (1) Usage: lcd_flatten_bench <percent>. Each cell of every layer is opaque with the given
+*                probability. Times lcdFlattenLayers() rebuilding the frame (a layer generation is
+*                bumped before each call), lcdFlattenLayers() finding the cached frame current, and
+*                the original byte loop, each under lcdLayersKey as the LCD task calls them. The
+*                frames from both compositors must match. The best of TEST_RUNS runs is printed.
+*
+*            (2) LcdLayered.c is included rather than linked so that its private functions and
+*                layers can be reached.
+*********************************************************************************************************
+*/
+
+#include  "host_test.h"
+#include  "../../board/LcdLayered.c"
+
+
+#define  TEST_CALLS           100000u
+#define  TEST_RUNS                 5u
+
+
+static  LCD_BUFFER  TestFlat;
+static  LCD_BUFFER  TestRef;
+static  CPU_INT32U  TestPct;
+static  OS_TCB      TestTCB;
+static  CPU_STK     TestStk[512];
+
+
+static  void  TestFlattenBytes (LCD_BUFFER  *dest_buffer,       /* lcdFlattenLayers() before the masks  */
+                                LCD_BUFFER  *src_layers)
+{
+    INT8U   layer;
+    INT8U   row;
+    INT8U   col;
+    INT8U   current_char;
+    OS_ERR  os_err;
+
+
+    OSMutexPend(&lcdLayersKey, 0, OS_OPT_PEND_BLOCKING, (CPU_TS *)0, &os_err);
+    lcdClear(dest_buffer);
+    dest_buffer->cursor.on    = FALSE;
+    dest_buffer->cursor.blink = FALSE;
+    for (layer = 0u; layer < LCD_NUM_LAYERS; layer++) {
+        if ((src_layers + layer)->hidden == 0u) {
+            for (row = 0u; row < LCD_NUM_ROWS; row++) {
+                for (col = 0u; col < LCD_NUM_COLS; col++) {
+                    current_char = (src_layers + layer)->lcd_char[row][col];
+                    if (current_char != LCD_CLEAR_BYTE) {
+                        dest_buffer->lcd_char[row][col] = current_char;
+                    }
+                }
+            }
+            dest_buffer->cursor.col   = (src_layers + layer)->cursor.col;
+            dest_buffer->cursor.row   = (src_layers + layer)->cursor.row;
+            dest_buffer->cursor.on    = (src_layers + layer)->cursor.on;
+            dest_buffer->cursor.blink = (src_layers + layer)->cursor.blink;
+        }
+    }
+    (void)OSMutexPost(&lcdLayersKey, OS_OPT_POST_NONE, &os_err);
+}
+
+
+static  CPU_INT64U  TestTime (CPU_INT32U  mode)
+{
+    CPU_INT64U  best;
+    CPU_INT64U  ns;
+    CPU_INT32U  run;
+    CPU_INT32U  i;
+
+
+    best = DEF_INT_64U_MAX_VAL;
+    for (run = 0u; run < TEST_RUNS; run++) {
+        ns = HostTestNs();
+        for (i = 0u; i < TEST_CALLS; i++) {
+            switch (mode) {
+                case 0u:
+                     lcdLayers[0].gen++;
+                     (void)lcdFlattenLayers(&TestFlat, &lcdLayers[0]);
+                     break;
+
+                case 1u:
+                     (void)lcdFlattenLayers(&TestFlat, &lcdLayers[0]);
+                     break;
+
+                default:
+                     TestFlattenBytes(&TestRef, &lcdLayers[0]);
+                     break;
+            }
+        }
+        ns = HostTestNs() - ns;
+        if (best > ns) {
+            best = ns;
+        }
+    }
+    return (best);
+}
+
+
+static  void  TestTask (void  *p_arg)
+{
+    CPU_INT32U  seed;
+    CPU_INT64U  rebuild_ns;
+    CPU_INT64U  cached_ns;
+    CPU_INT64U  bytes_ns;
+    INT8U       layer;
+    INT8U       row;
+    INT8U       col;
+
+
+    (void)p_arg;
+    OS_CPU_SysTickInitFreq(0u);
+    seed = 12345u;
+    for (layer = 0u; layer < LCD_NUM_LAYERS; layer++) {
+        for (row = 0u; row < LCD_NUM_ROWS; row++) {
+            for (col = 0u; col < LCD_NUM_COLS; col++) {
+                if ((HostTestRand(&seed) % 100u) < TestPct) {
+                    lcdPutChar(&lcdLayers[layer], row, col, (INT8C)('A' + HostTestRand(&seed) % 26u));
+                }
+            }
+        }
+        lcdLayers[layer].gen++;
+    }
+
+    rebuild_ns = TestTime(0u);
+    cached_ns  = TestTime(1u);
+    bytes_ns   = TestTime(2u);
+    for (row = 0u; row < LCD_NUM_ROWS; row++) {
+        for (col = 0u; col < LCD_NUM_COLS; col++) {
+            HOST_TEST_CHK(TestFlat.lcd_char[row][col] == TestRef.lcd_char[row][col]);
+        }
+    }
+    printf("lcd flatten opaque=%3u%%  byte loop=%6.1f ns  masks=%6.1f ns (x%.1f)  cached=%5.1f ns\n",
+           (unsigned)TestPct,
+           (double)bytes_ns   / TEST_CALLS,
+           (double)rebuild_ns / TEST_CALLS,
+           (double)bytes_ns   / (double)rebuild_ns,
+           (double)cached_ns  / TEST_CALLS);
+    exit(0);
+}
+
+
+int  main (int    argc,
+           char  *argv[])
+{
+    TestPct = (argc > 1) ? (CPU_INT32U)atoi(argv[1]) : 50u;
+    HOST_TEST_CHK(TestPct <= 100u);
+    HostTestInit();
+    LcdInit();
+    HostTestTaskCreate(&TestTCB, "Test Task", TestTask, (void *)0, 4u, &TestStk[0], 512u);
+    HostTestStart();
+    return (1);
+}
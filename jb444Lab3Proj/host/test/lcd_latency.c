@@ -0,0 +1,123 @@
+/*
+*********************************************************************************************************
+*                                  HOST BENCHMARK: LCD CALLER LATENCY
+*
+* Filename : lcd_latency.c
+*
+* Note(s)  : (1) Usage: lcd_latency <samples>. A high priority UI task wakes on each tick and times one
+*                LcdDispString() and one LcdDispStringAsync() call. A low priority task keeps writing
+*                to the layers with the blocking API, so the UI task often finds lcdLayersKey held,
+*                as it would behind a slow task or the LCD task's redraw on the board.
+*
+*            (2) Runs on the SIGALRM tick (lcd_latency_VIRTUAL = 0): the background task never lets the
+*                idle task run, so the virtual tick would never advance. Times are wall clock ns and
+*                include host scheduling noise. The median and the 99th percentile are printed with
+*                the maximum.
+*********************************************************************************************************
+*/
+
+#include  <string.h>
+#include  "host_test.h"
+#include  "LcdLayered.h"
+
+
+#define  TEST_SAMPLES_MAX        10000u
+
+
+static  CPU_INT32U  TestSamples;
+static  CPU_INT64U  TestBlockNs[TEST_SAMPLES_MAX];
+static  CPU_INT64U  TestAsyncNs[TEST_SAMPLES_MAX];
+static  CPU_INT32U  TestAsyncDrops;
+static  OS_TCB      TestUiTCB;
+static  CPU_STK     TestUiStk[512];
+static  OS_TCB      TestBgTCB;
+static  CPU_STK     TestBgStk[512];
+
+
+static  int  TestNsCmp (const void  *p_a,
+                        const void  *p_b)
+{
+    CPU_INT64U  a;
+    CPU_INT64U  b;
+
+
+    a = *(const CPU_INT64U *)p_a;
+    b = *(const CPU_INT64U *)p_b;
+    return ((a > b) - (a < b));
+}
+
+
+static  void  TestReport (const char  *p_api,
+                          CPU_INT64U  *p_ns)
+{
+    qsort(p_ns, TestSamples, sizeof(p_ns[0]), TestNsCmp);
+    printf("%-20s samples=%-5u median=%7u ns  p99=%8u ns  max=%8u ns\n",
+           p_api,
+           (unsigned)TestSamples,
+           (unsigned)p_ns[TestSamples / 2u],
+           (unsigned)p_ns[TestSamples * 99u / 100u],
+           (unsigned)p_ns[TestSamples - 1u]);
+}
+
+
+static  void  TestUi (void  *p_arg)
+{
+    OS_ERR      err;
+    CPU_INT32U  i;
+    CPU_INT64U  ns;
+
+
+    (void)p_arg;
+    OS_CPU_SysTickInitFreq(0u);
+    for (i = 0u; i < TestSamples; i++) {
+        OSTimeDly(1u, OS_OPT_TIME_DLY, &err);
+        HOST_TEST_CHK(err == OS_ERR_NONE);
+        ns = HostTestNs();
+        LcdDispString(1u, 1u, 3u, "UI blocking");
+        TestBlockNs[i] = HostTestNs() - ns;
+
+        OSTimeDly(1u, OS_OPT_TIME_DLY, &err);
+        HOST_TEST_CHK(err == OS_ERR_NONE);
+        ns = HostTestNs();
+        if (LcdDispStringAsync(2u, 1u, 3u, "UI async") == FALSE) {
+            TestAsyncDrops++;
+        }
+        TestAsyncNs[i] = HostTestNs() - ns;
+    }
+    TestReport("LcdDispString",      TestBlockNs);
+    TestReport("LcdDispStringAsync", TestAsyncNs);
+    printf("async drops=%u\n", (unsigned)TestAsyncDrops);
+    HostTestPass("lcd_latency");
+}
+
+
+static  void  TestBg (void  *p_arg)
+{
+    CPU_INT32U  n;
+    INT8U       layer;
+
+
+    (void)p_arg;
+    n = 0u;
+    while (DEF_ON) {
+        layer = (INT8U)(n % 3u);
+        LcdDispString(1u, 1u, layer, "background text");
+        LcdDispString(2u, 1u, layer, "more background");
+        LcdDispClrLine(1u + n % 2u, layer);
+        n++;
+    }
+}
+
+
+int  main (int    argc,
+           char  *argv[])
+{
+    TestSamples = (argc > 1) ? (CPU_INT32U)atoi(argv[1]) : 1000u;
+    HOST_TEST_CHK((TestSamples > 0u) && (TestSamples <= TEST_SAMPLES_MAX));
+    HostTestInit();
+    LcdInit();
+    HostTestTaskCreate(&TestUiTCB, "UI Task", TestUi, (void *)0, 4u, &TestUiStk[0], 512u);
+    HostTestTaskCreate(&TestBgTCB, "Background Task", TestBg, (void *)0, 20u, &TestBgStk[0], 512u);
+    HostTestStart();
+    return (1);
+}
@@ -0,0 +1,150 @@
+/*
+*********************************************************************************************************
+*                                  HOST TEST: LOCK-FREE MEMORY PARTITION
+*
+* Filename : mem_lock_free.c
+*
+* Note(s)  : (1) Usage: mem_lock_free [<ops>]. TEST_THREADS POSIX threads call OSMemGet() and OSMemPut()
+*                on one TEST_BLKS block partition, <ops> calls in all, each holding up to TEST_HOLD_MAX
+*                blocks at a time. The kernel is not started: with OS_CFG_MEM_LOCK_FREE_EN both calls
+*                only use CPU_AtomicCmpSwap(), which is what they rely on from an ISR on the board.
+*
+*            (2) Built with CPU_CFG_HOST_CAS_YIELD_EN, so that now and then a thread stalls between
+*                reading the free list and swapping it, while the others pop and push (see
+*                host/cpu_c.c). A block handed to two threads at once is caught by an owner table that
+*                each thread claims with a swap on every get, and by a stamp written over the whole
+*                block and checked before the put. With OS_MEM_FREE_TAG_INC set to 0 the free list
+*                suffers ABA and this test fails within the default run.
+*
+*            (3) At the end NbrFree must be TEST_BLKS again and the free list must hold every block
+*                exactly once. Blocks outside the partition must be rejected by OSMemPut().
+*********************************************************************************************************
+*/
+
+#include  <pthread.h>
+#include  <string.h>
+#include  "host_test.h"
+
+
+#define  TEST_THREADS               8u
+#define  TEST_BLKS                 16u
+#define  TEST_BLK_SIZE             16u
+#define  TEST_HOLD_MAX              3u
+
+
+static  OS_MEM      TestMem;
+static  CPU_INT32U  TestStore[TEST_BLKS][TEST_BLK_SIZE / sizeof(CPU_INT32U)];
+static  CPU_DATA    TestOwner[TEST_BLKS];                       /* Thread number plus one, 0 if free    */
+static  CPU_INT32U  TestOps;
+static  CPU_DATA    TestEmpty;
+
+
+static  CPU_INT32U  TestBlkIx (void  *p_blk)
+{
+    return ((CPU_INT32U)(((CPU_ADDR)p_blk - (CPU_ADDR)&TestStore[0][0]) / TEST_BLK_SIZE));
+}
+
+
+static  void  *TestThread (void  *p_arg)
+{
+    OS_ERR       err;
+    CPU_INT32U   id;
+    CPU_INT32U   seed;
+    CPU_INT32U   op;
+    CPU_INT32U   held;
+    CPU_INT32U   i;
+    CPU_INT32U   w;
+    CPU_DATA     ctr;
+    CPU_INT32U  *p_blk;
+    CPU_INT32U  *p_held[TEST_HOLD_MAX];
+
+
+    id   = (CPU_INT32U)(CPU_ADDR)p_arg;
+    seed = 12345u + id;
+    held = 0u;
+    for (op = 0u; op < TestOps / TEST_THREADS; op++) {
+        if ((held < TEST_HOLD_MAX) && (((HostTestRand(&seed) & 1u) != 0u) || (held == 0u))) {
+            p_blk = (CPU_INT32U *)OSMemGet(&TestMem, &err);
+            if (p_blk == (CPU_INT32U *)0) {
+                HOST_TEST_CHK(err == OS_ERR_MEM_NO_FREE_BLKS);
+                do {
+                    ctr = TestEmpty;
+                } while (CPU_AtomicCmpSwap(&TestEmpty, ctr, ctr + 1u) == DEF_FAIL);
+                continue;
+            }
+            HOST_TEST_CHK(err == OS_ERR_NONE);
+            HOST_TEST_CHK(((CPU_ADDR)p_blk >= (CPU_ADDR)&TestStore[0][0]) && (TestBlkIx(p_blk) < TEST_BLKS));
+            HOST_TEST_CHK(CPU_AtomicCmpSwap(&TestOwner[TestBlkIx(p_blk)], 0u, id + 1u) == DEF_OK);
+            for (w = 0u; w < (TEST_BLK_SIZE / sizeof(CPU_INT32U)); w++) {
+                p_blk[w] = id;
+            }
+            p_held[held] = p_blk;
+            held++;
+        } else {
+            i     = HostTestRand(&seed) % held;
+            p_blk = p_held[i];
+            held--;
+            p_held[i] = p_held[held];
+            for (w = 0u; w < (TEST_BLK_SIZE / sizeof(CPU_INT32U)); w++) {
+                HOST_TEST_CHK(p_blk[w] == id);                  /* No one else wrote to it              */
+            }
+            HOST_TEST_CHK(CPU_AtomicCmpSwap(&TestOwner[TestBlkIx(p_blk)], id + 1u, 0u) == DEF_OK);
+            OSMemPut(&TestMem, (void *)p_blk, &err);
+            HOST_TEST_CHK(err == OS_ERR_NONE);
+        }
+    }
+    while (held > 0u) {
+        held--;
+        HOST_TEST_CHK(CPU_AtomicCmpSwap(&TestOwner[TestBlkIx(p_held[held])], id + 1u, 0u) == DEF_OK);
+        OSMemPut(&TestMem, (void *)p_held[held], &err);
+        HOST_TEST_CHK(err == OS_ERR_NONE);
+    }
+    return ((void *)0);
+}
+
+
+int  main (int    argc,
+           char  *argv[])
+{
+    OS_ERR       err;
+    pthread_t    thread[TEST_THREADS];
+    CPU_BOOLEAN  seen[TEST_BLKS];
+    CPU_INT32U   i;
+    CPU_DATA     ix;
+    CPU_INT32U   foreign[TEST_BLK_SIZE / sizeof(CPU_INT32U)];
+
+
+    TestOps = (argc > 1) ? (CPU_INT32U)atoi(argv[1]) : 200000u;
+    HOST_TEST_CHK(TestOps >= TEST_THREADS);
+    HostTestInit();
+    OSMemCreate(&TestMem, "Lock-free", &TestStore[0][0], TEST_BLKS, TEST_BLK_SIZE, &err);
+    HOST_TEST_CHK(err == OS_ERR_NONE);
+    OSMemPut(&TestMem, (void *)&foreign[0], &err);              /* See Note #3                          */
+    HOST_TEST_CHK(err == OS_ERR_MEM_INVALID_P_BLK);
+
+    for (i = 0u; i < TEST_THREADS; i++) {
+        HOST_TEST_CHK(pthread_create(&thread[i], (const pthread_attr_t *)0, TestThread, (void *)(CPU_ADDR)i) == 0);
+    }
+    for (i = 0u; i < TEST_THREADS; i++) {
+        HOST_TEST_CHK(pthread_join(thread[i], (void **)0) == 0);
+    }
+
+    HOST_TEST_CHK(TestMem.NbrFree == TEST_BLKS);
+    (void)memset(&seen[0], 0, sizeof(seen));
+    ix = TestMem.FreeListTop & OS_MEM_FREE_IX_MSK;
+    for (i = 0u; i < TEST_BLKS; i++) {                          /* Walk the list by index (plus one)    */
+        HOST_TEST_CHK((ix > 0u) && (ix <= TEST_BLKS));
+        HOST_TEST_CHK(seen[ix - 1u] == DEF_NO);
+        seen[ix - 1u] = DEF_YES;
+        ix = TestStore[ix - 1u][0] & OS_MEM_FREE_IX_MSK;
+    }
+    HOST_TEST_CHK(ix == 0u);
+
+    printf("mem lock-free threads=%u blks=%u ops=%u: partition found empty %u times\n",
+           (unsigned)TEST_THREADS,
+           (unsigned)TEST_BLKS,
+           (unsigned)TestOps,
+           (unsigned)TestEmpty);
+    HostTestPass("mem_lock_free");
+    return (1);
+}
@@ -0,0 +1,205 @@
+/*
+*********************************************************************************************************
+*                                HOST TEST: DISCARDED REFERENCE MESSAGES
+*
+* Filename : mem_ref.c
+*
+* Note(s)  : (1) Blocks from OSMemRefGet() are posted with OSQPostRef() to queues nobody pends on, and
+*                the sender drops its own reference. OSQFlush() and OSQDel() must then give each block
+*                back to the partition once its last queue lets go of it, and only then. A plain
+*                OSQPost() message flushed with them is left alone.
+*
+*            (2) A block posted to two queues stays out after the first is flushed and comes back when
+*                the second is deleted.
+*
+*            (3) With OS_CFG_ISR_POST_DEFERRED_EN the same is checked for a post from ISR context,
+*                which OS_IntQTask() completes on OSIntExit().
+*
+*            (4) A block handed straight to a waiting task belongs to that task, which releases it.
+*                The queue it came through must not release it a second time.
+*
+*            (5) Built with OS_CFG_MEM_REF_EN enabled (test/cfg/mem_ref).
+*********************************************************************************************************
+*/
+
+#include  "host_test.h"
+
+
+#define  TEST_BLKS                  8u
+#define  TEST_BLK_SIZE           OS_MEM_REF_BLK_SIZE(16u)
+#define  TEST_Q_SIZE                8u
+
+
+static  OS_MEM       TestMem;
+static  CPU_INT64U   TestMemStore[TEST_BLKS][TEST_BLK_SIZE / sizeof(CPU_INT64U)];
+static  OS_Q         TestQ[2];
+static  CPU_INT32U   TestPlain;
+static  OS_TCB       TestTCB;
+static  CPU_STK      TestStk[512];
+static  OS_TCB       TestRxTCB;
+static  CPU_STK      TestRxStk[256];
+static  CPU_INT32U   TestRxCnt;
+
+
+static  void  TestRx (void  *p_arg)
+{
+    OS_ERR       err;
+    OS_MSG_SIZE  size;
+    void        *p_msg;
+
+
+    (void)p_arg;
+    while (DEF_ON) {
+        p_msg = OSQPend(&TestQ[1], 0u, OS_OPT_PEND_BLOCKING, &size, (CPU_TS *)0, &err);
+        HOST_TEST_CHK(err == OS_ERR_NONE);
+        OSMemRefRelease(p_msg, &err);
+        HOST_TEST_CHK(err == OS_ERR_NONE);
+        TestRxCnt++;
+    }
+}
+
+
+static  void  TestQCreate (OS_Q  *p_q)
+{
+    OS_ERR  err;
+
+
+    OSQCreate(p_q, "Ref Q", TEST_Q_SIZE, &err);
+    HOST_TEST_CHK(err == OS_ERR_NONE);
+}
+
+
+static  void  *TestPost (OS_Q  *p_q)
+{
+    OS_ERR   err;
+    void    *p_blk;
+
+
+    p_blk = OSMemRefGet(&TestMem, &err);
+    HOST_TEST_CHK(err == OS_ERR_NONE);
+    OSQPostRef(p_q, p_blk, 16u, OS_OPT_POST_FIFO, &err);
+    HOST_TEST_CHK(err == OS_ERR_NONE);
+    return (p_blk);
+}
+
+
+static  void  TestRelease (void  *p_blk)
+{
+    OS_ERR  err;
+
+
+    OSMemRefRelease(p_blk, &err);                               /* Sender's reference                   */
+    HOST_TEST_CHK(err == OS_ERR_NONE);
+}
+
+
+static  void  TestFlush (void)
+{
+    OS_ERR      err;
+    CPU_INT32U  i;
+
+
+    for (i = 0u; i < 3u; i++) {
+        TestRelease(TestPost(&TestQ[0]));
+    }
+    OSQPost(&TestQ[0], (void *)&TestPlain, sizeof(TestPlain), OS_OPT_POST_FIFO, &err);
+    HOST_TEST_CHK(err == OS_ERR_NONE);
+    HOST_TEST_CHK(TestMem.NbrFree == TEST_BLKS - 3u);
+    HOST_TEST_CHK(OSQFlush(&TestQ[0], &err) == 4u);
+    HOST_TEST_CHK(err == OS_ERR_NONE);
+    HOST_TEST_CHK(TestMem.NbrFree == TEST_BLKS);
+}
+
+
+static  void  TestShared (void)
+{
+    OS_ERR   err;
+    void    *p_blk;
+
+
+    p_blk = TestPost(&TestQ[0]);
+    OSQPostRef(&TestQ[1], p_blk, 16u, OS_OPT_POST_LIFO, &err);
+    HOST_TEST_CHK(err == OS_ERR_NONE);
+    TestRelease(p_blk);
+    TestRelease(TestPost(&TestQ[1]));
+    HOST_TEST_CHK(TestMem.NbrFree == TEST_BLKS - 2u);
+    HOST_TEST_CHK(OSQFlush(&TestQ[0], &err) == 1u);
+    HOST_TEST_CHK(err == OS_ERR_NONE);
+    HOST_TEST_CHK(TestMem.NbrFree == TEST_BLKS - 2u);           /* Both still held by the 2nd queue     */
+    (void)OSQDel(&TestQ[1], OS_OPT_DEL_NO_PEND, &err);
+    HOST_TEST_CHK(err == OS_ERR_NONE);
+    HOST_TEST_CHK(TestMem.NbrFree == TEST_BLKS);
+}
+
+
+#if (OS_CFG_ISR_POST_DEFERRED_EN == DEF_ENABLED)
+static  void  TestIsr (void)
+{
+    OS_ERR   err;
+    void    *p_blk;
+    CPU_SR_ALLOC();
+
+
+    p_blk = OSMemRefGet(&TestMem, &err);
+    HOST_TEST_CHK(err == OS_ERR_NONE);
+    CPU_CRITICAL_ENTER();                                       /* As the board's ISR prologue          */
+    OSIntEnter();
+    CPU_CRITICAL_EXIT();
+    OSQPostRef(&TestQ[0], p_blk, 16u, OS_OPT_POST_FIFO, &err);
+    HOST_TEST_CHK(err == OS_ERR_NONE);
+    OSIntExit();                                                /* OS_IntQTask() completes the post     */
+    TestRelease(p_blk);
+    HOST_TEST_CHK(TestQ[0].MsgQ.NbrEntries == 1u);
+    HOST_TEST_CHK(TestMem.NbrFree == TEST_BLKS - 1u);
+    HOST_TEST_CHK(OSQFlush(&TestQ[0], &err) == 1u);
+    HOST_TEST_CHK(TestMem.NbrFree == TEST_BLKS);
+}
+#endif
+
+
+static  void  TestTask (void  *p_arg)
+{
+    OS_ERR  err;
+
+
+    (void)p_arg;
+    OS_CPU_SysTickInitFreq(0u);
+
+    TestFlush();                                                /* See Note #1                          */
+
+    TestRelease(TestPost(&TestQ[1]));                           /* See Note #4                          */
+    HOST_TEST_CHK(TestRxCnt == 1u);
+    HOST_TEST_CHK(TestMem.NbrFree == TEST_BLKS);
+    OSTaskDel(&TestRxTCB, &err);                                /* Nobody pends on the queues from now  */
+    HOST_TEST_CHK(err == OS_ERR_NONE);
+
+    TestShared();                                               /* See Note #2                          */
+
+    TestQCreate(&TestQ[1]);
+    TestRelease(TestPost(&TestQ[1]));
+    (void)OSQDel(&TestQ[1], OS_OPT_DEL_ALWAYS, &err);
+    HOST_TEST_CHK(err == OS_ERR_NONE);
+    HOST_TEST_CHK(TestMem.NbrFree == TEST_BLKS);
+
+#if (OS_CFG_ISR_POST_DEFERRED_EN == DEF_ENABLED)
+    TestIsr();                                                  /* See Note #3                          */
+#endif
+    HostTestPass("mem_ref");
+}
+
+
+int  main (void)
+{
+    OS_ERR  err;
+
+
+    HostTestInit();
+    OSMemCreate(&TestMem, "Ref Blocks", &TestMemStore[0][0], TEST_BLKS, TEST_BLK_SIZE, &err);
+    HOST_TEST_CHK(err == OS_ERR_NONE);
+    TestQCreate(&TestQ[0]);
+    TestQCreate(&TestQ[1]);
+    HostTestTaskCreate(&TestTCB,   "Test Task", TestTask, (void *)0, 10u, &TestStk[0],   512u);
+    HostTestTaskCreate(&TestRxTCB, "Receiver",  TestRx,   (void *)0,  6u, &TestRxStk[0], 256u);
+    HostTestStart();
+    return (1);
+}
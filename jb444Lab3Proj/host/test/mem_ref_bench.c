@@ -0,0 +1,175 @@
+/*
+*********************************************************************************************************
+*                                 HOST BENCHMARK: SHARED MESSAGE PAYLOADS
+*
+* Filename : mem_ref_bench.c
+*
+* Note(s)  : (1) Usage: mem_ref_bench <bytes>. A sender multicasts TEST_MSGS payloads of <bytes> bytes
+*                to TEST_RXS receivers, one queue each. It is timed copying the payload into one
+*                partition block per receiver (OSMemGet(), OSQPost(), the receiver calls OSMemPut())
+*                and sharing one block (OSMemRefGet(), OSQPostRef() to each queue, OSMemRefRelease()
+*                by the sender and by each receiver). Messages delivered per second in the best of
+*                TEST_RUNS runs are printed.
+*
+*            (2) The receivers are above the sender, so every post switches to a receiver, as for the
+*                output tasks. Each receiver checks the payload's first and last byte. After each
+*                run every block must be back in the partition.
+*
+*            (3) Built with OS_CFG_MEM_REF_EN enabled (test/cfg/mem_ref).
+*********************************************************************************************************
+*/
+
+#include  <string.h>
+#include  "host_test.h"
+
+
+#define  TEST_RXS                   3u
+#define  TEST_MSGS              50000u
+#define  TEST_RUNS                  5u
+#define  TEST_BYTES_MAX          4096u
+#define  TEST_BLKS                  8u
+#define  TEST_BLK_SIZE           OS_MEM_REF_BLK_SIZE(TEST_BYTES_MAX)
+
+
+static  OS_MEM       TestMem;
+static  CPU_INT64U   TestMemStore[TEST_BLKS][TEST_BLK_SIZE / sizeof(CPU_INT64U)];
+static  OS_Q         TestQ[TEST_RXS];
+static  CPU_INT08U   TestSrc[TEST_BYTES_MAX];
+static  CPU_INT32U   TestBytes;
+static  CPU_BOOLEAN  TestShared;
+static  CPU_INT32U   TestRxCnt[TEST_RXS];
+static  OS_TCB       TestTCB;
+static  CPU_STK      TestStk[512];
+static  OS_TCB       TestRxTCB[TEST_RXS];
+static  CPU_STK      TestRxStk[TEST_RXS][256];
+
+
+static  void  TestRx (void  *p_arg)
+{
+    OS_ERR       err;
+    OS_MSG_SIZE  size;
+    CPU_INT08U  *p_msg;
+    CPU_INT32U   rx;
+
+
+    rx = (CPU_INT32U)(CPU_ADDR)p_arg;
+    while (DEF_ON) {
+        p_msg = (CPU_INT08U *)OSQPend(&TestQ[rx], 0u, OS_OPT_PEND_BLOCKING, &size, (CPU_TS *)0, &err);
+        HOST_TEST_CHK(err == OS_ERR_NONE);
+        HOST_TEST_CHK(size == TestBytes);
+        HOST_TEST_CHK((p_msg[0] == TestSrc[0]) && (p_msg[size - 1u] == TestSrc[size - 1u]));
+        if (TestShared == DEF_YES) {
+            OSMemRefRelease((void *)p_msg, &err);
+        } else {
+            OSMemPut(&TestMem, (void *)p_msg, &err);
+        }
+        HOST_TEST_CHK(err == OS_ERR_NONE);
+        TestRxCnt[rx]++;
+    }
+}
+
+
+static  void  TestSend (void)
+{
+    OS_ERR      err;
+    CPU_INT32U  rx;
+    void       *p_blk;
+
+
+    TestSrc[0]++;                                               /* New payload                          */
+    TestSrc[TestBytes - 1u]++;
+    if (TestShared == DEF_YES) {
+        p_blk = OSMemRefGet(&TestMem, &err);
+        HOST_TEST_CHK(err == OS_ERR_NONE);
+        (void)memcpy(p_blk, &TestSrc[0], TestBytes);
+        for (rx = 0u; rx < TEST_RXS; rx++) {
+            OSQPostRef(&TestQ[rx], p_blk, (OS_MSG_SIZE)TestBytes, OS_OPT_POST_FIFO, &err);
+            HOST_TEST_CHK(err == OS_ERR_NONE);
+        }
+        OSMemRefRelease(p_blk, &err);                           /* Sender's reference                   */
+        HOST_TEST_CHK(err == OS_ERR_NONE);
+    } else {
+        for (rx = 0u; rx < TEST_RXS; rx++) {
+            p_blk = OSMemGet(&TestMem, &err);
+            HOST_TEST_CHK(err == OS_ERR_NONE);
+            (void)memcpy(p_blk, &TestSrc[0], TestBytes);
+            OSQPost(&TestQ[rx], p_blk, (OS_MSG_SIZE)TestBytes, OS_OPT_POST_FIFO, &err);
+            HOST_TEST_CHK(err == OS_ERR_NONE);
+        }
+    }
+}
+
+
+static  CPU_INT64U  TestRun (CPU_BOOLEAN  shared)
+{
+    CPU_INT64U  best;
+    CPU_INT64U  ns;
+    CPU_INT32U  run;
+    CPU_INT32U  msg;
+    CPU_INT32U  rx;
+
+
+    TestShared = shared;
+    best       = DEF_INT_64U_MAX_VAL;
+    for (run = 0u; run < TEST_RUNS; run++) {
+        for (rx = 0u; rx < TEST_RXS; rx++) {
+            TestRxCnt[rx] = 0u;
+        }
+        ns = HostTestNs();
+        for (msg = 0u; msg < TEST_MSGS; msg++) {
+            TestSend();
+        }
+        ns = HostTestNs() - ns;
+        for (rx = 0u; rx < TEST_RXS; rx++) {
+            HOST_TEST_CHK(TestRxCnt[rx] == TEST_MSGS);
+        }
+        HOST_TEST_CHK(TestMem.NbrFree == TEST_BLKS);            /* No block leaked                      */
+        if (best > ns) {
+            best = ns;
+        }
+    }
+    return (best);
+}
+
+
+static  void  TestTask (void  *p_arg)
+{
+    CPU_INT64U  copy_ns;
+    CPU_INT64U  ref_ns;
+
+
+    (void)p_arg;
+    OS_CPU_SysTickInitFreq(0u);
+    copy_ns = TestRun(DEF_NO);
+    ref_ns  = TestRun(DEF_YES);
+    printf("mem ref bytes=%-5u receivers=%u  copy=%5.2f  shared=%5.2f  M messages/s delivered\n",
+           (unsigned)TestBytes,
+           (unsigned)TEST_RXS,
+           (double)(TEST_MSGS * TEST_RXS) * 1000.0 / (double)copy_ns,
+           (double)(TEST_MSGS * TEST_RXS) * 1000.0 / (double)ref_ns);
+    exit(0);
+}
+
+
+int  main (int    argc,
+           char  *argv[])
+{
+    OS_ERR      err;
+    CPU_INT32U  rx;
+
+
+    TestBytes = (argc > 1) ? (CPU_INT32U)atoi(argv[1]) : 64u;
+    HOST_TEST_CHK((TestBytes > 0u) && (TestBytes <= TEST_BYTES_MAX));
+    HostTestInit();
+    OSMemCreate(&TestMem, "Payloads", &TestMemStore[0][0], TEST_BLKS, TEST_BLK_SIZE, &err);
+    HOST_TEST_CHK(err == OS_ERR_NONE);
+    HostTestTaskCreate(&TestTCB, "Sender", TestTask, (void *)0, 10u, &TestStk[0], 512u);
+    for (rx = 0u; rx < TEST_RXS; rx++) {
+        OSQCreate(&TestQ[rx], "Receiver", 4u, &err);
+        HOST_TEST_CHK(err == OS_ERR_NONE);
+        HostTestTaskCreate(&TestRxTCB[rx], "Receiver", TestRx, (void *)(CPU_ADDR)rx,
+                           (OS_PRIO)(6u + rx), &TestRxStk[rx][0], 256u);
+    }
+    HostTestStart();
+    return (1);
+}
@@ -0,0 +1,204 @@
+/*
+*********************************************************************************************************
+*                                   HOST TEST: SLAB ALLOCATOR FRAGMENTATION
+*
+* Filename : mem_slab.c
+*
+* Note(s)  : (1) A slab of TEST_CLASSES classes of 8 to 128 byte blocks, TEST_BLKS blocks each. Every
+*                size from 1 to 128 must get a block of its own class when the slab is empty. An
+*                oversized request, a block pointer that is not at a block start and one that is not
+*                in the slab must be rejected, and a zero size too with OS_CFG_ARG_CHK_EN.
+*
+*            (2) Then TEST_STEPS random steps allocate 1 to 128 bytes, or free a random live block,
+*                with up to TEST_LIVE_MAX blocks live, more than one class holds. Each request must be
+*                served by its class, by a larger one counted in SpillCtr, or fail and be counted in
+*                FailCtr, and NbrUsedMax must match the peak seen. Once everything is freed every
+*                partition must be full. Internal fragmentation, the share of the served block bytes
+*                that were not requested, is printed.
+*
+*            (3) Built with OS_CFG_MEM_SLAB_EN enabled (test/cfg/mem_slab).
+*********************************************************************************************************
+*/
+
+#include  "host_test.h"
+
+
+#define  TEST_CLASSES               5u
+#define  TEST_MIN_SHIFT             3u
+#define  TEST_SIZE_MAX           (1u << (TEST_MIN_SHIFT + TEST_CLASSES - 1u))
+#define  TEST_BLKS                 16u
+#define  TEST_LIVE_MAX             64u
+#define  TEST_STEPS            200000u
+
+
+static  OS_MEM_SLAB        TestSlab;
+static  OS_MEM_SLAB_CLASS  TestClass[TEST_CLASSES];
+static  OS_MEM             TestMem[TEST_CLASSES];
+static  CPU_INT64U         TestStore[TEST_CLASSES][TEST_BLKS * TEST_SIZE_MAX / sizeof(CPU_INT64U)];
+static  void              *TestLive[TEST_LIVE_MAX];
+static  CPU_INT32U         TestLiveCnt;
+static  CPU_INT32U         TestUsed[TEST_CLASSES];
+static  CPU_INT32U         TestUsedMax[TEST_CLASSES];
+static  CPU_INT32U         TestAllocs[TEST_CLASSES];
+static  CPU_INT32U         TestSpills[TEST_CLASSES];
+static  CPU_INT32U         TestFails[TEST_CLASSES];
+
+
+static  CPU_INT32U  TestClassOfSize (CPU_INT32U  size)
+{
+    CPU_INT32U  ix;
+
+
+    for (ix = 0u; (1u << (TEST_MIN_SHIFT + ix)) < size; ix++) {
+        ;
+    }
+    return (ix);
+}
+
+
+static  CPU_INT32U  TestClassOfBlk (void  *p_blk)
+{
+    CPU_INT32U  ix;
+
+
+    for (ix = 0u; ix < TEST_CLASSES; ix++) {
+        if (((CPU_ADDR)p_blk >= (CPU_ADDR)&TestStore[ix][0]) &&
+            ((CPU_ADDR)p_blk <  (CPU_ADDR)&TestStore[ix][0] + TEST_BLKS * (1u << (TEST_MIN_SHIFT + ix)))) {
+            return (ix);
+        }
+    }
+    HostTestFail(__FILE__, __LINE__, "block not in the slab");
+    return (0u);
+}
+
+
+static  void  TestSizes (void)
+{
+    OS_ERR      err;
+    CPU_INT32U  size;
+    void       *p_blk;
+    CPU_INT64U  foreign;
+
+
+    for (size = 1u; size <= TEST_SIZE_MAX; size++) {            /* See Note #1                          */
+        p_blk = OSMemSlabAlloc(&TestSlab, (OS_MEM_SIZE)size, &err);
+        HOST_TEST_CHK(err == OS_ERR_NONE);
+        HOST_TEST_CHK(TestClassOfBlk(p_blk) == TestClassOfSize(size));
+        OSMemSlabFree(&TestSlab, p_blk, &err);
+        HOST_TEST_CHK(err == OS_ERR_NONE);
+    }
+
+#if (OS_CFG_ARG_CHK_EN == DEF_ENABLED)
+    (void)OSMemSlabAlloc(&TestSlab, 0u, &err);
+    HOST_TEST_CHK(err == OS_ERR_MEM_INVALID_SIZE);
+#endif
+    (void)OSMemSlabAlloc(&TestSlab, (OS_MEM_SIZE)(TEST_SIZE_MAX + 1u), &err);
+    HOST_TEST_CHK(err == OS_ERR_MEM_INVALID_SIZE);
+    p_blk = OSMemSlabAlloc(&TestSlab, 20u, &err);
+    HOST_TEST_CHK(err == OS_ERR_NONE);
+    OSMemSlabFree(&TestSlab, (CPU_INT08U *)p_blk + 8u, &err);   /* Inside a block, not at its start     */
+    HOST_TEST_CHK(err == OS_ERR_MEM_INVALID_P_BLK);
+    OSMemSlabFree(&TestSlab, &foreign, &err);
+    HOST_TEST_CHK(err == OS_ERR_MEM_INVALID_P_BLK);
+    OSMemSlabFree(&TestSlab, p_blk, &err);
+    HOST_TEST_CHK(err == OS_ERR_NONE);
+    for (size = 0u; size < TEST_CLASSES; size++) {
+        TestClass[size].AllocCtr = 0u;                          /* Count the churn only                 */
+    }
+}
+
+
+int  main (void)
+{
+    OS_ERR      err;
+    CPU_INT32U  seed;
+    CPU_INT32U  step;
+    CPU_INT32U  ix;
+    CPU_INT32U  blk_ix;
+    CPU_INT32U  size;
+    CPU_INT32U  r;
+    CPU_INT64U  bytes_req;
+    CPU_INT64U  bytes_blk;
+    void       *p_blk;
+
+
+    HostTestInit();
+    for (ix = 0u; ix < TEST_CLASSES; ix++) {
+        OSMemCreate(&TestMem[ix], "Slab class", &TestStore[ix][0], TEST_BLKS,
+                    (OS_MEM_SIZE)(1u << (TEST_MIN_SHIFT + ix)), &err);
+        HOST_TEST_CHK(err == OS_ERR_NONE);
+        TestClass[ix].MemPtr = &TestMem[ix];
+    }
+    OSMemSlabCreate(&TestSlab, "Slab", &TestClass[0], TEST_CLASSES, &err);
+    HOST_TEST_CHK(err == OS_ERR_NONE);
+    TestSizes();
+
+    seed      = 12345u;
+    bytes_req = 0u;
+    bytes_blk = 0u;
+    for (step = 0u; step < TEST_STEPS; step++) {                /* See Note #2                          */
+        r = HostTestRand(&seed);
+        if ((TestLiveCnt < TEST_LIVE_MAX) && (((r & 1u) != 0u) || (TestLiveCnt == 0u))) {
+            size  = 1u + (r >> 1) % TEST_SIZE_MAX;
+            ix    = TestClassOfSize(size);
+            p_blk = OSMemSlabAlloc(&TestSlab, (OS_MEM_SIZE)size, &err);
+            TestAllocs[ix]++;
+            if (p_blk == (void *)0) {
+                HOST_TEST_CHK(err == OS_ERR_MEM_NO_FREE_BLKS);
+                for (blk_ix = ix; blk_ix < TEST_CLASSES; blk_ix++) {
+                    HOST_TEST_CHK(TestUsed[blk_ix] == TEST_BLKS);
+                }
+                TestFails[ix]++;
+            } else {
+                HOST_TEST_CHK(err == OS_ERR_NONE);
+                blk_ix = TestClassOfBlk(p_blk);
+                HOST_TEST_CHK(blk_ix >= ix);
+                if (blk_ix != ix) {
+                    HOST_TEST_CHK(TestUsed[ix] == TEST_BLKS);   /* Only spills when its class is empty  */
+                    TestSpills[ix]++;
+                }
+                TestUsed[blk_ix]++;
+                if (TestUsedMax[blk_ix] < TestUsed[blk_ix]) {
+                    TestUsedMax[blk_ix] = TestUsed[blk_ix];
+                }
+                bytes_req += size;
+                bytes_blk += 1u << (TEST_MIN_SHIFT + blk_ix);
+                TestLive[TestLiveCnt] = p_blk;
+                TestLiveCnt++;
+            }
+        } else {
+            ix = (r >> 1) % TestLiveCnt;
+            TestUsed[TestClassOfBlk(TestLive[ix])]--;
+            OSMemSlabFree(&TestSlab, TestLive[ix], &err);
+            HOST_TEST_CHK(err == OS_ERR_NONE);
+            TestLiveCnt--;
+            TestLive[ix] = TestLive[TestLiveCnt];
+        }
+    }
+    while (TestLiveCnt > 0u) {
+        TestLiveCnt--;
+        OSMemSlabFree(&TestSlab, TestLive[TestLiveCnt], &err);
+        HOST_TEST_CHK(err == OS_ERR_NONE);
+    }
+
+    for (ix = 0u; ix < TEST_CLASSES; ix++) {
+        HOST_TEST_CHK(TestMem[ix].NbrFree         == TEST_BLKS);
+        HOST_TEST_CHK(TestClass[ix].AllocCtr      == TestAllocs[ix]);
+        HOST_TEST_CHK(TestClass[ix].SpillCtr      == TestSpills[ix]);
+        HOST_TEST_CHK(TestClass[ix].FailCtr       == TestFails[ix]);
+        HOST_TEST_CHK(TestClass[ix].NbrUsedMax    == TestUsedMax[ix]);
+        printf("slab class %3u B: allocs=%-6u spills=%-6u fails=%-6u used max=%u/%u\n",
+               (unsigned)(1u << (TEST_MIN_SHIFT + ix)),
+               (unsigned)TestAllocs[ix],
+               (unsigned)TestSpills[ix],
+               (unsigned)TestFails[ix],
+               (unsigned)TestUsedMax[ix],
+               (unsigned)TEST_BLKS);
+    }
+    printf("slab steps=%u live max=%u: internal fragmentation=%.1f%%\n",
+           (unsigned)TEST_STEPS,
+           (unsigned)TEST_LIVE_MAX,
+           100.0 * (double)(bytes_blk - bytes_req) / (double)bytes_blk);
+    HostTestPass("mem_slab");
+    return (1);
+}
@@ -0,0 +1,104 @@
+/*
+*********************************************************************************************************
+*                                     HOST BENCHMARK: SLAB ALLOCATOR
+*
+* Filename : mem_slab_bench.c
+*
+* Note(s)  : (1) Usage: mem_slab_bench <bytes>. Times an OSMemSlabAlloc() of a random 1 to <bytes> bytes
+*                followed by its OSMemSlabFree(), against an OSMemGet() and OSMemPut() pair on the
+*                partition of the largest class. The sizes are drawn before timing. The best of
+*                TEST_RUNS runs is printed.
+*
+*            (2) The slab has 8 to 128 byte classes, as in mem_slab.c. Built with OS_CFG_MEM_SLAB_EN
+*                enabled (test/cfg/mem_slab).
+*********************************************************************************************************
+*/
+
+#include  "host_test.h"
+
+
+#define  TEST_CLASSES               5u
+#define  TEST_MIN_SHIFT             3u
+#define  TEST_SIZE_MAX           (1u << (TEST_MIN_SHIFT + TEST_CLASSES - 1u))
+#define  TEST_BLKS                 16u
+#define  TEST_SIZES              4096u
+#define  TEST_CALLS          10000000u
+#define  TEST_RUNS                  5u
+
+
+static  OS_MEM_SLAB        TestSlab;
+static  OS_MEM_SLAB_CLASS  TestClass[TEST_CLASSES];
+static  OS_MEM             TestMem[TEST_CLASSES];
+static  CPU_INT64U         TestStore[TEST_CLASSES][TEST_BLKS * TEST_SIZE_MAX / sizeof(CPU_INT64U)];
+static  OS_MEM_SIZE        TestSize[TEST_SIZES];
+
+
+static  CPU_INT64U  TestTime (CPU_BOOLEAN  slab)
+{
+    OS_ERR      err;
+    CPU_INT64U  best;
+    CPU_INT64U  ns;
+    CPU_INT32U  run;
+    CPU_INT32U  i;
+    void       *p_blk;
+
+
+    best = DEF_INT_64U_MAX_VAL;
+    for (run = 0u; run < TEST_RUNS; run++) {
+        ns = HostTestNs();
+        if (slab == DEF_YES) {
+            for (i = 0u; i < TEST_CALLS; i++) {
+                p_blk = OSMemSlabAlloc(&TestSlab, TestSize[i % TEST_SIZES], &err);
+                OSMemSlabFree(&TestSlab, p_blk, &err);
+            }
+        } else {
+            for (i = 0u; i < TEST_CALLS; i++) {
+                p_blk = OSMemGet(&TestMem[TEST_CLASSES - 1u], &err);
+                OSMemPut(&TestMem[TEST_CLASSES - 1u], p_blk, &err);
+            }
+        }
+        ns = HostTestNs() - ns;
+        HOST_TEST_CHK(err == OS_ERR_NONE);
+        if (best > ns) {
+            best = ns;
+        }
+    }
+    return (best);
+}
+
+
+int  main (int    argc,
+           char  *argv[])
+{
+    OS_ERR      err;
+    CPU_INT32U  bytes;
+    CPU_INT32U  seed;
+    CPU_INT32U  ix;
+    CPU_INT64U  slab_ns;
+    CPU_INT64U  mem_ns;
+
+
+    bytes = (argc > 1) ? (CPU_INT32U)atoi(argv[1]) : TEST_SIZE_MAX;
+    HOST_TEST_CHK((bytes > 0u) && (bytes <= TEST_SIZE_MAX));
+    HostTestInit();
+    for (ix = 0u; ix < TEST_CLASSES; ix++) {
+        OSMemCreate(&TestMem[ix], "Slab class", &TestStore[ix][0], TEST_BLKS,
+                    (OS_MEM_SIZE)(1u << (TEST_MIN_SHIFT + ix)), &err);
+        HOST_TEST_CHK(err == OS_ERR_NONE);
+        TestClass[ix].MemPtr = &TestMem[ix];
+    }
+    OSMemSlabCreate(&TestSlab, "Slab", &TestClass[0], TEST_CLASSES, &err);
+    HOST_TEST_CHK(err == OS_ERR_NONE);
+    seed = 12345u;
+    for (ix = 0u; ix < TEST_SIZES; ix++) {
+        TestSize[ix] = (OS_MEM_SIZE)(1u + HostTestRand(&seed) % bytes);
+    }
+
+    slab_ns = TestTime(DEF_YES);
+    mem_ns  = TestTime(DEF_NO);
+    printf("slab sizes=1..%-3u  alloc+free=%5.1f ns  OSMemGet+OSMemPut=%5.1f ns\n",
+           (unsigned)bytes,
+           (double)slab_ns / TEST_CALLS,
+           (double)mem_ns  / TEST_CALLS);
+    return (0);
+}
@@ -0,0 +1,286 @@
+/*
+*********************************************************************************************************
+*                                   HOST TEST: FLASH INTEGRITY CRC-32
+*
+* Filename : memtest_crc.c
+*
+* Note(s)  : (1) MemTestCrc32() must give the standard CRC-32 check value, and the same CRC as a bitwise
+*                reference over 64 KB of random bytes however the buffer is split into chunks. This is
+*                the CRC tools/memtest_crc_ref.py computes with zlib.
+*
+*            (2) memTestTask is then run over the memory image of the page that holds MemTestCrcRef.
+*                The test write-enables the page and stores references in it, as the post-build step
+*                does in flash. A correct reference must PASS, a wrong one FAIL, and an erased one
+*                report MEMTEST_NO_REF. The CRC reported must skip the four bytes of MemTestCrcRef.
+*
+*            (3) The correct reference is the one tools/memtest_crc_ref.py stores. The page is written
+*                to build/memtest_crc.axf as a 32-bit ELF with two loadable segments, the second from
+*                MemTestCrcRef on, laid at TEST_FLASH as the linker lays the image in flash. The script
+*                must patch MemTestCrcRef in the file with the CRC worked out here and change nothing
+*                else. An image that copies MemTestCrcRef to RAM has no reference in flash: the script
+*                must exit with 1 and leave the file alone.
+*********************************************************************************************************
+*/
+
+#include  <string.h>
+#include  <sys/mman.h>
+#include  <unistd.h>
+#include  "host_test.h"
+#include  "MemTest.h"
+
+
+#define  TEST_BUF_BYTES         65536u
+#define  TEST_SPLITS             1000u
+#define  TEST_PASS_TICKS       (APP_CFG_MEMTEST_PERIOD_MS * OS_CFG_TICK_RATE_HZ / 1000u + 100u)
+
+#define  TEST_ELF                HOST_TEST_OUT "memtest_crc.axf"
+#define  TEST_FLASH             0x00008000u                     /* Where the page goes in the image     */
+#define  TEST_RAM               0x20000000u                     /* Where an image may copy it to        */
+#define  TEST_ELF_EHDR                  52u                     /* ELF32 header and table entry sizes   */
+#define  TEST_ELF_PHDR                  32u
+#define  TEST_ELF_SHDR                  40u
+#define  TEST_ELF_SYM                   16u
+#define  TEST_ELF_DATA         (TEST_ELF_EHDR + 2u * TEST_ELF_PHDR)
+#define  TEST_ELF_MAX          (TEST_ELF_DATA + TEST_BUF_BYTES + 2u * TEST_ELF_SYM + 16u + 3u * TEST_ELF_SHDR)
+
+
+static  const  char  TestStrTab[16] = "\0MemTestCrcRef";       /* Symbol names of the image            */
+
+static  INT8U    TestBuf[TEST_BUF_BYTES];
+static  INT8U    TestElf[TEST_ELF_MAX];
+static  INT8U    TestElfOut[TEST_ELF_MAX];
+static  char     TestOut[1024];
+static  OS_TCB   TestTCB;
+static  CPU_STK  TestStk[512];
+
+
+static  INT32U  TestCrcBits (INT32U        crc,
+                             const INT8U  *p_buf,
+                             CPU_SIZE_T    len)
+{
+    INT8U  bit;
+
+
+    while (len > 0u) {
+        crc ^= *p_buf;
+        for (bit = 0u; bit < 8u; bit++) {
+            crc = (crc >> 1) ^ (((crc & 1u) != 0u) ? 0xEDB88320u : 0u);
+        }
+        p_buf++;
+        len--;
+    }
+    return (crc);
+}
+
+
+static  void  TestPut (CPU_SIZE_T  ofs,                         /* Little-endian field of the image     */
+                       INT32U      val,
+                       CPU_SIZE_T  size)
+{
+    while (size > 0u) {
+        TestElf[ofs] = (INT8U)val;
+        val        >>= 8;
+        ofs++;
+        size--;
+    }
+}
+
+
+static  CPU_SIZE_T  TestElfWrite (const INT8U  *p_page,         /* See Note #3                          */
+                                  CPU_SIZE_T    page_size,
+                                  CPU_SIZE_T    ref_ofs,
+                                  CPU_BOOLEAN   in_flash)
+{
+    CPU_SIZE_T  sym;
+    CPU_SIZE_T  str;
+    CPU_SIZE_T  sh;
+    CPU_SIZE_T  ph;
+    INT32U      vaddr;
+    CPU_INT32U  i;
+
+
+    HOST_TEST_CHK(page_size <= TEST_BUF_BYTES);
+    sym = TEST_ELF_DATA + page_size;
+    str = sym + 2u * TEST_ELF_SYM;
+    sh  = str + sizeof(TestStrTab);
+    (void)memset(TestElf, 0, sizeof(TestElf));
+
+    (void)memcpy(&TestElf[0], "\177ELF\1\1\1", 7u);         /* 32-bit, little-endian, version 1     */
+    TestPut(16u, 2u,             2u);                           /* Executable                           */
+    TestPut(18u, 40u,            2u);                           /* ARM                                  */
+    TestPut(20u, 1u,             4u);
+    TestPut(28u, TEST_ELF_EHDR,  4u);                           /* Program headers                      */
+    TestPut(32u, sh,             4u);                           /* Section headers                      */
+    TestPut(40u, TEST_ELF_EHDR,  2u);
+    TestPut(42u, TEST_ELF_PHDR,  2u);
+    TestPut(44u, 2u,             2u);
+    TestPut(46u, TEST_ELF_SHDR,  2u);
+    TestPut(48u, 3u,             2u);
+
+    vaddr = (in_flash == DEF_YES) ? (TEST_FLASH + ref_ofs) : TEST_RAM;
+    for (i = 0u; i < 2u; i++) {                                 /* Page up to MemTestCrcRef, then rest  */
+        ph = TEST_ELF_EHDR + i * TEST_ELF_PHDR;
+        TestPut(ph,       1u,                                                    4u);
+        TestPut(ph + 4u,  TEST_ELF_DATA + ((i == 0u) ? 0u : ref_ofs),            4u);
+        TestPut(ph + 8u,  (i == 0u) ? TEST_FLASH : vaddr,                        4u);
+        TestPut(ph + 12u, TEST_FLASH + ((i == 0u) ? 0u : ref_ofs),               4u);
+        TestPut(ph + 16u, (i == 0u) ? ref_ofs : (page_size - ref_ofs),           4u);
+        TestPut(ph + 20u, (i == 0u) ? ref_ofs : (page_size - ref_ofs),           4u);
+        TestPut(ph + 24u, 4u,                                                    4u);
+    }
+    (void)memcpy(&TestElf[TEST_ELF_DATA], p_page, page_size);
+
+    TestPut(sym + TEST_ELF_SYM,       1u,    4u);               /* MemTestCrcRef, a global object       */
+    TestPut(sym + TEST_ELF_SYM + 4u,  vaddr, 4u);
+    TestPut(sym + TEST_ELF_SYM + 8u,  4u,    4u);
+    TestPut(sym + TEST_ELF_SYM + 12u, 0x11u, 1u);
+    (void)memcpy(&TestElf[str], TestStrTab, sizeof(TestStrTab));
+
+    TestPut(sh + TEST_ELF_SHDR + 4u,       2u,                  4u);   /* Symbol table              */
+    TestPut(sh + TEST_ELF_SHDR + 16u,      sym,                 4u);
+    TestPut(sh + TEST_ELF_SHDR + 20u,      2u * TEST_ELF_SYM,   4u);
+    TestPut(sh + TEST_ELF_SHDR + 24u,      2u,                  4u);
+    TestPut(sh + TEST_ELF_SHDR + 36u,      TEST_ELF_SYM,        4u);
+    TestPut(sh + 2u * TEST_ELF_SHDR + 4u,  3u,                  4u);   /* String table              */
+    TestPut(sh + 2u * TEST_ELF_SHDR + 16u, str,                 4u);
+    TestPut(sh + 2u * TEST_ELF_SHDR + 20u, sizeof(TestStrTab),  4u);
+
+    sh += 3u * TEST_ELF_SHDR;
+    HostTestFileWrite(TEST_ELF, TestElf, sh);
+    return (sh);
+}
+
+
+static  void  TestElfRead (CPU_SIZE_T  size)
+{
+    FILE  *p_file;
+
+
+    p_file = fopen(TEST_ELF, "rb");
+    HOST_TEST_CHK(p_file != (FILE *)0);
+    HOST_TEST_CHK(fread(TestElfOut, 1u, sizeof(TestElfOut), p_file) == size);
+    (void)fclose(p_file);
+}
+
+
+static  INT32U  TestCrcRefTool (const INT8U  *p_page,           /* See Note #3                          */
+                                CPU_SIZE_T    page_size,
+                                CPU_SIZE_T    ref_ofs,
+                                INT32U        crc_ref)
+{
+    char        args[128];
+    char        line[128];
+    CPU_SIZE_T  size;
+    INT32U      crc;
+
+
+    snprintf(args, sizeof(args), "memtest_crc_ref.py --start 0x%08X --end 0x%08X " TEST_ELF,
+             (unsigned)TEST_FLASH, (unsigned)(TEST_FLASH + page_size - 1u));
+
+    size = TestElfWrite(p_page, page_size, ref_ofs, DEF_NO);
+    HOST_TEST_CHK(HostTestTool(args, TestOut, sizeof(TestOut)) == 1);
+    TestElfRead(size);
+    HOST_TEST_CHK(memcmp(TestElfOut, TestElf, size) == 0);
+
+    size = TestElfWrite(p_page, page_size, ref_ofs, DEF_YES);
+    HOST_TEST_CHK(HostTestTool(args, TestOut, sizeof(TestOut)) == 0);
+    snprintf(line, sizeof(line), "%s: MemTestCrcRef = 0x%08X over 0x%08X-0x%08X\n", TEST_ELF,
+             (unsigned)crc_ref, (unsigned)TEST_FLASH, (unsigned)(TEST_FLASH + page_size - 1u));
+    HOST_TEST_CHK(HostTestFind(TestOut, line));
+    TestElfRead(size);
+    (void)memcpy(&crc, &TestElfOut[TEST_ELF_DATA + ref_ofs], sizeof(crc));
+    HOST_TEST_CHK(crc == crc_ref);
+    (void)memcpy(&TestElfOut[TEST_ELF_DATA + ref_ofs], &TestElf[TEST_ELF_DATA + ref_ofs], sizeof(crc));
+    HOST_TEST_CHK(memcmp(TestElfOut, TestElf, size) == 0);      /* Nothing else changed                 */
+    return (crc);
+}
+
+
+static  void  TestChunks (void)
+{
+    CPU_INT32U  seed;
+    CPU_INT32U  i;
+    CPU_INT32U  ofs;
+    CPU_INT32U  chunk;
+    INT32U      crc;
+    INT32U      crc_ref;
+
+
+    HOST_TEST_CHK((MemTestCrc32(MEMTEST_CRC32_INIT, (const INT8U *)"123456789", 9u) ^ MEMTEST_CRC32_XOR)
+                  == 0xCBF43926u);
+    seed = 12345u;
+    for (i = 0u; i < TEST_BUF_BYTES; i++) {
+        TestBuf[i] = (INT8U)HostTestRand(&seed);
+    }
+    crc_ref = TestCrcBits(MEMTEST_CRC32_INIT, TestBuf, TEST_BUF_BYTES);
+    for (i = 0u; i < TEST_SPLITS; i++) {
+        crc = MEMTEST_CRC32_INIT;
+        ofs = 0u;
+        while (ofs < TEST_BUF_BYTES) {
+            chunk = HostTestRand(&seed) % ((i & 1u) ? 16u : 8192u);
+            if (chunk > TEST_BUF_BYTES - ofs) {
+                chunk = TEST_BUF_BYTES - ofs;
+            }
+            crc  = MemTestCrc32(crc, &TestBuf[ofs], chunk);
+            ofs += chunk;
+        }
+        HOST_TEST_CHK(crc == crc_ref);
+    }
+}
+
+
+static  void  TestTask (void  *p_arg)
+{
+    OS_ERR           err;
+    INT8U           *p_page;
+    CPU_SIZE_T       page_size;
+    CPU_SIZE_T       ref_ofs;
+    INT32U           crc;
+    INT32U           crc_ref;
+    MEMTEST_STATUS   status;
+
+
+    (void)p_arg;
+    OS_CPU_SysTickInitFreq(0u);
+    TestChunks();
+
+    page_size = (CPU_SIZE_T)sysconf(_SC_PAGESIZE);
+    p_page    = (INT8U *)((CPU_ADDR)&MemTestCrcRef & ~(CPU_ADDR)(page_size - 1u));
+    ref_ofs   = (CPU_SIZE_T)((CPU_ADDR)&MemTestCrcRef - (CPU_ADDR)p_page);
+    HOST_TEST_CHK(mprotect(p_page, page_size, PROT_READ | PROT_WRITE) == 0);
+    crc_ref   = TestCrcBits(MEMTEST_CRC32_INIT, p_page, ref_ofs);
+    crc_ref   = TestCrcBits(crc_ref, p_page + ref_ofs + 4u, page_size - ref_ofs - 4u) ^ MEMTEST_CRC32_XOR;
+    HOST_TEST_CHK(*(volatile INT32U *)&MemTestCrcRef == MEMTEST_CRC_REF_NONE);
+
+    *(volatile INT32U *)&MemTestCrcRef = TestCrcRefTool(p_page, page_size, ref_ofs, crc_ref);
+    MemTestInit(p_page, p_page + page_size - 1u);
+    status = MemTestPend(0u, &err);
+    HOST_TEST_CHK(err == OS_ERR_NONE);
+    HOST_TEST_CHK(status == MEMTEST_PASS);
+    HOST_TEST_CHK(MemTestStatusGet(&crc) == MEMTEST_PASS);
+    HOST_TEST_CHK(crc == crc_ref);
+    HOST_TEST_CHK(MemTestProgressGet() == 100u);
+
+    *(volatile INT32U *)&MemTestCrcRef = crc_ref ^ 1u;          /* Next pass compares with a wrong one   */
+    OSTimeDly(TEST_PASS_TICKS, OS_OPT_TIME_DLY, &err);
+    HOST_TEST_CHK(MemTestStatusGet(&crc) == MEMTEST_FAIL);
+    HOST_TEST_CHK(crc == crc_ref);
+
+    *(volatile INT32U *)&MemTestCrcRef = MEMTEST_CRC_REF_NONE;  /* As if the post-build step had not run */
+    OSTimeDly(TEST_PASS_TICKS, OS_OPT_TIME_DLY, &err);
+    HOST_TEST_CHK(MemTestStatusGet(&crc) == MEMTEST_NO_REF);
+    HOST_TEST_CHK(crc == crc_ref);
+
+    printf("memtest crc=0x%08X splits=%u page=%u ref at +%u\n",
+           (unsigned)crc_ref, (unsigned)TEST_SPLITS, (unsigned)page_size, (unsigned)ref_ofs);
+    HostTestPass("memtest_crc");
+}
+
+
+int  main (void)
+{
+    HostTestInit();
+    HostTestTaskCreate(&TestTCB, "Test Task", TestTask, (void *)0, 4u, &TestStk[0], 512u);
+    HostTestStart();
+    return (1);
+}
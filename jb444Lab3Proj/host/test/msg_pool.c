@@ -0,0 +1,199 @@
+/*
+*********************************************************************************************************
+*                                   HOST TEST: PER-QUEUE MESSAGE POOLS
+*
+* Filename : msg_pool.c
+*
+* Note(s)  : (1) Usage: msg_pool [<msgs>]. TEST_PRODUCERS producers each post <msgs> numbered messages
+*                to one queue that has its own pool of TEST_POOL_SIZE OS_MSGs. The last producer posts
+*                from a faked ISR (OSIntEnter() ... OSIntExit()). One consumer, between the producers
+*                in priority, must receive every message once and in order for each producer.
+*
+*            (2) Before the producers start, a burst on another queue takes every OS_MSG of OSMsgPool
+*                and must stop at OS_ERR_MSG_POOL_EMPTY after OS_CFG_MSG_POOL_SIZE posts. It stays
+*                unread during the run, so the producers' queue runs on its own pool only. A task
+*                producer that finds the queue or its pool full delays a tick and posts again. The
+*                faked ISR only posts when there is room, as a deferred post that fails is not
+*                reported back to it.
+*
+*            (3) Once the burst is flushed, TEST_Q_SIZE + 1 messages are posted with the consumer held
+*                off. The first goes straight to the pending consumer, without an OS_MSG. Of the rest,
+*                the ones beyond TEST_POOL_SIZE must come from OSMsgPool and be counted in the pool's
+*                FallbackCtr. After they are read both pools must be full again.
+*
+*            (4) Built with OS_CFG_MSG_POOL_LOCAL_EN enabled (test/cfg/msg_pool).
+*********************************************************************************************************
+*/
+
+#include  "host_test.h"
+
+
+#define  TEST_PRODUCERS             4u
+#define  TEST_POOL_SIZE            16u
+#define  TEST_Q_SIZE               24u
+#define  TEST_ID_LAST          TEST_PRODUCERS                   /* Messages of the fallback check       */
+
+
+static  OS_Q         TestQ;
+static  OS_Q         TestBurstQ;
+static  OS_MSG_POOL  TestPool;
+static  OS_MSG       TestPoolStore[TEST_POOL_SIZE];
+static  CPU_INT32U   TestMsgs;
+static  CPU_INT32U   TestNext[TEST_PRODUCERS + 1u];             /* Next number expected, per producer   */
+static  CPU_INT32U   TestRxCnt;
+static  CPU_INT32U   TestRetries;
+static  OS_TCB       TestTCB;
+static  CPU_STK      TestStk[512];
+static  OS_TCB       TestRxTCB;
+static  CPU_STK      TestRxStk[256];
+static  OS_TCB       TestTxTCB[TEST_PRODUCERS];
+static  CPU_STK      TestTxStk[TEST_PRODUCERS][256];
+
+
+static  void  TestRx (void  *p_arg)
+{
+    OS_ERR       err;
+    OS_MSG_SIZE  id;
+    void        *p_msg;
+
+
+    (void)p_arg;
+    while (DEF_ON) {
+        p_msg = OSQPend(&TestQ, 0u, OS_OPT_PEND_BLOCKING, &id, (CPU_TS *)0, &err);
+        HOST_TEST_CHK(err == OS_ERR_NONE);
+        HOST_TEST_CHK(id <= TEST_ID_LAST);
+        HOST_TEST_CHK((CPU_INT32U)(CPU_ADDR)p_msg == TestNext[id]);
+        TestNext[id]++;
+        TestRxCnt++;
+    }
+}
+
+
+static  CPU_BOOLEAN  TestPostIsr (CPU_INT32U  seq)
+{
+    OS_ERR       err;
+    CPU_BOOLEAN  room;
+    CPU_SR_ALLOC();
+
+
+    CPU_CRITICAL_ENTER();
+    OSIntEnter();
+    CPU_CRITICAL_EXIT();
+    room = ((TestQ.MsgQ.NbrEntries < TestQ.MsgQ.NbrEntriesSize) &&
+            ((TestPool.NbrFree > 0u) || (OSMsgPool.NbrFree > 0u))) ? DEF_YES : DEF_NO;
+    if (room == DEF_YES) {
+        OSQPost(&TestQ, (void *)(CPU_ADDR)seq, (OS_MSG_SIZE)(TEST_PRODUCERS - 1u), OS_OPT_POST_FIFO, &err);
+        HOST_TEST_CHK(err == OS_ERR_NONE);
+    }
+    OSIntExit();
+    return (room);
+}
+
+
+static  void  TestTx (void  *p_arg)
+{
+    OS_ERR       err;
+    CPU_INT32U   id;
+    CPU_INT32U   seq;
+    CPU_BOOLEAN  posted;
+
+
+    id = (CPU_INT32U)(CPU_ADDR)p_arg;
+    for (seq = 0u; seq < TestMsgs; ) {
+        if (id == (TEST_PRODUCERS - 1u)) {
+            posted = TestPostIsr(seq);
+        } else {
+            OSQPost(&TestQ, (void *)(CPU_ADDR)seq, (OS_MSG_SIZE)id, OS_OPT_POST_FIFO, &err);
+            HOST_TEST_CHK((err == OS_ERR_NONE) || (err == OS_ERR_Q_MAX) || (err == OS_ERR_MSG_POOL_EMPTY));
+            posted = (err == OS_ERR_NONE) ? DEF_YES : DEF_NO;
+        }
+        if (posted == DEF_YES) {
+            seq++;
+        } else {
+            TestRetries++;
+            OSTimeDly(1u, OS_OPT_TIME_DLY, &err);               /* Let the consumer catch up            */
+        }
+    }
+    OSTaskDel((OS_TCB *)0, &err);
+}
+
+
+static  void  TestTask (void  *p_arg)
+{
+    OS_ERR      err;
+    OS_CTR      fallbacks;
+    CPU_INT32U  burst;
+    CPU_INT32U  i;
+
+
+    (void)p_arg;
+    OS_CPU_SysTickInitFreq(0u);
+    for (burst = 0u; ; burst++) {                               /* See Note #2                          */
+        OSQPost(&TestBurstQ, (void *)0, 0u, OS_OPT_POST_FIFO, &err);
+        if (err != OS_ERR_NONE) {
+            break;
+        }
+    }
+    HOST_TEST_CHK(err == OS_ERR_MSG_POOL_EMPTY);
+    HOST_TEST_CHK(burst == OS_CFG_MSG_POOL_SIZE);
+
+    while (TestRxCnt < (TestMsgs * TEST_PRODUCERS)) {           /* Producers and consumer run           */
+        OSTimeDly(1u, OS_OPT_TIME_DLY, &err);
+    }
+    for (i = 0u; i < TEST_PRODUCERS; i++) {
+        HOST_TEST_CHK(TestNext[i] == TestMsgs);
+    }
+    HOST_TEST_CHK(TestPool.NbrFree == TEST_POOL_SIZE);
+    HOST_TEST_CHK(TestPool.NbrUsedMax == TEST_POOL_SIZE);
+    fallbacks = TestPool.FallbackCtr;                           /* Tried OSMsgPool, which was empty     */
+
+    (void)OSQFlush(&TestBurstQ, &err);                          /* See Note #3                          */
+    HOST_TEST_CHK(OSMsgPool.NbrFree == OS_CFG_MSG_POOL_SIZE);
+    HOST_TEST_CHK(TestQ.PendList.NbrEntries == 1u);             /* First post goes to the consumer      */
+    for (i = 0u; i < (TEST_Q_SIZE + 1u); i++) {
+        OSQPost(&TestQ, (void *)(CPU_ADDR)i, (OS_MSG_SIZE)TEST_ID_LAST, OS_OPT_POST_FIFO, &err);
+        HOST_TEST_CHK(err == OS_ERR_NONE);
+    }
+    HOST_TEST_CHK(TestPool.NbrFree == 0u);
+    HOST_TEST_CHK(OSMsgPool.NbrUsed == (TEST_Q_SIZE - TEST_POOL_SIZE));
+    HOST_TEST_CHK(TestPool.FallbackCtr - fallbacks == (TEST_Q_SIZE - TEST_POOL_SIZE));
+    OSTimeDly(1u, OS_OPT_TIME_DLY, &err);
+    HOST_TEST_CHK(TestNext[TEST_ID_LAST] == (TEST_Q_SIZE + 1u));
+    HOST_TEST_CHK(TestPool.NbrFree  == TEST_POOL_SIZE);
+    HOST_TEST_CHK(OSMsgPool.NbrFree == OS_CFG_MSG_POOL_SIZE);
+
+    printf("msg pool producers=%u msgs=%u pool=%u: retries=%u, empty-fallbacks during burst=%u\n",
+           (unsigned)TEST_PRODUCERS,
+           (unsigned)(TestMsgs * TEST_PRODUCERS),
+           (unsigned)TEST_POOL_SIZE,
+           (unsigned)TestRetries,
+           (unsigned)fallbacks);
+    HostTestPass("msg_pool");
+}
+
+
+int  main (int    argc,
+           char  *argv[])
+{
+    OS_ERR      err;
+    CPU_INT32U  i;
+
+
+    TestMsgs = (argc > 1) ? (CPU_INT32U)atoi(argv[1]) : 12500u;
+    HOST_TEST_CHK(TestMsgs > 0u);
+    HostTestInit();
+    OSQCreate(&TestQ,      "Producers", TEST_Q_SIZE,                 &err);
+    OSQCreate(&TestBurstQ, "Burst",     OS_CFG_MSG_POOL_SIZE + 1u,   &err);
+    OSMsgPoolCreate(&TestPool, &TestPoolStore[0], TEST_POOL_SIZE, &err);
+    HOST_TEST_CHK(err == OS_ERR_NONE);
+    OSQPoolSet(&TestQ, &TestPool, &err);
+    HOST_TEST_CHK(err == OS_ERR_NONE);
+    HostTestTaskCreate(&TestTCB,   "Test Task", TestTask, (void *)0, 4u,  &TestStk[0],   512u);
+    HostTestTaskCreate(&TestRxTCB, "Consumer",  TestRx,   (void *)0, 12u, &TestRxStk[0], 256u);
+    for (i = 0u; i < TEST_PRODUCERS; i++) {                     /* Two above the consumer, two below    */
+        HostTestTaskCreate(&TestTxTCB[i], "Producer", TestTx, (void *)(CPU_ADDR)i,
+                           (OS_PRIO)(10u + i + ((i >= 2u) ? 1u : 0u)), &TestTxStk[i][0], 256u);
+    }
+    HostTestStart();
+    return (1);
+}
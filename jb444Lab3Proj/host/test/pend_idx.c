@@ -0,0 +1,127 @@
+/*
+*********************************************************************************************************
+*                                      HOST TEST: PEND LIST INDEX
+*
+* Filename : pend_idx.c
+*
+* Note(s)  : (1) Two semaphores get the same random inserts, removals and priority changes of up to
+*                TEST_TCBS waiters, one through its priority index and one with the index detached,
+*                which walks the list. After every operation both pend lists must hold the same
+*                waiters in the same order, sorted by priority and FIFO within a priority.
+*
+*            (2) Built with 256 priorities of which the index covers 64 (test/cfg/pend_idx), so some
+*                waiters are inserted through the index and others by the walk past it. The TCBs are
+*                not tasks: the pend list functions only use their priority and pend links.
+*********************************************************************************************************
+*/
+
+#include  <string.h>
+#include  "host_test.h"
+
+
+#define  TEST_TCBS                300u
+#define  TEST_OPS              200000u
+
+
+static  OS_SEM      TestSemIdx;
+static  OS_SEM      TestSemRef;
+static  OS_TCB      TestTcbIdx[TEST_TCBS];
+static  OS_TCB      TestTcbRef[TEST_TCBS];
+static  CPU_INT32U  TestSeed = 12345u;
+
+
+static  OS_PRIO  TestPrio (void)
+{
+    CPU_INT32U  r;
+
+
+    r = HostTestRand(&TestSeed);
+    if ((r & 1u) == 0u) {                                       /* Few priorities, so FIFO order counts */
+        return ((OS_PRIO)((r >> 1) % 8u) * (OS_CFG_PEND_IDX_PRIO_MAX / 8u));
+    }
+    return ((OS_PRIO)((r >> 1) % OS_CFG_PRIO_MAX));
+}
+
+
+static  void  TestListChk (CPU_INT32U  nbr)
+{
+    OS_TCB      *p_idx;
+    OS_TCB      *p_ref;
+    OS_TCB      *p_prev;
+    CPU_INT32U   n;
+
+
+    p_idx  = TestSemIdx.PendList.HeadPtr;
+    p_ref  = TestSemRef.PendList.HeadPtr;
+    p_prev = (OS_TCB *)0;
+    for (n = 0u; p_idx != (OS_TCB *)0; n++) {
+        HOST_TEST_CHK(p_ref != (OS_TCB *)0);
+        HOST_TEST_CHK((p_idx - &TestTcbIdx[0]) == (p_ref - &TestTcbRef[0]));
+        HOST_TEST_CHK(p_idx->PendPrevPtr == p_prev);
+        HOST_TEST_CHK((p_prev == (OS_TCB *)0) || (p_prev->Prio <= p_idx->Prio));
+        p_prev = p_idx;
+        p_idx  = p_idx->PendNextPtr;
+        p_ref  = p_ref->PendNextPtr;
+    }
+    HOST_TEST_CHK(p_ref == (OS_TCB *)0);
+    HOST_TEST_CHK(n == nbr);
+    HOST_TEST_CHK(TestSemIdx.PendList.TailPtr == p_prev);
+    HOST_TEST_CHK(TestSemIdx.PendList.NbrEntries == nbr);
+}
+
+
+int  main (void)
+{
+    OS_ERR      err;
+    CPU_INT32U  op;
+    CPU_INT32U  i;
+    CPU_INT32U  r;
+    CPU_INT32U  nbr;
+    CPU_INT32U  walked;
+    OS_PRIO     prio;
+
+
+    HostTestInit();
+    OSSemCreate(&TestSemIdx, "Indexed", 0u, &err);
+    HOST_TEST_CHK(err == OS_ERR_NONE);
+    HOST_TEST_CHK(TestSemIdx.PendList.IdxPtr != (OS_PEND_LIST_IDX *)0);
+    OSSemCreate(&TestSemRef, "Walked",  0u, &err);
+    HOST_TEST_CHK(err == OS_ERR_NONE);
+    TestSemRef.PendList.IdxPtr = (OS_PEND_LIST_IDX *)0;         /* Reference: the list walk             */
+    (void)memset(&TestTcbIdx[0], 0, sizeof(TestTcbIdx));
+    (void)memset(&TestTcbRef[0], 0, sizeof(TestTcbRef));
+
+    nbr    = 0u;
+    walked = 0u;
+    for (op = 0u; op < TEST_OPS; op++) {
+        r = HostTestRand(&TestSeed);
+        i = (r >> 8) % TEST_TCBS;
+        if (TestTcbIdx[i].PendObjPtr == (OS_PEND_OBJ *)0) {     /* Not waiting: insert it               */
+            prio                     = TestPrio();
+            TestTcbIdx[i].Prio       = prio;
+            TestTcbRef[i].Prio       = prio;
+            TestTcbIdx[i].PendObjPtr = (OS_PEND_OBJ *)&TestSemIdx;
+            TestTcbRef[i].PendObjPtr = (OS_PEND_OBJ *)&TestSemRef;
+            OS_PendListInsertPrio(&TestSemIdx.PendList, &TestTcbIdx[i]);
+            OS_PendListInsertPrio(&TestSemRef.PendList, &TestTcbRef[i]);
+            if (prio >= OS_CFG_PEND_IDX_PRIO_MAX) {
+                walked++;
+            }
+            nbr++;
+        } else if ((r & 1u) == 0u) {
+            OS_PendListRemove(&TestTcbIdx[i]);
+            OS_PendListRemove(&TestTcbRef[i]);
+            nbr--;
+        } else {
+            prio = TestPrio();
+            OS_PendListChangePrio(&TestTcbIdx[i], prio);
+            OS_PendListChangePrio(&TestTcbRef[i], prio);
+        }
+        TestListChk(nbr);
+    }
+    HOST_TEST_CHK(walked > 0u);
+    printf("pend idx ops=%u waiters=%u walked inserts=%u\n",
+           (unsigned)TEST_OPS, (unsigned)nbr, (unsigned)walked);
+    HostTestPass("pend_idx");
+    return (1);
+}
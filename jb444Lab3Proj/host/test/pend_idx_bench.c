@@ -0,0 +1,96 @@
+/*
+*********************************************************************************************************
+*                                   HOST BENCHMARK: PEND LIST INSERTION
+*
+* Filename : pend_idx_bench.c
+*
+* Note(s)  : (1) Usage: pend_idx_bench <waiters>. A semaphore's pend list holds <waiters> TCBs at
+*                random priorities. One operation removes a random waiter and inserts it again, as a
+*                timeout and the next pend do. It is timed with the priority index attached and with
+*                it detached, which walks the list.
+*
+*            (2) pend_idx_bench runs with the project configuration, 32 priorities all indexed.
+*                pend_idx_bench_256 has 256 priorities of which the index covers 64 (test/cfg/pend_idx);
+*                waiters at the other 192 are inserted by walking past the indexed ones.
+*                The size of one index is printed with the times, with 8-byte pointers.
+*********************************************************************************************************
+*/
+
+#include  <string.h>
+#include  "host_test.h"
+
+
+#define  TEST_WAITERS_MAX        1024u
+#define  TEST_OPS             2000000u
+#define  TEST_RUNS                  5u
+
+
+static  OS_SEM      TestSem;
+static  OS_TCB      TestTcb[TEST_WAITERS_MAX];
+static  CPU_INT32U  TestWaiters;
+
+
+static  CPU_INT64U  TestRun (OS_PEND_LIST_IDX  *p_idx)
+{
+    CPU_INT32U  seed;
+    CPU_INT32U  i;
+    CPU_INT32U  op;
+    CPU_INT64U  ns;
+    CPU_INT64U  best;
+    CPU_INT32U  run;
+
+
+    best = DEF_INT_64U_MAX_VAL;
+    for (run = 0u; run < TEST_RUNS; run++) {
+        OS_PendListInit(&TestSem.PendList);
+        if (p_idx != (OS_PEND_LIST_IDX *)0) {
+            OS_PendListIdxInit(&TestSem.PendList, p_idx);
+        }
+        seed = 12345u;
+        (void)memset(&TestTcb[0], 0, sizeof(TestTcb));
+        for (i = 0u; i < TestWaiters; i++) {
+            TestTcb[i].Prio       = (OS_PRIO)(HostTestRand(&seed) % (OS_CFG_PRIO_MAX - 4u));
+            TestTcb[i].PendObjPtr = (OS_PEND_OBJ *)&TestSem;
+            OS_PendListInsertPrio(&TestSem.PendList, &TestTcb[i]);
+        }
+        ns = HostTestNs();
+        for (op = 0u; op < TEST_OPS; op++) {
+            i = HostTestRand(&seed) % TestWaiters;
+            OS_PendListRemove(&TestTcb[i]);
+            TestTcb[i].PendObjPtr = (OS_PEND_OBJ *)&TestSem;
+            OS_PendListInsertPrio(&TestSem.PendList, &TestTcb[i]);
+        }
+        ns = HostTestNs() - ns;
+        if (best > ns) {
+            best = ns;
+        }
+    }
+    return (best);
+}
+
+
+int  main (int    argc,
+           char  *argv[])
+{
+    OS_ERR      err;
+    CPU_INT64U  walk_ns;
+    CPU_INT64U  idx_ns;
+
+
+    TestWaiters = (argc > 1) ? (CPU_INT32U)atoi(argv[1]) : 32u;
+    HOST_TEST_CHK((TestWaiters > 0u) && (TestWaiters <= TEST_WAITERS_MAX));
+    HostTestInit();
+    OSSemCreate(&TestSem, "Bench", 0u, &err);
+    HOST_TEST_CHK(err == OS_ERR_NONE);
+
+    walk_ns = TestRun((OS_PEND_LIST_IDX *)0);
+    idx_ns  = TestRun(&TestSem.PendListIdx);
+    printf("pend list prios=%-3u indexed=%-3u waiters=%-4u walk=%6.1f ns  index=%6.1f ns  (index %u B on the host)\n",
+           (unsigned)OS_CFG_PRIO_MAX,
+           (unsigned)OS_CFG_PEND_IDX_PRIO_MAX,
+           (unsigned)TestWaiters,
+           (double)walk_ns / TEST_OPS,
+           (double)idx_ns  / TEST_OPS,
+           (unsigned)sizeof(OS_PEND_LIST_IDX));
+    return (0);
+}
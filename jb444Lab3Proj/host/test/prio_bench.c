@@ -0,0 +1,97 @@
+/*
+*********************************************************************************************************
+*                                  HOST BENCHMARK: SCHEDULER DECISION
+*
+* Filename : prio_bench.c
+*
+* Note(s)  : (1) Usage: prio_bench <ready>. <ready> priorities are made ready, the lowest always the
+*                idle priority and the others random, then OS_PrioGetHighest() and the original
+*                table scan are each timed over TEST_CALLS calls; the best of TEST_RUNS runs is
+*                printed. With <ready> 1 only idle is ready, the worst case for the scan.
+*
+*            (2) Built with the project's 32 priorities (prio_bench), 256 (prio_bench_256) and 1024
+*                (prio_bench_1024). The host CPU_CntLeadZeros() is the C version from cpu_core.c;
+*                the board uses CLZ, so both lookups are faster there.
+*********************************************************************************************************
+*/
+
+#include  "host_test.h"
+
+
+#define  TEST_CALLS          10000000u
+#define  TEST_RUNS                  5u
+
+
+static  OS_PRIO  TestScan (void)                                /* OS_PrioGetHighest() before OSPrioGrp */
+{
+    CPU_DATA  *p_tbl;
+    OS_PRIO    prio;
+
+
+    prio  = 0u;
+    p_tbl = &OSPrioTbl[0];
+    while (*p_tbl == 0u) {
+        prio += (OS_PRIO)DEF_INT_CPU_NBR_BITS;
+        p_tbl++;
+    }
+    prio += (OS_PRIO)CPU_CntLeadZeros(*p_tbl);
+    return (prio);
+}
+
+
+static  CPU_INT64U  TestTime (CPU_BOOLEAN  scan)
+{
+    CPU_INT64U         best;
+    CPU_INT64U         ns;
+    CPU_INT32U         run;
+    CPU_INT32U         i;
+    volatile OS_PRIO   prio;
+
+
+    best = DEF_INT_64U_MAX_VAL;
+    for (run = 0u; run < TEST_RUNS; run++) {
+        ns = HostTestNs();
+        for (i = 0u; i < TEST_CALLS; i++) {
+            prio = (scan == DEF_YES) ? TestScan() : OS_PrioGetHighest();
+        }
+        ns = HostTestNs() - ns;
+        if (best > ns) {
+            best = ns;
+        }
+    }
+    (void)prio;
+    return (best);
+}
+
+
+int  main (int    argc,
+           char  *argv[])
+{
+    CPU_INT32U  ready;
+    CPU_INT32U  seed;
+    CPU_INT32U  i;
+    CPU_INT64U  grp_ns;
+    CPU_INT64U  scan_ns;
+
+
+    ready = (argc > 1) ? (CPU_INT32U)atoi(argv[1]) : 1u;
+    HOST_TEST_CHK((ready > 0u) && (ready <= OS_CFG_PRIO_MAX));
+    HostTestInit();
+    OS_PrioInit();
+    OS_PrioInsert(OS_CFG_PRIO_MAX - 1u);
+    seed = 12345u;
+    for (i = 1u; i < ready; i++) {                              /* May repeat a priority, as tasks can  */
+        OS_PrioInsert((OS_PRIO)(HostTestRand(&seed) % OS_CFG_PRIO_MAX));
+    }
+    HOST_TEST_CHK(OS_PrioGetHighest() == TestScan());
+
+    grp_ns  = TestTime(DEF_NO);
+    scan_ns = TestTime(DEF_YES);
+    printf("prio highest prios=%-4u ready=%-3u highest=%-4u scan=%5.2f ns  group=%5.2f ns\n",
+           (unsigned)OS_CFG_PRIO_MAX,
+           (unsigned)ready,
+           (unsigned)OS_PrioGetHighest(),
+           (double)scan_ns / TEST_CALLS,
+           (double)grp_ns  / TEST_CALLS);
+    return (0);
+}
@@ -0,0 +1,77 @@
+/*
+*********************************************************************************************************
+*                                   HOST TEST: READY PRIORITY BITMAP
+*
+* Filename : prio_tbl.c
+*
+* Note(s)  : (1) TEST_STEPS random OS_PrioInsert() and OS_PrioRemove() calls, with the idle priority
+*                always ready. After each one OS_PrioGetHighest() must return the highest priority of
+*                a reference set, and the group word must have a bit set for exactly the table entries
+*                that are not empty.
+*
+*            (2) Built with the project's 32 priorities (prio_tbl), 256 (prio_tbl_256) and 1024
+*                (prio_tbl_1024). Half the steps stay in the first table entry, so that entries often
+*                become empty and fill again.
+*********************************************************************************************************
+*/
+
+#include  "host_test.h"
+
+
+#define  TEST_STEPS           2000000u
+
+
+static  CPU_BOOLEAN  TestRdy[OS_CFG_PRIO_MAX];
+
+
+static  void  TestGrpChk (void)
+{
+#if (OS_CFG_PRIO_MAX > DEF_INT_CPU_NBR_BITS)
+    CPU_DATA  ix;
+    CPU_DATA  bit;
+
+
+    for (ix = 0u; ix < OS_PRIO_TBL_SIZE; ix++) {
+        bit = (CPU_DATA)1u << ((DEF_INT_CPU_NBR_BITS - 1u) - ix);
+        HOST_TEST_CHK(((OSPrioGrp & bit) != 0u) == (OSPrioTbl[ix] != 0u));
+    }
+#endif
+}
+
+
+int  main (void)
+{
+    CPU_INT32U  seed;
+    CPU_INT32U  step;
+    CPU_INT32U  r;
+    OS_PRIO     prio;
+    OS_PRIO     high;
+
+
+    HostTestInit();
+    OS_PrioInit();                                              /* Only what this test inserts          */
+    OS_PrioInsert(OS_CFG_PRIO_MAX - 1u);
+    TestRdy[OS_CFG_PRIO_MAX - 1u] = DEF_TRUE;
+
+    seed = 12345u;
+    for (step = 0u; step < TEST_STEPS; step++) {
+        r    = HostTestRand(&seed);
+        prio = (OS_PRIO)((r >> 1) % (((r & 1u) != 0u) ? DEF_INT_CPU_NBR_BITS : (OS_CFG_PRIO_MAX - 1u)));
+        if (TestRdy[prio] == DEF_TRUE) {
+            OS_PrioRemove(prio);
+            TestRdy[prio] = DEF_FALSE;
+        } else {
+            OS_PrioInsert(prio);
+            TestRdy[prio] = DEF_TRUE;
+        }
+        for (high = 0u; TestRdy[high] == DEF_FALSE; high++) {
+            ;
+        }
+        HOST_TEST_CHK(OS_PrioGetHighest() == high);
+        TestGrpChk();
+    }
+    printf("prio tbl prios=%u entries=%u steps=%u\n",
+           (unsigned)OS_CFG_PRIO_MAX, (unsigned)OS_PRIO_TBL_SIZE, (unsigned)TEST_STEPS);
+    HostTestPass("prio_tbl");
+    return (1);
+}
@@ -0,0 +1,177 @@
+/*
+*********************************************************************************************************
+*                                 HOST TEST: CONTEXT SWITCH PROFILE
+*
+* Filename : prof_ctx_sw.c
+*
+* Note(s)  : (1) OS_ProfCtxSw() is first called directly on a task that is never run: the FP switches,
+*                the total and the longest save and restore must add up as the board's PendSV would
+*                report them, switches out with and without the FP registers mixed.
+*
+*            (2) The test task then passes a semaphore to a second task and back TEST_ROUNDS times.
+*                The host port charges each task switched out the time of its swapcontext() and never
+*                the FP registers (os_cpu_c.c OSTaskSwHook() Note #3), so each task's FP count must
+*                stay 0, its total must be non zero, and its longest must lie between the average and
+*                the total.
+*
+*            (3) An OSProfSnapshot() record must be version 2, OS_PROF_TASK_SIZE (116) bytes per task,
+*                and end each task's entry with its three counts of (1) and (2).
+*
+*            (4) The FPU branch is untested. The board's PendSV (os_cpu_a.asm Note #5) saves and
+*                restores S16-S31 only when bit 4 of EXC_RETURN is clear. The host port has no FPCA or
+*                EXC_RETURN to model that, so both tasks here switch with fp 0, and only the direct calls
+*                of (1) reach the FP counts. Whether the board's PendSV skips S16-S31 for a task without
+*                FP use, and what it costs when it does not, has to be measured on the board.
+*********************************************************************************************************
+*/
+
+#include  <string.h>
+#include  "host_test.h"
+
+
+#define  TEST_ROUNDS            10000u
+#define  TEST_TASKS_MAX            16u
+
+
+static  OS_SEM      TestPing;
+static  OS_SEM      TestPong;
+static  OS_TCB      TestIdleTCB;                                /* Never created, see Note #1           */
+static  OS_TCB      TestTCB;
+static  CPU_STK     TestStk[512];
+static  OS_TCB      TestPongTCB;
+static  CPU_STK     TestPongStk[256];
+static  CPU_INT08U  TestRec[OS_PROF_HDR_SIZE + TEST_TASKS_MAX * OS_PROF_TASK_SIZE];
+
+
+static  void  TestPongTask (void  *p_arg)
+{
+    OS_ERR  err;
+
+
+    (void)p_arg;
+    while (DEF_ON) {
+        (void)OSSemPend(&TestPing, 0u, OS_OPT_PEND_BLOCKING, (CPU_TS *)0, &err);
+        (void)OSSemPost(&TestPong, OS_OPT_POST_1, &err);
+    }
+}
+
+
+static  CPU_INT32U  TestGet32 (const CPU_INT08U  *p_src)
+{
+    return ((CPU_INT32U)p_src[0]         | ((CPU_INT32U)p_src[1] << 8u) |
+           ((CPU_INT32U)p_src[2] << 16u) | ((CPU_INT32U)p_src[3] << 24u));
+}
+
+
+static  void  TestDirect (void)
+{
+    CPU_SR_ALLOC();
+
+
+    CPU_CRITICAL_ENTER();                                       /* See Note #1                          */
+    OS_ProfCtxSw(&TestIdleTCB, DEF_FALSE,  40u);                /* Core registers only                  */
+    OS_ProfCtxSw(&TestIdleTCB, DEF_TRUE,   90u);                /* With S16-S31                         */
+    OS_ProfCtxSw(&TestIdleTCB, DEF_TRUE,   70u);
+    OS_ProfCtxSw(&TestIdleTCB, DEF_FALSE,  42u);
+    CPU_CRITICAL_EXIT();
+    HOST_TEST_CHK(TestIdleTCB.ProfFpCtxSwCtr  ==   2u);
+    HOST_TEST_CHK(TestIdleTCB.ProfCtxSwCycles == 242u);
+    HOST_TEST_CHK(TestIdleTCB.ProfCtxSwMax    ==  90u);
+}
+
+
+static  void  TestRun (OS_TCB  *p_tcb)
+{
+    CPU_INT32U  avg;
+
+
+    HOST_TEST_CHK(p_tcb->ProfFpCtxSwCtr == 0u);                 /* See Note #2                          */
+    HOST_TEST_CHK(p_tcb->CtxSwCtr >= TEST_ROUNDS);
+    HOST_TEST_CHK(p_tcb->ProfCtxSwCycles > 0u);
+    avg = (CPU_INT32U)(p_tcb->ProfCtxSwCycles / p_tcb->CtxSwCtr);
+    HOST_TEST_CHK((p_tcb->ProfCtxSwMax >= avg) && (p_tcb->ProfCtxSwMax <= p_tcb->ProfCtxSwCycles));
+    printf("prof ctx sw %-10s switched in %6u, fp %u, swapcontext() average %5u ns, longest %6u ns\n",
+           p_tcb->NamePtr,
+           (unsigned)p_tcb->CtxSwCtr,
+           (unsigned)p_tcb->ProfFpCtxSwCtr,
+           (unsigned)avg,
+           (unsigned)p_tcb->ProfCtxSwMax);
+}
+
+
+static  void  TestSnapshot (void)
+{
+    OS_ERR       err;
+    CPU_SIZE_T   size;
+    CPU_INT08U  *p_task;
+    CPU_INT08U  *p_cnts;
+    OS_TCB      *p_tcb;
+    CPU_INT32U   found;
+    CPU_INT32U   i;
+
+
+    HOST_TEST_CHK(OS_PROF_TASK_SIZE == 116u);                   /* See Note #3                          */
+    HOST_TEST_CHK(OSTaskQty <= TEST_TASKS_MAX);
+    size = OSProfSnapshot(&TestRec[0], sizeof(TestRec), &err);
+    HOST_TEST_CHK(err == OS_ERR_NONE);
+    HOST_TEST_CHK(size == OS_PROF_HDR_SIZE + (CPU_SIZE_T)OSTaskQty * OS_PROF_TASK_SIZE);
+    HOST_TEST_CHK(memcmp(&TestRec[0], "OSPF", 4u) == 0);
+    HOST_TEST_CHK((TestRec[4] | (TestRec[5] << 8u)) == OS_PROF_VERSION);
+    HOST_TEST_CHK(OS_PROF_VERSION == 2u);
+
+    found = 0u;
+    for (i = 0u; i < OSTaskQty; i++) {
+        p_task = &TestRec[OS_PROF_HDR_SIZE + i * OS_PROF_TASK_SIZE];
+        if (strncmp((const char *)&p_task[4], "Ping", OS_PROF_NAME_SIZE) == 0) {
+            p_tcb = &TestTCB;
+        } else if (strncmp((const char *)&p_task[4], "Pong", OS_PROF_NAME_SIZE) == 0) {
+            p_tcb = &TestPongTCB;
+        } else {
+            continue;
+        }
+        p_cnts = &p_task[OS_PROF_TASK_SIZE - 12u];
+        HOST_TEST_CHK(TestGet32(&p_cnts[0]) == (CPU_INT32U)p_tcb->ProfFpCtxSwCtr);
+        HOST_TEST_CHK(TestGet32(&p_cnts[4]) == (CPU_INT32U)p_tcb->ProfCtxSwCycles);
+        HOST_TEST_CHK(TestGet32(&p_cnts[8]) == (CPU_INT32U)p_tcb->ProfCtxSwMax);
+        found++;
+    }
+    HOST_TEST_CHK(found == 2u);
+}
+
+
+static  void  TestTask (void  *p_arg)
+{
+    OS_ERR      err;
+    CPU_INT32U  i;
+
+
+    (void)p_arg;
+    OS_CPU_SysTickInitFreq(0u);
+    TestDirect();
+    for (i = 0u; i < TEST_ROUNDS; i++) {
+        (void)OSSemPost(&TestPing, OS_OPT_POST_1, &err);
+        HOST_TEST_CHK(err == OS_ERR_NONE);
+        (void)OSSemPend(&TestPong, 0u, OS_OPT_PEND_BLOCKING, (CPU_TS *)0, &err);
+        HOST_TEST_CHK(err == OS_ERR_NONE);
+    }
+    TestRun(&TestTCB);
+    TestRun(&TestPongTCB);
+    TestSnapshot();
+    HostTestPass("prof_ctx_sw");
+}
+
+
+int  main (void)
+{
+    OS_ERR  err;
+
+
+    HostTestInit();
+    OSSemCreate(&TestPing, "Ping", 0u, &err);
+    OSSemCreate(&TestPong, "Pong", 0u, &err);
+    HOST_TEST_CHK(err == OS_ERR_NONE);
+    HostTestTaskCreate(&TestTCB,     "Ping", TestTask,     (void *)0, 10u, &TestStk[0],     512u);
+    HostTestTaskCreate(&TestPongTCB, "Pong", TestPongTask, (void *)0,  9u, &TestPongStk[0], 256u);
+    HostTestStart();
+    return (1);
+}
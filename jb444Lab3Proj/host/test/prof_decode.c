@@ -0,0 +1,209 @@
+/*
+*********************************************************************************************************
+*                                HOST TEST: PROFILER RECORD ROUND TRIP
+*
+* Filename : prof_decode.c
+*
+* Note(s)  : (1) Two tasks are passed a semaphore TEST_ROUNDS times, the lower one readying the higher
+*                one, while the test task fakes an ISR each round. OSProfSnapshot() is then called
+*                twice, TEST_ROUNDS apart, and both records are written one after the other to
+*                build/prof_decode.bin, as they would be appended from the debugger.
+*
+*            (2) tools/os_prof_decode.py is run on the file. For each record, its first line, its ISR
+*                line and the table line of each of the two tasks must be printed as built here from
+*                the kernel's own figures, read right after the snapshot while both tasks are blocked.
+*                For the second record, the share of the time, the switches in and the preemptions of
+*                each task since the first must match too: the higher task is switched in once a round,
+*                the lower one twice, as the higher one preempts it once.
+*********************************************************************************************************
+*/
+
+#include  <string.h>
+#include  "host_test.h"
+
+
+#define  TEST_ROUNDS              200u
+#define  TEST_RECS                  2u
+#define  TEST_TASKS                 2u
+#define  TEST_TASKS_MAX            16u
+#define  TEST_REC_SIZE           (OS_PROF_HDR_SIZE + TEST_TASKS_MAX * OS_PROF_TASK_SIZE)
+#define  TEST_LINE_SIZE           160u
+#define  TEST_PATH               HOST_TEST_OUT "prof_decode.bin"
+
+
+typedef  struct  test_task {                                    /* A task's figures at one snapshot     */
+    CPU_INT32U  Cycles;
+    CPU_INT32U  SwIn;
+    CPU_INT32U  Preempt;
+    char        Line[TEST_LINE_SIZE];
+} TEST_TASK;
+
+
+static  const  char  *TestStates[] = {                          /* As os_prof_decode.py names them      */
+    "RDY", "DLY", "PEND", "PEND+TO", "SUSP", "DLY+SUSP", "PEND+SUSP", "PEND+TO+SUSP"
+};
+
+static  OS_SEM      TestSem[TEST_TASKS];
+static  OS_TCB      TestTCB;
+static  CPU_STK     TestStk[512];
+static  OS_TCB      TestWorkTCB[TEST_TASKS];
+static  CPU_STK     TestWorkStk[TEST_TASKS][256];
+static  CPU_INT08U  TestRec[TEST_RECS * TEST_REC_SIZE];
+static  char        TestOut[16384];
+
+static  CPU_INT32U  TestTs[TEST_RECS];
+static  char        TestHdr[TEST_RECS][TEST_LINE_SIZE];
+static  char        TestIsr[TEST_RECS][TEST_LINE_SIZE];
+static  TEST_TASK   TestFig[TEST_RECS][TEST_TASKS];
+
+
+static  void  TestWork (void  *p_arg)
+{
+    OS_ERR      err;
+    CPU_INT32U  i;
+
+
+    i = (CPU_INT32U)(CPU_ADDR)p_arg;
+    while (DEF_ON) {
+        (void)OSSemPend(&TestSem[i], 0u, OS_OPT_PEND_BLOCKING, (CPU_TS *)0, &err);
+        HOST_TEST_CHK(err == OS_ERR_NONE);
+        if (i == 1u) {                                          /* Lower task readies the higher one    */
+            (void)OSSemPost(&TestSem[0], OS_OPT_POST_1, &err);
+        }
+    }
+}
+
+
+static  void  TestRun (void)
+{
+    OS_ERR      err;
+    CPU_INT32U  i;
+    CPU_SR_ALLOC();
+
+
+    for (i = 0u; i < TEST_ROUNDS; i++) {
+        CPU_CRITICAL_ENTER();                                   /* As the board's ISR prologue          */
+        OSIntEnter();
+        CPU_CRITICAL_EXIT();
+        OSIntExit();
+        (void)OSSemPost(&TestSem[1], OS_OPT_POST_1, &err);
+        HOST_TEST_CHK(err == OS_ERR_NONE);
+        OSTimeDly(1u, OS_OPT_TIME_DLY, &err);
+    }
+}
+
+
+static  double  TestUs (CPU_INT32U  counts,                     /* As us() in os_prof_decode.py         */
+                        CPU_INT32U  freq)
+{
+    return ((freq != 0u) ? (double)counts * 1e6 / freq : (double)counts);
+}
+
+
+static  CPU_SIZE_T  TestSnap (CPU_INT32U  n,
+                              CPU_INT08U *p_rec)
+{
+    OS_ERR       err;
+    CPU_ERR      cpu_err;
+    CPU_SIZE_T   size;
+    CPU_INT32U   freq;
+    CPU_INT32U   stk;
+    const char  *p_unit;
+    OS_TCB      *p_tcb;
+    TEST_TASK   *p_task;
+    CPU_INT32U   i;
+
+
+    size = OSProfSnapshot(p_rec, TEST_REC_SIZE, &err);
+    HOST_TEST_CHK((err == OS_ERR_NONE) && (size > 0u));
+    freq   = (CPU_INT32U)CPU_TS_TmrFreqGet(&cpu_err);
+    p_unit = (freq != 0u) ? "us" : "counts";
+    (void)memcpy(&TestTs[n], &p_rec[12], sizeof(CPU_INT32U));  /* Timestamp, after magic, version, qty */
+    snprintf(TestHdr[n], TEST_LINE_SIZE, "record %u: ts=%u  %u Hz  ctxsw=%u\n",
+             (unsigned)n, (unsigned)TestTs[n], (unsigned)freq, (unsigned)OSTaskCtxSwCtr);
+    snprintf(TestIsr[n], TEST_LINE_SIZE, "  ISRs: %u, %.1f %s total, longest %.2f %s\n",
+             (unsigned)OSProfIntCtr, TestUs((CPU_INT32U)OSProfIntCycles, freq), p_unit,
+             TestUs((CPU_INT32U)OSProfIntTimeMax, freq), p_unit);
+
+    for (i = 0u; i < TEST_TASKS; i++) {                         /* See Note #2                          */
+        p_tcb  = &TestWorkTCB[i];
+        p_task = &TestFig[n][i];
+        HOST_TEST_CHK(p_tcb->TaskState == OS_TASK_STATE_PEND);
+#if (OS_CFG_STAT_TASK_STK_CHK_EN == DEF_ENABLED)
+        stk = (CPU_INT32U)p_tcb->StkUsed * (CPU_INT32U)sizeof(CPU_STK);
+#else
+        stk = 0u;
+#endif
+        p_task->Cycles  = (CPU_INT32U)p_tcb->ProfCycles;
+        p_task->SwIn    = (CPU_INT32U)p_tcb->CtxSwCtr;
+        p_task->Preempt = (CPU_INT32U)p_tcb->ProfPreemptCtr;
+        snprintf(p_task->Line, TEST_LINE_SIZE, "  %-4u %-16s %-12s %6.2f %12u %8u %8u %10.2f %6u\n",
+                 (unsigned)p_tcb->Prio, p_tcb->NamePtr, TestStates[p_tcb->TaskState & 7u],
+                 p_tcb->CPUUsage / 100.0, (unsigned)p_task->Cycles, (unsigned)p_task->SwIn,
+                 (unsigned)p_task->Preempt, TestUs((CPU_INT32U)p_tcb->ProfLatMax, freq), (unsigned)stk);
+    }
+    return (size);
+}
+
+
+static  void  TestTask (void  *p_arg)
+{
+    char        line[TEST_LINE_SIZE];
+    CPU_SIZE_T  size;
+    CPU_INT32U  span;
+    CPU_INT32U  i;
+    CPU_INT32U  n;
+
+
+    (void)p_arg;
+    OS_CPU_SysTickInitFreq(0u);
+
+    TestRun();                                                  /* See Note #1                          */
+    size  = TestSnap(0u, &TestRec[0]);
+    TestRun();
+    size += TestSnap(1u, &TestRec[size]);
+    HostTestFileWrite(TEST_PATH, &TestRec[0], size);
+
+    HOST_TEST_CHK(HostTestTool("os_prof_decode.py " TEST_PATH, &TestOut[0], sizeof(TestOut)) == 0);
+    for (n = 0u; n < TEST_RECS; n++) {                          /* See Note #2                          */
+        HOST_TEST_CHK(HostTestFind(TestOut, TestHdr[n]));
+        HOST_TEST_CHK(HostTestFind(TestOut, TestIsr[n]));
+        for (i = 0u; i < TEST_TASKS; i++) {
+            HOST_TEST_CHK(HostTestFind(TestOut, TestFig[n][i].Line));
+        }
+    }
+    span = TestTs[1] - TestTs[0];
+    for (i = 0u; i < TEST_TASKS; i++) {
+        snprintf(line, sizeof(line), "  %-4u %-16s %6.2f%% of the time, %u switches in, %u preemptions\n",
+                 (unsigned)TestWorkTCB[i].Prio, TestWorkTCB[i].NamePtr,
+                 100.0 * (TestFig[1][i].Cycles - TestFig[0][i].Cycles) / span,
+                 (unsigned)(TestFig[1][i].SwIn    - TestFig[0][i].SwIn),
+                 (unsigned)(TestFig[1][i].Preempt - TestFig[0][i].Preempt));
+        HOST_TEST_CHK(HostTestFind(TestOut, line));
+    }
+    HOST_TEST_CHK(TestFig[1][0].SwIn    - TestFig[0][0].SwIn    ==      TEST_ROUNDS);
+    HOST_TEST_CHK(TestFig[1][1].SwIn    - TestFig[0][1].SwIn    == 2u * TEST_ROUNDS);
+    HOST_TEST_CHK(TestFig[1][1].Preempt - TestFig[0][1].Preempt ==      TEST_ROUNDS);
+    printf("prof decode: %u records, %u bytes, decoded as the kernel reported them\n",
+           (unsigned)TEST_RECS, (unsigned)size);
+    HostTestPass("prof_decode");
+}
+
+
+int  main (void)
+{
+    OS_ERR      err;
+    CPU_INT32U  i;
+
+
+    HostTestInit();
+    for (i = 0u; i < TEST_TASKS; i++) {
+        OSSemCreate(&TestSem[i], "Prof Sem", 0u, &err);
+        HOST_TEST_CHK(err == OS_ERR_NONE);
+    }
+    HostTestTaskCreate(&TestTCB,        "Test Task", TestTask, (void *)0,           10u, &TestStk[0],        512u);
+    HostTestTaskCreate(&TestWorkTCB[0], "Prof Hi",   TestWork, (void *)(CPU_ADDR)0,  8u, &TestWorkStk[0][0], 256u);
+    HostTestTaskCreate(&TestWorkTCB[1], "Prof Lo",   TestWork, (void *)(CPU_ADDR)1, 12u, &TestWorkStk[1][0], 256u);
+    HostTestStart();
+    return (1);
+}
@@ -0,0 +1,289 @@
+/*
+*********************************************************************************************************
+*                                HOST TEST: SCHEDULE ANALYSIS ROUND TRIP
+*
+* Filename : sched_analyze.c
+*
+* Note(s)  : (1) Task A runs every TEST_A_DLY ticks, paced by its own OSTimeDly(). Task B runs each time
+*                the test task posts its semaphore, every TEST_B_DLY ticks. Over TEST_ROUNDS posts the
+*                run is recorded both ways tools/os_sched_analyze.py reads: as two profiler records,
+*                taken before and after, and as an OSTraceRam dump.
+*
+*            (2) The script finds the tasks the way it finds the board's: from the OSTaskCreate() calls
+*                in a source directory, written here with the same entry functions, and from a header
+*                that sets their priorities. The cfg gives A a deadline it meets and B one it cannot.
+*
+*            (3) From the profiler records, B's time per run and its period are averages the test works
+*                out from the kernel's own figures, as the script must: cycles over runs, and the time
+*                between the records over runs. A's period is its OSTimeDly(), read from the source.
+*                A must be reported ok and B as CAN MISS, and the script must exit with 1.
+*
+*            (4) From the trace, B's time per run is its longest run and its period the shortest time
+*                between releases, and B is seen responding. Those are only checked to be reported as
+*                such, as working them out again would be the script over again. A's verdict is not
+*                checked: on a loaded host SIGALRM comes late and the ticks missed follow at once, so the
+*                shortest time between two releases of the tick task can be a few us, and every task
+*                under it then misses.
+*
+*            (5) Built with the SIGALRM tick (sched_analyze_VIRTUAL = 0). The script takes a tick to be
+*                1/OS_CFG_TICK_RATE_HZ of the recording's time, which the virtual tick does not keep.
+*********************************************************************************************************
+*/
+
+#include  <string.h>
+#include  <sys/stat.h>
+#include  "host_test.h"
+
+
+#define  TEST_ROUNDS               10u
+#define  TEST_A_PRIO                8u
+#define  TEST_B_PRIO                9u
+#define  TEST_A_DLY                 2u
+#define  TEST_B_DLY                 3u
+#define  TEST_WORK                500u                          /* Loops of work per run                */
+#define  TEST_CLK_MHZ             180.0                         /* The script's default -f              */
+#define  TEST_TASKS_MAX            16u
+#define  TEST_REC_SIZE           (OS_PROF_HDR_SIZE + TEST_TASKS_MAX * OS_PROF_TASK_SIZE)
+#define  TEST_LINE_SIZE           256u
+#define  TEST_PREFIX_SIZE         160u
+
+#define  TEST_DIR                HOST_TEST_OUT "sched_analyze_src"
+#define  TEST_CFG                TEST_DIR "/sched_analyze.cfg"
+#define  TEST_PROF               HOST_TEST_OUT "sched_analyze.prof"
+#define  TEST_TRACE              HOST_TEST_OUT "sched_analyze.trace"
+#define  TEST_ARGS               " -c " TEST_CFG " -s " TEST_DIR
+
+
+static  const  char  TestSrc[] =                                /* See Note #2                          */
+    "#include  \"app_sched.h\"\n"
+    "\n"
+    "static  void  TestA (void  *p_arg)\n"
+    "{\n"
+    "    OS_ERR  err;\n"
+    "\n"
+    "\n"
+    "    while (DEF_ON) {\n"
+    "        TestWork();\n"
+    "        OSTimeDly(TEST_A_DLY, OS_OPT_TIME_DLY, &err);\n"
+    "    }\n"
+    "}\n"
+    "\n"
+    "static  void  TestB (void  *p_arg)\n"
+    "{\n"
+    "    OS_ERR  err;\n"
+    "\n"
+    "\n"
+    "    while (DEF_ON) {\n"
+    "        (void)OSTaskSemPend(0u, OS_OPT_PEND_BLOCKING, (CPU_TS *)0, &err);\n"
+    "        TestWork();\n"
+    "    }\n"
+    "}\n"
+    "\n"
+    "void  AppTaskCreate (void)\n"
+    "{\n"
+    "    OS_ERR  err;\n"
+    "\n"
+    "\n"
+    "    OSTaskCreate(&TestATCB, \"Sched A\", TestA, (void *)0, APP_CFG_TEST_A_PRIO, &TestAStk[0], 25u, 256u,\n"
+    "                 0u, 0u, (void *)0, OS_OPT_TASK_STK_CHK, &err);\n"
+    "    OSTaskCreate(&TestBTCB, \"Sched B\", TestB, (void *)0, APP_CFG_TEST_B_PRIO, &TestBStk[0], 25u, 256u,\n"
+    "                 0u, 0u, (void *)0, OS_OPT_TASK_STK_CHK, &err);\n"
+    "}\n";
+
+static  const  char  TestCfg[] =                                /* See Note #2                          */
+    "deadline TestA 1000\n"
+    "deadline TestB 1/1000000\n";
+
+static  volatile CPU_INT32U  TestSink;
+static  OS_TCB               TestTCB;
+static  CPU_STK              TestStk[512];
+static  OS_TCB               TestATCB;
+static  CPU_STK              TestAStk[256];
+static  OS_TCB               TestBTCB;
+static  CPU_STK              TestBStk[256];
+static  CPU_INT08U           TestRec[2u * TEST_REC_SIZE];
+static  char                 TestOut[16384];
+
+
+static  void  TestWork (void)
+{
+    CPU_INT32U  i;
+
+
+    for (i = 0u; i < TEST_WORK; i++) {
+        TestSink++;
+    }
+}
+
+
+static  void  TestA (void  *p_arg)
+{
+    OS_ERR  err;
+
+
+    (void)p_arg;
+    while (DEF_ON) {
+        TestWork();
+        OSTimeDly(TEST_A_DLY, OS_OPT_TIME_DLY, &err);
+    }
+}
+
+
+static  void  TestB (void  *p_arg)
+{
+    OS_ERR  err;
+
+
+    (void)p_arg;
+    while (DEF_ON) {
+        (void)OSTaskSemPend(0u, OS_OPT_PEND_BLOCKING, (CPU_TS *)0, &err);
+        HOST_TEST_CHK(err == OS_ERR_NONE);
+        TestWork();
+    }
+}
+
+
+static  void  TestRow (const char  *p_prefix,                   /* Line of the report 'p_prefix' starts */
+                       char        *p_line)
+{
+    const char  *p_row;
+    const char  *p_end;
+
+
+    p_row = strstr(TestOut, p_prefix);
+    if (p_row == (char *)0) {
+        HOST_TEST_CHK(HostTestFind(TestOut, p_prefix));
+    }
+    p_end = strchr(p_row, '\n');
+    HOST_TEST_CHK((p_end != (char *)0) && ((CPU_SIZE_T)(p_end - p_row) < TEST_LINE_SIZE));
+    (void)memcpy(p_line, p_row, (CPU_SIZE_T)(p_end - p_row));
+    p_line[p_end - p_row] = '\0';
+}
+
+
+static  void  TestPrefix (char        *p_prefix,                /* Report columns up to the deadline    */
+                          CPU_INT32U   prio,
+                          const char  *p_name,
+                          const char  *p_entry,
+                          const char  *p_run,
+                          const char  *p_period,
+                          const char  *p_dline)
+{
+    snprintf(p_prefix, TEST_PREFIX_SIZE, "  %-4u %-20s %-24s %12s %12s %10s ",
+             (unsigned)prio, p_name, p_entry, p_run, p_period, p_dline);
+}
+
+
+static  CPU_SIZE_T  TestProf (CPU_INT08U  *p_rec,               /* Snapshot, and B's figures in it      */
+                              CPU_INT32U  *p_ts,
+                              CPU_INT32U  *p_cycles,
+                              CPU_INT32U  *p_runs)
+{
+    OS_ERR      err;
+    CPU_SIZE_T  size;
+
+
+    size = OSProfSnapshot(p_rec, TEST_REC_SIZE, &err);
+    HOST_TEST_CHK((err == OS_ERR_NONE) && (size > 0u) && (size <= TEST_REC_SIZE));
+    HOST_TEST_CHK(TestBTCB.TaskState == OS_TASK_STATE_PEND);
+    (void)memcpy(p_ts, &p_rec[12], sizeof(CPU_INT32U));         /* Timestamp, after magic, version, qty */
+    *p_cycles = (CPU_INT32U)TestBTCB.ProfCycles;
+    *p_runs   = (CPU_INT32U)(TestBTCB.CtxSwCtr - TestBTCB.ProfPreemptCtr);
+    return (size);
+}
+
+
+static  void  TestTask (void  *p_arg)
+{
+    OS_ERR      err;
+    CPU_ERR     cpu_err;
+    char        prefix[TEST_PREFIX_SIZE];
+    char        line[TEST_LINE_SIZE];
+    char        run[32];
+    char        period[32];
+    char        a_period[32];
+    CPU_INT32U  cycles[2];
+    CPU_INT32U  runs[2];
+    CPU_INT32U  ts[2];
+    CPU_SIZE_T  size;
+    CPU_INT32U  n;
+    double      freq;
+    double      us;
+    CPU_INT32U  i;
+
+
+    (void)p_arg;
+    OS_CPU_SysTickInitFreq(0u);
+
+    OSTraceRamStop();                                           /* See Note #1                          */
+    OSTraceRamClear();
+    OSTraceRamStart(OS_TRACE_RAM_MODE_RING);
+    size = TestProf(&TestRec[0], &ts[0], &cycles[0], &runs[0]);
+    for (i = 0u; i < TEST_ROUNDS; i++) {
+        (void)OSTaskSemPost(&TestBTCB, OS_OPT_POST_NONE, &err);
+        HOST_TEST_CHK(err == OS_ERR_NONE);
+        OSTimeDly(TEST_B_DLY, OS_OPT_TIME_DLY, &err);
+    }
+    size += TestProf(&TestRec[size], &ts[1], &cycles[1], &runs[1]);
+    OSTraceRamStop();
+    HostTestFileWrite(TEST_PROF, &TestRec[0], size);
+    HostTestFileWrite(TEST_TRACE, &OSTraceRam, sizeof(OSTraceRam));
+
+    (void)mkdir(TEST_DIR, 0777);                                /* See Note #2                          */
+    HostTestFileWrite(TEST_DIR "/app_sched.c", TestSrc, sizeof(TestSrc) - 1u);
+    snprintf(line, sizeof(line), "#define  APP_CFG_TEST_A_PRIO  %uu\n#define  APP_CFG_TEST_B_PRIO  %uu\n"
+             "#define  TEST_A_DLY           %uu\n", (unsigned)TEST_A_PRIO, (unsigned)TEST_B_PRIO,
+             (unsigned)TEST_A_DLY);
+    HostTestFileWrite(TEST_DIR "/app_sched.h", line, strlen(line));
+    HostTestFileWrite(TEST_CFG, TestCfg, sizeof(TestCfg) - 1u);
+
+                                                                /* ----------- PROFILER (Note #3) ----- */
+    HOST_TEST_CHK(HostTestTool("os_sched_analyze.py -p " TEST_PROF TEST_ARGS, &TestOut[0], sizeof(TestOut)) == 1);
+    freq = (double)CPU_TS_TmrFreqGet(&cpu_err);
+    us   = 1e6 / freq;                                          /* As in the script's main()            */
+    snprintf(line, sizeof(line), "clock %.0f MHz, recording at %.0f MHz, tick %.0f us\n",
+             TEST_CLK_MHZ, freq / 1e6, 1e6 / OS_CFG_TICK_RATE_HZ);
+    HOST_TEST_CHK(HostTestFind(TestOut, line));
+
+    n = runs[1] - runs[0];
+    HOST_TEST_CHK(n == TEST_ROUNDS);
+    snprintf(run,    sizeof(run),    "%.1f avg", (double)(cycles[1] - cycles[0]) / n * (us * freq / (TEST_CLK_MHZ * 1e6)));
+    snprintf(period, sizeof(period), "%.3f avg", (double)(ts[1] - ts[0]) / n * us / 1e3);
+    TestPrefix(prefix, TEST_B_PRIO, "Sched B", "TestB", run, period, "0.000");
+    snprintf(line, sizeof(line), "%s%10s %10s  %s\n", prefix, "-", "-", "CAN MISS");
+    HOST_TEST_CHK(HostTestFind(TestOut, line));
+
+    snprintf(a_period, sizeof(a_period), "%.3f dly", TEST_A_DLY * (1e6 / OS_CFG_TICK_RATE_HZ) / 1e3);
+    snprintf(prefix, sizeof(prefix), "  %-4u %-20s %-24s ", (unsigned)TEST_A_PRIO, "Sched A", "TestA");
+    TestRow(prefix, line);
+    HOST_TEST_CHK(strstr(line, " avg ") != (char *)0);
+    HOST_TEST_CHK(HostTestFind(line, a_period));
+    HOST_TEST_CHK(HostTestFind(line, "   1000.000 "));
+    HOST_TEST_CHK(HostTestFind(line, "  ok"));
+                                                                /* ----------- TRACE (Note #4) -------- */
+    HOST_TEST_CHK(HostTestTool("os_sched_analyze.py -t " TEST_TRACE TEST_ARGS, &TestOut[0], sizeof(TestOut)) == 1);
+    snprintf(prefix, sizeof(prefix), "  %-4u %-20s %-24s ", (unsigned)TEST_B_PRIO, "Sched B", "TestB");
+    TestRow(prefix, line);
+    HOST_TEST_CHK(HostTestFind(line, " max "));
+    HOST_TEST_CHK(HostTestFind(line, " min "));
+    HOST_TEST_CHK(HostTestFind(line, "  CAN MISS"));
+    HOST_TEST_CHK(line[strlen(line) - strlen("  CAN MISS") - 1u] != '-');   /* B seen responding         */
+    snprintf(prefix, sizeof(prefix), "  %-4u %-20s %-24s ", (unsigned)TEST_A_PRIO, "Sched A", "TestA");
+    TestRow(prefix, line);
+    HOST_TEST_CHK(HostTestFind(line, " max "));
+    HOST_TEST_CHK(HostTestFind(line, a_period));
+
+    printf("sched analyze: B %s per run, %s period, from %u runs\n", run, period, (unsigned)n);
+    HostTestPass("sched_analyze");
+}
+
+
+int  main (void)
+{
+    HostTestInit();
+    HostTestTaskCreate(&TestTCB,  "Test Task", TestTask, (void *)0, 10u,          &TestStk[0],  512u);
+    HostTestTaskCreate(&TestATCB, "Sched A",   TestA,    (void *)0, TEST_A_PRIO,  &TestAStk[0], 256u);
+    HostTestTaskCreate(&TestBTCB, "Sched B",   TestB,    (void *)0, TEST_B_PRIO,  &TestBStk[0], 256u);
+    HostTestStart();
+    return (1);
+}
@@ -0,0 +1,246 @@
+/*
+*********************************************************************************************************
+*                                 HOST TEST: STACK ANALYSIS ROUND TRIP
+*
+* Filename : stk_analyze.c
+*
+* Note(s)  : (1) This file is built with -fstack-usage -fcallgraph-info=su (see the Makefile), so GCC
+*                writes the frames and the call graph of its functions to TEST_SU and TEST_CI, as the
+*                board's build does for tools/os_stk_analyze.py. It is built at -O0 so that none of
+*                the functions below is inlined or cloned under another name.
+*
+*            (2) TestDeep() calls TestShallow() and TestMid(), and TestMid() calls TestLeaf() and,
+*                through a pointer, TestFar(). The cfg written here resolves that call, so the deepest
+*                path is TestDeep(), TestMid(), TestFar(). The task is found the way the board's are,
+*                from an OSTaskCreate() call in a source directory whose header sets its size.
+*
+*            (3) TestRec() calls itself. Its task is listed in the cfg, and must be reported as not
+*                bounded: the script exits with 1 and leaves its size out of the header.
+*
+*            (4) The expected depth is summed here from the frames GCC wrote to TEST_SU, and the
+*                overhead from the project's os_cfg.h (--no-fp, as for an image without the FPU), which
+*                the script reads too. Both tasks are run, so the graph is of code that is called.
+*********************************************************************************************************
+*/
+
+#include  <string.h>
+#include  <sys/stat.h>
+#include  "host_test.h"
+
+
+#define  TEST_DIR                HOST_TEST_OUT "stk_analyze_src"
+#define  TEST_SU                 HOST_TEST_OUT "stk_analyze-stk_analyze.su"
+#define  TEST_CI                 HOST_TEST_OUT "stk_analyze-stk_analyze.ci"
+#define  TEST_CFG                TEST_DIR "/stk_analyze.cfg"
+#define  TEST_HDR                TEST_DIR "/app_stk_cfg.h"
+#define  TEST_MARGIN               10u
+#define  TEST_DEEP_SIZE           512u                          /* 'now' size of the deep task          */
+#define  TEST_REC_DEPTH             4u
+#define  TEST_LINE_SIZE           160u
+
+#define  TEST_SW_FRAME             36u                          /* As in os_stk_analyze.py              */
+#define  TEST_HW_FRAME             36u
+#define  TEST_STK_ALIGN             8u
+
+
+static  const  char  TestSrc[] =                                /* See Note #2                          */
+    "#include  \"app_stk.h\"\n"
+    "\n"
+    "static  OS_TCB   TestDeepTCB;\n"
+    "static  CPU_STK  TestDeepStk[APP_CFG_TEST_DEEP_STK_SIZE];\n"
+    "\n"
+    "void  AppTaskCreate (void)\n"
+    "{\n"
+    "    OS_ERR  err;\n"
+    "\n"
+    "\n"
+    "    OSTaskCreate(&TestDeepTCB, \"Stk Deep\", TestDeep, (void *)0, 8u,\n"
+    "                 &TestDeepStk[0], APP_CFG_TEST_DEEP_STK_SIZE / 10u, APP_CFG_TEST_DEEP_STK_SIZE,\n"
+    "                 0u, 0u, (void *)0, OS_OPT_TASK_STK_CHK, &err);\n"
+    "}\n";
+
+static  const  char  TestCfg[] =                                /* See Notes #2 and #3                  */
+    "TestMid: TestFar\n"
+    "task TestRec APP_CFG_TEST_REC_STK_SIZE\n";
+
+static  OS_TCB               TestTCB;
+static  CPU_STK              TestStk[512];
+static  OS_TCB               TestDeepTCB;
+static  CPU_STK              TestDeepStk[256];
+static  OS_TCB               TestRecTCB;
+static  CPU_STK              TestRecStk[256];
+static  volatile CPU_INT32U  TestSink;
+static  char                 TestOut[16384];
+static  char                 TestFile[4096];
+
+
+static  void  TestLeaf (CPU_INT32U  n)
+{
+    volatile CPU_INT32U  buf[16];
+
+
+    buf[n % 16u] = n;
+    TestSink    += buf[n % 16u];
+}
+
+
+static  void  TestFar (CPU_INT32U  n)
+{
+    volatile CPU_INT32U  buf[64];
+
+
+    buf[n % 64u] = n;
+    TestSink    += buf[n % 64u];
+}
+
+
+static  void  (*volatile TestFarPtr)(CPU_INT32U) = TestFar;
+
+
+static  void  TestMid (CPU_INT32U  n)
+{
+    volatile CPU_INT32U  buf[8];
+
+
+    buf[n % 8u] = n;
+    TestLeaf(buf[n % 8u]);
+    TestFarPtr(n);                                              /* Resolved by the cfg                  */
+}
+
+
+static  void  TestShallow (CPU_INT32U  n)
+{
+    TestSink += n;
+}
+
+
+static  void  TestDeep (void  *p_arg)
+{
+    (void)p_arg;
+    TestShallow(1u);
+    TestMid(2u);
+}
+
+
+static  void  TestRec (void  *p_arg)
+{
+    CPU_INT32U  n;
+
+
+    n = (CPU_INT32U)(CPU_ADDR)p_arg;
+    TestSink++;
+    if (n > 1u) {
+        TestRec((void *)(CPU_ADDR)(n - 1u));
+    }
+}
+
+
+static  CPU_INT32U  TestFrame (const char  *p_name)             /* Frame GCC wrote for 'p_name'         */
+{
+    char         pattern[64];
+    const char  *p_line;
+    unsigned     size;
+
+
+    snprintf(pattern, sizeof(pattern), ":%s\t", p_name);        /* file.c:line:col:name<TAB>bytes<TAB>  */
+    p_line = strstr(TestFile, pattern);
+    HOST_TEST_CHK(p_line != (char *)0);
+    HOST_TEST_CHK(sscanf(p_line + strlen(pattern), "%u", &size) == 1);
+    return ((CPU_INT32U)size);
+}
+
+
+static  CPU_INT32U  TestWords (CPU_INT32U  nbytes)              /* As words() in os_stk_analyze.py      */
+{
+    return ((nbytes + TEST_STK_ALIGN - 1u) / TEST_STK_ALIGN * (TEST_STK_ALIGN / sizeof(CPU_INT32U)));
+}
+
+
+static  void  TestRead (const char  *p_path)
+{
+    FILE        *p_file;
+    CPU_SIZE_T   len;
+
+
+    p_file = fopen(p_path, "r");
+    HOST_TEST_CHK(p_file != (FILE *)0);
+    len = fread(&TestFile[0], 1u, sizeof(TestFile) - 1u, p_file);
+    HOST_TEST_CHK(len < sizeof(TestFile) - 1u);
+    TestFile[len] = '\0';
+    (void)fclose(p_file);
+}
+
+
+static  void  TestTask (void  *p_arg)
+{
+    char        line[TEST_LINE_SIZE];
+    CPU_INT32U  overhead;
+    CPU_INT32U  deep;
+    CPU_INT32U  far;
+    CPU_INT32U  rec;
+
+
+    (void)p_arg;
+    OS_CPU_SysTickInitFreq(0u);
+    HOST_TEST_CHK(TestSink == 1u + 2u + 2u + TEST_REC_DEPTH);   /* Both tasks ran and returned          */
+
+    (void)mkdir(TEST_DIR, 0777);                                /* See Notes #2 and #3                  */
+    HostTestFileWrite(TEST_DIR "/app_stk.c", TestSrc, sizeof(TestSrc) - 1u);
+    snprintf(line, sizeof(line), "#define  APP_CFG_TEST_DEEP_STK_SIZE  %uu\n", (unsigned)TEST_DEEP_SIZE);
+    HostTestFileWrite(TEST_DIR "/app_stk.h", line, strlen(line));
+    HostTestFileWrite(TEST_CFG, TestCfg, sizeof(TestCfg) - 1u);
+
+    HOST_TEST_CHK(HostTestTool("os_stk_analyze.py " TEST_SU " " TEST_CI " -c " TEST_CFG " -s " TEST_DIR
+                               " -o " TEST_HDR " --no-fp", &TestOut[0], sizeof(TestOut)) == 1);
+
+    overhead = TEST_SW_FRAME + TEST_HW_FRAME;                   /* See Note #4                          */
+#if (OS_CFG_STK_GUARD_EN == DEF_ENABLED)
+    overhead += 2u * OS_STK_GUARD_SIZE - sizeof(CPU_STK);
+#endif
+#if (OS_CFG_TASK_STK_REDZONE_EN == DEF_ENABLED)
+    overhead += OS_CFG_TASK_STK_REDZONE_DEPTH * sizeof(CPU_STK);
+#endif
+    TestRead(TEST_SU);
+    far  = TestFrame("TestFar");
+    HOST_TEST_CHK(far > TestFrame("TestLeaf"));
+    HOST_TEST_CHK(TestFrame("TestMid") + far > TestFrame("TestShallow"));
+    deep = TestFrame("TestDeep") + TestFrame("TestMid") + far;
+    rec  = TestWords((deep + overhead) * (100u + TEST_MARGIN) / 100u);
+
+    snprintf(line, sizeof(line), "overhead %u bytes per task, margin %u%%\n",
+             (unsigned)overhead, (unsigned)TEST_MARGIN);
+    HOST_TEST_CHK(HostTestFind(TestOut, line));
+    snprintf(line, sizeof(line), "%-22s %-34s %6u %6u %6u\n", "TestDeep", "APP_CFG_TEST_DEEP_STK_SIZE",
+             (unsigned)deep, (unsigned)TEST_DEEP_SIZE, (unsigned)rec);
+    HOST_TEST_CHK(HostTestFind(TestOut, line));
+    snprintf(line, sizeof(line), "%-22s %-34s %6u %6s %6u  NOT BOUNDED\n", "TestRec",
+             "APP_CFG_TEST_REC_STK_SIZE", (unsigned)TestFrame("TestRec"), "?",
+             (unsigned)TestWords((TestFrame("TestRec") + overhead) * (100u + TEST_MARGIN) / 100u));
+    HOST_TEST_CHK(HostTestFind(TestOut, line));
+    HOST_TEST_CHK(HostTestFind(TestOut, "    recursion through TestRec -> TestRec\n"));
+    snprintf(line, sizeof(line), "%d bytes of task stack saved by the recommended sizes\n",
+             (int)((TEST_DEEP_SIZE - rec) * sizeof(CPU_STK)));
+    HOST_TEST_CHK(HostTestFind(TestOut, line));
+
+    TestRead(TEST_HDR);
+    snprintf(line, sizeof(line), "#define %-36s %4uu   /* %s, %u bytes deep */\n",
+             "APP_CFG_TEST_DEEP_STK_SIZE", (unsigned)rec, "TestDeep", (unsigned)deep);
+    HOST_TEST_CHK(HostTestFind(TestFile, line));
+    HOST_TEST_CHK(HostTestFind(TestFile, "/* APP_CFG_TEST_REC_STK_SIZE: not bounded, see os_stk_analyze.py */\n"));
+    HOST_TEST_CHK(strstr(TestFile, "#define APP_CFG_TEST_REC_STK_SIZE") == (char *)0);
+
+    printf("stk analyze: TestDeep %u bytes deep, %u bytes of overhead, %u words recommended\n",
+           (unsigned)deep, (unsigned)overhead, (unsigned)rec);
+    HostTestPass("stk_analyze");
+}
+
+
+int  main (void)
+{
+    HostTestInit();
+    HostTestTaskCreate(&TestTCB,     "Test Task", TestTask, (void *)0,                        10u, &TestStk[0],     512u);
+    HostTestTaskCreate(&TestDeepTCB, "Stk Deep",  TestDeep, (void *)0,                         8u, &TestDeepStk[0], 256u);
+    HostTestTaskCreate(&TestRecTCB,  "Stk Rec",   TestRec,  (void *)(CPU_ADDR)TEST_REC_DEPTH,  9u, &TestRecStk[0],  256u);
+    HostTestStart();
+    return (1);
+}
@@ -0,0 +1,204 @@
+/*
+*********************************************************************************************************
+*                                        HOST TEST: STACK GUARD
+*
+* Filename : stk_guard.c
+*
+* Note(s)  : (1) A task that runs off its host stack must fault in its guard page and reach the
+*                application hook with its own OS_TCB, while another task is also running. A stray
+*                fault outside every guard page must not be reported and must end the program with
+*                SIGSEGV. Each case runs in a child process, since neither returns.
+*
+*            (2) The guard of a stack must be aligned on OS_STK_GUARD_SIZE inside the stack, and a stack
+*                too small for a guard gets none. .StkUsedMax must keep the deepest stack pointer saved
+*                at a switch and ignore one outside the stack.
+*
+*            (3) The statistic task must take .StkUsed and .StkFree from OSTaskStkChk(). The test task
+*                marks its declared stack 200 elements deep between two switches, which .StkUsedMax does
+*                not see and the scan does.
+*********************************************************************************************************
+*/
+
+#include  <signal.h>
+#include  <string.h>
+#include  <sys/wait.h>
+#include  <unistd.h>
+#include  "host_test.h"
+
+
+#define  TEST_STK_SIZE           512u
+#define  TEST_EXIT_HIT            42
+#define  TEST_DEEP                200u
+
+
+static  OS_TCB      TestTCB;
+static  CPU_STK     TestStk[TEST_STK_SIZE];
+static  OS_TCB      TestOvfTCB;
+static  CPU_STK     TestOvfStk[TEST_STK_SIZE];
+static  CPU_STK     TestFakeStk[256];
+static  volatile CPU_INT32U  *volatile  TestStrayPtr = (volatile CPU_INT32U *)16;
+
+
+static  void  TestGuardHit (OS_TCB  *p_tcb)
+{
+    HOST_TEST_CHK(p_tcb == &TestOvfTCB);
+    HOST_TEST_CHK(OSTCBCurPtr == &TestOvfTCB);
+    _exit(TEST_EXIT_HIT);
+}
+
+
+static  CPU_INT32U  TestRecurse (CPU_INT32U  depth)
+{
+    volatile CPU_INT08U  frame[256];
+
+
+    frame[0] = (CPU_INT08U)depth;
+    if (depth == DEF_INT_32U_MAX_VAL) {                         /* Never, the guard page comes first    */
+        return (0u);
+    }
+    return (TestRecurse(depth + 1u) + frame[0]);                /* Not a tail call, every frame stays   */
+}
+
+
+static  void  TestOvfTask (void  *p_arg)
+{
+    (void)p_arg;
+    if (OSTCBCurPtr == &TestOvfTCB) {
+        (void)TestRecurse(0u);
+    }
+}
+
+
+static  void  TestStrayTask (void  *p_arg)
+{
+    (void)p_arg;
+    *TestStrayPtr = 0u;                                         /* Not in any guard page                */
+}
+
+
+static  void  TestOtherTask (void  *p_arg)
+{
+    OS_ERR  err;
+
+
+    (void)p_arg;
+    OS_CPU_SysTickInitFreq(0u);
+    while (DEF_ON) {
+        OSTimeDly(1u, OS_OPT_TIME_DLY, &err);
+    }
+}
+
+
+static  int  TestChild (OS_TASK_PTR  p_task)
+{
+    pid_t  pid;
+    int    status;
+
+
+    fflush(stdout);
+    pid = fork();
+    HOST_TEST_CHK(pid >= 0);
+    if (pid == 0) {
+        HostTestInit();
+        OS_AppStkGuardHitHookPtr = TestGuardHit;
+        HostTestTaskCreate(&TestTCB,    "Other Task",    TestOtherTask, (void *)0, 4u,
+                           &TestStk[0], TEST_STK_SIZE);
+        HostTestTaskCreate(&TestOvfTCB, "Overflow Task", p_task,        (void *)0, 5u,
+                           &TestOvfStk[0], TEST_STK_SIZE);
+        HostTestStart();
+        _exit(1);
+    }
+    HOST_TEST_CHK(waitpid(pid, &status, 0) == pid);
+    return (status);
+}
+
+
+static  void  TestMark (void)
+{
+    OS_TCB   fake;
+    OS_TCB  *p_cur;
+    OS_TCB  *p_high;
+    CPU_SR_ALLOC();
+
+
+    (void)memset(&fake, 0, sizeof(fake));
+    fake.StkBasePtr = &TestFakeStk[1];                          /* Not aligned on the guard size        */
+    fake.StkSize    = 255u;
+    fake.StkPtr     = &TestFakeStk[256 - 16];
+    OS_StkGuardTaskInit(&fake);
+    HOST_TEST_CHK(fake.StkGuardPtr != (CPU_STK *)0);
+    HOST_TEST_CHK(((CPU_ADDR)fake.StkGuardPtr % OS_STK_GUARD_SIZE) == 0u);
+    HOST_TEST_CHK(fake.StkGuardPtr >= fake.StkBasePtr);
+    HOST_TEST_CHK((CPU_ADDR)fake.StkGuardPtr < (CPU_ADDR)fake.StkBasePtr + OS_STK_GUARD_SIZE);
+    HOST_TEST_CHK(fake.StkUsedMax == 16u);
+
+    CPU_CRITICAL_ENTER();
+    p_cur           = OSTCBCurPtr;
+    p_high          = OSTCBHighRdyPtr;
+    OSTCBCurPtr     = &fake;
+    OSTCBHighRdyPtr = &fake;
+    fake.StkPtr     = &TestFakeStk[100];
+    OS_StkGuardTaskSw();
+    HOST_TEST_CHK(fake.StkUsedMax == 156u);
+    fake.StkPtr     = &TestFakeStk[200];                        /* Shallower, the mark stays            */
+    OS_StkGuardTaskSw();
+    HOST_TEST_CHK(fake.StkUsedMax == 156u);
+    fake.StkPtr     = (CPU_STK *)0;                             /* Deleted task, outside its stack      */
+    OS_StkGuardTaskSw();
+    HOST_TEST_CHK(fake.StkUsedMax == 156u);
+    OSTCBCurPtr     = p_cur;
+    OSTCBHighRdyPtr = p_high;
+    CPU_CRITICAL_EXIT();
+
+    fake.StkBasePtr = &TestFakeStk[0];                          /* Guard would take over a quarter      */
+    fake.StkSize    = (OS_STK_GUARD_SIZE / sizeof(CPU_STK)) * 3u;
+    fake.StkPtr     = &TestFakeStk[fake.StkSize - 1u];
+    OS_StkGuardTaskInit(&fake);
+    HOST_TEST_CHK(fake.StkGuardPtr == (CPU_STK *)0);
+}
+
+
+static  void  TestTask (void  *p_arg)
+{
+    OS_ERR        err;
+    CPU_STK_SIZE  i;
+    CPU_STK_SIZE  mark;
+
+
+    (void)p_arg;
+    OS_CPU_SysTickInitFreq(0u);
+    OSStatTaskCPUUsageInit(&err);
+    HOST_TEST_CHK(err == OS_ERR_NONE);
+    TestMark();
+
+    mark = TestTCB.StkUsedMax;
+    for (i = TEST_STK_SIZE - TEST_DEEP; i < TEST_STK_SIZE - mark; i++) {
+        TestStk[i] = (CPU_STK)0xA5A5A5A5u;                      /* Peak between switches (Note #3)      */
+    }
+    OSTimeDly(3u * OS_CFG_TICK_RATE_HZ / OS_CFG_STAT_TASK_RATE_HZ, OS_OPT_TIME_DLY, &err);
+    HOST_TEST_CHK(err == OS_ERR_NONE);
+    HOST_TEST_CHK(TestTCB.StkUsedMax < TEST_DEEP);
+    HOST_TEST_CHK(TestTCB.StkUsed == TEST_DEEP);
+    HOST_TEST_CHK(TestTCB.StkFree == TEST_STK_SIZE - TEST_DEEP);
+    printf("guard hit=ok stray=ok mark=%u used=%u free=%u\n",
+           (unsigned)TestTCB.StkUsedMax, (unsigned)TestTCB.StkUsed, (unsigned)TestTCB.StkFree);
+    HostTestPass("stk_guard");
+}
+
+
+int  main (void)
+{
+    int  status;
+
+
+    status = TestChild(TestOvfTask);                            /* Note #1                              */
+    HOST_TEST_CHK(WIFEXITED(status) && (WEXITSTATUS(status) == TEST_EXIT_HIT));
+    status = TestChild(TestStrayTask);
+    HOST_TEST_CHK(WIFSIGNALED(status) && (WTERMSIG(status) == SIGSEGV));
+
+    HostTestInit();
+    (void)memset(&TestStk[0], 0, sizeof(TestStk));
+    HostTestTaskCreate(&TestTCB, "Test Task", TestTask, (void *)0, 4u, &TestStk[0], TEST_STK_SIZE);
+    HostTestStart();
+    return (1);
+}
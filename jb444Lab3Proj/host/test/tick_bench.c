@@ -0,0 +1,193 @@
+/*
+*********************************************************************************************************
+*                              HOST BENCHMARK: TICK LIST UPDATE, INSERT AND REMOVE
+*
+* Filename : tick_bench.c
+*
+* Note(s)  : (1) Usage: tick_bench <tasks>. Each task delays for a random 1 to 35000 ticks, the longest
+*                step the board's dynamic tick takes (bspOSTickMax). The run lasts 2M ticks.
+*
+*            (2) OSTickTaskTimeMax is the longest OS_TickTask() list update, in ns on the host. It runs
+*                with interrupts disabled, so it is the figure that has to stay short as tasks are
+*                added and as steps get longer. A sampler task reads and clears it every 10000 ticks.
+*                The median of those maxima is printed with the overall one, which host scheduling
+*                noise can inflate.
+*
+*            (3) After the run the sampler takes 100000 delayed tasks at random out of the list with
+*                OS_TickListRemove() and puts them back with OS_TickListInsertDly() for a new random
+*                delay. These are the list operations OSTimeDlyResume() and OSTimeDly() do with
+*                interrupts disabled. Each is timed on its own, and the cost of reading the timestamp,
+*                measured the same way, is taken off the averages.
+*
+*            (4) Build with OS_CFG_TICK_WHEEL_EN disabled (tick_bench_list) for the delta list.
+*********************************************************************************************************
+*/
+
+#include  "host_test.h"
+
+
+#define  TEST_TASKS_MAX       1000u
+#define  TEST_TICKS        2000000u
+#define  TEST_DLY_MAX        35000u
+#define  TEST_WIN_TICKS      10000u
+#define  TEST_WINS          (TEST_TICKS / TEST_WIN_TICKS)
+#define  TEST_OPS            100000u
+
+
+static  OS_TCB      TestTCB[TEST_TASKS_MAX];
+static  CPU_STK     TestStk[TEST_TASKS_MAX][256];
+static  CPU_INT32U  TestTasks;
+static  CPU_INT32U  TestWakes;
+static  OS_TCB      TestSamplerTCB;
+static  CPU_STK     TestSamplerStk[256];
+static  CPU_TS      TestWinMax[TEST_WINS];
+
+
+static  int  TestTsCmp (const void  *p_a,
+                        const void  *p_b)
+{
+    CPU_TS  a;
+    CPU_TS  b;
+
+
+    a = *(const CPU_TS *)p_a;
+    b = *(const CPU_TS *)p_b;
+    return ((a > b) - (a < b));
+}
+
+
+static  CPU_TS  TestWinSort (CPU_TS  *p_win)
+{
+    CPU_INT32U  win;
+    CPU_TS      max;
+
+
+    max = 0u;
+    for (win = 0u; win < TEST_WINS; win++) {
+        if (max < p_win[win]) {
+            max = p_win[win];
+        }
+    }
+    qsort(p_win, TEST_WINS, sizeof(p_win[0]), TestTsCmp);
+    return (max);
+}
+
+
+static  void  TestInsRemove (void)
+{
+    OS_TCB      *p_tcb;
+    OS_ERR       err;
+    CPU_INT32U   seed;
+    CPU_INT32U   ops;
+    CPU_TS       ts0;
+    CPU_TS       ts1;
+    CPU_TS       ts2;
+    CPU_INT64U   ts_ns;
+    CPU_INT64U   remove_ns;
+    CPU_INT64U   insert_ns;
+    CPU_SR_ALLOC();
+
+
+    seed  = 1u;
+    ts_ns = 0u;
+    for (ops = 0u; ops < TEST_OPS; ops++) {                     /* Cost of the timestamps, see Note #3  */
+        CPU_CRITICAL_ENTER();
+        ts0    = OS_TS_GET();
+        ts1    = OS_TS_GET();
+        CPU_CRITICAL_EXIT();
+        ts_ns += (CPU_TS)(ts1 - ts0);
+    }
+    remove_ns = 0u;
+    insert_ns = 0u;
+    ops       = 0u;
+    while (ops < TEST_OPS) {
+        p_tcb = &TestTCB[HostTestRand(&seed) % TestTasks];
+        CPU_CRITICAL_ENTER();
+        if (p_tcb->TaskState == OS_TASK_STATE_DLY) {            /* Woken tasks wait for the sampler     */
+            ts0 = OS_TS_GET();
+            OS_TickListRemove(p_tcb);
+            ts1 = OS_TS_GET();
+            OS_TickListInsertDly(p_tcb, 1u + HostTestRand(&seed) % TEST_DLY_MAX, OS_OPT_TIME_DLY, &err);
+            ts2 = OS_TS_GET();
+            CPU_CRITICAL_EXIT();
+            HOST_TEST_CHK(err == OS_ERR_NONE);
+            remove_ns += (CPU_TS)(ts1 - ts0);
+            insert_ns += (CPU_TS)(ts2 - ts1);
+            ops++;
+        } else {
+            CPU_CRITICAL_EXIT();
+        }
+    }
+    printf("%-5s tasks=%-4u ops=%-6u  insert avg=%5u ns  remove avg=%5u ns\n",
+           (OS_CFG_TICK_WHEEL_EN == DEF_ENABLED) ? "wheel" : "list",
+           (unsigned)TestTasks,
+           (unsigned)TEST_OPS,
+           (unsigned)((insert_ns > ts_ns) ? (insert_ns - ts_ns) / TEST_OPS : 0u),
+           (unsigned)((remove_ns > ts_ns) ? (remove_ns - ts_ns) / TEST_OPS : 0u));
+}
+
+
+static  void  TestSampler (void  *p_arg)
+{
+    OS_ERR      err;
+    CPU_INT32U  win;
+    CPU_TS      max;
+    CPU_SR_ALLOC();
+
+
+    (void)p_arg;
+    OS_CPU_SysTickInitFreq(0u);
+    for (win = 0u; win < TEST_WINS; win++) {
+        OSTimeDly(TEST_WIN_TICKS, OS_OPT_TIME_PERIODIC, &err);
+        HOST_TEST_CHK(err == OS_ERR_NONE);
+        CPU_CRITICAL_ENTER();
+        TestWinMax[win]   = OSTickTaskTimeMax;
+        OSTickTaskTimeMax = 0u;
+        CPU_CRITICAL_EXIT();
+    }
+    max = TestWinSort(TestWinMax);
+    printf("%-5s tasks=%-4u steps=%-6u wakes=%-6u  update median=%5u ns  max=%7u ns\n",
+           (OS_CFG_TICK_WHEEL_EN == DEF_ENABLED) ? "wheel" : "list",
+           (unsigned)TestTasks,
+           (unsigned)OSTickTaskTCB.CtxSwCtr,
+           (unsigned)TestWakes,
+           (unsigned)TestWinMax[TEST_WINS / 2u],
+           (unsigned)max);
+    TestInsRemove();
+    HostTestPass("tick_bench");
+}
+
+
+static  void  TestTask (void  *p_arg)
+{
+    OS_ERR      err;
+    CPU_INT32U  seed;
+
+
+    seed = 7919u * (CPU_INT32U)(CPU_ADDR)p_arg + 1u;
+    for (;;) {
+        OSTimeDly(1u + HostTestRand(&seed) % TEST_DLY_MAX, OS_OPT_TIME_DLY, &err);
+        HOST_TEST_CHK(err == OS_ERR_NONE);
+        TestWakes++;
+    }
+}
+
+
+int  main (int    argc,
+           char  *argv[])
+{
+    CPU_INT32U  i;
+
+
+    TestTasks = (argc > 1) ? (CPU_INT32U)atoi(argv[1]) : 100u;
+    HOST_TEST_CHK((TestTasks > 0u) && (TestTasks <= TEST_TASKS_MAX));
+    HostTestInit();
+    HostTestTaskCreate(&TestSamplerTCB, "Sampler", TestSampler, (void *)0,
+                       4u, &TestSamplerStk[0], 256u);
+    for (i = 0u; i < TestTasks; i++) {
+        HostTestTaskCreate(&TestTCB[i], "Test Task", TestTask, (void *)(CPU_ADDR)i,
+                           (OS_PRIO)(6u + i % 20u), &TestStk[i][0], 256u);
+    }
+    HostTestStart();
+    return (1);
+}
@@ -0,0 +1,167 @@
+/*
+*********************************************************************************************************
+*                                     HOST TEST: TICK LIST EXPIRY
+*
+* Filename : tick_wheel.c
+*
+* Note(s)  : (1) 40 tasks delay or pend with a timeout for 1 to 300000 ticks, and post to and resume
+*                each other at random. A task that was neither posted nor resumed must wake on exactly
+*                the tick it asked for. With OS_CFG_DYN_TICK_EN a single tick step covers up to the
+*                next expiry, so most updates skip many empty slots.
+*
+*            (2) The run starts 1M ticks before OSTickCtr wraps and goes on for 3M ticks.
+*
+*            (3) With OS_CFG_TICK_WHEEL_EN every wake also checks that .Map[] matches the slots.
+*********************************************************************************************************
+*/
+
+#include  "host_test.h"
+
+
+#define  TEST_TASKS             40u
+#define  TEST_TICKS        3000000u
+#define  TEST_TICK_START   (0u - 1000000u)                      /* See Note #2.                                         */
+
+
+static  OS_TCB       TestTCB[TEST_TASKS];
+static  CPU_STK      TestStk[TEST_TASKS][256];
+static  OS_SEM       TestSem[TEST_TASKS];
+static  CPU_BOOLEAN  TestResumed[TEST_TASKS];
+static  CPU_INT32U   TestWakes;
+static  CPU_INT32U   TestTimeouts;
+
+
+#if (OS_CFG_TICK_WHEEL_EN == DEF_ENABLED)
+static  void  TestMapChk (OS_WHEEL  *p_wheel)
+{
+    CPU_INT08U  level;
+    CPU_INT08U  slot;
+    CPU_DATA    bit;
+    CPU_BOOLEAN used;
+
+
+    for (level = 0u; level < OS_WHEEL_LEVELS; level++) {
+        for (slot = 0u; slot < OS_WHEEL_SLOTS; slot++) {
+            bit  = (CPU_DATA)1u << ((DEF_INT_CPU_NBR_BITS - 1u) - (slot % DEF_INT_CPU_NBR_BITS));
+            used = ((p_wheel->Map[level][slot / DEF_INT_CPU_NBR_BITS] & bit) != 0u) ? DEF_YES : DEF_NO;
+            HOST_TEST_CHK(used == ((p_wheel->Slot[level][slot] != (OS_WHEEL_NODE *)0) ? DEF_YES : DEF_NO));
+        }
+    }
+}
+#endif
+
+
+static  OS_TICK  TestDlyGet (CPU_INT32U  *p_seed)
+{
+    CPU_INT32U  r;
+
+
+    r = HostTestRand(p_seed) % 10u;
+    if (r < 6u) {
+        return (1u + HostTestRand(p_seed) % 70u);               /* Level 0 and 1                                        */
+    } else if (r < 9u) {
+        return (1u + HostTestRand(p_seed) % 6000u);             /* Level 1 and 2                                        */
+    } else {
+        return (1u + HostTestRand(p_seed) % 300000u);           /* Up to level 3                                        */
+    }
+}
+
+
+static  void  TestTask (void  *p_arg)
+{
+    OS_ERR      err;
+    CPU_INT32U  id;
+    CPU_INT32U  seed;
+    CPU_INT32U  other;
+    OS_TICK     dly;
+    OS_TICK     start;
+    OS_TICK     elapsed;
+    CPU_BOOLEAN resumed;
+
+
+    id   = (CPU_INT32U)(CPU_ADDR)p_arg;
+    seed = 7919u * id + 1u;
+    if (id == 0u) {
+        OS_CPU_SysTickInitFreq(0u);
+    }
+    for (;;) {
+        dly   = TestDlyGet(&seed);
+        start = OSTickCtr;
+        if ((HostTestRand(&seed) & 1u) != 0u) {
+            TestResumed[id] = DEF_NO;
+            OSTimeDly(dly, OS_OPT_TIME_DLY, &err);
+            elapsed = OSTickCtr - start;
+            HOST_TEST_CHK(err == OS_ERR_NONE);
+            if (TestResumed[id] == DEF_NO) {
+                HOST_TEST_CHK(elapsed == dly);
+                TestTimeouts++;
+            } else {
+                HOST_TEST_CHK(elapsed <= dly);
+            }
+        } else {
+            OSSemPend(&TestSem[id], dly, OS_OPT_PEND_BLOCKING, (CPU_TS *)0, &err);
+            elapsed = OSTickCtr - start;
+            if (err == OS_ERR_TIMEOUT) {
+                HOST_TEST_CHK(elapsed == dly);
+                TestTimeouts++;
+            } else {
+                HOST_TEST_CHK(err == OS_ERR_NONE);
+                HOST_TEST_CHK(elapsed <= dly);
+            }
+        }
+        TestWakes++;
+#if (OS_CFG_TICK_WHEEL_EN == DEF_ENABLED)
+        TestMapChk(&OSTickListDly.Wheel);
+        TestMapChk(&OSTickListTimeout.Wheel);
+#endif
+
+        if ((HostTestRand(&seed) & 3u) == 0u) {                 /* Wake two others early                                */
+            other = HostTestRand(&seed) % TEST_TASKS;
+            if (other != id) {
+                OSSemPost(&TestSem[other], OS_OPT_POST_1, &err);
+            }
+            other = HostTestRand(&seed) % TEST_TASKS;
+            if (other != id) {
+                resumed            = TestResumed[other];
+                TestResumed[other] = DEF_YES;                   /* Set first, the task may run at once                  */
+                OSTimeDlyResume(&TestTCB[other], &err);
+                if (err != OS_ERR_NONE) {
+                    TestResumed[other] = resumed;               /* Was not in OSTimeDly(), may be resumed already       */
+                }
+            }
+        }
+
+        if ((OS_TICK)(OSTickCtr - TEST_TICK_START) >= TEST_TICKS) {
+            printf("ticks=%u wakes=%u on-time=%u ctxsw=%u\n",
+                   (unsigned)(OSTickCtr - TEST_TICK_START),
+                   (unsigned)TestWakes,
+                   (unsigned)TestTimeouts,
+                   (unsigned)OSTaskCtxSwCtr);
+            HOST_TEST_CHK(TestTimeouts > TestWakes / 4u);
+            HostTestPass("tick_wheel");
+        }
+    }
+}
+
+
+int  main (void)
+{
+    OS_ERR      err;
+    CPU_INT32U  i;
+
+
+    HostTestInit();
+    OSTickCtr                   = TEST_TICK_START;
+#if (OS_CFG_TICK_WHEEL_EN == DEF_ENABLED)
+    OSTickListDly.Wheel.Now     = OSTickCtr;
+    OSTickListTimeout.Wheel.Now = OSTickCtr;
+#endif
+    for (i = 0u; i < TEST_TASKS; i++) {
+        OSSemCreate(&TestSem[i], "Test Sem", 0u, &err);
+        HOST_TEST_CHK(err == OS_ERR_NONE);
+        HostTestTaskCreate(&TestTCB[i], "Test Task", TestTask, (void *)(CPU_ADDR)i,
+                           (OS_PRIO)(6u + i % 20u), &TestStk[i][0], 256u);
+    }
+    HostTestStart();
+    return (1);
+}
@@ -0,0 +1,116 @@
+/*
+*********************************************************************************************************
+*                                    HOST BENCHMARK: TIMER TASK UPDATE
+*
+* Filename : tmr_bench.c
+*
+* Note(s)  : (1) Usage: tmr_bench <timers>. Periodic timers with random periods of 1 to 1000 timer
+*                ticks run for 20000 timer ticks. The callbacks only count.
+*
+*            (2) OSTmrTaskTimeMax is the longest timer task pass, in ns on the host. A sampler task
+*                reads and clears it every 100 timer ticks. The median of those maxima is printed
+*                with the overall one, which host scheduling noise can inflate.
+*
+*            (3) Build with OS_CFG_TMR_WHEEL_EN disabled (tmr_bench_list) for the timer list.
+*********************************************************************************************************
+*/
+
+#include  "host_test.h"
+
+
+#define  TEST_TMRS_MAX          16000u
+#define  TEST_TMR_TICKS         20000u
+#define  TEST_PERIOD_MAX         1000u
+#define  TEST_WIN_TMR_TICKS       100u
+#define  TEST_WINS             (TEST_TMR_TICKS / TEST_WIN_TMR_TICKS)
+
+
+static  OS_TMR      TestTmr[TEST_TMRS_MAX];
+static  CPU_INT32U  TestTmrs;
+static  CPU_INT32U  TestFires;
+static  OS_TCB      TestSamplerTCB;
+static  CPU_STK     TestSamplerStk[256];
+static  CPU_TS      TestWinMax[TEST_WINS];
+
+
+static  int  TestTsCmp (const void  *p_a,
+                        const void  *p_b)
+{
+    CPU_TS  a;
+    CPU_TS  b;
+
+
+    a = *(const CPU_TS *)p_a;
+    b = *(const CPU_TS *)p_b;
+    return ((a > b) - (a < b));
+}
+
+
+static  void  TestCallback (void  *p_tmr,
+                            void  *p_arg)
+{
+    (void)p_tmr;
+    (void)p_arg;
+    TestFires++;
+}
+
+
+static  void  TestSampler (void  *p_arg)
+{
+    OS_ERR      err;
+    CPU_INT32U  win;
+    CPU_INT32U  i;
+    CPU_TS      max;
+
+
+    (void)p_arg;
+    OS_CPU_SysTickInitFreq(0u);
+    for (i = 0u; i < TestTmrs; i++) {
+        OSTmrStart(&TestTmr[i], &err);
+        HOST_TEST_CHK(err == OS_ERR_NONE);
+    }
+    max = 0u;
+    for (win = 0u; win < TEST_WINS; win++) {
+        OSTimeDly(TEST_WIN_TMR_TICKS * OSTmrUpdateCnt, OS_OPT_TIME_PERIODIC, &err);
+        HOST_TEST_CHK(err == OS_ERR_NONE);
+        OSSchedLock(&err);                                      /* Timer task must not run meanwhile    */
+        TestWinMax[win]  = OSTmrTaskTimeMax;
+        OSTmrTaskTimeMax = 0u;
+        OSSchedUnlock(&err);
+        if (max < TestWinMax[win]) {
+            max = TestWinMax[win];
+        }
+    }
+    qsort(TestWinMax, TEST_WINS, sizeof(TestWinMax[0]), TestTsCmp);
+    printf("%-5s timers=%-5u fires=%-8u  timer task median=%7u ns  max=%8u ns\n",
+           (OS_CFG_TMR_WHEEL_EN == DEF_ENABLED) ? "wheel" : "list",
+           (unsigned)TestTmrs,
+           (unsigned)TestFires,
+           (unsigned)TestWinMax[TEST_WINS / 2u],
+           (unsigned)max);
+    HostTestPass("tmr_bench");
+}
+
+
+int  main (int    argc,
+           char  *argv[])
+{
+    OS_ERR      err;
+    CPU_INT32U  seed;
+    CPU_INT32U  i;
+
+
+    TestTmrs = (argc > 1) ? (CPU_INT32U)atoi(argv[1]) : 1000u;
+    HOST_TEST_CHK((TestTmrs > 0u) && (TestTmrs <= TEST_TMRS_MAX));
+    HostTestInit();
+    seed = 12345u;
+    for (i = 0u; i < TestTmrs; i++) {
+        OSTmrCreate(&TestTmr[i], "Test Tmr", 0u, 1u + HostTestRand(&seed) % TEST_PERIOD_MAX,
+                    OS_OPT_TMR_PERIODIC, TestCallback, (void *)0, &err);
+        HOST_TEST_CHK(err == OS_ERR_NONE);
+    }
+    HostTestTaskCreate(&TestSamplerTCB, "Sampler", TestSampler, (void *)0,
+                       4u, &TestSamplerStk[0], 256u);
+    HostTestStart();
+    return (1);
+}
@@ -0,0 +1,155 @@
+/*
+*********************************************************************************************************
+*                                     HOST TEST: TIMER EXPIRY
+*
+* Filename : tmr_wheel.c
+*
+* Note(s)  : (1) 3000 one-shot and periodic timers, due 1 to 5000 timer ticks ahead, run for 20000
+*                timer ticks. The callbacks stop and restart other timers at random. Every callback
+*                must come on exactly the timer tick expected from when its timer was last started
+*                or reloaded, and a stopped timer must not fire.
+*
+*            (2) At the end OSTmrRemainGet() is checked against the expected expiry of every timer
+*                still running.
+*********************************************************************************************************
+*/
+
+#include  "host_test.h"
+
+
+#define  TEST_TMRS               3000u
+#define  TEST_TMR_TICKS         20000u
+
+
+static  OS_TMR       TestTmr[TEST_TMRS];
+static  OS_TICK      TestExpire[TEST_TMRS];                     /* OSTmrTickCtr when due, while running */
+static  CPU_BOOLEAN  TestRunning[TEST_TMRS];
+static  CPU_INT32U   TestSeed = 12345u;
+static  CPU_INT32U   TestFires;
+static  OS_TCB       TestTCB;
+static  CPU_STK      TestStk[256];
+
+
+static  void  TestStart (CPU_INT32U  id)
+{
+    OS_ERR  err;
+
+
+    OSTmrStart(&TestTmr[id], &err);
+    HOST_TEST_CHK(err == OS_ERR_NONE);
+    TestExpire[id]  = OSTmrTickCtr + ((TestTmr[id].Dly != 0u) ? TestTmr[id].Dly : TestTmr[id].Period);
+    TestRunning[id] = DEF_YES;
+}
+
+
+static  void  TestStop (CPU_INT32U  id)
+{
+    OS_ERR  err;
+
+
+    (void)OSTmrStop(&TestTmr[id], OS_OPT_TMR_NONE, (void *)0, &err);
+    HOST_TEST_CHK(err == ((TestRunning[id] == DEF_YES) ? OS_ERR_NONE : OS_ERR_TMR_STOPPED));
+    TestRunning[id] = DEF_NO;
+}
+
+
+static  void  TestCallback (void  *p_tmr,
+                            void  *p_arg)
+{
+    CPU_INT32U  id;
+    CPU_INT32U  r;
+
+
+    id = (CPU_INT32U)(CPU_ADDR)p_arg;
+    HOST_TEST_CHK(p_tmr == &TestTmr[id]);
+    HOST_TEST_CHK(TestRunning[id] == DEF_YES);
+    HOST_TEST_CHK(OSTmrTickCtr == TestExpire[id]);
+    TestFires++;
+    if (TestTmr[id].Opt == OS_OPT_TMR_PERIODIC) {
+        TestExpire[id] += TestTmr[id].Period;
+    } else {
+        TestRunning[id] = DEF_NO;
+    }
+
+    r = HostTestRand(&TestSeed);
+    switch (r & 7u) {
+        case 0u:
+             TestStop((r >> 8) % TEST_TMRS);
+             break;
+
+        case 1u:
+             TestStart((r >> 8) % TEST_TMRS);
+             break;
+
+        default:
+             break;
+    }
+}
+
+
+static  void  TestTask (void  *p_arg)
+{
+    OS_ERR      err;
+    OS_TICK     remain;
+    CPU_INT32U  running;
+    CPU_INT32U  i;
+
+
+    (void)p_arg;
+    OS_CPU_SysTickInitFreq(0u);
+    for (i = 0u; i < TEST_TMRS; i++) {
+        TestStart(i);
+    }
+    while (OSTmrTickCtr < TEST_TMR_TICKS) {
+        OSTimeDly(1000u, OS_OPT_TIME_DLY, &err);
+        HOST_TEST_CHK(err == OS_ERR_NONE);
+    }
+
+    OSSchedLock(&err);                                          /* Timer task must not run meanwhile    */
+    running = 0u;
+    for (i = 0u; i < TEST_TMRS; i++) {
+        remain = OSTmrRemainGet(&TestTmr[i], &err);
+        HOST_TEST_CHK(err == OS_ERR_NONE);
+        if (TestRunning[i] == DEF_YES) {
+            HOST_TEST_CHK(TestTmr[i].State == OS_TMR_STATE_RUNNING);
+            HOST_TEST_CHK(remain == TestExpire[i] - OSTmrTickCtr);
+            running++;
+        } else {
+            HOST_TEST_CHK(TestTmr[i].State != OS_TMR_STATE_RUNNING);
+        }
+    }
+    printf("tmr ticks=%u fires=%u running=%u\n", (unsigned)OSTmrTickCtr, (unsigned)TestFires, (unsigned)running);
+    HostTestPass("tmr_wheel");
+}
+
+
+int  main (void)
+{
+    OS_ERR      err;
+    CPU_INT32U  i;
+    CPU_INT32U  r;
+    OS_TICK     dly;
+    OS_TICK     period;
+
+
+    HostTestInit();
+    for (i = 0u; i < TEST_TMRS; i++) {
+        r      = HostTestRand(&TestSeed);
+        dly    = 1u + HostTestRand(&TestSeed) % (((r & 3u) != 0u) ? 50u : 5000u);
+        period = 1u + HostTestRand(&TestSeed) % 300u;
+        if ((r & 4u) == 0u) {                                   /* Periodic, first due after a period   */
+            OSTmrCreate(&TestTmr[i], "Test Tmr", 0u, period, OS_OPT_TMR_PERIODIC,
+                        TestCallback, (void *)(CPU_ADDR)i, &err);
+        } else if ((r & 8u) == 0u) {
+            OSTmrCreate(&TestTmr[i], "Test Tmr", dly, 0u, OS_OPT_TMR_ONE_SHOT,
+                        TestCallback, (void *)(CPU_ADDR)i, &err);
+        } else {
+            OSTmrCreate(&TestTmr[i], "Test Tmr", dly, period, OS_OPT_TMR_PERIODIC,
+                        TestCallback, (void *)(CPU_ADDR)i, &err);
+        }
+        HOST_TEST_CHK(err == OS_ERR_NONE);
+    }
+    HostTestTaskCreate(&TestTCB, "Test Task", TestTask, (void *)0, 4u, &TestStk[0], 256u);
+    HostTestStart();
+    return (1);
+}
@@ -0,0 +1,174 @@
+/*
+*********************************************************************************************************
+*                                    HOST BENCHMARK: RAM RING TRACE
+*
+* Filename : trace_bench.c
+*
+* Note(s)  : (1) Usage: trace_bench <mode>, with <mode> OS_TRACE_RAM_MODE_RING (0) or _STOP (1). Times
+*                OS_TraceRamEvt() alone, recording and with recording stopped. In stop mode the ring
+*                fills after OS_CFG_TRACE_RAM_SIZE events, so the rest time the drop count.
+*
+*            (2) Then two tasks pass a semaphore back and forth, TEST_ROUNDS rounds, with recording on
+*                and off. The events each round records are counted from OSTraceRam.Head, and the
+*                difference between the two times is divided by them for the cost of one event in a
+*                real kernel path. trace_bench_off is built with OS_CFG_TRACE_EN disabled
+*                (test/cfg/trace_off) and times only the rounds, without the hooks compiled in.
+*
+*            (3) The best of TEST_RUNS runs is printed. A host context switch takes far longer than
+*                the board's, so the per-event figure from (2) is noisy; the one from (1) is not.
+*********************************************************************************************************
+*/
+
+#include  "host_test.h"
+
+
+#define  TEST_EVTS            1000000u
+#define  TEST_ROUNDS           100000u
+#define  TEST_RUNS                  5u
+
+
+static  OS_SEM      TestPing;
+static  OS_SEM      TestPong;
+static  OS_TCB      TestTCB;
+static  CPU_STK     TestStk[512];
+static  OS_TCB      TestPongTCB;
+static  CPU_STK     TestPongStk[256];
+#if (OS_CFG_TRACE_EN == DEF_ENABLED)
+static  CPU_INT08U  TestMode;
+#endif
+
+
+static  void  TestPongTask (void  *p_arg)
+{
+    OS_ERR  err;
+
+
+    (void)p_arg;
+    while (DEF_ON) {
+        (void)OSSemPend(&TestPing, 0u, OS_OPT_PEND_BLOCKING, (CPU_TS *)0, &err);
+        (void)OSSemPost(&TestPong, OS_OPT_POST_1, &err);
+    }
+}
+
+
+static  CPU_INT64U  TestRounds (void)
+{
+    OS_ERR      err;
+    CPU_INT64U  best;
+    CPU_INT64U  ns;
+    CPU_INT32U  run;
+    CPU_INT32U  i;
+
+
+    best = DEF_INT_64U_MAX_VAL;
+    for (run = 0u; run < TEST_RUNS; run++) {
+        ns = HostTestNs();
+        for (i = 0u; i < TEST_ROUNDS; i++) {
+            (void)OSSemPost(&TestPing, OS_OPT_POST_1, &err);
+            (void)OSSemPend(&TestPong, 0u, OS_OPT_PEND_BLOCKING, (CPU_TS *)0, &err);
+        }
+        ns = HostTestNs() - ns;
+        if (best > ns) {
+            best = ns;
+        }
+    }
+    return (best);
+}
+
+
+#if (OS_CFG_TRACE_EN == DEF_ENABLED)
+static  CPU_INT64U  TestEvts (CPU_BOOLEAN  running)
+{
+    CPU_INT64U  best;
+    CPU_INT64U  ns;
+    CPU_INT32U  run;
+    CPU_INT32U  i;
+
+
+    best = DEF_INT_64U_MAX_VAL;
+    for (run = 0u; run < TEST_RUNS; run++) {
+        OSTraceRamStop();
+        OSTraceRamClear();
+        if (running == DEF_YES) {
+            OSTraceRamStart(TestMode);
+        }
+        ns = HostTestNs();
+        for (i = 0u; i < TEST_EVTS; i++) {
+            OS_TraceRamEvt(OS_TRACE_RAM_EVT_TICK, 0u, (CPU_INT16U)i);
+        }
+        ns = HostTestNs() - ns;
+        if (best > ns) {
+            best = ns;
+        }
+    }
+    return (best);
+}
+#endif
+
+
+static  void  TestTask (void  *p_arg)
+{
+    CPU_INT64U  off_ns;
+#if (OS_CFG_TRACE_EN == DEF_ENABLED)
+    CPU_INT64U  on_ns;
+    CPU_INT64U  evt_ns;
+    CPU_INT64U  stop_ns;
+    CPU_DATA    head;
+    CPU_DATA    evts;
+#endif
+
+
+    (void)p_arg;
+    OS_CPU_SysTickInitFreq(0u);
+#if (OS_CFG_TRACE_EN == DEF_ENABLED)
+    evt_ns  = TestEvts(DEF_YES);
+    stop_ns = TestEvts(DEF_NO);
+
+    OSTraceRamStop();
+    off_ns  = TestRounds();
+    OSTraceRamClear();
+    OSTraceRamStart(OS_TRACE_RAM_MODE_RING);                    /* Count the events of one round        */
+    head    = OSTraceRam.Head;
+    (void)TestRounds();
+    evts    = (OSTraceRam.Head - head) / (TEST_ROUNDS * TEST_RUNS);
+    OSTraceRamClear();
+    OSTraceRamStart(TestMode);
+    on_ns   = TestRounds();
+    OSTraceRamStop();
+    printf("trace mode=%s  event=%5.1f ns  stopped=%4.1f ns  round: %u events, on=%6.1f ns off=%6.1f ns (%+.1f ns/event)\n",
+           (TestMode == OS_TRACE_RAM_MODE_RING) ? "ring" : "stop",
+           (double)evt_ns  / TEST_EVTS,
+           (double)stop_ns / TEST_EVTS,
+           (unsigned)evts,
+           (double)on_ns   / TEST_ROUNDS,
+           (double)off_ns  / TEST_ROUNDS,
+           ((double)on_ns - (double)off_ns) / TEST_ROUNDS / (double)evts);
+#else
+    off_ns = TestRounds();
+    printf("trace compiled out  round: off=%6.1f ns\n", (double)off_ns / TEST_ROUNDS);
+#endif
+    exit(0);
+}
+
+
+int  main (int    argc,
+           char  *argv[])
+{
+    OS_ERR      err;
+    CPU_INT32U  mode;
+
+
+    mode = (argc > 1) ? (CPU_INT32U)atoi(argv[1]) : 0u;
+    HOST_TEST_CHK(mode <= 1u);
+#if (OS_CFG_TRACE_EN == DEF_ENABLED)
+    TestMode = (mode == 0u) ? OS_TRACE_RAM_MODE_RING : OS_TRACE_RAM_MODE_STOP;
+#endif
+    HostTestInit();
+    OSSemCreate(&TestPing, "Ping", 0u, &err);
+    OSSemCreate(&TestPong, "Pong", 0u, &err);
+    HOST_TEST_CHK(err == OS_ERR_NONE);
+    HostTestTaskCreate(&TestTCB,     "Test Task", TestTask,    (void *)0, 10u, &TestStk[0],     512u);
+    HostTestTaskCreate(&TestPongTCB, "Pong",      TestPongTask, (void *)0,  9u, &TestPongStk[0], 256u);
+    HostTestStart();
+    return (1);
+}
@@ -0,0 +1,143 @@
+/*
+*********************************************************************************************************
+*                                 HOST TEST: TRACE DUMP ROUND TRIP
+*
+* Filename : trace_decode.c
+*
+* Note(s)  : (1) The ring is cleared, then the test task posts a semaphore TEST_ROUNDS times to a
+*                higher task that pends on it. On the last round that task suspends itself, with
+*                OSTaskSuspend((OS_TCB *)0), and the test task resumes it. Recording is stopped and
+*                sizeof(OSTraceRam) bytes from &OSTraceRam are written to build/trace_decode.bin, as
+*                they would be dumped from the debugger.
+*
+*            (2) tools/os_trace_decode.py -l -o build/trace_decode.json is run on the dump. It must
+*                print the ring's counts as OSTraceRam holds them, list the suspend and the resume
+*                under the task's name, and count TEST_ROUNDS posts, pends and blocks on the
+*                semaphore. The Chrome trace must name the task's row and hold one slice per time it
+*                was switched in: once a round and once more after it was resumed.
+*********************************************************************************************************
+*/
+
+#include  <string.h>
+#include  "host_test.h"
+
+
+#define  TEST_ROUNDS               20u
+#define  TEST_LINE_SIZE           160u
+#define  TEST_PATH               HOST_TEST_OUT "trace_decode.bin"
+#define  TEST_PATH_JSON          HOST_TEST_OUT "trace_decode.json"
+
+
+static  OS_SEM               TestSem;
+static  volatile CPU_BOOLEAN TestSuspend;
+static  OS_TCB               TestTCB;
+static  CPU_STK              TestStk[512];
+static  OS_TCB               TestHiTCB;
+static  CPU_STK              TestHiStk[256];
+static  char                 TestOut[65536];
+static  char                 TestJson[262144];
+
+
+static  void  TestHi (void  *p_arg)
+{
+    OS_ERR  err;
+
+
+    (void)p_arg;
+    while (DEF_ON) {
+        (void)OSSemPend(&TestSem, 0u, OS_OPT_PEND_BLOCKING, (CPU_TS *)0, &err);
+        HOST_TEST_CHK(err == OS_ERR_NONE);
+        if (TestSuspend == DEF_YES) {
+            OSTaskSuspend((OS_TCB *)0, &err);                   /* See os_trace_events.h Note #3        */
+            HOST_TEST_CHK(err == OS_ERR_NONE);
+        }
+    }
+}
+
+
+static  CPU_INT32U  TestCnt (const char  *p_text,               /* Times 'p_text' occurs in 'p_str'     */
+                             const char  *p_str)
+{
+    CPU_INT32U  n;
+
+
+    n = 0u;
+    while ((p_str = strstr(p_str, p_text)) != (char *)0) {
+        p_str++;
+        n++;
+    }
+    return (n);
+}
+
+
+static  void  TestTask (void  *p_arg)
+{
+    OS_ERR      err;
+    char        line[TEST_LINE_SIZE];
+    FILE       *p_file;
+    CPU_SIZE_T  len;
+    CPU_INT32U  i;
+
+
+    (void)p_arg;
+    OS_CPU_SysTickInitFreq(0u);
+
+    OSTraceRamStop();                                           /* See Note #1                          */
+    OSTraceRamClear();
+    OSTraceRamStart(OS_TRACE_RAM_MODE_RING);
+    for (i = 0u; i < TEST_ROUNDS; i++) {
+        TestSuspend = (i == TEST_ROUNDS - 1u) ? DEF_YES : DEF_NO;
+        (void)OSSemPost(&TestSem, OS_OPT_POST_1, &err);
+        HOST_TEST_CHK(err == OS_ERR_NONE);
+        OSTimeDly(1u, OS_OPT_TIME_DLY, &err);
+    }
+    HOST_TEST_CHK(TestHiTCB.TaskState == OS_TASK_STATE_SUSPENDED);
+    TestSuspend = DEF_NO;
+    OSTaskResume(&TestHiTCB, &err);
+    HOST_TEST_CHK(err == OS_ERR_NONE);
+    OSTraceRamStop();
+    HOST_TEST_CHK(OSTraceRam.Head < OSTraceRam.Size);           /* Nothing overwritten                  */
+    HostTestFileWrite(TEST_PATH, &OSTraceRam, sizeof(OSTraceRam));
+
+    HOST_TEST_CHK(HostTestTool("os_trace_decode.py -l -o " TEST_PATH_JSON " " TEST_PATH,
+                               &TestOut[0], sizeof(TestOut)) == 0);
+    snprintf(line, sizeof(line), "%u events kept of %u recorded, %u dropped, ring mode, ring of %u\n",
+             (unsigned)OSTraceRam.Head, (unsigned)OSTraceRam.Head, (unsigned)OSTraceRam.DropCtr,
+             (unsigned)OSTraceRam.Size);
+    HOST_TEST_CHK(HostTestFind(TestOut, line));                 /* See Note #2                          */
+    snprintf(line, sizeof(line), "  %-24s %-16s %u\n", "task suspend", "Trace Hi", 0u);
+    HOST_TEST_CHK(HostTestFind(TestOut, line));
+    snprintf(line, sizeof(line), "  %-24s %-16s %u\n", "task resume", "Trace Hi", 0u);
+    HOST_TEST_CHK(HostTestFind(TestOut, line));
+    snprintf(line, sizeof(line), "  %-12s %-16s %6u %6u %6u ", "sem", "Trace Sem",
+             (unsigned)TEST_ROUNDS, (unsigned)TEST_ROUNDS, (unsigned)TEST_ROUNDS);
+    HOST_TEST_CHK(HostTestFind(TestOut, line));
+
+    p_file = fopen(TEST_PATH_JSON, "r");
+    HOST_TEST_CHK(p_file != (FILE *)0);
+    len = fread(&TestJson[0], 1u, sizeof(TestJson) - 1u, p_file);
+    HOST_TEST_CHK(len < sizeof(TestJson) - 1u);
+    TestJson[len] = '\0';
+    (void)fclose(p_file);
+    HOST_TEST_CHK(HostTestFind(TestJson, "\"args\": {\"name\": \"Trace Hi\"}"));
+    HOST_TEST_CHK(TestCnt("{\"name\": \"Trace Hi\", \"ph\": \"B\"", TestJson) == TEST_ROUNDS + 1u);
+
+    printf("trace decode: %u events, %u bytes dumped, %u bytes of Chrome trace\n",
+           (unsigned)OSTraceRam.Head, (unsigned)sizeof(OSTraceRam), (unsigned)len);
+    HostTestPass("trace_decode");
+}
+
+
+int  main (void)
+{
+    OS_ERR  err;
+
+
+    HostTestInit();
+    OSSemCreate(&TestSem, "Trace Sem", 0u, &err);
+    HOST_TEST_CHK(err == OS_ERR_NONE);
+    HostTestTaskCreate(&TestTCB,   "Test Task", TestTask, (void *)0, 10u, &TestStk[0],   512u);
+    HostTestTaskCreate(&TestHiTCB, "Trace Hi",  TestHi,   (void *)0,  8u, &TestHiStk[0], 256u);
+    HostTestStart();
+    return (1);
+}
@@ -6,17 +6,248 @@
  *  Created on: Oct 18, 2020
  *  Last Edited on: 11/28/20
  *      Author: August Byrne
+ *
+ *  The bulk of the range is summed a 32-bit word at a time. On the
+ *  Cortex-M4 USADA8 adds the four bytes of a word to the running sum in
+ *  one instruction. Without the DSP extension the bytes are summed in two
+ *  16-bit lanes (SIMD within a register). The result is the same 16-bit
+ *  byte sum the original byte loop gave.
+ *
+ *  memTestTask verifies the image in the background with a CRC-32, one
+ *  chunk per tick, so boot and the output tasks never wait on it. The
+ *  reference is MemTestCrcRef, stored in the image after the link by
+ *  tools/memtest_crc_ref.py.
  */
 
+#include "app_cfg.h"
+#include "os.h"
 #include "MCUType.h"               /* Include header files                    */
 #include "MemTest.h"
 
+#define CHKSUM_WORD_ALIGN   (sizeof(INT32U) - 1u)
+#define CHKSUM_LANE_MASK    0x00FF00FFu
+#define CHKSUM_LANE_WORDS   128u    /* 128*2*255 still fits a 16-bit lane */
+
+#define MEMTEST_CHUNK_BYTES 4096u   /* Bytes checked between yields       */
+#define MEMTEST_FLAG_DONE   0x01u   /* Set once the first pass finishes   */
+#define MEMTEST_REF_OUTSIDE 0xFFFFFFFFu /* memTestRefOfs, not in the range */
+#define MEMTEST_PERIOD_TICKS ((APP_CFG_MEMTEST_PERIOD_MS * OS_CFG_TICK_RATE_HZ) / 1000u)
+
+/*****************************************************************************************
+* Allocate task control blocks and stack space
+*****************************************************************************************/
+static OS_TCB memTestTaskTCB;
+static CPU_STK memTestTaskStk[APP_CFG_MEMTEST_TASK_STK_SIZE];
+
+static void memTestTask(void *p_arg);
+static INT32U chkSumWords(const INT32U *wordaddr, INT32U nwords);
+
+/*****************************************************************************************
+* Variables
+*****************************************************************************************/
+static OS_FLAG_GRP memTestFlags;
+static const INT8U *memTestStart;
+static INT32U memTestLen;
+static INT32U memTestRefOfs;        /* Offset of MemTestCrcRef in the range */
+static volatile INT8U memTestProgress;
+static volatile MEMTEST_STATUS memTestStatus = MEMTEST_PENDING;
+static volatile INT32U memTestCrc;
+
+/* Stays in flash. Read through a volatile pointer so the compiler
+ * does not fold in the erased value it was initialised with. */
+const INT32U MemTestCrcRef = MEMTEST_CRC_REF_NONE;
+
+/* CRC-32 remainders for one nibble, reflected polynomial 0xEDB88320 */
+static const INT32U memTestCrcTbl[16] = {
+	0x00000000u, 0x1DB71064u, 0x3B6E20C8u, 0x26D930ACu,
+	0x76DC4190u, 0x6B6B51F4u, 0x4DB26158u, 0x5005713Cu,
+	0xEDB88320u, 0xF00F9344u, 0xD6D6A3E8u, 0xCB61B38Cu,
+	0x9B64C2B0u, 0x86D3D2D4u, 0xA00AE278u, 0xBDBDF21Cu
+};
+
 INT16U CalcChkSum(INT8U *startaddr, INT8U *endaddr){
-	INT16U check_sum = 0;
+	INT32U check_sum = 0;
+	INT32U nwords;
+	while ((startaddr < endaddr) && (((CPU_ADDR)startaddr & CHKSUM_WORD_ALIGN) != 0)){
+		check_sum += (INT32U) *startaddr;	//add leading bytes up to a word boundary
+		startaddr ++;
+	}
+	nwords = (startaddr < endaddr) ? ((INT32U)(endaddr - startaddr) / sizeof(INT32U)) : 0;
+	check_sum += chkSumWords((const INT32U *)startaddr, nwords);
+	startaddr += nwords * sizeof(INT32U);
 	while (startaddr < endaddr){
-		check_sum += (INT16U) *startaddr;	//add all of the data in the addresses listed
-		startaddr ++;	//make the pointer point to the next address
+		check_sum += (INT32U) *startaddr;	//add trailing bytes
+		startaddr ++;
+	}
+	check_sum += (INT32U) *startaddr;	//add the last index to the checksum, navigating around the terminal count bug
+	return (INT16U)check_sum;
+}
+
+/*
+ * chkSumWords() - Returns the sum of every byte in nwords aligned words.
+ *	The sum is exact modulo 2^32, which is all CalcChkSum needs.
+ */
+static INT32U chkSumWords(const INT32U *wordaddr, INT32U nwords){
+	INT32U sum = 0;
+#if (defined (__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1))
+	while (nwords >= 4){	//unrolled, one USADA8 per word
+		sum = __USADA8(wordaddr[0], 0, sum);
+		sum = __USADA8(wordaddr[1], 0, sum);
+		sum = __USADA8(wordaddr[2], 0, sum);
+		sum = __USADA8(wordaddr[3], 0, sum);
+		wordaddr += 4;
+		nwords -= 4;
 	}
-	check_sum += (INT16U) *startaddr;	//add the last index to the checksum, navigating around the terminal count bug
-	return check_sum;
+	while (nwords != 0){
+		sum = __USADA8(*wordaddr, 0, sum);
+		wordaddr ++;
+		nwords --;
+	}
+#else
+	INT32U lanes;
+	INT32U block;
+	INT32U word;
+	while (nwords != 0){
+		block = (nwords < CHKSUM_LANE_WORDS) ? nwords : CHKSUM_LANE_WORDS;
+		nwords -= block;
+		lanes = 0;
+		while (block != 0){	//bytes 0,2 and 1,3 land in the low and high 16-bit lanes
+			word = *wordaddr;
+			lanes += (word & CHKSUM_LANE_MASK) + ((word >> 8) & CHKSUM_LANE_MASK);
+			wordaddr ++;
+			block --;
+		}
+		sum += (lanes & 0xFFFFu) + (lanes >> 16);	//fold the lanes before they can overflow
+	}
+#endif
+	return sum;
+}
+
+/*
+ * MemTestCrc32() - Continues a CRC-32 over nbytes at addr, a nibble at a time.
+ */
+INT32U MemTestCrc32(INT32U crc, const INT8U *addr, INT32U nbytes){
+	while (nbytes != 0){
+		crc ^= (INT32U) *addr;
+		crc = (crc >> 4) ^ memTestCrcTbl[crc & 0x0Fu];	//low nibble first, reflected
+		crc = (crc >> 4) ^ memTestCrcTbl[crc & 0x0Fu];
+		addr ++;
+		nbytes --;
+	}
+	return crc;
+}
+
+/*
+ * MemTestInit() - Creates the integrity task. Does not wait for it.
+ */
+void MemTestInit(INT8U *startaddr, INT8U *endaddr){
+	OS_ERR os_err;
+
+	memTestStart = startaddr;
+	memTestLen = (INT32U)(endaddr - startaddr) + 1u;	//endaddr is inclusive
+	if (((CPU_ADDR)&MemTestCrcRef >= (CPU_ADDR)startaddr)
+		&& (((CPU_ADDR)&MemTestCrcRef + sizeof(MemTestCrcRef) - 1u) <= (CPU_ADDR)endaddr)){
+		memTestRefOfs = (INT32U)((CPU_ADDR)&MemTestCrcRef - (CPU_ADDR)startaddr);
+	}else{
+		memTestRefOfs = MEMTEST_REF_OUTSIDE;	//nothing to skip
+	}
+	memTestProgress = 0;
+	memTestStatus = MEMTEST_PENDING;
+
+	OSFlagCreate(&memTestFlags, "MemTest Flags", (OS_FLAGS)0, &os_err);
+
+	OSTaskCreate(&memTestTaskTCB,
+				 "MemTest Task",
+				 memTestTask,
+				 (void *) 0,
+				 APP_CFG_MEMTEST_TASK_PRIO,
+				 &memTestTaskStk[0],
+				 (APP_CFG_MEMTEST_TASK_STK_SIZE / 10u),
+				 APP_CFG_MEMTEST_TASK_STK_SIZE,
+				 0,
+				 0,
+				 (void *) 0,
+				 (OS_OPT_TASK_STK_CHK | OS_OPT_TASK_STK_CLR),
+				 &os_err);
+}
+
+/*
+ * memTestTask() - CRC-32s the image one chunk per tick, then compares it with
+ *	MemTestCrcRef. The four bytes of MemTestCrcRef are skipped, as
+ *	tools/memtest_crc_ref.py skips them. Runs below every application task
+ *	and never masks interrupts, so the DMA output stream is not delayed.
+ *	Repeats every APP_CFG_MEMTEST_PERIOD_MS, or deletes itself after one
+ *	pass if that is 0.
+ */
+static void memTestTask(void *p_arg){
+	OS_ERR os_err;
+	INT32U ofs;
+	INT32U chunk;
+	INT32U crc;
+	INT32U crc_ref;
+	(void)p_arg;
+
+	while(1){
+		ofs = 0;
+		crc = MEMTEST_CRC32_INIT;
+		memTestProgress = 0;
+		while (ofs < memTestLen){
+			chunk = memTestLen - ofs;
+			if (chunk > MEMTEST_CHUNK_BYTES){
+				chunk = MEMTEST_CHUNK_BYTES;
+			}
+			if ((ofs < memTestRefOfs) && ((memTestRefOfs - ofs) < chunk)){
+				chunk = memTestRefOfs - ofs;	//stop short of the reference
+			}
+			crc = MemTestCrc32(crc, memTestStart + ofs, chunk);
+			ofs += chunk;
+			if (ofs == memTestRefOfs){
+				ofs += sizeof(MemTestCrcRef);	//and step over it
+			}
+			memTestProgress = (INT8U)(((INT64U)ofs * 100u) / memTestLen);
+			OSTimeDly(1, OS_OPT_TIME_DLY, &os_err);	//let the stat and idle tasks run
+		}
+		crc ^= MEMTEST_CRC32_XOR;
+
+		crc_ref = *(const volatile INT32U *)&MemTestCrcRef;	//as stored by the post-build step
+		memTestCrc = crc;
+		if (crc_ref == MEMTEST_CRC_REF_NONE){
+			memTestStatus = MEMTEST_NO_REF;	//post-build step did not run
+		}else{
+			memTestStatus = (crc == crc_ref) ? MEMTEST_PASS : MEMTEST_FAIL;
+		}
+		OSFlagPost(&memTestFlags, MEMTEST_FLAG_DONE, OS_OPT_POST_FLAG_SET, &os_err);
+
+		if (MEMTEST_PERIOD_TICKS == 0){
+			OSTaskDel((OS_TCB *)0, &os_err);
+		}
+		OSTimeDly(MEMTEST_PERIOD_TICKS, OS_OPT_TIME_DLY, &os_err);
+	}
+}
+
+/*
+ * MemTestProgressGet() - Percent of the current pass done.
+ */
+INT8U MemTestProgressGet(void){
+	return memTestProgress;
+}
+
+/*
+ * MemTestStatusGet() - Result and CRC-32 of the last completed pass.
+ */
+MEMTEST_STATUS MemTestStatusGet(INT32U *crc){
+	if (crc != (INT32U *)0){
+		*crc = memTestCrc;
+	}
+	return memTestStatus;
+}
+
+/*
+ * MemTestPend() - Pends until the first pass has finished, then returns its
+ *	result. Returns at once on every later call.
+ */
+MEMTEST_STATUS MemTestPend(OS_TICK tout, OS_ERR *os_err){
+	(void)OSFlagPend(&memTestFlags, MEMTEST_FLAG_DONE, tout,
+					 (OS_OPT_PEND_FLAG_SET_ANY | OS_OPT_PEND_BLOCKING), (CPU_TS *)0, os_err);
+	return memTestStatus;
 }
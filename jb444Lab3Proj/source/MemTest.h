@@ -3,13 +3,58 @@
  *	Header file for MemTest which has a prototype of CalcChkSum
  *  Created on: Oct 19, 2020
  *      Author: August
+ *
+ *  Also declares the background flash integrity task. It CRC-32s the
+ *  image in chunks at low priority so boot does not wait on it.
+ *
+ *  Optional app_cfg.h settings:
+ *     APP_CFG_MEMTEST_TASK_PRIO      (default 28, below every app task)
+ *     APP_CFG_MEMTEST_TASK_STK_SIZE  (default 128)
+ *     APP_CFG_MEMTEST_PERIOD_MS      re-verify period, 0 = once (default 60000)
+ *
+ *  The expected CRC-32 is MemTestCrcRef, written into the image by the
+ *  post-build step tools/memtest_crc_ref.py. Until then it is erased and
+ *  every pass reports MEMTEST_NO_REF.
  */
 
 #ifndef MEMTEST_H_
 #define MEMTEST_H_
 
+#ifndef APP_CFG_MEMTEST_TASK_PRIO
+#define APP_CFG_MEMTEST_TASK_PRIO       28u
+#endif
+#ifndef APP_CFG_MEMTEST_TASK_STK_SIZE
+#define APP_CFG_MEMTEST_TASK_STK_SIZE   128u
+#endif
+#ifndef APP_CFG_MEMTEST_PERIOD_MS
+#define APP_CFG_MEMTEST_PERIOD_MS       60000u
+#endif
+
+#define MEMTEST_CRC32_INIT  0xFFFFFFFFu     /* Seed for MemTestCrc32()     */
+#define MEMTEST_CRC32_XOR   0xFFFFFFFFu     /* Final XOR of a finished CRC */
+#define MEMTEST_CRC_REF_NONE 0xFFFFFFFFu    /* MemTestCrcRef not written   */
+
+typedef enum {
+    MEMTEST_PENDING,        /* First pass not finished yet */
+    MEMTEST_PASS,           /* Last pass matched the reference */
+    MEMTEST_FAIL,           /* Last pass did not match the reference */
+    MEMTEST_NO_REF          /* Image has no reference, nothing to compare */
+} MEMTEST_STATUS;
+
+/********************************************************************
+* MemTestCrcRef - Reference CRC-32 of the image, in flash. The CRC
+*                 skips these four bytes, so the post-build step can
+*                 write it without changing the CRC. Read it through
+*                 a volatile pointer, the compiler only knows the
+*                 erased value.
+********************************************************************/
+extern const INT32U MemTestCrcRef;
+
 /********************************************************************
-* BIOGetStrg() - Calculates the checksum between two addresses.
+* CalcChkSum() - Calculates the checksum between two addresses.
+*                The 16-bit byte sum is a quick check, a few ms over
+*                the whole flash. It is shown at boot while the
+*                CRC-32 pass runs.
 *
 * Return value: The calculated checksum from start to end address
 *
@@ -18,4 +63,40 @@
 ********************************************************************/
 INT16U CalcChkSum(INT8U *startaddr, INT8U *endaddr);
 
+/********************************************************************
+* MemTestCrc32() - Continues a CRC-32 (IEEE 802.3, reflected) over
+*                  nbytes at addr.
+*
+* Return value: The updated CRC register. Start with MEMTEST_CRC32_INIT
+*               and XOR the final value with MEMTEST_CRC32_XOR.
+*               Chunks may be any size, the result does not depend
+*               on how the range is split.
+********************************************************************/
+INT32U MemTestCrc32(INT32U crc, const INT8U *addr, INT32U nbytes);
+
+/********************************************************************
+* MemTestInit() - Starts the background integrity task over
+*                 startaddr to endaddr, inclusive. Returns at once.
+********************************************************************/
+void MemTestInit(INT8U *startaddr, INT8U *endaddr);
+
+/********************************************************************
+* MemTestProgressGet() - Percent (0-100) of the current pass done.
+********************************************************************/
+INT8U MemTestProgressGet(void);
+
+/********************************************************************
+* MemTestStatusGet() - Result of the last completed pass. *crc gets
+*                      the CRC-32 of that pass if crc is not null.
+********************************************************************/
+MEMTEST_STATUS MemTestStatusGet(INT32U *crc);
+
+/********************************************************************
+* MemTestPend() - Pends until the first pass finishes and returns
+*                 its result. Returns at once after that.
+*                 tout - timeout in ticks, 0 waits forever
+*                 Error codes are identical to OSFlagPend()
+********************************************************************/
+MEMTEST_STATUS MemTestPend(OS_TICK tout, OS_ERR *os_err);
+
 #endif /* MEMTEST_H_ */
@@ -5,6 +5,9 @@
 *
 * Jacob Bindernagel
 * 3/11/2021
+*
+* Each output task blocks on the OutputEvents flag group, with the sine task also waiting
+* for DMA blocks, and wakes with the mask of what happened. Neither task polls the mode.
 *****************************************************************************************/
 #include "app_cfg.h"
 #include "os.h"
@@ -55,16 +58,12 @@ static CPU_STK SquareOutputTaskStk[APP_CFG_SQUARE_GEN_STK_SIZE];
 #define ABS_VAL_MASK       0x7FFFFFFF
 #define DC_OFFSET 2048
 
-typedef struct{
-    INT8U index;
-    OS_SEM flag;
-}DMA_BLOCK_RDY;
-
 /******************************************************************************************
  * Variables
  ******************************************************************************************/
- DMA_BLOCK_RDY dmaInBlockRdy;
+ static volatile INT8U dmaInBlockIndex;
  static INT16S DMABuffer[NUM_BLOCKS][SAMPLES_PER_BLOCK];
+ static OS_FLAG_GRP OutputEvents;
 
 /*****************************************************************************************
 * Task Function Prototypes.
@@ -72,7 +71,7 @@ typedef struct{
 *****************************************************************************************/
 static void SquareOutputTask(void *p_arg);
 static void SineOutputTask(void *p_arg);
-static INT8U DMAPend(OS_TICK tout, OS_ERR *os_err_ptr);
+static OS_FLAGS OutputEventPend(OS_FLAGS events, OS_TICK tout, OS_ERR *os_err_ptr);
 void DMA0_DMA16_IRQHandler(void);
 
 void OutputInit(void){
@@ -82,13 +81,15 @@ void OutputInit(void){
     SIM->SCGC5 |= SIM_SCGC5_PORTE(1); /* Enable clock gate for PORTE */
     PORTE->PCR[8] = PORT_PCR_MUX(6); /* Set PCR for FTM output */
 
-    // dmaInBlockRdy.index indicates the buffer currently not being used by the DMA in the Ping-Pong scheme.
+    OSFlagCreate(&OutputEvents, "Output Events", (OS_FLAGS)0, &os_err);
+
+    // dmaInBlockIndex indicates the buffer currently not being used by the DMA in the Ping-Pong scheme.
     // This is a bit more open loop than I like but there doesn't seem to be a status bit that
     // distinguishes between a half-full interrupt,INTHALF, and a full interrupt, INTMAJOR.
     // Bottom line, this has to start at one. The DMA fills the [0] block first so, by the time
     // the HALFINT happens, it is working on the [1] block. The ISR toggles the initial value to
     // zero so the [0] block is processed first.
-    dmaInBlockRdy.index = 1;
+    dmaInBlockIndex = 1;
 
     //enable DMA clocks
     SIM->SCGC6 |= SIM_SCGC6_DMAMUX(1);
@@ -154,8 +155,8 @@ void OutputInit(void){
                     (void *) 0,
                     APP_CFG_SIN_GEN_TASK_PRIO,
                     &SineOutputTaskStk[0],
-                    (APP_CFG_SQUARE_GEN_STK_SIZE / 10u),
-                    APP_CFG_SQUARE_GEN_STK_SIZE,
+                    (APP_CFG_SIN_GEN_TASK_STK_SIZE / 10u),
+                    APP_CFG_SIN_GEN_TASK_STK_SIZE,
                     0,
                     0,
                     (void *) 0,
@@ -175,6 +176,20 @@ void OutputInit(void){
                      (void *) 0,
                      OS_OPT_TASK_NONE,
                      &os_err);
+
+#if (OS_CFG_TASK_BUDGET_EN == DEF_ENABLED)
+    //A parameter storm cannot keep the square task ready at its priority and
+    //starve the memory test
+    OSTaskBudgetSet(&SquareOutputTaskTCB, APP_CFG_SQUARE_GEN_BUDGET,
+                    APP_CFG_SQUARE_GEN_BUDGET_PERIOD, APP_CFG_OUTPUT_PRIO_LOW, &os_err);
+#endif
+#if (OS_CFG_EDF_EN == DEF_ENABLED)
+    //The sine task shares the UI's band, so a burst of UI work cannot hold
+    //it past the next DMA block
+    OSTaskChangePrio(&SineOutputTaskTCB, APP_CFG_EDF_BAND_PRIO, &os_err);
+    OSTaskEdfSet(&SineOutputTaskTCB, APP_CFG_SIN_GEN_PERIOD,
+                 APP_CFG_SIN_GEN_DEADLINE, &os_err);
+#endif
 }
 
 /******************************************************************************
@@ -197,15 +212,24 @@ static void SineOutputTask(void *p_arg){
 	INT32U vol;
 	q31_t sine_value;
 	STATE mode;
+	OS_FLAGS events;
 	(void) p_arg;
+	mode = UIStateGet();
 	while(1){
 		DB1_TURN_OFF();
-		mode = UIStateGet();
-		DB1_TURN_ON();
 		if(mode == SINEWAVE_MODE){
+			events = OutputEventPend(OUT_EV_SINE_MODE | OUT_EV_DMA_BLOCK, 0, &os_err);
+		}else{
+			events = OutputEventPend(OUT_EV_SINE_MODE, 0, &os_err);
+		}
+		DB1_TURN_ON();
+		if((events & OUT_EV_SINE_MODE) != 0){
+			mode = UIStateGet();
+		}else{}
+		if(((events & OUT_EV_DMA_BLOCK) != 0) && (mode == SINEWAVE_MODE)){
 			freq = UIFreqGet();
 			vol = UILevGet();
-			buffer_index = DMAPend(0, &os_err);
+			buffer_index = dmaInBlockIndex;
 			xarg_inc = freq*SAMPLE_PERIOD_Q31;
 			while (sample_index < SAMPLES_PER_BLOCK){
 				sine_value = arm_sin_q31(xarg); //Computes sine wave value
@@ -217,10 +241,7 @@ static void SineOutputTask(void *p_arg){
 				sample_index++;
 			}
 		sample_index = 0;
-		}
-		else{
-			mode = SinePend(0, &os_err);
-		}
+		}else{}
 	}
 }
 
@@ -278,10 +299,9 @@ static void  SquareOutputTask(void *p_arg){
 			duty = ((INT32U)mod * (INT32U)vol) / MAX_VOL;
 			//Set signal pulse width (duty cycle)
 			FTM3->CONTROLS[3].CnV = FTM_CnV_VAL((INT16U)duty);
-		}
-		else{
-			mode = SquarePend(0, &os_err);
-		}
+		}else{}
+		//Sleeps until the mode, frequency or level changes
+		(void)OutputEventPend(OUT_EV_SQUARE_MODE | OUT_EV_SQUARE_PARAM, 0, &os_err);
 	}
 }
 
@@ -295,18 +315,28 @@ void DMA0_DMA16_IRQHandler(void){
 	OSIntEnter();
 	DB1_TURN_ON();
 	DMA0->CINT = DMA_CINT_CINT(DMA_OUT_CH);
-	dmaInBlockRdy.index ^= 1;                            //toggle buffer index
-	OSSemPost(&(dmaInBlockRdy.flag),OS_OPT_POST_1,&os_err);
+	dmaInBlockIndex ^= 1;                                //toggle buffer index
+	OSFlagPost(&OutputEvents, OUT_EV_DMA_BLOCK, OS_OPT_POST_FLAG_SET, &os_err);
 	DB1_TURN_OFF();
 	OSIntExit();
 }
 
 /****************************************************************************************
-* DMA Interrupt Handler for the sample stream
-* 08/30/2015 TDM
+* OutputEventPend - Blocks until any of 'events' is set, consumes them and returns
+* the ones that were set. A DMA block that completes while the sine task is busy
+* is seen once, with dmaInBlockIndex already pointing at the free block.
+***************************************************************************************/
+static OS_FLAGS OutputEventPend(OS_FLAGS events, OS_TICK tout, OS_ERR *os_err_ptr){
+	return OSFlagPend(&OutputEvents, events, tout,
+					  (OS_OPT_PEND_FLAG_SET_ANY | OS_OPT_PEND_FLAG_CONSUME | OS_OPT_PEND_BLOCKING),
+					  (CPU_TS *)0, os_err_ptr);
+}
+
+/****************************************************************************************
+* OutputEventPost - Sets events for the output tasks, see OutputModule.h
 ***************************************************************************************/
-static INT8U DMAPend(OS_TICK tout, OS_ERR *os_err_ptr){
-	OSSemPend(&(dmaInBlockRdy.flag), tout, OS_OPT_PEND_BLOCKING,(void *)0, os_err_ptr);
-	return dmaInBlockRdy.index;
+void OutputEventPost(OS_FLAGS events){
+	OS_ERR os_err;
+	(void)OSFlagPost(&OutputEvents, events, OS_OPT_POST_FLAG_SET, &os_err);
 }
 
@@ -3,12 +3,59 @@
  *
  *  Created on: Mar 5, 2021
  *      Author: Ligma
+ *
+ *  The output tasks block on one event flag group and wake with the mask of
+ *  sources that are ready. UserInt.c posts the mode and parameter events,
+ *  the DMA interrupt posts OUT_EV_DMA_BLOCK.
  */
 
 #ifndef OUTPUTMODULE_H_
 #define OUTPUTMODULE_H_
+
+#include "MCUType.h"
+#include "os.h"
+
+#define OUT_EV_SINE_MODE    0x01u   /* Mode changed, for the sine task      */
+#define OUT_EV_SQUARE_MODE  0x02u   /* Mode changed, for the square task    */
+#define OUT_EV_SQUARE_PARAM 0x04u   /* Frequency or level changed (square)  */
+#define OUT_EV_DMA_BLOCK    0x08u   /* DMA finished a block (sine)          */
+#define OUT_EV_MODE         (OUT_EV_SINE_MODE | OUT_EV_SQUARE_MODE)
+
+/* CPU budget of the square task, see os_budget.c. It may use 'BUDGET'
+ * ticks per 'PERIOD' ticks at its own priority, then drops to
+ * APP_CFG_OUTPUT_PRIO_LOW, below the memory test, until its time is given
+ * back. The timer task shares that priority but has no timers to run.
+ * The sine task has no budget: it must finish each DMA block, and a
+ * demotion would make it miss the next one.
+ */
+#ifndef APP_CFG_SQUARE_GEN_BUDGET
+#define APP_CFG_SQUARE_GEN_BUDGET       1u
+#endif
+#ifndef APP_CFG_SQUARE_GEN_BUDGET_PERIOD
+#define APP_CFG_SQUARE_GEN_BUDGET_PERIOD 10u
+#endif
+#ifndef APP_CFG_OUTPUT_PRIO_LOW
+#define APP_CFG_OUTPUT_PRIO_LOW         29u
+#endif
+
+/* Deadline of the sine task in the EDF band, see os_edf.c and UserInt.h.
+ * A job is released per DMA block and is due before the next one.
+ */
+#ifndef APP_CFG_SIN_GEN_PERIOD
+#define APP_CFG_SIN_GEN_PERIOD          21u
+#endif
+#ifndef APP_CFG_SIN_GEN_DEADLINE
+#define APP_CFG_SIN_GEN_DEADLINE        21u
+#endif
+
 void OutputInit(void);
 void DMA0_DMA16_IRQHandler(void);
 
+/********************************************************************
+* OutputEventPost() - Sets events for the output tasks. Each task
+*                     consumes its own bits, so post OUT_EV_MODE to
+*                     reach both.
+********************************************************************/
+void OutputEventPost(OS_FLAGS events);
 
 #endif /* OUTPUTMODULE_H_ */
@@ -1,7 +1,8 @@
 /*******************************************************************************
 * UserInt.c -
 * Receives Inputs and Displays on the LCD then forwards values to Output module
-* via Mutexes
+* via Mutexes. Each change is signalled with OutputEventPost() so the output
+* tasks only wake when there is something new.
 *
 * Rachel Givens 03/14/2020
 *******************************************************************************/
@@ -14,6 +15,7 @@
 #include "LcdLayered.h"
 #include "uCOSKey.h"
 #include "input.h"
+#include "OutputModule.h"
 
 #define ASCII_SHIFT 48
 #define MAX_DIGITS 5
@@ -115,6 +117,18 @@ void UIInit(void){
     OSMutexCreate(&VolumeKey, "Volume", &os_err);
     OSMutexCreate(&StateKey, "State", &os_err);
 
+#if (OS_CFG_EDF_EN == DEF_ENABLED)
+    //Move the UI tasks into the EDF band they share with the sine task
+    OSTaskChangePrio(&uiFreqTaskTCB, APP_CFG_EDF_BAND_PRIO, &os_err);
+    OSTaskEdfSet(&uiFreqTaskTCB, 0, APP_CFG_UI_DEADLINE, &os_err);
+    OSTaskChangePrio(&uiDispTaskTCB, APP_CFG_EDF_BAND_PRIO, &os_err);
+    OSTaskEdfSet(&uiDispTaskTCB, 0, APP_CFG_UI_DEADLINE, &os_err);
+    OSTaskChangePrio(&uiVolTaskTCB, APP_CFG_EDF_BAND_PRIO, &os_err);
+    OSTaskEdfSet(&uiVolTaskTCB, 0, APP_CFG_UI_DEADLINE, &os_err);
+    OSTaskChangePrio(&uiStateTaskTCB, APP_CFG_EDF_BAND_PRIO, &os_err);
+    OSTaskEdfSet(&uiStateTaskTCB, 0, APP_CFG_UI_DEADLINE, &os_err);
+#endif
+
 }
 
 /******************************************************************************
@@ -135,12 +149,12 @@ void uiFreqTask(void *p_arg){
     while(1){
         DB3_TURN_OFF();
         inKeyBufferFreq = getInKeyPend(1, 0, &os_err);
-        LcdDispClear(APP_LAYER_TYPE);
+        LcdDispClearAsync(APP_LAYER_TYPE);
         for (int i = 0; i < KEY_LEN; i++){
             if (inKeyBufferFreq[i] != 0){
-                LcdDispChar(LCD_ROW_2,5-i,APP_LAYER_FREQ,inKeyBufferFreq[i]);
+                LcdDispCharAsync(LCD_ROW_2,5-i,APP_LAYER_FREQ,inKeyBufferFreq[i]);
             }else{
-                LcdDispChar(LCD_ROW_2,5-i,APP_LAYER_FREQ,' ');
+                LcdDispCharAsync(LCD_ROW_2,5-i,APP_LAYER_FREQ,' ');
             }
         }
         DB3_TURN_ON();
@@ -172,12 +186,12 @@ void uiDispTask(void *p_arg){
         inKeyBuffer =  getInKeyPend(0, 0, &os_err);
         for (int i = 0; i < KEY_LEN; i++){
             if (inKeyBuffer[i] != 0){
-                LcdDispChar(LCD_ROW_1,5-i,APP_LAYER_FREQ,inKeyBuffer[i]);
+                LcdDispCharAsync(LCD_ROW_1,5-i,APP_LAYER_FREQ,inKeyBuffer[i]);
             }else{
-                LcdDispChar(LCD_ROW_1,5-i,APP_LAYER_FREQ,' ');
+                LcdDispCharAsync(LCD_ROW_1,5-i,APP_LAYER_FREQ,' ');
             }
         }
-        LcdDispString(LCD_ROW_1,LCD_COL_7,APP_LAYER_FREQ,"Hz");
+        LcdDispStringAsync(LCD_ROW_1,LCD_COL_7,APP_LAYER_FREQ,"Hz");
         //Converts each char into it's true value
         while(key_index <= MAX_DIGITS){
             if(inKeyBuffer[key_index] != 0){
@@ -193,6 +207,7 @@ void uiDispTask(void *p_arg){
         OSMutexPend(&FrequencyKey, 0, OS_OPT_PEND_BLOCKING, (void *)0, &os_err);
         Frequency = freq_comps[4]*10000 + freq_comps[3]*1000 + freq_comps[2]*100 + freq_comps[1]*10 + freq_comps[0];
         OSMutexPost(&FrequencyKey, OS_OPT_POST_NONE, &os_err);
+        OutputEventPost(OUT_EV_SQUARE_PARAM);
         DB4_TURN_ON();
     }
 }
@@ -211,18 +226,18 @@ void uiVolTask(void *p_arg){
     while(1){
         DB5_TURN_OFF();
         inLevel = getInLevPend(0, &os_err);
-        LcdDispClear(APP_LAYER_VOL);
+        LcdDispClearAsync(APP_LAYER_VOL);
         switch(uiStateCntrl){
         case SINEWAVE_MODE:
-            LcdDispDecWord(LCD_ROW_1, LCD_COL_15,APP_LAYER_VOL,inLevel,2,LCD_DEC_MODE_AR);
+            LcdDispDecWordAsync(LCD_ROW_1, LCD_COL_15,APP_LAYER_VOL,inLevel,2,LCD_DEC_MODE_AR);
         break;
         case PULSETRAIN_MODE:
             if((inLevel <= 19) && (inLevel >= 2)){
-                LcdDispDecWord(LCD_ROW_1,LCD_COL_14,APP_LAYER_VOL,DutyCycle[inLevel],2,LCD_DEC_MODE_AR);
+                LcdDispDecWordAsync(LCD_ROW_1,LCD_COL_14,APP_LAYER_VOL,DutyCycle[inLevel],2,LCD_DEC_MODE_AR);
             }else if(inLevel <= 1){
-                LcdDispDecWord(LCD_ROW_1,LCD_COL_15,APP_LAYER_VOL,DutyCycle[inLevel],1,LCD_DEC_MODE_AR);
+                LcdDispDecWordAsync(LCD_ROW_1,LCD_COL_15,APP_LAYER_VOL,DutyCycle[inLevel],1,LCD_DEC_MODE_AR);
             }else{
-                LcdDispDecWord(LCD_ROW_1,LCD_COL_13,APP_LAYER_VOL,DutyCycle[inLevel],3,LCD_DEC_MODE_AR);
+                LcdDispDecWordAsync(LCD_ROW_1,LCD_COL_13,APP_LAYER_VOL,DutyCycle[inLevel],3,LCD_DEC_MODE_AR);
             }
             break;
         default:
@@ -231,6 +246,7 @@ void uiVolTask(void *p_arg){
         OSMutexPend(&VolumeKey, 0, OS_OPT_PEND_BLOCKING, (void *)0, &os_err);
         Lev = inLevel;
         OSMutexPost(&VolumeKey, OS_OPT_POST_NONE, &os_err);
+        OutputEventPost(OUT_EV_SQUARE_PARAM);
     }
     DB5_TURN_ON();
 }
@@ -248,26 +264,27 @@ void uiStateTask(void *p_arg){
 
     while(1){
         uiStateCntrl = getInStatePend(0, &os_err);
-        LcdDispClear(APP_LAYER_VOL);
-        LcdDispClear(APP_LAYER_UNIT);
+        LcdDispClearAsync(APP_LAYER_VOL);
+        LcdDispClearAsync(APP_LAYER_UNIT);
         if(uiStateCntrl == PULSETRAIN_MODE){
             if((inLevel <= 19) && (inLevel >= 2)){
-                LcdDispDecWord(LCD_ROW_1,LCD_COL_14,APP_LAYER_VOL,DutyCycle[inLevel],2,LCD_DEC_MODE_AR);
+                LcdDispDecWordAsync(LCD_ROW_1,LCD_COL_14,APP_LAYER_VOL,DutyCycle[inLevel],2,LCD_DEC_MODE_AR);
             }else if(inLevel <= 1){
-                LcdDispDecWord(LCD_ROW_1,LCD_COL_15,APP_LAYER_VOL,DutyCycle[inLevel],1,LCD_DEC_MODE_AR);
+                LcdDispDecWordAsync(LCD_ROW_1,LCD_COL_15,APP_LAYER_VOL,DutyCycle[inLevel],1,LCD_DEC_MODE_AR);
             }else{
-                LcdDispDecWord(LCD_ROW_1,LCD_COL_13,APP_LAYER_VOL,DutyCycle[inLevel],3,LCD_DEC_MODE_AR);
+                LcdDispDecWordAsync(LCD_ROW_1,LCD_COL_13,APP_LAYER_VOL,DutyCycle[inLevel],3,LCD_DEC_MODE_AR);
             }
-            LcdDispString(LCD_ROW_1,LCD_COL_16,APP_LAYER_UNIT,"%");
+            LcdDispStringAsync(LCD_ROW_1,LCD_COL_16,APP_LAYER_UNIT,"%");
         }else if(uiStateCntrl == SINEWAVE_MODE){
-            LcdDispDecWord(LCD_ROW_1, LCD_COL_15,APP_LAYER_VOL,inLevel,2,LCD_DEC_MODE_AR);
-            LcdDispString(LCD_ROW_1,LCD_COL_16,APP_LAYER_UNIT," ");
+            LcdDispDecWordAsync(LCD_ROW_1, LCD_COL_15,APP_LAYER_VOL,inLevel,2,LCD_DEC_MODE_AR);
+            LcdDispStringAsync(LCD_ROW_1,LCD_COL_16,APP_LAYER_UNIT," ");
         }else{
             // do nothing
         }
         OSMutexPend(&StateKey, 0, OS_OPT_PEND_BLOCKING, (void *)0, &os_err);
         StateCntrl = uiStateCntrl;
         OSMutexPost(&StateKey, OS_OPT_POST_NONE, &os_err);
+        OutputEventPost(OUT_EV_MODE);
     }
 
 }
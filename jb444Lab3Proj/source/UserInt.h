@@ -12,6 +12,17 @@
 #include "os.h"
 #include "input.h"
 
+/* EDF band, see os_edf.c. The UI tasks and the sine task share one priority
+ * and the scheduler runs whichever is due first. A UI task is due
+ * APP_CFG_UI_DEADLINE ticks after it wakes.
+ */
+#ifndef APP_CFG_EDF_BAND_PRIO
+#define APP_CFG_EDF_BAND_PRIO   APP_CFG_UIF_TASK_PRIO
+#endif
+#ifndef APP_CFG_UI_DEADLINE
+#define APP_CFG_UI_DEADLINE     50u
+#endif
+
 void UIInit(void);
 INT16U UIFreqGet(void);
 INT8U UILevGet(void);
@@ -7,6 +7,9 @@
  *
  *  Edited by Jacob Bindernagel 3/14/2021
  *  - Added semaphore flags for the output tasks to pend on
+ *
+ *  The output tasks now get mode changes from UserInt.c through the
+ *  OutputEvents flag group, so the per-task mode semaphores are gone.
  */
 #include "app_cfg.h"
 #include "os.h"
@@ -36,8 +39,6 @@ typedef struct {
 typedef struct{
     STATE buffer;
     OS_SEM flag;
-    OS_SEM flag_square;
-    OS_SEM flag_sine;
 }CTRL_STATE;
 
 /*****************************************************************************************
@@ -77,8 +78,6 @@ void inputInit(void){
 	KeyInit();
 
 	OSSemCreate(&(CtrlState.flag),"Key Press Buffer",0,&os_err);
-	OSSemCreate(&(CtrlState.flag_square),"Key Press Buffer",0,&os_err);
-	OSSemCreate(&(CtrlState.flag_sine),"Key Press Buffer",0,&os_err);
 	CtrlState.buffer = WAITING_MODE;
 	OSSemCreate(&(inKeyBuffer.flag),"Key Press Buffer",0,&os_err);
 	OSSemCreate(&(inKeyBuffer.enter),"Key Press Enter",0,&os_err);
@@ -143,7 +142,6 @@ static void inKeyTask(void *p_arg){
 			OSSemPost(&(inKeyBuffer.flag),OS_OPT_POST_NONE,&os_err);
 			CtrlState.buffer = SINEWAVE_MODE;
 			OSSemPost(&(CtrlState.flag),OS_OPT_POST_NONE,&os_err);
-			OSSemPost(&(CtrlState.flag_sine),OS_OPT_POST_NONE,&os_err);
 		break;
 		case DC2:		//'B' changes CtrlState semaphore to square wave mode
 			for (int i = 0; i < KEY_LEN; i++){
@@ -152,7 +150,6 @@ static void inKeyTask(void *p_arg){
 			OSSemPost(&(inKeyBuffer.flag),OS_OPT_POST_NONE,&os_err);
 			CtrlState.buffer = PULSETRAIN_MODE;
 			OSSemPost(&(CtrlState.flag),OS_OPT_POST_NONE,&os_err);
-			OSSemPost(&(CtrlState.flag_square),OS_OPT_POST_NONE,&os_err);
 		break;
 		case DC3:		//'C' changes CtrlState semaphore to idle mode
 			for (int i = 0; i < KEY_LEN; i++){
@@ -249,13 +246,3 @@ STATE getInStatePend(INT16U tout, OS_ERR *os_err){
 	OSSemPend(&(CtrlState.flag),tout, OS_OPT_PEND_BLOCKING, (CPU_TS *)0, os_err);
 	return CtrlState.buffer;
 }
-
-STATE SinePend(INT16U tout, OS_ERR *os_err){
-    OSSemPend(&(CtrlState.flag_sine),tout, OS_OPT_PEND_BLOCKING, (CPU_TS *)0, os_err);
-    return CtrlState.buffer;
-}
-
-STATE SquarePend(INT16U tout, OS_ERR *os_err){
-    OSSemPend(&(CtrlState.flag_square),tout, OS_OPT_PEND_BLOCKING, (CPU_TS *)0, os_err);
-    return CtrlState.buffer;
-}
@@ -15,6 +15,7 @@
 *****************************************************************************************/
 #include "app_cfg.h"
 #include "os.h"
+#include "os_app_hooks.h"
 #include "MCUType.h"
 #include "K65TWR_ClkCfg.h"
 #include "K65TWR_GPIO.h"
@@ -23,6 +24,7 @@
 #include "input.h"
 #include "UserInt.h"
 #include "OutputModule.h"
+#include "K65TWR_OSTick.h"
 
 #define LOWADDR (INT32U) 0x00000000			//low memory address
 #define HIGHADRR (INT32U) 0x001FFFFF		//high memory address
@@ -50,8 +52,10 @@ void main(void) {
 
 	K65TWR_BootClock();
 	CPU_IntDis();               /* Disable all interrupts, OS will enable them  */
+	CPU_Init();                 /* Starts the DWT timestamp timer (K65TWR_TS.c)  */
 
 	OSInit(&os_err);                    /* Initialize uC/OS-III                         */
+	App_OS_SetAllHooks();               /* After OSInit(), which clears them            */
 
 	OSTaskCreate(&AppTaskStartTCB,                  /* Address of TCB assigned to task */
 				 "Start Task",                      /* Name you want to give the task */
@@ -79,30 +83,52 @@ void main(void) {
 *****************************************************************************************/
 static void AppStartTask(void *p_arg) {
 	OS_ERR os_err;
-	INT8U math_val;
+	MEMTEST_STATUS status;
+	INT16U chksum;
+	INT32U crc;
 	(void)p_arg;                        /* Avoid compiler warning for unused variable   */
 
+#if (OS_CFG_DYN_TICK_EN == DEF_ENABLED)
+	BSP_OS_TickInitFreq(BSP_OS_TICK_BUS_FREQ);	//tickless, the PIT interrupts only when a delay is due
+#else
 	OS_CPU_SysTickInitFreq(SYSTEM_CLOCK);
+#endif
 
 	/* Initialize StatTask. This must be called when there is only one task running.
 	 * Therefore, any function call that creates a new task must come after this line.
 	 * Or, alternatively, you can comment out this line, or remove it. If you do, you
 	 * will not have accurate CPU load information                                       */
-//    OSStatTaskCPUUsageInit(&os_err);
+	OSStatTaskCPUUsageInit(&os_err);
 
 	LcdInit();
-	//Initial program checksum, which is displayed on the second row of the LCD
-	math_val = CalcChkSum((INT8U *)LOWADDR,(INT8U *)HIGHADRR);
-	LcdDispString(LCD_ROW_2,LCD_COL_1,APP_LAYER_CHKSUM,"CS: ");
-	LcdDispByte(LCD_ROW_2,LCD_COL_4,APP_LAYER_CHKSUM,(INT8U)math_val);
-	LcdDispByte(LCD_ROW_2,LCD_COL_6,APP_LAYER_CHKSUM,(INT8U)(math_val << 8));	//display first byte then <<8 and display next byte
-	OSTimeDly(3000, OS_OPT_TIME_PERIODIC, &os_err); // delay 3000 ms as per spec
-	LcdDispClear(APP_LAYER_CHKSUM);
+	//Quick check: the byte sum of the image takes a few ms, so show it right away
+	chksum = CalcChkSum((INT8U *)LOWADDR,(INT8U *)HIGHADRR);
+	LcdDispString(LCD_ROW_2,LCD_COL_1,APP_LAYER_CHKSUM,"CS:");
+	LcdDispByte(LCD_ROW_2,LCD_COL_4,APP_LAYER_CHKSUM,(INT8U)(chksum >> 8));
+	LcdDispByte(LCD_ROW_2,LCD_COL_6,APP_LAYER_CHKSUM,(INT8U)chksum);
+	MemTestInit((INT8U *)LOWADDR,(INT8U *)HIGHADRR);	//flash CRC runs in the background, boot does not wait
 
 	GpioDBugBitsInit();
 	inputInit();
 	UIInit();
 	OutputInit();
 
+	//Once the first pass is done, show the image CRC-32 in its place for 3 s
+	status = MemTestPend(0, &os_err);
+	(void)MemTestStatusGet(&crc);
+	LcdDispClrLine(LCD_ROW_2,APP_LAYER_CHKSUM);
+	LcdDispString(LCD_ROW_2,LCD_COL_1,APP_LAYER_CHKSUM,"CRC:");
+	LcdDispByte(LCD_ROW_2,LCD_COL_5,APP_LAYER_CHKSUM,(INT8U)(crc >> 24));
+	LcdDispByte(LCD_ROW_2,LCD_COL_7,APP_LAYER_CHKSUM,(INT8U)(crc >> 16));
+	LcdDispByte(LCD_ROW_2,LCD_COL_9,APP_LAYER_CHKSUM,(INT8U)(crc >> 8));
+	LcdDispByte(LCD_ROW_2,LCD_COL_11,APP_LAYER_CHKSUM,(INT8U)crc);
+	if(status == MEMTEST_FAIL){
+		LcdDispString(LCD_ROW_2,LCD_COL_14,APP_LAYER_CHKSUM,"BAD");
+	}else if(status == MEMTEST_NO_REF){
+		LcdDispString(LCD_ROW_2,LCD_COL_14,APP_LAYER_CHKSUM,"N/R");	//no reference in the image
+	}else{}
+	OSTimeDly(3000, OS_OPT_TIME_PERIODIC, &os_err); // delay 3000 ms as per spec
+	LcdDispClear(APP_LAYER_CHKSUM);
+
 	OSTaskDel((OS_TCB *)0, &os_err);
 }
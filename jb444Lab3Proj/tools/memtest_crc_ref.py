@@ -0,0 +1,123 @@
+#!/usr/bin/env python3
+"""Store the reference CRC-32 of the flash image in the image itself.
+
+memTestTask (source/MemTest.c) CRC-32s the flash from LOWADDR to HIGHADRR
+and compares the result with MemTestCrcRef, a word in flash that the
+compiler leaves erased (0xFFFFFFFF, no reference). This is a post-build step
+(set in .cproject). From the build directory,
+
+    memtest_crc_ref.py jb444Lab3Proj.axf
+
+lays the loadable segments of the ELF over an erased flash, computes the
+CRC the task will compute, and writes it into MemTestCrcRef in the .axf.
+The CRC skips the four bytes of MemTestCrcRef, so storing it does not change
+it. --start and --end give the range when it is not the whole K65 flash.
+
+Exits with 1 if the image has no MemTestCrcRef in flash.
+"""
+
+import argparse
+import struct
+import sys
+import zlib
+
+SYMBOL = 'MemTestCrcRef'
+ERASED = 0xFF
+PT_LOAD = 1
+SHT_SYMTAB = 2
+
+EHDR = struct.Struct('<16sHHIIIIIHHHHHH')
+PHDR = struct.Struct('<IIIIIIII')
+SHDR = struct.Struct('<IIIIIIIIII')
+SYM = struct.Struct('<IIIBBH')
+
+
+def sections(elf):
+    """Yields (type, addr, offset, size, link, entsize) for each section."""
+    ehdr = EHDR.unpack_from(elf, 0)
+    shoff, shentsize, shnum = ehdr[6], ehdr[11], ehdr[12]
+    for i in range(shnum):
+        (_, sh_type, _, addr, offset, size, link, _, _, entsize) = SHDR.unpack_from(elf, shoff + i * shentsize)
+        yield sh_type, addr, offset, size, link, entsize
+
+
+def segments(elf):
+    """Yields (offset, vaddr, paddr, filesz) for each loadable segment."""
+    ehdr = EHDR.unpack_from(elf, 0)
+    phoff, phentsize, phnum = ehdr[5], ehdr[9], ehdr[10]
+    for i in range(phnum):
+        (p_type, offset, vaddr, paddr, filesz, _, _, _) = PHDR.unpack_from(elf, phoff + i * phentsize)
+        if p_type == PT_LOAD and filesz > 0:
+            yield offset, vaddr, paddr, filesz
+
+
+def symbol(elf, name):
+    """Returns the address of a symbol from the symbol table."""
+    secs = list(sections(elf))
+    for sh_type, _, offset, size, link, entsize in secs:
+        if sh_type != SHT_SYMTAB:
+            continue
+        strtab = secs[link][2]
+        for off in range(offset, offset + size, entsize):
+            st_name, value, _, _, _, _ = SYM.unpack_from(elf, off)
+            end = elf.index(b'\0', strtab + st_name)
+            if elf[strtab + st_name:end].decode('latin-1') == name:
+                return value
+    return None
+
+
+def file_offset(elf, addr):
+    """Returns the file offset and flash address of addr, or None if it is not loaded from flash."""
+    for offset, vaddr, paddr, filesz in segments(elf):
+        if vaddr <= addr < vaddr + filesz:
+            if vaddr != paddr:
+                return None
+            return offset + addr - vaddr, paddr + addr - vaddr
+    return None
+
+
+def flash_image(elf, start, end):
+    """Returns the flash from start to end, inclusive, as the board sees it after programming."""
+    image = bytearray([ERASED]) * (end - start + 1)
+    for offset, _, paddr, filesz in segments(elf):
+        lo = max(paddr, start)
+        hi = min(paddr + filesz, end + 1)
+        if lo < hi:
+            image[lo - start:hi - start] = elf[offset + lo - paddr:offset + hi - paddr]
+    return image
+
+
+def main(argv):
+    ap = argparse.ArgumentParser(description='Store the reference CRC-32 of the flash image.')
+    ap.add_argument('elf', help='linked image (.axf), updated in place')
+    ap.add_argument('--start', type=lambda s: int(s, 0), default=0x00000000, help='first byte checked')
+    ap.add_argument('--end', type=lambda s: int(s, 0), default=0x001FFFFF, help='last byte checked')
+    args = ap.parse_args(argv[1:])
+
+    with open(args.elf, 'rb') as f:
+        elf = bytearray(f.read())
+    if elf[:4] != b'\x7fELF' or elf[4] != 1 or elf[5] != 1:
+        print('%s: not a 32-bit little-endian ELF' % args.elf, file=sys.stderr)
+        return 1
+    addr = symbol(elf, SYMBOL)
+    loc = file_offset(elf, addr) if addr is not None else None
+    if loc is None:
+        print('%s: no %s in flash' % (args.elf, SYMBOL), file=sys.stderr)
+        return 1
+    offset, flash = loc
+
+    image = flash_image(elf, args.start, args.end)
+    ref = flash - args.start
+    if 0 <= ref and ref + 4 <= len(image):
+        crc = zlib.crc32(bytes(image[ref + 4:]), zlib.crc32(bytes(image[:ref])))
+    else:
+        crc = zlib.crc32(bytes(image))
+    struct.pack_into('<I', elf, offset, crc)
+    with open(args.elf, 'wb') as f:
+        f.write(elf)
+    print('%s: %s = 0x%08X over 0x%08X-0x%08X' % (args.elf, SYMBOL, crc, args.start, args.end))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv))
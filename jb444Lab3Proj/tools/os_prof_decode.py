@@ -0,0 +1,134 @@
+#!/usr/bin/env python3
+"""Decode uC/OS-III run-time profiler records.
+
+OSProfSnapshot() (uCOS/uCOS-III/os_prof.c) writes one record per call. The
+stat task hook keeps the latest in App_OS_ProfRec[], App_OS_ProfRecLen bytes
+long. Dump those bytes from the debugger once or several times and append
+them to one file, then
+
+    os_prof_decode.py prof.bin
+
+prints one table per record and, for each record after the first, what
+changed since the one before it.
+"""
+
+import struct
+import sys
+
+HDR = struct.Struct('<4sHHIIIIIIBBBB')
+TASK = struct.Struct('<BBH')
+TASK_TAIL = struct.Struct('<IIIII')
+TASK_CTX = struct.Struct('<III')     # Version 2: FP saves, context cycles, longest
+
+STATES = ('RDY', 'DLY', 'PEND', 'PEND+TO', 'SUSP', 'DLY+SUSP', 'PEND+SUSP', 'PEND+TO+SUSP')
+
+
+def decode(buf):
+    """Yields one dict per record in buf."""
+    off = 0
+    while off + HDR.size <= len(buf):
+        (magic, version, ntasks, freq, now, int_cycles, int_ctr, int_max,
+         ctxsw, bins, shift, name_size, _) = HDR.unpack_from(buf, off)
+        if magic != b'OSPF':
+            raise ValueError('no record at offset %d' % off)
+        if version not in (1, 2):
+            raise ValueError('record version %d not supported' % version)
+        off += HDR.size
+        tasks = []
+        for _ in range(ntasks):
+            prio, state, usage = TASK.unpack_from(buf, off)
+            off += TASK.size
+            name = buf[off:off + name_size].split(b'\0', 1)[0].decode('latin-1')
+            off += name_size
+            cycles, swin, preempt, lat_max, stk = TASK_TAIL.unpack_from(buf, off)
+            off += TASK_TAIL.size
+            hist = struct.unpack_from('<%dI' % bins, buf, off)
+            off += 4 * bins
+            fp_sw, ctx_cycles, ctx_max = None, None, None
+            if version >= 2:
+                fp_sw, ctx_cycles, ctx_max = TASK_CTX.unpack_from(buf, off)
+                off += TASK_CTX.size
+            tasks.append(dict(prio=prio, state=state, usage=usage, name=name, cycles=cycles,
+                              swin=swin, preempt=preempt, lat_max=lat_max, stk=stk, hist=hist,
+                              fp_sw=fp_sw, ctx_cycles=ctx_cycles, ctx_max=ctx_max))
+        yield dict(version=version, freq=freq, now=now, int_cycles=int_cycles, int_ctr=int_ctr,
+                   int_max=int_max, ctxsw=ctxsw, bins=bins, shift=shift, tasks=tasks)
+
+
+def us(counts, freq):
+    return counts * 1e6 / freq if freq else float(counts)
+
+
+def bin_limits(bins, shift):
+    """Upper limit of each histogram bin in counts, None for the last."""
+    return [(1 << (shift + n)) for n in range(bins - 1)] + [None]
+
+
+def print_record(n, rec):
+    freq = rec['freq']
+    unit = 'us' if freq else 'counts'
+    print('record %d: ts=%u  %s Hz  ctxsw=%u' % (n, rec['now'], freq, rec['ctxsw']))
+    print('  ISRs: %u, %.1f %s total, longest %.2f %s' % (
+        rec['int_ctr'], us(rec['int_cycles'], freq), unit, us(rec['int_max'], freq), unit))
+    print('  %-4s %-16s %-12s %6s %12s %8s %8s %10s %6s' % (
+        'prio', 'name', 'state', 'cpu%', 'cycles', 'sw in', 'preempt', 'lat max', 'stk'))
+    for t in sorted(rec['tasks'], key=lambda t: t['prio']):
+        print('  %-4u %-16s %-12s %6.2f %12u %8u %8u %10.2f %6u' % (
+            t['prio'], t['name'], STATES[t['state'] & 7], t['usage'] / 100.0, t['cycles'],
+            t['swin'], t['preempt'], us(t['lat_max'], freq), t['stk']))
+    limits = bin_limits(rec['bins'], rec['shift'])
+    print('  pend latency, counts below (%s):' % unit)
+    print('  %-16s %s' % ('', ' '.join('%7s' % ('%.3g' % us(l, freq) if l else 'more')
+                                           for l in limits)))
+    for t in sorted(rec['tasks'], key=lambda t: t['prio']):
+        if any(t['hist']):
+            print('  %-16s %s' % (t['name'], ' '.join('%7u' % h for h in t['hist'])))
+    if rec['version'] >= 2:
+        print('  context save and restore (%s), switches out with the FP registers:' % unit)
+        print('  %-16s %8s %10s %10s' % ('', 'fp', 'average', 'longest'))
+        for t in sorted(rec['tasks'], key=lambda t: t['prio']):
+            if t['swin']:
+                print('  %-16s %8u %10.2f %10.2f' % (
+                    t['name'], t['fp_sw'], us(t['ctx_cycles'], freq) / t['swin'], us(t['ctx_max'], freq)))
+
+
+def print_delta(prev, rec):
+    freq = rec['freq']
+    span = (rec['now'] - prev['now']) & 0xFFFFFFFF
+    if span == 0:
+        return
+    before = {(t['prio'], t['name']): t for t in prev['tasks']}
+    print('  since the record before, %.1f ms:' % (span * 1e3 / freq if freq else span))
+    isr = (rec['int_cycles'] - prev['int_cycles']) & 0xFFFFFFFF
+    print('  %-21s %6.2f%% of the time, %u ISRs' % (
+        'ISRs', 100.0 * isr / span, (rec['int_ctr'] - prev['int_ctr']) & 0xFFFFFFFF))
+    for t in sorted(rec['tasks'], key=lambda t: t['prio']):
+        p = before.get((t['prio'], t['name']))
+        if p is None:
+            print('  %-4u %-16s new' % (t['prio'], t['name']))
+            continue
+        d = (t['cycles'] - p['cycles']) & 0xFFFFFFFF
+        print('  %-4u %-16s %6.2f%% of the time, %u switches in, %u preemptions' % (
+            t['prio'], t['name'], 100.0 * d / span, (t['swin'] - p['swin']) & 0xFFFFFFFF,
+            (t['preempt'] - p['preempt']) & 0xFFFFFFFF))
+
+
+def main(argv):
+    if len(argv) != 2:
+        sys.stderr.write('usage: %s <record file>\n' % argv[0])
+        return 2
+    with open(argv[1], 'rb') as f:
+        buf = f.read()
+    prev = None
+    for n, rec in enumerate(decode(buf)):
+        if n:
+            print()
+        print_record(n, rec)
+        if prev is not None:
+            print_delta(prev, rec)
+        prev = rec
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv))
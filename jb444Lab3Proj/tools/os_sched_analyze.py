@@ -0,0 +1,460 @@
+#!/usr/bin/env python3
+"""Check that every task meets its deadline, from measured task timing.
+
+Runs response-time analysis over the tasks created in source/ and board/,
+at the priorities set in app_cfg.h. The time each task takes per run comes
+from a recording of the running system, either way:
+
+    os_sched_analyze.py -t trace.bin             OSTraceRam dump, longest run
+    os_sched_analyze.py -p prof.bin              profiler records, average run
+    os_sched_analyze.py -t trace.bin -f 120      at a 120 MHz CPU clock
+
+See os_trace_decode.py and os_prof_decode.py for how to take them. On the
+host port, fwrite() OSTraceRam, or the buffer OSProfSnapshot() filled, to a
+file at the end of the run. Measured times are scaled from the clock the
+recording ran at (--ref, the timestamp frequency by default, right for the
+DWT cycle counter) to the clock given with -f.
+
+A task is released once per period and is due one period later unless
+tools/os_sched_analyze.cfg says otherwise. The period is taken, first
+found first, from the .cfg file, from the longest OSTimeDly() in the
+task's entry function, or from the trace, as the shortest time between two
+releases. The profiler only gives the average. The DMA block rate and
+other periods no source line shows go in the .cfg file. So do
+interrupts, unless the recording has them.
+
+Tasks at the same priority are counted as delaying each other, which holds
+whatever order they run in. Blocking on mutexes held by lower priority
+tasks is not measured; give it in the .cfg file.
+
+The tasks are then given priorities in deadline order, the best fixed
+priorities for independent tasks, among the numbers they use now, and
+checked again. The #define lines for app_cfg.h are printed if that helps.
+
+Exits with 1 if a task can miss its deadline at the current priorities.
+"""
+
+import argparse
+import math
+import os
+import re
+import sys
+
+import os_prof_decode as prof
+import os_stk_analyze as stk
+import os_trace_decode as trace
+
+PROJ = stk.PROJ
+
+CPU_CLK_MHZ = 180.0
+
+EVT_TASK_READY = 0x08
+EVT_TASK_SUSPEND = 0x0A
+OBJ_MUTEX = 0x18
+
+
+class Task(object):
+    def __init__(self, name, entry=None, macro=None, prio=None):
+        self.name = name
+        self.entry = entry
+        self.macro = macro
+        self.prio = prio
+        self.c = None           # us per run
+        self.c_how = ''
+        self.t = None           # us between releases
+        self.t_how = ''
+        self.d = None           # us from release to deadline
+        self.b = 0.0            # us of blocking
+        self.r_obs = None       # us, longest release to block seen
+
+
+def arith(text):
+    """A number, or a product or quotient of numbers, such as 1024/48."""
+    if not re.match(r'^[\d.]+([*/][\d.]+)*$', text):
+        raise ValueError('not a number: %s' % text)
+    nums = re.split(r'[*/]', text)
+    ops = re.findall(r'[*/]', text)
+    v = float(nums[0])
+    for op, n in zip(ops, nums[1:]):
+        v = v * float(n) if op == '*' else v / float(n)
+    return v
+
+
+def read_cfg(path):
+    """Returns ({entry: {what: us}}, [(name, us per run, us between runs)])."""
+    per_task = {}
+    isrs = []
+    scale = dict(period=1e3, deadline=1e3, exec=1.0, block=1.0)
+    with open(path) as f:
+        for n, line in enumerate(f, 1):
+            line = line.split('#', 1)[0].strip()
+            if not line:
+                continue
+            words = line.split()
+            try:
+                if words[0] in scale and len(words) == 3:
+                    per_task.setdefault(words[1], {})[words[0]] = arith(words[2]) * scale[words[0]]
+                elif words[0] == 'isr' and len(words) == 4:
+                    isrs.append((words[1], arith(words[2]), arith(words[3]) * 1e3))
+                else:
+                    raise ValueError('cannot parse')
+            except ValueError as e:
+                raise ValueError('%s:%d: %s "%s"' % (path, n, e, line))
+    return per_task, isrs
+
+
+def find_tasks(dirs, defs):
+    """A Task for each OSTaskCreate() call, and the source text of each file."""
+    tasks = []
+    texts = {}
+    for d in dirs:
+        for name in sorted(os.listdir(d)):
+            if not name.endswith('.c'):
+                continue
+            path = os.path.join(d, name)
+            with open(path, encoding='latin-1') as f:
+                text = stk.strip_comments(f.read())
+            texts[path] = text
+            for m in re.finditer(r'\bOSTaskCreate\s*\(', text):
+                args = stk.call_args(text, m.end() - 1)
+                if len(args) != 13:
+                    continue
+                label = re.search(r'"([^"]*)"', args[1])
+                macro = stk.uncast(args[4])
+                prio = defs.get(macro, int(macro.rstrip('uU')) if macro.rstrip('uU').isdigit() else None)
+                tasks.append(Task(label.group(1).strip() if label else stk.uncast(args[2]), stk.uncast(args[2]),
+                                  macro, prio))
+    return tasks, texts
+
+
+def func_body(text, name):
+    m = re.search(r'\b%s\s*\([^;{)]*\)\s*\{' % re.escape(name), text)
+    if not m:
+        return None, 0
+    depth = 0
+    for i in range(m.end() - 1, len(text)):
+        if text[i] == '{':
+            depth += 1
+        elif text[i] == '}':
+            depth -= 1
+            if depth == 0:
+                return text[m.end():i], m.end()
+    return None, 0
+
+
+def dly_period(texts, entry, defs):
+    """Ticks of the longest OSTimeDly() in the entry function. Shorter ones only let other tasks run.
+
+    None if a delay is not a number or a macro defined as one, as it may be
+    the longest.
+    """
+    best = None
+    for text in texts.values():
+        body, _ = func_body(text, entry)
+        if body is None:
+            continue
+        for m in re.finditer(r'\bOSTimeDly\s*\(', body):
+            arg = stk.uncast(stk.call_args(body, m.end() - 1)[0]).rstrip('uU')
+            ticks = int(arg) if arg.isdigit() else defs.get(arg)
+            if not ticks:
+                return None
+            best = max(best or 0, ticks)
+        return best
+    return None
+
+
+def trace_timing(buf):
+    """Per task name: longest run, shortest time between releases, longest response.
+
+    A run ends each time the task gets what it pends on, delays or suspends
+    itself, so runs the task makes one after the other to catch up are kept
+    apart. Time spent in ISRs is not counted. A release is the task being
+    made ready while blocked, and the response runs from there to when it
+    blocks again. Mutexes are left out: a task takes them within a run.
+    Returns (freq, {name: dict}, ISRs).
+    """
+    hdr, objs, recs = trace.load(buf)
+    names = {oid: o['name'] for oid, o in objs.items() if o['type'] == 1}
+    prio = {oid: o['prio'] for oid, o in objs.items() if o['type'] == 1}
+    info = {}
+    cur = None
+    since = None
+    isr_depth = 0
+    isr_since = None
+    isr_max = 0
+    isr_nbr = 0
+    used = {}               # task id -> counts run in the current run
+    released = {}           # task id -> release ts, for blocked tasks made ready
+    blocked = set()
+    last_rel = {}
+
+    def stop(ts):
+        if cur is not None and since is not None:
+            used[cur] = used.get(cur, 0) + ts - since
+
+    def run_end(oid):
+        t = info.setdefault(oid, dict(c=0, t=None, r=0, runs=0))
+        if oid in used:
+            t['c'] = max(t['c'], used[oid])
+            t['runs'] += 1
+        used[oid] = 0
+
+    def block(oid, ts):
+        t = info.setdefault(oid, dict(c=0, t=None, r=0, runs=0))
+        if oid in released:
+            t['r'] = max(t['r'], ts - released.pop(oid))
+        blocked.add(oid)
+
+    for ts, evt, arg, oid in recs:
+        if evt == trace.EVT_SWITCHED_IN:
+            stop(ts)
+            cur, since = oid, ts
+            prio[oid] = arg
+        elif evt == trace.EVT_ISR_ENTER:
+            if isr_depth == 0:
+                stop(ts)
+                since = None
+                isr_since = ts
+            isr_depth += 1
+        elif evt == trace.EVT_ISR_EXIT or evt == trace.EVT_ISR_EXIT_TO_SCHED:
+            if isr_depth:
+                isr_depth -= 1
+                if isr_depth == 0:
+                    if isr_since is not None:
+                        isr_max = max(isr_max, ts - isr_since)
+                        isr_nbr += 1
+                    since = ts
+        elif evt == EVT_TASK_READY:
+            if oid in blocked:
+                blocked.discard(oid)
+                released[oid] = ts
+                t = info.setdefault(oid, dict(c=0, t=None, r=0, runs=0))
+                if oid in last_rel:
+                    gap = ts - last_rel[oid]
+                    t['t'] = gap if t['t'] is None else min(t['t'], gap)
+                last_rel[oid] = ts
+        elif isr_depth == 0 and cur is not None:
+            base = evt & ~7
+            if evt == trace.EVT_TASK_DLY or (evt == EVT_TASK_SUSPEND and oid == cur):
+                ends = blocks = True
+            elif base in trace.OBJ_BASES and base != OBJ_MUTEX:
+                ends = evt & 7 == trace.ACT_PEND
+                blocks = evt & 7 == trace.ACT_PEND_BLOCK
+            else:
+                continue
+            stop(ts)
+            since = ts
+            if ends:
+                run_end(cur)
+            if blocks:
+                block(cur, ts)
+    span = recs[-1][0] - recs[0][0] if recs else 0
+    out = {}
+    for oid, t in sorted(info.items()):
+        name = names.get(oid, '#%u' % oid)
+        if name in out:                                         # Names are cut short
+            name = '%s #%u' % (name, oid)
+        if t['runs']:
+            out[name] = dict(c=t['c'], c_how='max', t=t['t'], t_how='min', r=t['r'], prio=prio.get(oid))
+    isrs = [('ISRs', isr_max, span / isr_nbr)] if isr_nbr else []
+    return hdr['freq'], out, isrs
+
+
+def prof_timing(buf):
+    """Per task name, from the first and last profiler records: average run and time between runs.
+
+    A run is a switch in that was not the end of a preemption.
+    """
+    recs = list(prof.decode(buf))
+    if len(recs) < 2:
+        raise ValueError('need two profiler records or more')
+    a, z = recs[0], recs[-1]
+    span = (z['now'] - a['now']) & 0xFFFFFFFF
+    before = {t['name']: t for t in a['tasks']}
+    out = {}
+    for t in z['tasks']:
+        p = before.get(t['name'])
+        if p is None:
+            continue
+        runs = ((t['swin'] - p['swin']) - (t['preempt'] - p['preempt'])) & 0xFFFFFFFF
+        if runs:
+            out[t['name']] = dict(c=float((t['cycles'] - p['cycles']) & 0xFFFFFFFF) / runs, c_how='avg',
+                                  t=float(span) / runs, t_how='avg', r=None, prio=t['prio'])
+    isrs = []
+    nbr = (z['int_ctr'] - a['int_ctr']) & 0xFFFFFFFF
+    if nbr:
+        isrs.append(('ISRs', z['int_max'], float(span) / nbr))
+    return z['freq'], out, isrs
+
+
+def match(timing, name):
+    """Recordings keep the first few characters of a task's name."""
+    if name in timing:
+        return timing[name]
+    for n, v in timing.items():
+        if n and name.startswith(n):
+            return v
+    return None
+
+
+def response(task, tasks, isrs, prio_of):
+    """Worst-case response time in us, None past the deadline, '?' if it cannot be bounded."""
+    if task.c is None or task.d is None:
+        return '?'
+    hp = [t for t in tasks if t is not task and prio_of[t.name] <= prio_of[task.name]]
+    if any(t.c is None or t.t is None for t in hp):
+        return '?'
+    r = task.c + task.b
+    while True:
+        nxt = task.c + task.b
+        nxt += sum(math.ceil(r / t.t) * t.c for t in hp)
+        nxt += sum(math.ceil(r / t_us) * c_us for _, c_us, t_us in isrs)
+        if nxt > task.d:
+            return None
+        if nxt <= r:
+            return r
+        r = nxt
+
+
+def report(tasks, isrs, prio_of):
+    """Prints one line per task in priority order. Returns the number that may miss."""
+    bad = 0
+    print('  %-4s %-20s %-24s %12s %12s %10s %10s %10s  %s' % (
+        'prio', 'task', 'entry', 'run us', 'period ms', 'dline ms', 'resp ms', 'seen ms', 'verdict'))
+    for t in sorted(tasks, key=lambda t: (prio_of[t.name], t.name)):
+        r = response(t, tasks, isrs, prio_of)
+        if r is None:
+            verdict = 'CAN MISS'
+            bad += 1
+        elif r == '?':
+            verdict = 'not bounded'
+        else:
+            verdict = 'ok'
+        print('  %-4s %-20s %-24s %12s %12s %10s %10s %10s  %s' % (
+            prio_of[t.name], t.name[:20], (t.entry or '-')[:24],
+            '%.1f %s' % (t.c, t.c_how) if t.c is not None else '-',
+            '%.3f %s' % (t.t / 1e3, t.t_how) if t.t is not None else '-',
+            '%.3f' % (t.d / 1e3) if t.d is not None else '-',
+            '%.3f' % (r / 1e3) if isinstance(r, float) else '-',
+            '%.3f' % (t.r_obs / 1e3) if t.r_obs is not None else '-', verdict))
+    return bad
+
+
+def deadline_order(tasks, fixed):
+    """Priorities in deadline order for the tasks not in 'fixed', from the numbers they use now."""
+    movable = [t for t in tasks if t.name not in fixed and t.d is not None and t.prio is not None]
+    taken = set(fixed.values())
+    pool = sorted(set(t.prio for t in movable) - taken)
+    n = pool[0] if pool else 0
+    while len(pool) < len(movable):
+        if n not in pool and n not in taken:
+            pool.append(n)
+        n += 1
+    pool.sort()
+    prio_of = dict(fixed)
+    for t, p in zip(sorted(movable, key=lambda t: (t.d, t.t or 0, t.prio, t.name)), pool):
+        prio_of[t.name] = p
+    for t in tasks:
+        prio_of.setdefault(t.name, t.prio)
+    return prio_of
+
+
+def main(argv):
+    ap = argparse.ArgumentParser(description='Response-time analysis from measured task timing.')
+    ap.add_argument('-t', '--trace', help='OSTraceRam dump')
+    ap.add_argument('-p', '--prof', help='profiler records')
+    ap.add_argument('-f', '--clock', type=float, default=CPU_CLK_MHZ, help='CPU clock in MHz (default 180)')
+    ap.add_argument('--ref', type=float, help='CPU clock in MHz the recording ran at')
+    ap.add_argument('-c', '--cfg', default=os.path.join(PROJ, 'tools', 'os_sched_analyze.cfg'))
+    ap.add_argument('-s', '--src', action='append', help='directory with OSTaskCreate() calls')
+    args = ap.parse_args(argv[1:])
+    if not args.trace and not args.prof:
+        sys.stderr.write('no recording: give -t or -p\n')
+        return 2
+
+    cfg_dir = os.path.join(PROJ, 'uCOS', 'uC-CFG')
+    src = args.src or [os.path.join(PROJ, 'source'), os.path.join(PROJ, 'board')]
+    defs = stk.read_defines([os.path.join(cfg_dir, 'app_cfg.h'), os.path.join(cfg_dir, 'os_cfg_app.h')] +
+                            [os.path.join(d, n) for d in src for n in sorted(os.listdir(d)) if n.endswith('.h')])
+    tick_us = 1e6 / defs.get('OS_CFG_TICK_RATE_HZ', 1000)
+    per_task, isrs = read_cfg(args.cfg)
+    tasks, texts = find_tasks(src, defs)
+
+    timing = {}
+    rec_isrs = []
+    if args.prof:
+        with open(args.prof, 'rb') as f:
+            freq, timing, rec_isrs = prof_timing(f.read())
+    if args.trace:
+        with open(args.trace, 'rb') as f:
+            freq, timing, rec_isrs = trace_timing(f.read())
+    if not freq:
+        sys.stderr.write('the recording has no timestamp frequency\n')
+        return 2
+    ref = args.ref * 1e6 if args.ref else float(freq)
+    us = 1e6 / freq                                             # us per count
+    run_us = us * ref / (args.clock * 1e6)                      # us per count of CPU work, at -f
+    print('clock %.0f MHz, recording at %.0f MHz, tick %.0f us' % (args.clock, ref / 1e6, tick_us))
+
+    idle = defs.get('OS_CFG_PRIO_MAX', 32) - 1
+    for name, m in sorted(timing.items()):                      # Kernel tasks, and any the scan missed
+        if not any(t.name.startswith(name) for t in tasks) and m['prio'] is not None and m['prio'] < idle:
+            tasks.append(Task(name, prio=m['prio']))
+
+    for t in tasks:
+        m = match(timing, t.name)
+        if m is not None:
+            t.c, t.c_how = m['c'] * run_us, m['c_how']
+            if m['t']:
+                t.t, t.t_how = m['t'] * us, m['t_how']
+            if m['r']:
+                t.r_obs = m['r'] * us
+            if t.prio is None:
+                t.prio = m['prio']
+        if t.entry:
+            ticks = dly_period(texts, t.entry, defs)
+            if ticks:
+                t.t, t.t_how = ticks * tick_us, 'dly'
+        c = dict(per_task.get(t.entry, {}), **per_task.get(t.name, {}))
+        if 'exec' in c:
+            t.c, t.c_how = c['exec'], 'cfg'
+        if 'period' in c:
+            t.t, t.t_how = c['period'], 'cfg'
+        t.b = c.get('block', 0.0)
+        t.d = c.get('deadline', t.t)
+    isrs = isrs + [(n, c * run_us, p * us) for n, c, p in rec_isrs]
+
+    util = sum(t.c / t.t for t in tasks if t.c is not None and t.t)
+    util += sum(c / p for _, c, p in isrs)
+    for name, c, p in isrs:
+        print('ISR %-16s %.2f us every %.3f ms' % (name, c, p / 1e3))
+    n = len([t for t in tasks if t.c is not None and t.t])
+    print('utilization %.1f%%, rate monotonic bound for %u tasks %.1f%%' % (
+        100.0 * util, n, 100.0 * n * (2 ** (1.0 / n) - 1) if n else 100.0))
+    missing = [t.name for t in tasks if t.c is None or t.t is None]
+    if missing:
+        print('no timing for: %s' % ', '.join(missing))
+
+    print()
+    print('at the priorities in app_cfg.h:')
+    now = dict((t.name, t.prio) for t in tasks)
+    bad = report(tasks, isrs, now)
+
+    fixed = dict((t.name, t.prio) for t in tasks if not (t.macro or '').startswith('APP_CFG_'))
+    dm = deadline_order(tasks, fixed)
+    print()
+    print('in deadline order:')
+    bad_dm = report(tasks, isrs, dm)
+    moved = [t for t in tasks if dm[t.name] != t.prio]
+    if not moved:
+        print('the priorities in app_cfg.h are in deadline order already')
+    elif bad_dm < bad:
+        for t in sorted(moved, key=lambda t: dm[t.name]):
+            print('#define  %-30s %2uu' % (t.macro, dm[t.name]))
+    elif bad_dm:
+        print('no better with fixed priorities: make the tasks shorter or run them less often')
+    return 1 if bad else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv))
@@ -0,0 +1,429 @@
+#!/usr/bin/env python3
+"""Compute worst-case task stack sizes from the call graph.
+
+Build with -fstack-usage (set in .cproject) so GCC writes a .su file with
+the stack frame of every function next to each object. The call graph
+comes from the disassembly of the image, or from the .ci files of
+-fcallgraph-info=su on GCC 10 or later. Then, from the project directory,
+
+    os_stk_analyze.py Debug -d Debug/jb444Lab3Proj.axf
+    os_stk_analyze.py Debug -d image.dis -v          also print the deepest paths
+    os_stk_analyze.py Debug/*.ci                     .ci files only
+
+-d takes the ELF, and runs $OBJDUMP (arm-none-eabi-objdump) on it, or the
+output of 'objdump -d'. The tasks are the OSTaskCreate() calls in source/
+and board/, plus those listed in tools/os_stk_analyze.cfg, which also names
+the targets of indirect calls the graph cannot follow.
+
+A task needs the deepest call path from its entry function, plus the frame
+PendSV saves on it at a context switch (with the FP registers when the
+image is built for the FPU), plus the stack guard and redzone when they are
+enabled in os_cfg.h, plus a margin. The recommended sizes go to
+uCOS/uC-CFG/app_stk_cfg.h. Include it from app_cfg.h in place of the
+APP_CFG_xxx_STK_SIZE defines. Kernel task sizes are reported only; they are
+set in os_cfg_app.h. A task whose depth cannot be bounded, because of
+recursion, an unresolved indirect call, a dynamic frame or a function with
+no known frame, is reported and left out of the header.
+
+Exits with 1 if any task could not be bounded.
+"""
+
+import argparse
+import os
+import re
+import subprocess
+import sys
+
+PROJ = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+CPU_STK_BYTES = 4
+STK_ALIGN_BYTES = 8
+SW_FRAME = 9 * 4                # R4-R11 and EXC_RETURN, pushed by OS_CPU_PendSVHandler
+HW_FRAME = 8 * 4 + 4            # R0-R3, R12, LR, PC, xPSR and the alignment word
+FP_SW_FRAME = 16 * 4            # S16-S31, pushed by OS_CPU_PendSVHandler for a task using the FPU
+FP_HW_FRAME = 18 * 4            # S0-S15, FPSCR and a reserved word
+
+INDIRECT = '__indirect_call'
+
+BRANCH = re.compile(r'^(blx|bl|b)(eq|ne|cs|cc|hs|lo|mi|pl|vs|vc|hi|ls|ge|lt|gt|le|al)?(\.w|\.n)?$')
+TARGET = re.compile(r'<([^>+]+)(\+0x[0-9a-f]+)?>')
+FUNC = re.compile(r'^[0-9a-f]+ <([^>]+)>:$')
+REGS = re.compile(r'\{([^}]*)\}')
+
+
+class Graph(object):
+    def __init__(self):
+        self.frames = {}        # function -> bytes
+        self.estimated = set()  # frames read from the prologue
+        self.dynamic = set()    # functions with an unbounded frame
+        self.calls = {}         # function -> set of callees
+        self.indirect = set()   # functions with an indirect call nobody resolved
+
+    def frame(self, name, size, dynamic=False):
+        self.frames[name] = max(size, self.frames.get(name, 0))
+        self.estimated.discard(name)
+        if dynamic:
+            self.dynamic.add(name)
+
+    def call(self, caller, callee):
+        if callee == INDIRECT:
+            self.indirect.add(caller)
+        else:
+            self.calls.setdefault(caller, set()).add(callee)
+
+
+def func_name(title):
+    """GCC names a static function file.c:name in .su and .ci files."""
+    return title.rsplit(':', 1)[-1]
+
+
+def read_su(g, path):
+    """file.c:12:6:name<TAB>bytes<TAB>static|dynamic|dynamic,bounded"""
+    with open(path) as f:
+        for line in f:
+            fields = line.rstrip('\n').split('\t')
+            if len(fields) < 3:
+                continue
+            g.frame(func_name(fields[0]), int(fields[1]), fields[2] == 'dynamic')
+
+
+def read_ci(g, path):
+    """VCG graph written by -fcallgraph-info=su."""
+    with open(path) as f:
+        text = f.read()
+    for m in re.finditer(r'node: \{ title: "([^"]+)" label: "([^"]*)"', text):
+        size = re.search(r'(\d+) bytes \(([a-z,]+)\)', m.group(2))
+        if size:
+            g.frame(func_name(m.group(1)), int(size.group(1)), size.group(2) == 'dynamic')
+    for m in re.finditer(r'edge: \{ sourcename: "([^"]+)" targetname: "([^"]+)"', text):
+        g.call(func_name(m.group(1)), func_name(m.group(2)))
+
+
+def prologue_bytes(mnem, ops):
+    """Stack an instruction of a prologue takes, for functions with no .su entry."""
+    if mnem in ('push', 'push.w', 'stmdb', 'stmdb.w') and (mnem.startswith('push') or ops.startswith('sp!')):
+        m = REGS.search(ops)
+        return 4 * len(m.group(1).split(',')) if m else 0
+    if mnem == 'vpush':
+        m = REGS.search(ops)
+        if not m:
+            return 0
+        n = 0
+        for r in m.group(1).split(','):
+            r = r.strip()
+            lo, _, hi = r.partition('-')
+            n += (int(hi[1:]) - int(lo[1:]) + 1 if hi else 1) * (8 if lo.startswith('d') else 4)
+        return n
+    if mnem in ('sub', 'sub.w', 'subw', 'subs') and ops.startswith('sp,'):
+        m = re.search(r'#(\d+)', ops)
+        return int(m.group(1)) if m else 0
+    if mnem in ('str', 'str.w') and ops.startswith('lr, [sp, #-4]!'):
+        return 4
+    return 0
+
+
+def read_dis(g, path):
+    """Calls from 'objdump -d' output, or from an ELF run through $OBJDUMP."""
+    with open(path, 'rb') as f:
+        elf = f.read(4) == b'\x7fELF'
+    if elf:
+        objdump = os.environ.get('OBJDUMP', 'arm-none-eabi-objdump')
+        text = subprocess.check_output([objdump, '-d', '--no-show-raw-insn', path]).decode('latin-1')
+    else:
+        with open(path, encoding='latin-1') as f:
+            text = f.read()
+    cur = None
+    in_prologue = False
+    est = 0
+    for line in text.splitlines():
+        m = FUNC.match(line)
+        if m:
+            if cur is not None and cur not in g.frames:
+                g.frames[cur] = est
+                g.estimated.add(cur)
+            cur, in_prologue, est = m.group(1), True, 0
+            continue
+        if cur is None:
+            continue
+        fields = line.split('\t')
+        if len(fields) < 2 or not fields[0].strip().endswith(':'):
+            continue
+        insn = [f for f in fields[1:] if f.strip()]
+        if not insn:
+            continue
+        if re.match(r'^[0-9a-f]{4}( [0-9a-f]{4})?\s*$', insn[0]):
+            insn = insn[1:]                         # raw instruction bytes
+        if not insn:
+            continue
+        mnem = insn[0].strip()
+        ops = insn[1].strip() if len(insn) > 1 else ''
+        b = BRANCH.match(mnem)
+        if b:
+            in_prologue = False
+            t = TARGET.search(ops)
+            if t and (t.group(1) != cur or (b.group(1) != 'b' and not t.group(2))):
+                g.call(cur, t.group(1))
+            elif not t and b.group(1) == 'blx':
+                g.call(cur, INDIRECT)
+        elif mnem == 'bx' and ops != 'lr':
+            g.call(cur, INDIRECT)
+        elif in_prologue:
+            n = prologue_bytes(mnem, ops)
+            if n:
+                est += n
+            elif mnem.startswith(('b', 'cb', 'pop', 'ldm')):
+                in_prologue = False
+    if cur is not None and cur not in g.frames:
+        g.frames[cur] = est
+        g.estimated.add(cur)
+
+
+def read_cfg(g, path):
+    """Indirect call targets, frames and extra tasks. Returns [(entry, macro, where)]."""
+    tasks = []
+    resolved = set()
+    with open(path) as f:
+        for n, line in enumerate(f, 1):
+            line = line.split('#', 1)[0].strip()
+            if not line:
+                continue
+            words = line.split()
+            if words[0] == 'frame' and len(words) == 3:
+                g.frame(words[1], int(words[2]))
+            elif words[0] == 'task' and len(words) == 3:
+                tasks.append((words[1], words[2], '%s:%d' % (os.path.basename(path), n)))
+            elif words[0].endswith(':'):
+                caller = words[0][:-1]
+                resolved.add(caller)
+                for callee in words[1:]:
+                    g.call(caller, callee)
+            else:
+                raise ValueError('%s:%d: cannot parse "%s"' % (path, n, line))
+    return tasks, resolved
+
+
+def strip_comments(text):
+    text = re.sub(r'/\*.*?\*/', lambda m: '\n' * m.group(0).count('\n'), text, flags=re.S)
+    return re.sub(r'//[^\n]*', '', text)
+
+
+def call_args(text, start):
+    """Splits the arguments of the call whose '(' is at start."""
+    args = []
+    depth = 0
+    arg = ''
+    for c in text[start:]:
+        if c == '(':
+            depth += 1
+            if depth == 1:
+                continue
+        elif c == ')':
+            depth -= 1
+            if depth == 0:
+                args.append(arg.strip())
+                return args
+        elif c == ',' and depth == 1:
+            args.append(arg.strip())
+            arg = ''
+            continue
+        arg += c
+    return args
+
+
+def uncast(expr):
+    return re.sub(r'^(\(\s*[A-Za-z_][\w\s]*\**\s*\)\s*)+', '', expr).lstrip('&').strip()
+
+
+def find_tasks(dirs):
+    """Returns [(entry, size expression, where, warning)] for each OSTaskCreate() call."""
+    tasks = []
+    for d in dirs:
+        for name in sorted(os.listdir(d)):
+            if not name.endswith('.c'):
+                continue
+            path = os.path.join(d, name)
+            with open(path, encoding='latin-1') as f:
+                text = strip_comments(f.read())
+            for m in re.finditer(r'\bOSTaskCreate\s*\(', text):
+                args = call_args(text, m.end() - 1)
+                if len(args) != 13:
+                    continue
+                where = '%s:%d' % (os.path.relpath(path, PROJ), text.count('\n', 0, m.start()) + 1)
+                size = uncast(args[7])
+                warn = None
+                stk = re.match(r'(\w+)', uncast(args[5]))
+                if stk:
+                    decl = re.search(r'\bCPU_STK\s+' + stk.group(1) + r'\s*\[\s*([^\]]+?)\s*\]', text)
+                    if decl and decl.group(1) != size:
+                        warn = '%s is %s elements but the task is created with size %s' % (
+                            stk.group(1), decl.group(1), size)
+                tasks.append((uncast(args[2]), size, where, warn))
+    return tasks
+
+
+def read_defines(paths):
+    """First #define of each macro with a plain number, from the files in order."""
+    defs = {}
+    for path in paths:
+        if not os.path.exists(path):
+            continue
+        with open(path, encoding='latin-1') as f:
+            for m in re.finditer(r'^\s*#define\s+(\w+)\s+\(?(\d+)u?\)?', f.read(), re.M):
+                defs.setdefault(m.group(1), int(m.group(2)))
+    return defs
+
+
+def enabled(path, macro):
+    with open(path, encoding='latin-1') as f:
+        m = re.search(r'^\s*#define\s+' + macro + r'\s+(\w+)', f.read(), re.M)
+    return bool(m) and m.group(1) in ('DEF_ENABLED', '1', '1u')
+
+
+def depth(g, root):
+    """Deepest path from root. Returns (bytes, path, problems)."""
+    memo = {}
+    problems = set()
+    active = []
+
+    def walk(fn):
+        if fn in memo:
+            return memo[fn]
+        if fn in active:
+            problems.add('recursion through %s' % ' -> '.join(active[active.index(fn):] + [fn]))
+            return 0, [fn]
+        active.append(fn)
+        if fn not in g.frames:
+            problems.add('no frame for %s' % fn)
+        if fn in g.dynamic:
+            problems.add('dynamic frame in %s' % fn)
+        if fn in g.indirect:
+            problems.add('unresolved indirect call in %s' % fn)
+        best, path = 0, []
+        for callee in sorted(g.calls.get(fn, ())):
+            d, p = walk(callee)
+            if d > best or not path:
+                best, path = d, p
+        active.pop()
+        memo[fn] = (g.frames.get(fn, 0) + best, [fn] + path)
+        return memo[fn]
+
+    d, p = walk(root)
+    return d, p, sorted(problems)
+
+
+def words(nbytes):
+    return -(-nbytes // STK_ALIGN_BYTES) * (STK_ALIGN_BYTES // CPU_STK_BYTES)
+
+
+def write_header(path, rows, overhead, margin):
+    lines = [
+        '/*',
+        ' * app_stk_cfg.h',
+        ' *  Generated by tools/os_stk_analyze.py. Do not edit, run it again.',
+        ' *',
+        ' *  Task stack sizes in CPU_STK elements: the deepest call path from the',
+        ' *  task entry, plus %u bytes for the context switch frame, stack guard and' % overhead,
+        ' *  redzone, plus %u%%. Include it from app_cfg.h in place of the' % margin,
+        ' *  APP_CFG_xxx_STK_SIZE defines.',
+        ' */',
+        '',
+        '#ifndef APP_STK_CFG_H_',
+        '#define APP_STK_CFG_H_',
+        '',
+    ]
+    for r in rows:
+        if not r['macro'].startswith('APP_CFG_'):
+            continue
+        if r['problems']:
+            lines.append('/* %s: not bounded, see os_stk_analyze.py */' % r['macro'])
+            continue
+        lines.append('#ifndef %s' % r['macro'])
+        lines.append('#define %-36s %4uu   /* %s, %u bytes deep */' % (r['macro'], r['rec'], r['entry'], r['depth']))
+        lines.append('#endif')
+    lines += ['', '#endif', '']
+    with open(path, 'w') as f:
+        f.write('\n'.join(lines))
+
+
+def main(argv):
+    ap = argparse.ArgumentParser(description='Worst-case task stack sizes from the call graph.')
+    ap.add_argument('inputs', nargs='+', help='.su and .ci files, or directories to search for them')
+    ap.add_argument('-d', '--dis', help='image ELF or its objdump -d output, for the calls')
+    ap.add_argument('-c', '--cfg', default=os.path.join(PROJ, 'tools', 'os_stk_analyze.cfg'))
+    ap.add_argument('-s', '--src', action='append', help='directory with OSTaskCreate() calls')
+    ap.add_argument('-o', '--output', default=os.path.join(PROJ, 'uCOS', 'uC-CFG', 'app_stk_cfg.h'))
+    ap.add_argument('-m', '--margin', type=int, default=10, help='percent added (default 10)')
+    ap.add_argument('--no-fp', action='store_true', help='image built without the FPU')
+    ap.add_argument('-v', '--verbose', action='store_true', help='print the deepest path of each task')
+    args = ap.parse_args(argv[1:])
+
+    g = Graph()
+    files = []
+    for i in args.inputs:
+        if os.path.isdir(i):
+            for top, _, names in os.walk(i):
+                files += [os.path.join(top, n) for n in sorted(names) if n.endswith(('.su', '.ci'))]
+        else:
+            files.append(i)
+    for path in files:
+        if path.endswith('.ci'):
+            read_ci(g, path)
+        else:
+            read_su(g, path)
+    if args.dis:
+        read_dis(g, args.dis)
+    elif not any(f.endswith('.ci') for f in files):
+        sys.stderr.write('no call graph: give -d or .ci files\n')
+        return 2
+    cfg_tasks, resolved = read_cfg(g, args.cfg)
+    g.indirect -= resolved
+
+    cfg_dir = os.path.join(PROJ, 'uCOS', 'uC-CFG')
+    src = args.src or [os.path.join(PROJ, 'source'), os.path.join(PROJ, 'board')]
+    tasks = find_tasks(src) + [(e, m, w, None) for e, m, w in cfg_tasks]
+    defs = read_defines([os.path.join(cfg_dir, 'app_cfg.h'), os.path.join(cfg_dir, 'os_cfg_app.h')] +
+                        [os.path.join(d, n) for d in src for n in sorted(os.listdir(d)) if n.endswith('.h')])
+
+    os_cfg = os.path.join(cfg_dir, 'os_cfg.h')
+    overhead = SW_FRAME + HW_FRAME
+    if not args.no_fp:
+        overhead += FP_SW_FRAME + FP_HW_FRAME
+    if enabled(os_cfg, 'OS_CFG_STK_GUARD_EN'):
+        shift = read_defines([os.path.join(PROJ, 'uCOS', 'uCOS-III', 'os.h')]).get('OS_STK_GUARD_SHIFT', 5)
+        overhead += 2 * (1 << shift) - CPU_STK_BYTES                # Guard and its worst alignment
+    if enabled(os_cfg, 'OS_CFG_TASK_STK_REDZONE_EN'):
+        overhead += read_defines([os_cfg]).get('OS_CFG_TASK_STK_REDZONE_DEPTH', 8) * CPU_STK_BYTES
+
+    rows = []
+    bad = 0
+    print('overhead %u bytes per task, margin %u%%' % (overhead, args.margin))
+    print('%-22s %-34s %6s %6s %6s' % ('entry', 'size macro', 'deep', 'now', 'rec'))
+    saved = 0
+    for entry, macro, where, warn in tasks:
+        d, path, problems = depth(g, entry)
+        rec = words((d + overhead) * (100 + args.margin) // 100)
+        now = defs.get(macro)
+        rows.append(dict(entry=entry, macro=macro, depth=d, rec=rec, problems=problems))
+        print('%-22s %-34s %6u %6s %6u%s' % (entry, macro, d, now if now is not None else '?', rec,
+                                              '  NOT BOUNDED' if problems else ''))
+        if warn:
+            print('    %s: %s' % (where, warn))
+        for p in problems:
+            print('    %s' % p)
+        if args.verbose:
+            print('    %s' % ' -> '.join('%s(%u%s)' % (f, g.frames.get(f, 0), '?' if f in g.estimated else '')
+                                         for f in path))
+        if problems:
+            bad += 1
+        elif now is not None:
+            saved += (now - rec) * CPU_STK_BYTES
+    print('%d bytes of task stack saved by the recommended sizes' % saved)
+    if args.verbose and g.estimated:
+        print('frames read from the prologue: %s' % ' '.join(sorted(g.estimated)))
+
+    write_header(args.output, rows, overhead, args.margin)
+    return 1 if bad else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv))
@@ -0,0 +1,276 @@
+#!/usr/bin/env python3
+"""Decode the uC/OS-III RAM ring trace recorder.
+
+uCOS/uCOS-III/Trace/RamRing/os_trace_ram.c records kernel events in
+OSTraceRam. Stop the target, dump sizeof(OSTraceRam) bytes starting at
+&OSTraceRam from the debugger, then
+
+    os_trace_decode.py trace.bin                 summary
+    os_trace_decode.py trace.bin -l              summary and every event
+    os_trace_decode.py trace.bin -o trace.json   also write a Chrome trace
+
+The summary has, per task, the time it ran and how long it spent blocked,
+and per object, the posts, pends and the latency from a post to the
+woken task running. The JSON file opens in chrome://tracing or
+ui.perfetto.dev, one row per task and one for ISRs.
+"""
+
+import argparse
+import json
+import struct
+import sys
+
+HDR = struct.Struct('<4sHHIIIIIIIBBH')
+OBJ = struct.Struct('<HBB12s')
+REC = struct.Struct('<IBBH')
+
+OBJ_TYPES = {1: 'task', 2: 'sem', 3: 'mutex', 4: 'queue', 5: 'flags', 6: 'mem'}
+
+EVT_SWITCHED_IN = 0x01
+EVT_ISR_ENTER = 0x02
+EVT_ISR_EXIT = 0x03
+EVT_ISR_EXIT_TO_SCHED = 0x04
+EVT_TICK = 0x05
+EVT_TASK_DLY = 0x09
+
+KERNEL_EVTS = {
+    0x01: 'switched in', 0x02: 'ISR enter', 0x03: 'ISR exit', 0x04: 'ISR exit to scheduler',
+    0x05: 'tick', 0x06: 'task create', 0x07: 'task del', 0x08: 'task ready', 0x09: 'task dly',
+    0x0A: 'task suspend', 0x0B: 'task resume', 0x0C: 'prio change', 0x0D: 'prio inherit',
+    0x0E: 'prio disinherit',
+}
+
+# Object events are a base for the kind of object plus an action. The
+# task semaphore and task queue events carry the owning task's ID.
+OBJ_BASES = {0x10: 'sem', 0x18: 'mutex', 0x20: 'queue', 0x28: 'flags',
+             0x30: 'task sem', 0x38: 'task queue', 0x40: 'mem'}
+ACTS = ('create', 'del', 'post', 'post failed', 'pend', 'pend block', 'pend failed')
+ACT_POST = 2
+ACT_PEND = 4
+ACT_PEND_BLOCK = 5
+
+
+def load(buf):
+    """Returns (header dict, {id: object}, [(ts, evt, arg, id)]) oldest first."""
+    (magic, version, obj_max, size, freq, bench_nbr, bench_cycles,
+     head, drops, obj_ctr, mode, running, _) = HDR.unpack_from(buf, 0)
+    if magic != b'OSTR':
+        raise ValueError('not an OSTraceRam dump')
+    if version != 1:
+        raise ValueError('OSTraceRam version %d not supported' % version)
+    off = HDR.size
+    objs = {}
+    for _ in range(obj_max):
+        oid, otype, prio, name = OBJ.unpack_from(buf, off)
+        off += OBJ.size
+        if oid:
+            objs[oid] = dict(type=otype, prio=prio, name=name.split(b'\0', 1)[0].decode('latin-1'))
+    if len(buf) < off + size * REC.size:
+        raise ValueError('dump is %d bytes, %d expected' % (len(buf), off + size * REC.size))
+    if head > size:
+        first = head - size
+    else:
+        first = 0
+    recs = []
+    prev = None
+    hi = 0
+    for n in range(first, head):
+        ts, evt, arg, oid = REC.unpack_from(buf, off + (n % size) * REC.size)
+        if prev is not None and ts < prev:
+            hi += 1 << 32
+        prev = ts
+        recs.append((hi + ts, evt, arg, oid))
+    hdr = dict(size=size, freq=freq, bench_nbr=bench_nbr, bench_cycles=bench_cycles, head=head,
+               drops=drops, obj_ctr=obj_ctr, obj_max=obj_max, mode=('ring', 'stop')[mode & 1],
+               lost=first)
+    return hdr, objs, recs
+
+
+def obj_name(objs, oid):
+    o = objs.get(oid)
+    if o is None:
+        return '#%u' % oid
+    return o['name'] or '%s #%u' % (OBJ_TYPES.get(o['type'], '?'), oid)
+
+
+def evt_what(objs, evt, oid):
+    """What the ID of an event stands for, as text."""
+    if evt in (EVT_ISR_ENTER, EVT_ISR_EXIT):
+        return ''
+    if evt in (EVT_TICK, EVT_TASK_DLY):
+        return str(oid)
+    return obj_name(objs, oid)
+
+
+def evt_name(evt):
+    if evt in KERNEL_EVTS:
+        return KERNEL_EVTS[evt]
+    base = evt & ~7
+    act = evt & 7
+    if base in OBJ_BASES and act < len(ACTS):
+        return '%s %s' % (OBJ_BASES[base], ACTS[act])
+    return 'event 0x%02x' % evt
+
+
+class Stats(object):
+    def __init__(self):
+        self.posts = 0
+        self.pends = 0
+        self.blocks = 0
+        self.lat = []
+
+
+def analyze(objs, recs):
+    """Walks the events once. Returns (task run time, task block time, ISR time, object stats).
+
+    A task blocked on an object is taken to be woken by the next post to that
+    object, the highest priority waiter first. The latency runs from that post
+    to the task's next switch in.
+    """
+    run = {}
+    blocked_time = {}
+    isr_time = 0
+    stats = {}
+    cur = None
+    cur_since = None
+    isr_depth = 0
+    isr_since = None
+    prio = {oid: o['prio'] for oid, o in objs.items() if o['type'] == 1}
+    waiting = {}            # object key -> [task id]
+    blocked = {}            # task id -> (block ts, object key)
+    posted = {}             # task id -> (post ts, object key)
+    for ts, evt, arg, oid in recs:
+        if evt == EVT_SWITCHED_IN:
+            if cur is not None and cur_since is not None:
+                run[cur] = run.get(cur, 0) + ts - cur_since
+            cur, cur_since = oid, ts
+            prio[oid] = arg
+            if oid in blocked:
+                t0, _ = blocked.pop(oid)
+                blocked_time[oid] = blocked_time.get(oid, 0) + ts - t0
+            if oid in posted:
+                t0, key = posted.pop(oid)
+                stats[key].lat.append(ts - t0)
+        elif evt == EVT_ISR_ENTER:
+            if isr_depth == 0:
+                isr_since = ts
+            isr_depth += 1
+        elif evt == EVT_ISR_EXIT or evt == EVT_ISR_EXIT_TO_SCHED:
+            if isr_depth:
+                isr_depth -= 1
+                if isr_depth == 0 and isr_since is not None:
+                    isr_time += ts - isr_since
+        elif evt & ~7 in OBJ_BASES:
+            key = (evt & ~7, oid)
+            st = stats.setdefault(key, Stats())
+            act = evt & 7
+            if act == ACT_POST:
+                st.posts += 1
+                q = waiting.get(key)
+                if q:
+                    q.sort(key=lambda t: prio.get(t, 255))
+                    posted[q.pop(0)] = (ts, key)
+            elif act == ACT_PEND_BLOCK:
+                st.blocks += 1
+                if cur is not None and isr_depth == 0:
+                    blocked[cur] = (ts, key)
+                    waiting.setdefault(key, []).append(cur)
+            elif act == ACT_PEND:
+                st.pends += 1
+    return run, blocked_time, isr_time, stats
+
+
+def chrome(objs, recs, freq):
+    """Chrome trace events: slices for tasks and ISRs, instants for the rest."""
+    scale = 1e6 / freq if freq else 1.0
+    out = []
+    for oid, o in objs.items():
+        if o['type'] == 1:
+            out.append(dict(name='thread_name', ph='M', pid=1, tid=oid, args=dict(name=o['name'])))
+    out.append(dict(name='thread_name', ph='M', pid=1, tid=0, args=dict(name='ISRs')))
+    if not recs:
+        return out
+    t_base = recs[0][0]
+    cur = None
+    isr_depth = 0
+    for ts, evt, arg, oid in recs:
+        t = (ts - t_base) * scale
+        if evt == EVT_SWITCHED_IN:
+            if cur is not None:
+                out.append(dict(name=obj_name(objs, cur), ph='E', pid=1, tid=cur, ts=t))
+            cur = oid
+            out.append(dict(name=obj_name(objs, oid), ph='B', pid=1, tid=oid, ts=t, args=dict(prio=arg)))
+        elif evt == EVT_ISR_ENTER:
+            isr_depth += 1
+            out.append(dict(name='ISR', ph='B', pid=1, tid=0, ts=t, args=dict(nesting=arg)))
+        elif evt == EVT_ISR_EXIT or evt == EVT_ISR_EXIT_TO_SCHED:
+            if isr_depth:
+                isr_depth -= 1
+                out.append(dict(name='ISR', ph='E', pid=1, tid=0, ts=t))
+        elif evt != EVT_TICK:
+            tid = 0 if isr_depth else (cur if cur is not None else 0)
+            out.append(dict(name='%s %s' % (evt_name(evt), evt_what(objs, evt, oid)),
+                            ph='i', s='t', pid=1, tid=tid, ts=t))
+    return out
+
+
+def main(argv):
+    ap = argparse.ArgumentParser(description='Decode an OSTraceRam dump.')
+    ap.add_argument('dump')
+    ap.add_argument('-l', '--list', action='store_true', help='print every event')
+    ap.add_argument('-o', '--output', help='write a Chrome trace JSON file')
+    args = ap.parse_args(argv[1:])
+    with open(args.dump, 'rb') as f:
+        hdr, objs, recs = load(f.read())
+
+    freq = hdr['freq']
+    unit = 'us' if freq else 'counts'
+
+    def us(counts):
+        return counts * 1e6 / freq if freq else float(counts)
+
+    print('%u events kept of %u recorded, %u dropped, %s mode, ring of %u' % (
+        len(recs), hdr['head'], hdr['drops'], hdr['mode'], hdr['size']))
+    if hdr['bench_nbr'] and hdr['bench_cycles']:
+        print('recording costs %.1f counts (%.3f %s) per event' % (
+            float(hdr['bench_cycles']) / hdr['bench_nbr'], us(hdr['bench_cycles']) / hdr['bench_nbr'], unit))
+    if hdr['obj_ctr'] > hdr['obj_max']:
+        print('%u objects, names kept for the first %u' % (hdr['obj_ctr'], hdr['obj_max']))
+    if not recs:
+        return 0
+    span = recs[-1][0] - recs[0][0]
+    print('%.1f %s traced' % (us(span), unit))
+
+    if args.list:
+        t_base = recs[0][0]
+        for ts, evt, arg, oid in recs:
+            print('%12.3f  %-24s %-16s %u' % (us(ts - t_base), evt_name(evt), evt_what(objs, evt, oid), arg))
+
+    run, blocked_time, isr_time, stats = analyze(objs, recs)
+    print()
+    print('  %-16s %6s %12s %12s' % ('task', 'run %', 'run ' + unit, 'blocked ' + unit))
+    for oid in sorted(set(run) | set(blocked_time), key=lambda t: objs.get(t, {}).get('prio', 255)):
+        print('  %-16s %6.2f %12.1f %12.1f' % (obj_name(objs, oid), 100.0 * run.get(oid, 0) / span if span else 0,
+                                                us(run.get(oid, 0)), us(blocked_time.get(oid, 0))))
+    print('  %-16s %6.2f %12.1f' % ('ISRs', 100.0 * isr_time / span if span else 0, us(isr_time)))
+
+    print()
+    print('  %-12s %-16s %6s %6s %6s %12s %12s %12s' % (
+        'kind', 'object', 'posts', 'pends', 'blocks', 'lat avg', 'lat max', 'lat min'))
+    for (base, oid), st in sorted(stats.items()):
+        lat = st.lat
+        if lat:
+            l_avg, l_max, l_min = ('%12.2f' % us(v) for v in (sum(lat) / len(lat), max(lat), min(lat)))
+        else:
+            l_avg = l_max = l_min = '%12s' % '-'
+        print('  %-12s %-16s %6u %6u %6u %s %s %s' % (OBJ_BASES[base], obj_name(objs, oid),
+                                                     st.posts, st.pends, st.blocks, l_avg, l_max, l_min))
+
+    if args.output:
+        with open(args.output, 'w') as f:
+            json.dump(dict(traceEvents=chrome(objs, recs, freq), displayTimeUnit='ns'), f)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv))
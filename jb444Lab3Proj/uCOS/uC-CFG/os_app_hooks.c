@@ -35,6 +35,25 @@
 #define   MICRIUM_SOURCE
 #include  "os.h"
 #include  "os_app_hooks.h"
+#if (OS_CFG_PROF_EN == DEF_ENABLED)
+#include  "app_cfg.h"
+
+#ifndef  APP_CFG_PROF_REC_SIZE                                  /* OSProfSnapshot() needs 36 bytes + 116 per task       */
+#define  APP_CFG_PROF_REC_SIZE                          2560u
+#endif
+#endif
+
+
+/*
+************************************************************************************************************************
+*                                                  GLOBAL VARIABLES
+************************************************************************************************************************
+*/
+
+#if (OS_CFG_PROF_EN == DEF_ENABLED)
+CPU_INT08U  App_OS_ProfRec[APP_CFG_PROF_REC_SIZE];
+CPU_SIZE_T  App_OS_ProfRecLen;
+#endif
 
 
 /*
@@ -62,6 +81,10 @@ void  App_OS_SetAllHooks (void)
     OS_AppRedzoneHitHookPtr = App_OS_RedzoneHitHook;
 #endif
 
+#if (OS_CFG_STK_GUARD_EN == DEF_ENABLED)
+    OS_AppStkGuardHitHookPtr = App_OS_StkGuardHitHook;
+#endif
+
     OS_AppStatTaskHookPtr   = App_OS_StatTaskHook;
 
     OS_AppTaskCreateHookPtr = App_OS_TaskCreateHook;
@@ -103,6 +126,10 @@ void  App_OS_ClrAllHooks (void)
     OS_AppRedzoneHitHookPtr = (OS_APP_HOOK_TCB)0;
 #endif
 
+#if (OS_CFG_STK_GUARD_EN == DEF_ENABLED)
+    OS_AppStkGuardHitHookPtr = (OS_APP_HOOK_TCB)0;
+#endif
+
     OS_AppStatTaskHookPtr   = (OS_APP_HOOK_VOID)0;
 
     OS_AppTaskCreateHookPtr = (OS_APP_HOOK_TCB)0;
@@ -156,6 +183,27 @@ void  App_OS_RedzoneHitHook (OS_TCB  *p_tcb)
 #endif
 
 
+/*
+************************************************************************************************************************
+*                                           APPLICATION STACK GUARD HIT HOOK
+*
+* Description: This function is called when a write to a stack guard is trapped.
+*
+* Arguments  : p_tcb   is a pointer to the task control block of the offending task. NULL if ISR.
+*
+* Note(s)    : 1) It may be called from an exception that interrupted the kernel, so it must not call uC/OS-III
+*                 services.  Look at p_tcb->NamePtr from the debugger.
+************************************************************************************************************************
+*/
+#if (OS_CFG_STK_GUARD_EN == DEF_ENABLED)
+void  App_OS_StkGuardHitHook (OS_TCB  *p_tcb)
+{
+    (void)&p_tcb;
+    CPU_SW_EXCEPTION(;);
+}
+#endif
+
+
 /*
 ************************************************************************************************************************
 *                                           APPLICATION STATISTIC TASK HOOK
@@ -165,13 +213,19 @@ void  App_OS_RedzoneHitHook (OS_TCB  *p_tcb)
 *
 * Arguments  : none
 *
-* Note(s)    : none
+* Note(s)    : 1) With OS_CFG_PROF_EN, each call takes a profiler record into App_OS_ProfRec[].  Dump
+*                 App_OS_ProfRecLen bytes of it from the debugger and decode them with tools/os_prof_decode.py.
 ************************************************************************************************************************
 */
 
 void  App_OS_StatTaskHook (void)
 {
+#if (OS_CFG_PROF_EN == DEF_ENABLED)
+    OS_ERR  err;
 
+
+    App_OS_ProfRecLen = OSProfSnapshot(&App_OS_ProfRec[0], sizeof(App_OS_ProfRec), &err);
+#endif
 }
 
 
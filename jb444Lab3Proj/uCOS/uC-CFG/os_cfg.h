@@ -39,13 +39,17 @@
 #define OS_CFG_APP_HOOKS_EN             DEF_ENABLED        /* Enable (DEF_ENABLED) application specific hooks                       */
 #define OS_CFG_ARG_CHK_EN               DEF_DISABLED        /* Enable (DEF_ENABLED) argument checking                                */
 #define OS_CFG_CALLED_FROM_ISR_CHK_EN   DEF_ENABLED        /* Enable (DEF_ENABLED) check for called from ISR                        */
-#define OS_CFG_DBG_EN                   DEF_DISABLED       /* Enable (DEF_ENABLED) debug code/variables                             */
-#define OS_CFG_DYN_TICK_EN              DEF_DISABLED       /* Enable (DEF_ENABLED) the Dynamic Tick                                 */
+#define OS_CFG_DBG_EN                   DEF_ENABLED        /* Enable (DEF_ENABLED) debug code/variables                             */
+#define OS_CFG_DYN_TICK_EN              DEF_ENABLED        /* Enable (DEF_ENABLED) the Dynamic Tick                                 */
+#define OS_CFG_ISR_POST_DEFERRED_EN     DEF_ENABLED        /* Enable (DEF_ENABLED) deferring ISR posts to the ISR queue task        */
 #define OS_CFG_INVALID_OS_CALLS_CHK_EN  DEF_DISABLED        /* Enable (DEF_ENABLED) checks for invalid kernel calls                  */
 #define OS_CFG_OBJ_TYPE_CHK_EN          DEF_DISABLED        /* Enable (DEF_ENABLED) object type checking                             */
-#define OS_CFG_TS_EN                    DEF_DISABLED       /* Enable (DEF_ENABLED) time stamping                                    */
+#define OS_CFG_TS_EN                    DEF_ENABLED        /* Enable (DEF_ENABLED) time stamping                                    */
 
 #define OS_CFG_PRIO_MAX                 32u                /* Defines the maximum number of task priorities (see OS_PRIO data type) */
+#define OS_CFG_PEND_IDX_PRIO_MAX        32u                /* Priorities a pend list index covers (see OS_CFG_xxx_PEND_IDX_EN):     */
+                                                           /*     N = this: each indexed object holds 4*N + 4*N/32 bytes, 132 B     */
+                                                           /*     at 32, and each pend list 4 B. Waiters at N and up are walked     */
 
 #define OS_CFG_SCHED_LOCK_TIME_MEAS_EN  DEF_DISABLED       /* Include (DEF_ENABLED) code to measure scheduler lock time             */
 #define OS_CFG_SCHED_ROUND_ROBIN_EN     DEF_ENABLED        /* Include (DEF_ENABLED) code for Round-Robin scheduling                 */
@@ -58,16 +62,21 @@
 #define OS_CFG_FLAG_DEL_EN              DEF_DISABLED        /*     Include (DEF_ENABLED) code for OSFlagDel()                        */
 #define OS_CFG_FLAG_MODE_CLR_EN         DEF_ENABLED        /*     Include (DEF_ENABLED) code for Wait on Clear EVENT FLAGS          */
 #define OS_CFG_FLAG_PEND_ABORT_EN       DEF_ENABLED        /*     Include (DEF_ENABLED) code for OSFlagPendAbort()                  */
+#define OS_CFG_FLAG_PEND_IDX_EN         DEF_DISABLED       /*     Index waiters by priority (DEF_ENABLED) for O(1) pend insert      */
 
 
                                                            /* ------------------------ MEMORY MANAGEMENT -------------------------  */
 #define OS_CFG_MEM_EN                   DEF_ENABLED        /* Enable (DEF_ENABLED) code generation for the MEMORY MANAGER           */
+#define OS_CFG_MEM_LOCK_FREE_EN         DEF_DISABLED       /*     Get/put blocks without disabling interrupts (DEF_ENABLED)         */
+#define OS_CFG_MEM_REF_EN               DEF_DISABLED       /*     Include (DEF_ENABLED) reference-counted blocks and OSQPostRef()   */
+#define OS_CFG_MEM_SLAB_EN              DEF_DISABLED       /*     Include (DEF_ENABLED) size-class slabs, see OSMemSlabCreate()     */
 
 
                                                            /* ------------------- MUTUAL EXCLUSION SEMAPHORES --------------------  */
 #define OS_CFG_MUTEX_EN                 DEF_ENABLED        /* Enable (DEF_ENABLED) code generation for MUTEX                        */
 #define OS_CFG_MUTEX_DEL_EN             DEF_ENABLED        /*     Include (DEF_ENABLED) code for OSMutexDel()                       */
 #define OS_CFG_MUTEX_PEND_ABORT_EN      DEF_ENABLED        /*     Include (DEF_ENABLED) code for OSMutexPendAbort()                 */
+#define OS_CFG_MUTEX_PEND_IDX_EN        DEF_ENABLED        /*     Index waiters by priority (DEF_ENABLED) for O(1) pend insert      */
 
 
                                                            /* -------------------------- MESSAGE QUEUES --------------------------  */
@@ -75,12 +84,15 @@
 #define OS_CFG_Q_DEL_EN                 DEF_ENABLED        /*     Include (DEF_ENABLED) code for OSQDel()                           */
 #define OS_CFG_Q_FLUSH_EN               DEF_ENABLED        /*     Include (DEF_ENABLED) code for OSQFlush()                         */
 #define OS_CFG_Q_PEND_ABORT_EN          DEF_ENABLED        /*     Include (DEF_ENABLED) code for OSQPendAbort()                     */
+#define OS_CFG_Q_PEND_IDX_EN            DEF_DISABLED       /*     Index waiters by priority (DEF_ENABLED) for O(1) pend insert      */
+#define OS_CFG_MSG_POOL_LOCAL_EN        DEF_DISABLED       /* Enable (DEF_ENABLED) per-queue OS_MSG pools, see OSMsgPoolCreate()    */
 
 
                                                            /* ---------------------------- SEMAPHORES ----------------------------- */
 #define OS_CFG_SEM_EN                   DEF_ENABLED        /* Enable (DEF_ENABLED) code generation for SEMAPHORES                   */
 #define OS_CFG_SEM_DEL_EN               DEF_ENABLED        /*     Include (DEF_ENABLED) code for OSSemDel()                         */
 #define OS_CFG_SEM_PEND_ABORT_EN        DEF_ENABLED        /*     Include (DEF_ENABLED) code for OSSemPendAbort()                   */
+#define OS_CFG_SEM_PEND_IDX_EN          DEF_ENABLED        /*     Index waiters by priority (DEF_ENABLED) for O(1) pend insert      */
 #define OS_CFG_SEM_SET_EN               DEF_ENABLED        /*     Include (DEF_ENABLED) code for OSSemSet()                         */
 
 
@@ -96,14 +108,20 @@
 #define OS_CFG_TASK_DEL_EN              DEF_ENABLED        /* Include (DEF_ENABLED) code for OSTaskDel()                            */
 #define OS_CFG_TASK_IDLE_EN             DEF_ENABLED        /* Include (DEF_ENABLED) the idle task                                   */
 #define OS_CFG_TASK_PROFILE_EN          DEF_ENABLED       /* Include (DEF_ENABLED) variables in OS_TCB for profiling               */
+#define OS_CFG_PROF_EN                  DEF_ENABLED        /* Include (DEF_ENABLED) the run-time profiler (os_prof.c)               */
 #define OS_CFG_TASK_Q_EN                DEF_ENABLED        /* Include (DEF_ENABLED) code for OSTaskQXXXX()                          */
 #define OS_CFG_TASK_Q_PEND_ABORT_EN     DEF_ENABLED        /* Include (DEF_ENABLED) code for OSTaskQPendAbort()                     */
 #define OS_CFG_TASK_REG_TBL_SIZE        1u                 /* Number of task specific registers                                     */
 #define OS_CFG_TASK_STK_REDZONE_EN      DEF_DISABLED       /* Enable (DEF_ENABLED) stack redzone                                    */
 #define OS_CFG_TASK_STK_REDZONE_DEPTH   8u                 /*     Depth of the stack redzone                                        */
+#define OS_CFG_STK_GUARD_EN             DEF_ENABLED        /* Trap (DEF_ENABLED) stack overflows with a guard, see os_stk_guard.c   */
 #define OS_CFG_TASK_SEM_PEND_ABORT_EN   DEF_ENABLED        /* Include (DEF_ENABLED) code for OSTaskSemPendAbort()                   */
 #define OS_CFG_TASK_SUSPEND_EN          DEF_ENABLED        /* Include (DEF_ENABLED) code for OSTaskSuspend() and OSTaskResume()     */
+#define OS_CFG_TASK_BUDGET_EN           DEF_ENABLED        /* Include (DEF_ENABLED) per-task CPU budgets, see os_budget.c           */
+#define OS_CFG_TASK_BUDGET_REPL_MAX     4u                 /*     Pending replenishments per budgeted task                          */
+#define OS_CFG_EDF_EN                   DEF_ENABLED        /* Include (DEF_ENABLED) EDF bands, see os_edf.c                         */
 #define OS_CFG_TASK_TICK_EN             DEF_ENABLED        /* Include (DEF_ENABLED) the kernel tick task                            */
+#define OS_CFG_TICK_WHEEL_EN            DEF_DISABLED       /*     Keep tick lists in a timing wheel (DEF_DISABLED: delta lists)     */
 
                                                            /* ------------------ TASK LOCAL STORAGE MANAGEMENT -------------------  */
 #define OS_CFG_TLS_TBL_SIZE             0u                 /* Include (DEF_ENABLED) code for Task Local Storage (TLS) registers     */
@@ -115,10 +133,14 @@
                                                            /* ------------------------- TIMER MANAGEMENT -------------------------- */
 #define OS_CFG_TMR_EN                   DEF_ENABLED        /* Enable (DEF_ENABLED) code generation for TIMERS                       */
 #define OS_CFG_TMR_DEL_EN               DEF_ENABLED        /* Enable (DEF_ENABLED) code generation for OSTmrDel()                   */
+#define OS_CFG_TMR_WHEEL_EN             DEF_ENABLED        /*     Keep running timers in a timer wheel (DEF_DISABLED: one list)     */
 
                                                            /* ------------------------- TRACE RECORDER ---------------------------- */
-#define OS_CFG_TRACE_EN                 DEF_DISABLED       /* Enable (DEF_ENABLED) uC/OS-III Trace instrumentation                  */
+#define OS_CFG_TRACE_EN                 DEF_ENABLED        /* Enable (DEF_ENABLED) uC/OS-III Trace instrumentation                  */
 #define OS_CFG_TRACE_API_ENTER_EN       DEF_DISABLED       /* Enable (DEF_ENABLED) uC/OS-III Trace API enter instrumentation        */
 #define OS_CFG_TRACE_API_EXIT_EN        DEF_DISABLED       /* Enable (DEF_ENABLED) uC/OS-III Trace API exit  instrumentation        */
+#define OS_CFG_TRACE_RAM_SIZE           1024u              /* Events kept by the RAM recorder (Trace/RamRing), power of 2           */
+#define OS_CFG_TRACE_RAM_STOP_EN        DEF_DISABLED       /* Stop (DEF_ENABLED) when full, else overwrite the oldest               */
+#define OS_CFG_TRACE_RAM_OBJ_MAX        48u                /* Objects whose names the RAM recorder keeps                            */
 
 #endif
@@ -48,6 +48,11 @@
 #define  OS_CFG_TASK_STK_LIMIT_PCT_EMPTY              10u       /* Stack limit position in percentage to empty          */
 
 
+                                                                /* ------------------ ISR POST QUEUE ------------------ */
+#define  OS_CFG_INT_Q_SIZE                            16u       /* Deferred ISR posts (power of 2, 2 or more)           */
+#define  OS_CFG_INT_Q_TASK_STK_SIZE                  128u       /* Stack size (number of CPU_STK elements)              */
+
+
                                                                 /* -------------------- IDLE TASK --------------------- */
 #define  OS_CFG_IDLE_TASK_STK_SIZE                    64u       /* Stack size (number of CPU_STK elements)              */
 
@@ -412,6 +412,10 @@ void        CPU_WaitForExcept(void);
 
 CPU_DATA    CPU_RevBits      (CPU_DATA    val);
 
+CPU_BOOLEAN CPU_AtomicCmpSwap(CPU_DATA   *p_data,
+                              CPU_DATA    cmp,
+                              CPU_DATA    val);
+
 void        CPU_BitBandClr   (CPU_ADDR    addr,
                               CPU_INT08U  bit_nbr);
 void        CPU_BitBandSet   (CPU_ADDR    addr,
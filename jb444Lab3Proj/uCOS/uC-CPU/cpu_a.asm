@@ -50,6 +50,8 @@
         .global  CPU_CntTrailZeros
         .global  CPU_RevBits
 
+        .global  CPU_AtomicCmpSwap
+
 
 @********************************************************************************************************
 @                                      CODE GENERATION DIRECTIVES
@@ -282,6 +284,52 @@ CPU_RevBits:
         BX      LR
 
 
+@********************************************************************************************************
+@                                        CPU_AtomicCmpSwap()
+@                                      ATOMIC COMPARE AND SWAP
+@
+@ Description : Stores a new value in a data word, only if the word still holds an expected value.
+@
+@ Prototypes  : CPU_BOOLEAN  CPU_AtomicCmpSwap(CPU_DATA  *p_data,
+@                                              CPU_DATA   cmp,
+@                                              CPU_DATA   val);
+@
+@ Argument(s) : p_data      Pointer to the data word.
+@
+@               cmp         Value the word must hold.
+@
+@               val         Value to store.
+@
+@ Return(s)   : 1 (DEF_OK),   if 'val' was stored.
+@
+@               0 (DEF_FAIL), if the word did not hold 'cmp'.
+@
+@ Caller(s)   : Application.
+@
+@               This function is an INTERNAL CPU module function but MAY be called by application function(s).
+@
+@ Note(s)     : (1) Interrupts are not disabled.  Exception entry and return clear the local exclusive
+@                   monitor, so an interrupt between LDREX and STREX makes STREX fail and the exchange is
+@                   tried again.  This makes the exchange atomic against any ISR, nested or not.
+@********************************************************************************************************
+
+.thumb_func
+CPU_AtomicCmpSwap:
+        LDREX   R3, [R0]                        @ Read and reserve the word
+        CMP     R3, R1
+        BNE     CPU_AtomicCmpSwap_Fail
+        STREX   R3, R2, [R0]                    @ Store if still reserved
+        CMP     R3, #0
+        BNE     CPU_AtomicCmpSwap               @ Reservation lost (see Note #1), try again
+        MOVS    R0, #1
+        BX      LR
+
+CPU_AtomicCmpSwap_Fail:
+        CLREX                                   @ Release the reservation
+        MOVS    R0, #0
+        BX      LR
+
+
 @********************************************************************************************************
 @                                     CPU ASSEMBLY PORT FILE END
 @********************************************************************************************************
@@ -39,6 +39,24 @@
 const  CPU_CHAR  *os_core__c = "$Id: $";
 #endif
 
+/*
+************************************************************************************************************************
+*                                                 FUNCTION PROTOTYPES
+************************************************************************************************************************
+*/
+
+#if (OS_PEND_LIST_IDX_EN == DEF_ENABLED)
+static  void     OS_PendListIdxInsert     (OS_PEND_LIST      *p_pend_list,
+                                           OS_TCB            *p_tcb,
+                                           OS_PRIO            prio);
+
+static  void     OS_PendListIdxRemove     (OS_PEND_LIST_IDX  *p_idx,
+                                           OS_TCB            *p_tcb);
+
+static  OS_TCB  *OS_PendListIdxPrevGet    (OS_PEND_LIST_IDX  *p_idx,
+                                           OS_PRIO            prio);
+#endif
+
 /*
 ************************************************************************************************************************
 *                                                    INITIALIZATION
@@ -117,6 +135,9 @@ void  OSInit (OS_ERR  *p_err)
 #if (OS_CFG_APP_HOOKS_EN == DEF_ENABLED)                        /* Clear application hook pointers                      */
 #if (OS_CFG_TASK_STK_REDZONE_EN == DEF_ENABLED)
     OS_AppRedzoneHitHookPtr = (OS_APP_HOOK_TCB )0;
+#endif
+#if (OS_CFG_STK_GUARD_EN == DEF_ENABLED)
+    OS_AppStkGuardHitHookPtr = (OS_APP_HOOK_TCB )0;
 #endif
     OS_AppTaskCreateHookPtr = (OS_APP_HOOK_TCB )0;
     OS_AppTaskDelHookPtr    = (OS_APP_HOOK_TCB )0;
@@ -136,6 +157,20 @@ void  OSInit (OS_ERR  *p_err)
 
     OS_RdyListInit();                                           /* Initialize the Ready List                            */
 
+#if (OS_CFG_PROF_EN == DEF_ENABLED)
+    OS_ProfInit();                                              /* Initialize the run-time profiler                     */
+#endif
+
+    OS_TRACE_INIT();                                            /* Initialize the trace recorder, before any object     */
+
+#if (OS_CFG_STK_GUARD_EN == DEF_ENABLED)
+    OS_StkGuardInit();                                          /* Arm the guard of the ISR stack                       */
+#endif
+
+#if (OS_CFG_TASK_BUDGET_EN == DEF_ENABLED)
+    OS_BudgetInit();                                            /* No task has a CPU budget yet                         */
+#endif
+
 
 #if (OS_CFG_FLAG_EN == DEF_ENABLED)                             /* Initialize the Event Flag module                     */
 #if (OS_CFG_DBG_EN == DEF_ENABLED)
@@ -206,6 +241,14 @@ void  OSInit (OS_ERR  *p_err)
 #endif
 
 
+#if (OS_CFG_ISR_POST_DEFERRED_EN == DEF_ENABLED)
+    OS_IntQTaskInit(p_err);                                     /* Initialize the ISR post queue and its task           */
+    if (*p_err != OS_ERR_NONE) {
+        return;
+    }
+#endif
+
+
 #if (OS_CFG_TASK_TICK_EN == DEF_ENABLED)
     OS_TickTaskInit(p_err);                                     /* Initialize the Tick Task                             */
     if (*p_err != OS_ERR_NONE) {
@@ -282,6 +325,7 @@ void  OSIntEnter (void)
     }
 
     OSIntNestingCtr++;                                          /* Increment ISR nesting level                          */
+    OS_PROF_INT_ENTER();
 }
 
 
@@ -326,6 +370,7 @@ void  OSIntExit (void)
         return;
     }
     OSIntNestingCtr--;
+    OS_PROF_INT_EXIT();
     if (OSIntNestingCtr > 0u) {                                 /* ISRs still nested?                                   */
         OS_TRACE_ISR_EXIT();
         CPU_INT_EN();                                           /* Yes                                                  */
@@ -1202,15 +1247,19 @@ void  OS_PendDbgNameRemove (OS_PEND_OBJ  *p_obj,
 * Arguments  : p_tcb       is a pointer to the TCB of the task to move
 *              -----
 *
+*              prio_new    is the new priority of the task
+*
 * Returns    : none
 *
 * Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application MUST NOT call it.
 *
-*              2) It's assumed that the TCB contains the NEW priority in its .Prio field.
+*              2) The TCB still holds the OLD priority in its .Prio field on entry, so that the task can be found in the
+*                 pend list index. This function sets the new one.
 ************************************************************************************************************************
 */
 
-void  OS_PendListChangePrio (OS_TCB  *p_tcb)
+void  OS_PendListChangePrio (OS_TCB   *p_tcb,
+                             OS_PRIO   prio_new)
 {
     OS_PEND_LIST  *p_pend_list;
     OS_PEND_OBJ   *p_obj;
@@ -1218,11 +1267,19 @@ void  OS_PendListChangePrio (OS_TCB  *p_tcb)
     p_obj       =  p_tcb->PendObjPtr;                           /* Get pointer to pend list                             */
     p_pend_list = &p_obj->PendList;
 
+#if (OS_PEND_LIST_IDX_EN == DEF_ENABLED)
+    if ((p_pend_list->HeadPtr->PendNextPtr != (OS_TCB           *)0) ||
+        (p_pend_list->IdxPtr               != (OS_PEND_LIST_IDX *)0)) { /* An index is keyed by priority, always move   */
+#else
     if (p_pend_list->HeadPtr->PendNextPtr != (OS_TCB *)0) {     /* Only move if multiple entries in the list            */
+#endif
             OS_PendListRemove(p_tcb);                           /* Remove entry from current position                   */
             p_tcb->PendObjPtr = p_obj;
+            p_tcb->Prio       = prio_new;
             OS_PendListInsertPrio(p_pend_list,                  /* INSERT it back in the list                           */
                                   p_tcb);
+    } else {
+        p_tcb->Prio = prio_new;
     }
 }
 
@@ -1249,9 +1306,49 @@ void  OS_PendListInit (OS_PEND_LIST  *p_pend_list)
 #if (OS_CFG_DBG_EN == DEF_ENABLED)
     p_pend_list->NbrEntries =           0u;
 #endif
+#if (OS_PEND_LIST_IDX_EN == DEF_ENABLED)
+    p_pend_list->IdxPtr     = (OS_PEND_LIST_IDX *)0;
+#endif
 }
 
 
+/*
+************************************************************************************************************************
+*                                            ATTACH A PRIORITY INDEX TO A WAIT LIST
+*
+* Description: This function is called by the OSxxxCreate() of object types that index their pend list, right after
+*              OS_PendListInit().
+*
+* Arguments  : p_pend_list   is a pointer to an empty OS_PEND_LIST
+*              -----------
+*
+*              p_idx         is a pointer to the index, stored in the same object
+*              -----
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application must not call it.
+************************************************************************************************************************
+*/
+
+#if (OS_PEND_LIST_IDX_EN == DEF_ENABLED)
+void  OS_PendListIdxInit (OS_PEND_LIST      *p_pend_list,
+                          OS_PEND_LIST_IDX  *p_idx)
+{
+    OS_PRIO  i;
+
+
+    for (i = 0u; i < OS_PEND_IDX_TBL_SIZE; i++) {
+        p_idx->PrioTbl[i] = 0u;
+    }
+    for (i = 0u; i < OS_CFG_PEND_IDX_PRIO_MAX; i++) {
+        p_idx->TailPtr[i] = (OS_TCB *)0;
+    }
+    p_pend_list->IdxPtr = p_idx;
+}
+#endif
+
+
 /*
 ************************************************************************************************************************
 *                                  INSERT A TASK BASED ON IT'S PRIORITY IN A PEND LIST
@@ -1312,6 +1409,9 @@ void  OS_PendListInit (OS_PEND_LIST  *p_pend_list)
 * Returns    : none
 *
 * Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application MUST NOT call it.
+*
+*              2) If the list has a priority index the position is found from the index in constant time (see
+*                 OS_PendListIdxPrevGet()) instead of by walking the list.
 ************************************************************************************************************************
 */
 
@@ -1324,6 +1424,13 @@ void  OS_PendListInsertPrio (OS_PEND_LIST  *p_pend_list,
 
     prio  = p_tcb->Prio;                                        /* Obtain the priority of the task to insert            */
 
+#if (OS_PEND_LIST_IDX_EN == DEF_ENABLED)
+    if (p_pend_list->IdxPtr != (OS_PEND_LIST_IDX *)0) {         /* See Note #2.                                         */
+        OS_PendListIdxInsert(p_pend_list, p_tcb, prio);
+        return;
+    }
+#endif
+
     if (p_pend_list->HeadPtr == (OS_TCB *)0) {                  /* CASE 0: Insert when there are no entries             */
 #if (OS_CFG_DBG_EN == DEF_ENABLED)
         p_pend_list->NbrEntries = 1u;                           /* This is the first entry                              */
@@ -1424,6 +1531,11 @@ void  OS_PendListRemove (OS_TCB  *p_tcb)
     if (p_tcb->PendObjPtr != (OS_PEND_OBJ *)0) {                /* Only remove if object has a pend list.               */
         p_pend_list = &p_tcb->PendObjPtr->PendList;             /* Get pointer to pend list                             */
 
+#if (OS_PEND_LIST_IDX_EN == DEF_ENABLED)
+        if (p_pend_list->IdxPtr != (OS_PEND_LIST_IDX *)0) {     /* Keep the index of the last waiter per priority       */
+            OS_PendListIdxRemove(p_pend_list->IdxPtr, p_tcb);
+        }
+#endif
                                                                 /* Remove TCB from the pend list.                       */
         if (p_pend_list->HeadPtr->PendNextPtr == (OS_TCB *)0) {
             p_pend_list->HeadPtr = (OS_TCB *)0;                 /* Only one entry in the pend list                      */
@@ -1520,6 +1632,9 @@ void  OS_Post (OS_PEND_OBJ  *p_obj,
              if (p_tcb->TaskState == OS_TASK_STATE_PEND_TIMEOUT) {
                  OS_TickListRemove(p_tcb);                      /* Remove from tick list                                */
              }
+#endif
+#if (OS_CFG_EDF_EN == DEF_ENABLED)
+             p_tcb->EdfWake    = DEF_TRUE;                      /* New job once made ready, see os_edf.c Note #2        */
 #endif
              OS_RdyListInsert(p_tcb);                           /* Insert the task in the ready list                    */
              p_tcb->TaskState  = OS_TASK_STATE_RDY;
@@ -1547,6 +1662,9 @@ void  OS_Post (OS_PEND_OBJ  *p_obj,
              if (p_tcb->TaskState == OS_TASK_STATE_PEND_TIMEOUT_SUSPENDED) {
                  OS_TickListRemove(p_tcb);                      /* Cancel any timeout                                   */
              }
+#endif
+#if (OS_CFG_EDF_EN == DEF_ENABLED)
+             p_tcb->EdfWake    = DEF_TRUE;                      /* New job once made ready, see os_edf.c Note #2        */
 #endif
              p_tcb->TaskState  = OS_TASK_STATE_SUSPENDED;
              p_tcb->PendStatus = OS_STATUS_PEND_OK;             /* Clear pend status                                    */
@@ -1634,12 +1752,23 @@ void  OS_RdyListInit (void)
 *
 * Returns    : none
 *
-* Note(s)    : This function is INTERNAL to uC/OS-III and your application should not call it.
+* Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application should not call it.
+*
+*              2) A task with a deadline is inserted in deadline order.  It starts a new job only if it was woken by a
+*                 post or by the tick, see os_edf.c Note #2.
 ************************************************************************************************************************
 */
 
 void  OS_RdyListInsert (OS_TCB  *p_tcb)
 {
+#if (OS_CFG_EDF_EN == DEF_ENABLED)
+    if (p_tcb->EdfWake == DEF_TRUE) {                           /* See Note #2                                          */
+        p_tcb->EdfWake = DEF_FALSE;
+        if (p_tcb->EdfDeadline > 0u) {
+            OS_EdfRelease(p_tcb);
+        }
+    }
+#endif
     OS_PrioInsert(p_tcb->Prio);
     if (p_tcb->Prio == OSPrioCur) {                             /* Are we readying a task at the same prio?             */
         OS_RdyListInsertTail(p_tcb);                            /* Yes, insert readied task at the end of the list      */
@@ -1704,6 +1833,8 @@ void  OS_RdyListInsert (OS_TCB  *p_tcb)
 * Returns    : none
 *
 * Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application MUST NOT call it.
+*
+*              2) A task with a deadline is inserted in deadline order instead (see os_edf.c).
 ************************************************************************************************************************
 */
 
@@ -1714,6 +1845,12 @@ void  OS_RdyListInsertHead (OS_TCB  *p_tcb)
 
 
 
+#if (OS_CFG_EDF_EN == DEF_ENABLED)
+    if (p_tcb->EdfDeadline > 0u) {                              /* See Note #2                                          */
+        OS_EdfRdyListInsert(p_tcb);
+        return;
+    }
+#endif
     p_rdy_list = &OSRdyList[p_tcb->Prio];
     if (p_rdy_list->HeadPtr == (OS_TCB *)0) {                   /* CASE 0: Insert when there are no entries             */
 #if (OS_CFG_DBG_EN == DEF_ENABLED)
@@ -1789,6 +1926,8 @@ void  OS_RdyListInsertHead (OS_TCB  *p_tcb)
 * Returns    : none
 *
 * Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application MUST NOT call it.
+*
+*              2) A task with a deadline is inserted in deadline order instead (see os_edf.c).
 ************************************************************************************************************************
 */
 
@@ -1799,6 +1938,12 @@ void  OS_RdyListInsertTail (OS_TCB  *p_tcb)
 
 
 
+#if (OS_CFG_EDF_EN == DEF_ENABLED)
+    if (p_tcb->EdfDeadline > 0u) {                              /* See Note #2                                          */
+        OS_EdfRdyListInsert(p_tcb);
+        return;
+    }
+#endif
     p_rdy_list = &OSRdyList[p_tcb->Prio];
     if (p_rdy_list->HeadPtr == (OS_TCB *)0) {                   /* CASE 0: Insert when there are no entries             */
 #if (OS_CFG_DBG_EN == DEF_ENABLED)
@@ -1870,6 +2015,8 @@ void  OS_RdyListInsertTail (OS_TCB  *p_tcb)
 * Returns    : none
 *
 * Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application MUST NOT call it.
+*
+*              2) A list in deadline order is left as it is (see os_edf.c).
 ************************************************************************************************************************
 */
 
@@ -1880,6 +2027,12 @@ void  OS_RdyListMoveHeadToTail (OS_RDY_LIST  *p_rdy_list)
     OS_TCB  *p_tcb3;
 
 
+#if (OS_CFG_EDF_EN == DEF_ENABLED)
+    if ((p_rdy_list->HeadPtr              != (OS_TCB *)0) &&    /* See Note #2                                          */
+        (p_rdy_list->HeadPtr->EdfDeadline >  0u)) {
+        return;
+    }
+#endif
      if (p_rdy_list->HeadPtr != p_rdy_list->TailPtr) {
          if (p_rdy_list->HeadPtr->NextPtr == p_rdy_list->TailPtr) { /* SWAP the TCBs                                    */
              p_tcb1              =  p_rdy_list->HeadPtr;        /* Point to current head                                */
@@ -1950,6 +2103,8 @@ void  OS_RdyListMoveHeadToTail (OS_RDY_LIST  *p_rdy_list)
 * Returns    : A pointer to the OS_RDY_LIST where the OS_TCB was
 *
 * Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application MUST NOT call it.
+*
+*              2) The job of a task with a deadline is checked against it (see os_edf.c).
 ************************************************************************************************************************
 */
 
@@ -1961,6 +2116,11 @@ void  OS_RdyListRemove (OS_TCB  *p_tcb)
 
 
 
+#if (OS_CFG_EDF_EN == DEF_ENABLED)
+    if (p_tcb->EdfDeadline > 0u) {                              /* See Note #2                                          */
+        OS_EdfJobChk(p_tcb);
+    }
+#endif
     p_rdy_list = &OSRdyList[p_tcb->Prio];
     p_tcb1     = p_tcb->PrevPtr;                                /* Point to next and previous OS_TCB in the list        */
     p_tcb2     = p_tcb->NextPtr;
@@ -2058,14 +2218,23 @@ void  OS_SchedLockTimeMeasStop (void)
 * Arguments  : p_rdy_list    is a pointer to the OS_RDY_LIST entry of the ready list at the current priority
 *              ----------
 *
+*              ticks         is the number of ticks elapsed since the last call, more than 1 with the dynamic tick.
+*
 * Returns    : none
 *
 * Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application MUST NOT call it.
+*
+*              2) A task alone at its priority has nothing to share its time with, so the ready list is left alone
+*                 and its time quanta counter does not run.  This is the case on almost every tick.
+*
+*              3) With the dynamic tick, the ticks since the last one are all charged to the task running when the
+*                 next one is announced.  OS_SchedRoundRobinArm() makes sure that happens by the end of its quanta.
 ************************************************************************************************************************
 */
 
 #if (OS_CFG_SCHED_ROUND_ROBIN_EN == DEF_ENABLED)
-void  OS_SchedRoundRobin (OS_RDY_LIST  *p_rdy_list)
+void  OS_SchedRoundRobin (OS_RDY_LIST  *p_rdy_list,
+                          OS_TICK       ticks)
 {
     OS_TCB   *p_tcb;
     CPU_SR_ALLOC();
@@ -2075,6 +2244,10 @@ void  OS_SchedRoundRobin (OS_RDY_LIST  *p_rdy_list)
         return;
     }
 
+    if (p_rdy_list->HeadPtr == p_rdy_list->TailPtr) {           /* See Note #2                                          */
+        return;
+    }
+
     CPU_CRITICAL_ENTER();
     p_tcb = p_rdy_list->HeadPtr;                                /* Decrement time quanta counter                        */
 
@@ -2090,14 +2263,12 @@ void  OS_SchedRoundRobin (OS_RDY_LIST  *p_rdy_list)
     }
 #endif
 
-    if (p_tcb->TimeQuantaCtr > 0u) {
-        p_tcb->TimeQuantaCtr--;
-    }
-
-    if (p_tcb->TimeQuantaCtr > 0u) {                            /* Task not done with its time quanta                   */
+    if (p_tcb->TimeQuantaCtr > ticks) {                         /* Task not done with its time quanta (see Note #3)     */
+        p_tcb->TimeQuantaCtr -= ticks;
         CPU_CRITICAL_EXIT();
         return;
     }
+    p_tcb->TimeQuantaCtr = 0u;
 
     if (p_rdy_list->HeadPtr == p_rdy_list->TailPtr) {           /* See if it's time to time slice current task          */
         CPU_CRITICAL_EXIT();                                    /* ... only if multiple tasks at same priority          */
@@ -2121,6 +2292,56 @@ void  OS_SchedRoundRobin (OS_RDY_LIST  *p_rdy_list)
 #endif
 
 
+/*
+************************************************************************************************************************
+*                                          ARM A TICK AT THE END OF A TIME SLICE
+*
+* Description: This function is called by OSTaskSwHook() with the dynamic tick.  If the task being switched in shares
+*              its priority with other ready tasks, it makes sure a tick comes by the end of the task's time quanta.
+*
+* Arguments  : p_tcb         is a pointer to the OS_TCB of the task being switched in
+*              -----
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application MUST NOT call it.
+*
+*              2) This function is called with interrupts disabled.
+*
+*              3) Without other ready tasks at its priority, a task needs no tick to be rotated, so a tick is only
+*                 armed while the time is actually being shared.  Nor does a task with a deadline (see os_edf.c).
+************************************************************************************************************************
+*/
+
+#if (OS_CFG_SCHED_ROUND_ROBIN_EN == DEF_ENABLED) && (OS_CFG_DYN_TICK_EN == DEF_ENABLED)
+void  OS_SchedRoundRobinArm (OS_TCB  *p_tcb)
+{
+    OS_RDY_LIST  *p_rdy_list;
+
+
+    if (OSSchedRoundRobinEn != DEF_TRUE) {
+        return;
+    }
+
+    p_rdy_list = &OSRdyList[p_tcb->Prio];
+    if (p_rdy_list->HeadPtr == p_rdy_list->TailPtr) {           /* See Note #3                                          */
+        return;
+    }
+#if (OS_CFG_EDF_EN == DEF_ENABLED)
+    if (p_tcb->EdfDeadline > 0u) {
+        return;
+    }
+#endif
+
+    if (p_tcb->TimeQuantaCtr == 0u) {
+        OS_TickArm(1u);
+    } else {
+        OS_TickArm(p_tcb->TimeQuantaCtr);
+    }
+}
+#endif
+
+
 /*
 ************************************************************************************************************************
 *                                                     BLOCK A TASK
@@ -2168,3 +2389,218 @@ void  OS_TaskBlock (OS_TCB   *p_tcb,
 #endif
     OS_RdyListRemove(p_tcb);
 }
+
+
+/*
+************************************************************************************************************************
+*                                          INSERT A TASK USING THE PEND LIST INDEX
+*
+* Description: This function links a task in after the last waiter of its own or the next higher priority, then records
+*              it as the last waiter of its priority.
+*
+* Arguments  : p_pend_list   is a pointer to a pend list that has a priority index
+*              -----------
+*
+*              p_tcb         is a pointer to the TCB of the task to insert
+*              -----
+*
+*              prio          is the priority of the task
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application MUST NOT call it.
+*
+*              2) A task at OS_CFG_PEND_IDX_PRIO_MAX or lower priority is not indexed.  It is linked in after the last
+*                 indexed waiter and the waiters of its own or higher unindexed priorities, found by walking the list.
+************************************************************************************************************************
+*/
+
+#if (OS_PEND_LIST_IDX_EN == DEF_ENABLED)
+static  void  OS_PendListIdxInsert (OS_PEND_LIST  *p_pend_list,
+                                    OS_TCB        *p_tcb,
+                                    OS_PRIO        prio)
+{
+    OS_PEND_LIST_IDX  *p_idx;
+    OS_TCB            *p_prev;
+    OS_TCB            *p_next;
+    CPU_DATA           bit;
+    CPU_DATA           bit_nbr;
+    OS_PRIO            ix;
+
+
+    p_idx  = p_pend_list->IdxPtr;
+#if (OS_CFG_PEND_IDX_PRIO_MAX < OS_CFG_PRIO_MAX)
+    if (prio >= OS_CFG_PEND_IDX_PRIO_MAX) {                     /* See Note #2.                                         */
+        p_prev = OS_PendListIdxPrevGet(p_idx, OS_CFG_PEND_IDX_PRIO_MAX - 1u);
+        p_next = (p_prev == (OS_TCB *)0) ? p_pend_list->HeadPtr : p_prev->PendNextPtr;
+        while ((p_next       != (OS_TCB *)0) &&
+               (p_next->Prio <= prio)) {
+            p_prev = p_next;
+            p_next = p_next->PendNextPtr;
+        }
+    } else {
+        p_prev = OS_PendListIdxPrevGet(p_idx, prio);
+    }
+#else
+    p_prev = OS_PendListIdxPrevGet(p_idx, prio);
+#endif
+    if (p_prev == (OS_TCB *)0) {                                /* No waiter of equal or higher priority: new head      */
+        p_next               = p_pend_list->HeadPtr;
+        p_pend_list->HeadPtr = p_tcb;
+    } else {
+        p_next               = p_prev->PendNextPtr;
+        p_prev->PendNextPtr  = p_tcb;
+    }
+    p_tcb->PendPrevPtr = p_prev;
+    p_tcb->PendNextPtr = p_next;
+    if (p_next == (OS_TCB *)0) {
+        p_pend_list->TailPtr = p_tcb;
+    } else {
+        p_next->PendPrevPtr  = p_tcb;
+    }
+#if (OS_CFG_DBG_EN == DEF_ENABLED)
+    p_pend_list->NbrEntries++;
+#endif
+
+#if (OS_CFG_PEND_IDX_PRIO_MAX < OS_CFG_PRIO_MAX)
+    if (prio >= OS_CFG_PEND_IDX_PRIO_MAX) {
+        return;
+    }
+#endif
+#if (OS_CFG_PEND_IDX_PRIO_MAX > DEF_INT_CPU_NBR_BITS)
+    ix                  = prio / (OS_PRIO)DEF_INT_CPU_NBR_BITS;
+    bit_nbr             = (CPU_DATA)prio & (DEF_INT_CPU_NBR_BITS - 1u);
+#else
+    ix                  = 0u;
+    bit_nbr             = prio;
+#endif
+    bit                 = 1u;
+    bit               <<= (DEF_INT_CPU_NBR_BITS - 1u) - bit_nbr;
+    p_idx->PrioTbl[ix] |= bit;
+    p_idx->TailPtr[prio] = p_tcb;
+}
+
+
+/*
+************************************************************************************************************************
+*                                         REMOVE A TASK FROM THE PEND LIST INDEX
+*
+* Description: This function is called before a task is unlinked from an indexed pend list. If the task was the last
+*              waiter at its priority, the one before it takes its place, or the priority is marked empty.
+*
+* Arguments  : p_idx         is a pointer to the priority index
+*              -----
+*
+*              p_tcb         is a pointer to the TCB of the task being removed
+*              -----
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application MUST NOT call it.
+*
+*              2) .Prio must still be the priority the task was inserted with (see OS_PendListChangePrio()).
+************************************************************************************************************************
+*/
+
+static  void  OS_PendListIdxRemove (OS_PEND_LIST_IDX  *p_idx,
+                                    OS_TCB            *p_tcb)
+{
+    OS_TCB    *p_prev;
+    OS_PRIO    prio;
+    CPU_DATA   bit;
+    CPU_DATA   bit_nbr;
+    OS_PRIO    ix;
+
+
+    prio = p_tcb->Prio;
+#if (OS_CFG_PEND_IDX_PRIO_MAX < OS_CFG_PRIO_MAX)
+    if (prio >= OS_CFG_PEND_IDX_PRIO_MAX) {                     /* Not indexed                                          */
+        return;
+    }
+#endif
+    if (p_idx->TailPtr[prio] != p_tcb) {                        /* Not the last waiter at its priority                  */
+        return;
+    }
+    p_prev = p_tcb->PendPrevPtr;
+    if ((p_prev != (OS_TCB *)0) &&
+        (p_prev->Prio == prio)) {
+        p_idx->TailPtr[prio] = p_prev;
+        return;
+    }
+    p_idx->TailPtr[prio] = (OS_TCB *)0;                         /* It was the only one                                  */
+#if (OS_CFG_PEND_IDX_PRIO_MAX > DEF_INT_CPU_NBR_BITS)
+    ix                   = prio / (OS_PRIO)DEF_INT_CPU_NBR_BITS;
+    bit_nbr              = (CPU_DATA)prio & (DEF_INT_CPU_NBR_BITS - 1u);
+#else
+    ix                   = 0u;
+    bit_nbr              = prio;
+#endif
+    bit                  = 1u;
+    bit                <<= (DEF_INT_CPU_NBR_BITS - 1u) - bit_nbr;
+    p_idx->PrioTbl[ix]  &= ~bit;
+}
+
+
+/*
+************************************************************************************************************************
+*                                       FIND WHERE A TASK GOES USING THE PEND LIST INDEX
+*
+* Description: This function returns the waiter a task of priority 'prio' is inserted after: the last waiter at 'prio'
+*              if there is one, otherwise the last waiter at the nearest higher priority.
+*
+* Arguments  : p_idx         is a pointer to the priority index
+*              -----
+*
+*              prio          is the priority of the task to insert
+*
+* Returns    : The TCB to insert after, or NULL to insert at the head of the list.
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application MUST NOT call it.
+*
+*              2) Higher priorities are the more significant bits of a table entry (as in OSPrioTbl[]), so the nearest
+*                 higher priority is the least significant bit set above the bit for 'prio'. At most one table entry is
+*                 looked at per DEF_INT_CPU_NBR_BITS priorities.
+************************************************************************************************************************
+*/
+
+static  OS_TCB  *OS_PendListIdxPrevGet (OS_PEND_LIST_IDX  *p_idx,
+                                        OS_PRIO            prio)
+{
+    CPU_DATA  bits;
+    CPU_DATA  bit;
+    CPU_DATA  bit_nbr;
+    OS_PRIO   ix;
+
+
+    if (p_idx->TailPtr[prio] != (OS_TCB *)0) {                  /* FIFO behind tasks of the same priority               */
+        return (p_idx->TailPtr[prio]);
+    }
+
+#if (OS_CFG_PEND_IDX_PRIO_MAX > DEF_INT_CPU_NBR_BITS)
+    ix      = prio / (OS_PRIO)DEF_INT_CPU_NBR_BITS;
+    bit_nbr = (CPU_DATA)prio & (DEF_INT_CPU_NBR_BITS - 1u);
+#else
+    ix      = 0u;
+    bit_nbr = prio;
+#endif
+    bit     = 1u;
+    bit   <<= (DEF_INT_CPU_NBR_BITS - 1u) - bit_nbr;
+    bits    = p_idx->PrioTbl[ix] & ~(bit | (bit - 1u));         /* Higher priorities in the same entry (see Note #2)    */
+#if (OS_CFG_PEND_IDX_PRIO_MAX > DEF_INT_CPU_NBR_BITS)
+    while (bits == 0u) {
+        if (ix == 0u) {
+            return ((OS_TCB *)0);
+        }
+        ix--;
+        bits = p_idx->PrioTbl[ix];
+    }
+#else
+    if (bits == 0u) {
+        return ((OS_TCB *)0);
+    }
+#endif
+    prio = (OS_PRIO)(ix * DEF_INT_CPU_NBR_BITS)
+         + (OS_PRIO)((DEF_INT_CPU_NBR_BITS - 1u) - CPU_CntTrailZeros(bits));
+    return (p_idx->TailPtr[prio]);
+}
+#endif
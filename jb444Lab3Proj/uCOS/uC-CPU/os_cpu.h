@@ -156,7 +156,8 @@ extern  "C" {                                    /* See Note #1.
 *********************************************************************************************************
 */
 
-OS_CPU_EXT  CPU_STK  *OS_CPU_ExceptStkBase;
+OS_CPU_EXT  CPU_STK     *OS_CPU_ExceptStkBase;
+OS_CPU_EXT  CPU_INT32U   OS_CPU_CtxSwCycles;      /* Cycles to restore, then save, the current task    */
 
 
 /*
@@ -177,9 +178,9 @@ void  OS_CPU_SysTickInitFreq(CPU_INT32U  cpu_freq);
 void  OS_CPU_SysTickHandler(void);
 void  OS_CPU_PendSVHandler (void);
 
-#if (OS_CPU_ARM_FP_EN > 0u)
-void  OS_CPU_FP_Reg_Push(CPU_STK  *stkPtr);
-void  OS_CPU_FP_Reg_Pop (CPU_STK  *stkPtr);
+#if (defined(OS_CFG_STK_GUARD_EN) && (OS_CFG_STK_GUARD_EN == DEF_ENABLED))
+void  OS_CPU_StkGuardInit(CPU_STK  *p_isr_guard);
+void  OS_CPU_StkGuardSet (CPU_STK  *p_guard);
 #endif
 
 
@@ -38,6 +38,7 @@
     .extern  OSIntExit
     .extern  OSTaskSwHook
     .extern  OS_CPU_ExceptStkBase
+    .extern  OS_CPU_CtxSwCycles
 
 
     .global  OSStartHighRdy                                     @ Functions declared in this file
@@ -45,11 +46,6 @@
     .global  OSIntCtxSw
     .global  OS_CPU_PendSVHandler
 
-#if (defined(__VFP_FP__) && !defined(__SOFTFP__))
-    .global  OS_CPU_FP_Reg_Push
-    .global  OS_CPU_FP_Reg_Pop
-#endif
-
 
 @********************************************************************************************************
 @                                               EQUATES
@@ -59,6 +55,7 @@
 .equ NVIC_SYSPRI14,     0xE000ED22                              @ System priority register (priority 14).
 .equ NVIC_PENDSV_PRI,   0xFF                                    @ PendSV priority value (lowest).
 .equ NVIC_PENDSVSET,    0x10000000                              @ Value to trigger PendSV exception.
+.equ DWT_CYCCNT,        0xE0001004                              @ DWT cycle counter.
 
 
 @********************************************************************************************************
@@ -71,56 +68,6 @@
    .syntax unified
 
 
-@********************************************************************************************************
-@                                   FLOATING POINT REGISTERS PUSH
-@                             void  OS_CPU_FP_Reg_Push (CPU_STK  *stkPtr)
-@
-@ Note(s) : 1) This function saves S16-S31 registers of the Floating Point Unit.
-@
-@           2) Pseudo-code is:
-@              a) Push remaining FPU regs S16-S31 on process stack;
-@              b) Update OSTCBCurPtr->StkPtr;
-@********************************************************************************************************
-
-#if (defined(__VFP_FP__) && !defined(__SOFTFP__))
-
-.thumb_func
-OS_CPU_FP_Reg_Push:
-    MRS     R1, PSP                                             @ PSP is process stack pointer
-    CBZ     R1, OS_CPU_FP_nosave                                @ Skip FP register save the first time
-
-    VSTMDB  R0!, {S16-S31}
-    LDR     R1, =OSTCBCurPtr
-    LDR     R2, [R1]
-    STR     R0, [R2]
-OS_CPU_FP_nosave:
-    BX      LR
-#endif
-
-
-@********************************************************************************************************
-@                                   FLOATING POINT REGISTERS POP
-@                             void  OS_CPU_FP_Reg_Pop (CPU_STK  *stkPtr)
-@
-@ Note(s) : 1) This function restores S16-S31 of the Floating Point Unit.
-@
-@           2) Pseudo-code is:
-@              a) Restore regs S16-S31 of new process stack;
-@              b) Update OSTCBHighRdyPtr->StkPtr pointer of new proces stack;
-@********************************************************************************************************
-
-#if (defined(__VFP_FP__) && !defined(__SOFTFP__))
-
-.thumb_func
-OS_CPU_FP_Reg_Pop:
-    VLDMIA  R0!, {S16-S31}
-    LDR     R1, =OSTCBHighRdyPtr
-    LDR     R2, [R1]
-    STR     R0, [R2]
-    BX      LR
-#endif
-
-
 @********************************************************************************************************
 @                                         START MULTITASKING
 @                                      void OSStartHighRdy(void)
@@ -140,6 +87,9 @@ OS_CPU_FP_Reg_Pop:
 @              f) Get new process SP from TCB, SP = OSTCBHighRdyPtr->StkPtr;
 @              g) Restore R0-R11 and R14 from new process stack;
 @              h) Enable interrupts (tasks will run with interrupts enabled).
+@
+@           4) The first task starts with no floating point context (CONTROL.FPCA clear), even if the code
+@              that ran before OSStart() used the FPU.  See OS_CPU_PendSVHandler() Note #5.
 @********************************************************************************************************
 
 .thumb_func
@@ -160,7 +110,7 @@ OSStartHighRdy:
     LDR     R1, [R0]
     MSR     MSP, R1
 
-    BL      OSTaskSwHook                                        @ Call OSTaskSwHook() for FPU Push & Pop
+    BL      OSTaskSwHook                                        @ Call OSTaskSwHook()
 
     MOVW    R0, #:lower16:OSPrioCur                             @ OSPrioCur   = OSPrioHighRdy;
     MOVT    R0, #:upper16:OSPrioCur
@@ -181,6 +131,9 @@ OSStartHighRdy:
 
     MRS     R0, CONTROL
     ORR     R0, R0, #2
+#if (defined(__VFP_FP__) && !defined(__SOFTFP__))
+    BIC     R0, R0, #4                                          @ No floating point context yet, see Note #4
+#endif
     MSR     CONTROL, R0
     ISB                                                         @ Sync instruction stream
 
@@ -236,14 +189,16 @@ OSIntCtxSw:
 @
 @           2) Pseudo-code is:
 @              a) Get the process SP
-@              b) Save remaining regs r4-r11 & r14 on process stack;
-@              c) Save the process SP in its TCB, OSTCBCurPtr->OSTCBStkPtr = SP;
-@              d) Call OSTaskSwHook();
-@              e) Get current high priority, OSPrioCur = OSPrioHighRdy;
-@              f) Get current ready thread TCB, OSTCBCurPtr = OSTCBHighRdyPtr;
-@              g) Get new process SP from TCB, SP = OSTCBHighRdyPtr->OSTCBStkPtr;
-@              h) Restore R4-R11 and R14 from new process stack;
-@              i) Perform exception return which will restore remaining context.
+@              b) Save S16-S31 on process stack if the task used the FPU (see Note #5);
+@              c) Save remaining regs r4-r11 & r14 on process stack;
+@              d) Save the process SP in its TCB, OSTCBCurPtr->OSTCBStkPtr = SP;
+@              e) Call OSTaskSwHook();
+@              f) Get current high priority, OSPrioCur = OSPrioHighRdy;
+@              g) Get current ready thread TCB, OSTCBCurPtr = OSTCBHighRdyPtr;
+@              h) Get new process SP from TCB, SP = OSTCBHighRdyPtr->OSTCBStkPtr;
+@              i) Restore R4-R11 and R14 from new process stack;
+@              j) Restore S16-S31 from new process stack if the task used the FPU;
+@              k) Perform exception return which will restore remaining context.
 @
 @           3) On entry into PendSV handler:
 @              a) The following have been saved on the process stack (by processor):
@@ -256,12 +211,30 @@ OSIntCtxSw:
 @           4) Since PendSV is set to lowest priority in the system (by OSStartHighRdy() above), we
 @              know that it will only be run when no other exception or interrupt is active, and
 @              therefore safe to assume that context being switched out was using the process stack (PSP).
+@
+@           5) A task uses the FPU from its first floating point instruction on, which sets CONTROL.FPCA.
+@              From then on the processor stacks the extended frame for it (S0-S15 and FPSCR, lazily) and
+@              clears bit 4 of EXC_RETURN.  Only then are S16-S31 saved and restored here, below R4-R11
+@              and R14, so a task that never touches a float switches in the time of a core-only port.
+@              The EXC_RETURN restored from the new process stack tells whether S16-S31 follow it.
+@
+@           6) OS_CPU_CtxSwCycles is set to the DWT cycles spent restoring the new task, then has the
+@              cycles spent saving it added at the next switch, before OSTaskSwHook() charges it to
+@              the task.  OSTaskSwHook() itself is not counted.
 @********************************************************************************************************
 
 .thumb_func
 OS_CPU_PendSVHandler:
     CPSID   I                                                   @ Prevent interruption during context switch
+    MOVW    R2, #:lower16:DWT_CYCCNT                            @ R3 = cycle count at the start of the save
+    MOVT    R2, #:upper16:DWT_CYCCNT
+    LDR     R3, [R2]
     MRS     R0, PSP                                             @ PSP is process stack pointer
+#if (defined(__VFP_FP__) && !defined(__SOFTFP__))
+    TST     R14, #0x10                                          @ Did the task use the FPU? See Note #5
+    IT      EQ
+    VSTMDBEQ R0!, {S16-S31}                                     @ Yes, save remaining FP regs S16-S31
+#endif
     STMFD   R0!, {R4-R11, R14}                                  @ Save remaining regs r4-11, R14 on process stack
 
     MOVW    R5, #:lower16:OSTCBCurPtr                           @ OSTCBCurPtr->StkPtr = SP;
@@ -269,9 +242,17 @@ OS_CPU_PendSVHandler:
     LDR     R1, [R5]
     STR     R0, [R1]                                            @ R0 is SP of process being switched out
 
+    LDR     R0, [R2]                                            @ OS_CPU_CtxSwCycles += cycles to save; See Note #6
+    SUB     R0, R0, R3
+    MOVW    R1, #:lower16:OS_CPU_CtxSwCycles
+    MOVT    R1, #:upper16:OS_CPU_CtxSwCycles
+    LDR     R3, [R1]
+    ADD     R3, R3, R0
+    STR     R3, [R1]
+
                                                                 @ At this point, entire context of process has been saved
     MOV     R4, LR                                              @ Save LR exc_return value
-    BL      OSTaskSwHook                                        @ Call OSTaskSwHook() for FPU Push & Pop
+    BL      OSTaskSwHook                                        @ Call OSTaskSwHook()
 
     MOVW    R0, #:lower16:OSPrioCur                             @ OSPrioCur   = OSPrioHighRdy;
     MOVT    R0, #:upper16:OSPrioCur
@@ -285,10 +266,24 @@ OS_CPU_PendSVHandler:
     LDR     R2, [R1]
     STR     R2, [R5]
 
+    MOVW    R3, #:lower16:DWT_CYCCNT                            @ R12 = cycle count at the start of the restore
+    MOVT    R3, #:upper16:DWT_CYCCNT
+    LDR     R12, [R3]
     ORR     LR,  R4, #0x04                                      @ Ensure exception return uses process stack
     LDR     R0, [R2]                                            @ R0 is new process SP; SP = OSTCBHighRdyPtr->StkPtr;
     LDMFD   R0!, {R4-R11, R14}                                  @ Restore r4-11, R14 from new process stack
+#if (defined(__VFP_FP__) && !defined(__SOFTFP__))
+    TST     R14, #0x10                                          @ Did the task use the FPU? See Note #5
+    IT      EQ
+    VLDMIAEQ R0!, {S16-S31}                                     @ Yes, restore remaining FP regs S16-S31
+#endif
     MSR     PSP, R0                                             @ Load PSP with new process SP
+
+    LDR     R1, [R3]                                            @ OS_CPU_CtxSwCycles = cycles to restore
+    SUB     R1, R1, R12
+    MOVW    R2, #:lower16:OS_CPU_CtxSwCycles
+    MOVT    R2, #:upper16:OS_CPU_CtxSwCycles
+    STR     R1, [R2]
     CPSIE   I
     BX      LR                                                  @ Exception return will restore remaining context
 
@@ -77,6 +77,29 @@ extern  "C" {
                                                                         /* ..automatic state saving.                   */
 #define  CPU_REG_FPCCR_LAZY_STK                        0xC0000000uL
 
+#define  OS_CPU_STK_EXC_RETURN_IX                               8u      /* EXEC_RETURN above R4-R11 of a saved task.   */
+#define  OS_CPU_EXC_RETURN_STD_FRAME                   0x00000010uL     /* EXEC_RETURN bit 4 clear: FP regs saved.     */
+
+
+/*
+*********************************************************************************************************
+*                                          STACK GUARD DEFINES
+*********************************************************************************************************
+*/
+
+#define  CPU_REG_DEMCR                 (*((CPU_REG32 *)0xE000EDFCuL))   /* Debug Exception & Monitor Control Reg.      */
+#define  CPU_REG_DWT_COMP0             (*((CPU_REG32 *)0xE0001020uL))   /* DWT comparator 0: task stack guard.         */
+#define  CPU_REG_DWT_MASK0             (*((CPU_REG32 *)0xE0001024uL))
+#define  CPU_REG_DWT_FUNCTION0         (*((CPU_REG32 *)0xE0001028uL))
+#define  CPU_REG_DWT_COMP1             (*((CPU_REG32 *)0xE0001030uL))   /* DWT comparator 1: ISR stack guard.          */
+#define  CPU_REG_DWT_MASK1             (*((CPU_REG32 *)0xE0001034uL))
+#define  CPU_REG_DWT_FUNCTION1         (*((CPU_REG32 *)0xE0001038uL))
+
+#define  CPU_REG_DEMCR_TRCENA                          0x01000000uL     /* Enable the DWT.                             */
+#define  CPU_REG_DEMCR_MON_EN                          0x00010000uL     /* Enable the DebugMonitor exception.          */
+#define  CPU_REG_DWT_FUNCTION_WR                       0x00000006uL     /* Watchpoint on write.                        */
+#define  CPU_REG_DWT_FUNCTION_MATCHED                  0x01000000uL     /* Matched since last read, cleared by read.   */
+
 
 /*
 *********************************************************************************************************
@@ -87,7 +110,10 @@ extern  "C" {
 *
 * Arguments  : None.
 *
-* Note(s)    : None.
+* Note(s)    : 1) With the dynamic tick nothing interrupts an idle CPU until the next delay or timeout is
+*                 due, so the CPU sleeps until then. Any interrupt, tick or not, wakes it. CYCCNT stops in
+*                 WFI, so only busy cycles are counted. The CPU stays awake when the statistic task
+*                 needs the idle counter instead (see os.h, CPU USAGE).
 *********************************************************************************************************
 */
 
@@ -98,6 +124,10 @@ void  OSIdleTaskHook (void)
         (*OS_AppIdleTaskHookPtr)();
     }
 #endif
+
+#if (OS_IDLE_SLEEP_EN == DEF_ENABLED)
+    CPU_WaitForInt();                                           /* See Note #1.                                         */
+#endif
 }
 
 
@@ -163,6 +193,35 @@ void  OSRedzoneHitHook (OS_TCB  *p_tcb)
 #endif
 
 
+/*
+*********************************************************************************************************
+*                                         STACK GUARD HIT HOOK
+*
+* Description: This function is called when a write to a stack guard is trapped.
+*
+* Arguments  : p_tcb        Pointer to the task control block of the offending task. NULL if ISR.
+*
+* Note(s)    : 1) It is called from the DebugMonitor exception, which may have interrupted a critical section
+*                 of the kernel.  It must not call uC/OS-III services.
+*********************************************************************************************************
+*/
+#if (OS_CFG_STK_GUARD_EN == DEF_ENABLED)
+void  OSStkGuardHitHook (OS_TCB  *p_tcb)
+{
+#if OS_CFG_APP_HOOKS_EN > 0u
+    if (OS_AppStkGuardHitHookPtr != (OS_APP_HOOK_TCB)0) {
+        (*OS_AppStkGuardHitHookPtr)(p_tcb);
+    } else {
+        CPU_SW_EXCEPTION(;);
+    }
+#else
+    (void)p_tcb;                                                /* Prevent compiler warning                             */
+    CPU_SW_EXCEPTION(;);
+#endif
+}
+#endif
+
+
 /*
 *********************************************************************************************************
 *                                         STATISTIC TASK HOOK
@@ -285,18 +344,20 @@ void  OSTaskReturnHook (OS_TCB  *p_tcb)
 *
 *              (2) All tasks run in Thread mode, using process stack.
 *
-*              (3) There are two different stack frames depending on whether the Floating-Point(FP)
-*                  co-processor is enabled or not.
+*              (3) There are two different stack frames depending on whether the task has used the Floating-Point
+*                  Unit (FPU) or not.
 *
-*                  (a) The stack frame shown in the diagram is used when the Co-processor Access Control
-*                      Register(CPACR) is disabling the Floating Point Unit. In this case, the FP
-*                      registers(S0- S31) & FP Status Control(FPSCR) register are not saved in the stack frame.
+*                  (a) Every task starts with the stack frame in diagram (a), without the FP registers (S0-S31) and
+*                      the FP Status Control register (FPSCR), whether the FPU is enabled or not.
 *
-*                  (b) The stack frame shown in the diagram is used when the Floating Point Unit is enabled,
-*                      that is, CP10 and CP11 field in CPACR are ones and FPCCR sets bits ASPEN and LSPEN to 1.
+*                  (b) A task that executes a floating point instruction has the stack frame in diagram (b) from
+*                      its next switch on.  The processor stacks S0-S15 and FPSCR and clears bit 4 of EXEC_RETURN,
+*                      then OS_CPU_PendSVHandler() saves S16-S31 (see OS_CPU_A.ASM).  A task that never uses the
+*                      FPU never pays for them.
 *
 *                      (1) When enabling the FPU through CPACR, make sure to set bits ASPEN and LSPEN in the
-*                          Floating-Point Context Control Register (FPCCR).
+*                          Floating-Point Context Control Register (FPCCR).  The processor then sets FPSCR from
+*                          FPDSCR when a task first uses the FPU.
 *
 *                                          +-------------+
 *                                          |             |
@@ -309,67 +370,83 @@ void  OSTaskReturnHook (OS_TCB  *p_tcb)
 *                                          +-------------+
 *                                          |     S14     |
 *                                          +-------------+
-*                                          |     S13     |
-*                                          +-------------+
 *                                                .
 *                                                .
 *                                                .
 *                                          +-------------+
-*                                          |     S2      |
+*                                          |      S2     |
+*                                          +-------------+
+*                                          |      S1     |
+*                                          +-------------+
+*                                          |      S0     |
+*                                          +-------------+
+*                                          |     xPSR    |
+*                                          +-------------+
+*                                          | Return Addr |
+*                                          +-------------+
+*                                          |   LR(R14)   |
+*                                          +-------------+
+*                                          |     R12     |
+*                                          +-------------+
+*                                          |      R3     |
 *                                          +-------------+
-*                                          |     S1      |
+*                                          |      R2     |
+*                                          +-------------+
+*                                          |      R1     |
+*                                          +-------------+
+*                                          |      R0     |
+*                                          +-------------+
+*                                          |     S31     |
+*                                          +-------------+
+*                                          |     S30     |
+*                                          +-------------+
+*                                          |     S29     |
+*                                          +-------------+
+*                                          |     S28     |
+*                                          +-------------+
+*                                          |     S27     |
+*                                          +-------------+
+*                                          |     S26     |
+*                                          +-------------+
+*                                          |     S25     |
 *                    +-------------+       +-------------+
-*                    |             |       |     S0      |
+*                    |             |       |     S24     |
 *                    +-------------+       +-------------+
-*                    |    xPSR     |       |    xPSR     |
+*                    |     xPSR    |       |     S23     |
 *                    +-------------+       +-------------+
-*                    | Return Addr |       | Return Addr |
+*                    | Return Addr |       |     S22     |
 *                    +-------------+       +-------------+
-*                    |  LR(R14)    |       |   LR(R14)   |
+*                    |   LR(R14)   |       |     S21     |
 *                    +-------------+       +-------------+
-*                    |    R12      |       |     R12     |
+*                    |     R12     |       |     S20     |
 *                    +-------------+       +-------------+
-*                    |    R3       |       |     R3      |
+*                    |      R3     |       |     S19     |
 *                    +-------------+       +-------------+
-*                    |    R2       |       |     R0      |
+*                    |      R2     |       |     S18     |
 *                    +-------------+       +-------------+
-*                    |    R1       |       |     R1      |
+*                    |      R1     |       |     S17     |
 *                    +-------------+       +-------------+
-*                    |    R0       |       |     R0      |
+*                    |      R0     |       |     S16     |
 *                    +-------------+       +-------------+
 *                    | EXEC_RETURN |       | EXEC_RETURN |
 *                    +-------------+       +-------------+
-*                    |    R11      |       |     R11     |
+*                    |     R11     |       |     R11     |
 *                    +-------------+       +-------------+
-*                    |    R10      |       |     R10     |
+*                    |     R10     |       |     R10     |
 *                    +-------------+       +-------------+
-*                    |    R9       |       |     R9      |
+*                    |      R9     |       |      R9     |
 *                    +-------------+       +-------------+
-*                    |    R8       |       |     R8      |
+*                    |      R8     |       |      R8     |
 *                    +-------------+       +-------------+
-*                    |    R7       |       |     R7      |
+*                    |      R7     |       |      R7     |
 *                    +-------------+       +-------------+
-*                    |    R6       |       |     R6      |
+*                    |      R6     |       |      R6     |
 *                    +-------------+       +-------------+
-*                    |    R5       |       |     R5      |
+*                    |      R5     |       |      R5     |
 *                    +-------------+       +-------------+
-*                    |    R4       |       |     R4      |
+*                    |      R4     |       |      R4     |
 *                    +-------------+       +-------------+
-*                          (a)             |     S31     |
-*                                          +-------------+
-*                                          |     S30     |
-*                                          +-------------+
-*                                          |     S29     |
-                                           +-------------+
-*                                                .
-*                                                .
-*                                                .
-*                                          +-------------+
-*                                          |     S17     |
-                                           +-------------+
-*                                          |     S16     |
-*                                          +-------------+
-*                                               (b)
+*                          (a)                   (b)
 *
 *             (4) The SP must be 8-byte aligned in conforming to the Procedure Call Standard for the ARM architecture
 *
@@ -453,27 +530,6 @@ CPU_STK  *OSTaskStkInit (OS_TASK_PTR    p_task,
                                                                 /* Align the stack to 8-bytes.                          */
     p_stk = (CPU_STK *)((CPU_STK)(p_stk) & 0xFFFFFFF8u);
                                                                 /* Registers stacked as if auto-saved on exception      */
-#if (OS_CPU_ARM_FP_EN > 0u)                                     /* FPU auto-saved registers.                            */
-     --p_stk;
-    *(--p_stk) = (CPU_STK)0x02000000u;                          /* FPSCR                                                */
-                                                                /* Initialize S0-S15 floating point registers           */
-    *(--p_stk) = (CPU_STK)0x41700000u;                          /* S15                                                  */
-    *(--p_stk) = (CPU_STK)0x41600000u;                          /* S14                                                  */
-    *(--p_stk) = (CPU_STK)0x41500000u;                          /* S13                                                  */
-    *(--p_stk) = (CPU_STK)0x41400000u;                          /* S12                                                  */
-    *(--p_stk) = (CPU_STK)0x41300000u;                          /* S11                                                  */
-    *(--p_stk) = (CPU_STK)0x41200000u;                          /* S10                                                  */
-    *(--p_stk) = (CPU_STK)0x41100000u;                          /* S9                                                   */
-    *(--p_stk) = (CPU_STK)0x41000000u;                          /* S8                                                   */
-    *(--p_stk) = (CPU_STK)0x40E00000u;                          /* S7                                                   */
-    *(--p_stk) = (CPU_STK)0x40C00000u;                          /* S6                                                   */
-    *(--p_stk) = (CPU_STK)0x40A00000u;                          /* S5                                                   */
-    *(--p_stk) = (CPU_STK)0x40800000u;                          /* S4                                                   */
-    *(--p_stk) = (CPU_STK)0x40400000u;                          /* S3                                                   */
-    *(--p_stk) = (CPU_STK)0x40000000u;                          /* S2                                                   */
-    *(--p_stk) = (CPU_STK)0x3F800000u;                          /* S1                                                   */
-    *(--p_stk) = (CPU_STK)0x00000000u;                          /* S0                                                   */
-#endif
     *(--p_stk) = (CPU_STK)0x01000000u;                          /* xPSR                                                 */
     *(--p_stk) = (CPU_STK)p_task;                               /* Entry Point                                          */
     *(--p_stk) = (CPU_STK)OS_TaskReturn;                        /* R14 (LR)                                             */
@@ -483,11 +539,7 @@ CPU_STK  *OSTaskStkInit (OS_TASK_PTR    p_task,
     *(--p_stk) = (CPU_STK)p_stk_limit;                          /* R1                                                   */
     *(--p_stk) = (CPU_STK)p_arg;                                /* R0 : argument                                        */
 
-#if (OS_CPU_ARM_FP_EN > 0u)
-    *(--p_stk) = (CPU_STK)0xFFFFFFEDuL;                         /* R14: EXEC_RETURN; See Note 5                         */
-#else
-    *(--p_stk) = (CPU_STK)0xFFFFFFFDuL;                         /* R14: EXEC_RETURN; See Note 5                         */
-#endif
+    *(--p_stk) = (CPU_STK)0xFFFFFFFDuL;                         /* R14: EXEC_RETURN; See Note 3a & 5                    */
                                                                 /* Remaining registers saved on process stack           */
     *(--p_stk) = (CPU_STK)0x11111111uL;                         /* R11                                                  */
     *(--p_stk) = (CPU_STK)0x10101010uL;                         /* R10                                                  */
@@ -498,26 +550,6 @@ CPU_STK  *OSTaskStkInit (OS_TASK_PTR    p_task,
     *(--p_stk) = (CPU_STK)0x05050505uL;                         /* R5                                                   */
     *(--p_stk) = (CPU_STK)0x04040404uL;                         /* R4                                                   */
 
-#if (OS_CPU_ARM_FP_EN > 0u)
-                                                                /* Initialize S16-S31 floating point registers          */
-    *(--p_stk) = (CPU_STK)0x41F80000u;                          /* S31                                                  */
-    *(--p_stk) = (CPU_STK)0x41F00000u;                          /* S30                                                  */
-    *(--p_stk) = (CPU_STK)0x41E80000u;                          /* S29                                                  */
-    *(--p_stk) = (CPU_STK)0x41E00000u;                          /* S28                                                  */
-    *(--p_stk) = (CPU_STK)0x41D80000u;                          /* S27                                                  */
-    *(--p_stk) = (CPU_STK)0x41D00000u;                          /* S26                                                  */
-    *(--p_stk) = (CPU_STK)0x41C80000u;                          /* S25                                                  */
-    *(--p_stk) = (CPU_STK)0x41C00000u;                          /* S24                                                  */
-    *(--p_stk) = (CPU_STK)0x41B80000u;                          /* S23                                                  */
-    *(--p_stk) = (CPU_STK)0x41B00000u;                          /* S22                                                  */
-    *(--p_stk) = (CPU_STK)0x41A80000u;                          /* S21                                                  */
-    *(--p_stk) = (CPU_STK)0x41A00000u;                          /* S20                                                  */
-    *(--p_stk) = (CPU_STK)0x41980000u;                          /* S19                                                  */
-    *(--p_stk) = (CPU_STK)0x41900000u;                          /* S18                                                  */
-    *(--p_stk) = (CPU_STK)0x41880000u;                          /* S17                                                  */
-    *(--p_stk) = (CPU_STK)0x41800000u;                          /* S16                                                  */
-#endif
-
     return (p_stk);
 }
 
@@ -535,6 +567,10 @@ CPU_STK  *OSTaskStkInit (OS_TASK_PTR    p_task,
 *              2) It is assumed that the global pointer 'OSTCBHighRdyPtr' points to the TCB of the task
 *                 that will be 'switched in' (i.e. the highest priority task) and, 'OSTCBCurPtr' points
 *                 to the task being switched out (i.e. the preempted task).
+*
+*              3) The context of the task switched out is saved.  Its EXEC_RETURN tells whether its FP
+*                 registers are part of it (see OSTaskStkInit() Note 3), and OS_CPU_CtxSwCycles holds
+*                 the cycles OS_CPU_PendSVHandler() spent restoring it and saving it.
 *********************************************************************************************************
 */
 
@@ -543,6 +579,9 @@ void  OSTaskSwHook (void)
 #if OS_CFG_TASK_PROFILE_EN > 0u
     CPU_TS  ts;
 #endif
+#if (OS_CFG_PROF_EN == DEF_ENABLED)
+    CPU_BOOLEAN  fp_used;
+#endif
 #ifdef  CPU_CFG_INT_DIS_MEAS_EN
     CPU_TS  int_dis_time;
 #endif
@@ -550,10 +589,6 @@ void  OSTaskSwHook (void)
     CPU_BOOLEAN  stk_status;
 #endif
 
-#if (OS_CPU_ARM_FP_EN > 0u)
-    OS_CPU_FP_Reg_Push(OSTCBCurPtr->StkPtr);                    /* Push the FP registers of the current task.           */
-#endif
-
 #if OS_CFG_APP_HOOKS_EN > 0u
     if (OS_AppTaskSwHookPtr != (OS_APP_HOOK_VOID)0) {
         (*OS_AppTaskSwHookPtr)();
@@ -565,6 +600,14 @@ void  OSTaskSwHook (void)
 #if OS_CFG_TASK_PROFILE_EN > 0u
     ts = OS_TS_GET();
     if (OSTCBCurPtr != OSTCBHighRdyPtr) {
+#if (OS_CFG_PROF_EN == DEF_ENABLED)
+        OS_ProfTaskSw(ts);                                      /* Takes ISR time out of the task's cycles              */
+        fp_used = DEF_FALSE;                                    /* See Note #3                                          */
+        if ((OSTCBCurPtr->StkPtr[OS_CPU_STK_EXC_RETURN_IX] & OS_CPU_EXC_RETURN_STD_FRAME) == 0u) {
+            fp_used = DEF_TRUE;
+        }
+        OS_ProfCtxSw(OSTCBCurPtr, fp_used, (CPU_TS)OS_CPU_CtxSwCycles);
+#endif
         OSTCBCurPtr->CyclesDelta  = ts - OSTCBCurPtr->CyclesStart;
         OSTCBCurPtr->CyclesTotal += (OS_CYCLES)OSTCBCurPtr->CyclesDelta;
     }
@@ -595,8 +638,16 @@ void  OSTaskSwHook (void)
     }
 #endif
 
-#if (OS_CPU_ARM_FP_EN > 0u)
-    OS_CPU_FP_Reg_Pop(OSTCBHighRdyPtr->StkPtr);                 /* Pop the FP registers of the highest ready task.      */
+#if (OS_CFG_STK_GUARD_EN == DEF_ENABLED)
+    OS_StkGuardTaskSw();                                        /* Guard the stack of the task switched in              */
+#endif
+
+#if (OS_CFG_TASK_BUDGET_EN == DEF_ENABLED)
+    OS_BudgetTaskSw();                                          /* Charge the task switched out its CPU time            */
+#endif
+
+#if (OS_CFG_SCHED_ROUND_ROBIN_EN == DEF_ENABLED) && (OS_CFG_DYN_TICK_EN == DEF_ENABLED)
+    OS_SchedRoundRobinArm(OSTCBHighRdyPtr);                     /* Tick by the end of its time slice, if it has one     */
 #endif
 }
 
@@ -711,6 +762,68 @@ void  OS_CPU_SysTickInit (CPU_INT32U  cnts)
     CPU_REG_NVIC_ST_CTRL  |= CPU_REG_NVIC_ST_CTRL_TICKINT;
 }
 
+
+#if (OS_CFG_STK_GUARD_EN == DEF_ENABLED)
+/*
+*********************************************************************************************************
+*                                             STACK GUARD
+*
+* Description: OS_CPU_StkGuardInit() arms DWT comparator 1 on the guard of the ISR stack and enables the
+*              DebugMonitor exception.  OS_CPU_StkGuardSet() points comparator 0 at the guard of the task
+*              being switched in.  DebugMon_Handler() reports a write to either guard.
+*
+* Arguments  : p_guard      Start of the guard, OS_STK_GUARD_SIZE bytes aligned on their size. NULL for none.
+*
+* Note(s)    : 1) The K65 has no ARMv7-M MPU (__MPU_PRESENT is 0) and its system MPU cannot take RAM away
+*                 from the core, so the guard is a DWT data watchpoint.  It fires just after the store, so
+*                 the guard bytes have been written but nothing below them.
+*
+*              2) DebugMonitor is left at priority 0, the highest.  Critical sections mask it with PRIMASK,
+*                 so a write made inside one is reported when the critical section ends.
+*
+*              3) With a debugger attached in halting mode, the watchpoint halts the core instead.
+*
+*              4) DebugMon_Handler() replaces the weak handler of the startup code.
+*********************************************************************************************************
+*/
+
+void  OS_CPU_StkGuardInit (CPU_STK  *p_isr_guard)
+{
+    CPU_REG_DEMCR         |= CPU_REG_DEMCR_TRCENA | CPU_REG_DEMCR_MON_EN;
+    CPU_REG_NVIC_SHPRI3   &= ~DEF_BIT_FIELD(8, 0);              /* See Note #2.                                         */
+
+    CPU_REG_DWT_FUNCTION0  = 0u;
+    CPU_REG_DWT_FUNCTION1  = 0u;
+    if (p_isr_guard != (CPU_STK *)0) {
+        CPU_REG_DWT_COMP1     = (CPU_INT32U)p_isr_guard;
+        CPU_REG_DWT_MASK1     = OS_STK_GUARD_SHIFT;
+        CPU_REG_DWT_FUNCTION1 = CPU_REG_DWT_FUNCTION_WR;
+    }
+}
+
+
+void  OS_CPU_StkGuardSet (CPU_STK  *p_guard)
+{
+    CPU_REG_DWT_FUNCTION0 = 0u;                                 /* Off while the comparator is changed                  */
+    if (p_guard != (CPU_STK *)0) {
+        CPU_REG_DWT_COMP0     = (CPU_INT32U)p_guard;
+        CPU_REG_DWT_MASK0     = OS_STK_GUARD_SHIFT;
+        CPU_REG_DWT_FUNCTION0 = CPU_REG_DWT_FUNCTION_WR;
+    }
+}
+
+
+void  DebugMon_Handler (void)
+{
+    if ((CPU_REG_DWT_FUNCTION1 & CPU_REG_DWT_FUNCTION_MATCHED) != 0u) {
+        OSStkGuardHitHook((OS_TCB *)0);
+    }
+    if ((CPU_REG_DWT_FUNCTION0 & CPU_REG_DWT_FUNCTION_MATCHED) != 0u) {
+        OSStkGuardHitHook(OSTCBCurPtr);
+    }
+}
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,274 @@
+/*
+************************************************************************************************************************
+*                                            RAM RING TRACE RECORDER EVENTS
+*                          A uC/OS-III V3.06.01 addition for jb444Lab3Proj, not Micrium code
+*
+* File    : OS_TRACE_EVENTS.H
+************************************************************************************************************************
+* Note(s) : (1) os_trace.h includes this file when OS_CFG_TRACE_EN is enabled.  Put this folder on the include path.
+*
+*           (2) Each event is one 8-byte OS_TRACE_RAM_REC in OSTraceRam.RecTbl[]: an OS_TS_GET() timestamp, an event
+*               code, one byte of argument and a 16-bit ID.  The ID is the object's .xxxID field, assigned when the
+*               object is created.  Names and priorities are kept once, in OSTraceRam.ObjTbl[], not in the events.
+*
+*           (3) Dump OSTraceRam from the debugger (sizeof(OSTraceRam) bytes) and read it with tools/os_trace_decode.py.
+*               The structure has only fixed size fields in natural alignment, so its layout is the same on any
+*               32-bit little endian target.
+************************************************************************************************************************
+*/
+
+#ifndef  OS_TRACE_EVENTS_H
+#define  OS_TRACE_EVENTS_H
+
+
+/*
+************************************************************************************************************************
+*                                                 CONFIGURATION DEFAULTS
+************************************************************************************************************************
+*/
+
+#ifndef  OS_CFG_TRACE_RAM_SIZE
+#define  OS_CFG_TRACE_RAM_SIZE                      1024u       /* Records in the ring, a power of 2                  */
+#endif
+
+#ifndef  OS_CFG_TRACE_RAM_STOP_EN
+#define  OS_CFG_TRACE_RAM_STOP_EN           DEF_DISABLED        /* DEF_ENABLED: stop when full, else overwrite oldest */
+#endif
+
+#ifndef  OS_CFG_TRACE_RAM_OBJ_MAX
+#define  OS_CFG_TRACE_RAM_OBJ_MAX                     48u       /* Objects whose name is kept                         */
+#endif
+
+
+/*
+************************************************************************************************************************
+*                                                       DEFINES
+************************************************************************************************************************
+*/
+
+#define  OS_TRACE_RAM_VERSION                          1u
+#define  OS_TRACE_RAM_NAME_SIZE                       12u       /* Bytes of a name kept, zero padded                  */
+#define  OS_TRACE_RAM_BENCH_NBR                       32u       /* Events timed by OSTraceRamInit()                   */
+
+#define  OS_TRACE_RAM_MODE_RING                        0u       /* Overwrite the oldest events                        */
+#define  OS_TRACE_RAM_MODE_STOP                        1u       /* Stop when the ring is full                         */
+
+                                                                /* ------------------ OBJECT TYPES ------------------ */
+#define  OS_TRACE_RAM_OBJ_TASK                         1u
+#define  OS_TRACE_RAM_OBJ_SEM                          2u
+#define  OS_TRACE_RAM_OBJ_MUTEX                        3u
+#define  OS_TRACE_RAM_OBJ_Q                            4u
+#define  OS_TRACE_RAM_OBJ_FLAG                         5u
+#define  OS_TRACE_RAM_OBJ_MEM                          6u
+
+                                                                /* ---------------- KERNEL EVENTS ------------------- */
+#define  OS_TRACE_RAM_EVT_TASK_SWITCHED_IN          0x01u       /* ID: task,  Arg: priority                           */
+#define  OS_TRACE_RAM_EVT_ISR_ENTER                 0x02u       /*            Arg: nesting before entry               */
+#define  OS_TRACE_RAM_EVT_ISR_EXIT                  0x03u
+#define  OS_TRACE_RAM_EVT_ISR_EXIT_TO_SCHED         0x04u
+#define  OS_TRACE_RAM_EVT_TICK                      0x05u       /* ID: tick counter, low 16 bits                      */
+#define  OS_TRACE_RAM_EVT_TASK_CREATE               0x06u       /* ID: task,  Arg: priority                           */
+#define  OS_TRACE_RAM_EVT_TASK_DEL                  0x07u       /* ID: task                                           */
+#define  OS_TRACE_RAM_EVT_TASK_READY                0x08u       /* ID: task,  Arg: priority                           */
+#define  OS_TRACE_RAM_EVT_TASK_DLY                  0x09u       /* ID: delay in ticks, low 16 bits                    */
+#define  OS_TRACE_RAM_EVT_TASK_SUSPEND              0x0Au       /* ID: task                                           */
+#define  OS_TRACE_RAM_EVT_TASK_RESUME               0x0Bu       /* ID: task                                           */
+#define  OS_TRACE_RAM_EVT_TASK_PRIO_CHANGE          0x0Cu       /* ID: task,  Arg: new priority                       */
+#define  OS_TRACE_RAM_EVT_TASK_PRIO_INHERIT         0x0Du       /* ID: task,  Arg: new priority                       */
+#define  OS_TRACE_RAM_EVT_TASK_PRIO_DISINHERIT      0x0Eu       /* ID: task,  Arg: new priority                       */
+
+                                                                /* ---------------- OBJECT EVENTS ------------------- */
+                                                                /* Event = object base + action, ID: object           */
+#define  OS_TRACE_RAM_EVT_SEM                       0x10u
+#define  OS_TRACE_RAM_EVT_MUTEX                     0x18u
+#define  OS_TRACE_RAM_EVT_Q                         0x20u
+#define  OS_TRACE_RAM_EVT_FLAG                      0x28u
+#define  OS_TRACE_RAM_EVT_TASK_SEM                  0x30u       /* ID: task owning the semaphore                      */
+#define  OS_TRACE_RAM_EVT_TASK_Q                    0x38u       /* ID: task owning the queue                          */
+#define  OS_TRACE_RAM_EVT_MEM                       0x40u       /* Get is a pend, put is a post                       */
+
+#define  OS_TRACE_RAM_ACT_CREATE                       0u
+#define  OS_TRACE_RAM_ACT_DEL                          1u
+#define  OS_TRACE_RAM_ACT_POST                         2u
+#define  OS_TRACE_RAM_ACT_POST_FAILED                  3u
+#define  OS_TRACE_RAM_ACT_PEND                         4u       /* Got it, blocked or not                             */
+#define  OS_TRACE_RAM_ACT_PEND_BLOCK                   5u       /* About to block                                     */
+#define  OS_TRACE_RAM_ACT_PEND_FAILED                  6u
+
+
+/*
+************************************************************************************************************************
+*                                                      DATA TYPES
+************************************************************************************************************************
+*/
+
+typedef  struct  os_trace_ram_rec {                             /* ------------------- ONE EVENT -------------------- */
+    CPU_INT32U           TS;                                    /* OS_TS_GET() when the event was recorded            */
+    CPU_INT08U           Evt;                                   /* OS_TRACE_RAM_EVT_xxx                               */
+    CPU_INT08U           Arg;
+    CPU_INT16U           ID;
+} OS_TRACE_RAM_REC;
+
+
+typedef  struct  os_trace_ram_obj {                             /* ------------------- ONE OBJECT ------------------- */
+    CPU_INT16U           ID;                                    /* 0 if the entry is unused                           */
+    CPU_INT08U           Type;                                  /* OS_TRACE_RAM_OBJ_xxx                               */
+    CPU_INT08U           Prio;                                  /* Priority at creation, tasks only                   */
+    CPU_CHAR             Name[OS_TRACE_RAM_NAME_SIZE];
+} OS_TRACE_RAM_OBJ;
+
+
+typedef  struct  os_trace_ram {                                 /* ------------------- RECORDER --------------------- */
+    CPU_CHAR             Magic[4];                              /* "OSTR"                                             */
+    CPU_INT16U           Version;                               /* OS_TRACE_RAM_VERSION                               */
+    CPU_INT16U           ObjMax;                                /* Entries in .ObjTbl[]                               */
+    CPU_INT32U           Size;                                  /* Entries in .RecTbl[]                               */
+    CPU_INT32U           TSFreq;                                /* Timestamp counts per second, 0 if unknown          */
+    CPU_INT32U           BenchNbr;                              /* Events timed by OSTraceRamInit() ...               */
+    CPU_INT32U           BenchCycles;                           /* ... and the timestamp counts they took             */
+    CPU_DATA             Head;                                  /* Events recorded, next one in .RecTbl[Head % Size]   */
+    CPU_DATA             DropCtr;                               /* Events not recorded while stopped by a full ring   */
+    CPU_DATA             ObjCtr;                                /* Last ID handed out                                 */
+    CPU_INT08U           Mode;                                  /* OS_TRACE_RAM_MODE_xxx                              */
+    CPU_INT08U           Running;                               /* DEF_YES while recording                            */
+    CPU_INT16U           Rsvd;
+    OS_TRACE_RAM_OBJ     ObjTbl[OS_CFG_TRACE_RAM_OBJ_MAX];      /* Entry n describes ID n + 1                         */
+    OS_TRACE_RAM_REC     RecTbl[OS_CFG_TRACE_RAM_SIZE];
+} OS_TRACE_RAM;
+
+
+/*
+************************************************************************************************************************
+*                                                   GLOBAL VARIABLES
+************************************************************************************************************************
+*/
+
+extern  OS_TRACE_RAM     OSTraceRam;
+
+
+/*
+************************************************************************************************************************
+*                                                  FUNCTION PROTOTYPES
+************************************************************************************************************************
+*/
+
+struct  os_tcb;                                                 /* Defined in os.h, after this file is included       */
+
+void  OSTraceRamInit    (void);
+
+void  OSTraceRamStart   (CPU_INT08U          mode);
+
+void  OSTraceRamStop    (void);
+
+void  OSTraceRamClear   (void);
+
+void  OS_TraceRamEvt    (CPU_INT08U          evt,
+                         CPU_INT08U          arg,
+                         CPU_INT16U          id);
+
+void  OS_TraceRamTaskReg(struct  os_tcb     *p_tcb);
+
+void  OS_TraceRamObjReg (CPU_INT16U         *p_id,
+                         CPU_INT08U          type,
+                         CPU_INT08U          prio,
+                         const  CPU_CHAR    *p_name);
+
+
+/*
+************************************************************************************************************************
+*                                                 uC/OS-III TRACE HOOKS
+*
+* Note(s) : (1) Only the hooks below record an event.  os_trace.h leaves the others, including every _ENTER and _EXIT
+*               API hook, empty.
+*
+*           (2) A task's message queue gets the task's ID (see OS_TraceRamTaskReg()), so its events name the task.
+*
+*           (3) OSTaskSuspend() and OSTaskSemPost() call their hook with the 'p_tcb' they were given, which is
+*               NULL for the calling task.  OS_TRACE_RAM_TASK_ID() names the calling task then.
+************************************************************************************************************************
+*/
+
+#define  OS_TRACE_RAM_OBJ(base, act, id)                  OS_TraceRamEvt((CPU_INT08U)((base) + (act)), 0u, (id))
+#define  OS_TRACE_RAM_TASK_ID(p_tcb)                      ((((p_tcb) != (OS_TCB *)0) ? (p_tcb) : OSTCBCurPtr)->TaskID)
+
+#define  OS_TRACE_INIT()                                  OSTraceRamInit()
+#define  OS_TRACE_START()                                 OSTraceRamStart(OSTraceRam.Mode)
+#define  OS_TRACE_STOP()                                  OSTraceRamStop()
+#define  OS_TRACE_CLEAR()                                 OSTraceRamClear()
+
+                                                                /* ---------------- ISRs AND TICKS ------------------ */
+#define  OS_TRACE_ISR_ENTER()                             OS_TraceRamEvt(OS_TRACE_RAM_EVT_ISR_ENTER, (CPU_INT08U)OSIntNestingCtr, 0u)
+#define  OS_TRACE_ISR_EXIT()                              OS_TraceRamEvt(OS_TRACE_RAM_EVT_ISR_EXIT, (CPU_INT08U)OSIntNestingCtr, 0u)
+#define  OS_TRACE_ISR_EXIT_TO_SCHEDULER()                 OS_TraceRamEvt(OS_TRACE_RAM_EVT_ISR_EXIT_TO_SCHED, 0u, OSTCBHighRdyPtr->TaskID)
+#define  OS_TRACE_TICK_INCREMENT(OSTickCtr)               OS_TraceRamEvt(OS_TRACE_RAM_EVT_TICK, 0u, (CPU_INT16U)(OSTickCtr))
+
+                                                                /* --------------------- TASKS ---------------------- */
+#define  OS_TRACE_TASK_CREATE(p_tcb)                      OS_TraceRamTaskReg(p_tcb)
+#define  OS_TRACE_TASK_DEL(p_tcb)                         OS_TraceRamEvt(OS_TRACE_RAM_EVT_TASK_DEL, 0u, (p_tcb)->TaskID)
+#define  OS_TRACE_TASK_READY(p_tcb)                       OS_TraceRamEvt(OS_TRACE_RAM_EVT_TASK_READY, (CPU_INT08U)(p_tcb)->Prio, (p_tcb)->TaskID)
+#define  OS_TRACE_TASK_SWITCHED_IN(p_tcb)                 OS_TraceRamEvt(OS_TRACE_RAM_EVT_TASK_SWITCHED_IN, (CPU_INT08U)(p_tcb)->Prio, (p_tcb)->TaskID)
+#define  OS_TRACE_TASK_DLY(dly_ticks)                     OS_TraceRamEvt(OS_TRACE_RAM_EVT_TASK_DLY, 0u, (CPU_INT16U)(dly_ticks))
+#define  OS_TRACE_TASK_SUSPEND(p_tcb)                     OS_TraceRamEvt(OS_TRACE_RAM_EVT_TASK_SUSPEND, 0u, OS_TRACE_RAM_TASK_ID(p_tcb))
+#define  OS_TRACE_TASK_RESUME(p_tcb)                      OS_TraceRamEvt(OS_TRACE_RAM_EVT_TASK_RESUME, 0u, (p_tcb)->TaskID)
+#define  OS_TRACE_TASK_PRIO_CHANGE(p_tcb, prio)           OS_TraceRamEvt(OS_TRACE_RAM_EVT_TASK_PRIO_CHANGE, (CPU_INT08U)(prio), (p_tcb)->TaskID)
+#define  OS_TRACE_MUTEX_TASK_PRIO_INHERIT(p_tcb, prio)    OS_TraceRamEvt(OS_TRACE_RAM_EVT_TASK_PRIO_INHERIT, (CPU_INT08U)(prio), (p_tcb)->TaskID)
+#define  OS_TRACE_MUTEX_TASK_PRIO_DISINHERIT(p_tcb, prio) OS_TraceRamEvt(OS_TRACE_RAM_EVT_TASK_PRIO_DISINHERIT, (CPU_INT08U)(prio), (p_tcb)->TaskID)
+
+                                                                /* ------------------ SEMAPHORES -------------------- */
+#define  OS_TRACE_SEM_CREATE(p_sem, p_name)               OS_TraceRamObjReg(&(p_sem)->SemID, OS_TRACE_RAM_OBJ_SEM, 0u, (p_name))
+#define  OS_TRACE_SEM_DEL(p_sem)                          OS_TRACE_RAM_OBJ(OS_TRACE_RAM_EVT_SEM, OS_TRACE_RAM_ACT_DEL,          (p_sem)->SemID)
+#define  OS_TRACE_SEM_POST(p_sem)                         OS_TRACE_RAM_OBJ(OS_TRACE_RAM_EVT_SEM, OS_TRACE_RAM_ACT_POST,         (p_sem)->SemID)
+#define  OS_TRACE_SEM_POST_FAILED(p_sem)                  OS_TRACE_RAM_OBJ(OS_TRACE_RAM_EVT_SEM, OS_TRACE_RAM_ACT_POST_FAILED,  (p_sem)->SemID)
+#define  OS_TRACE_SEM_PEND(p_sem)                         OS_TRACE_RAM_OBJ(OS_TRACE_RAM_EVT_SEM, OS_TRACE_RAM_ACT_PEND,         (p_sem)->SemID)
+#define  OS_TRACE_SEM_PEND_BLOCK(p_sem)                   OS_TRACE_RAM_OBJ(OS_TRACE_RAM_EVT_SEM, OS_TRACE_RAM_ACT_PEND_BLOCK,   (p_sem)->SemID)
+#define  OS_TRACE_SEM_PEND_FAILED(p_sem)                  OS_TRACE_RAM_OBJ(OS_TRACE_RAM_EVT_SEM, OS_TRACE_RAM_ACT_PEND_FAILED,  (p_sem)->SemID)
+
+                                                                /* -------------------- MUTEXES --------------------- */
+#define  OS_TRACE_MUTEX_CREATE(p_mutex, p_name)           OS_TraceRamObjReg(&(p_mutex)->MutexID, OS_TRACE_RAM_OBJ_MUTEX, 0u, (p_name))
+#define  OS_TRACE_MUTEX_DEL(p_mutex)                      OS_TRACE_RAM_OBJ(OS_TRACE_RAM_EVT_MUTEX, OS_TRACE_RAM_ACT_DEL,         (p_mutex)->MutexID)
+#define  OS_TRACE_MUTEX_POST(p_mutex)                     OS_TRACE_RAM_OBJ(OS_TRACE_RAM_EVT_MUTEX, OS_TRACE_RAM_ACT_POST,        (p_mutex)->MutexID)
+#define  OS_TRACE_MUTEX_POST_FAILED(p_mutex)              OS_TRACE_RAM_OBJ(OS_TRACE_RAM_EVT_MUTEX, OS_TRACE_RAM_ACT_POST_FAILED, (p_mutex)->MutexID)
+#define  OS_TRACE_MUTEX_PEND(p_mutex)                     OS_TRACE_RAM_OBJ(OS_TRACE_RAM_EVT_MUTEX, OS_TRACE_RAM_ACT_PEND,        (p_mutex)->MutexID)
+#define  OS_TRACE_MUTEX_PEND_BLOCK(p_mutex)               OS_TRACE_RAM_OBJ(OS_TRACE_RAM_EVT_MUTEX, OS_TRACE_RAM_ACT_PEND_BLOCK,  (p_mutex)->MutexID)
+#define  OS_TRACE_MUTEX_PEND_FAILED(p_mutex)              OS_TRACE_RAM_OBJ(OS_TRACE_RAM_EVT_MUTEX, OS_TRACE_RAM_ACT_PEND_FAILED, (p_mutex)->MutexID)
+
+                                                                /* ---------------- MESSAGE QUEUES ------------------ */
+#define  OS_TRACE_Q_CREATE(p_q, p_name)                   OS_TraceRamObjReg(&(p_q)->MsgQ.MsgQID, OS_TRACE_RAM_OBJ_Q, 0u, (p_name))
+#define  OS_TRACE_Q_DEL(p_q)                              OS_TRACE_RAM_OBJ(OS_TRACE_RAM_EVT_Q, OS_TRACE_RAM_ACT_DEL,             (p_q)->MsgQ.MsgQID)
+#define  OS_TRACE_Q_POST(p_q)                             OS_TRACE_RAM_OBJ(OS_TRACE_RAM_EVT_Q, OS_TRACE_RAM_ACT_POST,            (p_q)->MsgQ.MsgQID)
+#define  OS_TRACE_Q_POST_FAILED(p_q)                      OS_TRACE_RAM_OBJ(OS_TRACE_RAM_EVT_Q, OS_TRACE_RAM_ACT_POST_FAILED,     (p_q)->MsgQ.MsgQID)
+#define  OS_TRACE_Q_PEND(p_q)                             OS_TRACE_RAM_OBJ(OS_TRACE_RAM_EVT_Q, OS_TRACE_RAM_ACT_PEND,            (p_q)->MsgQ.MsgQID)
+#define  OS_TRACE_Q_PEND_BLOCK(p_q)                       OS_TRACE_RAM_OBJ(OS_TRACE_RAM_EVT_Q, OS_TRACE_RAM_ACT_PEND_BLOCK,      (p_q)->MsgQ.MsgQID)
+#define  OS_TRACE_Q_PEND_FAILED(p_q)                      OS_TRACE_RAM_OBJ(OS_TRACE_RAM_EVT_Q, OS_TRACE_RAM_ACT_PEND_FAILED,     (p_q)->MsgQ.MsgQID)
+
+                                                                /* ------------------ EVENT FLAGS ------------------- */
+#define  OS_TRACE_FLAG_CREATE(p_grp, p_name)              OS_TraceRamObjReg(&(p_grp)->FlagID, OS_TRACE_RAM_OBJ_FLAG, 0u, (p_name))
+#define  OS_TRACE_FLAG_DEL(p_grp)                         OS_TRACE_RAM_OBJ(OS_TRACE_RAM_EVT_FLAG, OS_TRACE_RAM_ACT_DEL,          (p_grp)->FlagID)
+#define  OS_TRACE_FLAG_POST(p_grp)                        OS_TRACE_RAM_OBJ(OS_TRACE_RAM_EVT_FLAG, OS_TRACE_RAM_ACT_POST,         (p_grp)->FlagID)
+#define  OS_TRACE_FLAG_POST_FAILED(p_grp)                 OS_TRACE_RAM_OBJ(OS_TRACE_RAM_EVT_FLAG, OS_TRACE_RAM_ACT_POST_FAILED,  (p_grp)->FlagID)
+#define  OS_TRACE_FLAG_PEND(p_grp)                        OS_TRACE_RAM_OBJ(OS_TRACE_RAM_EVT_FLAG, OS_TRACE_RAM_ACT_PEND,         (p_grp)->FlagID)
+#define  OS_TRACE_FLAG_PEND_BLOCK(p_grp)                  OS_TRACE_RAM_OBJ(OS_TRACE_RAM_EVT_FLAG, OS_TRACE_RAM_ACT_PEND_BLOCK,   (p_grp)->FlagID)
+#define  OS_TRACE_FLAG_PEND_FAILED(p_grp)                 OS_TRACE_RAM_OBJ(OS_TRACE_RAM_EVT_FLAG, OS_TRACE_RAM_ACT_PEND_FAILED,  (p_grp)->FlagID)
+
+                                                                /* --------------- TASK SEMAPHORES ------------------ */
+#define  OS_TRACE_TASK_SEM_POST(p_tcb)                    OS_TRACE_RAM_OBJ(OS_TRACE_RAM_EVT_TASK_SEM, OS_TRACE_RAM_ACT_POST,        OS_TRACE_RAM_TASK_ID(p_tcb))
+#define  OS_TRACE_TASK_SEM_POST_FAILED(p_tcb)             OS_TRACE_RAM_OBJ(OS_TRACE_RAM_EVT_TASK_SEM, OS_TRACE_RAM_ACT_POST_FAILED, OS_TRACE_RAM_TASK_ID(p_tcb))
+#define  OS_TRACE_TASK_SEM_PEND(p_tcb)                    OS_TRACE_RAM_OBJ(OS_TRACE_RAM_EVT_TASK_SEM, OS_TRACE_RAM_ACT_PEND,        (p_tcb)->TaskID)
+#define  OS_TRACE_TASK_SEM_PEND_BLOCK(p_tcb)              OS_TRACE_RAM_OBJ(OS_TRACE_RAM_EVT_TASK_SEM, OS_TRACE_RAM_ACT_PEND_BLOCK,  (p_tcb)->TaskID)
+#define  OS_TRACE_TASK_SEM_PEND_FAILED(p_tcb)             OS_TRACE_RAM_OBJ(OS_TRACE_RAM_EVT_TASK_SEM, OS_TRACE_RAM_ACT_PEND_FAILED, (p_tcb)->TaskID)
+
+                                                                /* ------------- TASK MESSAGE QUEUES ---------------- */
+#define  OS_TRACE_TASK_MSG_Q_POST(p_msg_q)                OS_TRACE_RAM_OBJ(OS_TRACE_RAM_EVT_TASK_Q, OS_TRACE_RAM_ACT_POST,        (p_msg_q)->MsgQID)
+#define  OS_TRACE_TASK_MSG_Q_POST_FAILED(p_msg_q)         OS_TRACE_RAM_OBJ(OS_TRACE_RAM_EVT_TASK_Q, OS_TRACE_RAM_ACT_POST_FAILED, (p_msg_q)->MsgQID)
+#define  OS_TRACE_TASK_MSG_Q_PEND(p_msg_q)                OS_TRACE_RAM_OBJ(OS_TRACE_RAM_EVT_TASK_Q, OS_TRACE_RAM_ACT_PEND,        (p_msg_q)->MsgQID)
+#define  OS_TRACE_TASK_MSG_Q_PEND_BLOCK(p_msg_q)          OS_TRACE_RAM_OBJ(OS_TRACE_RAM_EVT_TASK_Q, OS_TRACE_RAM_ACT_PEND_BLOCK,  (p_msg_q)->MsgQID)
+#define  OS_TRACE_TASK_MSG_Q_PEND_FAILED(p_msg_q)         OS_TRACE_RAM_OBJ(OS_TRACE_RAM_EVT_TASK_Q, OS_TRACE_RAM_ACT_PEND_FAILED, (p_msg_q)->MsgQID)
+
+                                                                /* ---------------- MEMORY PARTITIONS --------------- */
+#define  OS_TRACE_MEM_CREATE(p_mem, p_name)               OS_TraceRamObjReg(&(p_mem)->MemID, OS_TRACE_RAM_OBJ_MEM, 0u, (p_name))
+#define  OS_TRACE_MEM_PUT(p_mem)                          OS_TRACE_RAM_OBJ(OS_TRACE_RAM_EVT_MEM, OS_TRACE_RAM_ACT_POST,          (p_mem)->MemID)
+#define  OS_TRACE_MEM_PUT_FAILED(p_mem)                   OS_TRACE_RAM_OBJ(OS_TRACE_RAM_EVT_MEM, OS_TRACE_RAM_ACT_POST_FAILED,   (p_mem)->MemID)
+#define  OS_TRACE_MEM_GET(p_mem)                          OS_TRACE_RAM_OBJ(OS_TRACE_RAM_EVT_MEM, OS_TRACE_RAM_ACT_PEND,          (p_mem)->MemID)
+#define  OS_TRACE_MEM_GET_FAILED(p_mem)                   OS_TRACE_RAM_OBJ(OS_TRACE_RAM_EVT_MEM, OS_TRACE_RAM_ACT_PEND_FAILED,   (p_mem)->MemID)
+
+#endif
@@ -0,0 +1,286 @@
+/*
+************************************************************************************************************************
+*                                              RAM RING TRACE RECORDER
+*                          A uC/OS-III V3.06.01 addition for jb444Lab3Proj, not Micrium code
+*
+* File    : OS_TRACE_RAM.C
+************************************************************************************************************************
+* Note(s) : (1) Writers take a slot by advancing OSTraceRam.Head with CPU_AtomicCmpSwap(), so tasks and ISRs record
+*               without a critical section.  The timestamp is read before the swap and read again if the swap fails,
+*               so events are in timestamp order in the ring.
+*
+*           (2) A writer interrupted between taking its slot and filling it leaves that slot stale until it resumes.
+*               Dump the ring with the target halted, or after OSTraceRamStop().
+************************************************************************************************************************
+*/
+
+#define  MICRIUM_SOURCE
+#include "os.h"
+
+#ifdef VSC_INCLUDE_SOURCE_FILE_NAMES
+const  CPU_CHAR  *os_trace_ram__c = "$Id: $";
+#endif
+
+
+#if (OS_CFG_TRACE_EN == DEF_ENABLED)
+
+#if ((OS_CFG_TRACE_RAM_SIZE & (OS_CFG_TRACE_RAM_SIZE - 1u)) != 0u)
+#error  "OS_CFG.H, OS_CFG_TRACE_RAM_SIZE must be a power of 2"
+#endif
+
+/*
+************************************************************************************************************************
+*                                                   GLOBAL VARIABLES
+************************************************************************************************************************
+*/
+
+OS_TRACE_RAM  OSTraceRam;
+
+
+/*
+************************************************************************************************************************
+*                                               INITIALIZE THE RECORDER
+*
+* Description: This function is called by OSInit() through OS_TRACE_INIT().  It fills in the header of OSTraceRam, times
+*              OS_TRACE_RAM_BENCH_NBR events into .BenchCycles, then empties the ring and starts recording in the mode
+*              set by OS_CFG_TRACE_RAM_STOP_EN.
+*
+* Arguments  : none
+*
+* Returns    : none
+*
+* Note(s)    : 1) OSInit() runs with interrupts disabled, so nothing but the loop itself is in .BenchCycles.  Divide by
+*                 .BenchNbr for the cost of one event.  It stays 0 without OS_CFG_TS_EN.
+*
+*              2) Objects registered so far keep their IDs, so the application may restart recording at any time.
+************************************************************************************************************************
+*/
+
+void  OSTraceRamInit (void)
+{
+    CPU_INT08U  i;
+#if (OS_CFG_TS_EN == DEF_ENABLED)
+    CPU_TS      ts_start;
+    CPU_ERR     cpu_err;
+#endif
+
+
+    OSTraceRam.Magic[0]    = 'O';
+    OSTraceRam.Magic[1]    = 'S';
+    OSTraceRam.Magic[2]    = 'T';
+    OSTraceRam.Magic[3]    = 'R';
+    OSTraceRam.Version     = OS_TRACE_RAM_VERSION;
+    OSTraceRam.ObjMax      = OS_CFG_TRACE_RAM_OBJ_MAX;
+    OSTraceRam.Size        = OS_CFG_TRACE_RAM_SIZE;
+    OSTraceRam.BenchNbr    = OS_TRACE_RAM_BENCH_NBR;
+    OSTraceRam.BenchCycles = 0u;
+    OSTraceRam.ObjCtr      = 0u;
+    OSTraceRam.Rsvd        = 0u;
+
+#if (OS_CFG_TS_EN == DEF_ENABLED)
+    OSTraceRam.TSFreq      = (CPU_INT32U)CPU_TS_TmrFreqGet(&cpu_err);
+    OSTraceRamStart(OS_TRACE_RAM_MODE_RING);                    /* See Note #1                                          */
+    ts_start = OS_TS_GET();
+    for (i = 0u; i < OS_TRACE_RAM_BENCH_NBR; i++) {
+        OS_TraceRamEvt(OS_TRACE_RAM_EVT_TICK, 0u, 0u);
+    }
+    OSTraceRam.BenchCycles = (CPU_INT32U)(OS_TS_GET() - ts_start);
+#else
+    OSTraceRam.TSFreq      = 0u;
+#endif
+    OSTraceRamStop();
+    OSTraceRamClear();
+
+    for (i = 0u; i < OS_CFG_TRACE_RAM_OBJ_MAX; i++) {
+        OSTraceRam.ObjTbl[i].ID = 0u;
+    }
+
+#if (OS_CFG_TRACE_RAM_STOP_EN == DEF_ENABLED)
+    OSTraceRamStart(OS_TRACE_RAM_MODE_STOP);
+#else
+    OSTraceRamStart(OS_TRACE_RAM_MODE_RING);
+#endif
+}
+
+
+/*
+************************************************************************************************************************
+*                                             START, STOP AND CLEAR RECORDING
+*
+* Description: OSTraceRamStart() records from now on, overwriting the oldest events when the ring is full
+*              (OS_TRACE_RAM_MODE_RING) or dropping new ones (OS_TRACE_RAM_MODE_STOP).  OSTraceRamStop() stops recording
+*              and OSTraceRamClear() empties the ring.
+*
+* Arguments  : mode       is OS_TRACE_RAM_MODE_RING or OS_TRACE_RAM_MODE_STOP.
+*
+* Returns    : none
+*
+* Note(s)    : 1) Clear the ring while recording is stopped.  A writer in progress would otherwise fill a slot past the
+*                 new head.
+************************************************************************************************************************
+*/
+
+void  OSTraceRamStart (CPU_INT08U  mode)
+{
+    OSTraceRam.Mode    = mode;
+    OSTraceRam.Running = DEF_YES;
+}
+
+
+void  OSTraceRamStop (void)
+{
+    OSTraceRam.Running = DEF_NO;
+}
+
+
+void  OSTraceRamClear (void)
+{
+    OSTraceRam.Head    = 0u;
+    OSTraceRam.DropCtr = 0u;
+}
+
+
+/*
+************************************************************************************************************************
+*                                                   RECORD AN EVENT
+*
+* Description: This function is called by the OS_TRACE_xxx() hooks to append one event to the ring.
+*
+* Arguments  : evt        is the OS_TRACE_RAM_EVT_xxx code.
+*
+*              arg        is the event's byte of argument.
+*
+*              id         is the ID of the object or task the event is about.
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application MUST NOT call it.
+************************************************************************************************************************
+*/
+
+void  OS_TraceRamEvt (CPU_INT08U  evt,
+                      CPU_INT08U  arg,
+                      CPU_INT16U  id)
+{
+    OS_TRACE_RAM_REC  *p_rec;
+    CPU_DATA           head;
+    CPU_DATA           drop;
+    CPU_TS             ts;
+
+
+    do {                                                        /* Take a slot (see Note #1 at the top of the file)     */
+        if (OSTraceRam.Running == DEF_NO) {
+            return;
+        }
+        head = OSTraceRam.Head;
+        if ((OSTraceRam.Mode == OS_TRACE_RAM_MODE_STOP) &&
+            (head        >= OS_CFG_TRACE_RAM_SIZE)) {           /* Full and not to be overwritten                       */
+            do {
+                drop = OSTraceRam.DropCtr;
+            } while (CPU_AtomicCmpSwap(&OSTraceRam.DropCtr, drop, drop + 1u) != DEF_OK);
+            return;
+        }
+        ts = OS_TS_GET();
+    } while (CPU_AtomicCmpSwap(&OSTraceRam.Head, head, head + 1u) != DEF_OK);
+
+    p_rec      = &OSTraceRam.RecTbl[head & (OS_CFG_TRACE_RAM_SIZE - 1u)];
+    p_rec->TS  = (CPU_INT32U)ts;
+    p_rec->Evt = evt;
+    p_rec->Arg = arg;
+    p_rec->ID  = id;
+}
+
+
+/*
+************************************************************************************************************************
+*                                                   REGISTER A TASK
+*
+* Description: This function is called by OS_TRACE_TASK_CREATE().  It registers the task like any other object, and
+*              gives the task's message queue the same ID.
+*
+* Arguments  : p_tcb      is a pointer to the task's OS_TCB.
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application MUST NOT call it.
+************************************************************************************************************************
+*/
+
+void  OS_TraceRamTaskReg (OS_TCB  *p_tcb)
+{
+    OS_TraceRamObjReg(&p_tcb->TaskID,
+                       OS_TRACE_RAM_OBJ_TASK,
+                      (CPU_INT08U)p_tcb->Prio,
+                       p_tcb->NamePtr);
+#if (OS_CFG_TASK_Q_EN == DEF_ENABLED)
+    p_tcb->MsgQ.MsgQID = p_tcb->TaskID;
+#endif
+}
+
+
+/*
+************************************************************************************************************************
+*                                                  REGISTER AN OBJECT
+*
+* Description: This function is called by the OS_TRACE_xxx_CREATE() hooks.  It gives the object the next ID, keeps its
+*              name in OSTraceRam.ObjTbl[] and records the creation.
+*
+* Arguments  : p_id       is a pointer to the object's ID field.
+*
+*              type       is the OS_TRACE_RAM_OBJ_xxx type.
+*
+*              prio       is the priority of a task, 0 for other objects.
+*
+*              p_name     is a pointer to the object's name, may be a NULL pointer.
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application MUST NOT call it.
+*
+*              2) Objects past the first OS_CFG_TRACE_RAM_OBJ_MAX still get an ID, but no name.  IDs wrap after 65535.
+************************************************************************************************************************
+*/
+
+void  OS_TraceRamObjReg (CPU_INT16U         *p_id,
+                         CPU_INT08U          type,
+                         CPU_INT08U          prio,
+                         const  CPU_CHAR    *p_name)
+{
+    OS_TRACE_RAM_OBJ  *p_obj;
+    CPU_DATA           id;
+    CPU_INT08U         i;
+    CPU_INT08U         evt;
+
+
+    do {
+        id = OSTraceRam.ObjCtr;
+    } while (CPU_AtomicCmpSwap(&OSTraceRam.ObjCtr, id, id + 1u) != DEF_OK);
+    id++;
+   *p_id = (CPU_INT16U)id;
+
+    if (id <= OS_CFG_TRACE_RAM_OBJ_MAX) {                       /* See Note #2                                          */
+        p_obj = &OSTraceRam.ObjTbl[id - 1u];
+        for (i = 0u; i < OS_TRACE_RAM_NAME_SIZE; i++) {         /* Copy the name, zero padded                           */
+            if ((p_name != (const CPU_CHAR *)0) && (*p_name != (CPU_CHAR)0)) {
+                p_obj->Name[i] = *p_name++;
+            } else {
+                p_obj->Name[i] = (CPU_CHAR)0;
+            }
+        }
+        p_obj->Type = type;
+        p_obj->Prio = prio;
+        p_obj->ID   = (CPU_INT16U)id;
+    }
+
+    switch (type) {
+        case OS_TRACE_RAM_OBJ_TASK:  evt = OS_TRACE_RAM_EVT_TASK_CREATE;                         break;
+        case OS_TRACE_RAM_OBJ_SEM:   evt = OS_TRACE_RAM_EVT_SEM   + OS_TRACE_RAM_ACT_CREATE;     break;
+        case OS_TRACE_RAM_OBJ_MUTEX: evt = OS_TRACE_RAM_EVT_MUTEX + OS_TRACE_RAM_ACT_CREATE;     break;
+        case OS_TRACE_RAM_OBJ_Q:     evt = OS_TRACE_RAM_EVT_Q     + OS_TRACE_RAM_ACT_CREATE;     break;
+        case OS_TRACE_RAM_OBJ_FLAG:  evt = OS_TRACE_RAM_EVT_FLAG  + OS_TRACE_RAM_ACT_CREATE;     break;
+        case OS_TRACE_RAM_OBJ_MEM:   evt = OS_TRACE_RAM_EVT_MEM   + OS_TRACE_RAM_ACT_CREATE;     break;
+        default:                     return;
+    }
+    OS_TraceRamEvt(evt, prio, (CPU_INT16U)id);
+}
+#endif
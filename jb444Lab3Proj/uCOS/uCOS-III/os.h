@@ -83,10 +83,42 @@ extern "C" {
 #define  OS_CFG_TASK_TICK_EN             DEF_ENABLED
 #endif
 
+#ifndef OS_CFG_TICK_WHEEL_EN
+#define  OS_CFG_TICK_WHEEL_EN            DEF_DISABLED
+#endif
+
+#ifndef OS_CFG_TMR_WHEEL_EN
+#define  OS_CFG_TMR_WHEEL_EN             DEF_DISABLED
+#endif
+
 #ifndef OS_CFG_TASK_IDLE_EN
 #define  OS_CFG_TASK_IDLE_EN             DEF_ENABLED
 #endif
 
+#ifndef OS_CFG_FLAG_PEND_IDX_EN
+#define  OS_CFG_FLAG_PEND_IDX_EN         DEF_DISABLED
+#endif
+
+#ifndef OS_CFG_MUTEX_PEND_IDX_EN
+#define  OS_CFG_MUTEX_PEND_IDX_EN        DEF_DISABLED
+#endif
+
+#ifndef OS_CFG_Q_PEND_IDX_EN
+#define  OS_CFG_Q_PEND_IDX_EN            DEF_DISABLED
+#endif
+
+#ifndef OS_CFG_SEM_PEND_IDX_EN
+#define  OS_CFG_SEM_PEND_IDX_EN          DEF_DISABLED
+#endif
+
+#ifndef OS_CFG_PEND_IDX_PRIO_MAX
+#if     (OS_CFG_PRIO_MAX > 64u)
+#define  OS_CFG_PEND_IDX_PRIO_MAX        64u
+#else
+#define  OS_CFG_PEND_IDX_PRIO_MAX        OS_CFG_PRIO_MAX
+#endif
+#endif
+
 #ifndef OS_CFG_TASK_STK_REDZONE_EN
 #define  OS_CFG_TASK_STK_REDZONE_EN      DEF_DISABLED
 #endif
@@ -95,6 +127,55 @@ extern "C" {
 #define  OS_CFG_INVALID_OS_CALLS_CHK_EN  DEF_DISABLED
 #endif
 
+#ifndef OS_CFG_ISR_POST_DEFERRED_EN
+#define  OS_CFG_ISR_POST_DEFERRED_EN     DEF_DISABLED
+#endif
+
+#ifndef OS_CFG_MEM_REF_EN
+#define  OS_CFG_MEM_REF_EN               DEF_DISABLED
+#endif
+
+#ifndef OS_CFG_PROF_EN
+#define  OS_CFG_PROF_EN                  DEF_DISABLED
+#endif
+
+#ifndef OS_CFG_MEM_LOCK_FREE_EN
+#define  OS_CFG_MEM_LOCK_FREE_EN         DEF_DISABLED
+#endif
+
+#ifndef OS_CFG_MEM_SLAB_EN
+#define  OS_CFG_MEM_SLAB_EN              DEF_DISABLED
+#endif
+
+#ifndef OS_CFG_MSG_POOL_LOCAL_EN
+#define  OS_CFG_MSG_POOL_LOCAL_EN        DEF_DISABLED
+#endif
+
+#ifndef OS_CFG_STK_GUARD_EN
+#define  OS_CFG_STK_GUARD_EN             DEF_DISABLED
+#endif
+
+#ifndef OS_CFG_TASK_BUDGET_EN
+#define  OS_CFG_TASK_BUDGET_EN           DEF_DISABLED
+#endif
+
+#ifndef OS_CFG_TASK_BUDGET_REPL_MAX
+#define  OS_CFG_TASK_BUDGET_REPL_MAX     4u                     /* Pending replenishments per budgeted task               */
+#endif
+
+#ifndef OS_CFG_EDF_EN
+#define  OS_CFG_EDF_EN                   DEF_DISABLED
+#endif
+
+#if ((OS_CFG_FLAG_EN  == DEF_ENABLED) && (OS_CFG_FLAG_PEND_IDX_EN  == DEF_ENABLED)) || \
+    ((OS_CFG_MUTEX_EN == DEF_ENABLED) && (OS_CFG_MUTEX_PEND_IDX_EN == DEF_ENABLED)) || \
+    ((OS_CFG_Q_EN     == DEF_ENABLED) && (OS_CFG_Q_PEND_IDX_EN     == DEF_ENABLED)) || \
+    ((OS_CFG_SEM_EN   == DEF_ENABLED) && (OS_CFG_SEM_PEND_IDX_EN   == DEF_ENABLED))
+#define  OS_PEND_LIST_IDX_EN             DEF_ENABLED            /* At least one object type indexes its pend list         */
+#else
+#define  OS_PEND_LIST_IDX_EN             DEF_DISABLED
+#endif
+
 
 /*
 ************************************************************************************************************************
@@ -117,6 +198,15 @@ extern "C" {
 #endif
 
 
+#if      (OS_CFG_PROF_EN == DEF_ENABLED)
+#define  OS_PROF_INT_ENTER()                OS_ProfIntEnter()
+#define  OS_PROF_INT_EXIT()                 OS_ProfIntExit()
+#else
+#define  OS_PROF_INT_ENTER()
+#define  OS_PROF_INT_EXIT()
+#endif
+
+
 /*
 ************************************************************************************************************************
 *                                                     MISCELLANEOUS
@@ -131,6 +221,7 @@ extern "C" {
 
 
 #define  OS_PRIO_TBL_SIZE          (((OS_CFG_PRIO_MAX - 1u) / (DEF_INT_CPU_NBR_BITS)) + 1u)
+#define  OS_PEND_IDX_TBL_SIZE      (((OS_CFG_PEND_IDX_PRIO_MAX - 1u) / (DEF_INT_CPU_NBR_BITS)) + 1u)
 
 #define  OS_MSG_EN                 (((OS_CFG_TASK_Q_EN == DEF_ENABLED) || (OS_CFG_Q_EN == DEF_ENABLED)) ? DEF_ENABLED : DEF_DISABLED)
 
@@ -214,8 +305,10 @@ extern "C" {
 #define  OS_OBJ_TYPE_NONE                    (OS_OBJ_TYPE)CPU_TYPE_CREATE('N', 'O', 'N', 'E')
 #define  OS_OBJ_TYPE_FLAG                    (OS_OBJ_TYPE)CPU_TYPE_CREATE('F', 'L', 'A', 'G')
 #define  OS_OBJ_TYPE_MEM                     (OS_OBJ_TYPE)CPU_TYPE_CREATE('M', 'E', 'M', ' ')
+#define  OS_OBJ_TYPE_MEM_SLAB                (OS_OBJ_TYPE)CPU_TYPE_CREATE('S', 'L', 'A', 'B')
 #define  OS_OBJ_TYPE_MUTEX                   (OS_OBJ_TYPE)CPU_TYPE_CREATE('M', 'U', 'T', 'X')
 #define  OS_OBJ_TYPE_Q                       (OS_OBJ_TYPE)CPU_TYPE_CREATE('Q', 'U', 'E', 'U')
+#define  OS_OBJ_TYPE_Q_REF                   (OS_OBJ_TYPE)CPU_TYPE_CREATE('Q', 'R', 'E', 'F')
 #define  OS_OBJ_TYPE_SEM                     (OS_OBJ_TYPE)CPU_TYPE_CREATE('S', 'E', 'M', 'A')
 #define  OS_OBJ_TYPE_MON                     (OS_OBJ_TYPE)CPU_TYPE_CREATE('M', 'O', 'N', ' ')
 #define  OS_OBJ_TYPE_TASK_MSG                (OS_OBJ_TYPE)CPU_TYPE_CREATE('T', 'M', 'S', 'G')
@@ -292,6 +385,7 @@ extern "C" {
 #define  OS_OPT_POST_LIFO                    (OS_OPT)(0x0010u)  /* Post to highest priority task waiting              */
 #define  OS_OPT_POST_1                       (OS_OPT)(0x0000u)  /* Post message to highest priority task waiting      */
 #define  OS_OPT_POST_ALL                     (OS_OPT)(0x0200u)  /* Broadcast message to ALL tasks waiting             */
+#define  OS_OPT_POST_MEM_REF                 (OS_OPT)(0x0400u)  /* Message holds a reference, set by OSQPostRef() only */
 
 #define  OS_OPT_POST_NO_SCHED                (OS_OPT)(0x8000u)  /* Do not call the scheduler if this is selected      */
 
@@ -404,6 +498,49 @@ extern "C" {
 #define  OS_STACK_CHECK_DEPTH               8u
 
 
+/*
+------------------------------------------------------------------------------------------------------------------------
+*                                                    STACK GUARD
+*
+* Note(s) : (1) The guard is the first OS_STK_GUARD_SIZE bytes of a stack that start on a multiple of OS_STK_GUARD_SIZE.
+*               The port traps any write to the guard of the running task and of the ISR stack (see os_stk_guard.c).
+------------------------------------------------------------------------------------------------------------------------
+*/
+
+#define  OS_STK_GUARD_SHIFT                 5u
+#define  OS_STK_GUARD_SIZE                 (1u << OS_STK_GUARD_SHIFT)
+
+
+/*
+------------------------------------------------------------------------------------------------------------------------
+*                                                     CPU USAGE
+*
+* Note(s) : (1) With the dynamic tick the idle task sleeps until the next interrupt, so its counter no longer measures
+*               idle time.  The statistic task then takes CPU usage from the cycles the profiler charges to each task
+*               and ISR over the wall clock time of the statistic period (see OS_StatTask()).
+*
+*           (2) Without the profiler the idle counter is the only measure, so the idle task stays awake while the
+*               statistic task is enabled.
+------------------------------------------------------------------------------------------------------------------------
+*/
+
+#if    ((OS_CFG_STAT_TASK_EN == DEF_ENABLED) && \
+        (OS_CFG_TASK_IDLE_EN == DEF_ENABLED) && \
+        (OS_CFG_DYN_TICK_EN  == DEF_ENABLED) && \
+        (OS_CFG_PROF_EN      == DEF_ENABLED))
+#define  OS_STAT_CYCLES_EN                  DEF_ENABLED         /* See Note #1                                    */
+#else
+#define  OS_STAT_CYCLES_EN                  DEF_DISABLED
+#endif
+
+#if    ((OS_CFG_DYN_TICK_EN  == DEF_ENABLED) && \
+       ((OS_CFG_STAT_TASK_EN != DEF_ENABLED) || (OS_STAT_CYCLES_EN == DEF_ENABLED)))
+#define  OS_IDLE_SLEEP_EN                   DEF_ENABLED
+#else
+#define  OS_IDLE_SLEEP_EN                   DEF_DISABLED        /* See Note #2                                    */
+#endif
+
+
 /*
 ************************************************************************************************************************
 ************************************************************************************************************************
@@ -425,6 +562,9 @@ typedef  enum  os_err {
     OS_ERR_ACCEPT_ISR                = 10001u,
 
     OS_ERR_B                         = 11000u,
+    OS_ERR_BUDGET_ADMIT              = 11001u,
+    OS_ERR_BUDGET_INVALID            = 11002u,
+    OS_ERR_BUDGET_ISR                = 11003u,
 
     OS_ERR_C                         = 12000u,
     OS_ERR_CREATE_ISR                = 12001u,
@@ -433,6 +573,8 @@ typedef  enum  os_err {
     OS_ERR_DEL_ISR                   = 13001u,
 
     OS_ERR_E                         = 14000u,
+    OS_ERR_EDF_INVALID               = 14001u,
+    OS_ERR_EDF_ISR                   = 14002u,
 
     OS_ERR_F                         = 15000u,
     OS_ERR_FATAL_RETURN              = 15001u,
@@ -449,11 +591,11 @@ typedef  enum  os_err {
     OS_ERR_I                         = 18000u,
     OS_ERR_ILLEGAL_CREATE_RUN_TIME   = 18001u,
 
-    OS_ERR_INT_Q                     = 18002u,                  /* OBSOLETE ERR CODE                                    */
-    OS_ERR_INT_Q_FULL                = 18003u,                  /* OBSOLETE ERR CODE                                    */
-    OS_ERR_INT_Q_SIZE                = 18004u,                  /* OBSOLETE ERR CODE                                    */
-    OS_ERR_INT_Q_STK_INVALID         = 18005u,                  /* OBSOLETE ERR CODE                                    */
-    OS_ERR_INT_Q_STK_SIZE_INVALID    = 18006u,                  /* OBSOLETE ERR CODE                                    */
+    OS_ERR_INT_Q                     = 18002u,                  /* ISR post queue, see os_int.c                         */
+    OS_ERR_INT_Q_FULL                = 18003u,
+    OS_ERR_INT_Q_SIZE                = 18004u,
+    OS_ERR_INT_Q_STK_INVALID         = 18005u,
+    OS_ERR_INT_Q_STK_SIZE_INVALID    = 18006u,
 
     OS_ERR_ILLEGAL_DEL_RUN_TIME      = 18007u,
 
@@ -521,11 +663,14 @@ typedef  enum  os_err {
 
     OS_ERR_PTR_INVALID               = 25301u,
 
+    OS_ERR_PROF_BUF_SIZE             = 25401u,
+
     OS_ERR_Q                         = 26000u,
     OS_ERR_Q_FULL                    = 26001u,
     OS_ERR_Q_EMPTY                   = 26002u,
     OS_ERR_Q_MAX                     = 26003u,
     OS_ERR_Q_SIZE                    = 26004u,
+    OS_ERR_Q_NOT_EMPTY               = 26005u,
 
     OS_ERR_R                         = 27000u,
     OS_ERR_REG_ID_INVALID            = 27001u,
@@ -645,6 +790,9 @@ typedef  enum  os_err {
 typedef  struct  os_flag_grp         OS_FLAG_GRP;
 
 typedef  struct  os_mem              OS_MEM;
+typedef  struct  os_mem_ref          OS_MEM_REF;
+typedef  struct  os_mem_slab         OS_MEM_SLAB;
+typedef  struct  os_mem_slab_class   OS_MEM_SLAB_CLASS;
 
 typedef  struct  os_msg              OS_MSG;
 typedef  struct  os_msg_pool         OS_MSG_POOL;
@@ -681,10 +829,16 @@ typedef  struct  os_rdy_list         OS_RDY_LIST;
 
 typedef  struct  os_tick_list        OS_TICK_LIST;
 
+typedef  struct  os_wheel            OS_WHEEL;
+typedef  struct  os_wheel_node       OS_WHEEL_NODE;
+
 typedef  void                      (*OS_TMR_CALLBACK_PTR)(void *p_tmr, void *p_arg);
 typedef  struct  os_tmr              OS_TMR;
 
+typedef  struct  os_int_q            OS_INT_Q;
+
 typedef  struct  os_pend_list        OS_PEND_LIST;
+typedef  struct  os_pend_list_idx    OS_PEND_LIST_IDX;
 typedef  struct  os_pend_obj         OS_PEND_OBJ;
 
 #if (OS_CFG_APP_HOOKS_EN == DEF_ENABLED)
@@ -701,6 +855,30 @@ typedef  void                      (*OS_APP_HOOK_TCB)(OS_TCB *p_tcb);
 ************************************************************************************************************************
 */
 
+/*
+------------------------------------------------------------------------------------------------------------------------
+*                                                    ISR POST QUEUE
+*
+* Note(s) : (1) With OS_CFG_ISR_POST_DEFERRED_EN, a post made from an ISR is stored in OSCfg_IntQ[] and re-posted by
+*               OS_IntQTask() at task level.  The queue is a ring of OSCfg_IntQSize entries (a power of 2).  'Seq'
+*               equals the ring position an entry is free for, or that position + 1 once the entry holds a post.  ISRs
+*               claim a position with CPU_AtomicCmpSwap(), so they never disable interrupts to queue a post.
+------------------------------------------------------------------------------------------------------------------------
+*/
+
+#if (OS_CFG_ISR_POST_DEFERRED_EN == DEF_ENABLED)
+struct  os_int_q {
+    CPU_DATA             Seq;                               /* Ring position, see Note #1                             */
+    OS_OBJ_TYPE          Type;                              /* Type of object or task posted to                       */
+    void                *ObjPtr;                            /* Object or TCB posted to                                */
+    void                *MsgPtr;                            /* Message, for OS_OBJ_TYPE_Q and OS_OBJ_TYPE_TASK_MSG    */
+    OS_MSG_SIZE          MsgSize;
+    OS_FLAGS             Flags;                             /* Flags, for OS_OBJ_TYPE_FLAG                            */
+    OS_OPT               Opt;                               /* Post options                                           */
+};
+#endif
+
+
 /*
 ------------------------------------------------------------------------------------------------------------------------
 *                                                      READY LIST
@@ -728,7 +906,33 @@ struct  os_pend_list {
 #if (OS_CFG_DBG_EN == DEF_ENABLED)
     OS_OBJ_QTY           NbrEntries;
 #endif
+#if (OS_PEND_LIST_IDX_EN == DEF_ENABLED)
+    OS_PEND_LIST_IDX    *IdxPtr;                            /* Priority index, NULL if the object type has none       */
+#endif
+};
+
+
+/*
+------------------------------------------------------------------------------------------------------------------------
+*                                                   PEND LIST INDEX
+*
+* Note(s) : (1) Optional per object type (OS_CFG_xxx_PEND_IDX_EN). The pend list stays a list sorted by priority, FIFO
+*               within a priority. The index records which priorities have waiters, in the same bit order as
+*               OSPrioTbl[], and the last waiter of each. A task is then linked in after the last waiter of its own or
+*               the next higher priority without walking the list.
+*
+*           (2) The index covers priorities 0 to OS_CFG_PEND_IDX_PRIO_MAX - 1, which bounds its RAM to one pointer per
+*               priority covered plus the bitmap (OS_CFG_PEND_IDX_PRIO_MAX defaults to at most 64).  A waiter at a lower
+*               priority is inserted by walking from the last indexed waiter, past the lower priority waiters only.
+------------------------------------------------------------------------------------------------------------------------
+*/
+
+#if (OS_PEND_LIST_IDX_EN == DEF_ENABLED)
+struct  os_pend_list_idx {
+    CPU_DATA             PrioTbl[OS_PEND_IDX_TBL_SIZE];     /* Priorities with at least one waiter                    */
+    OS_TCB              *TailPtr[OS_CFG_PEND_IDX_PRIO_MAX]; /* Last waiter at each priority, see Note #2              */
 };
+#endif
 
 
 /*
@@ -790,6 +994,9 @@ struct  os_flag_grp {                                       /* Event Flag Group
 #if (OS_CFG_TS_EN == DEF_ENABLED)
     CPU_TS               TS;                                /* Timestamp of when last post occurred                   */
 #endif
+#if (OS_CFG_FLAG_PEND_IDX_EN == DEF_ENABLED)
+    OS_PEND_LIST_IDX     PendListIdx;                       /* Priority index of .PendList                            */
+#endif
 #if (defined(OS_CFG_TRACE_EN) && (OS_CFG_TRACE_EN == DEF_ENABLED))
     CPU_INT16U           FlagID;                            /* Unique ID for third-party debuggers and tracers.       */
 #endif
@@ -799,6 +1006,12 @@ struct  os_flag_grp {                                       /* Event Flag Group
 /*
 ------------------------------------------------------------------------------------------------------------------------
 *                                                   MEMORY PARTITIONS
+*
+* Note(s) : (1) With OS_CFG_MEM_LOCK_FREE_EN, OSMemGet() and OSMemPut() change the free list and NbrFree with
+*               CPU_AtomicCmpSwap() instead of disabling interrupts.  The top of the free list is then one data word:
+*               the index (plus one) of the first free block in the low half, 0 when empty, and a tag in the high half
+*               that every push and pop increments.  The tag makes the swap fail if the list was popped and pushed
+*               back to the same block in between (ABA).  Each free block holds the index word of the next one.
 ------------------------------------------------------------------------------------------------------------------------
 */
 
@@ -811,10 +1024,18 @@ struct os_mem {                                             /* MEMORY CONTROL BL
     CPU_CHAR            *NamePtr;
 #endif
     void                *AddrPtr;                           /* Pointer to beginning of memory partition               */
+#if (OS_CFG_MEM_LOCK_FREE_EN == DEF_ENABLED)
+    CPU_DATA             FreeListTop;                       /* Tag and index of first free block, see Note #1         */
+#else
     void                *FreeListPtr;                       /* Pointer to list of free memory blocks                  */
+#endif
     OS_MEM_SIZE          BlkSize;                           /* Size (in bytes) of each block of memory                */
     OS_MEM_QTY           NbrMax;                            /* Total number of blocks in this partition               */
+#if (OS_CFG_MEM_LOCK_FREE_EN == DEF_ENABLED)
+    CPU_DATA             NbrFree;                           /* Number of memory blocks remaining, see Note #1         */
+#else
     OS_MEM_QTY           NbrFree;                           /* Number of memory blocks remaining in this partition    */
+#endif
 #if (OS_CFG_DBG_EN == DEF_ENABLED)
     OS_MEM              *DbgPrevPtr;
     OS_MEM              *DbgNextPtr;
@@ -824,6 +1045,66 @@ struct os_mem {                                             /* MEMORY CONTROL BL
 #endif
 };
 
+#if (OS_CFG_MEM_LOCK_FREE_EN == DEF_ENABLED)
+#define  OS_MEM_FREE_IX_MSK     ((CPU_DATA)0x0000FFFFu)     /* Index (plus one) of a block, see Note #1               */
+#define  OS_MEM_FREE_TAG_INC    ((CPU_DATA)0x00010000u)     /* Tag increment, see Note #1                             */
+#endif
+
+
+/*
+------------------------------------------------------------------------------------------------------------------------
+*                                           REFERENCE-COUNTED MEMORY BLOCKS
+*
+* Note(s) : (1) OSMemRefGet() places this header at the start of the block and returns the address just after it.
+*               Blocks of a partition used this way must be OS_MEM_REF_BLK_SIZE() bytes for the payload size wanted.
+------------------------------------------------------------------------------------------------------------------------
+*/
+
+#if (OS_CFG_MEM_REF_EN == DEF_ENABLED)
+struct os_mem_ref {                                         /* REFERENCE-COUNTED BLOCK HEADER                         */
+    OS_MEM              *MemPtr;                            /* Partition the block returns to on last release         */
+    CPU_DATA             RefCtr;                            /* Number of holders, changed with CPU_AtomicCmpSwap()    */
+};
+
+#define  OS_MEM_REF_BLK_SIZE(size)     ((OS_MEM_SIZE)(sizeof(OS_MEM_REF) +                            \
+                                                      (((size) + sizeof(void *) - 1u) & ~(sizeof(void *) - 1u))))
+#endif
+
+
+/*
+------------------------------------------------------------------------------------------------------------------------
+*                                                 SLAB MEMORY ALLOCATOR
+*
+* Note(s) : (1) A slab is a table of partitions whose block sizes double from one class to the next, starting at a
+*               power of two.  OSMemSlabAlloc() maps a request size to its class with CPU_CntLeadZeros().
+*
+*           (2) The statistics of a class count the requests that mapped to it.  A request that found its class
+*               empty and was served by a larger one is also counted in SpillCtr.
+------------------------------------------------------------------------------------------------------------------------
+*/
+
+#if (OS_CFG_MEM_SLAB_EN == DEF_ENABLED)
+struct os_mem_slab_class {                                  /* SIZE CLASS OF A SLAB                                   */
+    OS_MEM              *MemPtr;                            /* Partition holding the blocks of this class             */
+    OS_MEM_QTY           NbrUsedMax;                        /* Peak number of blocks of the partition in use          */
+    OS_CTR               AllocCtr;                          /* Number of requests that mapped to this class           */
+    OS_CTR               SpillCtr;                          /* ... of those, served by a larger class                 */
+    OS_CTR               FailCtr;                           /* ... of those, not served at all                        */
+};
+
+struct os_mem_slab {                                        /* SLAB CONTROL BLOCK                                     */
+#if (OS_OBJ_TYPE_REQ == DEF_ENABLED)
+    OS_OBJ_TYPE          Type;                              /* Should be set to OS_OBJ_TYPE_MEM_SLAB                  */
+#endif
+#if (OS_CFG_DBG_EN == DEF_ENABLED)
+    CPU_CHAR            *NamePtr;
+#endif
+    OS_MEM_SLAB_CLASS   *ClassTbl;                          /* Classes, smallest block size first                     */
+    OS_OBJ_QTY           NbrClass;                          /* Number of entries in ClassTbl[]                        */
+    CPU_INT08U           MinShift;                          /* Block size of ClassTbl[0] is 2^MinShift                */
+};
+#endif
+
 
 /*
 ------------------------------------------------------------------------------------------------------------------------
@@ -838,6 +1119,9 @@ struct  os_msg {                                            /* MESSAGE CONTROL B
 #if (OS_CFG_TS_EN == DEF_ENABLED)
     CPU_TS               MsgTS;                             /* Time stamp of when message was sent                    */
 #endif
+#if (OS_CFG_MEM_REF_EN == DEF_ENABLED)
+    CPU_BOOLEAN          MsgRef;                            /* MsgPtr holds a reference, see OSQPostRef()             */
+#endif
 };
 
 
@@ -847,9 +1131,14 @@ struct  os_msg_pool {                                       /* OS_MSG POOL
     OS_MSG              *NextPtr;                           /* Pointer to next message                                */
     OS_MSG_QTY           NbrFree;                           /* Number of messages available from this pool            */
     OS_MSG_QTY           NbrUsed;                           /* Current number of messages used                        */
-#if (OS_CFG_DBG_EN == DEF_ENABLED)
+#if ((OS_CFG_DBG_EN == DEF_ENABLED) || (OS_CFG_MSG_POOL_LOCAL_EN == DEF_ENABLED))
     OS_MSG_QTY           NbrUsedMax;                        /* Peak number of messages used                           */
 #endif
+#if (OS_CFG_MSG_POOL_LOCAL_EN == DEF_ENABLED)
+    OS_MSG              *BasePtr;                           /* First OS_MSG of the pool's storage                     */
+    OS_MSG_QTY           Size;                              /* Number of OS_MSGs in the pool's storage                */
+    OS_CTR               FallbackCtr;                       /* Posts that found it empty and used OSMsgPool instead   */
+#endif
 };
 
 
@@ -862,6 +1151,9 @@ struct  os_msg_q {                                          /* OS_MSG_Q
 #if (OS_CFG_DBG_EN == DEF_ENABLED)
     OS_MSG_QTY           NbrEntriesMax;                     /* Peak number of entries in the queue                    */
 #endif
+#if (OS_CFG_MSG_POOL_LOCAL_EN == DEF_ENABLED)
+    OS_MSG_POOL         *PoolPtr;                           /* Pool OS_MSGs are taken from, OSMsgPool by default      */
+#endif
 #if (defined(OS_CFG_TRACE_EN) && (OS_CFG_TRACE_EN == DEF_ENABLED))
     CPU_INT16U           MsgQID;                            /* Unique ID for third-party debuggers and tracers.       */
 #endif
@@ -897,6 +1189,9 @@ struct  os_mutex {                                          /* Mutual Exclusion
 #if (OS_CFG_TS_EN == DEF_ENABLED)
     CPU_TS               TS;
 #endif
+#if (OS_CFG_MUTEX_PEND_IDX_EN == DEF_ENABLED)
+    OS_PEND_LIST_IDX     PendListIdx;                       /* Priority index of .PendList                            */
+#endif
 #if (defined(OS_CFG_TRACE_EN) && (OS_CFG_TRACE_EN == DEF_ENABLED))
     CPU_INT16U           MutexID;                           /* Unique ID for third-party debuggers and tracers.       */
 #endif
@@ -927,6 +1222,9 @@ struct  os_q {                                              /* Message Queue
 #endif
                                                             /* ------------------ SPECIFIC MEMBERS ------------------ */
     OS_MSG_Q             MsgQ;                              /* List of messages                                       */
+#if (OS_CFG_Q_PEND_IDX_EN == DEF_ENABLED)
+    OS_PEND_LIST_IDX     PendListIdx;                       /* Priority index of .PendList                            */
+#endif
 };
 
 
@@ -957,6 +1255,9 @@ struct  os_sem {                                            /* Semaphore
 #if (OS_CFG_TS_EN == DEF_ENABLED)
     CPU_TS               TS;
 #endif
+#if (OS_CFG_SEM_PEND_IDX_EN == DEF_ENABLED)
+    OS_PEND_LIST_IDX     PendListIdx;                       /* Priority index of .PendList                            */
+#endif
 #if (defined(OS_CFG_TRACE_EN) && (OS_CFG_TRACE_EN == DEF_ENABLED))
     CPU_INT16U           SemID;                             /* Unique ID for third-party debuggers and tracers.       */
 #endif
@@ -995,6 +1296,62 @@ struct  os_mon_ctx {
 };
 
 
+/*
+------------------------------------------------------------------------------------------------------------------------
+*                                                  RUN-TIME PROFILER
+*
+* Note(s) : (1) Pend latency is the time from the post, abort or timeout that made a task ready until it runs.  It is
+*               counted in OS_PROF_LAT_BINS bins of OS_TS_GET() counts.  Bin 0 holds latencies below
+*               2^OS_PROF_LAT_SHIFT counts, each next bin those below twice the limit of the bin before it, and the
+*               last bin all longer ones.
+*
+*           (2) OSProfSnapshot() copies OS_PROF_NAME_SIZE bytes of each task name, zero padded.
+------------------------------------------------------------------------------------------------------------------------
+*/
+
+#define  OS_PROF_LAT_BINS                             16u
+#define  OS_PROF_LAT_SHIFT                             6u
+#define  OS_PROF_NAME_SIZE                            16u
+
+#define  OS_PROF_VERSION                               2u       /* Layout of an OSProfSnapshot() record               */
+#define  OS_PROF_HDR_SIZE                             36u       /* Bytes in its header                                */
+#define  OS_PROF_TASK_SIZE                            (36u + OS_PROF_NAME_SIZE + (4u * OS_PROF_LAT_BINS))
+
+
+/*
+------------------------------------------------------------------------------------------------------------------------
+*                                                 TIMING WHEEL DATA TYPES
+------------------------------------------------------------------------------------------------------------------------
+*/
+
+#if ((OS_CFG_TICK_WHEEL_EN == DEF_ENABLED) || (OS_CFG_TMR_WHEEL_EN == DEF_ENABLED))
+#define  OS_WHEEL_EN                    DEF_ENABLED
+#else
+#define  OS_WHEEL_EN                    DEF_DISABLED
+#endif
+
+#if (OS_WHEEL_EN == DEF_ENABLED)
+#define  OS_WHEEL_LEVELS                   6u               /* 6 levels of 6 bits cover every 32-bit time            */
+#define  OS_WHEEL_BITS                     6u
+#define  OS_WHEEL_SLOTS                 (1u << OS_WHEEL_BITS)
+#define  OS_WHEEL_MASK                  (OS_WHEEL_SLOTS - 1u)
+#define  OS_WHEEL_MAP_SIZE             (((OS_WHEEL_SLOTS - 1u) / DEF_INT_CPU_NBR_BITS) + 1u)
+
+struct  os_wheel_node {
+    OS_WHEEL_NODE       *NextPtr;
+    OS_WHEEL_NODE       *PrevPtr;                           /* The first entry of a slot points to the last           */
+    OS_TICK              Expire;                            /* Value of .Now at which the entry is due                */
+    void                *ObjPtr;                            /* Task or timer the entry belongs to                     */
+};
+
+struct  os_wheel {
+    OS_WHEEL_NODE       *Slot[OS_WHEEL_LEVELS][OS_WHEEL_SLOTS];                 /* Entries per level and slot        */
+    CPU_DATA             Map[OS_WHEEL_LEVELS][OS_WHEEL_MAP_SIZE];               /* Slots not empty, MSB first        */
+    OS_TICK              Now;                               /* Ticks the wheel has been advanced by                  */
+};
+#endif
+
+
 /*
 ------------------------------------------------------------------------------------------------------------------------
 *                                                  TASK CONTROL BLOCK
@@ -1018,8 +1375,12 @@ struct os_tcb {
     OS_TCB              *PrevPtr;                           /* Pointer to previous TCB in the TCB list                */
 
 #if (OS_CFG_TASK_TICK_EN == DEF_ENABLED)
+#if (OS_CFG_TICK_WHEEL_EN == DEF_ENABLED)
+    OS_WHEEL_NODE        TickNode;                          /* Entry in the tick list's timing wheel                  */
+#else
     OS_TCB              *TickNextPtr;
     OS_TCB              *TickPrevPtr;
+#endif
 
     OS_TICK_LIST        *TickListPtr;                       /* Pointer to tick list if task is in a tick list         */
 #endif
@@ -1118,11 +1479,56 @@ struct os_tcb {
     CPU_TS               SemPendTimeMax;                    /* Max amount of time it took for signal to be received   */
 #endif
 
+#if (OS_CFG_PROF_EN == DEF_ENABLED)
+    OS_CYCLES            ProfCycles;                        /* Cycles run, ISRs excluded, see os_prof.c               */
+    OS_CTR               ProfPreemptCtr;                    /* Times switched out while still ready to run            */
+    CPU_TS               ProfRdyTS;                         /* Value of .TS when the task was last switched in        */
+    CPU_TS               ProfLatMax;                        /* Longest time from being made ready to running          */
+    OS_CTR               ProfLatHist[OS_PROF_LAT_BINS];     /* Histogram of those times (see RUN-TIME PROFILER)       */
+    OS_CTR               ProfFpCtxSwCtr;                    /* Times switched out with its FP registers               */
+    OS_CYCLES            ProfCtxSwCycles;                   /* Cycles the port spent saving and restoring its context */
+    CPU_TS               ProfCtxSwMax;                      /* Longest save and restore                               */
+#endif
+
 #if (OS_CFG_STAT_TASK_STK_CHK_EN == DEF_ENABLED)
     CPU_STK_SIZE         StkUsed;                           /* Number of stack elements used from the stack           */
     CPU_STK_SIZE         StkFree;                           /* Number of stack elements free on   the stack           */
 #endif
 
+#if (OS_CFG_STK_GUARD_EN == DEF_ENABLED)
+    CPU_STK             *StkGuardPtr;                       /* Start of the stack guard, NULL if the stack has none   */
+    CPU_STK_SIZE         StkUsedMax;                        /* Most stack elements in use when switched out           */
+#endif
+
+#if (OS_CFG_TASK_BUDGET_EN == DEF_ENABLED)                  /* CPU BUDGET (see os_budget.c) ------------------------- */
+    OS_TCB              *BudgetNextPtr;                     /* Next task in OSBudgetListPtr                           */
+    OS_TICK              Budget;                            /* Ticks of CPU per period, 0 if the task has no budget   */
+    OS_TICK              BudgetPeriod;                      /* Replenishment period in ticks                          */
+    CPU_TS               BudgetRem;                         /* OS_TS_GET() counts left, 0 when demoted                */
+    CPU_TS               BudgetUsed;                        /* Counts used since .BudgetActTime                       */
+    CPU_TS               BudgetTS;                          /* OS_TS_GET() when last switched in or charged           */
+    OS_TICK              BudgetActTime;                     /* Tick at which the task last became active              */
+    CPU_BOOLEAN          BudgetActive;                      /* Running or ready at .BudgetPrio since .BudgetActTime   */
+    OS_PRIO              BudgetPrio;                        /* Priority while budget remains                          */
+    OS_PRIO              BudgetPrioLow;                     /* Priority once the budget is used up                    */
+    CPU_INT08U           BudgetReplIx;                      /* Oldest pending replenishment                           */
+    CPU_INT08U           BudgetReplNbr;                     /* Number of pending replenishments                       */
+    OS_TICK              BudgetReplTime[OS_CFG_TASK_BUDGET_REPL_MAX];    /* Tick each one is due                      */
+    CPU_TS               BudgetReplAmt[OS_CFG_TASK_BUDGET_REPL_MAX];     /* Counts each one gives back                */
+    OS_CTR               BudgetOverrunCtr;                  /* Number of times the budget ran out                     */
+#endif
+
+#if (OS_CFG_EDF_EN == DEF_ENABLED)                          /* EDF BANDS (see os_edf.c) ----------------------------- */
+    OS_TICK              EdfPeriod;                         /* Least ticks between two releases, 0 for no minimum     */
+    OS_TICK              EdfDeadline;                       /* Relative deadline in ticks, 0 if the task has none     */
+    OS_TICK              EdfRelease;                        /* Tick at which the current job was released             */
+    OS_TICK              EdfDeadlineAbs;                    /* Tick at which the current job is due                   */
+    CPU_BOOLEAN          EdfLate;                           /* Current job was counted as missed                      */
+    CPU_BOOLEAN          EdfWake;                           /* Next readying releases a job (see os_edf.c Note #2)    */
+    OS_CTR               EdfJobCtr;                         /* Number of jobs released                                */
+    OS_CTR               EdfMissCtr;                        /* Number of jobs that missed their deadline              */
+#endif
+
 #ifdef CPU_CFG_INT_DIS_MEAS_EN
     CPU_TS               IntDisTimeMax;                     /* Maximum interrupt disable time                         */
 #endif
@@ -1148,7 +1554,11 @@ struct os_tcb {
 */
 
 struct  os_tick_list {
+#if (OS_CFG_TICK_WHEEL_EN == DEF_ENABLED)
+    OS_WHEEL             Wheel;                             /* Tasks by expiry, .Now follows OSTickCtr               */
+#else
     OS_TCB              *TCB_Ptr;                           /* Pointer to list of tasks in tick list                 */
+#endif
 #if (OS_CFG_DBG_EN == DEF_ENABLED)
     OS_OBJ_QTY           NbrEntries;                        /* Current number of entries in the tick list            */
     OS_OBJ_QTY           NbrUpdated;                        /* Number of entries updated                             */
@@ -1171,9 +1581,13 @@ struct  os_tmr {
 #endif
     OS_TMR_CALLBACK_PTR  CallbackPtr;                       /* Function to call when timer expires                    */
     void                *CallbackPtrArg;                    /* Argument to pass to function when timer expires        */
+#if (OS_CFG_TMR_WHEEL_EN == DEF_ENABLED)
+    OS_WHEEL_NODE        WheelNode;                         /* Entry in OSTmrWheel, due at .WheelNode.Expire          */
+#else
     OS_TMR              *NextPtr;                           /* Double link list pointers                              */
     OS_TMR              *PrevPtr;
     OS_TICK              Remain;                            /* Amount of time remaining before timer expires          */
+#endif
     OS_TICK              Dly;                               /* Delay before start of repeat                           */
     OS_TICK              Period;                            /* Period to repeat timer                                 */
     OS_OPT               Opt;                               /* Options (see OS_OPT_TMR_xxx)                           */
@@ -1197,6 +1611,9 @@ struct  os_tmr {
 #if (OS_CFG_TASK_STK_REDZONE_EN == DEF_ENABLED)
 OS_EXT           OS_APP_HOOK_TCB            OS_AppRedzoneHitHookPtr;
 #endif
+#if (OS_CFG_STK_GUARD_EN == DEF_ENABLED)
+OS_EXT           OS_APP_HOOK_TCB            OS_AppStkGuardHitHookPtr;
+#endif
 OS_EXT           OS_APP_HOOK_TCB            OS_AppTaskCreateHookPtr;
 OS_EXT           OS_APP_HOOK_TCB            OS_AppTaskDelHookPtr;
 OS_EXT           OS_APP_HOOK_TCB            OS_AppTaskReturnHookPtr;
@@ -1213,6 +1630,15 @@ OS_EXT            OS_IDLE_CTR               OSIdleTaskCtr;
 #endif
 #if (OS_CFG_TASK_IDLE_EN == DEF_ENABLED)
 OS_EXT            OS_TCB                    OSIdleTaskTCB;
+#endif
+
+                                                                        /* ISR POST QUEUE --------------------------- */
+#if (OS_CFG_ISR_POST_DEFERRED_EN == DEF_ENABLED)
+OS_EXT            CPU_DATA                  OSIntQInCtr;                /* Next ring position an ISR claims           */
+OS_EXT            CPU_DATA                  OSIntQOutCtr;               /* Next ring position to re-post              */
+OS_EXT            CPU_DATA                  OSIntQOvfCtr;               /* Posts lost to a full queue                 */
+OS_EXT            OS_OBJ_QTY                OSIntQNbrEntriesMax;        /* Largest batch re-posted at once            */
+OS_EXT            OS_TCB                    OSIntQTaskTCB;
 #endif
 
                                                                         /* MISCELLANEOUS ---------------------------- */
@@ -1260,6 +1686,18 @@ OS_EXT            OS_OBJ_QTY                OSMutexQty;                 /* Numbe
 OS_EXT            OS_PRIO                   OSPrioCur;                  /* Priority of current task                   */
 OS_EXT            OS_PRIO                   OSPrioHighRdy;              /* Priority of highest priority task          */
 extern            CPU_DATA                  OSPrioTbl[OS_PRIO_TBL_SIZE];
+#if (OS_CFG_PRIO_MAX > DEF_INT_CPU_NBR_BITS)
+extern            CPU_DATA                  OSPrioGrp;                  /* Non-empty entries of OSPrioTbl[]           */
+#endif
+
+                                                                        /* PROFILER --------------------------------- */
+#if (OS_CFG_PROF_EN == DEF_ENABLED)
+OS_EXT            OS_CYCLES                 OSProfIntCycles;            /* Cycles spent in ISRs                       */
+OS_EXT            OS_CYCLES                 OSProfIntCyclesSw;          /* OSProfIntCycles at the last task switch    */
+OS_EXT            OS_CTR                    OSProfIntCtr;               /* Number of ISRs, nested ones not counted    */
+OS_EXT            CPU_TS                    OSProfIntTimeMax;           /* Longest ISR, nested ones included          */
+OS_EXT            CPU_TS                    OSProfIntTS;                /* Entry time of the outermost ISR            */
+#endif
 
                                                                         /* QUEUES ----------------------------------- */
 #if (OS_CFG_Q_EN == DEF_ENABLED)
@@ -1289,6 +1727,12 @@ OS_EXT            OS_NESTING_CTR            OSSchedLockNestingCtr;      /* Lock
 #if (OS_CFG_SCHED_ROUND_ROBIN_EN == DEF_ENABLED)
 OS_EXT            OS_TICK                   OSSchedRoundRobinDfltTimeQuanta;
 OS_EXT            CPU_BOOLEAN               OSSchedRoundRobinEn;        /* Enable/Disable round-robin scheduling      */
+#endif
+#if (OS_CFG_TASK_BUDGET_EN == DEF_ENABLED)
+OS_EXT            OS_TCB                   *OSBudgetListPtr;            /* Tasks with a CPU budget                    */
+OS_EXT            OS_OBJ_QTY                OSBudgetQty;
+OS_EXT            CPU_INT16U                OSBudgetUtil;               /* Their share of the CPU, in 0.01% units     */
+OS_EXT            CPU_TS                    OSBudgetTickCnts;           /* OS_TS_GET() counts per tick                */
 #endif
                                                                         /* SEMAPHORES ------------------------------- */
 #if (OS_CFG_SEM_EN == DEF_ENABLED)
@@ -1357,7 +1801,11 @@ OS_EXT            OS_TICK_LIST              OSTickListTimeout;
 OS_EXT            OS_TMR                   *OSTmrDbgListPtr;
 OS_EXT            OS_OBJ_QTY                OSTmrListEntries;           /* Doubly-linked list of timers               */
 #endif
+#if (OS_CFG_TMR_WHEEL_EN == DEF_ENABLED)
+OS_EXT            OS_WHEEL                  OSTmrWheel;                 /* Running timers, .Now follows OSTmrTickCtr  */
+#else
 OS_EXT            OS_TMR                   *OSTmrListPtr;
+#endif
 #if (OS_CFG_MUTEX_EN == DEF_ENABLED)                                    /* Use a Mutex (if available) to protect tmrs */
 OS_EXT            OS_MUTEX                  OSTmrMutex;
 #endif
@@ -1394,6 +1842,16 @@ extern  CPU_STK_SIZE  const OSCfg_IdleTaskStkLimit;
 extern  CPU_STK_SIZE  const OSCfg_IdleTaskStkSize;
 extern  CPU_INT32U    const OSCfg_IdleTaskStkSizeRAM;
 
+#if (OS_CFG_ISR_POST_DEFERRED_EN == DEF_ENABLED)
+extern  OS_INT_Q    * const OSCfg_IntQBasePtr;
+extern  OS_OBJ_QTY    const OSCfg_IntQSize;
+extern  CPU_INT32U    const OSCfg_IntQSizeRAM;
+extern  CPU_STK     * const OSCfg_IntQTaskStkBasePtr;
+extern  CPU_STK_SIZE  const OSCfg_IntQTaskStkLimit;
+extern  CPU_STK_SIZE  const OSCfg_IntQTaskStkSize;
+extern  CPU_INT32U    const OSCfg_IntQTaskStkSizeRAM;
+#endif
+
 extern  CPU_STK     * const OSCfg_ISRStkBasePtr;
 extern  CPU_STK_SIZE  const OSCfg_ISRStkSize;
 extern  CPU_INT32U    const OSCfg_ISRStkSizeRAM;
@@ -1431,6 +1889,11 @@ extern  CPU_INT32U    const OSCfg_DataSizeRAM;
 extern  CPU_STK        OSCfg_IdleTaskStk[OS_CFG_IDLE_TASK_STK_SIZE];
 #endif
 
+#if (OS_CFG_ISR_POST_DEFERRED_EN == DEF_ENABLED)
+extern  OS_INT_Q       OSCfg_IntQ[OS_CFG_INT_Q_SIZE];
+extern  CPU_STK        OSCfg_IntQTaskStk[OS_CFG_INT_Q_TASK_STK_SIZE];
+#endif
+
 #if (OS_CFG_ISR_STK_SIZE > 0u)
 extern  CPU_STK        OSCfg_ISRStk[OS_CFG_ISR_STK_SIZE];
 #endif
@@ -1537,6 +2000,33 @@ void          OSMemPut                  (OS_MEM                *p_mem,
                                          void                  *p_blk,
                                          OS_ERR                *p_err);
 
+#if (OS_CFG_MEM_REF_EN == DEF_ENABLED)
+void          OSMemRefAdd               (void                  *p_data,
+                                         OS_ERR                *p_err);
+
+void         *OSMemRefGet               (OS_MEM                *p_mem,
+                                         OS_ERR                *p_err);
+
+void          OSMemRefRelease           (void                  *p_data,
+                                         OS_ERR                *p_err);
+#endif
+
+#if (OS_CFG_MEM_SLAB_EN == DEF_ENABLED)
+void          OSMemSlabCreate           (OS_MEM_SLAB           *p_slab,
+                                         CPU_CHAR              *p_name,
+                                         OS_MEM_SLAB_CLASS     *p_class_tbl,
+                                         OS_OBJ_QTY             n_class,
+                                         OS_ERR                *p_err);
+
+void         *OSMemSlabAlloc            (OS_MEM_SLAB           *p_slab,
+                                         OS_MEM_SIZE            size,
+                                         OS_ERR                *p_err);
+
+void          OSMemSlabFree             (OS_MEM_SLAB           *p_slab,
+                                         void                  *p_blk,
+                                         OS_ERR                *p_err);
+#endif
+
 /* ------------------------------------------------ INTERNAL FUNCTIONS ---------------------------------------------- */
 
 #if (OS_CFG_DBG_EN == DEF_ENABLED)
@@ -1585,6 +2075,18 @@ void          OS_MonDbgListRemove       (OS_MON                *p_mon);
 #endif
 
 
+/* ================================================================================================================== */
+/*                                                   MESSAGE POOLS                                                    */
+/* ================================================================================================================== */
+
+#if (OS_MSG_EN == DEF_ENABLED) && (OS_CFG_MSG_POOL_LOCAL_EN == DEF_ENABLED)
+void          OSMsgPoolCreate           (OS_MSG_POOL           *p_pool,
+                                         OS_MSG                *p_base,
+                                         OS_MSG_QTY             size,
+                                         OS_ERR                *p_err);
+#endif
+
+
 /* ================================================================================================================== */
 /*                                             MUTUAL EXCLUSION SEMAPHORES                                            */
 /* ================================================================================================================== */
@@ -1675,12 +2177,26 @@ OS_OBJ_QTY    OSQPendAbort              (OS_Q                  *p_q,
                                          OS_ERR                *p_err);
 #endif
 
+#if (OS_CFG_MSG_POOL_LOCAL_EN == DEF_ENABLED)
+void          OSQPoolSet                (OS_Q                  *p_q,
+                                         OS_MSG_POOL           *p_pool,
+                                         OS_ERR                *p_err);
+#endif
+
 void          OSQPost                   (OS_Q                  *p_q,
                                          void                  *p_void,
                                          OS_MSG_SIZE            msg_size,
                                          OS_OPT                 opt,
                                          OS_ERR                *p_err);
 
+#if (OS_CFG_MEM_REF_EN == DEF_ENABLED)
+void          OSQPostRef                (OS_Q                  *p_q,
+                                         void                  *p_data,
+                                         OS_MSG_SIZE            msg_size,
+                                         OS_OPT                 opt,
+                                         OS_ERR                *p_err);
+#endif
+
 /* ------------------------------------------------ INTERNAL FUNCTIONS ---------------------------------------------- */
 
 void          OS_QClr                   (OS_Q                  *p_q);
@@ -1694,6 +2210,101 @@ void          OS_QDbgListRemove         (OS_Q                  *p_q);
 #endif
 
 
+/* ================================================================================================================== */
+/*                                                  RUN-TIME PROFILER                                                 */
+/* ================================================================================================================== */
+
+#if (OS_CFG_PROF_EN == DEF_ENABLED)
+
+CPU_SIZE_T    OSProfSnapshot            (void                  *p_buf,
+                                         CPU_SIZE_T             buf_size,
+                                         OS_ERR                *p_err);
+
+/* ------------------------------------------------ INTERNAL FUNCTIONS ---------------------------------------------- */
+
+void          OS_ProfCtxSw              (OS_TCB                *p_tcb,
+                                         CPU_BOOLEAN            fp,
+                                         CPU_TS                 cycles);
+
+void          OS_ProfInit               (void);
+
+void          OS_ProfIntEnter           (void);
+
+void          OS_ProfIntExit            (void);
+
+void          OS_ProfTaskSw             (CPU_TS                 ts);
+
+#endif
+
+
+/* ================================================================================================================== */
+/*                                                    STACK GUARD                                                     */
+/* ================================================================================================================== */
+
+#if (OS_CFG_STK_GUARD_EN == DEF_ENABLED)
+
+/* ------------------------------------------------ INTERNAL FUNCTIONS ---------------------------------------------- */
+
+void          OS_StkGuardInit           (void);
+
+void          OS_StkGuardTaskInit       (OS_TCB                *p_tcb);
+
+void          OS_StkGuardTaskSw         (void);
+
+#endif
+
+
+/* ================================================================================================================== */
+/*                                                     CPU BUDGET                                                     */
+/* ================================================================================================================== */
+
+#if (OS_CFG_TASK_BUDGET_EN == DEF_ENABLED)
+
+void          OSTaskBudgetSet           (OS_TCB                *p_tcb,
+                                         OS_TICK                budget,
+                                         OS_TICK                period,
+                                         OS_PRIO                prio_low,
+                                         OS_ERR                *p_err);
+
+/* ------------------------------------------------ INTERNAL FUNCTIONS ---------------------------------------------- */
+
+void          OS_BudgetInit             (void);
+
+void          OS_BudgetTaskDel          (OS_TCB                *p_tcb);
+
+void          OS_BudgetTaskSw           (void);
+
+void          OS_BudgetTick             (void);
+
+#if (OS_CFG_DYN_TICK_EN == DEF_ENABLED)
+OS_TICK       OS_BudgetTickNextGet      (void);
+#endif
+
+#endif
+
+
+/* ================================================================================================================== */
+/*                                                      EDF BANDS                                                     */
+/* ================================================================================================================== */
+
+#if (OS_CFG_EDF_EN == DEF_ENABLED)
+
+void          OSTaskEdfSet              (OS_TCB                *p_tcb,
+                                         OS_TICK                period,
+                                         OS_TICK                deadline,
+                                         OS_ERR                *p_err);
+
+/* ------------------------------------------------ INTERNAL FUNCTIONS ---------------------------------------------- */
+
+void          OS_EdfJobChk              (OS_TCB                *p_tcb);
+
+void          OS_EdfRdyListInsert       (OS_TCB                *p_tcb);
+
+void          OS_EdfRelease             (OS_TCB                *p_tcb);
+
+#endif
+
+
 /* ================================================================================================================== */
 /*                                                     SEMAPHORES                                                     */
 /* ================================================================================================================== */
@@ -1789,6 +2400,12 @@ CPU_BOOLEAN   OSTaskQPendAbort          (OS_TCB                *p_tcb,
                                          OS_OPT                 opt,
                                          OS_ERR                *p_err);
 
+#if (OS_CFG_MSG_POOL_LOCAL_EN == DEF_ENABLED)
+void          OSTaskQPoolSet            (OS_TCB                *p_tcb,
+                                         OS_MSG_POOL           *p_pool,
+                                         OS_ERR                *p_err);
+#endif
+
 void          OSTaskQPost               (OS_TCB                *p_tcb,
                                          void                  *p_void,
                                          OS_MSG_SIZE            msg_size,
@@ -1969,7 +2586,7 @@ void          OS_TmrDbgListRemove       (OS_TMR                *p_tmr);
 void          OS_TmrInit                (OS_ERR                *p_err);
 
 void          OS_TmrLink                (OS_TMR                *p_tmr,
-                                         OS_OPT                 opt);
+                                         OS_TICK                time);
 
 void          OS_TmrUnlink              (OS_TMR                *p_tmr);
 
@@ -2047,6 +2664,20 @@ void          OS_IdleTask               (void                  *p_arg);
 
 void          OS_IdleTaskInit           (OS_ERR                *p_err);
 
+#if (OS_CFG_ISR_POST_DEFERRED_EN == DEF_ENABLED)
+void          OS_IntQPost               (OS_OBJ_TYPE            type,
+                                         void                  *p_obj,
+                                         void                  *p_void,
+                                         OS_MSG_SIZE            msg_size,
+                                         OS_FLAGS               flags,
+                                         OS_OPT                 opt,
+                                         OS_ERR                *p_err);
+
+void          OS_IntQTask               (void                  *p_arg);
+
+void          OS_IntQTaskInit           (OS_ERR                *p_err);
+#endif
+
 #if (OS_CFG_STAT_TASK_EN == DEF_ENABLED)
 void          OS_StatTask               (void                  *p_arg);
 #endif
@@ -2073,6 +2704,10 @@ void          OSInitHook                (void);
 void          OSRedzoneHitHook          (OS_TCB                *p_tcb);
 #endif
 
+#if (OS_CFG_STK_GUARD_EN == DEF_ENABLED)
+void          OSStkGuardHitHook         (OS_TCB                *p_tcb);
+#endif
+
 void          OSStatTaskHook            (void);
 
 void          OSTaskCreateHook          (OS_TCB                *p_tcb);
@@ -2129,6 +2764,10 @@ void          OS_MsgQPut                (OS_MSG_Q              *p_msg_q,
                                          CPU_TS                 ts,
                                          OS_ERR                *p_err);
 
+#if (OS_CFG_MEM_REF_EN == DEF_ENABLED)
+void          OS_MsgQRefRelease         (OS_MSG_Q              *p_msg_q);
+#endif
+
 /* ---------------------------------------------- PEND/POST MANAGEMENT ---------------------------------------------- */
 
 void          OS_Pend                   (OS_PEND_OBJ           *p_obj,
@@ -2163,7 +2802,12 @@ void          OS_SchedLockTimeMeasStop  (void);
 #endif
 
 #if (OS_CFG_SCHED_ROUND_ROBIN_EN == DEF_ENABLED)
-void          OS_SchedRoundRobin        (OS_RDY_LIST           *p_rdy_list);
+void          OS_SchedRoundRobin        (OS_RDY_LIST           *p_rdy_list,
+                                         OS_TICK                ticks);
+
+#if (OS_CFG_DYN_TICK_EN == DEF_ENABLED)
+void          OS_SchedRoundRobinArm     (OS_TCB                *p_tcb);
+#endif
 #endif
 
 /* --------------------------------------------- READY LIST MANAGEMENT ---------------------------------------------- */
@@ -2192,10 +2836,16 @@ void          OS_PendDbgNameRemove      (OS_PEND_OBJ           *p_obj,
 
 void          OS_PendListInit           (OS_PEND_LIST          *p_pend_list);
 
+#if (OS_PEND_LIST_IDX_EN == DEF_ENABLED)
+void          OS_PendListIdxInit        (OS_PEND_LIST          *p_pend_list,
+                                         OS_PEND_LIST_IDX      *p_idx);
+#endif
+
 void          OS_PendListInsertPrio     (OS_PEND_LIST          *p_pend_list,
                                          OS_TCB                *p_tcb);
 
-void          OS_PendListChangePrio     (OS_TCB                *p_tcb);
+void          OS_PendListChangePrio     (OS_TCB                *p_tcb,
+                                         OS_PRIO                prio_new);
 
 void          OS_PendListRemove         (OS_TCB                *p_tcb);
 
@@ -2213,12 +2863,40 @@ void          OS_TickListInsertDly      (OS_TCB                *p_tcb,
 void          OS_TickListRemove         (OS_TCB                *p_tcb);
 
 #if (OS_CFG_DYN_TICK_EN == DEF_ENABLED)
+OS_TICK       OS_TickListNextGet        (OS_TICK_LIST          *p_list);
+
+void          OS_TickArm                (OS_TICK                ticks);
+
 OS_TICK       BSP_OS_TickGet            (void);
 
 OS_TICK       BSP_OS_TickNextSet        (OS_TICK                ticks);
 #endif
 #endif
 
+/* -------------------------------------------------- TIMING WHEEL -------------------------------------------------- */
+#if (OS_WHEEL_EN == DEF_ENABLED)
+void          OS_WheelInit              (OS_WHEEL              *p_wheel,
+                                         OS_TICK                now);
+
+void          OS_WheelInsert            (OS_WHEEL              *p_wheel,
+                                         OS_WHEEL_NODE         *p_node,
+                                         void                  *p_obj,
+                                         OS_TICK                time);
+
+void          OS_WheelRemove            (OS_WHEEL              *p_wheel,
+                                         OS_WHEEL_NODE         *p_node);
+
+OS_TICK       OS_WheelStep              (OS_WHEEL              *p_wheel,
+                                         OS_TICK                ticks);
+
+void          OS_WheelAdvance           (OS_WHEEL              *p_wheel,
+                                         OS_TICK                ticks);
+
+OS_WHEEL_NODE *OS_WheelDueGet           (OS_WHEEL              *p_wheel);
+
+OS_TICK       OS_WheelNextGet           (OS_WHEEL              *p_wheel);
+#endif
+
 
 /*
 ************************************************************************************************************************
@@ -2267,6 +2945,21 @@ OS_TICK       BSP_OS_TickNextSet        (OS_TICK                ticks);
 #error  "OS_CFG.H,         OS_CFG_PRIO_MAX must be >= 8"
 #endif
 
+#if    (OS_CFG_ISR_POST_DEFERRED_EN == DEF_ENABLED)
+    #if    (OS_CFG_INT_Q_SIZE < 2u) || ((OS_CFG_INT_Q_SIZE & (OS_CFG_INT_Q_SIZE - 1u)) != 0u)
+    #error  "OS_CFG_APP.H,     OS_CFG_INT_Q_SIZE must be a power of 2, and 2 or more"
+    #endif
+#endif
+
+#if     OS_CFG_PRIO_MAX > (DEF_INT_CPU_NBR_BITS * DEF_INT_CPU_NBR_BITS)
+#error  "OS_CFG.H,         OS_CFG_PRIO_MAX must be <= DEF_INT_CPU_NBR_BITS squared (one OSPrioGrp bit per OSPrioTbl[] entry)"
+#endif
+
+#if    (OS_PEND_LIST_IDX_EN == DEF_ENABLED) && \
+      ((OS_CFG_PEND_IDX_PRIO_MAX < 1u) || (OS_CFG_PEND_IDX_PRIO_MAX > OS_CFG_PRIO_MAX))
+#error  "OS_CFG.H,         OS_CFG_PEND_IDX_PRIO_MAX must be >= 1 and <= OS_CFG_PRIO_MAX"
+#endif
+
 
 #ifndef OS_CFG_SCHED_LOCK_TIME_MEAS_EN
 #error  "OS_CFG.H, Missing OS_CFG_SCHED_LOCK_TIME_MEAS_EN: Include code to measure scheduler lock time"
@@ -2328,6 +3021,18 @@ OS_TICK       BSP_OS_TickNextSet        (OS_TICK                ticks);
 #error  "OS_CFG.H, Missing OS_CFG_MEM_EN: Enable (1) or Disable (0) code generation for MEMORY MANAGER"
 #endif
 
+#if    (OS_CFG_MEM_REF_EN == DEF_ENABLED) && (OS_CFG_MEM_EN == DEF_DISABLED)
+#error  "OS_CFG.H, OS_CFG_MEM_REF_EN requires OS_CFG_MEM_EN to be enabled"
+#endif
+
+#if    (OS_CFG_MEM_LOCK_FREE_EN == DEF_ENABLED) && (OS_CFG_MEM_EN == DEF_DISABLED)
+#error  "OS_CFG.H, OS_CFG_MEM_LOCK_FREE_EN requires OS_CFG_MEM_EN to be enabled"
+#endif
+
+#if    (OS_CFG_MEM_SLAB_EN == DEF_ENABLED) && (OS_CFG_MEM_EN == DEF_DISABLED)
+#error  "OS_CFG.H, OS_CFG_MEM_SLAB_EN requires OS_CFG_MEM_EN to be enabled"
+#endif
+
 /*
 ************************************************************************************************************************
 *                                              MUTUAL EXCLUSION SEMAPHORES
@@ -2429,6 +3134,42 @@ OS_TICK       BSP_OS_TickNextSet        (OS_TICK                ticks);
 #endif
 #endif
 
+#if    (OS_CFG_PROF_EN == DEF_ENABLED) && \
+      ((OS_CFG_TASK_PROFILE_EN == DEF_DISABLED) || (OS_CFG_TS_EN == DEF_DISABLED) || (OS_CFG_DBG_EN == DEF_DISABLED))
+#error  "OS_CFG.H, OS_CFG_PROF_EN requires OS_CFG_TASK_PROFILE_EN, OS_CFG_TS_EN and OS_CFG_DBG_EN to be enabled"
+#endif
+
+#if    (OS_CFG_PROF_EN == DEF_ENABLED) && (CPU_CFG_TS_TMR_EN == DEF_DISABLED)
+#error  "CPU_CFG.H, OS_CFG_PROF_EN requires a timestamp timer, enable CPU_CFG_TS_32_EN"
+#endif
+
+#if    (OS_CFG_STK_GUARD_EN == DEF_ENABLED) && \
+       (OS_CFG_DBG_EN == DEF_DISABLED) && (OS_CFG_STAT_TASK_STK_CHK_EN == DEF_DISABLED)
+#error  "OS_CFG.H, OS_CFG_STK_GUARD_EN requires OS_CFG_DBG_EN or OS_CFG_STAT_TASK_STK_CHK_EN to be enabled"
+#endif
+
+#if    (OS_CFG_STK_GUARD_EN == DEF_ENABLED) && (CPU_CFG_STK_GROWTH != CPU_STK_GROWTH_HI_TO_LO)
+#error  "CPU.H, OS_CFG_STK_GUARD_EN requires a stack that grows from high to low memory"
+#endif
+
+#if    (OS_CFG_TASK_BUDGET_EN == DEF_ENABLED) && \
+      ((OS_CFG_TS_EN == DEF_DISABLED) || (OS_CFG_TASK_TICK_EN == DEF_DISABLED))
+#error  "OS_CFG.H, OS_CFG_TASK_BUDGET_EN requires OS_CFG_TS_EN and OS_CFG_TASK_TICK_EN to be enabled"
+#endif
+
+#if    (OS_CFG_TASK_BUDGET_EN == DEF_ENABLED) && (CPU_CFG_TS_TMR_EN == DEF_DISABLED)
+#error  "CPU_CFG.H, OS_CFG_TASK_BUDGET_EN requires a timestamp timer, enable CPU_CFG_TS_32_EN"
+#endif
+
+#if    (OS_CFG_TASK_BUDGET_EN == DEF_ENABLED) && \
+      ((OS_CFG_TASK_BUDGET_REPL_MAX < 1u) || (OS_CFG_TASK_BUDGET_REPL_MAX > 255u))
+#error  "OS_CFG.H, OS_CFG_TASK_BUDGET_REPL_MAX must be between 1 and 255"
+#endif
+
+#if    (OS_CFG_EDF_EN == DEF_ENABLED) && (OS_CFG_TASK_TICK_EN == DEF_DISABLED)
+#error  "OS_CFG.H, OS_CFG_EDF_EN requires OS_CFG_TASK_TICK_EN to be enabled"
+#endif
+
 #ifndef OS_CFG_TASK_REG_TBL_SIZE
 #error  "OS_CFG.H, Missing OS_CFG_TASK_REG_TBL_SIZE: Include support for task specific registers"
 #endif
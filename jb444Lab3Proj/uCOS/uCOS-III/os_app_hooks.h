@@ -67,6 +67,10 @@ void  App_OS_IdleTaskHook  (void);
 void  App_OS_RedzoneHitHook(OS_TCB  *p_tcb);
 #endif
 
+#if (OS_CFG_STK_GUARD_EN == DEF_ENABLED)
+void  App_OS_StkGuardHitHook(OS_TCB  *p_tcb);
+#endif
+
 void  App_OS_StatTaskHook  (void);
 
 void  App_OS_TaskCreateHook(OS_TCB  *p_tcb);
@@ -79,4 +83,15 @@ void  App_OS_TaskSwHook    (void);
 
 void  App_OS_TimeTickHook  (void);
 
+/*
+************************************************************************************************************************
+*                                                  GLOBAL VARIABLES
+************************************************************************************************************************
+*/
+
+#if (OS_CFG_PROF_EN == DEF_ENABLED)
+extern  CPU_INT08U  App_OS_ProfRec[];                           /* Last OSProfSnapshot() record, for the debugger       */
+extern  CPU_SIZE_T  App_OS_ProfRecLen;                          /* Its length in bytes, 0 if the snapshot failed        */
+#endif
+
 #endif
@@ -0,0 +1,723 @@
+/*
+************************************************************************************************************************
+*                                                   TASK CPU BUDGETS
+*                          A uC/OS-III V3.06.01 addition for jb444Lab3Proj, not Micrium code
+*
+* File    : OS_BUDGET.C
+************************************************************************************************************************
+* Note(s) : (1) A task given a budget by OSTaskBudgetSet() runs at its own priority for at most 'budget' ticks of CPU
+*               time in any 'period' ticks.  When the budget is used up the task drops to 'prio_low', where it only
+*               gets the CPU left over by the tasks above it, until the budget is given back.
+*
+*           (2) The budget is given back as a sporadic server would.  The task becomes active when it is switched in
+*               at its own priority, and stays active until it blocks or its budget runs out.  What it used while
+*               active is given back 'period' ticks after it became active, so the task can never take more than
+*               'budget' in any window of 'period' ticks, whatever its pattern of releases.  Each task holds up to
+*               OS_CFG_TASK_BUDGET_REPL_MAX pending replenishments.  With no room left, the last one is pushed back
+*               to the later time, which only delays it.
+*
+*           (3) Time is charged in OS_TS_GET() counts, at every task switch and every tick.  An ISR is charged to the
+*               task it interrupted.  A task can only be stopped at a tick, so at a tick a budget with less than half
+*               a tick left counts as used up, and the task is stopped at the tick nearest to where it runs out.  With
+*               the dynamic tick, that tick is armed when the task is switched in.
+*
+*           (4) OSTaskBudgetSet() only admits a budget if the budgeted tasks together stay under the rate-monotonic
+*               bound n(2^(1/n) - 1).  The budgeted tasks are then schedulable at their own priorities if those are
+*               in the order of their periods and above every other task that has a deadline.
+************************************************************************************************************************
+*/
+
+#define  MICRIUM_SOURCE
+#include "os.h"
+
+#ifdef VSC_INCLUDE_SOURCE_FILE_NAMES
+const  CPU_CHAR  *os_budget__c = "$Id: $";
+#endif
+
+
+#if (OS_CFG_TASK_BUDGET_EN == DEF_ENABLED)
+
+/*
+************************************************************************************************************************
+*                                                   LOCAL CONSTANTS
+************************************************************************************************************************
+*/
+
+                                                                /* n(2^(1/n) - 1) in 0.01% units for n = 1 to 10, ...   */
+static  const  CPU_INT16U  OS_BudgetUtilBound[] = {             /* ... then ln(2) for any larger n                      */
+    10000u, 8284u, 7797u, 7568u, 7434u, 7347u, 7286u, 7240u, 7205u, 7177u, 6931u
+};
+
+
+/*
+************************************************************************************************************************
+*                                                   LOCAL FUNCTIONS
+************************************************************************************************************************
+*/
+
+static  CPU_INT16U  OS_BudgetUtilGet   (OS_TICK        budget,
+                                        OS_TICK        period);
+
+static  OS_TICK     OS_BudgetNow       (void);
+
+static  void        OS_BudgetCharge    (OS_TCB        *p_tcb,
+                                        CPU_TS         ts,
+                                        CPU_TS         slack);
+
+static  void        OS_BudgetPrioSet   (OS_TCB        *p_tcb,
+                                        OS_PRIO        prio);
+
+static  void        OS_BudgetReplPost  (OS_TCB        *p_tcb);
+
+static  void        OS_BudgetReplApply (OS_TCB        *p_tcb,
+                                        OS_TICK        now);
+
+static  void        OS_BudgetUnlink    (OS_TCB        *p_tcb);
+
+
+/*
+************************************************************************************************************************
+*                                                SET A TASK'S CPU BUDGET
+*
+* Description: This function gives a task a CPU budget, changes it or removes it.  See Note #1 at the top of the file.
+*
+* Arguments  : p_tcb      is a pointer to the task's OS_TCB, or NULL for the calling task.
+*
+*              budget     is the number of ticks of CPU time the task may use at its priority per 'period', or 0 to
+*                         remove the budget and put the task back at its own priority.
+*
+*              period     is the replenishment period in ticks.
+*
+*              prio_low   is the priority the task runs at once its budget is used up.  It must be lower (a larger
+*                         number) than the task's priority.
+*
+*              p_err      is a pointer to a variable that will contain an error code returned by this function.
+*
+*                             OS_ERR_NONE               The budget was set
+*                             OS_ERR_BUDGET_ADMIT       The budgeted tasks would no longer be schedulable (Note #4)
+*                             OS_ERR_BUDGET_INVALID     'budget' is more than 'period', or too long to count in
+*                                                       OS_TS_GET() counts
+*                             OS_ERR_BUDGET_ISR         You called this function from an ISR
+*                             OS_ERR_OS_NOT_RUNNING     'p_tcb' is NULL and uC/OS-III is not running yet
+*                             OS_ERR_PRIO_INVALID       'prio_low' is not below the task's priority, or is the idle
+*                                                       task's priority
+*                             OS_ERR_STATE_INVALID      The task was deleted
+*
+* Returns    : none
+*
+* Note(s)    : 1) The new budget starts full.  Pending replenishments and the time used so far are dropped.
+*
+*              2) While the task has a budget, OSTaskChangePrio() changes the priority it runs at with budget left.
+************************************************************************************************************************
+*/
+
+void  OSTaskBudgetSet (OS_TCB   *p_tcb,
+                       OS_TICK   budget,
+                       OS_TICK   period,
+                       OS_PRIO   prio_low,
+                       OS_ERR   *p_err)
+{
+    CPU_TS_TMR_FREQ  freq;
+    CPU_ERR          cpu_err;
+    CPU_TS           cnts;
+    CPU_INT16U       util;
+    CPU_INT16U       util_bound;
+    OS_OBJ_QTY       qty;
+    CPU_SR_ALLOC();
+
+
+#ifdef OS_SAFETY_CRITICAL
+    if (p_err == (OS_ERR *)0) {
+        OS_SAFETY_CRITICAL_EXCEPTION();
+        return;
+    }
+#endif
+
+#if (OS_CFG_CALLED_FROM_ISR_CHK_EN == DEF_ENABLED)
+    if (OSIntNestingCtr > 0u) {                                 /* Not allowed to call from an ISR                      */
+       *p_err = OS_ERR_BUDGET_ISR;
+        return;
+    }
+#endif
+
+#if (OS_CFG_ARG_CHK_EN == DEF_ENABLED)
+    if ((p_tcb != (OS_TCB *)0) && (p_tcb->TaskState == OS_TASK_STATE_DEL)) {
+       *p_err = OS_ERR_STATE_INVALID;
+        return;
+    }
+#endif
+
+    cnts = 0u;
+    util = 0u;
+    if (budget > 0u) {
+        if (budget > period) {
+           *p_err = OS_ERR_BUDGET_INVALID;
+            return;
+        }
+        freq = CPU_TS_TmrFreqGet(&cpu_err);
+        cnts = (CPU_TS)(freq / OSCfg_TickRate_Hz);              /* OS_TS_GET() counts per tick                          */
+        if ((cnts == 0u) ||
+            (budget > ((CPU_TS)-1 / cnts))) {                   /* Budget must fit in a CPU_TS                          */
+           *p_err = OS_ERR_BUDGET_INVALID;
+            return;
+        }
+        if (prio_low >= (OS_CFG_PRIO_MAX - 1u)) {               /* Cannot run at the Idle Task priority                 */
+           *p_err = OS_ERR_PRIO_INVALID;
+            return;
+        }
+        util = OS_BudgetUtilGet(budget, period);
+    }
+
+    CPU_CRITICAL_ENTER();
+
+    if (p_tcb == (OS_TCB *)0) {                                 /* Setting the budget of 'self'?                        */
+        if (OSRunning != OS_STATE_OS_RUNNING) {
+            CPU_CRITICAL_EXIT();
+           *p_err = OS_ERR_OS_NOT_RUNNING;
+            return;
+        }
+        p_tcb = OSTCBCurPtr;
+    }
+
+    if (budget > 0u) {
+        if (p_tcb->Budget == 0u) {                              /* Task's own priority is not yet saved                 */
+#if (OS_CFG_MUTEX_EN == DEF_ENABLED)
+            p_tcb->BudgetPrio = p_tcb->BasePrio;
+#else
+            p_tcb->BudgetPrio = p_tcb->Prio;
+#endif
+        }
+        if (prio_low <= p_tcb->BudgetPrio) {
+            CPU_CRITICAL_EXIT();
+           *p_err = OS_ERR_PRIO_INVALID;
+            return;
+        }
+
+        qty = OSBudgetQty;                                      /* Admission control, see Note #4                       */
+        if (p_tcb->Budget == 0u) {
+            qty++;
+        }
+        if (qty > (sizeof(OS_BudgetUtilBound) / sizeof(OS_BudgetUtilBound[0]))) {
+            qty = (OS_OBJ_QTY)(sizeof(OS_BudgetUtilBound) / sizeof(OS_BudgetUtilBound[0]));
+        }
+        util_bound = OS_BudgetUtilBound[qty - 1u];
+        util += OSBudgetUtil;
+        if (p_tcb->Budget > 0u) {
+            util -= OS_BudgetUtilGet(p_tcb->Budget, p_tcb->BudgetPeriod);
+        }
+        if (util > util_bound) {
+            CPU_CRITICAL_EXIT();
+           *p_err = OS_ERR_BUDGET_ADMIT;
+            return;
+        }
+
+        if (p_tcb->Budget == 0u) {                              /* Add the task to the list of budgeted tasks           */
+            p_tcb->BudgetNextPtr = OSBudgetListPtr;
+            OSBudgetListPtr      = p_tcb;
+            OSBudgetQty++;
+        }
+        OSBudgetUtil            = util;
+        OSBudgetTickCnts        = cnts;
+
+        p_tcb->Budget           = budget;
+        p_tcb->BudgetPeriod     = period;
+        p_tcb->BudgetPrioLow    = prio_low;
+        p_tcb->BudgetRem        = (CPU_TS)budget * cnts;        /* See Note #1                                          */
+        p_tcb->BudgetUsed       = 0u;
+        p_tcb->BudgetTS         = OS_TS_GET();
+        p_tcb->BudgetActTime    = OS_BudgetNow();
+        p_tcb->BudgetActive     = (p_tcb == OSTCBCurPtr) ? DEF_TRUE : DEF_FALSE;
+        p_tcb->BudgetReplIx     = 0u;
+        p_tcb->BudgetReplNbr    = 0u;
+        OS_BudgetPrioSet(p_tcb, p_tcb->BudgetPrio);             /* Run at its own priority with a full budget           */
+    } else if (p_tcb->Budget > 0u) {
+        OS_BudgetUnlink(p_tcb);
+        OS_BudgetPrioSet(p_tcb, p_tcb->BudgetPrio);             /* Back to its own priority for good                    */
+    }
+    CPU_CRITICAL_EXIT();
+
+    if (OSRunning == OS_STATE_OS_RUNNING) {
+        OSSched();                                              /* Run highest priority task ready                      */
+    }
+
+   *p_err = OS_ERR_NONE;
+}
+
+
+/*
+************************************************************************************************************************
+*                                              INITIALIZE THE CPU BUDGETS
+*
+* Description: This function is called by OSInit() to empty the list of budgeted tasks.
+*
+* Arguments  : none
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application MUST NOT call it.
+************************************************************************************************************************
+*/
+
+void  OS_BudgetInit (void)
+{
+    OSBudgetListPtr  = (OS_TCB *)0;
+    OSBudgetQty      = 0u;
+    OSBudgetUtil     = 0u;
+    OSBudgetTickCnts = 0u;
+}
+
+
+/*
+************************************************************************************************************************
+*                                            REMOVE A DELETED TASK'S BUDGET
+*
+* Description: This function is called by OSTaskDel() to take the task off the list of budgeted tasks.
+*
+* Arguments  : p_tcb      is a pointer to the OS_TCB of the task being deleted.
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application MUST NOT call it.
+*
+*              2) This function is assumed to be called with interrupts disabled.
+************************************************************************************************************************
+*/
+
+void  OS_BudgetTaskDel (OS_TCB  *p_tcb)
+{
+    if (p_tcb->Budget > 0u) {
+        OS_BudgetUnlink(p_tcb);
+    }
+}
+
+
+/*
+************************************************************************************************************************
+*                                             CHARGE THE CPU BUDGETS AT A SWITCH
+*
+* Description: This function is called by OSTaskSwHook().  It charges the task being switched out for the time it ran,
+*              ends its activation if it blocked, and starts the clock of the task being switched in.
+*
+* Arguments  : none
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application MUST NOT call it.
+*
+*              2) This function is called with interrupts disabled.
+************************************************************************************************************************
+*/
+
+void  OS_BudgetTaskSw (void)
+{
+    OS_TCB  *p_tcb;
+    CPU_TS   ts;
+#if (OS_CFG_DYN_TICK_EN == DEF_ENABLED)
+    OS_TICK  ticks;
+#endif
+
+
+    if (OSBudgetListPtr == (OS_TCB *)0) {
+        return;
+    }
+
+    ts    = OS_TS_GET();
+    p_tcb = OSTCBCurPtr;
+    if ((p_tcb        != OSTCBHighRdyPtr) &&                    /* Not the first switch, from OSStart()                 */
+        (p_tcb->Budget > 0u)) {
+        OS_BudgetCharge(p_tcb, ts, 0u);
+        if ((p_tcb->BudgetActive == DEF_TRUE) &&
+            (p_tcb->TaskState    != OS_TASK_STATE_RDY)) {       /* Blocked, its activation ends (see Note #2 at top)    */
+            OS_BudgetReplPost(p_tcb);
+        }
+    }
+
+    p_tcb = OSTCBHighRdyPtr;
+    if (p_tcb->Budget > 0u) {
+        p_tcb->BudgetTS = ts;
+        if (p_tcb->BudgetRem > 0u) {
+            if (p_tcb->BudgetActive == DEF_FALSE) {
+                p_tcb->BudgetActive  = DEF_TRUE;
+                p_tcb->BudgetActTime = OS_BudgetNow();
+            }
+#if (OS_CFG_DYN_TICK_EN == DEF_ENABLED)
+            ticks = (OS_TICK)(p_tcb->BudgetRem / OSBudgetTickCnts);
+            if ((p_tcb->BudgetRem % OSBudgetTickCnts) >= (OSBudgetTickCnts / 2u)) {
+                ticks++;                                        /* Nearest tick to where it runs out (Note #3 at top)   */
+            }
+            OS_TickArm(ticks);
+#endif
+        }
+    }
+}
+
+
+/*
+************************************************************************************************************************
+*                                            CHARGE THE CPU BUDGETS AT A TICK
+*
+* Description: This function is called by OSTimeTick() and OSTimeDynTick().  It charges the running task for the time
+*              it ran and gives back the replenishments that are due.
+*
+* Arguments  : none
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application MUST NOT call it.
+*
+*              2) A task that runs out of budget is demoted here, and OSIntExit() switches to whatever is then the
+*                 highest priority task ready.
+************************************************************************************************************************
+*/
+
+void  OS_BudgetTick (void)
+{
+    OS_TCB  *p_tcb;
+    OS_TICK  now;
+    CPU_SR_ALLOC();
+
+
+    if (OSBudgetListPtr == (OS_TCB *)0) {
+        return;
+    }
+
+    CPU_CRITICAL_ENTER();
+    if (OSTCBCurPtr->Budget > 0u) {
+        OS_BudgetCharge(OSTCBCurPtr, OS_TS_GET(), OSBudgetTickCnts / 2u);
+    }
+
+#if (OS_CFG_DYN_TICK_EN == DEF_ENABLED)
+    now   = OS_BudgetNow();
+#else
+    now   = OSTickCtr + 1u;                                     /* This tick, the tick task has yet to count it         */
+#endif
+    p_tcb = OSBudgetListPtr;
+    while (p_tcb != (OS_TCB *)0) {
+        OS_BudgetReplApply(p_tcb, now);
+        p_tcb = p_tcb->BudgetNextPtr;
+    }
+    CPU_CRITICAL_EXIT();
+}
+
+
+/*
+************************************************************************************************************************
+*                                           TICKS TO THE NEXT REPLENISHMENT
+*
+* Description: This function returns the number of ticks from OSTickCtr until the first pending replenishment is due,
+*              so the tick task can program the next tick for it.
+*
+* Arguments  : none
+*
+* Returns    : the number of ticks, or (OS_TICK)-1 if no replenishment is pending.
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application MUST NOT call it.
+*
+*              2) This function is assumed to be called with interrupts disabled.
+*
+*              3) Replenishments are posted in the order they are due, so the oldest of each task is its first.
+************************************************************************************************************************
+*/
+
+#if (OS_CFG_DYN_TICK_EN == DEF_ENABLED)
+OS_TICK  OS_BudgetTickNextGet (void)
+{
+    OS_TCB   *p_tcb;
+    OS_TICK   ticks;
+    OS_TICK   ticks_min;
+
+
+    ticks_min = (OS_TICK)-1;
+    p_tcb     = OSBudgetListPtr;
+    while (p_tcb != (OS_TCB *)0) {
+        if (p_tcb->BudgetReplNbr > 0u) {                        /* See Note #3                                          */
+            ticks = (OS_TICK)(p_tcb->BudgetReplTime[p_tcb->BudgetReplIx] - OSTickCtr);
+            if ((ticks == 0u) || (ticks > ((OS_TICK)-1 / 2u))) {
+                ticks = 1u;                                     /* Already due                                          */
+            }
+            if (ticks_min > ticks) {
+                ticks_min = ticks;
+            }
+        }
+        p_tcb = p_tcb->BudgetNextPtr;
+    }
+    return (ticks_min);
+}
+#endif
+
+
+/*
+************************************************************************************************************************
+*                                          UTILIZATION OF A BUDGET, 0.01% UNITS
+*
+* Description: This function returns budget / period in 0.01% units, rounded up.
+*
+* Arguments  : budget     is the budget in ticks.
+*
+*              period     is the period in ticks, not less than 'budget'.
+*
+* Returns    : The utilization, 1 to 10000.
+************************************************************************************************************************
+*/
+
+static  CPU_INT16U  OS_BudgetUtilGet (OS_TICK  budget,
+                                      OS_TICK  period)
+{
+    CPU_INT32U  util;
+
+
+    if (budget > ((CPU_INT32U)-1 / 10000u)) {                   /* Scale both down rather than overflow                 */
+        budget = budget / 10000u + 1u;
+        period = period / 10000u + 1u;
+    }
+    util = ((CPU_INT32U)budget * 10000u + (period - 1u)) / period;
+    if (util > 10000u) {
+        util = 10000u;
+    }
+    return ((CPU_INT16U)util);
+}
+
+
+/*
+************************************************************************************************************************
+*                                                  CURRENT TICK COUNT
+*
+* Description: This function returns the tick count that activations and replenishments are timed against.
+*
+* Arguments  : none
+*
+* Returns    : The current tick.
+*
+* Note(s)    : 1) With the dynamic tick, OSTickCtr lags until the tick task runs, so the BSP is asked instead.
+************************************************************************************************************************
+*/
+
+static  OS_TICK  OS_BudgetNow (void)
+{
+#if (OS_CFG_DYN_TICK_EN == DEF_ENABLED)
+    return (BSP_OS_TickGet());                                  /* See Note #1                                          */
+#else
+    return (OSTickCtr);
+#endif
+}
+
+
+/*
+************************************************************************************************************************
+*                                                  CHARGE A TASK
+*
+* Description: This function charges a task for the time since its .BudgetTS and demotes it if its budget runs out.
+*
+* Arguments  : p_tcb      is a pointer to the OS_TCB of a budgeted task.
+*
+*              ts         is the current OS_TS_GET() value.
+*
+*              slack      is the budget left under which it counts as used up (see Note #3 at the top of the file).
+*
+* Returns    : none
+*
+* Note(s)    : 1) A demoted task is not charged, it runs on what the tasks above it leave.
+*
+*              2) The slack given up is charged as used, so it is replenished with the rest.
+************************************************************************************************************************
+*/
+
+static  void  OS_BudgetCharge (OS_TCB  *p_tcb,
+                               CPU_TS   ts,
+                               CPU_TS   slack)
+{
+    CPU_TS  delta;
+
+
+    delta           = ts - p_tcb->BudgetTS;
+    p_tcb->BudgetTS = ts;
+    if (p_tcb->BudgetRem == 0u) {                               /* See Note #1                                          */
+        return;
+    }
+
+    if ((delta         <  p_tcb->BudgetRem) &&
+        ((p_tcb->BudgetRem - delta) > slack)) {
+        p_tcb->BudgetRem  -= delta;
+        p_tcb->BudgetUsed += delta;
+        return;
+    }
+
+    p_tcb->BudgetUsed += p_tcb->BudgetRem;                      /* Budget used up, see Note #2                          */
+    p_tcb->BudgetRem   = 0u;
+    p_tcb->BudgetOverrunCtr++;
+    OS_BudgetReplPost(p_tcb);
+    OS_BudgetPrioSet(p_tcb, p_tcb->BudgetPrioLow);
+    if ((p_tcb             == OSTCBCurPtr) &&
+        (p_tcb->TaskState  == OS_TASK_STATE_RDY) &&
+        (p_tcb->Prio       == p_tcb->BudgetPrioLow)) {          /* Let its peers at the lower priority go first         */
+        OS_RdyListMoveHeadToTail(&OSRdyList[p_tcb->Prio]);
+    }
+}
+
+
+/*
+************************************************************************************************************************
+*                                              CHANGE A BUDGETED TASK'S PRIORITY
+*
+* Description: This function moves a task to 'prio', or higher if it owns a mutex a higher priority task waits on.
+*
+* Arguments  : p_tcb      is a pointer to the task's OS_TCB.
+*
+*              prio       is the priority to give the task.
+*
+* Returns    : none
+************************************************************************************************************************
+*/
+
+static  void  OS_BudgetPrioSet (OS_TCB   *p_tcb,
+                                OS_PRIO   prio)
+{
+#if (OS_CFG_MUTEX_EN == DEF_ENABLED)
+    OS_PRIO  prio_high;
+
+
+    p_tcb->BasePrio = prio;                                     /* Where OSMutexPost() puts the task back               */
+    if (p_tcb->MutexGrpHeadPtr != (OS_MUTEX *)0) {              /* Keep any priority it inherited                       */
+        prio_high = OS_MutexGrpPrioFindHighest(p_tcb);
+        if (prio > prio_high) {
+            prio = prio_high;
+        }
+    }
+#endif
+
+    if (p_tcb->Prio != prio) {
+        OS_TaskChangePrio(p_tcb, prio);
+        OS_TRACE_TASK_PRIO_CHANGE(p_tcb, prio);
+    }
+}
+
+
+/*
+************************************************************************************************************************
+*                                               POST A REPLENISHMENT
+*
+* Description: This function ends a task's activation and schedules the time it used to be given back one period after
+*              the activation began.
+*
+* Arguments  : p_tcb      is a pointer to the OS_TCB of a budgeted task.
+*
+* Returns    : none
+*
+* Note(s)    : 1) With no room left, the time is added to the last replenishment, which is moved to the later time.
+************************************************************************************************************************
+*/
+
+static  void  OS_BudgetReplPost (OS_TCB  *p_tcb)
+{
+    OS_TICK     time;
+    CPU_INT08U  ix;
+
+
+    p_tcb->BudgetActive = DEF_FALSE;
+    if (p_tcb->BudgetUsed == 0u) {
+        return;
+    }
+
+    time = p_tcb->BudgetActTime + p_tcb->BudgetPeriod;
+    if (p_tcb->BudgetReplNbr < OS_CFG_TASK_BUDGET_REPL_MAX) {
+        ix = (CPU_INT08U)((p_tcb->BudgetReplIx + p_tcb->BudgetReplNbr) % OS_CFG_TASK_BUDGET_REPL_MAX);
+        p_tcb->BudgetReplAmt[ix] = 0u;
+        p_tcb->BudgetReplNbr++;
+    } else {                                                    /* See Note #1                                          */
+        ix = (CPU_INT08U)((p_tcb->BudgetReplIx + OS_CFG_TASK_BUDGET_REPL_MAX - 1u) % OS_CFG_TASK_BUDGET_REPL_MAX);
+    }
+    p_tcb->BudgetReplTime[ix]  = time;
+    p_tcb->BudgetReplAmt[ix]  += p_tcb->BudgetUsed;
+    p_tcb->BudgetUsed          = 0u;
+
+#if (OS_CFG_DYN_TICK_EN == DEF_ENABLED)
+    OS_TickArm((OS_TICK)(time - OS_BudgetNow()));               /* Tick when it is due                                  */
+#endif
+}
+
+
+/*
+************************************************************************************************************************
+*                                             APPLY DUE REPLENISHMENTS
+*
+* Description: This function gives a task back the replenishments that are due, and puts it back at its own priority
+*              if it was demoted.
+*
+* Arguments  : p_tcb      is a pointer to the OS_TCB of a budgeted task.
+*
+*              now        is the current tick.
+*
+* Returns    : none
+************************************************************************************************************************
+*/
+
+static  void  OS_BudgetReplApply (OS_TCB   *p_tcb,
+                                  OS_TICK   now)
+{
+    CPU_TS      rem;
+    CPU_TS      rem_max;
+    CPU_INT08U  ix;
+
+
+    rem     = p_tcb->BudgetRem;
+    rem_max = (CPU_TS)p_tcb->Budget * OSBudgetTickCnts;
+    while (p_tcb->BudgetReplNbr > 0u) {
+        ix = p_tcb->BudgetReplIx;
+        if ((OS_TICK)(now - p_tcb->BudgetReplTime[ix]) > ((OS_TICK)-1 / 2u)) {
+            break;                                              /* Not due yet                                          */
+        }
+        if (p_tcb->BudgetReplAmt[ix] < (rem_max - p_tcb->BudgetRem)) {
+            p_tcb->BudgetRem += p_tcb->BudgetReplAmt[ix];
+        } else {
+            p_tcb->BudgetRem  = rem_max;
+        }
+        p_tcb->BudgetReplIx = (CPU_INT08U)((ix + 1u) % OS_CFG_TASK_BUDGET_REPL_MAX);
+        p_tcb->BudgetReplNbr--;
+    }
+
+    if ((rem == 0u) && (p_tcb->BudgetRem > 0u)) {               /* Budget is back, so is the task's priority            */
+        p_tcb->BudgetTS = OS_TS_GET();
+        if (p_tcb == OSTCBCurPtr) {
+            p_tcb->BudgetActive  = DEF_TRUE;
+            p_tcb->BudgetActTime = now;
+        }
+        OS_BudgetPrioSet(p_tcb, p_tcb->BudgetPrio);
+    }
+}
+
+
+/*
+************************************************************************************************************************
+*                                            TAKE A TASK OFF THE BUDGET LIST
+*
+* Description: This function removes a task from the list of budgeted tasks and clears its budget.  The caller puts
+*              the task back at its own priority.
+*
+* Arguments  : p_tcb      is a pointer to the OS_TCB of a budgeted task.
+*
+* Returns    : none
+************************************************************************************************************************
+*/
+
+static  void  OS_BudgetUnlink (OS_TCB  *p_tcb)
+{
+    OS_TCB  **pp_tcb;
+
+
+    pp_tcb = &OSBudgetListPtr;
+    while (*pp_tcb != p_tcb) {
+        pp_tcb = &(*pp_tcb)->BudgetNextPtr;
+    }
+   *pp_tcb = p_tcb->BudgetNextPtr;
+
+    OSBudgetQty--;
+    OSBudgetUtil         -= OS_BudgetUtilGet(p_tcb->Budget, p_tcb->BudgetPeriod);
+    p_tcb->BudgetNextPtr  = (OS_TCB *)0;
+    p_tcb->Budget         = 0u;
+    p_tcb->BudgetRem      = 0u;
+    p_tcb->BudgetUsed     = 0u;
+    p_tcb->BudgetActive   = DEF_FALSE;
+    p_tcb->BudgetReplNbr  = 0u;
+}
+
+#endif
@@ -209,6 +209,9 @@ CPU_INT32U  const  OSDbg_DataSize = sizeof(OSIntNestingCtr)
 #if (OS_CFG_APP_HOOKS_EN == DEF_ENABLED)
 #if (OS_CFG_TASK_STK_REDZONE_EN == DEF_ENABLED)
                                   + sizeof(OS_AppRedzoneHitHookPtr)
+#endif
+#if (OS_CFG_STK_GUARD_EN == DEF_ENABLED)
+                                  + sizeof(OS_AppStkGuardHitHookPtr)
 #endif
                                   + sizeof(OS_AppTaskCreateHookPtr)
                                   + sizeof(OS_AppTaskDelHookPtr)
@@ -273,6 +276,9 @@ CPU_INT32U  const  OSDbg_DataSize = sizeof(OSIntNestingCtr)
                                   + sizeof(OSPrioCur)
                                   + sizeof(OSPrioHighRdy)
                                   + sizeof(OSPrioTbl)
+#if (OS_CFG_PRIO_MAX > DEF_INT_CPU_NBR_BITS)
+                                  + sizeof(OSPrioGrp)
+#endif
 
 #if (OS_CFG_Q_EN == DEF_ENABLED)
 #if (OS_CFG_DBG_EN == DEF_ENABLED)
@@ -296,6 +302,13 @@ CPU_INT32U  const  OSDbg_DataSize = sizeof(OSIntNestingCtr)
                                   + sizeof(OSSchedRoundRobinEn)
 #endif
 
+#if (OS_CFG_TASK_BUDGET_EN == DEF_ENABLED)
+                                  + sizeof(OSBudgetListPtr)
+                                  + sizeof(OSBudgetQty)
+                                  + sizeof(OSBudgetUtil)
+                                  + sizeof(OSBudgetTickCnts)
+#endif
+
 #if (OS_CFG_SEM_EN == DEF_ENABLED)
 #if (OS_CFG_DBG_EN == DEF_ENABLED)
                                   + sizeof(OSSemDbgListPtr)
@@ -341,7 +354,11 @@ CPU_INT32U  const  OSDbg_DataSize = sizeof(OSIntNestingCtr)
                                   + sizeof(OSTmrDbgListPtr)
                                   + sizeof(OSTmrListEntries)
 #endif
+#if (OS_CFG_TMR_WHEEL_EN == DEF_ENABLED)
+                                  + sizeof(OSTmrWheel)
+#else
                                   + sizeof(OSTmrListPtr)
+#endif
 #if (OS_CFG_MUTEX_EN == DEF_ENABLED)
                                   + sizeof(OSTmrMutex)
 #endif
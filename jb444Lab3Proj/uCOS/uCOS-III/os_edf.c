@@ -0,0 +1,275 @@
+/*
+************************************************************************************************************************
+*                                            EARLIEST DEADLINE FIRST BANDS
+*                          A uC/OS-III V3.06.01 addition for jb444Lab3Proj, not Micrium code
+*
+* File    : OS_EDF.C
+************************************************************************************************************************
+* Note(s) : (1) Tasks given a deadline by OSTaskEdfSet() are kept in deadline order in the ready list of their priority,
+*               instead of first in, first out.  The scheduler still runs the head of the highest priority list, so
+*               among the tasks ready at that priority, the one due first runs first.  A priority holding such tasks
+*               is an EDF band.  The bands stay in fixed priority order with each other and with the other tasks.
+*
+*           (2) A task starts a new job when it is woken by a post to what it pends on, by the end of its delay or
+*               by the timeout of its pend.  The job is due 'deadline' ticks after its release, which is when it was
+*               made ready, but no sooner than 'period' ticks after the release of the job before.  A task that is
+*               woken early so cannot move ahead of the others.  A post to a task that has not left the ready list
+*               yet, such as a second semaphore post, is part of the job under way.  A task made ready any other
+*               way, by OSTaskResume(), OSTimeDlyResume(), a pend abort or the deletion of what it pends on, goes
+*               on with the job it had and keeps its deadline.  If it was woken while suspended, its job is released
+*               when it is resumed.
+*
+*           (3) A job still ready past its deadline is counted in .EdfMissCtr when it leaves the ready list, once
+*               per job.  .EdfJobCtr counts the jobs, so the two give the miss rate.
+*
+*           (4) Round-robin does not rotate a list whose head has a deadline, nor does OSSchedRoundRobinYield().
+*               A band should hold tasks with deadlines only.  A task without one is inserted at the head or the
+*               tail of the list as usual, ahead of or behind all of them.
+************************************************************************************************************************
+*/
+
+#define  MICRIUM_SOURCE
+#include "os.h"
+
+#ifdef VSC_INCLUDE_SOURCE_FILE_NAMES
+const  CPU_CHAR  *os_edf__c = "$Id: $";
+#endif
+
+
+#if (OS_CFG_EDF_EN == DEF_ENABLED)
+
+/*
+************************************************************************************************************************
+*                                                SET A TASK'S DEADLINE
+*
+* Description: This function puts a task in the EDF band of its priority, changes its period and deadline, or takes
+*              it out.  See Note #1 at the top of the file.
+*
+* Arguments  : p_tcb      is a pointer to the task's OS_TCB, or NULL for the calling task.
+*
+*              period     is the least number of ticks between the releases of two jobs, or 0 for no minimum.
+*
+*              deadline   is the number of ticks from the release of a job to its deadline, or 0 to take the task
+*                         out of the band and back to first in, first out order.
+*
+*              p_err      is a pointer to a variable that will contain an error code returned by this function.
+*
+*                             OS_ERR_NONE               The deadline was set
+*                             OS_ERR_EDF_INVALID        'deadline' is more than a non-zero 'period'
+*                             OS_ERR_EDF_ISR            You called this function from an ISR
+*                             OS_ERR_OS_NOT_RUNNING     'p_tcb' is NULL and uC/OS-III is not running yet
+*                             OS_ERR_STATE_INVALID      The task was deleted
+*
+* Returns    : none
+*
+* Note(s)    : 1) A ready task starts a new job at once, released now.
+*
+*              2) Use OSTaskChangePrio() or the task's creation priority to pick the band.
+************************************************************************************************************************
+*/
+
+void  OSTaskEdfSet (OS_TCB   *p_tcb,
+                    OS_TICK   period,
+                    OS_TICK   deadline,
+                    OS_ERR   *p_err)
+{
+    CPU_SR_ALLOC();
+
+
+#ifdef OS_SAFETY_CRITICAL
+    if (p_err == (OS_ERR *)0) {
+        OS_SAFETY_CRITICAL_EXCEPTION();
+        return;
+    }
+#endif
+
+#if (OS_CFG_CALLED_FROM_ISR_CHK_EN == DEF_ENABLED)
+    if (OSIntNestingCtr > 0u) {                                 /* Not allowed to call from an ISR                      */
+       *p_err = OS_ERR_EDF_ISR;
+        return;
+    }
+#endif
+
+#if (OS_CFG_ARG_CHK_EN == DEF_ENABLED)
+    if ((p_tcb != (OS_TCB *)0) && (p_tcb->TaskState == OS_TASK_STATE_DEL)) {
+       *p_err = OS_ERR_STATE_INVALID;
+        return;
+    }
+#endif
+
+    if ((period > 0u) && (deadline > period)) {                 /* Deadlines must be constrained                        */
+       *p_err = OS_ERR_EDF_INVALID;
+        return;
+    }
+
+    CPU_CRITICAL_ENTER();
+
+    if (p_tcb == (OS_TCB *)0) {                                 /* Setting the deadline of 'self'?                      */
+        if (OSRunning != OS_STATE_OS_RUNNING) {
+            CPU_CRITICAL_EXIT();
+           *p_err = OS_ERR_OS_NOT_RUNNING;
+            return;
+        }
+        p_tcb = OSTCBCurPtr;
+    }
+
+    if (p_tcb->TaskState == OS_TASK_STATE_RDY) {                /* Take it out to put it back in deadline order         */
+        OS_RdyListRemove(p_tcb);
+    }
+
+    p_tcb->EdfPeriod   = period;
+    p_tcb->EdfDeadline = deadline;
+    p_tcb->EdfRelease  = OSTimeGet(p_err) - period;             /* No minimum for the first job                         */
+
+    if (p_tcb->TaskState == OS_TASK_STATE_RDY) {
+        if (deadline > 0u) {
+            OS_EdfRelease(p_tcb);                               /* See Note #1                                          */
+        }
+        OS_PrioInsert(p_tcb->Prio);
+        if (p_tcb == OSTCBCurPtr) {                             /* Keep the current task ahead of its peers             */
+            OS_RdyListInsertHead(p_tcb);
+        } else {
+            OS_RdyListInsertTail(p_tcb);
+        }
+    }
+    CPU_CRITICAL_EXIT();
+
+    if (OSRunning == OS_STATE_OS_RUNNING) {
+        OSSched();                                              /* Run highest priority task ready                      */
+    }
+
+   *p_err = OS_ERR_NONE;
+}
+
+
+/*
+************************************************************************************************************************
+*                                                   RELEASE A JOB
+*
+* Description: This function is called by OS_RdyListInsert() when a task with a deadline is made ready after a post or
+*              a tick woke it.  It works out the release and the deadline of the task's new job (see Note #2 at the top
+*              of the file).
+*
+* Arguments  : p_tcb      is a pointer to the task's OS_TCB.
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application MUST NOT call it.
+*
+*              2) This function is assumed to be called with interrupts disabled.
+************************************************************************************************************************
+*/
+
+void  OS_EdfRelease (OS_TCB  *p_tcb)
+{
+    OS_ERR   err;
+    OS_TICK  now;
+    OS_TICK  release;
+
+
+    now     = OSTimeGet(&err);
+    release = p_tcb->EdfRelease + p_tcb->EdfPeriod;             /* Earliest release the period allows                   */
+    if ((OS_TICK)(now - release) < ((OS_TICK)-1 / 2u)) {        /* Is 'now' at or past it?                              */
+        release = now;
+    }
+    p_tcb->EdfRelease     = release;
+    p_tcb->EdfDeadlineAbs = release + p_tcb->EdfDeadline;
+    p_tcb->EdfLate        = DEF_FALSE;
+    p_tcb->EdfJobCtr++;
+}
+
+
+/*
+************************************************************************************************************************
+*                                                 CHECK A JOB'S DEADLINE
+*
+* Description: This function is called by OS_RdyListRemove() when a task with a deadline leaves the ready list.  It
+*              counts the job as missed if it is past its deadline (see Note #3 at the top of the file).
+*
+* Arguments  : p_tcb      is a pointer to the task's OS_TCB.
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application MUST NOT call it.
+*
+*              2) This function is assumed to be called with interrupts disabled.
+*
+*              3) A job leaves the ready list before it ends when its priority changes.  It may be counted then, as
+*                 it is late already, but not again.
+************************************************************************************************************************
+*/
+
+void  OS_EdfJobChk (OS_TCB  *p_tcb)
+{
+    OS_ERR   err;
+    OS_TICK  now;
+
+
+    if (p_tcb->EdfLate == DEF_TRUE) {                           /* See Note #3                                          */
+        return;
+    }
+    now = OSTimeGet(&err);
+    if ((OS_TICK)(p_tcb->EdfDeadlineAbs - now) > ((OS_TICK)-1 / 2u)) {
+        p_tcb->EdfLate = DEF_TRUE;                              /* Deadline is behind us                                */
+        p_tcb->EdfMissCtr++;
+    }
+}
+
+
+/*
+************************************************************************************************************************
+*                                            INSERT TCB IN DEADLINE ORDER
+*
+* Description: This function is called by OS_RdyListInsertHead() and OS_RdyListInsertTail() for a task with a
+*              deadline.  It inserts the task after every task of its list due no later, and before the rest.
+*
+* Arguments  : p_tcb      is a pointer to the task's OS_TCB.
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application MUST NOT call it.
+*
+*              2) This function is assumed to be called with interrupts disabled.
+*
+*              3) A task without a deadline ends the search, see Note #4 at the top of the file.
+*
+*              4) Tasks due at the same tick stay first in, first out.  The running task is not preempted by one due
+*                 at the same tick.
+************************************************************************************************************************
+*/
+
+void  OS_EdfRdyListInsert (OS_TCB  *p_tcb)
+{
+    OS_RDY_LIST  *p_rdy_list;
+    OS_TCB       *p_tcb2;
+
+
+    p_rdy_list = &OSRdyList[p_tcb->Prio];
+    p_tcb2     = p_rdy_list->HeadPtr;
+    while ((p_tcb2              != (OS_TCB *)0) &&
+           (p_tcb2->EdfDeadline >  0u)) {                       /* See Note #3                                          */
+        if ((OS_TICK)(p_tcb->EdfDeadlineAbs - p_tcb2->EdfDeadlineAbs) > ((OS_TICK)-1 / 2u)) {
+            break;                                              /* Found one due later (see Note #4)                    */
+        }
+        p_tcb2 = p_tcb2->NextPtr;
+    }
+
+    p_tcb->NextPtr = p_tcb2;                                    /* Link before 'p_tcb2', or at the tail if none         */
+    if (p_tcb2 == (OS_TCB *)0) {
+        p_tcb->PrevPtr      = p_rdy_list->TailPtr;
+        p_rdy_list->TailPtr = p_tcb;
+    } else {
+        p_tcb->PrevPtr      = p_tcb2->PrevPtr;
+        p_tcb2->PrevPtr     = p_tcb;
+    }
+    if (p_tcb->PrevPtr == (OS_TCB *)0) {
+        p_rdy_list->HeadPtr     = p_tcb;
+    } else {
+        p_tcb->PrevPtr->NextPtr = p_tcb;
+    }
+#if (OS_CFG_DBG_EN == DEF_ENABLED)
+    p_rdy_list->NbrEntries++;                                   /* One more OS_TCB in the list                          */
+#endif
+}
+
+#endif
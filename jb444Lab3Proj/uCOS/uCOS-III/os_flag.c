@@ -116,6 +116,9 @@ void  OSFlagCreate (OS_FLAG_GRP  *p_grp,
     p_grp->TS      = 0u;
 #endif
     OS_PendListInit(&p_grp->PendList);
+#if (OS_CFG_FLAG_PEND_IDX_EN == DEF_ENABLED)
+    OS_PendListIdxInit(&p_grp->PendList, &p_grp->PendListIdx);  /* Index the waiting list by priority                  */
+#endif
 
 #if (OS_CFG_DBG_EN == DEF_ENABLED)
     OS_FlagDbgListAdd(p_grp);
@@ -921,6 +924,7 @@ OS_FLAGS  OSFlagPendGetFlagsRdy (OS_ERR  *p_err)
 *                                OS_ERR_OBJ_TYPE            You are not pointing to an event flag group
 *                                OS_ERR_OPT_INVALID         You specified an invalid option
 *                                OS_ERR_OS_NOT_RUNNING      If uC/OS-III is not running yet
+*                                OS_ERR_INT_Q_FULL          If called from an ISR and the ISR post queue is full
 *
 * Returns    : the new value of the event flags bits that are still set.
 *
@@ -979,6 +983,14 @@ OS_FLAGS  OSFlagPost (OS_FLAG_GRP  *p_grp,
     }
 #endif
 
+#if (OS_CFG_ISR_POST_DEFERRED_EN == DEF_ENABLED)
+    if (OSIntNestingCtr > 0u) {                                 /* Called from an ISR: leave the post to OS_IntQTask()  */
+        OS_IntQPost(OS_OBJ_TYPE_FLAG, (void *)p_grp, (void *)0, 0u, flags, opt, p_err);
+        OS_TRACE_FLAG_POST_EXIT(*p_err);
+        return (0u);
+    }
+#endif
+
 #if (OS_CFG_TS_EN == DEF_ENABLED)
     ts = OS_TS_GET();                                           /* Get timestamp                                        */
 #else
@@ -1265,6 +1277,9 @@ void   OS_FlagTaskRdy (OS_TCB    *p_tcb,
              if (p_tcb->TaskState == OS_TASK_STATE_PEND_TIMEOUT) {
                  OS_TickListRemove(p_tcb);                      /* Remove from tick list                                */
              }
+#endif
+#if (OS_CFG_EDF_EN == DEF_ENABLED)
+             p_tcb->EdfWake = DEF_TRUE;                         /* New job once made ready, see os_edf.c Note #2        */
 #endif
              OS_RdyListInsert(p_tcb);                           /* Insert the task in the ready list                    */
              p_tcb->TaskState = OS_TASK_STATE_RDY;
@@ -1272,6 +1287,9 @@ void   OS_FlagTaskRdy (OS_TCB    *p_tcb,
 
         case OS_TASK_STATE_PEND_SUSPENDED:
         case OS_TASK_STATE_PEND_TIMEOUT_SUSPENDED:
+#if (OS_CFG_EDF_EN == DEF_ENABLED)
+             p_tcb->EdfWake = DEF_TRUE;                         /* New job once made ready, see os_edf.c Note #2        */
+#endif
              p_tcb->TaskState = OS_TASK_STATE_SUSPENDED;
              break;
 
@@ -3,14 +3,14 @@
 *                                                      uC/OS-III
 *                                                 The Real-Time Kernel
 *
-*                                  (c) Copyright 2009-2015; Micrium, Inc.; Weston, FL
+*                                  (c) Copyright 2009-2016; Micrium, Inc.; Weston, FL
 *                           All rights reserved.  Protected by international copyright laws.
 *
 *                                                 ISR QUEUE MANAGEMENT
 *
 * File    : OS_INT.C
 * By      : JJL
-* Version : V3.05.01
+* Version : V3.06.01
 *
 * LICENSING TERMS:
 * ---------------
@@ -27,12 +27,12 @@
 *           Your honesty is greatly appreciated.
 *
 *           You can find our product's user manual, API reference, release notes and
-*           more information at https://doc.micrium.com.
+*           more information at doc.micrium.com.
 *           You can contact us at www.micrium.com.
 ************************************************************************************************************************
 */
 
-#define   MICRIUM_SOURCE
+#define  MICRIUM_SOURCE
 #include "os.h"
 
 #ifdef VSC_INCLUDE_SOURCE_FILE_NAMES
@@ -43,21 +43,31 @@ const  CPU_CHAR  *os_int__c = "$Id: $";
 #if (OS_CFG_ISR_POST_DEFERRED_EN == DEF_ENABLED)
 /*
 ************************************************************************************************************************
-*                                                   POST TO ISR QUEUE
+*                                                 FUNCTION PROTOTYPES
+************************************************************************************************************************
+*/
+
+static  void  OS_IntQRePost (OS_INT_Q  *p_entry);
+
+
+/*
+************************************************************************************************************************
+*                                                  POST TO ISR QUEUE
 *
-* Description: This function places contents of posts into an intermediate queue to help defer processing of interrupts
-*              at the task level.
+* Description: This function places a post made from an ISR in the ISR post queue.  OS_IntQTask() performs it at task
+*              level.
 *
 * Arguments  : type       is the type of kernel object the post is destined to:
 *
 *                             OS_OBJ_TYPE_SEM
 *                             OS_OBJ_TYPE_Q
+*                             OS_OBJ_TYPE_Q_REF
 *                             OS_OBJ_TYPE_FLAG
 *                             OS_OBJ_TYPE_TASK_MSG
 *                             OS_OBJ_TYPE_TASK_SIGNAL
 *
 *              p_obj      is a pointer to the kernel object to post to.  This can be a pointer to a semaphore,
-*              -----      a message queue or a task control clock.
+*              -----      a message queue, an event flag group or a task control block.
 *
 *              p_void     is a pointer to a message that is being posted.  This is used when posting to a message
 *                         queue or directly to a task.
@@ -67,27 +77,31 @@ const  CPU_CHAR  *os_int__c = "$Id: $";
 *              flags      if the post is done to an event flag group then this corresponds to the flags being
 *                         posted
 *
-*              ts         is a timestamp as to when the post was done
-*
 *              opt        this corresponds to post options and applies to:
 *
 *                             OSFlagPost()
 *                             OSSemPost()
 *                             OSQPost()
 *                             OSTaskQPost()
+*                             OSTaskSemPost()
 *
 *              p_err      is a pointer to a variable that will contain an error code returned by this function.
 *
-*                             OS_ERR_NONE         if the post to the ISR queue was successful
-*                             OS_ERR_INT_Q_FULL   if the ISR queue is full and cannot accepts any further posts.  This
+*                             OS_ERR_NONE         if the post was placed in the ISR queue
+*                             OS_ERR_INT_Q_FULL   if the ISR queue is full and cannot accept any further posts.  This
 *                                                 generally indicates that you are receiving interrupts faster than you
 *                                                 can process them or, that you didn't make the ISR queue large enough.
 *
 * Returns    : none
 *
-* Note(s)    : 1) This function is DEPRECATED and is not recommended for new designs. Deferred ISRs is a deprecated
-*                 feature of the kernel. It remains fully functional and supported but should not be used for
-*                 new applications.
+* Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application MUST NOT call it.
+*
+*              2) A queue entry is claimed with CPU_AtomicCmpSwap() on OSIntQInCtr, so interrupts stay enabled while
+*                 the post is copied in.  An ISR nesting on this one may claim the entry first, in which case the next
+*                 one is tried.  Its 'Seq' is written last, which hands the entry to OS_IntQTask().
+*
+*              3) Interrupts are only disabled to make OS_IntQTask() ready.  That takes the same few steps whatever is
+*                 posted and however many tasks are waiting, because OS_IntQTask() is alone at priority 0.
 ************************************************************************************************************************
 */
 
@@ -97,51 +111,56 @@ void  OS_IntQPost (OS_OBJ_TYPE   type,
                    OS_MSG_SIZE   msg_size,
                    OS_FLAGS      flags,
                    OS_OPT        opt,
-                   CPU_TS        ts,
                    OS_ERR       *p_err)
 {
+    OS_INT_Q     *p_entry;
+    CPU_DATA      pos;
+    CPU_DATA      ctr;
+    CPU_INT32S    diff;
+    CPU_BOOLEAN   claimed;
     CPU_SR_ALLOC();
 
 
-#if (OS_CFG_TS_EN == DEF_DISABLED)
-    (void)ts;                                                   /* Prevent compiler warning for not using 'ts'          */
-#endif
-
-    CPU_CRITICAL_ENTER();
-    if (OSIntQNbrEntries < OSCfg_IntQSize) {                    /* Make sure we haven't already filled the ISR queue    */
-        OSIntQNbrEntries++;
-
-        if (OSIntQNbrEntriesMax < OSIntQNbrEntries) {
-            OSIntQNbrEntriesMax = OSIntQNbrEntries;
+    claimed = DEF_NO;
+    while (claimed == DEF_NO) {                                 /* Claim the next free entry (see Note #2)              */
+        pos     = OSIntQInCtr;
+        p_entry = &OSCfg_IntQBasePtr[pos & ((CPU_DATA)OSCfg_IntQSize - 1u)];
+        diff    = (CPU_INT32S)(p_entry->Seq - pos);
+        if (diff == 0) {                                        /* Free for this position                               */
+            if (CPU_AtomicCmpSwap(&OSIntQInCtr, pos, pos + 1u) == DEF_OK) {
+                claimed = DEF_YES;
+            }
+        } else if (diff < 0) {                                  /* Still holds the post one lap behind: queue full      */
+            do {
+                ctr = OSIntQOvfCtr;                             /* Count the number of ISR queue overflows              */
+            } while (CPU_AtomicCmpSwap(&OSIntQOvfCtr, ctr, ctr + 1u) == DEF_FAIL);
+           *p_err = OS_ERR_INT_Q_FULL;
+            return;
+        } else {
+                                                                /* Claimed by a nested ISR, try the next position       */
         }
+    }
 
-        OSIntQInPtr->Type       = type;                         /* Save object type being posted                        */
-        OSIntQInPtr->ObjPtr     = p_obj;                        /* Save pointer to object being posted                  */
-        OSIntQInPtr->MsgPtr     = p_void;                       /* Save pointer to message if posting to a message queue*/
-        OSIntQInPtr->MsgSize    = msg_size;                     /* Save the message size   if posting to a message queue*/
-        OSIntQInPtr->Flags      = flags;                        /* Save the flags if posting to an event flag group     */
-        OSIntQInPtr->Opt        = opt;                          /* Save post options                                    */
-#if (OS_CFG_TS_EN == DEF_ENABLED)
-        OSIntQInPtr->TS         = ts;                           /* Save time stamp                                      */
-#endif
-
-        OSIntQInPtr             = OSIntQInPtr->NextPtr;         /* Point to the next interrupt handler queue entry      */
+    p_entry->Type    = type;                                    /* Save object type being posted                        */
+    p_entry->ObjPtr  = p_obj;                                   /* Save pointer to object being posted                  */
+    p_entry->MsgPtr  = p_void;                                  /* Save pointer to message if posting to a message queue*/
+    p_entry->MsgSize = msg_size;                                /* Save the message size   if posting to a message queue*/
+    p_entry->Flags   = flags;                                   /* Save the flags if posting to an event flag group     */
+    p_entry->Opt     = opt;                                     /* Save post options                                    */
+    CPU_MB();
+    p_entry->Seq     = pos + 1u;                                /* Hand the entry to OS_IntQTask()                      */
+
+    CPU_CRITICAL_ENTER();                                       /* Make the ISR queue task ready (see Note #3)          */
+    if (OSRdyList[0].HeadPtr == (OS_TCB *)0) {
 #if (OS_CFG_DBG_EN == DEF_ENABLED)
-        OSRdyList[0].NbrEntries = 1u;                           /* Make the interrupt handler task ready to run         */
+        OSRdyList[0].NbrEntries = 1u;
 #endif
         OSRdyList[0].HeadPtr    = &OSIntQTaskTCB;
         OSRdyList[0].TailPtr    = &OSIntQTaskTCB;
         OS_PrioInsert(0u);                                      /* Add task priority 0 in the priority table            */
-        if (OSPrioCur != 0) {                                   /* Chk if OSIntQTask is not running                     */
-            OSPrioSaved         = OSPrioCur;                    /* Save current priority                                */
-        }
-
-       *p_err                   = OS_ERR_NONE;
-    } else {
-        OSIntQOvfCtr++;                                         /* Count the number of ISR queue overflows              */
-       *p_err                   = OS_ERR_INT_Q_FULL;
     }
     CPU_CRITICAL_EXIT();
+   *p_err = OS_ERR_NONE;
 }
 
 
@@ -149,144 +168,86 @@ void  OS_IntQPost (OS_OBJ_TYPE   type,
 ************************************************************************************************************************
 *                                               RE-POST FROM ISR QUEUE
 *
-* Description: This function takes contents of posts from an intermediate queue to help defer processing of interrupts
-*              at the task level.
+* Description: This function performs a post taken from the ISR queue, at task level.
 *
-* Arguments  : none
+* Arguments  : p_entry    is a pointer to the ISR queue entry
 *
 * Returns    : none
 *
-* Note(s)    : 1) This function is DEPRECATED, see OS_IntQPost() note 1 for details.
+* Note(s)    : 1) OS_OPT_POST_NO_SCHED is added to every post.  OS_IntQTask() runs the scheduler once the queue is
+*                 empty.
+*
+*              2) Errors are not reported back to the ISR.  The options were checked when the ISR made the post.  A
+*                 reference-counted message that can not be posted is released (see OSQPostRef()).
 ************************************************************************************************************************
 */
 
-void  OS_IntQRePost (void)
+static  void  OS_IntQRePost (OS_INT_Q  *p_entry)
 {
-#if (OS_CFG_TMR_EN == DEF_ENABLED)
-    CPU_TS  ts;
-#endif
     OS_ERR  err;
 
 
-    switch (OSIntQOutPtr->Type) {                               /* Re-post to task                                      */
+    switch (p_entry->Type) {                                    /* Re-post to object or task                            */
         case OS_OBJ_TYPE_FLAG:
 #if (OS_CFG_FLAG_EN == DEF_ENABLED)
-             (void)OS_FlagPost((OS_FLAG_GRP *) OSIntQOutPtr->ObjPtr,
-                                OSIntQOutPtr->Flags,
-                                OSIntQOutPtr->Opt,
-#if (OS_CFG_TS_EN == DEF_ENABLED)
-                                OSIntQOutPtr->TS,
-#else
-                                0u,
-#endif
-                               &err);
+             (void)OSFlagPost((OS_FLAG_GRP *)p_entry->ObjPtr,
+                                             p_entry->Flags,
+                                             p_entry->Opt | OS_OPT_POST_NO_SCHED,
+                                            &err);
 #endif
              break;
 
         case OS_OBJ_TYPE_Q:
 #if (OS_CFG_Q_EN == DEF_ENABLED)
-             OS_QPost((OS_Q *) OSIntQOutPtr->ObjPtr,
-                       OSIntQOutPtr->MsgPtr,
-                       OSIntQOutPtr->MsgSize,
-                       OSIntQOutPtr->Opt,
-#if (OS_CFG_TS_EN == DEF_ENABLED)
-                        OSIntQOutPtr->TS,
-#else
-                        0u,
+             OSQPost((OS_Q *)p_entry->ObjPtr,
+                             p_entry->MsgPtr,
+                             p_entry->MsgSize,
+                             p_entry->Opt | OS_OPT_POST_NO_SCHED,
+                            &err);
 #endif
-                      &err);
+             break;
+
+        case OS_OBJ_TYPE_Q_REF:
+#if (OS_CFG_Q_EN == DEF_ENABLED) && (OS_CFG_MEM_REF_EN == DEF_ENABLED)
+             OSQPost((OS_Q *)p_entry->ObjPtr,
+                             p_entry->MsgPtr,
+                             p_entry->MsgSize,
+                             p_entry->Opt | OS_OPT_POST_NO_SCHED | OS_OPT_POST_MEM_REF,
+                            &err);
+             if (err != OS_ERR_NONE) {                          /* Not posted, drop the queue's reference (see os_q.c)  */
+                 OSMemRefRelease(p_entry->MsgPtr, &err);
+             }
 #endif
              break;
 
         case OS_OBJ_TYPE_SEM:
 #if (OS_CFG_SEM_EN == DEF_ENABLED)
-             (void)OS_SemPost((OS_SEM *) OSIntQOutPtr->ObjPtr,
-                               OSIntQOutPtr->Opt,
-#if (OS_CFG_TS_EN == DEF_ENABLED)
-                               OSIntQOutPtr->TS,
-#else
-                               0u,
-#endif
-                              &err);
+             (void)OSSemPost((OS_SEM *)p_entry->ObjPtr,
+                                       p_entry->Opt | OS_OPT_POST_NO_SCHED,
+                                      &err);
 #endif
              break;
 
         case OS_OBJ_TYPE_TASK_MSG:
 #if (OS_CFG_TASK_Q_EN == DEF_ENABLED)
-             OS_TaskQPost((OS_TCB    *) OSIntQOutPtr->ObjPtr,
-                          (void      *) OSIntQOutPtr->MsgPtr,
-                           OSIntQOutPtr->MsgSize,
-                           OSIntQOutPtr->Opt,
-#if (OS_CFG_TS_EN == DEF_ENABLED)
-                           OSIntQOutPtr->TS,
-#else
-                           0u,
-#endif
-                          &err);
-#endif
-             break;
-
-        case OS_OBJ_TYPE_TASK_RESUME:
-#if (OS_CFG_TASK_SUSPEND_EN == DEF_ENABLED)
-             (void)OS_TaskResume((OS_TCB *) OSIntQOutPtr->ObjPtr,
-                                 &err);
-#endif
-             break;
-
-        case OS_OBJ_TYPE_TASK_SIGNAL:
-             (void)OS_TaskSemPost((OS_TCB *) OSIntQOutPtr->ObjPtr,
-                                   OSIntQOutPtr->Opt,
-#if (OS_CFG_TS_EN == DEF_ENABLED)
-                                   OSIntQOutPtr->TS,
-#else
-                                   0u,
-#endif
-                                  &err);
-             break;
-
-        case OS_OBJ_TYPE_TASK_SUSPEND:
-#if (OS_CFG_TASK_SUSPEND_EN == DEF_ENABLED)
-             (void)OS_TaskSuspend((OS_TCB *) OSIntQOutPtr->ObjPtr,
+             OSTaskQPost((OS_TCB *)p_entry->ObjPtr,
+                                   p_entry->MsgPtr,
+                                   p_entry->MsgSize,
+                                   p_entry->Opt | OS_OPT_POST_NO_SCHED,
                                   &err);
 #endif
              break;
 
-        case OS_OBJ_TYPE_TICK:
-#if (OS_CFG_TASK_TICK_EN == DEF_ENABLED)
-#if (OS_CFG_SCHED_ROUND_ROBIN_EN == DEF_ENABLED)
-             OS_SchedRoundRobin(&OSRdyList[OSPrioSaved]);
-#endif
-
-             (void)OS_TaskSemPost((OS_TCB *)&OSTickTaskTCB,     /* Signal tick task                                     */
-                                   OS_OPT_POST_NONE,
-#if (OS_CFG_TS_EN == DEF_ENABLED)
-                                   OSIntQOutPtr->TS,
-#else
-                                   0u,
-#endif
-                                  &err);
-#endif
-
-#if (OS_CFG_TMR_EN == DEF_ENABLED)
-             OSTmrUpdateCtr--;
-             if (OSTmrUpdateCtr == 0u) {
-                 OSTmrUpdateCtr = OSTmrUpdateCnt;
-#if (OS_CFG_TS_EN == DEF_ENABLED)
-                 ts             = OS_TS_GET();                  /* Get timestamp                                        */
-#else
-                 ts             = 0u;
-#endif
-                 (void)OS_TaskSemPost(&OSTmrTaskTCB,            /* Signal timer task                                    */
-                                       OS_OPT_POST_NONE,
-                                       ts,
-                                      &err);
-             }
-#endif
+        case OS_OBJ_TYPE_TASK_SIGNAL:
+             (void)OSTaskSemPost((OS_TCB *)p_entry->ObjPtr,
+                                           p_entry->Opt | OS_OPT_POST_NO_SCHED,
+                                          &err);
              break;
 
         default:
              break;
     }
+    (void)err;
 }
 
 
@@ -294,61 +255,61 @@ void  OS_IntQRePost (void)
 ************************************************************************************************************************
 *                                               INTERRUPT QUEUE MANAGEMENT TASK
 *
-* Description: This task is internal to uC/OS-III and is used to process the queue of deffered interrupts.
+* Description: This task is internal to uC/OS-III and is used to process the queue of deferred ISR posts.
 *
 * Arguments  : p_arg     is a pointer to an optional argument that is passed during task creation.  For this function
 *                        the argument is not used and will be a NULL pointer.
 *
 * Returns    : none
 *
-* Note(s)    : 1) This function is DEPRECATED, see OS_IntQPost() note 1 for details.
+* Note(s)    : 1) The task runs at priority 0, so no other task runs until the queue is empty.  It drains every entry
+*                 it finds in one batch, with interrupts enabled, and ISRs may add more while it does.
+*
+*              2) The task never pends.  Once the queue is empty it takes itself off the ready list, and OS_IntQPost()
+*                 puts it back.  The check and the removal are one critical section, so a post can not be missed.
 ************************************************************************************************************************
 */
 
 void  OS_IntQTask (void  *p_arg)
 {
-    CPU_BOOLEAN  done;
-#if (OS_CFG_TS_EN == DEF_ENABLED)
-    CPU_TS       ts_start;
-    CPU_TS       ts_end;
-#endif
+    OS_INT_Q    *p_entry;
+    CPU_DATA     mask;
+    CPU_DATA     pos;
+    OS_OBJ_QTY   nbr_entries;
     CPU_SR_ALLOC();
 
 
-
     (void)p_arg;                                                /* Not using 'p_arg', prevent compiler warning          */
 
+    mask = (CPU_DATA)OSCfg_IntQSize - 1u;
     while (DEF_ON) {
-        done = DEF_FALSE;
-        while (done == DEF_FALSE) {
-            CPU_CRITICAL_ENTER();
-            if (OSIntQNbrEntries == 0u) {
+        pos         = OSIntQOutCtr;
+        p_entry     = &OSCfg_IntQBasePtr[pos & mask];
+        nbr_entries = 0u;
+        while (p_entry->Seq == (pos + 1u)) {                    /* Re-post the entries ISRs have handed over (Note #1)  */
+            OS_IntQRePost(p_entry);
+            p_entry->Seq = pos + (CPU_DATA)OSCfg_IntQSize;      /* Free the entry for the next lap                      */
+            pos++;
+            nbr_entries++;
+            p_entry      = &OSCfg_IntQBasePtr[pos & mask];
+        }
+        OSIntQOutCtr = pos;
+        if (OSIntQNbrEntriesMax < nbr_entries) {
+            OSIntQNbrEntriesMax = nbr_entries;
+        }
+
+        CPU_CRITICAL_ENTER();
+        if (p_entry->Seq != (pos + 1u)) {                       /* Still empty: leave the ready list (see Note #2)      */
 #if (OS_CFG_DBG_EN == DEF_ENABLED)
-                OSRdyList[0].NbrEntries = 0u;                   /* Remove from ready list                               */
-#endif
-                OSRdyList[0].HeadPtr    = DEF_NULL;
-                OSRdyList[0].TailPtr    = DEF_NULL;
-                OS_PrioRemove(0u);                              /* Remove from the priority table                       */
-                CPU_CRITICAL_EXIT();
-                OSSched();
-                done = DEF_TRUE;                                /* No more entries in the queue, we are done            */
-            } else {
-                CPU_CRITICAL_EXIT();
-#if (OS_CFG_TS_EN == DEF_ENABLED)
-                ts_start = OS_TS_GET();
+            OSRdyList[0].NbrEntries = 0u;
 #endif
-                OS_IntQRePost();
-#if (OS_CFG_TS_EN == DEF_ENABLED)
-                ts_end   = OS_TS_GET() - ts_start;              /* Measure execution time of tick task                  */
-                if (OSIntQTaskTimeMax < ts_end) {
-                    OSIntQTaskTimeMax = ts_end;
-                }
-#endif
-                CPU_CRITICAL_ENTER();
-                OSIntQOutPtr = OSIntQOutPtr->NextPtr;           /* Point to next item in the ISR queue                  */
-                OSIntQNbrEntries--;
-                CPU_CRITICAL_EXIT();
-            }
+            OSRdyList[0].HeadPtr    = (OS_TCB *)0;
+            OSRdyList[0].TailPtr    = (OS_TCB *)0;
+            OS_PrioRemove(0u);                                  /* Remove from the priority table                       */
+            CPU_CRITICAL_EXIT();
+            OSSched();                                          /* Run the tasks the posts made ready                   */
+        } else {
+            CPU_CRITICAL_EXIT();
         }
     }
 }
@@ -362,67 +323,56 @@ void  OS_IntQTask (void  *p_arg)
 *
 * Arguments  : p_err    is a pointer to a variable that will contain an error code returned by this function.
 *
-*                           OS_ERR_INT_Q             If you didn't provide an ISR queue in OS_CFG.C
-*                           OS_ERR_INT_Q_SIZE        If you didn't specify a large enough ISR queue.
-*                           OS_ERR_STK_INVALID       If you specified a NULL pointer for the task of the ISR task
+*                           OS_ERR_INT_Q             If you didn't provide an ISR queue in OS_CFG_APP.C
+*                           OS_ERR_INT_Q_SIZE        If the ISR queue size is not a power of 2, 2 or more
+*                           OS_ERR_INT_Q_STK_INVALID If you specified a NULL pointer for the task of the ISR task
 *                                                    handler
-*                           OS_ERR_STK_SIZE_INVALID  If you didn't specify a stack size greater than the minimum
-*                                                    specified by OS_CFG_STK_SIZE_MIN
+*                           OS_ERR_INT_Q_STK_SIZE_INVALID  If you didn't specify a stack size greater than the minimum
+*                                                          specified by OS_CFG_STK_SIZE_MIN
 *                           OS_ERR_???               An error code returned by OSTaskCreate().
 *
 * Returns    : none
 *
-* Note(s)    : 1) This function is DEPRECATED, see OS_IntQPost() note 1 for details.
+* Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application MUST NOT call it.
 ************************************************************************************************************************
 */
 
 void  OS_IntQTaskInit (OS_ERR  *p_err)
 {
-    OS_INT_Q      *p_int_q;
-    OS_INT_Q      *p_int_q_next;
-    OS_OBJ_QTY     i;
+    OS_INT_Q    *p_entry;
+    OS_OBJ_QTY   i;
 
 
     OSIntQOvfCtr = 0u;                                          /* Clear the ISR queue overflow counter                 */
 
-    if (OSCfg_IntQBasePtr == DEF_NULL) {
+    if (OSCfg_IntQBasePtr == (OS_INT_Q *)0) {
        *p_err = OS_ERR_INT_Q;
         return;
     }
 
-    if (OSCfg_IntQSize < 2u) {
+    if ((OSCfg_IntQSize < 2u) ||
+        ((OSCfg_IntQSize & (OSCfg_IntQSize - 1u)) != 0u)) {     /* Positions are masked, not divided                    */
        *p_err = OS_ERR_INT_Q_SIZE;
         return;
     }
 
-#if (OS_CFG_TS_EN == DEF_ENABLED)
-    OSIntQTaskTimeMax = 0u;
-#endif
-
-    p_int_q           = OSCfg_IntQBasePtr;                      /* Initialize the circular ISR queue                    */
-    p_int_q_next      = p_int_q;
-    p_int_q_next++;
+    p_entry = OSCfg_IntQBasePtr;                                /* Initialize the ISR queue ring                        */
     for (i = 0u; i < OSCfg_IntQSize; i++) {
-        p_int_q->Type    =  OS_OBJ_TYPE_NONE;
-        p_int_q->ObjPtr  = DEF_NULL;
-        p_int_q->MsgPtr  = DEF_NULL;
-        p_int_q->MsgSize = 0u;
-        p_int_q->Flags   = 0u;
-        p_int_q->Opt     = 0u;
-        p_int_q->NextPtr = p_int_q_next;
-        p_int_q++;
-        p_int_q_next++;
+        p_entry->Seq     = (CPU_DATA)i;                         /* Free for the first lap                               */
+        p_entry->Type    =  OS_OBJ_TYPE_NONE;
+        p_entry->ObjPtr  = (void *)0;
+        p_entry->MsgPtr  = (void *)0;
+        p_entry->MsgSize =  0u;
+        p_entry->Flags   =  0u;
+        p_entry->Opt     =  0u;
+        p_entry++;
     }
-    p_int_q--;
-    p_int_q_next        = OSCfg_IntQBasePtr;
-    p_int_q->NextPtr    = p_int_q_next;
-    OSIntQInPtr         = p_int_q_next;
-    OSIntQOutPtr        = p_int_q_next;
-    OSIntQNbrEntries    = 0u;
+    OSIntQInCtr         = 0u;
+    OSIntQOutCtr        = 0u;
     OSIntQNbrEntriesMax = 0u;
 
                                                                 /* ------------ CREATE THE ISR QUEUE TASK ------------- */
-    if (OSCfg_IntQTaskStkBasePtr == DEF_NULL) {
+    if (OSCfg_IntQTaskStkBasePtr == (CPU_STK *)0) {
        *p_err = OS_ERR_INT_Q_STK_INVALID;
         return;
     }
@@ -433,16 +383,20 @@ void  OS_IntQTaskInit (OS_ERR  *p_err)
     }
 
     OSTaskCreate(&OSIntQTaskTCB,
-                 (CPU_CHAR   *)((void *)"uC/OS-III ISR Queue Task"),
+#if  (OS_CFG_DBG_EN == DEF_DISABLED)
+                 (CPU_CHAR   *)0,
+#else
+                 (CPU_CHAR   *)"uC/OS-III ISR Queue Task",
+#endif
                   OS_IntQTask,
-                  DEF_NULL,
+                 (void       *)0,
                   0u,                                           /* This task is ALWAYS at priority '0' (i.e. highest)   */
                   OSCfg_IntQTaskStkBasePtr,
                   OSCfg_IntQTaskStkLimit,
                   OSCfg_IntQTaskStkSize,
                   0u,
                   0u,
-                  DEF_NULL,
+                 (void       *)0,
                  (OS_OPT_TASK_STK_CHK | OS_OPT_TASK_STK_CLR),
                   p_err);
 }
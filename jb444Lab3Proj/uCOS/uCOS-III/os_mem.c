@@ -64,7 +64,8 @@ const  CPU_CHAR  *os_mem__c = "$Id: $";
 *                            OS_ERR_ILLEGAL_CREATE_RUN_TIME If you are trying to create the memory partition after you
 *                                                             called OSSafetyCriticalStart()
 *                            OS_ERR_MEM_CREATE_ISR          If you called this function from an ISR
-*                            OS_ERR_MEM_INVALID_BLKS        User specified an invalid number of blocks (must be >= 2)
+*                            OS_ERR_MEM_INVALID_BLKS        User specified an invalid number of blocks (must be >= 2,
+*                                                             and less than 65536 with OS_CFG_MEM_LOCK_FREE_EN)
 *                            OS_ERR_MEM_INVALID_P_ADDR      If you are specifying an invalid address for the memory
 *                                                           storage of the partition or, the block does not align on a
 *                                                           pointer boundary
@@ -90,7 +91,11 @@ void  OSMemCreate (OS_MEM       *p_mem,
     OS_MEM_QTY     i;
     OS_MEM_QTY     loops;
     CPU_INT08U    *p_blk;
+#if (OS_CFG_MEM_LOCK_FREE_EN == DEF_ENABLED)
+    CPU_DATA      *p_link;
+#else
     void         **p_link;
+#endif
     CPU_SR_ALLOC();
 
 
@@ -125,6 +130,12 @@ void  OSMemCreate (OS_MEM       *p_mem,
        *p_err = OS_ERR_MEM_INVALID_BLKS;
         return;
     }
+#if (OS_CFG_MEM_LOCK_FREE_EN == DEF_ENABLED)
+    if ((CPU_DATA)n_blks >= OS_MEM_FREE_IX_MSK) {               /* Block index must fit the free list top (see os.h)    */
+       *p_err = OS_ERR_MEM_INVALID_BLKS;
+        return;
+    }
+#endif
     if (blk_size < sizeof(void *)) {                            /* Must contain space for at least a pointer            */
        *p_err = OS_ERR_MEM_INVALID_SIZE;
         return;
@@ -142,6 +153,17 @@ void  OSMemCreate (OS_MEM       *p_mem,
     }
 #endif
 
+#if (OS_CFG_MEM_LOCK_FREE_EN == DEF_ENABLED)
+    p_link = (CPU_DATA *)p_addr;                                /* Create linked list of free memory blocks             */
+    p_blk  = (CPU_INT08U *)p_addr;
+    loops  = n_blks - 1u;
+    for (i = 0u; i < loops; i++) {
+        p_blk +=  blk_size;
+       *p_link = (CPU_DATA)i + 2u;                              /* Save index (plus one) of NEXT block in CURRENT block */
+        p_link = (CPU_DATA *)(void *)p_blk;                     /* Position to NEXT block                               */
+    }
+   *p_link             = 0u;                                    /* Last memory block has no next                        */
+#else
     p_link = (void **)p_addr;                                   /* Create linked list of free memory blocks             */
     p_blk  = (CPU_INT08U *)p_addr;
     loops  = n_blks - 1u;
@@ -151,6 +173,7 @@ void  OSMemCreate (OS_MEM       *p_mem,
         p_link = (void **)(void *)p_blk;                        /* Position     to NEXT block                           */
     }
    *p_link             = (void *)0;                             /* Last memory block points to NULL                     */
+#endif
 
     CPU_CRITICAL_ENTER();
 #if (OS_OBJ_TYPE_REQ == DEF_ENABLED)
@@ -162,7 +185,11 @@ void  OSMemCreate (OS_MEM       *p_mem,
     (void)p_name;
 #endif
     p_mem->AddrPtr     = p_addr;                                /* Store start address of memory partition              */
+#if (OS_CFG_MEM_LOCK_FREE_EN == DEF_ENABLED)
+    p_mem->FreeListTop = 1u;                                    /* First block is free, tag starts at 0                 */
+#else
     p_mem->FreeListPtr = p_addr;                                /* Initialize pointer to pool of free blocks            */
+#endif
     p_mem->NbrFree     = n_blks;                                /* Store number of free blocks in MCB                   */
     p_mem->NbrMax      = n_blks;
     p_mem->BlkSize     = blk_size;                              /* Store block size of each memory blocks               */
@@ -197,15 +224,27 @@ void  OSMemCreate (OS_MEM       *p_mem,
 * Returns    : A pointer to a memory block if no error is detected
 *              A pointer to NULL if an error is detected
 *
-* Note(s)    : none
+* Note(s)    : 1) With OS_CFG_MEM_LOCK_FREE_EN, interrupts stay enabled (see os.h, MEMORY PARTITIONS Note #1).  The
+*                 next index is read before the swap.  If another caller took the block in between, the index read
+*                 may be stale, but the tag has changed and the swap fails and is retried.  Blocks are never given
+*                 back to the system, so the read is always of partition memory.
+*
+*              2) The block is taken before NbrFree is decremented, and OSMemPut() increments NbrFree before the block
+*                 is put back.  NbrFree may so be higher than the length of the list for a short time, never lower.
 ************************************************************************************************************************
 */
 
 void  *OSMemGet (OS_MEM  *p_mem,
                  OS_ERR  *p_err)
 {
-    void    *p_blk;
+    void      *p_blk;
+#if (OS_CFG_MEM_LOCK_FREE_EN == DEF_ENABLED)
+    CPU_DATA   top;
+    CPU_DATA   ix;
+    CPU_DATA   ctr;
+#else
     CPU_SR_ALLOC();
+#endif
 
 
 
@@ -236,6 +275,25 @@ void  *OSMemGet (OS_MEM  *p_mem,
 #endif
 
 
+#if (OS_CFG_MEM_LOCK_FREE_EN == DEF_ENABLED)
+    do {
+        top = p_mem->FreeListTop;
+        ix  = top & OS_MEM_FREE_IX_MSK;
+        if (ix == 0u) {                                         /* See if there are any free memory blocks              */
+            OS_TRACE_MEM_GET_FAILED(p_mem);
+            OS_TRACE_MEM_GET_EXIT(OS_ERR_MEM_NO_FREE_BLKS);
+           *p_err = OS_ERR_MEM_NO_FREE_BLKS;                    /* No,  Notify caller of empty memory partition         */
+            return ((void *)0);                                 /* Return NULL pointer to caller                        */
+        }
+        p_blk = (void *)((CPU_INT08U *)p_mem->AddrPtr + (ix - 1u) * p_mem->BlkSize);
+        ix    = *(CPU_DATA *)p_blk;                             /* Yes, index of the block after it, see Note #1        */
+    } while (CPU_AtomicCmpSwap(&p_mem->FreeListTop,
+                                top,
+                              ((top & ~OS_MEM_FREE_IX_MSK) + OS_MEM_FREE_TAG_INC) | (ix & OS_MEM_FREE_IX_MSK)) == DEF_FAIL);
+    do {                                                        /* One less memory block in this partition (Note #2)    */
+        ctr = p_mem->NbrFree;
+    } while (CPU_AtomicCmpSwap(&p_mem->NbrFree, ctr, ctr - 1u) == DEF_FAIL);
+#else
     CPU_CRITICAL_ENTER();
     if (p_mem->NbrFree == 0u) {                                 /* See if there are any free memory blocks              */
         CPU_CRITICAL_EXIT();
@@ -248,6 +306,7 @@ void  *OSMemGet (OS_MEM  *p_mem,
     p_mem->FreeListPtr = *(void **)p_blk;                       /* Adjust pointer to new free list                      */
     p_mem->NbrFree--;                                           /* One less memory block in this partition              */
     CPU_CRITICAL_EXIT();
+#endif
     OS_TRACE_MEM_GET(p_mem);
     OS_TRACE_MEM_GET_EXIT(OS_ERR_NONE);
    *p_err = OS_ERR_NONE;                                        /* No error                                             */
@@ -270,13 +329,14 @@ void  *OSMemGet (OS_MEM  *p_mem,
 *                            OS_ERR_NONE               If the memory block was inserted into the partition
 *                            OS_ERR_MEM_FULL           If you are returning a memory block to an already FULL memory
 *                                                      partition (You freed more blocks than you allocated!)
-*                            OS_ERR_MEM_INVALID_P_BLK  If you passed a NULL pointer for the block to release.
+*                            OS_ERR_MEM_INVALID_P_BLK  If you passed a NULL pointer for the block to release, or
+*                                                      (with OS_CFG_MEM_LOCK_FREE_EN) a block not of this partition.
 *                            OS_ERR_MEM_INVALID_P_MEM  If you passed a NULL pointer for 'p_mem'
 *                            OS_ERR_OBJ_TYPE           If 'p_mem' is not pointing at a memory partition
 *
 * Returns    : none
 *
-* Note(s)    : none
+* Note(s)    : 1) With OS_CFG_MEM_LOCK_FREE_EN, interrupts stay enabled.  See OSMemGet() Note #2.
 ************************************************************************************************************************
 */
 
@@ -284,7 +344,13 @@ void  OSMemPut (OS_MEM  *p_mem,
                 void    *p_blk,
                 OS_ERR  *p_err)
 {
+#if (OS_CFG_MEM_LOCK_FREE_EN == DEF_ENABLED)
+    CPU_DATA   top;
+    CPU_DATA   ix;
+    CPU_DATA   ctr;
+#else
     CPU_SR_ALLOC();
+#endif
 
 
 
@@ -321,6 +387,33 @@ void  OSMemPut (OS_MEM  *p_mem,
 #endif
 
 
+#if (OS_CFG_MEM_LOCK_FREE_EN == DEF_ENABLED)
+    ix = (CPU_DATA)(((CPU_ADDR)p_blk - (CPU_ADDR)p_mem->AddrPtr) / p_mem->BlkSize);
+#if (OS_CFG_ARG_CHK_EN == DEF_ENABLED)
+    if (((CPU_ADDR)p_blk <  (CPU_ADDR)p_mem->AddrPtr) ||        /* Block must be one of this partition                  */
+        (ix              >= (CPU_DATA)p_mem->NbrMax)) {
+        OS_TRACE_MEM_PUT_FAILED(p_mem);
+        OS_TRACE_MEM_PUT_EXIT(OS_ERR_MEM_INVALID_P_BLK);
+       *p_err = OS_ERR_MEM_INVALID_P_BLK;
+        return;
+    }
+#endif
+    do {
+        ctr = p_mem->NbrFree;
+        if (ctr >= p_mem->NbrMax) {                             /* Make sure all blocks not already returned            */
+            OS_TRACE_MEM_PUT_FAILED(p_mem);
+            OS_TRACE_MEM_PUT_EXIT(OS_ERR_MEM_FULL);
+           *p_err = OS_ERR_MEM_FULL;
+            return;
+        }
+    } while (CPU_AtomicCmpSwap(&p_mem->NbrFree, ctr, ctr + 1u) == DEF_FAIL);
+    do {                                                        /* Insert released block into free block list           */
+        top                = p_mem->FreeListTop;
+       *(CPU_DATA *)p_blk  = top & OS_MEM_FREE_IX_MSK;          /* Link to the block that is first now                  */
+    } while (CPU_AtomicCmpSwap(&p_mem->FreeListTop,
+                                top,
+                              ((top & ~OS_MEM_FREE_IX_MSK) + OS_MEM_FREE_TAG_INC) | (ix + 1u)) == DEF_FAIL);
+#else
     CPU_CRITICAL_ENTER();
     if (p_mem->NbrFree >= p_mem->NbrMax) {                      /* Make sure all blocks not already returned            */
         CPU_CRITICAL_EXIT();
@@ -333,12 +426,513 @@ void  OSMemPut (OS_MEM  *p_mem,
     p_mem->FreeListPtr = p_blk;
     p_mem->NbrFree++;                                           /* One more memory block in this partition              */
     CPU_CRITICAL_EXIT();
+#endif
     OS_TRACE_MEM_PUT(p_mem);
     OS_TRACE_MEM_PUT_EXIT(OS_ERR_NONE);
    *p_err              = OS_ERR_NONE;                           /* Notify caller that memory block was released         */
 }
 
 
+/*
+************************************************************************************************************************
+*                                            ADD A REFERENCE TO A MEMORY BLOCK
+*
+* Description : Adds a holder to a block obtained from OSMemRefGet().  Each holder calls OSMemRefRelease() once.
+*
+* Arguments   : p_data   is the address returned by OSMemRefGet()
+*
+*               p_err    is a pointer to a variable that will contain an error code returned by this function.
+*
+*                            OS_ERR_NONE                 If the reference was added
+*                            OS_ERR_MEM_INVALID_P_DATA   If 'p_data' is a NULL pointer or the block was already released
+*
+* Returns     : none
+*
+* Note(s)     : 1) The count is changed with CPU_AtomicCmpSwap(), so this function can be called from ISRs and does not
+*                  disable interrupts.
+************************************************************************************************************************
+*/
+
+#if (OS_CFG_MEM_REF_EN == DEF_ENABLED)
+void  OSMemRefAdd (void    *p_data,
+                   OS_ERR  *p_err)
+{
+    OS_MEM_REF  *p_ref;
+    CPU_DATA     ctr;
+
+
+
+#ifdef OS_SAFETY_CRITICAL
+    if (p_err == (OS_ERR *)0) {
+        OS_SAFETY_CRITICAL_EXCEPTION();
+        return;
+    }
+#endif
+
+#if (OS_CFG_ARG_CHK_EN == DEF_ENABLED)
+    if (p_data == (void *)0) {                                  /* Must hold a valid block                              */
+       *p_err = OS_ERR_MEM_INVALID_P_DATA;
+        return;
+    }
+#endif
+
+    p_ref = (OS_MEM_REF *)p_data - 1;                           /* Header is just before the data                       */
+    do {
+        ctr = p_ref->RefCtr;
+        if (ctr == 0u) {                                        /* Last holder already gave the block back              */
+           *p_err = OS_ERR_MEM_INVALID_P_DATA;
+            return;
+        }
+    } while (CPU_AtomicCmpSwap(&p_ref->RefCtr, ctr, ctr + 1u) == DEF_FAIL);
+   *p_err = OS_ERR_NONE;
+}
+
+
+/*
+************************************************************************************************************************
+*                                         GET A REFERENCE-COUNTED MEMORY BLOCK
+*
+* Description : Gets a block from a partition and makes the caller its only holder.
+*
+* Arguments   : p_mem   is a pointer to the memory partition control block.  Its blocks must be OS_MEM_REF_BLK_SIZE()
+*                       bytes for the data size wanted.
+*
+*               p_err   is a pointer to a variable containing an error message which will be set by this function to
+*                       either:
+*
+*                           OS_ERR_NONE               If a block was obtained
+*                           OS_ERR_MEM_INVALID_P_MEM  If you passed a NULL pointer for 'p_mem'
+*                           OS_ERR_MEM_INVALID_SIZE   If the blocks of the partition are too small for the header
+*                           OS_ERR_MEM_NO_FREE_BLKS   If there are no more free memory blocks to allocate to the caller
+*                           OS_ERR_OBJ_TYPE           If 'p_mem' is not pointing at a memory partition
+*
+* Returns     : A pointer to the data area of the block if no error is detected
+*               A pointer to NULL if an error is detected
+*
+* Note(s)     : 1) The data area follows an OS_MEM_REF header (see os.h), and has the same alignment as the block.
+************************************************************************************************************************
+*/
+
+void  *OSMemRefGet (OS_MEM  *p_mem,
+                    OS_ERR  *p_err)
+{
+    OS_MEM_REF  *p_ref;
+
+
+
+#ifdef OS_SAFETY_CRITICAL
+    if (p_err == (OS_ERR *)0) {
+        OS_SAFETY_CRITICAL_EXCEPTION();
+        return ((void *)0);
+    }
+#endif
+
+#if (OS_CFG_ARG_CHK_EN == DEF_ENABLED)
+    if (p_mem == (OS_MEM *)0) {                                 /* Must point to a valid memory partition               */
+       *p_err = OS_ERR_MEM_INVALID_P_MEM;
+        return ((void *)0);
+    }
+    if (p_mem->BlkSize <= sizeof(OS_MEM_REF)) {                 /* Must leave room for data after the header            */
+       *p_err = OS_ERR_MEM_INVALID_SIZE;
+        return ((void *)0);
+    }
+#endif
+
+    p_ref = (OS_MEM_REF *)OSMemGet(p_mem, p_err);
+    if (p_ref == (OS_MEM_REF *)0) {
+        return ((void *)0);
+    }
+    p_ref->MemPtr = p_mem;
+    p_ref->RefCtr = 1u;                                         /* Caller is the only holder                            */
+    return ((void *)(p_ref + 1));
+}
+
+
+/*
+************************************************************************************************************************
+*                                         RELEASE A REFERENCE TO A MEMORY BLOCK
+*
+* Description : Drops a holder of a block obtained from OSMemRefGet().  The last one returns the block to its partition.
+*
+* Arguments   : p_data   is the address returned by OSMemRefGet()
+*
+*               p_err    is a pointer to a variable that will contain an error code returned by this function.
+*
+*                            OS_ERR_NONE                 If the reference was released
+*                            OS_ERR_MEM_INVALID_P_DATA   If 'p_data' is a NULL pointer or the block was already released
+*                            OS_ERR_MEM_FULL             If the partition was already full (see OSMemPut())
+*
+* Returns     : none
+*
+* Note(s)     : 1) Can be called from ISRs.  Interrupts are only disabled by OSMemPut() for the last holder.
+************************************************************************************************************************
+*/
+
+void  OSMemRefRelease (void    *p_data,
+                       OS_ERR  *p_err)
+{
+    OS_MEM_REF  *p_ref;
+    CPU_DATA     ctr;
+
+
+
+#ifdef OS_SAFETY_CRITICAL
+    if (p_err == (OS_ERR *)0) {
+        OS_SAFETY_CRITICAL_EXCEPTION();
+        return;
+    }
+#endif
+
+#if (OS_CFG_ARG_CHK_EN == DEF_ENABLED)
+    if (p_data == (void *)0) {                                  /* Must hold a valid block                              */
+       *p_err = OS_ERR_MEM_INVALID_P_DATA;
+        return;
+    }
+#endif
+
+    p_ref = (OS_MEM_REF *)p_data - 1;                           /* Header is just before the data                       */
+    do {
+        ctr = p_ref->RefCtr;
+        if (ctr == 0u) {                                        /* Released more times than it was held                 */
+           *p_err = OS_ERR_MEM_INVALID_P_DATA;
+            return;
+        }
+    } while (CPU_AtomicCmpSwap(&p_ref->RefCtr, ctr, ctr - 1u) == DEF_FAIL);
+
+    if (ctr == 1u) {                                            /* Last holder: return the block to its partition       */
+        OSMemPut(p_ref->MemPtr, (void *)p_ref, p_err);
+        return;
+    }
+   *p_err = OS_ERR_NONE;
+}
+#endif
+
+
+/*
+************************************************************************************************************************
+*                                                   CREATE A SLAB
+*
+* Description : Groups memory partitions into the size classes of a slab, so that blocks can be obtained by size with
+*               OSMemSlabAlloc() instead of by partition.
+*
+* Arguments   : p_slab       is a pointer to the slab control block, allocated in user memory space.
+*
+*               p_name       is a pointer to an ASCII string to provide a name to the slab.
+*
+*               p_class_tbl  is a table of 'n_class' size classes, allocated in user memory space.  The caller fills
+*                            in the MemPtr of each entry with a partition made by OSMemCreate(), smallest block size
+*                            first.  The other members are cleared by this function.
+*
+*               n_class      is the number of entries in 'p_class_tbl'.
+*
+*               p_err        is a pointer to a variable containing an error message which will be set by this function
+*                            to either:
+*
+*                                OS_ERR_NONE                  If the slab has been created correctly
+*                                OS_ERR_ILLEGAL_CREATE_RUN_TIME If you are trying to create the slab after you called
+*                                                               OSSafetyCriticalStart()
+*                                OS_ERR_MEM_CREATE_ISR        If you called this function from an ISR
+*                                OS_ERR_MEM_INVALID_P_MEM     If 'p_slab' or 'p_class_tbl' is a NULL pointer
+*                                OS_ERR_MEM_INVALID_PART      If 'n_class' is 0 or a class has no partition
+*                                OS_ERR_MEM_INVALID_SIZE      If the block sizes are not a power of two doubling from
+*                                                             one class to the next
+*                                OS_ERR_OBJ_TYPE              If a MemPtr is not pointing at a memory partition
+*
+* Returns     : none
+*
+* Note(s)     : 1) With 8, 16, 32 and 64 byte classes, a request for 20 bytes gets a 32 byte block.  Blocks are
+*                  never split or merged, so the memory of each class stays available to that class only.
+************************************************************************************************************************
+*/
+
+#if (OS_CFG_MEM_SLAB_EN == DEF_ENABLED)
+void  OSMemSlabCreate (OS_MEM_SLAB        *p_slab,
+                       CPU_CHAR           *p_name,
+                       OS_MEM_SLAB_CLASS  *p_class_tbl,
+                       OS_OBJ_QTY          n_class,
+                       OS_ERR             *p_err)
+{
+    OS_MEM_SIZE         blk_size;
+    OS_OBJ_QTY          i;
+    CPU_SR_ALLOC();
+
+
+
+#ifdef OS_SAFETY_CRITICAL
+    if (p_err == (OS_ERR *)0) {
+        OS_SAFETY_CRITICAL_EXCEPTION();
+        return;
+    }
+#endif
+
+#ifdef OS_SAFETY_CRITICAL_IEC61508
+    if (OSSafetyCriticalStartFlag == DEF_TRUE) {
+       *p_err = OS_ERR_ILLEGAL_CREATE_RUN_TIME;
+        return;
+    }
+#endif
+
+#if (OS_CFG_CALLED_FROM_ISR_CHK_EN == DEF_ENABLED)
+    if (OSIntNestingCtr > 0u) {                                 /* Not allowed to call from an ISR                      */
+       *p_err = OS_ERR_MEM_CREATE_ISR;
+        return;
+    }
+#endif
+
+#if (OS_CFG_ARG_CHK_EN == DEF_ENABLED)
+    if ((p_slab      == (OS_MEM_SLAB       *)0) ||
+        (p_class_tbl == (OS_MEM_SLAB_CLASS *)0)) {
+       *p_err = OS_ERR_MEM_INVALID_P_MEM;
+        return;
+    }
+    if (n_class == 0u) {                                        /* Must have at least one class                         */
+       *p_err = OS_ERR_MEM_INVALID_PART;
+        return;
+    }
+#endif
+
+    blk_size = 0u;
+    for (i = 0u; i < n_class; i++) {
+        if (p_class_tbl[i].MemPtr == (OS_MEM *)0) {             /* Every class needs a partition                        */
+           *p_err = OS_ERR_MEM_INVALID_PART;
+            return;
+        }
+#if (OS_CFG_OBJ_TYPE_CHK_EN == DEF_ENABLED)
+        if (p_class_tbl[i].MemPtr->Type != OS_OBJ_TYPE_MEM) {   /* Make sure the partition was created                  */
+           *p_err = OS_ERR_OBJ_TYPE;
+            return;
+        }
+#endif
+        if (i == 0u) {
+            blk_size = p_class_tbl[0].MemPtr->BlkSize;
+            if ((blk_size & (blk_size - 1u)) != 0u) {           /* First class must be a power of two ...               */
+               *p_err = OS_ERR_MEM_INVALID_SIZE;
+                return;
+            }
+        } else {
+            if ((OS_MEM_SIZE)(blk_size << 1u) <= blk_size) {    /* ... and each class twice the size of the one before  */
+               *p_err = OS_ERR_MEM_INVALID_SIZE;
+                return;
+            }
+            blk_size <<= 1u;
+            if (p_class_tbl[i].MemPtr->BlkSize != blk_size) {
+               *p_err = OS_ERR_MEM_INVALID_SIZE;
+                return;
+            }
+        }
+        p_class_tbl[i].NbrUsedMax = p_class_tbl[i].MemPtr->NbrMax - p_class_tbl[i].MemPtr->NbrFree;
+        p_class_tbl[i].AllocCtr   = 0u;
+        p_class_tbl[i].SpillCtr   = 0u;
+        p_class_tbl[i].FailCtr    = 0u;
+    }
+
+    CPU_CRITICAL_ENTER();
+#if (OS_OBJ_TYPE_REQ == DEF_ENABLED)
+    p_slab->Type     = OS_OBJ_TYPE_MEM_SLAB;                    /* Set the type of object                               */
+#endif
+#if (OS_CFG_DBG_EN == DEF_ENABLED)
+    p_slab->NamePtr  = p_name;                                  /* Save name of slab                                    */
+#else
+    (void)p_name;
+#endif
+    p_slab->ClassTbl = p_class_tbl;
+    p_slab->NbrClass = n_class;
+    p_slab->MinShift = (CPU_INT08U)(DEF_INT_CPU_NBR_BITS - 1u - CPU_CntLeadZeros((CPU_DATA)p_class_tbl[0].MemPtr->BlkSize));
+    CPU_CRITICAL_EXIT();
+   *p_err = OS_ERR_NONE;
+}
+
+
+/*
+************************************************************************************************************************
+*                                              GET A MEMORY BLOCK BY SIZE
+*
+* Description : Gets a block of at least 'size' bytes from the smallest class of a slab that fits it.
+*
+* Arguments   : p_slab   is a pointer to the slab control block
+*
+*               size     is the number of bytes wanted
+*
+*               p_err    is a pointer to a variable containing an error message which will be set by this function to
+*                        either:
+*
+*                            OS_ERR_NONE               If a block was obtained
+*                            OS_ERR_MEM_INVALID_P_MEM  If you passed a NULL pointer for 'p_slab'
+*                            OS_ERR_MEM_INVALID_SIZE   If 'size' is 0 or larger than the largest class
+*                            OS_ERR_MEM_NO_FREE_BLKS   If the class and all larger ones are empty
+*                            OS_ERR_OBJ_TYPE           If 'p_slab' is not pointing at a slab
+*
+* Returns     : A pointer to a memory block if no error is detected
+*               A pointer to NULL if an error is detected
+*
+* Note(s)     : 1) The class is found in constant time: the number of bits needed for 'size - 1' is the power of two
+*                  of the smallest block that holds 'size' bytes.
+*
+*               2) When the class is empty, the next larger classes are tried in turn (see os.h, SLAB MEMORY
+*                  ALLOCATOR Note #2).
+*
+*               3) Can be called from ISRs, as OSMemGet().
+************************************************************************************************************************
+*/
+
+void  *OSMemSlabAlloc (OS_MEM_SLAB  *p_slab,
+                       OS_MEM_SIZE   size,
+                       OS_ERR       *p_err)
+{
+    OS_MEM_SLAB_CLASS  *p_class;
+    OS_MEM_SLAB_CLASS  *p_class_blk;
+    OS_MEM_SLAB_CLASS  *p_class_end;
+    OS_MEM_QTY          nbr_used;
+    CPU_DATA            shift;
+    void               *p_blk;
+    CPU_SR_ALLOC();
+
+
+
+#ifdef OS_SAFETY_CRITICAL
+    if (p_err == (OS_ERR *)0) {
+        OS_SAFETY_CRITICAL_EXCEPTION();
+        return ((void *)0);
+    }
+#endif
+
+#if (OS_CFG_ARG_CHK_EN == DEF_ENABLED)
+    if (p_slab == (OS_MEM_SLAB *)0) {                           /* Must point to a valid slab                           */
+       *p_err = OS_ERR_MEM_INVALID_P_MEM;
+        return ((void *)0);
+    }
+    if (size == 0u) {
+       *p_err = OS_ERR_MEM_INVALID_SIZE;
+        return ((void *)0);
+    }
+#endif
+
+#if (OS_CFG_OBJ_TYPE_CHK_EN == DEF_ENABLED)
+    if (p_slab->Type != OS_OBJ_TYPE_MEM_SLAB) {                 /* Make sure the slab was created                       */
+       *p_err = OS_ERR_OBJ_TYPE;
+        return ((void *)0);
+    }
+#endif
+
+    shift = 0u;                                                 /* Find the class, see Note #1                          */
+    if (size > 1u) {
+        shift = DEF_INT_CPU_NBR_BITS - CPU_CntLeadZeros((CPU_DATA)size - 1u);
+    }
+    if (shift < p_slab->MinShift) {
+        shift = p_slab->MinShift;
+    }
+    shift -= p_slab->MinShift;
+    if (shift >= p_slab->NbrClass) {                            /* Larger than the largest class                        */
+       *p_err = OS_ERR_MEM_INVALID_SIZE;
+        return ((void *)0);
+    }
+
+    p_class     = &p_slab->ClassTbl[shift];
+    p_class_end = &p_slab->ClassTbl[p_slab->NbrClass];
+    p_blk       = (void *)0;
+    for (p_class_blk = p_class; p_class_blk < p_class_end; p_class_blk++) {
+        p_blk = OSMemGet(p_class_blk->MemPtr, p_err);           /* Fall back on larger classes, see Note #2             */
+        if (p_blk != (void *)0) {
+            break;
+        }
+    }
+
+    CPU_CRITICAL_ENTER();
+    p_class->AllocCtr++;
+    if (p_blk == (void *)0) {
+        p_class->FailCtr++;
+    } else {
+        if (p_class_blk != p_class) {
+            p_class->SpillCtr++;
+        }
+        nbr_used = p_class_blk->MemPtr->NbrMax - p_class_blk->MemPtr->NbrFree;
+        if (p_class_blk->NbrUsedMax < nbr_used) {
+            p_class_blk->NbrUsedMax = nbr_used;
+        }
+    }
+    CPU_CRITICAL_EXIT();
+    return (p_blk);
+}
+
+
+/*
+************************************************************************************************************************
+*                                           RELEASE A MEMORY BLOCK TO A SLAB
+*
+* Description : Returns a block obtained from OSMemSlabAlloc() to the partition it came from.
+*
+* Arguments   : p_slab   is a pointer to the slab control block
+*
+*               p_blk    is a pointer to the memory block being released.
+*
+*               p_err    is a pointer to a variable that will contain an error code returned by this function.
+*
+*                            OS_ERR_NONE               If the memory block was returned
+*                            OS_ERR_MEM_FULL           If the partition was already full (see OSMemPut())
+*                            OS_ERR_MEM_INVALID_P_BLK  If 'p_blk' is not the start of a block of the slab
+*                            OS_ERR_MEM_INVALID_P_MEM  If you passed a NULL pointer for 'p_slab'
+*                            OS_ERR_OBJ_TYPE           If 'p_slab' is not pointing at a slab
+*
+* Returns     : none
+*
+* Note(s)     : 1) The partition is found from the address of the block, so the caller does not have to remember the
+*                  size it asked for.  This takes one compare per class.
+************************************************************************************************************************
+*/
+
+void  OSMemSlabFree (OS_MEM_SLAB  *p_slab,
+                     void         *p_blk,
+                     OS_ERR       *p_err)
+{
+    OS_MEM_SLAB_CLASS  *p_class;
+    OS_MEM_SLAB_CLASS  *p_class_end;
+    OS_MEM             *p_mem;
+    CPU_ADDR            offset;
+
+
+
+#ifdef OS_SAFETY_CRITICAL
+    if (p_err == (OS_ERR *)0) {
+        OS_SAFETY_CRITICAL_EXCEPTION();
+        return;
+    }
+#endif
+
+#if (OS_CFG_ARG_CHK_EN == DEF_ENABLED)
+    if (p_slab == (OS_MEM_SLAB *)0) {                           /* Must point to a valid slab                           */
+       *p_err = OS_ERR_MEM_INVALID_P_MEM;
+        return;
+    }
+    if (p_blk == (void *)0) {                                   /* Must release a valid block                           */
+       *p_err = OS_ERR_MEM_INVALID_P_BLK;
+        return;
+    }
+#endif
+
+#if (OS_CFG_OBJ_TYPE_CHK_EN == DEF_ENABLED)
+    if (p_slab->Type != OS_OBJ_TYPE_MEM_SLAB) {                 /* Make sure the slab was created                       */
+       *p_err = OS_ERR_OBJ_TYPE;
+        return;
+    }
+#endif
+
+    p_class_end = &p_slab->ClassTbl[p_slab->NbrClass];
+    for (p_class = p_slab->ClassTbl; p_class < p_class_end; p_class++) {
+        p_mem  = p_class->MemPtr;                               /* See Note #1                                          */
+        offset = (CPU_ADDR)p_blk - (CPU_ADDR)p_mem->AddrPtr;
+        if (offset < ((CPU_ADDR)p_mem->NbrMax * p_mem->BlkSize)) {
+            if ((offset & ((CPU_ADDR)p_mem->BlkSize - 1u)) != 0u) {
+                break;                                          /* Inside the partition but not at a block start        */
+            }
+            OSMemPut(p_mem, p_blk, p_err);
+            return;
+        }
+    }
+   *p_err = OS_ERR_MEM_INVALID_P_BLK;
+}
+#endif
+
+
 /*
 ************************************************************************************************************************
 *                                           ADD MEMORY PARTITION TO DEBUG LIST
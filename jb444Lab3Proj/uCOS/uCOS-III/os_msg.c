@@ -41,6 +41,87 @@ const  CPU_CHAR  *os_msg__c = "$Id: $";
 
 
 #if (OS_MSG_EN == DEF_ENABLED)
+/*
+************************************************************************************************************************
+*                                                 FUNCTION PROTOTYPES
+************************************************************************************************************************
+*/
+
+static  void  OS_MsgFree     (OS_MSG_Q     *p_msg_q,
+                              OS_MSG       *p_msg);
+
+static  void  OS_MsgPoolLink (OS_MSG_POOL  *p_pool,
+                              OS_MSG       *p_base,
+                              OS_MSG_QTY    size);
+
+
+/*
+************************************************************************************************************************
+*                                               CREATE A MESSAGE POOL
+*
+* Description: This function creates a pool of OS_MSGs that queues can be given with OSQPoolSet() or OSTaskQPoolSet().
+*
+* Arguments  : p_pool    is a pointer to the pool to create.  It is allocated in user memory space.
+*
+*              p_base    is a pointer to storage for 'size' OS_MSGs, also in user memory space.
+*
+*              size      is the number of OS_MSGs in the pool.
+*
+*              p_err     is a pointer to a variable that will contain an error code returned by this function.
+*
+*                            OS_ERR_NONE                 The pool was created
+*                            OS_ERR_CREATE_ISR           If you called this function from an ISR
+*                            OS_ERR_MSG_POOL_EMPTY       If 'size' is 0
+*                            OS_ERR_MSG_POOL_NULL_PTR    If 'p_pool' or 'p_base' is a NULL pointer
+*
+* Returns    : none
+*
+* Note(s)    : 1) A queue takes OS_MSGs from its own pool first.  If that is empty it takes one from OSMsgPool, so
+*                 OS_CFG_MSG_POOL_SIZE is the shared overflow for every queue.  Giving a queue a pool as large as the
+*                 queue means a burst on another queue can never take its OS_MSGs.
+*
+*              2) Each pool keeps its own peak use (NbrUsedMax) and counts the posts that had to fall back to OSMsgPool
+*                 (FallbackCtr).
+************************************************************************************************************************
+*/
+
+#if (OS_CFG_MSG_POOL_LOCAL_EN == DEF_ENABLED)
+void  OSMsgPoolCreate (OS_MSG_POOL  *p_pool,
+                       OS_MSG       *p_base,
+                       OS_MSG_QTY    size,
+                       OS_ERR       *p_err)
+{
+#ifdef OS_SAFETY_CRITICAL
+    if (p_err == (OS_ERR *)0) {
+        OS_SAFETY_CRITICAL_EXCEPTION();
+        return;
+    }
+#endif
+
+#if (OS_CFG_CALLED_FROM_ISR_CHK_EN == DEF_ENABLED)
+    if (OSIntNestingCtr > 0u) {                                 /* Not allowed to be called from an ISR                 */
+       *p_err = OS_ERR_CREATE_ISR;
+        return;
+    }
+#endif
+
+#if (OS_CFG_ARG_CHK_EN == DEF_ENABLED)
+    if ((p_pool == (OS_MSG_POOL *)0) ||
+        (p_base == (OS_MSG      *)0)) {
+       *p_err = OS_ERR_MSG_POOL_NULL_PTR;
+        return;
+    }
+    if (size == 0u) {
+       *p_err = OS_ERR_MSG_POOL_EMPTY;
+        return;
+    }
+#endif
+
+    OS_MsgPoolLink(p_pool, p_base, size);                       /* Not in use by any queue yet                          */
+   *p_err = OS_ERR_NONE;
+}
+#endif
+
 
 /*
 ************************************************************************************************************************
@@ -62,12 +143,6 @@ const  CPU_CHAR  *os_msg__c = "$Id: $";
 
 void  OS_MsgPoolInit (OS_ERR  *p_err)
 {
-    OS_MSG      *p_msg1;
-    OS_MSG      *p_msg2;
-    OS_MSG_QTY   i;
-    OS_MSG_QTY   loops;
-
-
 #if (OS_CFG_ARG_CHK_EN == DEF_ENABLED)
     if (OSCfg_MsgPoolBasePtr == (OS_MSG *)0) {
        *p_err = OS_ERR_MSG_POOL_NULL_PTR;
@@ -79,10 +154,45 @@ void  OS_MsgPoolInit (OS_ERR  *p_err)
     }
 #endif
 
-    p_msg1 = OSCfg_MsgPoolBasePtr;
-    p_msg2 = OSCfg_MsgPoolBasePtr;
+    OS_MsgPoolLink(&OSMsgPool,
+                    OSCfg_MsgPoolBasePtr,
+                    OSCfg_MsgPoolSize);
+   *p_err = OS_ERR_NONE;
+}
+
+
+/*
+************************************************************************************************************************
+*                                              LINK THE OS_MSGs OF A POOL
+*
+* Description: This function places every OS_MSG of a pool's storage in its free list.
+*
+* Arguments  : p_pool    is a pointer to the pool
+*
+*              p_base    is a pointer to the storage of the pool
+*
+*              size      is the number of OS_MSGs in the storage, at least 1
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application MUST NOT call it.
+************************************************************************************************************************
+*/
+
+static  void  OS_MsgPoolLink (OS_MSG_POOL  *p_pool,
+                              OS_MSG       *p_base,
+                              OS_MSG_QTY    size)
+{
+    OS_MSG      *p_msg1;
+    OS_MSG      *p_msg2;
+    OS_MSG_QTY   i;
+    OS_MSG_QTY   loops;
+
+
+    p_msg1 = p_base;
+    p_msg2 = p_base;
     p_msg2++;
-    loops  = OSCfg_MsgPoolSize - 1u;
+    loops  = size - 1u;
     for (i = 0u; i < loops; i++) {                              /* Init. list of free OS_MSGs                           */
         p_msg1->NextPtr = p_msg2;
         p_msg1->MsgPtr  = (void *)0;
@@ -100,13 +210,56 @@ void  OS_MsgPoolInit (OS_ERR  *p_err)
     p_msg1->MsgTS   =           0u;
 #endif
 
-    OSMsgPool.NextPtr    = OSCfg_MsgPoolBasePtr;
-    OSMsgPool.NbrFree    = OSCfg_MsgPoolSize;
-    OSMsgPool.NbrUsed    = 0u;
-#if (OS_CFG_DBG_EN == DEF_ENABLED)
-    OSMsgPool.NbrUsedMax = 0u;
+    p_pool->NextPtr     = p_base;
+    p_pool->NbrFree     = size;
+    p_pool->NbrUsed     = 0u;
+#if ((OS_CFG_DBG_EN == DEF_ENABLED) || (OS_CFG_MSG_POOL_LOCAL_EN == DEF_ENABLED))
+    p_pool->NbrUsedMax  = 0u;
+#endif
+#if (OS_CFG_MSG_POOL_LOCAL_EN == DEF_ENABLED)
+    p_pool->BasePtr     = p_base;
+    p_pool->Size        = size;
+    p_pool->FallbackCtr = 0u;
+#endif
+}
+
+
+/*
+************************************************************************************************************************
+*                                           RETURN AN OS_MSG TO ITS POOL
+*
+* Description: This function returns an OS_MSG taken by OS_MsgQPut() to the pool it came from.
+*
+* Arguments  : p_msg_q     is a pointer to the message queue the OS_MSG was in
+*
+*              p_msg       is a pointer to the OS_MSG
+*
+* Returns    : none
+*
+* Note(s)    : 1) An OS_MSG outside the storage of the queue's pool was a fallback from OSMsgPool.
+************************************************************************************************************************
+*/
+
+static  void  OS_MsgFree (OS_MSG_Q  *p_msg_q,
+                          OS_MSG    *p_msg)
+{
+    OS_MSG_POOL  *p_pool;
+
+
+#if (OS_CFG_MSG_POOL_LOCAL_EN == DEF_ENABLED)
+    p_pool = p_msg_q->PoolPtr;
+    if (((CPU_ADDR)p_msg <  (CPU_ADDR)p_pool->BasePtr) ||       /* See Note #1                                          */
+        ((CPU_ADDR)p_msg >= (CPU_ADDR)&p_pool->BasePtr[p_pool->Size])) {
+        p_pool = &OSMsgPool;
+    }
+#else
+    (void)p_msg_q;
+    p_pool = &OSMsgPool;
 #endif
-   *p_err                = OS_ERR_NONE;
+    p_msg->NextPtr  = p_pool->NextPtr;                          /* Return message control block to free list            */
+    p_pool->NextPtr = p_msg;
+    p_pool->NbrFree++;
+    p_pool->NbrUsed--;
 }
 
 
@@ -128,17 +281,32 @@ void  OS_MsgPoolInit (OS_ERR  *p_err)
 OS_MSG_QTY  OS_MsgQFreeAll (OS_MSG_Q  *p_msg_q)
 {
     OS_MSG      *p_msg;
+#if (OS_CFG_MSG_POOL_LOCAL_EN == DEF_ENABLED)
+    OS_MSG      *p_msg_next;
+#endif
     OS_MSG_QTY   qty;
 
 
 
     qty = p_msg_q->NbrEntries;                                  /* Get the number of OS_MSGs being freed                */
     if (p_msg_q->NbrEntries > 0u) {
-        p_msg                   = p_msg_q->InPtr;               /* Point to end of message chain                        */
-        p_msg->NextPtr          = OSMsgPool.NextPtr;
-        OSMsgPool.NextPtr       = p_msg_q->OutPtr;              /* Point to beginning of message chain                  */
-        OSMsgPool.NbrUsed      -= p_msg_q->NbrEntries;          /* Update statistics for free list of messages          */
-        OSMsgPool.NbrFree      += p_msg_q->NbrEntries;
+#if (OS_CFG_MSG_POOL_LOCAL_EN == DEF_ENABLED)
+        if (p_msg_q->PoolPtr != &OSMsgPool) {                   /* Chain may mix two pools, free one OS_MSG at a time   */
+            p_msg = p_msg_q->OutPtr;
+            while (p_msg != (OS_MSG *)0) {
+                p_msg_next = p_msg->NextPtr;
+                OS_MsgFree(p_msg_q, p_msg);
+                p_msg      = p_msg_next;
+            }
+        } else
+#endif
+        {
+            p_msg               = p_msg_q->InPtr;               /* Point to end of message chain                        */
+            p_msg->NextPtr      = OSMsgPool.NextPtr;
+            OSMsgPool.NextPtr   = p_msg_q->OutPtr;              /* Point to beginning of message chain                  */
+            OSMsgPool.NbrUsed  -= p_msg_q->NbrEntries;          /* Update statistics for free list of messages          */
+            OSMsgPool.NbrFree  += p_msg_q->NbrEntries;
+        }
         p_msg_q->NbrEntries     =           0u;                 /* Flush the message queue                              */
 #if (OS_CFG_DBG_EN == DEF_ENABLED)
         p_msg_q->NbrEntriesMax  =           0u;
@@ -150,6 +318,44 @@ OS_MSG_QTY  OS_MsgQFreeAll (OS_MSG_Q  *p_msg_q)
 }
 
 
+/*
+************************************************************************************************************************
+*                                 RELEASE THE BLOCK REFERENCES HELD BY A MESSAGE QUEUE
+*
+* Description: This function drops the reference held by each message that OSQPostRef() placed in a message queue,
+*              before the messages are discarded by OS_MsgQFreeAll().
+*
+* Arguments  : p_msg_q       is a pointer to the OS_MSG_Q structure containing the messages.
+*              -------
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application MUST NOT call it.
+*
+*              2) The messages stay in the queue.  A block whose last reference this was goes back to its partition.
+************************************************************************************************************************
+*/
+
+#if (OS_CFG_MEM_REF_EN == DEF_ENABLED)
+void  OS_MsgQRefRelease (OS_MSG_Q  *p_msg_q)
+{
+    OS_MSG  *p_msg;
+    OS_ERR   err;
+
+
+
+    p_msg = p_msg_q->OutPtr;
+    while (p_msg != (OS_MSG *)0) {
+        if (p_msg->MsgRef == DEF_YES) {
+            OSMemRefRelease(p_msg->MsgPtr, &err);
+            p_msg->MsgRef = DEF_NO;
+        }
+        p_msg = p_msg->NextPtr;
+    }
+}
+#endif
+
+
 /*
 ************************************************************************************************************************
 *                                               INITIALIZE A MESSAGE QUEUE
@@ -177,6 +383,9 @@ void  OS_MsgQInit (OS_MSG_Q    *p_msg_q,
 #endif
     p_msg_q->InPtr          = (OS_MSG *)0;
     p_msg_q->OutPtr         = (OS_MSG *)0;
+#if (OS_CFG_MSG_POOL_LOCAL_EN == DEF_ENABLED)
+    p_msg_q->PoolPtr        = &OSMsgPool;                       /* Until OSQPoolSet() or OSTaskQPoolSet()               */
+#endif
 }
 
 
@@ -246,10 +455,7 @@ void  *OS_MsgQGet (OS_MSG_Q     *p_msg_q,
         p_msg_q->NbrEntries--;                                  /* Yes, One less message in the queue                   */
     }
 
-    p_msg->NextPtr    = OSMsgPool.NextPtr;                      /* Return message control block to free list            */
-    OSMsgPool.NextPtr = p_msg;
-    OSMsgPool.NbrFree++;
-    OSMsgPool.NbrUsed--;
+    OS_MsgFree(p_msg_q, p_msg);                                 /* Return message control block to its pool             */
 
    *p_err             = OS_ERR_NONE;
     return (p_void);
@@ -274,6 +480,8 @@ void  *OS_MsgQGet (OS_MSG_Q     *p_msg_q,
 *                              OS_OPT_POST_FIFO
 *                              OS_OPT_POST_LIFO
 *
+*                          and with OS_OPT_POST_MEM_REF, that the message holds a block reference
+*
 *              ts          is a timestamp as to when the message was posted
 *
 *              p_err       is a pointer to a variable that will contain an error code returned by this function.
@@ -295,8 +503,9 @@ void  OS_MsgQPut (OS_MSG_Q     *p_msg_q,
                   CPU_TS        ts,
                   OS_ERR       *p_err)
 {
-    OS_MSG  *p_msg;
-    OS_MSG  *p_msg_in;
+    OS_MSG       *p_msg;
+    OS_MSG       *p_msg_in;
+    OS_MSG_POOL  *p_pool;
 
 
 #if (OS_CFG_TS_EN == DEF_DISABLED)
@@ -308,19 +517,30 @@ void  OS_MsgQPut (OS_MSG_Q     *p_msg_q,
         return;
     }
 
-    if (OSMsgPool.NbrFree == 0u) {
+#if (OS_CFG_MSG_POOL_LOCAL_EN == DEF_ENABLED)
+    p_pool = p_msg_q->PoolPtr;
+    if (p_pool->NbrFree == 0u) {                                /* Queue's own pool is empty, fall back to OSMsgPool    */
+        if (p_pool != &OSMsgPool) {
+            p_pool->FallbackCtr++;
+        }
+        p_pool = &OSMsgPool;
+    }
+#else
+    p_pool = &OSMsgPool;
+#endif
+    if (p_pool->NbrFree == 0u) {
        *p_err = OS_ERR_MSG_POOL_EMPTY;                          /* No more OS_MSG to use                                */
         return;
     }
 
-    p_msg = OSMsgPool.NextPtr;                                  /* Remove message control block from free list          */
-    OSMsgPool.NextPtr = p_msg->NextPtr;
-    OSMsgPool.NbrFree--;
-    OSMsgPool.NbrUsed++;
+    p_msg = p_pool->NextPtr;                                    /* Remove message control block from free list          */
+    p_pool->NextPtr = p_msg->NextPtr;
+    p_pool->NbrFree--;
+    p_pool->NbrUsed++;
 
-#if (OS_CFG_DBG_EN == DEF_ENABLED)
-    if (OSMsgPool.NbrUsedMax < OSMsgPool.NbrUsed) {
-        OSMsgPool.NbrUsedMax = OSMsgPool.NbrUsed;
+#if ((OS_CFG_DBG_EN == DEF_ENABLED) || (OS_CFG_MSG_POOL_LOCAL_EN == DEF_ENABLED))
+    if (p_pool->NbrUsedMax < p_pool->NbrUsed) {
+        p_pool->NbrUsedMax = p_pool->NbrUsed;
     }
 #endif
 
@@ -352,6 +572,9 @@ void  OS_MsgQPut (OS_MSG_Q     *p_msg_q,
     p_msg->MsgSize = msg_size;
 #if (OS_CFG_TS_EN == DEF_ENABLED)
     p_msg->MsgTS   = ts;
+#endif
+#if (OS_CFG_MEM_REF_EN == DEF_ENABLED)
+    p_msg->MsgRef  = ((opt & OS_OPT_POST_MEM_REF) != 0u) ? DEF_YES : DEF_NO;
 #endif
    *p_err          = OS_ERR_NONE;
 }
@@ -117,6 +117,9 @@ void  OSMutexCreate (OS_MUTEX  *p_mutex,
     p_mutex->TS                =             0u;
 #endif
     OS_PendListInit(&p_mutex->PendList);                        /* Initialize the waiting list                          */
+#if (OS_CFG_MUTEX_PEND_IDX_EN == DEF_ENABLED)
+    OS_PendListIdxInit(&p_mutex->PendList, &p_mutex->PendListIdx);/* Index the waiting list by priority                  */
+#endif
 
 #if (OS_CFG_DBG_EN == DEF_ENABLED)
     OS_MutexDbgListAdd(p_mutex);
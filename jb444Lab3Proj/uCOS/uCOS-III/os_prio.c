@@ -43,6 +43,9 @@ const  CPU_CHAR  *os_prio__c = "$Id: $";
 CPU_DATA   OSPrioTbl[OS_PRIO_TBL_SIZE];                         /* Declare the array local to this file to allow for  ...*/
                                                                 /* ... optimization.  In other words, this allows the ...*/
                                                                 /* ... table to be located in fast memory                */
+#if (OS_CFG_PRIO_MAX > DEF_INT_CPU_NBR_BITS)
+CPU_DATA   OSPrioGrp;                                           /* One bit per OSPrioTbl[] entry that is not empty       */
+#endif
 
 /*
 ************************************************************************************************************************
@@ -67,6 +70,9 @@ void  OS_PrioInit (void)
     for (i = 0u; i < OS_PRIO_TBL_SIZE; i++) {
          OSPrioTbl[i] = 0u;
     }
+#if (OS_CFG_PRIO_MAX > DEF_INT_CPU_NBR_BITS)
+    OSPrioGrp = 0u;
+#endif
 
 #if (OS_CFG_TASK_IDLE_EN == DEF_DISABLED)
     OS_PrioInsert ((OS_PRIO)(OS_CFG_PRIO_MAX - 1u));            /* Insert what would be the idle task                   */
@@ -85,24 +91,27 @@ void  OS_PrioInit (void)
 * Returns    : The priority of the Highest Priority Task (HPT) waiting for the event
 *
 * Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application MUST NOT call it.
+*
+*              2) With more than DEF_INT_CPU_NBR_BITS priorities, OSPrioGrp has one bit per OSPrioTbl[] entry, in the
+*                 same most-significant-first order, set while that entry is not empty.  The highest priority is then
+*                 found with two CPU_CntLeadZeros() whatever the number of priorities, up to DEF_INT_CPU_NBR_BITS
+*                 squared (1024 with 32-bit CPU_DATA).
 ************************************************************************************************************************
 */
 
 OS_PRIO  OS_PrioGetHighest (void)
 {
-    CPU_DATA  *p_tbl;
     OS_PRIO    prio;
+#if (OS_CFG_PRIO_MAX > DEF_INT_CPU_NBR_BITS)
+    CPU_DATA   ix;
 
 
-    prio  = 0u;
-    p_tbl = &OSPrioTbl[0];
-#if (OS_CFG_PRIO_MAX > DEF_INT_CPU_NBR_BITS)
-    while (*p_tbl == 0u) {                                      /* Search the bitmap table for the highest priority     */
-        prio += (OS_PRIO)DEF_INT_CPU_NBR_BITS;                  /* Compute the step of each CPU_DATA entry              */
-        p_tbl++;
-    }
+    ix    = CPU_CntLeadZeros(OSPrioGrp);                        /* Find the first entry that is not empty, see Note #2  */
+    prio  = (OS_PRIO)(ix * DEF_INT_CPU_NBR_BITS);               /* Compute the step of each CPU_DATA entry              */
+    prio += (OS_PRIO)CPU_CntLeadZeros(OSPrioTbl[ix]);           /* Find the position of the first bit set at the entry  */
+#else
+    prio = (OS_PRIO)CPU_CntLeadZeros(OSPrioTbl[0]);             /* Find the position of the first bit set at the entry  */
 #endif
-    prio += (OS_PRIO)CPU_CntLeadZeros(*p_tbl);                  /* Find the position of the first bit set at the entry  */
 
     return (prio);
 }
@@ -137,6 +146,11 @@ void  OS_PrioInsert (OS_PRIO  prio)
     bit            = 1u;
     bit          <<= (DEF_INT_CPU_NBR_BITS - 1u) - bit_nbr;
     OSPrioTbl[ix] |= bit;
+#if (OS_CFG_PRIO_MAX > DEF_INT_CPU_NBR_BITS)
+    bit            = 1u;
+    bit          <<= (DEF_INT_CPU_NBR_BITS - 1u) - ix;
+    OSPrioGrp     |= bit;                                       /* Entry 'ix' is not empty                              */
+#endif
 }
 
 /*
@@ -169,4 +183,11 @@ void  OS_PrioRemove (OS_PRIO  prio)
     bit            = 1u;
     bit          <<= (DEF_INT_CPU_NBR_BITS - 1u) - bit_nbr;
     OSPrioTbl[ix] &= ~bit;
+#if (OS_CFG_PRIO_MAX > DEF_INT_CPU_NBR_BITS)
+    if (OSPrioTbl[ix] == 0u) {                                  /* Last priority of entry 'ix' removed                  */
+        bit            = 1u;
+        bit          <<= (DEF_INT_CPU_NBR_BITS - 1u) - ix;
+        OSPrioGrp     &= ~bit;
+    }
+#endif
 }
@@ -0,0 +1,398 @@
+/*
+************************************************************************************************************************
+*                                                 RUN-TIME PROFILER
+*                          A uC/OS-III V3.06.01 addition for jb444Lab3Proj, not Micrium code
+*
+* File    : OS_PROF.C
+************************************************************************************************************************
+* Note(s) : (1) All times are in OS_TS_GET() counts.  On the K65 that is the DWT cycle counter, see CPU_TS_TmrInit().
+*
+*           (2) Time spent in ISRs is counted once, in OSProfIntCycles, and is taken out of the cycles of the task it
+*               interrupted.  ISRs must therefore call OSIntEnter() and OSIntExit().
+*
+*           (3) OSProfSnapshot() writes a record that tools/os_prof_decode.py reads.  All fields are little endian:
+*
+*                   Header      "OSPF", u16 version, u16 number of tasks, u32 timestamp frequency (Hz),
+*                               u32 timestamp, u32 ISR cycles, u32 ISR count, u32 longest ISR,
+*                               u32 context switches, u8 histogram bins, u8 bin shift, u8 name size, u8 0
+*
+*                   Per task    u8 priority, u8 state, u16 CPU usage (0..10000), name (zero padded),
+*                               u32 cycles, u32 times switched in, u32 times preempted, u32 longest latency,
+*                               u32 stack bytes used, u32 histogram bins, u32 times switched out with the FP
+*                               registers, u32 context save and restore cycles, u32 longest save and restore
+*
+*           (4) A port that times its context switches calls OS_ProfCtxSw() from OSTaskSwHook().  On the K65 that is the
+*               save and restore in OS_CPU_PendSVHandler(), which handles the FP registers of the tasks that use them
+*               only.
+************************************************************************************************************************
+*/
+
+#define  MICRIUM_SOURCE
+#include "os.h"
+
+#ifdef VSC_INCLUDE_SOURCE_FILE_NAMES
+const  CPU_CHAR  *os_prof__c = "$Id: $";
+#endif
+
+
+#if (OS_CFG_PROF_EN == DEF_ENABLED)
+
+/*
+************************************************************************************************************************
+*                                                   LOCAL FUNCTIONS
+************************************************************************************************************************
+*/
+
+static  CPU_INT08U  *OS_ProfPut16 (CPU_INT08U  *p_dst,
+                                   CPU_INT16U   val);
+
+static  CPU_INT08U  *OS_ProfPut32 (CPU_INT08U  *p_dst,
+                                   CPU_INT32U   val);
+
+
+/*
+************************************************************************************************************************
+*                                               TAKE A PROFILER SNAPSHOT
+*
+* Description: This function copies the kernel's ISR figures and the profile of every task into 'p_buf' as one binary
+*              record (see Note #3 at the top of this file).
+*
+* Arguments  : p_buf      is a pointer to the buffer that receives the record.
+*
+*              buf_size   is the size of the buffer in bytes.
+*
+*              p_err      is a pointer to a variable that will contain an error code returned by this function.
+*
+*                             OS_ERR_NONE                  The record was written
+*                             OS_ERR_OS_NOT_RUNNING        If uC/OS-III is not running yet
+*                             OS_ERR_PROF_BUF_SIZE         If the record does not fit in 'buf_size' bytes
+*                             OS_ERR_PTR_INVALID           If 'p_buf' is a NULL pointer
+*                             OS_ERR_SCHED_LOCK_ISR        If you called this function from an ISR
+*
+* Returns    : The number of bytes written, 0 on error.
+*
+* Note(s)    : 1) The scheduler is locked while the task list is walked so that no task can be deleted under it.  Each
+*                 task is read in its own critical section, so the record is not one instant but never has half a
+*                 task.
+*
+*              2) The size of a record is OS_PROF_HDR_SIZE + OSTaskQty * OS_PROF_TASK_SIZE bytes.
+************************************************************************************************************************
+*/
+
+CPU_SIZE_T  OSProfSnapshot (void        *p_buf,
+                            CPU_SIZE_T   buf_size,
+                            OS_ERR      *p_err)
+{
+    CPU_INT08U  *p_dst;
+    OS_TCB      *p_tcb;
+    CPU_CHAR    *p_name;
+    CPU_SIZE_T   size;
+    CPU_INT32U   stk_used;
+    CPU_INT08U   i;
+    OS_ERR       err;
+    CPU_ERR      cpu_err;
+    CPU_SR_ALLOC();
+
+
+
+#ifdef OS_SAFETY_CRITICAL
+    if (p_err == (OS_ERR *)0) {
+        OS_SAFETY_CRITICAL_EXCEPTION();
+        return (0u);
+    }
+#endif
+
+#if (OS_CFG_ARG_CHK_EN == DEF_ENABLED)
+    if (p_buf == (void *)0) {                                   /* Validate 'p_buf'                                     */
+       *p_err = OS_ERR_PTR_INVALID;
+        return (0u);
+    }
+#endif
+
+    OSSchedLock(&err);                                          /* See Note #1                                          */
+    if (err != OS_ERR_NONE) {
+       *p_err = err;
+        return (0u);
+    }
+
+    size = OS_PROF_HDR_SIZE + (CPU_SIZE_T)OSTaskQty * OS_PROF_TASK_SIZE;
+    if (size > buf_size) {
+        OSSchedUnlock(&err);
+       *p_err = OS_ERR_PROF_BUF_SIZE;
+        return (0u);
+    }
+
+    p_dst    = (CPU_INT08U *)p_buf;                             /* --------------------- HEADER --------------------- */
+   *p_dst++  = (CPU_INT08U)'O';
+   *p_dst++  = (CPU_INT08U)'S';
+   *p_dst++  = (CPU_INT08U)'P';
+   *p_dst++  = (CPU_INT08U)'F';
+    p_dst    = OS_ProfPut16(p_dst, OS_PROF_VERSION);
+    p_dst    = OS_ProfPut16(p_dst, (CPU_INT16U)OSTaskQty);
+    p_dst    = OS_ProfPut32(p_dst, (CPU_INT32U)CPU_TS_TmrFreqGet(&cpu_err));
+    CPU_CRITICAL_ENTER();
+    p_dst    = OS_ProfPut32(p_dst, (CPU_INT32U)OS_TS_GET());
+    p_dst    = OS_ProfPut32(p_dst, (CPU_INT32U)OSProfIntCycles);
+    p_dst    = OS_ProfPut32(p_dst, (CPU_INT32U)OSProfIntCtr);
+    p_dst    = OS_ProfPut32(p_dst, (CPU_INT32U)OSProfIntTimeMax);
+    p_dst    = OS_ProfPut32(p_dst, (CPU_INT32U)OSTaskCtxSwCtr);
+    p_tcb    = OSTaskDbgListPtr;
+    CPU_CRITICAL_EXIT();
+   *p_dst++  = (CPU_INT08U)OS_PROF_LAT_BINS;
+   *p_dst++  = (CPU_INT08U)OS_PROF_LAT_SHIFT;
+   *p_dst++  = (CPU_INT08U)OS_PROF_NAME_SIZE;
+   *p_dst++  = 0u;
+
+    while (p_tcb != (OS_TCB *)0) {                              /* -------------- ONE RECORD PER TASK --------------- */
+        CPU_CRITICAL_ENTER();
+       *p_dst++ = (CPU_INT08U)p_tcb->Prio;
+       *p_dst++ = (CPU_INT08U)p_tcb->TaskState;
+        p_dst   = OS_ProfPut16(p_dst, (CPU_INT16U)p_tcb->CPUUsage);
+        p_name  = p_tcb->NamePtr;
+        for (i = 0u; i < OS_PROF_NAME_SIZE; i++) {              /* Copy the name, zero padded                           */
+            if ((p_name != (CPU_CHAR *)0) && (*p_name != (CPU_CHAR)0)) {
+               *p_dst++ = (CPU_INT08U)*p_name++;
+            } else {
+               *p_dst++ = 0u;
+            }
+        }
+        p_dst   = OS_ProfPut32(p_dst, (CPU_INT32U)p_tcb->ProfCycles);
+        p_dst   = OS_ProfPut32(p_dst, (CPU_INT32U)p_tcb->CtxSwCtr);
+        p_dst   = OS_ProfPut32(p_dst, (CPU_INT32U)p_tcb->ProfPreemptCtr);
+        p_dst   = OS_ProfPut32(p_dst, (CPU_INT32U)p_tcb->ProfLatMax);
+#if (OS_CFG_STAT_TASK_STK_CHK_EN == DEF_ENABLED)
+        stk_used = (CPU_INT32U)p_tcb->StkUsed * (CPU_INT32U)sizeof(CPU_STK);
+#else
+        stk_used = 0u;
+#endif
+        p_dst   = OS_ProfPut32(p_dst, stk_used);
+        for (i = 0u; i < OS_PROF_LAT_BINS; i++) {
+            p_dst = OS_ProfPut32(p_dst, (CPU_INT32U)p_tcb->ProfLatHist[i]);
+        }
+        p_dst   = OS_ProfPut32(p_dst, (CPU_INT32U)p_tcb->ProfFpCtxSwCtr);
+        p_dst   = OS_ProfPut32(p_dst, (CPU_INT32U)p_tcb->ProfCtxSwCycles);
+        p_dst   = OS_ProfPut32(p_dst, (CPU_INT32U)p_tcb->ProfCtxSwMax);
+        p_tcb   = p_tcb->DbgNextPtr;
+        CPU_CRITICAL_EXIT();
+    }
+
+    OSSchedUnlock(&err);
+   *p_err = OS_ERR_NONE;
+    return (size);
+}
+
+
+/*
+************************************************************************************************************************
+*                                               INITIALIZE THE PROFILER
+*
+* Description: This function is called by OSInit() to clear the profiler's ISR figures.
+*
+* Arguments  : none
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application MUST NOT call it.
+************************************************************************************************************************
+*/
+
+void  OS_ProfInit (void)
+{
+    OSProfIntCycles   = 0u;
+    OSProfIntCyclesSw = 0u;
+    OSProfIntCtr      = 0u;
+    OSProfIntTimeMax  = 0u;
+    OSProfIntTS       = 0u;
+}
+
+
+/*
+************************************************************************************************************************
+*                                                  PROFILE ISR ENTRY
+*
+* Description: This function is called by OSIntEnter() after it incremented OSIntNestingCtr.  The outermost ISR takes
+*              a timestamp.
+*
+* Arguments  : none
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application MUST NOT call it.
+*
+*              2) Not every ISR disables interrupts around OSIntEnter() (e.g. DMA0_DMA16_IRQHandler()), so this
+*                 function does.
+************************************************************************************************************************
+*/
+
+void  OS_ProfIntEnter (void)
+{
+    CPU_SR_ALLOC();
+
+
+    CPU_CRITICAL_ENTER();
+    if (OSIntNestingCtr == 1u) {                                /* Outermost ISR?                                       */
+        OSProfIntTS = OS_TS_GET();
+    }
+    CPU_CRITICAL_EXIT();
+}
+
+
+/*
+************************************************************************************************************************
+*                                                   PROFILE ISR EXIT
+*
+* Description: This function is called by OSIntExit() with interrupts disabled, after it decremented OSIntNestingCtr.
+*              When the outermost ISR ends, its time, nested ISRs included, is added to OSProfIntCycles.
+*
+* Arguments  : none
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application MUST NOT call it.
+************************************************************************************************************************
+*/
+
+void  OS_ProfIntExit (void)
+{
+    CPU_TS  delta;
+
+
+    if (OSIntNestingCtr == 0u) {                                /* Outermost ISR?                                       */
+        delta            = OS_TS_GET() - OSProfIntTS;
+        OSProfIntCycles += (OS_CYCLES)delta;
+        OSProfIntCtr++;
+        if (OSProfIntTimeMax < delta) {
+            OSProfIntTimeMax = delta;
+        }
+    }
+}
+
+
+/*
+************************************************************************************************************************
+*                                                PROFILE A TASK SWITCH
+*
+* Description: This function is called by OSTaskSwHook() when OSTCBCurPtr is about to be switched out in favour of
+*              OSTCBHighRdyPtr, before the hook works out OSTCBCurPtr->CyclesDelta.
+*
+* Arguments  : ts         is the timestamp of the switch.
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application MUST NOT call it.
+*
+*              2) ISR time since the last switch is moved past .CyclesStart, so neither .ProfCycles nor .CyclesTotal
+*                 (and so .CPUUsage) count it.
+*
+*              3) .TS is set when a task is made ready by a post, an abort or a timeout.  A .TS not yet seen by this
+*                 function is a new readying, and the time since is the task's latency.  A task that is preempted and
+*                 resumed is not counted again.
+************************************************************************************************************************
+*/
+
+void  OS_ProfTaskSw (CPU_TS  ts)
+{
+    OS_CYCLES   int_cycles;
+    CPU_TS      lat;
+    CPU_DATA    bin;
+
+
+    int_cycles                = OSProfIntCycles;                /* See Note #2                                          */
+    int_cycles               -= OSProfIntCyclesSw;
+    OSProfIntCyclesSw         = OSProfIntCycles;
+    OSTCBCurPtr->CyclesStart += (CPU_TS)int_cycles;
+    OSTCBCurPtr->ProfCycles  += (OS_CYCLES)(ts - OSTCBCurPtr->CyclesStart);
+    if (OSTCBCurPtr->TaskState == OS_TASK_STATE_RDY) {          /* Switched out while still ready?                      */
+        OSTCBCurPtr->ProfPreemptCtr++;
+    }
+
+    if (OSTCBHighRdyPtr->TS != OSTCBHighRdyPtr->ProfRdyTS) {    /* See Note #3                                          */
+        OSTCBHighRdyPtr->ProfRdyTS = OSTCBHighRdyPtr->TS;
+        lat                        = ts - OSTCBHighRdyPtr->TS;
+        if (OSTCBHighRdyPtr->ProfLatMax < lat) {
+            OSTCBHighRdyPtr->ProfLatMax = lat;
+        }
+        bin = (CPU_DATA)(lat >> OS_PROF_LAT_SHIFT);
+        if (bin != 0u) {
+            bin = (CPU_DATA)DEF_INT_CPU_NBR_BITS - (CPU_DATA)CPU_CntLeadZeros(bin);
+            if (bin > (OS_PROF_LAT_BINS - 1u)) {
+                bin = OS_PROF_LAT_BINS - 1u;
+            }
+        }
+        OSTCBHighRdyPtr->ProfLatHist[bin]++;
+    }
+}
+
+
+/*
+************************************************************************************************************************
+*                                              PROFILE A TASK'S CONTEXT
+*
+* Description: This function is called by OSTaskSwHook() for the task being switched out, once its context is saved.
+*              It counts the cycles the port spent on the context and whether the FP registers were part of it (see
+*              Note #4 at the top of this file).
+*
+* Arguments  : p_tcb      is a pointer to the OS_TCB of the task switched out.
+*
+*              fp         is DEF_TRUE if its FP registers were saved, DEF_FALSE if not.
+*
+*              cycles     is the number of OS_TS_GET() counts spent restoring the context when the task was switched
+*                         in and saving it now.
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application MUST NOT call it.
+*
+*              2) This function is assumed to be called with interrupts disabled.
+************************************************************************************************************************
+*/
+
+void  OS_ProfCtxSw (OS_TCB       *p_tcb,
+                    CPU_BOOLEAN   fp,
+                    CPU_TS        cycles)
+{
+    if (fp == DEF_TRUE) {
+        p_tcb->ProfFpCtxSwCtr++;
+    }
+    p_tcb->ProfCtxSwCycles += (OS_CYCLES)cycles;
+    if (p_tcb->ProfCtxSwMax < cycles) {
+        p_tcb->ProfCtxSwMax = cycles;
+    }
+}
+
+
+/*
+************************************************************************************************************************
+*                                              STORE LITTLE ENDIAN VALUES
+*
+* Description: These functions store 'val' at 'p_dst', least significant byte first, and return the next free byte.
+*
+* Arguments  : p_dst      is where to store the value.
+*
+*              val        is the value to store.
+*
+* Returns    : p_dst advanced past the value.
+*
+* Note(s)    : none
+************************************************************************************************************************
+*/
+
+static  CPU_INT08U  *OS_ProfPut16 (CPU_INT08U  *p_dst,
+                                   CPU_INT16U   val)
+{
+   *p_dst++ = (CPU_INT08U)(val      );
+   *p_dst++ = (CPU_INT08U)(val >> 8u);
+    return (p_dst);
+}
+
+
+static  CPU_INT08U  *OS_ProfPut32 (CPU_INT08U  *p_dst,
+                                   CPU_INT32U   val)
+{
+   *p_dst++ = (CPU_INT08U)(val       );
+   *p_dst++ = (CPU_INT08U)(val >>  8u);
+   *p_dst++ = (CPU_INT08U)(val >> 16u);
+   *p_dst++ = (CPU_INT08U)(val >> 24u);
+    return (p_dst);
+}
+#endif
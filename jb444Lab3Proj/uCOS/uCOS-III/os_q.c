@@ -123,6 +123,9 @@ void  OSQCreate (OS_Q        *p_q,
     OS_MsgQInit(&p_q->MsgQ,                                     /* Initialize the queue                                 */
                 max_qty);
     OS_PendListInit(&p_q->PendList);                            /* Initialize the waiting list                          */
+#if (OS_CFG_Q_PEND_IDX_EN == DEF_ENABLED)
+    OS_PendListIdxInit(&p_q->PendList, &p_q->PendListIdx);      /* Index the waiting list by priority                  */
+#endif
 
 #if (OS_CFG_DBG_EN == DEF_ENABLED)
     OS_QDbgListAdd(p_q);
@@ -168,6 +171,8 @@ void  OSQCreate (OS_Q        *p_q,
 *
 *              2) Because ALL tasks pending on the queue will be readied, you MUST be careful in applications where the
 *                 queue is used for mutual exclusion because the resource(s) will no longer be guarded by the queue.
+*
+*              3) The references held by messages posted with OSQPostRef() are released.
 ************************************************************************************************************************
 */
 
@@ -310,6 +315,8 @@ OS_OBJ_QTY  OSQDel (OS_Q    *p_q,
 *                  references to what the queue entries are pointing to and thus, you could cause 'memory leaks'.  In
 *                  other words, the data you are pointing to that's being referenced by the queue entries should, most
 *                  likely, need to be de-allocated (i.e. freed).
+*
+*               2) The references held by messages posted with OSQPostRef() are released.
 ************************************************************************************************************************
 */
 
@@ -358,6 +365,9 @@ OS_MSG_QTY  OSQFlush (OS_Q    *p_q,
 #endif
 
     CPU_CRITICAL_ENTER();
+#if (OS_CFG_MEM_REF_EN == DEF_ENABLED)
+    OS_MsgQRefRelease(&p_q->MsgQ);                              /* See Note #2                                          */
+#endif
     entries = OS_MsgQFreeAll(&p_q->MsgQ);                       /* Return all OS_MSGs to the OS_MSG pool                */
     CPU_CRITICAL_EXIT();
    *p_err   = OS_ERR_NONE;
@@ -715,6 +725,84 @@ OS_OBJ_QTY  OSQPendAbort (OS_Q    *p_q,
 #endif
 
 
+/*
+************************************************************************************************************************
+*                                          GIVE A QUEUE ITS OWN MESSAGE POOL
+*
+* Description: This function makes a message queue take its OS_MSGs from 'p_pool' first (see OSMsgPoolCreate()).
+*
+* Arguments  : p_q       is a pointer to the message queue
+*
+*              p_pool    is a pointer to a pool created by OSMsgPoolCreate(), or a NULL pointer to go back to OSMsgPool
+*
+*              p_err     is a pointer to a variable that will contain an error code returned by this function.
+*
+*                            OS_ERR_NONE              The pool was set
+*                            OS_ERR_OBJ_PTR_NULL      If 'p_q' is a NULL pointer
+*                            OS_ERR_OBJ_TYPE          If 'p_q' is not pointing at a message queue
+*                            OS_ERR_Q_NOT_EMPTY       If the queue holds messages
+*                            OS_ERR_SET_ISR           If you called this function from an ISR
+*
+* Returns    : none
+*
+* Note(s)    : 1) Several queues may share a pool.  The queue must be empty so that every OS_MSG goes back to the
+*                 pool it came from.
+************************************************************************************************************************
+*/
+
+#if (OS_CFG_MSG_POOL_LOCAL_EN == DEF_ENABLED)
+void  OSQPoolSet (OS_Q         *p_q,
+                  OS_MSG_POOL  *p_pool,
+                  OS_ERR       *p_err)
+{
+    CPU_SR_ALLOC();
+
+
+#ifdef OS_SAFETY_CRITICAL
+    if (p_err == (OS_ERR *)0) {
+        OS_SAFETY_CRITICAL_EXCEPTION();
+        return;
+    }
+#endif
+
+#if (OS_CFG_CALLED_FROM_ISR_CHK_EN == DEF_ENABLED)
+    if (OSIntNestingCtr > 0u) {                                 /* Not allowed to be called from an ISR                 */
+       *p_err = OS_ERR_SET_ISR;
+        return;
+    }
+#endif
+
+#if (OS_CFG_ARG_CHK_EN == DEF_ENABLED)
+    if (p_q == (OS_Q *)0) {                                     /* Validate 'p_q'                                       */
+       *p_err = OS_ERR_OBJ_PTR_NULL;
+        return;
+    }
+#endif
+
+#if (OS_CFG_OBJ_TYPE_CHK_EN == DEF_ENABLED)
+    if (p_q->Type != OS_OBJ_TYPE_Q) {                           /* Make sure message queue was created                  */
+       *p_err = OS_ERR_OBJ_TYPE;
+        return;
+    }
+#endif
+
+    if (p_pool == (OS_MSG_POOL *)0) {                           /* Back to the shared pool                              */
+        p_pool = &OSMsgPool;
+    }
+
+    CPU_CRITICAL_ENTER();
+    if (p_q->MsgQ.NbrEntries > 0u) {                            /* See Note #1                                          */
+        CPU_CRITICAL_EXIT();
+       *p_err = OS_ERR_Q_NOT_EMPTY;
+        return;
+    }
+    p_q->MsgQ.PoolPtr = p_pool;
+    CPU_CRITICAL_EXIT();
+   *p_err = OS_ERR_NONE;
+}
+#endif
+
+
 /*
 ************************************************************************************************************************
 *                                               POST MESSAGE TO A QUEUE
@@ -761,6 +849,7 @@ OS_OBJ_QTY  OSQPendAbort (OS_Q    *p_q,
 *                                OS_ERR_OPT_INVALID       You specified an invalid option
 *                                OS_ERR_OS_NOT_RUNNING    If uC/OS-III is not running yet
 *                                OS_ERR_Q_MAX             If the queue is full
+*                                OS_ERR_INT_Q_FULL        If called from an ISR and the ISR post queue is full
 *
 * Returns    : None
 *
@@ -806,7 +895,7 @@ void  OSQPost (OS_Q         *p_q,
        *p_err = OS_ERR_OBJ_PTR_NULL;
         return;
     }
-    switch (opt) {                                              /* Validate 'opt'                                       */
+    switch (opt & (OS_OPT)~OS_OPT_POST_MEM_REF) {               /* Validate 'opt'                                       */
         case OS_OPT_POST_FIFO:
         case OS_OPT_POST_LIFO:
         case OS_OPT_POST_FIFO | OS_OPT_POST_ALL:
@@ -833,6 +922,15 @@ void  OSQPost (OS_Q         *p_q,
         return;
     }
 #endif
+
+#if (OS_CFG_ISR_POST_DEFERRED_EN == DEF_ENABLED)
+    if (OSIntNestingCtr > 0u) {                                 /* Called from an ISR: leave the post to OS_IntQTask()  */
+        OS_IntQPost(OS_OBJ_TYPE_Q, (void *)p_q, p_void, msg_size, 0u, opt, p_err);
+        OS_TRACE_Q_POST_EXIT(*p_err);
+        return;
+    }
+#endif
+
 #if (OS_CFG_TS_EN == DEF_ENABLED)
     ts = OS_TS_GET();                                           /* Get timestamp                                        */
 #else
@@ -849,6 +947,9 @@ void  OSQPost (OS_Q         *p_q,
         } else {
             post_type = OS_OPT_POST_LIFO;
         }
+#if (OS_CFG_MEM_REF_EN == DEF_ENABLED)
+        post_type |= opt & OS_OPT_POST_MEM_REF;                 /* Tag the reference for OSQFlush() and OSQDel()        */
+#endif
         OS_MsgQPut(&p_q->MsgQ,                                  /* Place message in the message queue                   */
                    p_void,
                    msg_size,
@@ -885,6 +986,96 @@ void  OSQPost (OS_Q         *p_q,
 }
 
 
+/*
+************************************************************************************************************************
+*                                       POST A REFERENCE-COUNTED MESSAGE TO A QUEUE
+*
+* Description: This function sends a block obtained from OSMemRefGet() to a queue without copying it.  The queue gets
+*              its own reference, so the sender may release its reference or post the same block to other queues.
+*
+* Arguments  : p_q           is a pointer to a message queue that must have been created by OSQCreate().
+*
+*              p_data        is the address returned by OSMemRefGet()
+*
+*              msg_size      specifies the size of the message (in bytes)
+*
+*              opt           determines the type of POST performed:
+*
+*                                OS_OPT_POST_FIFO         POST message to end of queue (FIFO) and wake up a single
+*                                                         waiting task.
+*                                OS_OPT_POST_LIFO         POST message to the front of the queue (LIFO) and wake up
+*                                                         a single waiting task.
+*                                OS_OPT_POST_NO_SCHED     Do not call the scheduler
+*
+*              p_err         is a pointer to a variable that will contain an error code returned by this function.
+*
+*                                OS_ERR_NONE                 The call was successful and the message was sent
+*                                OS_ERR_MEM_INVALID_P_DATA   If 'p_data' is not a held reference-counted block
+*                                OS_ERR_OPT_INVALID          You specified OS_OPT_POST_ALL (see Note #2)
+*                                OS_ERR_???                  An error code returned by OSQPost()
+*
+* Returns    : None
+*
+* Note(s)    : 1) The task that gets the message from OSQPend() holds the queue's reference and must call
+*                 OSMemRefRelease() when it is done with it.  The block returns to its partition on the last release.
+*
+*              2) OS_OPT_POST_ALL would hand one reference to several tasks, so it is rejected.  Post to one queue per
+*                 receiver instead.
+*
+*              3) If the post fails the queue's reference is dropped again.  This includes a post from an ISR that
+*                 OS_IntQTask() can not complete.
+*
+*              4) The message is tagged with OS_OPT_POST_MEM_REF while it waits in the queue, so that OSQFlush() and
+*                 OSQDel() release the queue's reference when they discard it.  A task that was waiting gets the
+*                 reference directly.
+************************************************************************************************************************
+*/
+
+#if (OS_CFG_MEM_REF_EN == DEF_ENABLED)
+void  OSQPostRef (OS_Q         *p_q,
+                  void         *p_data,
+                  OS_MSG_SIZE   msg_size,
+                  OS_OPT        opt,
+                  OS_ERR       *p_err)
+{
+    OS_ERR  err;
+
+
+
+#ifdef OS_SAFETY_CRITICAL
+    if (p_err == (OS_ERR *)0) {
+        OS_SAFETY_CRITICAL_EXCEPTION();
+        return;
+    }
+#endif
+
+    if ((opt & OS_OPT_POST_ALL) != 0u) {                        /* One reference can not go to several tasks            */
+       *p_err = OS_ERR_OPT_INVALID;
+        return;
+    }
+
+    OSMemRefAdd(p_data, p_err);                                 /* Reference held by the queue                          */
+    if (*p_err != OS_ERR_NONE) {
+        return;
+    }
+
+#if (OS_CFG_ISR_POST_DEFERRED_EN == DEF_ENABLED)
+    if (OSIntNestingCtr > 0u) {                                 /* OS_IntQTask() releases it if the post fails          */
+        OS_IntQPost(OS_OBJ_TYPE_Q_REF, (void *)p_q, p_data, msg_size, 0u, opt, p_err);
+    } else {
+        OSQPost(p_q, p_data, msg_size, opt | OS_OPT_POST_MEM_REF, p_err);
+    }
+#else
+    OSQPost(p_q, p_data, msg_size, opt | OS_OPT_POST_MEM_REF, p_err);
+#endif
+
+    if (*p_err != OS_ERR_NONE) {                                /* Not posted, drop the queue's reference               */
+        OSMemRefRelease(p_data, &err);
+    }
+}
+#endif
+
+
 /*
 ************************************************************************************************************************
 *                                        CLEAR THE CONTENTS OF A MESSAGE QUEUE
@@ -903,6 +1094,9 @@ void  OSQPost (OS_Q         *p_q,
 
 void  OS_QClr (OS_Q  *p_q)
 {
+#if (OS_CFG_MEM_REF_EN == DEF_ENABLED)
+    OS_MsgQRefRelease(&p_q->MsgQ);                              /* Release references held by OSQPostRef() messages     */
+#endif
     (void)OS_MsgQFreeAll(&p_q->MsgQ);                           /* Return all OS_MSGs to the free list                  */
 #if (OS_OBJ_TYPE_REQ == DEF_ENABLED)
     p_q->Type    =  OS_OBJ_TYPE_NONE;                           /* Mark the data structure as a NONE                    */
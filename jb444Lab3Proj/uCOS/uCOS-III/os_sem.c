@@ -120,6 +120,9 @@ void  OSSemCreate (OS_SEM      *p_sem,
     (void)p_name;
 #endif
     OS_PendListInit(&p_sem->PendList);                          /* Initialize the waiting list                          */
+#if (OS_CFG_SEM_PEND_IDX_EN == DEF_ENABLED)
+    OS_PendListIdxInit(&p_sem->PendList, &p_sem->PendListIdx);  /* Index the waiting list by priority                  */
+#endif
 
 #if (OS_CFG_DBG_EN == DEF_ENABLED)
     OS_SemDbgListAdd(p_sem);
@@ -666,6 +669,7 @@ OS_OBJ_QTY  OSSemPendAbort (OS_SEM  *p_sem,
 *                           OS_ERR_OPT_INVALID       If you specified an invalid option
 *                           OS_ERR_OS_NOT_RUNNING    If uC/OS-III is not running yet
 *                           OS_ERR_SEM_OVF           If the post would cause the semaphore count to overflow
+*                           OS_ERR_INT_Q_FULL        If called from an ISR and the ISR post queue is full
 *
 * Returns    : The current value of the semaphore counter or 0 upon error.
 *
@@ -732,6 +736,15 @@ OS_SEM_CTR  OSSemPost (OS_SEM  *p_sem,
         return (0u);
     }
 #endif
+
+#if (OS_CFG_ISR_POST_DEFERRED_EN == DEF_ENABLED)
+    if (OSIntNestingCtr > 0u) {                                 /* Called from an ISR: leave the post to OS_IntQTask()  */
+        OS_IntQPost(OS_OBJ_TYPE_SEM, (void *)p_sem, (void *)0, 0u, 0u, opt, p_err);
+        OS_TRACE_SEM_POST_EXIT(*p_err);
+        return (0u);
+    }
+#endif
+
 #if (OS_CFG_TS_EN == DEF_ENABLED)
     ts = OS_TS_GET();                                           /* Get timestamp                                        */
 #else
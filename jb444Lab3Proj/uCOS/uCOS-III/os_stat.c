@@ -68,6 +68,9 @@ void  OSStatReset (OS_ERR  *p_err)
 #if (OS_CFG_Q_EN == DEF_ENABLED)
     OS_Q        *p_q;
 #endif
+#endif
+#if (OS_CFG_PROF_EN == DEF_ENABLED)
+    CPU_INT08U   bin;
 #endif
     CPU_SR_ALLOC();
 
@@ -109,9 +112,16 @@ void  OSStatReset (OS_ERR  *p_err)
     OSSchedLockTimeMax    = 0u;                                 /* Reset the maximum scheduler lock time                */
 #endif
 
-#if ((OS_MSG_EN == DEF_ENABLED) && (OS_CFG_DBG_EN == DEF_ENABLED))
+#if ((OS_MSG_EN == DEF_ENABLED) && ((OS_CFG_DBG_EN == DEF_ENABLED) || (OS_CFG_MSG_POOL_LOCAL_EN == DEF_ENABLED)))
     OSMsgPool.NbrUsedMax  = 0u;
 #endif
+
+#if (OS_CFG_PROF_EN == DEF_ENABLED)
+    OSProfIntCycles       = 0u;                                 /* Reset the run-time profiler                          */
+    OSProfIntCyclesSw     = 0u;
+    OSProfIntCtr          = 0u;
+    OSProfIntTimeMax      = 0u;
+#endif
     CPU_CRITICAL_EXIT();
 
 #if (OS_CFG_DBG_EN == DEF_ENABLED)
@@ -144,6 +154,16 @@ void  OSStatReset (OS_ERR  *p_err)
 #endif
 #endif
 
+#if (OS_CFG_PROF_EN == DEF_ENABLED)
+        p_tcb->ProfCycles       = 0u;
+        p_tcb->ProfPreemptCtr   = 0u;
+        p_tcb->ProfRdyTS        = p_tcb->TS;                    /* Do not count a readying from before the reset        */
+        p_tcb->ProfLatMax       = 0u;
+        for (bin = 0u; bin < OS_PROF_LAT_BINS; bin++) {
+            p_tcb->ProfLatHist[bin] = 0u;
+        }
+#endif
+
 #if (OS_CFG_TASK_Q_EN == DEF_ENABLED)
         p_msg_q                 = &p_tcb->MsgQ;
         p_msg_q->NbrEntriesMax  = 0u;
@@ -292,6 +312,11 @@ void  OSStatTaskCPUUsageInit (OS_ERR  *p_err)
 *                 for the idle counter.
 *
 *              4) This function is INTERNAL to uC/OS-III and your application should not call it.
+*
+*              5) When the idle task sleeps (see os.h, CPU USAGE), the idle counter is not used.  CPU usage is instead the
+*                 cycles of every task but the idle task, plus the ISR cycles, over the cycles in the ticks elapsed since
+*                 the last pass.  Each task's usage is taken over the same wall clock time.  A pass delayed by more than
+*                 2^32 cycles overflows OS_CYCLES and is not supported.
 ************************************************************************************************************************
 */
 
@@ -307,9 +332,19 @@ void  OS_StatTask (void  *p_arg)
 #endif
     OS_TCB      *p_tcb;
 #endif
+#if (OS_STAT_CYCLES_EN == DEF_ENABLED)
+    OS_CYCLES    cycles_busy;
+    OS_CYCLES    cycles_int;
+    OS_CYCLES    cycles_int_prev;
+    OS_CYCLES    cycles_tick;
+    OS_TICK      tick_prev;
+    OS_TICK      ticks;
+    CPU_ERR      cpu_err;
+#else
     OS_TICK      ctr_max;
     OS_TICK      ctr_mult;
     OS_TICK      ctr_div;
+#endif
     OS_ERR       err;
     OS_TICK      dly;
 #if (OS_CFG_TS_EN == DEF_ENABLED)
@@ -337,6 +372,14 @@ void  OS_StatTask (void  *p_arg)
         dly =  (OSCfg_TickRate_Hz / 10u);
     }
 
+#if (OS_STAT_CYCLES_EN == DEF_ENABLED)
+    cycles_tick     = (OS_CYCLES)(CPU_TS_TmrFreqGet(&cpu_err) / OSCfg_TickRate_Hz);
+    CPU_CRITICAL_ENTER();
+    tick_prev       = OSTickCtr;
+    cycles_int_prev = OSProfIntCycles;
+    CPU_CRITICAL_EXIT();
+#endif
+
     for (;;) {
 #if (OS_CFG_TS_EN == DEF_ENABLED)
         ts_start        = OS_TS_GET();
@@ -345,6 +388,16 @@ void  OS_StatTask (void  *p_arg)
 #endif
 #endif
 
+#if (OS_STAT_CYCLES_EN == DEF_ENABLED)
+        CPU_CRITICAL_ENTER();                                   /* ---------- ELAPSED TICKS AND ISR CYCLES ------------ */
+        OSStatTaskCtrRun   = OSStatTaskCtr;
+        OSStatTaskCtr      = 0u;
+        ticks              = OSTickCtr - tick_prev;             /* See Note #5                                          */
+        tick_prev         += ticks;
+        cycles_int         = OSProfIntCycles - cycles_int_prev;
+        cycles_int_prev   += cycles_int;
+        CPU_CRITICAL_EXIT();
+#else
         CPU_CRITICAL_ENTER();                                   /* ---------------- OVERALL CPU USAGE ----------------- */
         OSStatTaskCtrRun   = OSStatTaskCtr;                     /* Obtain the of the stat counter for the past .1 second*/
         OSStatTaskCtr      = 0u;                                /* Reset the stat counter for the next .1 second        */
@@ -377,11 +430,15 @@ void  OS_StatTask (void  *p_arg)
         }
 
         OSStatTaskHook();                                       /* Invoke user definable hook                           */
+#endif
 
 
 #if (OS_CFG_DBG_EN == DEF_ENABLED)
 #if (OS_CFG_TASK_PROFILE_EN == DEF_ENABLED)
         cycles_total = 0u;
+#if (OS_STAT_CYCLES_EN == DEF_ENABLED)
+        cycles_busy  = cycles_int;
+#endif
 
         CPU_CRITICAL_ENTER();
         p_tcb = OSTaskDbgListPtr;
@@ -393,11 +450,19 @@ void  OS_StatTask (void  *p_arg)
             CPU_CRITICAL_EXIT();
 
             cycles_total          += p_tcb->CyclesTotalPrev;    /* Perform sum of all task # cycles                     */
+#if (OS_STAT_CYCLES_EN == DEF_ENABLED)
+            if (p_tcb != &OSIdleTaskTCB) {
+                cycles_busy       += p_tcb->CyclesTotalPrev;
+            }
+#endif
 
             CPU_CRITICAL_ENTER();
             p_tcb                  = p_tcb->DbgNextPtr;
             CPU_CRITICAL_EXIT();
         }
+#if (OS_STAT_CYCLES_EN == DEF_ENABLED)
+        cycles_total = (OS_CYCLES)ticks * cycles_tick;          /* Wall clock, CYCCNT stops while idle sleeps           */
+#endif
 #endif
 
 
@@ -425,6 +490,18 @@ void  OS_StatTask (void  *p_arg)
             cycles_mult = 0u;
             cycles_max  = 1u;
         }
+#endif
+#if (OS_STAT_CYCLES_EN == DEF_ENABLED)
+                                                                /* ---------------- OVERALL CPU USAGE ----------------- */
+        if (cycles_busy > cycles_total) {                       /* Tick and cycle counts are read at different times    */
+            cycles_busy = cycles_total;
+        }
+        OSStatTaskCPUUsage = (OS_CPU_USAGE)(cycles_mult * cycles_busy / cycles_max);
+        if (OSStatTaskCPUUsageMax < OSStatTaskCPUUsage) {
+            OSStatTaskCPUUsageMax = OSStatTaskCPUUsage;
+        }
+
+        OSStatTaskHook();                                       /* Invoke user definable hook                           */
 #endif
         CPU_CRITICAL_ENTER();
         p_tcb = OSTaskDbgListPtr;
@@ -457,6 +534,11 @@ void  OS_StatTask (void  *p_arg)
         if (OSStatResetFlag == DEF_TRUE) {                      /* Check if need to reset statistics                    */
             OSStatResetFlag  = DEF_FALSE;
             OSStatReset(&err);
+#if (OS_STAT_CYCLES_EN == DEF_ENABLED)
+            CPU_CRITICAL_ENTER();
+            cycles_int_prev  = OSProfIntCycles;                 /* The reset cleared the ISR cycles                     */
+            CPU_CRITICAL_EXIT();
+#endif
         }
 
 #if (OS_CFG_TS_EN == DEF_ENABLED)
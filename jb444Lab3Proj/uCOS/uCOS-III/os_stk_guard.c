@@ -0,0 +1,157 @@
+/*
+************************************************************************************************************************
+*                                                    STACK GUARD
+*                          A uC/OS-III V3.06.01 addition for jb444Lab3Proj, not Micrium code
+*
+* File    : OS_STK_GUARD.C
+************************************************************************************************************************
+* Note(s) : (1) Each task stack, and the ISR stack, gets a guard of OS_STK_GUARD_SIZE bytes near its low end.  The port
+*               traps a write to the guard of the running task and to the guard of the ISR stack as it happens, and
+*               calls OSStkGuardHitHook().  A port provides:
+*
+*                   OS_CPU_StkGuardInit(p_isr_guard)    Arms the guard of the ISR stack for good
+*                   OS_CPU_StkGuardSet(p_guard)         Arms the guard of the task being switched in, none if NULL
+*
+*           (2) .StkUsedMax is the most stack a task had in use when it was switched out, taken from its saved stack
+*               pointer at each switch.  It costs a compare per switch instead of a scan of every stack, but misses
+*               peaks between switches.  The guard catches those that would overflow.
+*
+*           (3) .StkUsedMax is reported on its own and is not a substitute for OSTaskStkChk().  A peak between two
+*               switches is missed by it but not by the scan, so .StkUsed and .StkFree still come from OSTaskStkChk().
+************************************************************************************************************************
+*/
+
+#define  MICRIUM_SOURCE
+#include "os.h"
+
+#ifdef VSC_INCLUDE_SOURCE_FILE_NAMES
+const  CPU_CHAR  *os_stk_guard__c = "$Id: $";
+#endif
+
+
+#if (OS_CFG_STK_GUARD_EN == DEF_ENABLED)
+
+/*
+************************************************************************************************************************
+*                                                   LOCAL FUNCTIONS
+************************************************************************************************************************
+*/
+
+static  CPU_STK  *OS_StkGuardFind (CPU_STK       *p_base,
+                                   CPU_STK_SIZE   size);
+
+
+/*
+************************************************************************************************************************
+*                                              INITIALIZE THE STACK GUARD
+*
+* Description: This function is called by OSInit() to arm the guard of the ISR stack.
+*
+* Arguments  : none
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application MUST NOT call it.
+************************************************************************************************************************
+*/
+
+void  OS_StkGuardInit (void)
+{
+    OS_CPU_StkGuardInit(OS_StkGuardFind(OSCfg_ISRStkBasePtr, OSCfg_ISRStkSize));
+}
+
+
+/*
+************************************************************************************************************************
+*                                             SET UP THE GUARD OF A TASK
+*
+* Description: This function is called by OSTaskCreate() once the task's stack frame is built.  It finds the task's
+*              guard and starts its high-water mark at the stack frame.
+*
+* Arguments  : p_tcb      is a pointer to the task's OS_TCB.
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application MUST NOT call it.
+************************************************************************************************************************
+*/
+
+void  OS_StkGuardTaskInit (OS_TCB  *p_tcb)
+{
+    p_tcb->StkGuardPtr = OS_StkGuardFind(p_tcb->StkBasePtr, p_tcb->StkSize);
+    p_tcb->StkUsedMax  = (CPU_STK_SIZE)((p_tcb->StkBasePtr + p_tcb->StkSize) - p_tcb->StkPtr);
+}
+
+
+/*
+************************************************************************************************************************
+*                                               SWITCH THE STACK GUARD
+*
+* Description: This function is called by OSTaskSwHook().  It updates the high-water mark of the task being switched
+*              out (see Note #2 at the top of the file) and arms the guard of the task being switched in.
+*
+* Arguments  : none
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application MUST NOT call it.
+*
+*              2) The port must have saved the stack pointer of OSTCBCurPtr before it calls OSTaskSwHook().
+*
+*              3) A task that deleted itself has had its OS_TCB cleared, so its stack pointer is outside its stack.
+************************************************************************************************************************
+*/
+
+void  OS_StkGuardTaskSw (void)
+{
+    OS_TCB        *p_tcb;
+    CPU_STK       *p_top;
+    CPU_STK_SIZE   used;
+
+
+    p_tcb = OSTCBCurPtr;
+    p_top = p_tcb->StkBasePtr + p_tcb->StkSize;
+    if ((p_tcb->StkPtr >= p_tcb->StkBasePtr) &&                 /* See Note #3                                          */
+        (p_tcb->StkPtr <  p_top)) {
+        used = (CPU_STK_SIZE)(p_top - p_tcb->StkPtr);
+        if (p_tcb->StkUsedMax < used) {
+            p_tcb->StkUsedMax = used;
+        }
+    }
+
+    OS_CPU_StkGuardSet(OSTCBHighRdyPtr->StkGuardPtr);
+}
+
+
+/*
+************************************************************************************************************************
+*                                              FIND THE GUARD OF A STACK
+*
+* Description: This function returns the first address in a stack that is a multiple of OS_STK_GUARD_SIZE, where the
+*              guard starts.
+*
+* Arguments  : p_base     is the lowest address of the stack.
+*
+*              size       is the size of the stack in CPU_STK elements.
+*
+* Returns    : The start of the guard, or NULL if the guard and its alignment would take more than a quarter of the
+*              stack.
+************************************************************************************************************************
+*/
+
+static  CPU_STK  *OS_StkGuardFind (CPU_STK       *p_base,
+                                   CPU_STK_SIZE   size)
+{
+    CPU_ADDR  guard;
+    CPU_ADDR  size_bytes;
+
+
+    guard      = ((CPU_ADDR)p_base + (OS_STK_GUARD_SIZE - 1u)) & ~(CPU_ADDR)(OS_STK_GUARD_SIZE - 1u);
+    size_bytes = (CPU_ADDR)size * (CPU_ADDR)sizeof(CPU_STK);
+    if (((guard + OS_STK_GUARD_SIZE) - (CPU_ADDR)p_base) > (size_bytes / 4u)) {
+        return ((CPU_STK *)0);
+    }
+    return ((CPU_STK *)guard);
+}
+
+#endif
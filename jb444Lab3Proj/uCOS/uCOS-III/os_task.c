@@ -57,7 +57,7 @@ const  CPU_CHAR  *os_task__c = "$Id: $";
 *                             OS_ERR_OS_NOT_RUNNING          If uC/OS-III is not running yet
 *                             OS_ERR_PRIO_INVALID            If the priority you specify is higher that the maximum allowed
 *                                                              (i.e. >= (OS_CFG_PRIO_MAX-1)) or already in use by a kernel
-*                                                              task
+*                                                              task, or not above the task's OSTaskBudgetSet() 'prio_low'
 *                             OS_ERR_STATE_INVALID           If the task is in an invalid state
 *                             OS_ERR_TASK_CHANGE_PRIO_ISR    If you tried to change the task's priority from an ISR
 *
@@ -104,6 +104,14 @@ void  OSTaskChangePrio (OS_TCB   *p_tcb,
         return;
     }
 
+#if (OS_CFG_ISR_POST_DEFERRED_EN == DEF_ENABLED)
+    if ((prio_new == 0u) ||                                     /* Priority 0 belongs to the ISR post queue task        */
+        (p_tcb    == &OSIntQTaskTCB)) {
+       *p_err = OS_ERR_PRIO_INVALID;
+        return;
+    }
+#endif
+
     CPU_CRITICAL_ENTER();
 
     if (p_tcb == (OS_TCB *)0) {                                 /* Are we changing the priority of 'self'?              */
@@ -115,6 +123,20 @@ void  OSTaskChangePrio (OS_TCB   *p_tcb,
         p_tcb = OSTCBCurPtr;
     }
 
+#if (OS_CFG_TASK_BUDGET_EN == DEF_ENABLED)
+    if (p_tcb->Budget > 0u) {                                   /* Task has a CPU budget?                               */
+        if (prio_new >= p_tcb->BudgetPrioLow) {                 /* Must stay above where it goes when out of budget     */
+            CPU_CRITICAL_EXIT();
+           *p_err = OS_ERR_PRIO_INVALID;
+            return;
+        }
+        p_tcb->BudgetPrio = prio_new;                           /* Priority it runs at with budget left                 */
+        if (p_tcb->BudgetRem == 0u) {                           /* Out of budget, stays demoted until replenished       */
+            prio_new = p_tcb->BudgetPrioLow;
+        }
+    }
+#endif
+
 #if (OS_CFG_MUTEX_EN == DEF_ENABLED)
     p_tcb->BasePrio = prio_new;                                 /* Update base priority                                 */
 
@@ -327,6 +349,15 @@ void  OSTaskCreate (OS_TCB        *p_tcb,
 #endif
     }
 
+#if (OS_CFG_ISR_POST_DEFERRED_EN == DEF_ENABLED)
+    if ((prio  == 0u) &&
+        (p_tcb != &OSIntQTaskTCB)) {
+        OS_TRACE_TASK_CREATE_FAILED(p_tcb);
+       *p_err = OS_ERR_PRIO_INVALID;                            /* Priority 0 belongs to the ISR post queue task        */
+        return;
+    }
+#endif
+
     OS_TaskInitTCB(p_tcb);                                      /* Initialize the TCB to default values                 */
 
    *p_err = OS_ERR_NONE;
@@ -412,6 +443,10 @@ void  OSTaskCreate (OS_TCB        *p_tcb,
 #endif
     p_tcb->Opt           = opt;                                 /* Save task options                                    */
 
+#if (OS_CFG_STK_GUARD_EN == DEF_ENABLED)
+    OS_StkGuardTaskInit(p_tcb);                                 /* Find the task's stack guard                          */
+#endif
+
 #if (OS_CFG_TASK_REG_TBL_SIZE > 0u)
     for (reg_nbr = 0u; reg_nbr < OS_CFG_TASK_REG_TBL_SIZE; reg_nbr++) {
         p_tcb->RegTbl[reg_nbr] = 0u;
@@ -536,6 +571,13 @@ void  OSTaskDel (OS_TCB  *p_tcb,
     }
 #endif
 
+#if (OS_CFG_ISR_POST_DEFERRED_EN == DEF_ENABLED)
+    if (p_tcb == &OSIntQTaskTCB) {                              /* Not allowed to delete the ISR post queue task        */
+       *p_err = OS_ERR_TASK_DEL_INVALID;
+        return;
+    }
+#endif
+
     if (p_tcb == (OS_TCB *)0) {                                 /* Delete 'Self'?                                       */
         CPU_CRITICAL_ENTER();
         p_tcb  = OSTCBCurPtr;                                   /* Yes.                                                 */
@@ -627,6 +669,10 @@ void  OSTaskDel (OS_TCB  *p_tcb,
     OS_TLS_TaskDel(p_tcb);                                      /* Call TLS hook                                        */
 #endif
 
+#if (OS_CFG_TASK_BUDGET_EN == DEF_ENABLED)
+    OS_BudgetTaskDel(p_tcb);                                    /* Drop the task's CPU budget                           */
+#endif
+
 #if (OS_CFG_DBG_EN == DEF_ENABLED)
     OS_TaskDbgListRemove(p_tcb);
 #endif
@@ -1021,6 +1067,71 @@ CPU_BOOLEAN  OSTaskQPendAbort (OS_TCB  *p_tcb,
 #endif
 
 
+/*
+************************************************************************************************************************
+*                                       GIVE A TASK QUEUE ITS OWN MESSAGE POOL
+*
+* Description: This function makes a task's message queue take its OS_MSGs from 'p_pool' first (see OSMsgPoolCreate()).
+*
+* Arguments  : p_tcb     is a pointer to the task's OS_TCB.  Specifying a NULL pointer indicates the calling task.
+*
+*              p_pool    is a pointer to a pool created by OSMsgPoolCreate(), or a NULL pointer to go back to OSMsgPool
+*
+*              p_err     is a pointer to a variable that will contain an error code returned by this function.
+*
+*                            OS_ERR_NONE              The pool was set
+*                            OS_ERR_Q_NOT_EMPTY       If the task's queue holds messages
+*                            OS_ERR_SET_ISR           If you called this function from an ISR
+*
+* Returns    : none
+*
+* Note(s)    : 1) Several queues may share a pool.  The queue must be empty so that every OS_MSG goes back to the
+*                 pool it came from.
+************************************************************************************************************************
+*/
+
+#if (OS_CFG_TASK_Q_EN == DEF_ENABLED) && (OS_CFG_MSG_POOL_LOCAL_EN == DEF_ENABLED)
+void  OSTaskQPoolSet (OS_TCB       *p_tcb,
+                      OS_MSG_POOL  *p_pool,
+                      OS_ERR       *p_err)
+{
+    CPU_SR_ALLOC();
+
+
+#ifdef OS_SAFETY_CRITICAL
+    if (p_err == (OS_ERR *)0) {
+        OS_SAFETY_CRITICAL_EXCEPTION();
+        return;
+    }
+#endif
+
+#if (OS_CFG_CALLED_FROM_ISR_CHK_EN == DEF_ENABLED)
+    if (OSIntNestingCtr > 0u) {                                 /* Not allowed to be called from an ISR                 */
+       *p_err = OS_ERR_SET_ISR;
+        return;
+    }
+#endif
+
+    if (p_pool == (OS_MSG_POOL *)0) {                           /* Back to the shared pool                              */
+        p_pool = &OSMsgPool;
+    }
+
+    CPU_CRITICAL_ENTER();
+    if (p_tcb == (OS_TCB *)0) {                                 /* Set the pool of the calling task's queue?            */
+        p_tcb = OSTCBCurPtr;
+    }
+    if (p_tcb->MsgQ.NbrEntries > 0u) {                            /* See Note #1                                          */
+        CPU_CRITICAL_EXIT();
+       *p_err = OS_ERR_Q_NOT_EMPTY;
+        return;
+    }
+    p_tcb->MsgQ.PoolPtr = p_pool;
+    CPU_CRITICAL_EXIT();
+   *p_err = OS_ERR_NONE;
+}
+#endif
+
+
 /*
 ************************************************************************************************************************
 *                                               POST MESSAGE TO A TASK
@@ -1055,6 +1166,7 @@ CPU_BOOLEAN  OSTaskQPendAbort (OS_TCB  *p_tcb,
 *                             OS_ERR_Q_MAX             If the queue is full
 *                             OS_ERR_STATE_INVALID     If the task is in an invalid state.  This should never happen
 *                                                      and if it does, would be considered a system failure
+*                             OS_ERR_INT_Q_FULL        If called from an ISR and the ISR post queue is full
 *
 * Returns    : none
 *
@@ -1106,6 +1218,17 @@ void  OSTaskQPost (OS_TCB       *p_tcb,
     }
 #endif
 
+#if (OS_CFG_ISR_POST_DEFERRED_EN == DEF_ENABLED)
+    if (OSIntNestingCtr > 0u) {                                 /* Called from an ISR: leave the post to OS_IntQTask()  */
+        if (p_tcb == (OS_TCB *)0) {                             /* 'Self' is the task the ISR interrupted               */
+            p_tcb = OSTCBCurPtr;
+        }
+        OS_IntQPost(OS_OBJ_TYPE_TASK_MSG, (void *)p_tcb, p_void, msg_size, 0u, opt, p_err);
+        OS_TRACE_TASK_MSG_Q_POST_EXIT(*p_err);
+        return;
+    }
+#endif
+
 #if (OS_CFG_TS_EN == DEF_ENABLED)
     ts = OS_TS_GET();                                           /* Get timestamp                                        */
 #else
@@ -1791,6 +1914,7 @@ CPU_BOOLEAN  OSTaskSemPendAbort (OS_TCB  *p_tcb,
 *                            OS_ERR_SEM_OVF           If the post would cause the semaphore count to overflow
 *                            OS_ERR_STATE_INVALID     If the task is in an invalid state.  This should never happen
 *                                                     and if it does, would be considered a system failure
+*                            OS_ERR_INT_Q_FULL        If called from an ISR and the ISR post queue is full
 *
 * Returns    : The current value of the task's signal counter or 0 if called from an ISR
 *
@@ -1838,6 +1962,17 @@ OS_SEM_CTR  OSTaskSemPost (OS_TCB  *p_tcb,
     }
 #endif
 
+#if (OS_CFG_ISR_POST_DEFERRED_EN == DEF_ENABLED)
+    if (OSIntNestingCtr > 0u) {                                 /* Called from an ISR: leave the post to OS_IntQTask()  */
+        if (p_tcb == (OS_TCB *)0) {                             /* 'Self' is the task the ISR interrupted               */
+            p_tcb = OSTCBCurPtr;
+        }
+        OS_IntQPost(OS_OBJ_TYPE_TASK_SIGNAL, (void *)p_tcb, (void *)0, 0u, 0u, opt, p_err);
+        OS_TRACE_TASK_SEM_POST_EXIT(*p_err);
+        return (0u);
+    }
+#endif
+
 #if (OS_CFG_TS_EN == DEF_ENABLED)
     ts = OS_TS_GET();                                           /* Get timestamp                                        */
 #else
@@ -2191,6 +2326,13 @@ void   OSTaskSuspend (OS_TCB  *p_tcb,
     }
 #endif
 
+#if (OS_CFG_ISR_POST_DEFERRED_EN == DEF_ENABLED)
+    if (p_tcb == &OSIntQTaskTCB) {                              /* Make sure not suspending the ISR post queue task     */
+       *p_err = OS_ERR_TASK_SUSPEND_INT_HANDLER;
+        return;
+    }
+#endif
+
     OS_TRACE_TASK_SUSPEND(p_tcb);
 
     CPU_CRITICAL_ENTER();
@@ -2442,6 +2584,9 @@ void  OS_TaskInitTCB (OS_TCB  *p_tcb)
 #if defined(OS_CFG_TLS_TBL_SIZE) && (OS_CFG_TLS_TBL_SIZE > 0u)
     OS_TLS_ID   id;
 #endif
+#if (OS_CFG_PROF_EN == DEF_ENABLED)
+    CPU_INT08U  bin;
+#endif
 
 
     p_tcb->StkPtr               = (CPU_STK          *)0;
@@ -2455,8 +2600,15 @@ void  OS_TaskInitTCB (OS_TCB  *p_tcb)
     p_tcb->PrevPtr              = (OS_TCB           *)0;
 
 #if (OS_CFG_TASK_TICK_EN == DEF_ENABLED)
+#if (OS_CFG_TICK_WHEEL_EN == DEF_ENABLED)
+    p_tcb->TickNode.NextPtr     = (OS_WHEEL_NODE    *)0;
+    p_tcb->TickNode.PrevPtr     = (OS_WHEEL_NODE    *)0;
+    p_tcb->TickNode.Expire      =                     0u;
+    p_tcb->TickNode.ObjPtr      = (void             *)p_tcb;
+#else
     p_tcb->TickNextPtr          = (OS_TCB           *)0;
     p_tcb->TickPrevPtr          = (OS_TCB           *)0;
+#endif
     p_tcb->TickListPtr          = (OS_TICK_LIST     *)0;
 #endif
 
@@ -2534,6 +2686,38 @@ void  OS_TaskInitTCB (OS_TCB  *p_tcb)
     p_tcb->StkUsed              =                     0u;
 #endif
 
+#if (OS_CFG_STK_GUARD_EN == DEF_ENABLED)
+    p_tcb->StkGuardPtr          = (CPU_STK          *)0;
+    p_tcb->StkUsedMax           =                     0u;
+#endif
+
+#if (OS_CFG_TASK_BUDGET_EN == DEF_ENABLED)
+    p_tcb->BudgetNextPtr        = (OS_TCB           *)0;
+    p_tcb->Budget               =                     0u;
+    p_tcb->BudgetPeriod         =                     0u;
+    p_tcb->BudgetRem            =                     0u;
+    p_tcb->BudgetUsed           =                     0u;
+    p_tcb->BudgetTS             =                     0u;
+    p_tcb->BudgetActTime        =                     0u;
+    p_tcb->BudgetActive         =              DEF_FALSE;
+    p_tcb->BudgetPrio           =                     0u;
+    p_tcb->BudgetPrioLow        =                     0u;
+    p_tcb->BudgetReplIx         =                     0u;
+    p_tcb->BudgetReplNbr        =                     0u;
+    p_tcb->BudgetOverrunCtr     =                     0u;
+#endif
+
+#if (OS_CFG_EDF_EN == DEF_ENABLED)
+    p_tcb->EdfPeriod            =                     0u;
+    p_tcb->EdfDeadline          =                     0u;
+    p_tcb->EdfRelease           =                     0u;
+    p_tcb->EdfDeadlineAbs       =                     0u;
+    p_tcb->EdfLate              =              DEF_FALSE;
+    p_tcb->EdfWake              =              DEF_FALSE;
+    p_tcb->EdfJobCtr            =                     0u;
+    p_tcb->EdfMissCtr           =                     0u;
+#endif
+
     p_tcb->Opt                  =                     0u;
 
 #if (OS_CFG_TASK_TICK_EN == DEF_ENABLED)
@@ -2559,6 +2743,19 @@ void  OS_TaskInitTCB (OS_TCB  *p_tcb)
     p_tcb->CyclesTotal          =                     0u;
 #endif
 
+#if (OS_CFG_PROF_EN == DEF_ENABLED)
+    p_tcb->ProfCycles           =                     0u;
+    p_tcb->ProfPreemptCtr       =                     0u;
+    p_tcb->ProfRdyTS            =                     0u;
+    p_tcb->ProfLatMax           =                     0u;
+    for (bin = 0u; bin < OS_PROF_LAT_BINS; bin++) {
+        p_tcb->ProfLatHist[bin] =                     0u;
+    }
+    p_tcb->ProfFpCtxSwCtr       =                     0u;
+    p_tcb->ProfCtxSwCycles      =                     0u;
+    p_tcb->ProfCtxSwMax         =                     0u;
+#endif
+
 #ifdef CPU_CFG_INT_DIS_MEAS_EN
     p_tcb->IntDisTimeMax        =                     0u;
 #endif
@@ -2767,17 +2964,16 @@ void  OS_TaskChangePrio(OS_TCB  *p_tcb,
             case OS_TASK_STATE_PEND_TIMEOUT:
             case OS_TASK_STATE_PEND_SUSPENDED:
             case OS_TASK_STATE_PEND_TIMEOUT_SUSPENDED:
-                 p_tcb->Prio = prio_new;                        /* Set new task priority                                */
                  switch (p_tcb->PendOn) {                       /* What to do depends on what we are pending on         */
                      case OS_TASK_PEND_ON_FLAG:
                      case OS_TASK_PEND_ON_Q:
                      case OS_TASK_PEND_ON_SEM:
-                          OS_PendListChangePrio(p_tcb);
+                          OS_PendListChangePrio(p_tcb, prio_new);
                           break;
 
                      case OS_TASK_PEND_ON_MUTEX:
 #if (OS_CFG_MUTEX_EN == DEF_ENABLED)
-                          OS_PendListChangePrio(p_tcb);
+                          OS_PendListChangePrio(p_tcb, prio_new);
                           p_tcb_owner = ((OS_MUTEX *)((void *)p_tcb->PendObjPtr))->OwnerTCBPtr;
                           if (prio_cur > prio_new) {            /* Are we increasing the priority?                      */
                               if (p_tcb_owner->Prio <= prio_new) { /* Yes, do we need to give this prio to the owner?   */
@@ -2804,7 +3000,7 @@ void  OS_TaskChangePrio(OS_TCB  *p_tcb,
                      case OS_TASK_PEND_ON_TASK_Q:
                      case OS_TASK_PEND_ON_TASK_SEM:
                      default:
-                                                                /* Default case.                                        */
+                          p_tcb->Prio = prio_new;               /* Set new task priority                                */
                           break;
                  }
                  break;
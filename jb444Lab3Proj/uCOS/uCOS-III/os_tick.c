@@ -46,8 +46,11 @@ const  CPU_CHAR  *os_tick__c = "$Id: $";
 ************************************************************************************************************************
 */
 
-static  CPU_TS  OS_TickListUpdateDly     (OS_TICK ticks);
-static  CPU_TS  OS_TickListUpdateTimeout (OS_TICK ticks);
+static  CPU_TS   OS_TickListUpdateDly     (OS_TICK        ticks);
+static  CPU_TS   OS_TickListUpdateTimeout (OS_TICK        ticks);
+
+static  void     OS_TickDlyExpire         (OS_TCB        *p_tcb);
+static  void     OS_TickTimeoutExpire     (OS_TCB        *p_tcb);
 
 /*
 ************************************************************************************************************************
@@ -115,15 +118,15 @@ void  OS_TickTask (void  *p_arg)
 #endif
 
 #if (OS_CFG_DYN_TICK_EN == DEF_ENABLED)
-            tick_step_dly = (OS_TICK)-1;
-            tick_step_timeout = (OS_TICK)-1;
-            if(OSTickListDly.TCB_Ptr != (OS_TCB *)0) {
-                tick_step_dly = OSTickListDly.TCB_Ptr->TickRemain;
-            }
-            if(OSTickListTimeout.TCB_Ptr != (OS_TCB *)0) {
-                tick_step_timeout = OSTickListTimeout.TCB_Ptr->TickRemain;
-            }
+            tick_step_dly     = OS_TickListNextGet(&OSTickListDly);
+            tick_step_timeout = OS_TickListNextGet(&OSTickListTimeout);
             OSTickCtrStep = (tick_step_dly < tick_step_timeout) ? tick_step_dly : tick_step_timeout;
+#if (OS_CFG_TASK_BUDGET_EN == DEF_ENABLED)
+            tick_step_dly     = OS_BudgetTickNextGet();         /* First CPU budget replenishment                       */
+            if (tick_step_dly < OSTickCtrStep) {
+                OSTickCtrStep = tick_step_dly;
+            }
+#endif
             BSP_OS_TickNextSet(OSTickCtrStep);
 #endif
             CPU_CRITICAL_EXIT();
@@ -161,8 +164,13 @@ void  OS_TickTaskInit (OS_ERR  *p_err)
     OSTickCtrPend                = 0u;
 #endif
 
+#if (OS_CFG_TICK_WHEEL_EN == DEF_ENABLED)
+    OS_WheelInit(&OSTickListDly.Wheel,     OSTickCtr);          /* Wheels run in step with OSTickCtr                    */
+    OS_WheelInit(&OSTickListTimeout.Wheel, OSTickCtr);
+#else
     OSTickListDly.TCB_Ptr        = (OS_TCB *)0;
     OSTickListTimeout.TCB_Ptr    = (OS_TCB *)0;
+#endif
 
 #if (OS_CFG_DBG_EN == DEF_ENABLED)
     OSTickListDly.NbrEntries     = 0u;
@@ -207,6 +215,46 @@ void  OS_TickTaskInit (OS_ERR  *p_err)
                   p_err);
 }
 
+/*
+************************************************************************************************************************
+*                                              ARM A TICK WITHIN SO MANY TICKS
+*
+* Description: This function makes sure a tick is announced no later than 'ticks' ticks from now, for the kernel
+*              services that need the CPU back at a given time without a task waiting in a tick list.
+*
+* Arguments  : ticks       is the number of ticks from now, 0 is taken as 1.
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application MUST NOT call it.
+*
+*              2) This function is assumed to be called with interrupts disabled.
+*
+*              3) 'Now' is BSP_OS_TickGet(), which can be ahead of OSTickCtr, while BSP_OS_TickNextSet() counts from
+*                 OSTickCtr.  The tick task programs the next tick afresh each time it runs, so a caller must arm
+*                 again after that if it still needs the tick.  Task switches do, see OSTaskSwHook().
+************************************************************************************************************************
+*/
+
+#if (OS_CFG_DYN_TICK_EN == DEF_ENABLED)
+void  OS_TickArm (OS_TICK  ticks)
+{
+    OS_TICK  tick_step;
+
+
+    if (ticks == 0u) {
+        ticks = 1u;
+    }
+    tick_step = (OS_TICK)(BSP_OS_TickGet() - OSTickCtr)         /* See Note #3                                          */
+              + ticks;
+    if (tick_step < OSTickCtrStep) {
+        OSTickCtrStep = tick_step;
+        BSP_OS_TickNextSet(tick_step);
+    }
+}
+#endif
+
+#if (OS_CFG_TICK_WHEEL_EN == DEF_DISABLED)
 /*
 ************************************************************************************************************************
 *                                                      INSERT
@@ -315,6 +363,8 @@ void  OS_TickListInsert (OS_TICK_LIST  *p_list,
 #endif
 }
 
+#endif
+
 /*
 ************************************************************************************************************************
 *                                            ADD TASK TO DELAYED TICK LIST
@@ -402,6 +452,7 @@ void  OS_TickListInsertDly (OS_TCB   *p_tcb,
     OS_TickListInsert(&OSTickListDly, p_tcb, remain + (tick_ctr - OSTickCtr));
 }
 
+#if (OS_CFG_TICK_WHEEL_EN == DEF_DISABLED)
 /*
 ************************************************************************************************************************
 *                                         REMOVE A TASK FROM THE TICK LIST
@@ -511,15 +562,7 @@ static  CPU_TS  OS_TickListUpdateDly (OS_TICK  ticks)
 #if (OS_CFG_DBG_EN == DEF_ENABLED)
             nbr_updated++;                                      /* Keep track of the number of TCBs updated             */
 #endif
-            if (p_tcb->TaskState == OS_TASK_STATE_DLY) {
-                p_tcb->TaskState = OS_TASK_STATE_RDY;
-                OS_RdyListInsert(p_tcb);                        /* Insert the task in the ready list                    */
-
-            } else {
-                if (p_tcb->TaskState == OS_TASK_STATE_DLY_SUSPENDED) {
-                    p_tcb->TaskState = OS_TASK_STATE_SUSPENDED;
-                }
-            }
+            OS_TickDlyExpire(p_tcb);                            /* Make the task ready                                  */
 
             p_list->TCB_Ptr = p_tcb->TickNextPtr;
             p_tcb           = p_list->TCB_Ptr;                  /* Get 'p_tcb' again for loop                           */
@@ -583,10 +626,6 @@ static  CPU_TS  OS_TickListUpdateTimeout (OS_TICK  ticks)
 #if (OS_CFG_DBG_EN == DEF_ENABLED)
     OS_OBJ_QTY    nbr_updated;
 #endif
-#if (OS_CFG_MUTEX_EN == DEF_ENABLED)
-    OS_TCB       *p_tcb_owner;
-    OS_PRIO       prio_new;
-#endif
 
                                                                 /*  ======= UPDATE TASKS WAITING WITH TIMEOUT ========  */
 #if (OS_CFG_TS_EN == DEF_ENABLED)
@@ -610,46 +649,7 @@ static  CPU_TS  OS_TickListUpdateTimeout (OS_TICK  ticks)
             nbr_updated++;
 #endif
 
-#if (OS_CFG_MUTEX_EN == DEF_ENABLED)
-            p_tcb_owner = (OS_TCB *)0;
-            if (p_tcb->PendOn == OS_TASK_PEND_ON_MUTEX) {
-                p_tcb_owner = (OS_TCB *)((OS_MUTEX *)((void *)p_tcb->PendObjPtr))->OwnerTCBPtr;
-            }
-#endif
-
-#if (OS_MSG_EN == DEF_ENABLED)
-            p_tcb->MsgPtr  = (void *)0;
-            p_tcb->MsgSize = 0u;
-#endif
-#if (OS_CFG_TS_EN == DEF_ENABLED)
-            p_tcb->TS      = OS_TS_GET();
-#endif
-            OS_PendListRemove(p_tcb);                           /* Remove task from pend list                           */
-            if (p_tcb->TaskState == OS_TASK_STATE_PEND_TIMEOUT) {
-                OS_RdyListInsert(p_tcb);                        /* Insert the task in the ready list                    */
-                p_tcb->TaskState  = OS_TASK_STATE_RDY;
-
-            } else {
-                if (p_tcb->TaskState == OS_TASK_STATE_PEND_TIMEOUT_SUSPENDED) {
-                    p_tcb->TaskState  = OS_TASK_STATE_SUSPENDED;
-                }
-            }
-            p_tcb->PendStatus = OS_STATUS_PEND_TIMEOUT;         /* Indicate pend timed out                              */
-            p_tcb->PendOn     = OS_TASK_PEND_ON_NOTHING;        /* Indicate no longer pending                           */
-
-#if (OS_CFG_MUTEX_EN == DEF_ENABLED)
-            if (p_tcb_owner != (OS_TCB *)0) {
-                if ((p_tcb_owner->Prio != p_tcb_owner->BasePrio) &&
-                    (p_tcb_owner->Prio == p_tcb->Prio)) {       /* Has the owner inherited a priority?                  */
-                    prio_new = OS_MutexGrpPrioFindHighest(p_tcb_owner);
-                    prio_new = (prio_new > p_tcb_owner->BasePrio) ? p_tcb_owner->BasePrio : prio_new;
-                    if(prio_new != p_tcb_owner->Prio) {
-                        OS_TaskChangePrio(p_tcb_owner, prio_new);
-                        OS_TRACE_MUTEX_TASK_PRIO_DISINHERIT(p_tcb_owner, p_tcb_owner->Prio);
-                    }
-                }
-            }
-#endif
+            OS_TickTimeoutExpire(p_tcb);                        /* Time out the pend                                    */
 
             p_list->TCB_Ptr = p_tcb->TickNextPtr;
             p_tcb           = p_list->TCB_Ptr;                  /* Get 'p_tcb' again for loop                           */
@@ -685,4 +685,373 @@ static  CPU_TS  OS_TickListUpdateTimeout (OS_TICK  ticks)
     return (0u);
 #endif
 }
+
+
+/*
+************************************************************************************************************************
+*                                             TICKS TO THE NEXT EXPIRY
+*
+* Description: This function returns the number of ticks until the first task in a tick list is due.
+*
+* Arguments  : p_list         is a pointer to the tick list.
+*
+* Returns    : the number of ticks, or (OS_TICK)-1 if the list is empty.
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application MUST NOT call it.
+*
+*              2) This function is assumed to be called with interrupts disabled.
+************************************************************************************************************************
+*/
+
+#if (OS_CFG_DYN_TICK_EN == DEF_ENABLED)
+OS_TICK  OS_TickListNextGet (OS_TICK_LIST  *p_list)
+{
+    if (p_list->TCB_Ptr == (OS_TCB *)0) {
+        return ((OS_TICK)-1);
+    }
+    return (p_list->TCB_Ptr->TickRemain);                       /* The head holds the delta to the first expiry         */
+}
+#endif
+
+#else                                                           /* ------------------ TIMING WHEEL ------------------ */
+/*
+************************************************************************************************************************
+*                                                      INSERT
+*
+* Description: This task is internal to uC/OS-III and allows the insertion of a task in a tick list.
+*
+* Arguments  : p_list      is a pointer to the desired list
+*
+*              p_tcb       is a pointer to the TCB to insert in the list
+*
+*              time        is the amount of time remaining (in ticks) for the task to become ready
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application should not call it.
+*
+*              2) The list is a timing wheel (see os_wheel.c), so insertion is O(1) whatever the number of tasks
+*                 already waiting.  .TickRemain is not used.
+*
+*              3) A time of 0 is treated as 1 tick, which is when the delta list would make the task ready.
+************************************************************************************************************************
+*/
+
+void  OS_TickListInsert (OS_TICK_LIST  *p_list,
+                         OS_TCB        *p_tcb,
+                         OS_TICK        time)
+{
+    if (time == 0u) {                                           /* See Note #3                                          */
+        time = 1u;
+    }
+    p_tcb->TickListPtr = p_list;                                /* Link to this list                                    */
+    OS_WheelInsert(&p_list->Wheel, &p_tcb->TickNode, (void *)p_tcb, time);
+#if (OS_CFG_DBG_EN == DEF_ENABLED)
+    p_list->NbrEntries++;                                       /* List contains an extra entry                         */
+#endif
+
+#if (OS_CFG_DYN_TICK_EN == DEF_ENABLED)
+    if (time < OSTickCtrStep) {
+        OSTickCtrStep = time;
+        BSP_OS_TickNextSet(time);
+    }
+#endif
+}
+
+/*
+************************************************************************************************************************
+*                                         REMOVE A TASK FROM THE TICK LIST
+*
+* Description: This function is called to remove a task from the tick list
+*
+* Arguments  : p_tcb          Is a pointer to the OS_TCB to remove.
+*              -----
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application MUST NOT call it.
+*
+*              2) This function is assumed to be called with interrupts disabled.
+************************************************************************************************************************
+*/
+
+void  OS_TickListRemove (OS_TCB  *p_tcb)
+{
+    OS_TICK_LIST  *p_list;
+
+
+    p_list = p_tcb->TickListPtr;
+    OS_WheelRemove(&p_list->Wheel, &p_tcb->TickNode);
+#if (OS_CFG_DBG_EN == DEF_ENABLED)
+    p_list->NbrEntries--;
+#endif
+    p_tcb->TickListPtr = (OS_TICK_LIST *)0;
+}
+
+/*
+************************************************************************************************************************
+*                                             TICKS TO THE NEXT EXPIRY
+*
+* Description: This function returns the number of ticks until the first task in a tick list is due.
+*
+* Arguments  : p_list         is a pointer to the tick list.
+*
+* Returns    : the number of ticks, or (OS_TICK)-1 if the list is empty.
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application MUST NOT call it.
+*
+*              2) This function is assumed to be called with interrupts disabled.
+************************************************************************************************************************
+*/
+
+#if (OS_CFG_DYN_TICK_EN == DEF_ENABLED)
+OS_TICK  OS_TickListNextGet (OS_TICK_LIST  *p_list)
+{
+    return (OS_WheelNextGet(&p_list->Wheel));
+}
+#endif
+
+/*
+************************************************************************************************************************
+*                                           UPDATE THE LIST OF TASKS DELAYED
+*
+* Description: This function advances the timing wheel which contains tasks that have been delayed.
+*
+* Arguments  : ticks          the number of ticks which have elapsed.
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application MUST NOT call it.
+*
+*              2) Tasks due on the same tick are made ready newest first, the same order as the delta list.
+*
+*              3) The wheel is moved straight to the next tick on which a slot expires or cascades, so the time taken
+*                 grows with the number of tasks made ready, not with 'ticks'.  A dynamic tick can cover tens of
+*                 thousands of ticks at once, and this runs with interrupts disabled.
+************************************************************************************************************************
+*/
+
+static  CPU_TS  OS_TickListUpdateDly (OS_TICK  ticks)
+{
+    OS_TCB        *p_tcb;
+    OS_WHEEL_NODE *p_node;
+    OS_TICK_LIST  *p_list;
+    OS_TICK        step;
+#if (OS_CFG_TS_EN == DEF_ENABLED)
+    CPU_TS         ts_start;
+    CPU_TS         ts_delta_dly;
+#endif
+#if (OS_CFG_DBG_EN == DEF_ENABLED)
+    OS_OBJ_QTY     nbr_updated;
+#endif
+
+                                                                /*  ========= UPDATE TASKS WAITING FOR DELAY =========  */
+#if (OS_CFG_TS_EN == DEF_ENABLED)
+    ts_start    = OS_TS_GET();
+#endif
+#if (OS_CFG_DBG_EN == DEF_ENABLED)
+    nbr_updated = (OS_OBJ_QTY)0u;
+#endif
+    p_list      = &OSTickListDly;
+    while (ticks > 0u) {
+        step   = OS_WheelStep(&p_list->Wheel, ticks);           /* Skip the ticks on which nothing happens (Note #3)    */
+        OS_WheelAdvance(&p_list->Wheel, step);
+        p_node = OS_WheelDueGet(&p_list->Wheel);                /* Tasks due on this tick                               */
+        while (p_node != (OS_WHEEL_NODE *)0) {
+#if (OS_CFG_DBG_EN == DEF_ENABLED)
+            nbr_updated++;                                      /* Keep track of the number of TCBs updated             */
+            p_list->NbrEntries--;
+#endif
+            OS_WheelRemove(&p_list->Wheel, p_node);
+            p_tcb              = (OS_TCB *)p_node->ObjPtr;
+            p_tcb->TickListPtr = (OS_TICK_LIST *)0;
+            OS_TickDlyExpire(p_tcb);                            /* Make the task ready                                  */
+            p_node             = OS_WheelDueGet(&p_list->Wheel);
+        }
+        ticks -= step;
+    }
+#if (OS_CFG_DBG_EN == DEF_ENABLED)
+    p_list->NbrUpdated = nbr_updated;
+#endif
+#if (OS_CFG_TS_EN == DEF_ENABLED)
+    ts_delta_dly       = OS_TS_GET() - ts_start;                /* Measure execution time of the update                 */
+#endif
+
+#if (OS_CFG_TS_EN == DEF_ENABLED)
+    return (ts_delta_dly);
+#else
+    return (0u);
+#endif
+}
+
+
+/*
+************************************************************************************************************************
+*                                       UPDATE THE LIST OF TASKS PENDING WITH TIMEOUT
+*
+* Description: This function advances the timing wheel which contains tasks that are pending with a timeout.
+*
+* Arguments  : ticks          the number of ticks which have elapsed.
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application MUST NOT call it.
+*
+*              2) Ticks on which nothing is due are skipped, see OS_TickListUpdateDly() Note #3.
+************************************************************************************************************************
+*/
+
+static  CPU_TS  OS_TickListUpdateTimeout (OS_TICK  ticks)
+{
+    OS_TCB        *p_tcb;
+    OS_WHEEL_NODE *p_node;
+    OS_TICK_LIST  *p_list;
+    OS_TICK        step;
+#if (OS_CFG_TS_EN == DEF_ENABLED)
+    CPU_TS         ts_start;
+    CPU_TS         ts_delta_timeout;
+#endif
+#if (OS_CFG_DBG_EN == DEF_ENABLED)
+    OS_OBJ_QTY     nbr_updated;
+#endif
+
+                                                                /*  ======= UPDATE TASKS WAITING WITH TIMEOUT ========  */
+#if (OS_CFG_TS_EN == DEF_ENABLED)
+    ts_start    = OS_TS_GET();
+#endif
+#if (OS_CFG_DBG_EN == DEF_ENABLED)
+    nbr_updated = 0u;
+#endif
+    p_list      = &OSTickListTimeout;
+    while (ticks > 0u) {
+        step   = OS_WheelStep(&p_list->Wheel, ticks);           /* Skip the ticks on which nothing happens (Note #2)    */
+        OS_WheelAdvance(&p_list->Wheel, step);
+        p_node = OS_WheelDueGet(&p_list->Wheel);                /* Tasks due on this tick                               */
+        while (p_node != (OS_WHEEL_NODE *)0) {
+#if (OS_CFG_DBG_EN == DEF_ENABLED)
+            nbr_updated++;
+            p_list->NbrEntries--;
+#endif
+            OS_WheelRemove(&p_list->Wheel, p_node);
+            p_tcb              = (OS_TCB *)p_node->ObjPtr;
+            p_tcb->TickListPtr = (OS_TICK_LIST *)0;
+            OS_TickTimeoutExpire(p_tcb);                        /* Time out the pend                                    */
+            p_node             = OS_WheelDueGet(&p_list->Wheel);
+        }
+        ticks -= step;
+    }
+#if (OS_CFG_DBG_EN == DEF_ENABLED)
+    p_list->NbrUpdated = nbr_updated;
+#endif
+#if (OS_CFG_TS_EN == DEF_ENABLED)
+    ts_delta_timeout   = OS_TS_GET() - ts_start;                /* Measure execution time of the update                 */
+#endif
+
+#if (OS_CFG_TS_EN == DEF_ENABLED)
+    return (ts_delta_timeout);
+#else
+    return (0u);
+#endif
+}
+#endif
+
+
+/*
+************************************************************************************************************************
+*                                               EXPIRE A DELAYED TASK
+*
+* Description: This function makes a task ready once its delay has expired. The task has already been taken off the
+*              tick list.
+*
+* Arguments  : p_tcb          is a pointer to the TCB of the task.
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application MUST NOT call it.
+************************************************************************************************************************
+*/
+
+static  void  OS_TickDlyExpire (OS_TCB  *p_tcb)
+{
+#if (OS_CFG_EDF_EN == DEF_ENABLED)
+    p_tcb->EdfWake = DEF_TRUE;                                  /* New job once made ready, see os_edf.c Note #2        */
+#endif
+    if (p_tcb->TaskState == OS_TASK_STATE_DLY) {
+        p_tcb->TaskState = OS_TASK_STATE_RDY;
+        OS_RdyListInsert(p_tcb);                                /* Insert the task in the ready list                    */
+
+    } else {
+        if (p_tcb->TaskState == OS_TASK_STATE_DLY_SUSPENDED) {
+            p_tcb->TaskState = OS_TASK_STATE_SUSPENDED;
+        }
+    }
+}
+
+
+/*
+************************************************************************************************************************
+*                                              TIME OUT A PENDING TASK
+*
+* Description: This function ends a pend whose timeout has expired. The task has already been taken off the tick list.
+*
+* Arguments  : p_tcb          is a pointer to the TCB of the task.
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application MUST NOT call it.
+************************************************************************************************************************
+*/
+
+static  void  OS_TickTimeoutExpire (OS_TCB  *p_tcb)
+{
+#if (OS_CFG_MUTEX_EN == DEF_ENABLED)
+    OS_TCB   *p_tcb_owner;
+    OS_PRIO   prio_new;
+#endif
+
+
+#if (OS_CFG_MUTEX_EN == DEF_ENABLED)
+    p_tcb_owner = (OS_TCB *)0;
+    if (p_tcb->PendOn == OS_TASK_PEND_ON_MUTEX) {
+        p_tcb_owner = (OS_TCB *)((OS_MUTEX *)((void *)p_tcb->PendObjPtr))->OwnerTCBPtr;
+    }
+#endif
+
+#if (OS_MSG_EN == DEF_ENABLED)
+    p_tcb->MsgPtr  = (void *)0;
+    p_tcb->MsgSize = 0u;
+#endif
+#if (OS_CFG_TS_EN == DEF_ENABLED)
+    p_tcb->TS      = OS_TS_GET();
+#endif
+    OS_PendListRemove(p_tcb);                                   /* Remove task from pend list                           */
+#if (OS_CFG_EDF_EN == DEF_ENABLED)
+    p_tcb->EdfWake = DEF_TRUE;                                  /* New job once made ready, see os_edf.c Note #2        */
+#endif
+    if (p_tcb->TaskState == OS_TASK_STATE_PEND_TIMEOUT) {
+        OS_RdyListInsert(p_tcb);                                /* Insert the task in the ready list                    */
+        p_tcb->TaskState  = OS_TASK_STATE_RDY;
+
+    } else {
+        if (p_tcb->TaskState == OS_TASK_STATE_PEND_TIMEOUT_SUSPENDED) {
+            p_tcb->TaskState  = OS_TASK_STATE_SUSPENDED;
+        }
+    }
+    p_tcb->PendStatus = OS_STATUS_PEND_TIMEOUT;                 /* Indicate pend timed out                              */
+    p_tcb->PendOn     = OS_TASK_PEND_ON_NOTHING;                /* Indicate no longer pending                           */
+
+#if (OS_CFG_MUTEX_EN == DEF_ENABLED)
+    if (p_tcb_owner != (OS_TCB *)0) {
+        if ((p_tcb_owner->Prio != p_tcb_owner->BasePrio) &&
+            (p_tcb_owner->Prio == p_tcb->Prio)) {               /* Has the owner inherited a priority?                  */
+            prio_new = OS_MutexGrpPrioFindHighest(p_tcb_owner);
+            prio_new = (prio_new > p_tcb_owner->BasePrio) ? p_tcb_owner->BasePrio : prio_new;
+            if(prio_new != p_tcb_owner->Prio) {
+                OS_TaskChangePrio(p_tcb_owner, prio_new);
+                OS_TRACE_MUTEX_TASK_PRIO_DISINHERIT(p_tcb_owner, p_tcb_owner->Prio);
+            }
+        }
+    }
+#endif
+}
 #endif
@@ -590,7 +590,11 @@ void  OSTimeTick (void)
 
 
 #if (OS_CFG_SCHED_ROUND_ROBIN_EN == DEF_ENABLED)
-    OS_SchedRoundRobin(&OSRdyList[OSPrioCur]);
+    OS_SchedRoundRobin(&OSRdyList[OSPrioCur], 1u);
+#endif
+
+#if (OS_CFG_TASK_BUDGET_EN == DEF_ENABLED)
+    OS_BudgetTick();                                            /* Charge the running task's CPU budget                 */
 #endif
 
 #if (OS_CFG_TMR_EN == DEF_ENABLED)
@@ -642,5 +646,13 @@ void OSTimeDynTick (OS_TICK ticks)
                          OS_OPT_POST_NONE,
                         &err);
 
+#if (OS_CFG_SCHED_ROUND_ROBIN_EN == DEF_ENABLED)
+    OS_SchedRoundRobin(&OSRdyList[OSPrioCur], ticks);
+#endif
+
+#if (OS_CFG_TASK_BUDGET_EN == DEF_ENABLED)
+    OS_BudgetTick();                                            /* Charge the running task's CPU budget                 */
+#endif
+
 }
 #endif
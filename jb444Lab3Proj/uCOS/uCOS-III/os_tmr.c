@@ -47,8 +47,8 @@ const  CPU_CHAR  *os_tmr__c = "$Id: $";
 ************************************************************************************************************************
 */
 
-static  void  OS_TmrLock   (void);
-static  void  OS_TmrUnlock (void);
+static  void      OS_TmrLock          (void);
+static  void      OS_TmrUnlock        (void);
 
 
 /*
@@ -178,13 +178,20 @@ void  OSTmrCreate (OS_TMR               *p_tmr,
     (void)p_name;
 #endif
     p_tmr->Dly            =  dly;
-    p_tmr->Remain         =           0u;
     p_tmr->Period         =  period;
     p_tmr->Opt            =  opt;
     p_tmr->CallbackPtr    =  p_callback;
     p_tmr->CallbackPtrArg =  p_callback_arg;
+#if (OS_CFG_TMR_WHEEL_EN == DEF_ENABLED)
+    p_tmr->WheelNode.NextPtr = (OS_WHEEL_NODE *)0;
+    p_tmr->WheelNode.PrevPtr = (OS_WHEEL_NODE *)0;
+    p_tmr->WheelNode.Expire  =                  0u;
+    p_tmr->WheelNode.ObjPtr  = (void          *)p_tmr;
+#else
+    p_tmr->Remain         =           0u;
     p_tmr->NextPtr        = (OS_TMR *)0;
     p_tmr->PrevPtr        = (OS_TMR *)0;
+#endif
 
 #if (OS_CFG_DBG_EN == DEF_ENABLED)
     OS_TmrDbgListAdd(p_tmr);
@@ -394,7 +401,11 @@ OS_TICK  OSTmrRemainGet (OS_TMR  *p_tmr,
 
     switch (p_tmr->State) {
         case OS_TMR_STATE_RUNNING:
+#if (OS_CFG_TMR_WHEEL_EN == DEF_ENABLED)
+             remain = p_tmr->WheelNode.Expire - OSTmrWheel.Now;
+#else
              remain = p_tmr->Remain;
+#endif
             *p_err  = OS_ERR_NONE;
              break;
 
@@ -590,7 +601,7 @@ void  OSTmrSet (OS_TMR               *p_tmr,
 CPU_BOOLEAN  OSTmrStart (OS_TMR  *p_tmr,
                          OS_ERR  *p_err)
 {
-    OS_TMR      *p_next;
+    OS_TICK      time;
     CPU_BOOLEAN  success;
 
 
@@ -632,42 +643,27 @@ CPU_BOOLEAN  OSTmrStart (OS_TMR  *p_tmr,
 
     OS_TmrLock();
 
+    if (p_tmr->Dly == 0u) {
+        time = p_tmr->Period;
+    } else {
+        time = p_tmr->Dly;
+    }
+
     switch (p_tmr->State) {
         case OS_TMR_STATE_RUNNING:                              /* Restart the timer                                    */
-             if (p_tmr->Dly == 0u) {
-                 p_tmr->Remain = p_tmr->Period;
-             } else {
-                 p_tmr->Remain = p_tmr->Dly;
-             }
+#if (OS_CFG_TMR_WHEEL_EN == DEF_ENABLED)
+             OS_TmrUnlink(p_tmr);                               /* Move it to the slot for its new expiry               */
+             OS_TmrLink(p_tmr, time);
+#else
+             p_tmr->Remain = time;
+#endif
             *p_err         = OS_ERR_NONE;
              success       = DEF_TRUE;
              break;
 
         case OS_TMR_STATE_STOPPED:                              /* Start the timer                                      */
         case OS_TMR_STATE_COMPLETED:
-             p_tmr->State  = OS_TMR_STATE_RUNNING;
-             if (p_tmr->Dly == 0u) {
-                 p_tmr->Remain = p_tmr->Period;
-             } else {
-                 p_tmr->Remain = p_tmr->Dly;
-             }
-             if (OSTmrListPtr == (OS_TMR *)0) {                 /* Link into timer list                                 */
-                 p_tmr->NextPtr   = (OS_TMR *)0;                /* This is the first timer in the list                  */
-                 p_tmr->PrevPtr   = (OS_TMR *)0;
-                 OSTmrListPtr     =  p_tmr;
-#if (OS_CFG_DBG_EN == DEF_ENABLED)
-                 OSTmrListEntries =           1u;
-#endif
-             } else {
-                 p_next           =  OSTmrListPtr;              /* Insert at the beginning of the list                  */
-                 p_tmr->NextPtr   =  OSTmrListPtr;
-                 p_tmr->PrevPtr   = (OS_TMR *)0;
-                 p_next->PrevPtr  =  p_tmr;
-                 OSTmrListPtr     =  p_tmr;
-#if (OS_CFG_DBG_EN == DEF_ENABLED)
-                 OSTmrListEntries++;
-#endif
-             }
+             OS_TmrLink(p_tmr, time);                           /* Link into timer list                                 */
             *p_err   = OS_ERR_NONE;
              success = DEF_TRUE;
              break;
@@ -952,13 +948,19 @@ void  OS_TmrClr (OS_TMR  *p_tmr)
     p_tmr->NamePtr        = (CPU_CHAR *)((void *)"?TMR");
 #endif
     p_tmr->Dly            =                      0u;
-    p_tmr->Remain         =                      0u;
     p_tmr->Period         =                      0u;
     p_tmr->Opt            =                      0u;
     p_tmr->CallbackPtr    = (OS_TMR_CALLBACK_PTR)0;
     p_tmr->CallbackPtrArg = (void              *)0;
+#if (OS_CFG_TMR_WHEEL_EN == DEF_ENABLED)
+    p_tmr->WheelNode.NextPtr = (OS_WHEEL_NODE  *)0;
+    p_tmr->WheelNode.PrevPtr = (OS_WHEEL_NODE  *)0;
+    p_tmr->WheelNode.Expire  =                   0u;
+#else
+    p_tmr->Remain         =                      0u;
     p_tmr->NextPtr        = (OS_TMR            *)0;
     p_tmr->PrevPtr        = (OS_TMR            *)0;
+#endif
 }
 
 
@@ -1048,7 +1050,11 @@ void  OS_TmrInit (OS_ERR  *p_err)
     OSTmrDbgListPtr     = (OS_TMR *)0;
 #endif
 
+#if (OS_CFG_TMR_WHEEL_EN == DEF_ENABLED)
+    OS_WheelInit(&OSTmrWheel, 0u);                              /* Create an empty timer wheel, at OSTmrTickCtr         */
+#else
     OSTmrListPtr        = (OS_TMR *)0;                          /* Create an empty timer list                           */
+#endif
 #if (OS_CFG_DBG_EN == DEF_ENABLED)
     OSTmrListEntries    =           0u;
 #endif
@@ -1115,6 +1121,62 @@ void  OS_TmrInit (OS_ERR  *p_err)
 }
 
 
+/*
+************************************************************************************************************************
+*                                           ADD A TIMER TO THE TIMER LIST
+*
+* Description: This function is called to start a timer by placing it in the timer list.
+*
+* Arguments  : p_tmr          Is a pointer to the timer to add.
+*              -----
+*
+*              time           Is the number of timer ticks until the timer expires (must be non-zero).
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application MUST NOT call it.
+*
+*              2) With the timer wheel, the timer is due when OSTmrWheel.Now, which follows OSTmrTickCtr, reaches
+*                 .WheelNode.Expire.
+************************************************************************************************************************
+*/
+
+void  OS_TmrLink (OS_TMR   *p_tmr,
+                  OS_TICK   time)
+{
+#if (OS_CFG_TMR_WHEEL_EN == DEF_ENABLED)
+    p_tmr->State     = OS_TMR_STATE_RUNNING;
+    OS_WheelInsert(&OSTmrWheel, &p_tmr->WheelNode, (void *)p_tmr, time);    /* See Note #2                          */
+#if (OS_CFG_DBG_EN == DEF_ENABLED)
+    OSTmrListEntries++;
+#endif
+#else
+    OS_TMR  *p_next;
+
+
+    p_tmr->State     = OS_TMR_STATE_RUNNING;
+    p_tmr->Remain    = time;
+    if (OSTmrListPtr == (OS_TMR *)0) {
+        p_tmr->NextPtr   = (OS_TMR *)0;                         /* This is the first timer in the list                  */
+        p_tmr->PrevPtr   = (OS_TMR *)0;
+        OSTmrListPtr     =  p_tmr;
+#if (OS_CFG_DBG_EN == DEF_ENABLED)
+        OSTmrListEntries =           1u;
+#endif
+    } else {
+        p_next           =  OSTmrListPtr;                       /* Insert at the beginning of the list                  */
+        p_tmr->NextPtr   =  OSTmrListPtr;
+        p_tmr->PrevPtr   = (OS_TMR *)0;
+        p_next->PrevPtr  =  p_tmr;
+        OSTmrListPtr     =  p_tmr;
+#if (OS_CFG_DBG_EN == DEF_ENABLED)
+        OSTmrListEntries++;
+#endif
+    }
+#endif
+}
+
+
 /*
 ************************************************************************************************************************
 *                                         REMOVE A TIMER FROM THE TIMER LIST
@@ -1132,6 +1194,9 @@ void  OS_TmrInit (OS_ERR  *p_err)
 
 void  OS_TmrUnlink (OS_TMR  *p_tmr)
 {
+#if (OS_CFG_TMR_WHEEL_EN == DEF_ENABLED)
+    OS_WheelRemove(&OSTmrWheel, &p_tmr->WheelNode);
+#else
     OS_TMR  *p_tmr1;
     OS_TMR  *p_tmr2;
 
@@ -1150,9 +1215,10 @@ void  OS_TmrUnlink (OS_TMR  *p_tmr)
             p_tmr2->PrevPtr = p_tmr1;
         }
     }
-    p_tmr->State   = OS_TMR_STATE_STOPPED;
     p_tmr->NextPtr = (OS_TMR *)0;
     p_tmr->PrevPtr = (OS_TMR *)0;
+#endif
+    p_tmr->State   = OS_TMR_STATE_STOPPED;
 #if (OS_CFG_DBG_EN == DEF_ENABLED)
     OSTmrListEntries--;
 #endif
@@ -1170,6 +1236,10 @@ void  OS_TmrUnlink (OS_TMR  *p_tmr)
 * Returns    : none
 *
 * Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application MUST NOT call it.
+*
+*              2) With the timer wheel only the timers that expire are visited, and the scheduler is locked once for
+*                 all of them. Each one is taken from the front of the slot, so a callback may stop or restart any
+*                 timer, including others due on the same tick.
 ************************************************************************************************************************
 */
 
@@ -1178,7 +1248,11 @@ void  OS_TmrTask (void  *p_arg)
     OS_ERR               err;
     OS_TMR_CALLBACK_PTR  p_fnct;
     OS_TMR              *p_tmr;
+#if (OS_CFG_TMR_WHEEL_EN == DEF_ENABLED)
+    OS_WHEEL_NODE       *p_node;
+#else
     OS_TMR              *p_tmr_next;
+#endif
 #if (OS_CFG_DYN_TICK_EN != DEF_ENABLED)
     CPU_TS               ts;
 #endif
@@ -1211,6 +1285,30 @@ void  OS_TmrTask (void  *p_arg)
         ts_start = OS_TS_GET();
 #endif
         OSTmrTickCtr++;                                         /* Increment the current time                           */
+#if (OS_CFG_TMR_WHEEL_EN == DEF_ENABLED)
+        OS_WheelAdvance(&OSTmrWheel, 1u);
+        p_node = OS_WheelDueGet(&OSTmrWheel);                   /* Timers that expire now (see Note #2)                 */
+        if (p_node != (OS_WHEEL_NODE *)0) {
+            OSSchedLock(&err);
+            (void)err;
+            while (p_node != (OS_WHEEL_NODE *)0) {
+                p_tmr = (OS_TMR *)p_node->ObjPtr;
+                OS_TmrUnlink(p_tmr);                            /* Remove from wheel                                    */
+                if (p_tmr->Opt == OS_OPT_TMR_PERIODIC) {
+                    OS_TmrLink(p_tmr, p_tmr->Period);           /* Reload the time remaining                            */
+                } else {
+                    p_tmr->State = OS_TMR_STATE_COMPLETED;      /* Indicate that the timer has completed                */
+                }
+                p_fnct = p_tmr->CallbackPtr;                    /* Execute callback function if available               */
+                if (p_fnct != (OS_TMR_CALLBACK_PTR)0u) {
+                    (*p_fnct)(p_tmr, p_tmr->CallbackPtrArg);
+                }
+                p_node = OS_WheelDueGet(&OSTmrWheel);
+            }
+            OSSchedUnlock(&err);
+            (void)err;
+        }
+#else
         p_tmr    = OSTmrListPtr;
         while (p_tmr != (OS_TMR *)0) {                          /* Update all the timers in the list                    */
             OSSchedLock(&err);
@@ -1233,6 +1331,7 @@ void  OS_TmrTask (void  *p_arg)
             OSSchedUnlock(&err);
             (void)err;
         }
+#endif
 
 #if (OS_CFG_TS_EN == DEF_ENABLED)
         ts_delta = OS_TS_GET() - ts_start;                      /* Measure execution time of timer task                 */
@@ -74,7 +74,11 @@ typedef   CPU_INT16U      OS_OPT;                      /* Holds function options
 
 typedef   CPU_INT32U      OS_MON_RES;                  /* Monitor result flags,                                       */
 
+#if (OS_CFG_PRIO_MAX > 255u)                           /* OS_PRIO_INIT (OS_CFG_PRIO_MAX) must fit too             */
+typedef   CPU_INT16U      OS_PRIO;                     /* Priority of a task,                               8/<16>/32 */
+#else
 typedef   CPU_INT08U      OS_PRIO;                     /* Priority of a task,                               <8>/16/32 */
+#endif
 
 typedef   CPU_INT16U      OS_QTY;                      /* Quantity                                            <16>/32 */
 
@@ -0,0 +1,572 @@
+/*
+************************************************************************************************************************
+*                                                    TIMING WHEEL
+*                          A uC/OS-III V3.06.01 addition for jb444Lab3Proj, not Micrium code
+*
+* File    : OS_WHEEL.C
+************************************************************************************************************************
+* Note(s) : (1) A hierarchical timing wheel holds entries by the value of .Now at which they are due.  OS_WHEEL_LEVELS
+*               levels of OS_WHEEL_SLOTS slots each hold entries due within 64, 64^2, ... ticks.  The slot is picked
+*               from the expiry alone, so insertion is O(1) whatever the number of entries already waiting.  The
+*               tick lists (OS_CFG_TICK_WHEEL_EN) and the timer list (OS_CFG_TMR_WHEEL_EN) are both kept in one.
+*
+*           (2) The owner moves the wheel on with OS_WheelStep() and OS_WheelAdvance(), then takes the entries that
+*               are due off it with OS_WheelDueGet() and OS_WheelRemove().  Entries due on the same tick come out
+*               newest first.
+*
+*           (3) The .PrevPtr of the first entry in a slot points to the last one, so a slot can be appended to in
+*               O(1).  An entry is therefore first in its slot when its previous entry has no next one.
+*
+*           (4) The wheel is not protected here.  The tick lists are used with interrupts disabled and the timer
+*               wheel with the timer lock held.
+*
+*           (5) The project ships with the timer wheel on and the tick wheel off.  Stepping the tick wheel costs more
+*               per tick than the delta lists at 10 to 1000 delayed tasks.  It only wins at about 1000 tasks, where
+*               the lists' O(n) insertion dominates (host/test/tick_bench.c).
+************************************************************************************************************************
+*/
+
+#define  MICRIUM_SOURCE
+#include "os.h"
+
+#ifdef VSC_INCLUDE_SOURCE_FILE_NAMES
+const  CPU_CHAR  *os_wheel__c = "$Id: $";
+#endif
+
+
+#if (OS_WHEEL_EN == DEF_ENABLED)
+/*
+************************************************************************************************************************
+*                                               LOCAL FUNCTION PROTOTYPES
+************************************************************************************************************************
+*/
+
+static  OS_WHEEL_NODE **OS_WheelSlotGet  (OS_WHEEL       *p_wheel,
+                                          OS_TICK         expire);
+
+static  OS_WHEEL_NODE **OS_WheelSlotFind (OS_WHEEL       *p_wheel,
+                                          OS_WHEEL_NODE  *p_node);
+
+static  void            OS_WheelLink     (OS_WHEEL       *p_wheel,
+                                          OS_WHEEL_NODE  *p_node,
+                                          CPU_BOOLEAN     at_tail);
+
+static  CPU_INT08U      OS_WheelSlotNext (OS_WHEEL       *p_wheel,
+                                          CPU_INT08U      level,
+                                          CPU_INT08U      slot);
+
+static  void            OS_WheelMapSet   (OS_WHEEL       *p_wheel,
+                                          CPU_DATA        ix);
+
+static  void            OS_WheelMapClr   (OS_WHEEL       *p_wheel,
+                                          CPU_DATA        ix);
+
+
+/*
+************************************************************************************************************************
+*                                               INITIALIZE A TIMING WHEEL
+*
+* Description: This function empties every slot of a timing wheel.
+*
+* Arguments  : p_wheel        is a pointer to the wheel.
+*
+*              now            is the initial value of .Now, the counter the wheel is to follow.
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application MUST NOT call it.
+************************************************************************************************************************
+*/
+
+void  OS_WheelInit (OS_WHEEL  *p_wheel,
+                    OS_TICK    now)
+{
+    CPU_INT08U  level;
+    CPU_INT08U  slot;
+
+
+    for (level = 0u; level < OS_WHEEL_LEVELS; level++) {
+        for (slot = 0u; slot < OS_WHEEL_SLOTS; slot++) {
+            p_wheel->Slot[level][slot] = (OS_WHEEL_NODE *)0;
+        }
+        for (slot = 0u; slot < OS_WHEEL_MAP_SIZE; slot++) {
+            p_wheel->Map[level][slot]  = 0u;
+        }
+    }
+    p_wheel->Now = now;
+}
+
+
+/*
+************************************************************************************************************************
+*                                            INSERT AN ENTRY IN A TIMING WHEEL
+*
+* Description: This function adds an entry that becomes due 'time' ticks from now.
+*
+* Arguments  : p_wheel        is a pointer to the wheel.
+*
+*              p_node         is a pointer to the entry, which must not already be in a wheel.
+*
+*              p_obj          is a pointer to the task or timer the entry belongs to, returned in .ObjPtr.
+*
+*              time           is the number of ticks until the entry is due.
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application MUST NOT call it.
+*
+*              2) A time of 0 is treated as 1 tick.  The slot for the current tick has already been handled.
+************************************************************************************************************************
+*/
+
+void  OS_WheelInsert (OS_WHEEL       *p_wheel,
+                      OS_WHEEL_NODE  *p_node,
+                      void           *p_obj,
+                      OS_TICK         time)
+{
+    if (time == 0u) {                                           /* See Note #2                                          */
+        time = 1u;
+    }
+    p_node->Expire = p_wheel->Now + time;
+    p_node->ObjPtr = p_obj;
+    OS_WheelLink(p_wheel, p_node, DEF_NO);                      /* Newest entries go in front                           */
+}
+
+
+/*
+************************************************************************************************************************
+*                                            REMOVE AN ENTRY FROM A TIMING WHEEL
+*
+* Description: This function takes an entry off the wheel, whether it is due or not.
+*
+* Arguments  : p_wheel        is a pointer to the wheel.
+*
+*              p_node         is a pointer to the entry.
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application MUST NOT call it.
+*
+*              2) The slot only has to be found when its first or last entry is removed (see Note #3 at the top).
+************************************************************************************************************************
+*/
+
+void  OS_WheelRemove (OS_WHEEL       *p_wheel,
+                      OS_WHEEL_NODE  *p_node)
+{
+    OS_WHEEL_NODE   *p_node1;
+    OS_WHEEL_NODE   *p_node2;
+    OS_WHEEL_NODE  **p_slot;
+    CPU_BOOLEAN      first;
+
+
+    p_node1 = p_node->PrevPtr;
+    p_node2 = p_node->NextPtr;
+    first   = (p_node1->NextPtr == (OS_WHEEL_NODE *)0) ? DEF_YES : DEF_NO;
+    p_slot  = (OS_WHEEL_NODE **)0;
+    if ((first == DEF_YES) || (p_node2 == (OS_WHEEL_NODE *)0)) {
+        p_slot = OS_WheelSlotFind(p_wheel, p_node);             /* Slot head has to change (see Note #2)                */
+    }
+
+    if (first == DEF_YES) {
+       *p_slot = p_node2;
+    } else {
+        p_node1->NextPtr = p_node2;
+    }
+    if (p_node2 != (OS_WHEEL_NODE *)0) {
+        p_node2->PrevPtr = p_node1;
+    } else if (*p_slot != (OS_WHEEL_NODE *)0) {
+        (*p_slot)->PrevPtr = p_node1;                           /* New last entry of the slot                           */
+    } else {
+        OS_WheelMapClr(p_wheel, (CPU_DATA)(p_slot - &p_wheel->Slot[0][0]));     /* Slot is now empty                */
+    }
+    p_node->NextPtr = (OS_WHEEL_NODE *)0;
+    p_node->PrevPtr = (OS_WHEEL_NODE *)0;
+}
+
+
+/*
+************************************************************************************************************************
+*                                            TICKS TO THE NEXT WHEEL EVENT
+*
+* Description: This function returns the number of ticks until the wheel next has work to do: a level 0 slot with
+*              entries due, or a slot of a higher level to cascade.
+*
+* Arguments  : p_wheel        is a pointer to the wheel.
+*
+*              ticks          is the most that can be returned, the number of ticks left to process.
+*
+* Returns    : the number of ticks, from 1 to 'ticks'.
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application MUST NOT call it.
+*
+*              2) Slot s of level n is emptied on the tick at which digit n of .Now becomes s and the digits below are
+*                 0.  The next occupied slot after the current one, up to a full turn, gives that tick.  It is
+*                 computed modulo 2^32, so the top level, of which only 2^32 / 64^5 slots are used, needs no special
+*                 case.
+*
+*              3) The ticks skipped are ones on which every slot OS_WheelAdvance() would visit is empty, so the time
+*                 taken to catch up grows with the number of entries due, not with 'ticks'.
+************************************************************************************************************************
+*/
+
+OS_TICK  OS_WheelStep (OS_WHEEL  *p_wheel,
+                       OS_TICK    ticks)
+{
+    OS_TICK      step;
+    OS_TICK      turn;
+    OS_TICK      next;
+    CPU_INT08U   level;
+    CPU_INT08U   shift;
+    CPU_INT08U   cur;
+    CPU_INT08U   slot;
+
+
+    step = ticks;
+    for (level = 0u; level < OS_WHEEL_LEVELS; level++) {
+        shift = (CPU_INT08U)(level * OS_WHEEL_BITS);
+        turn  = p_wheel->Now >> shift;
+        cur   = (CPU_INT08U)(turn & OS_WHEEL_MASK);
+        slot  = OS_WheelSlotNext(p_wheel, level, (CPU_INT08U)((cur + 1u) & OS_WHEEL_MASK));
+        if (slot < OS_WHEEL_SLOTS) {
+            turn += ((OS_TICK)slot - cur - 1u) & OS_WHEEL_MASK;         /* 1 to 64 slots on, see Note #2            */
+            turn += 1u;
+            next  = (OS_TICK)(turn << shift) - p_wheel->Now;
+            if ((next != 0u) && (next < step)) {
+                step = next;
+            }
+        }
+    }
+    return (step);
+}
+
+
+/*
+************************************************************************************************************************
+*                                              ADVANCE A TIMING WHEEL
+*
+* Description: This function moves a wheel on by 'ticks' and cascades the slots reached.  The entries due are then in
+*              the level 0 slot for .Now, see OS_WheelDueGet().
+*
+* Arguments  : p_wheel        is a pointer to the wheel.
+*
+*              ticks          is the number of ticks to move on by, no more than OS_WheelStep() returned.
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application MUST NOT call it.
+*
+*              2) Each time level n wraps to slot 0, the next slot of level n+1 is emptied into the levels below.  An
+*                 entry is moved at most once per level, which makes expiry amortized O(1).  Only the last tick can
+*                 have a slot to cascade, see OS_WheelStep().
+*
+*              3) Cascaded entries are older than the ones already in their new slot, so they are relinked in order
+*                 behind them.
+************************************************************************************************************************
+*/
+
+void  OS_WheelAdvance (OS_WHEEL  *p_wheel,
+                       OS_TICK    ticks)
+{
+    OS_WHEEL_NODE  *p_node;
+    OS_WHEEL_NODE  *p_node_next;
+    CPU_INT08U      level;
+    CPU_INT08U      slot;
+
+
+    p_wheel->Now += ticks;
+    level         = 0u;
+    slot          = (CPU_INT08U)(p_wheel->Now & OS_WHEEL_MASK);
+    while ((slot == 0u) && (level < (OS_WHEEL_LEVELS - 1u))) {
+        level++;                                                /* Cascade the next slot of the level above (Note #2)   */
+        slot   = (CPU_INT08U)((p_wheel->Now >> (level * OS_WHEEL_BITS)) & OS_WHEEL_MASK);
+        p_node = p_wheel->Slot[level][slot];
+        if (p_node != (OS_WHEEL_NODE *)0) {
+            p_wheel->Slot[level][slot] = (OS_WHEEL_NODE *)0;
+            OS_WheelMapClr(p_wheel, ((CPU_DATA)level * OS_WHEEL_SLOTS) + slot);
+            while (p_node != (OS_WHEEL_NODE *)0) {              /* Relink in order (see Note #3)                        */
+                p_node_next = p_node->NextPtr;
+                OS_WheelLink(p_wheel, p_node, DEF_YES);
+                p_node      = p_node_next;
+            }
+        }
+    }
+}
+
+
+/*
+************************************************************************************************************************
+*                                               GET THE FIRST ENTRY DUE
+*
+* Description: This function returns the newest entry due on the current tick.  The owner takes it off the wheel with
+*              OS_WheelRemove() and calls this function again until there are none left.
+*
+* Arguments  : p_wheel        is a pointer to the wheel.
+*
+* Returns    : a pointer to the entry, or a NULL pointer if no entry is due.
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application MUST NOT call it.
+*
+*              2) An entry inserted while the due entries are being handled is due 1 tick or more later, so it never
+*                 lands in this slot.
+************************************************************************************************************************
+*/
+
+OS_WHEEL_NODE  *OS_WheelDueGet (OS_WHEEL  *p_wheel)
+{
+    return (p_wheel->Slot[0][p_wheel->Now & OS_WHEEL_MASK]);
+}
+
+
+/*
+************************************************************************************************************************
+*                                             TICKS TO THE NEXT EXPIRY
+*
+* Description: This function returns the number of ticks until the first entry in a wheel is due.
+*
+* Arguments  : p_wheel        is a pointer to the wheel.
+*
+* Returns    : the number of ticks, or (OS_TICK)-1 if the wheel is empty.
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application MUST NOT call it.
+*
+*              2) On each level the first occupied slot after the current one holds that level's earliest entries.
+*                 The earliest of those across all levels is the answer.  The slots are found from .Map[], so the cost
+*                 is bounded by the number of levels and the entries of at most one slot per level.
+************************************************************************************************************************
+*/
+
+OS_TICK  OS_WheelNextGet (OS_WHEEL  *p_wheel)
+{
+    OS_WHEEL_NODE  *p_node;
+    OS_TICK         next;
+    OS_TICK         remain;
+    CPU_INT08U      level;
+    CPU_INT08U      slot;
+
+
+    next = (OS_TICK)-1;
+    for (level = 0u; level < OS_WHEEL_LEVELS; level++) {
+        slot = (CPU_INT08U)(((p_wheel->Now >> (level * OS_WHEEL_BITS)) + 1u) & OS_WHEEL_MASK);
+        slot = OS_WheelSlotNext(p_wheel, level, slot);          /* The current slot is reached last                     */
+        if (slot < OS_WHEEL_SLOTS) {
+            p_node = p_wheel->Slot[level][slot];
+            while (p_node != (OS_WHEEL_NODE *)0) {
+                remain = p_node->Expire - p_wheel->Now;
+                if (remain < next) {
+                    next = remain;
+                }
+                p_node = p_node->NextPtr;
+            }
+        }
+    }
+    return (next);
+}
+
+
+/*
+************************************************************************************************************************
+*                                                  FIND A WHEEL SLOT
+*
+* Description: This function returns the slot that holds an entry due when .Now reaches 'expire'.
+*
+* Arguments  : p_wheel        is a pointer to the wheel.
+*
+*              expire         is the value of .Now at which the entry is due.
+*
+* Returns    : a pointer to the head of the slot's list.
+*
+* Note(s)    : 1) The level is picked from the distance to 'expire': level n holds entries due in less than 64^(n+1)
+*                 ticks.  The slot within the level is picked from the bits of 'expire' itself, so an entry moves
+*                 down a level exactly when the wheel below it wraps to its slot.
+************************************************************************************************************************
+*/
+
+static  OS_WHEEL_NODE  **OS_WheelSlotGet (OS_WHEEL  *p_wheel,
+                                          OS_TICK    expire)
+{
+    OS_TICK     remain;
+    CPU_INT08U  level;
+
+
+    remain = (expire - p_wheel->Now) >> OS_WHEEL_BITS;
+    level  = 0u;
+    while (remain != 0u) {                                      /* At most OS_WHEEL_LEVELS - 1 passes                   */
+        remain >>= OS_WHEEL_BITS;
+        level++;
+    }
+    return (&p_wheel->Slot[level][(expire >> (level * OS_WHEEL_BITS)) & OS_WHEEL_MASK]);
+}
+
+
+/*
+************************************************************************************************************************
+*                                            FIND THE SLOT OF A LINKED ENTRY
+*
+* Description: This function returns the slot in which an entry is the first or the last one.
+*
+* Arguments  : p_wheel        is a pointer to the wheel.
+*
+*              p_node         is a pointer to the entry.
+*
+* Returns    : a pointer to the head of the slot's list.
+*
+* Note(s)    : 1) The expiry maps to one slot on each level.  The entry may have moved down levels since it was
+*                 linked, so each of those slots is checked.
+************************************************************************************************************************
+*/
+
+static  OS_WHEEL_NODE  **OS_WheelSlotFind (OS_WHEEL       *p_wheel,
+                                           OS_WHEEL_NODE  *p_node)
+{
+    OS_WHEEL_NODE  *p_first;
+    CPU_INT08U      level;
+    CPU_INT08U      slot;
+
+
+    for (level = 0u; level < (OS_WHEEL_LEVELS - 1u); level++) {
+        slot    = (CPU_INT08U)((p_node->Expire >> (level * OS_WHEEL_BITS)) & OS_WHEEL_MASK);
+        p_first = p_wheel->Slot[level][slot];
+        if ((p_first == p_node) ||
+            ((p_first != (OS_WHEEL_NODE *)0) && (p_first->PrevPtr == p_node))) {
+            return (&p_wheel->Slot[level][slot]);
+        }
+    }
+    slot = (CPU_INT08U)((p_node->Expire >> (level * OS_WHEEL_BITS)) & OS_WHEEL_MASK);
+    return (&p_wheel->Slot[level][slot]);                       /* Must then be on the top level                        */
+}
+
+
+/*
+************************************************************************************************************************
+*                                             LINK AN ENTRY INTO ITS SLOT
+*
+* Description: This function adds an entry to the slot for its expiry (.Expire).
+*
+* Arguments  : p_wheel        is a pointer to the wheel.
+*
+*              p_node         is a pointer to the entry to link.
+*
+*              at_tail        DEF_NO  to add the entry in front, as a new entry
+*                             DEF_YES to add the entry at the back, as a cascaded entry
+*
+* Returns    : none
+************************************************************************************************************************
+*/
+
+static  void  OS_WheelLink (OS_WHEEL       *p_wheel,
+                            OS_WHEEL_NODE  *p_node,
+                            CPU_BOOLEAN     at_tail)
+{
+    OS_WHEEL_NODE  **p_slot;
+    OS_WHEEL_NODE   *p_first;
+
+
+    p_slot  = OS_WheelSlotGet(p_wheel, p_node->Expire);
+    p_first = *p_slot;
+    if (p_first == (OS_WHEEL_NODE *)0) {                        /* Only entry in the slot                               */
+        p_node->PrevPtr  = p_node;
+        p_node->NextPtr  = (OS_WHEEL_NODE *)0;
+       *p_slot           = p_node;
+        OS_WheelMapSet(p_wheel, (CPU_DATA)(p_slot - &p_wheel->Slot[0][0]));
+    } else if (at_tail == DEF_YES) {
+        p_node->PrevPtr  = p_first->PrevPtr;
+        p_node->NextPtr  = (OS_WHEEL_NODE *)0;
+        p_first->PrevPtr->NextPtr = p_node;
+        p_first->PrevPtr = p_node;                              /* Entry is the new last entry                          */
+    } else {
+        p_node->PrevPtr  = p_first->PrevPtr;
+        p_node->NextPtr  = p_first;
+        p_first->PrevPtr = p_node;
+       *p_slot           = p_node;                              /* Entry is the new first entry                         */
+    }
+}
+
+
+/*
+************************************************************************************************************************
+*                                             FIND THE NEXT OCCUPIED SLOT
+*
+* Description: This function returns the first slot of a level that holds entries, looking from 'slot' on and wrapping
+*              around.
+*
+* Arguments  : p_wheel        is a pointer to the wheel.
+*
+*              level          is the wheel level.
+*
+*              slot           is the first slot to look at.
+*
+* Returns    : the slot, or OS_WHEEL_SLOTS if the level is empty.
+*
+* Note(s)    : 1) .Map[] has one bit per slot, most significant first as in OSPrioTbl[], so each CPU_DATA entry is
+*                 searched with one CPU_CntLeadZeros().  The entry holding 'slot' is visited twice: first for the
+*                 slots from 'slot' on, last for the slots before it.
+************************************************************************************************************************
+*/
+
+static  CPU_INT08U  OS_WheelSlotNext (OS_WHEEL    *p_wheel,
+                                      CPU_INT08U   level,
+                                      CPU_INT08U   slot)
+{
+    CPU_DATA  *p_map;
+    CPU_DATA   bits;
+    CPU_DATA   ix;
+    CPU_DATA   i;
+
+
+    p_map = &p_wheel->Map[level][0];
+    ix    = (CPU_DATA)slot / DEF_INT_CPU_NBR_BITS;
+    bits  = p_map[ix] & (DEF_INT_CPU_U_MAX_VAL >> ((CPU_DATA)slot & (DEF_INT_CPU_NBR_BITS - 1u)));
+    for (i = 0u; i <= OS_WHEEL_MAP_SIZE; i++) {                 /* See Note #1                                          */
+        if (bits != 0u) {
+            return ((CPU_INT08U)((ix * DEF_INT_CPU_NBR_BITS) + CPU_CntLeadZeros(bits)));
+        }
+        ix   = (ix + 1u) % OS_WHEEL_MAP_SIZE;
+        bits = p_map[ix];
+    }
+    return ((CPU_INT08U)OS_WHEEL_SLOTS);
+}
+
+
+/*
+************************************************************************************************************************
+*                                             MARK A SLOT FULL OR EMPTY
+*
+* Description: These functions keep .Map[] in step with the slots.  A bit is set when an entry is linked into an empty
+*              slot and cleared when the slot is emptied.
+*
+* Arguments  : p_wheel        is a pointer to the wheel.
+*
+*              ix             is the index of the slot in .Slot[][], level * OS_WHEEL_SLOTS + slot.
+*
+* Returns    : none
+************************************************************************************************************************
+*/
+
+static  void  OS_WheelMapSet (OS_WHEEL  *p_wheel,
+                              CPU_DATA   ix)
+{
+    CPU_DATA  bit;
+    CPU_DATA  slot;
+
+
+    slot  = ix & OS_WHEEL_MASK;
+    bit   = 1u;
+    bit <<= (DEF_INT_CPU_NBR_BITS - 1u) - (slot & (DEF_INT_CPU_NBR_BITS - 1u));
+    p_wheel->Map[ix / OS_WHEEL_SLOTS][slot / DEF_INT_CPU_NBR_BITS] |= bit;
+}
+
+
+static  void  OS_WheelMapClr (OS_WHEEL  *p_wheel,
+                              CPU_DATA   ix)
+{
+    CPU_DATA  bit;
+    CPU_DATA  slot;
+
+
+    slot  = ix & OS_WHEEL_MASK;
+    bit   = 1u;
+    bit <<= (DEF_INT_CPU_NBR_BITS - 1u) - (slot & (DEF_INT_CPU_NBR_BITS - 1u));
+    p_wheel->Map[ix / OS_WHEEL_SLOTS][slot / DEF_INT_CPU_NBR_BITS] &= ~bit;
+}
+#endif